@@ -215,7 +215,7 @@ void distribute_matrix(const MPI_Comm *comm,
         }
     }
     // Wait to finish communication
-    MPI_Waitall(n-1, &(mpi_req[0]), MPI_STATUSES_IGNORE);
+    MPI_Waitall(n, mpi_req.data(), MPI_STATUSES_IGNORE);
 
     n = 0;
     // Array to hold boundary offset for each interface
@@ -270,7 +270,7 @@ void distribute_matrix(const MPI_Comm *comm,
     }
 
     // Wait to finish communication
-    MPI_Waitall(n-1, &(mpi_req[0]), MPI_STATUSES_IGNORE);
+    MPI_Waitall(n, mpi_req.data(), MPI_STATUSES_IGNORE);
 
     // Total boundary size
     int nnz_boundary = 0;
@@ -55,6 +55,9 @@ void testing_backend_init_order(void)
     // Set OpenMP thread affinity after init_rocalution should terminate
     ASSERT_DEATH(set_omp_affinity_rocalution(omp_aff), ".*Assertion.*");
 
+    // Set OpenMP NUMA placement after init_rocalution should terminate
+    ASSERT_DEATH(set_omp_numa_rocalution(true), ".*Assertion.*");
+
     // Select a device after init_rocalution should terminate
     ASSERT_DEATH(set_device_rocalution(dev), ".*Assertion.*");
 
@@ -97,4 +100,69 @@ void testing_backend(Arguments argus)
     stop_rocalution();
 }
 
+void testing_backend_numa(void)
+{
+    // Enable NUMA placement
+    set_omp_numa_rocalution(true);
+
+    // Initialize rocalution platform
+    init_rocalution();
+
+    // Set OpenMP threads and threshold, such that all threads are used
+    set_omp_threads_rocalution(4);
+    set_omp_threshold_rocalution(0);
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    double* csr_val = NULL;
+
+    int nrow = gen_2d_laplacian(100, &csr_ptr, &csr_col, &csr_val);
+    int nnz = csr_ptr[nrow];
+
+    LocalMatrix<double> A;
+    LocalMatrix<double> B;
+    LocalVector<double> x;
+    LocalVector<double> y;
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // B is allocated and placed by the row-wise copy
+    B.CloneFrom(A);
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+
+    // Allocated vectors are zero
+    ASSERT_EQ(y.Norm(), 0.0);
+
+    x.Ones();
+    B.Apply(x, &y);
+
+    // Row sums of the Laplacian are zero in the interior
+    double* y_val = NULL;
+    y.LeaveDataPtr(&y_val);
+
+    for(int i = 0; i < 100; ++i)
+    {
+        for(int j = 0; j < 100; ++j)
+        {
+            int nb = (i > 0) + (i < 99) + (j > 0) + (j < 99);
+
+            ASSERT_EQ(y_val[i * 100 + j], 4.0 - nb);
+        }
+    }
+
+    free_host(&y_val);
+
+    // Restore the default threshold
+    set_omp_threshold_rocalution(10000);
+
+    // Stop rocalution platform
+    stop_rocalution();
+
+    // Disable NUMA placement again
+    set_omp_numa_rocalution(false);
+}
+
 #endif // TESTING_BACKEND_HPP
@@ -0,0 +1,199 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_BLOCK_KRYLOV_HPP
+#define TESTING_BLOCK_KRYLOV_HPP
+
+#include "utility.hpp"
+
+#include <rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-6);
+}
+
+static double block_tolerance(float)
+{
+    return 1e-5;
+}
+
+static double block_tolerance(double)
+{
+    return 1e-10;
+}
+
+template <typename T>
+bool testing_block_krylov(Arguments argus)
+{
+    int ndim = argus.size;
+    int nrhs = argus.index;
+    std::string solver = argus.solver;
+    std::string precond = argus.precond;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalMultiVector<T> X;
+    LocalMultiVector<T> B;
+    LocalMultiVector<T> E;
+    LocalVector<T> x;
+    LocalVector<T> b;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    X.MoveToAccelerator();
+    B.MoveToAccelerator();
+    E.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+
+    // Allocate X, B and E
+    X.Allocate("X", A.GetN(), nrhs);
+    B.Allocate("B", A.GetM(), nrhs);
+    E.Allocate("E", A.GetN(), nrhs);
+
+    // Random exact solutions, with a repeated column and a zero column to test the
+    // deflation of linearly dependent and converged columns
+    E.SetRandomUniform(12345ULL, static_cast<T>(-1), static_cast<T>(1));
+
+    if(nrhs > 2)
+    {
+        E.GetColumn(0, &x);
+        E.SetColumn(1, x);
+    }
+
+    if(nrhs > 1)
+    {
+        x.Zeros();
+        E.SetColumn(nrhs - 1, x);
+    }
+
+    // Matrix format
+    A.ConvertTo(format);
+
+    // B = A * E
+    A.Apply(E, &B);
+
+    // Verify the SpMM column-wise against the SpMV
+    bool success = true;
+
+    for(int j = 0; j < nrhs; ++j)
+    {
+        E.GetColumn(j, &x);
+        B.GetColumn(j, &b);
+
+        A.ApplyAdd(x, static_cast<T>(-1), &b);
+
+        success &= check_residual(b.Norm());
+    }
+
+    // Solver
+    IterativeLinearSolver<LocalMatrix<T>, LocalMultiVector<T>, T>* ls;
+
+    if(solver == "BlockCG")
+    {
+        ls = new BlockCG<LocalMatrix<T>, LocalMultiVector<T>, T>;
+    }
+    else if(solver == "BlockGMRES")
+    {
+        BlockGMRES<LocalMatrix<T>, LocalMultiVector<T>, T>* gmres
+            = new BlockGMRES<LocalMatrix<T>, LocalMultiVector<T>, T>;
+        gmres->SetBasisSize(8);
+        ls = gmres;
+    }
+    else return false;
+
+    // Preconditioner
+    IterativeLinearSolver<LocalMatrix<T>, LocalMultiVector<T>, T>* p;
+
+    if(precond == "None")
+    {
+        p = NULL;
+    }
+    else if(precond == "BlockCG")
+    {
+        // Inner block solver, solving accurately enough to act as a fixed operator
+        p = new BlockCG<LocalMatrix<T>, LocalMultiVector<T>, T>;
+        p->Init(0.0, 0.1 * block_tolerance(T()), 1e+8, 1000);
+        p->Verbose(0);
+    }
+    else return false;
+
+    ls->Verbose(0);
+    ls->SetOperator(A);
+
+    // Set preconditioner
+    if(p != NULL)
+    {
+        ls->SetPreconditioner(*p);
+    }
+
+    ls->Init(0.0, block_tolerance(T()), 1e+8, 10000);
+    ls->Build();
+
+    X.Zeros();
+    ls->Solve(B, &X);
+
+    // Verify solution
+    X.ScaleAdd(static_cast<T>(-1), E);
+
+    success &= check_residual(X.Norm() / E.Norm());
+
+    // Clean up
+    ls->Clear();
+    delete ls;
+
+    if(p != NULL)
+    {
+        delete p;
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_BLOCK_KRYLOV_HPP
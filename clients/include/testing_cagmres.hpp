@@ -0,0 +1,148 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_CAGMRES_HPP
+#define TESTING_CAGMRES_HPP
+
+#include "utility.hpp"
+
+#include <rocalution.hpp>
+
+using namespace rocalution;
+
+template <typename T>
+bool testing_cagmres(Arguments argus)
+{
+    int ndim = argus.size;
+    int step = argus.index;
+    unsigned int basis = argus.basis;
+    std::string precond = argus.precond;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    // Solver
+    CAGMRES<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    // Preconditioner
+    Preconditioner<LocalMatrix<T>, LocalVector<T>, T> *p;
+
+    // Spectral bounds of the (preconditioned) operator
+    T lambda_min;
+    T lambda_max;
+
+    if(precond == "None")
+    {
+        p = NULL;
+        A.Gershgorin(lambda_min, lambda_max);
+    }
+    else
+    {
+        // The spectrum of the preconditioned operator is contained in (0, 2]
+        lambda_min = static_cast<T>(0);
+        lambda_max = static_cast<T>(2);
+
+        if(precond == "Jacobi") p = new Jacobi<LocalMatrix<T>, LocalVector<T>, T>;
+        else if(precond == "SGS") p = new SGS<LocalMatrix<T>, LocalVector<T>, T>;
+        else if(precond == "ILU") p = new ILU<LocalMatrix<T>, LocalVector<T>, T>;
+        else return false;
+    }
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+
+    // Set preconditioner
+    if(p != NULL)
+    {
+        ls.SetPreconditioner(*p);
+    }
+
+    ls.Init(1e-6, 0.0, 1e+8, 10000);
+    ls.SetBasisSize(30);
+    ls.SetStepSize(step);
+    ls.SetBasis(basis);
+    ls.SetSpectralBounds(lambda_min, lambda_max);
+
+    ls.Build();
+
+    // Matrix format
+    A.ConvertTo(format);
+
+    ls.Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    bool success = (nrm2 < 1e3);
+
+    // Clean up
+    ls.Clear();
+    if(p != NULL)
+    {
+        delete p;
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_CAGMRES_HPP
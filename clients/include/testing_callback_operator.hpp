@@ -0,0 +1,208 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_CALLBACK_OPERATOR_HPP
+#define TESTING_CALLBACK_OPERATOR_HPP
+
+#include "utility.hpp"
+
+#include <rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-6);
+}
+
+// Matrix-free 2D Laplacian, same operator as gen_2d_laplacian()
+template <typename T>
+static void laplace_apply(const LocalVector<T>& in, LocalVector<T>* out, void* data)
+{
+    int ndim = *static_cast<int*>(data);
+
+    for(int i = 0; i < ndim; ++i)
+    {
+        for(int j = 0; j < ndim; ++j)
+        {
+            int idx = i * ndim + j;
+            T sum   = static_cast<T>(4) * in[idx];
+
+            if(i != 0) sum -= in[idx - ndim];
+            if(j != 0) sum -= in[idx - 1];
+            if(j != ndim - 1) sum -= in[idx + 1];
+            if(i != ndim - 1) sum -= in[idx + ndim];
+
+            (*out)[idx] = sum;
+        }
+    }
+}
+
+template <typename T>
+static void laplace_diagonal(LocalVector<T>* diag, void* data)
+{
+    diag->SetValues(static_cast<T>(4));
+}
+
+template <typename T>
+bool testing_callback_operator(Arguments argus)
+{
+    int ndim = argus.size;
+    std::string solver = argus.solver;
+    std::string precond = argus.precond;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // The callback accesses the vectors on the host, hence all data stays on the host
+
+    // Assembled operator for reference
+    LocalMatrix<T> A;
+
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Matrix-free operator
+    LocalCallbackOperator<T> op;
+    op.SetApply(nrow, nrow, laplace_apply<T>, &ndim);
+    op.SetDiagonal(laplace_diagonal<T>);
+
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+    LocalVector<T> ref;
+
+    x.Allocate("x", nrow);
+    b.Allocate("b", nrow);
+    e.Allocate("e", nrow);
+    ref.Allocate("ref", nrow);
+
+    bool success = true;
+
+    // Both operators have to agree
+    e.SetRandomUniform(12345ULL, -1.0, 1.0);
+    A.Apply(e, &ref);
+    op.Apply(e, &x);
+    op.ApplyAdd(e, static_cast<T>(-2), &x);
+    x.AddScale(ref, static_cast<T>(1));
+
+    success &= check_residual(x.Norm() / ref.Norm());
+
+    // b = A * 1
+    e.Ones();
+    op.Apply(e, &b);
+
+    // Random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    // Solver
+    IterativeLinearSolver<LocalCallbackOperator<T>, LocalVector<T>, T>* ls;
+
+    if(solver == "CG") ls = new CG<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(solver == "FCG") ls = new FCG<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(solver == "CR") ls = new CR<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(solver == "BiCGStab") ls = new BiCGStab<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(solver == "BiCGStabl") ls = new BiCGStabl<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(solver == "QMRCGStab") ls = new QMRCGStab<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(solver == "GMRES") ls = new GMRES<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(solver == "FGMRES") ls = new FGMRES<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(solver == "IDR") ls = new IDR<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(solver == "CACG")
+    {
+        // Short monomial bases stay well conditioned in single precision
+        CACG<LocalCallbackOperator<T>, LocalVector<T>, T>* cacg
+            = new CACG<LocalCallbackOperator<T>, LocalVector<T>, T>;
+        cacg->SetStepSize(2);
+
+        ls = cacg;
+    }
+    else if(solver == "CAGMRES") ls = new CAGMRES<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else return false;
+
+    // Preconditioner
+    Preconditioner<LocalCallbackOperator<T>, LocalVector<T>, T> *p;
+
+    if(precond == "None") p = NULL;
+    else if(precond == "Jacobi") p = new Jacobi<LocalCallbackOperator<T>, LocalVector<T>, T>;
+    else if(precond == "Chebyshev")
+    {
+        // The Gershgorin bound of the Laplacian is 8
+        AIChebyshev<LocalCallbackOperator<T>, LocalVector<T>, T> *cheb
+            = new AIChebyshev<LocalCallbackOperator<T>, LocalVector<T>, T>;
+        cheb->Set(3, static_cast<T>(8.0 / 7.0), static_cast<T>(8));
+
+        p = cheb;
+    }
+    else return false;
+
+    ls->Verbose(0);
+    ls->SetOperator(op);
+
+    // Set preconditioner
+    if(p != NULL)
+    {
+        ls->SetPreconditioner(*p);
+    }
+
+    // Single precision stagnates before the absolute tolerance is reached
+    double rel_tol = (sizeof(T) == sizeof(float)) ? 1e-6 : 0.0;
+
+    ls->Init(1e-8, rel_tol, 1e+8, 10000);
+    ls->Build();
+
+    ls->Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm() / e.Norm();
+
+    success &= check_residual(nrm2);
+
+    // Clean up
+    ls->Clear();
+    delete ls;
+
+    if(p != NULL)
+    {
+        delete p;
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_CALLBACK_OPERATOR_HPP
@@ -0,0 +1,245 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#pragma once
+#ifndef TESTING_CCSR_HPP
+#define TESTING_CCSR_HPP
+
+#include "utility.hpp"
+
+#include <rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-5);
+}
+
+// Relative error of the SpMV due to the reduced precision values
+static bool check_precision(unsigned int format, double res)
+{
+    return (res < ((format == CCSRBF16) ? 1e-2 : 1e-6));
+}
+
+template <typename T>
+bool testing_ccsr(Arguments argus)
+{
+    int ndim            = argus.size;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalMatrix<T> B;
+    LocalMatrix<T> C;
+    LocalMatrix<T> D;
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Values that are not exactly representable in reduced precision
+    A.Scale(static_cast<T>(1.0 / 3.0));
+
+    // Matrix with column gaps, that do not fit into 16 bit
+    int gap_nrow = 16;
+    int gap_ncol = 200000;
+    int gap_nnz  = 4 * gap_nrow;
+
+    int* gap_ptr = NULL;
+    int* gap_col = NULL;
+    T* gap_val   = NULL;
+
+    allocate_host(gap_nrow + 1, &gap_ptr);
+    allocate_host(gap_nnz, &gap_col);
+    allocate_host(gap_nnz, &gap_val);
+
+    gap_ptr[0] = 0;
+    for(int i = 0; i < gap_nrow; ++i)
+    {
+        gap_ptr[i + 1] = gap_ptr[i] + 4;
+
+        gap_col[4 * i]     = i;
+        gap_col[4 * i + 1] = i + 65535;
+        gap_col[4 * i + 2] = i + 140000;
+        gap_col[4 * i + 3] = gap_ncol - 1 - i;
+
+        gap_val[4 * i]     = static_cast<T>(1.0 / 3.0);
+        gap_val[4 * i + 1] = static_cast<T>(-2.0);
+        gap_val[4 * i + 2] = static_cast<T>(0.0);
+        gap_val[4 * i + 3] = static_cast<T>(i + 1);
+    }
+
+    C.SetDataPtrCSR(&gap_ptr, &gap_col, &gap_val, "C", gap_nnz, gap_nrow, gap_ncol);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    C.MoveToAccelerator();
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+    z.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate vectors
+    x.Allocate("x", A.GetN());
+    y.Allocate("y", A.GetM());
+    z.Allocate("z", A.GetM());
+
+    bool success = true;
+
+    // Compressed copy of A
+    B.CloneFrom(A);
+    B.ConvertTo(format);
+
+    // CCSR is a host format only
+    success &= (B.GetFormat() == format || B.GetFormat() == CSR);
+    success &= (B.GetNnz() == A.GetNnz());
+
+    // SpMV
+    x.SetRandomUniform(12345ULL, -1.0, 1.0);
+
+    A.Apply(x, &y);
+    B.Apply(x, &z);
+
+    z.ScaleAdd(static_cast<T>(-1), y);
+    success &= check_precision(format, z.Norm() / y.Norm());
+
+    // SpMV with scaled addition
+    y.SetRandomUniform(4321ULL, -1.0, 1.0);
+    z.CopyFrom(y);
+
+    A.ApplyAdd(x, static_cast<T>(-2), &y);
+    B.ApplyAdd(x, static_cast<T>(-2), &z);
+
+    z.ScaleAdd(static_cast<T>(-1), y);
+    success &= check_precision(format, z.Norm() / y.Norm());
+
+    // Matrix with column gaps
+    D.CloneFrom(C);
+    D.ConvertTo(format);
+
+    success &= (D.GetNnz() == C.GetNnz());
+
+    x.Allocate("x", gap_ncol);
+    y.Allocate("y", gap_nrow);
+    z.Allocate("z", gap_nrow);
+
+    x.SetRandomUniform(12345ULL, -1.0, 1.0);
+
+    C.Apply(x, &y);
+    D.Apply(x, &z);
+
+    z.ScaleAdd(static_cast<T>(-1), y);
+    success &= check_precision(format, z.Norm() / y.Norm());
+
+    // Round trip keeps the structure, including explicit zeros
+    D.ConvertToCSR();
+
+    success &= (D.GetNnz() == C.GetNnz());
+
+    D.MoveToHost();
+
+    int* row_offset = NULL;
+    int* col        = NULL;
+    T* val          = NULL;
+
+    D.LeaveDataPtrCSR(&row_offset, &col, &val);
+
+    for(int i = 0; i < gap_nrow; ++i)
+    {
+        success &= (row_offset[i + 1] == 4 * (i + 1));
+        success &= (col[4 * i + 1] == i + 65535);
+        success &= (col[4 * i + 3] == gap_ncol - 1 - i);
+        success &= (val[4 * i + 2] == static_cast<T>(0));
+    }
+
+    free_host(&row_offset);
+    free_host(&col);
+    free_host(&val);
+
+    // Solve with AMG, using compressed level operators
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+    UAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    p.SetCoarsestLevel(20);
+    p.SetOperatorFormat(format);
+    p.InitMaxIter(1);
+    p.Verbose(0);
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.SetPreconditioner(p);
+
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    ls.Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    success &= check_residual(nrm2);
+
+    // Clean up
+    ls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_CCSR_HPP
@@ -157,4 +157,107 @@ bool testing_cg(Arguments argus)
     return success;
 }
 
+template <typename T>
+bool testing_cg_fused(Arguments argus)
+{
+    int ndim = argus.size;
+    std::string precond = argus.precond;
+    int nthreads = argus.omp_nthreads;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // Use all threads, also for small sizes
+    set_omp_threads_rocalution(nthreads);
+    set_omp_threshold_rocalution(0);
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalMatrix<T> B;
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz = csr_ptr[nrow];
+
+    // Vary the diagonal, such that Jacobi is not a scaling
+    for(int r = 0; r < nrow; ++r)
+    {
+        for(int j = csr_ptr[r]; j < csr_ptr[r + 1]; ++j)
+        {
+            if(csr_col[j] == r)
+            {
+                csr_val[j] += static_cast<T>(r % 3);
+            }
+        }
+    }
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // B is solved with the single kernels
+    B.CloneFrom(A);
+    B.ConvertToELL();
+
+    // Allocate x, y, b and e
+    x.Allocate("x", A.GetN());
+    y.Allocate("y", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Same random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+    y.CopyFrom(x);
+
+    int iter[2];
+
+    for(int i = 0; i < 2; ++i)
+    {
+        CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+        Jacobi<LocalMatrix<T>, LocalVector<T>, T> p;
+
+        ls.Verbose(0);
+        ls.SetOperator(i == 0 ? A : B);
+
+        if(precond == "Jacobi")
+        {
+            ls.SetPreconditioner(p);
+        }
+
+        ls.Init(0.0, 1e-4, 1e+8, 10000);
+        ls.Build();
+
+        ls.Solve(b, i == 0 ? &x : &y);
+
+        iter[i] = ls.GetIterationCount();
+
+        ls.Clear();
+    }
+
+    // Both paths compute the same iterates up to rounding
+    x.ScaleAdd(-1.0, y);
+
+    bool success = check_residual(x.Norm() / e.Norm());
+
+    success &= (std::abs(iter[0] - iter[1]) <= 1);
+
+    // Restore the default threshold
+    set_omp_threshold_rocalution(10000);
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_CG_HPP
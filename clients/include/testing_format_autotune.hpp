@@ -0,0 +1,164 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_FORMAT_AUTOTUNE_HPP
+#define TESTING_FORMAT_AUTOTUNE_HPP
+
+#include "utility.hpp"
+
+#include <rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-2f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-5);
+}
+
+template <typename T>
+bool testing_format_autotune(Arguments argus)
+{
+    int ndim = argus.size;
+    unsigned int format = argus.format;
+    bool benchmark = argus.benchmark;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalMatrix<T> B;
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    y.MoveToAccelerator();
+    z.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate vectors
+    x.Allocate("x", A.GetN());
+    y.Allocate("y", A.GetM());
+    z.Allocate("z", A.GetM());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // Initial matrix format
+    A.ConvertTo(format);
+
+    // Reference matrix in CSR format
+    B.CloneFrom(A);
+    B.ConvertToCSR();
+
+    bool success = true;
+
+    // Select the format of A
+    unsigned int selected = A.AutoTuneFormat(benchmark);
+
+    success &= (selected == A.GetFormat());
+
+    // The 5-point stencil fills its diagonals without padding
+    if(benchmark == false)
+    {
+        success &= (selected == DIA);
+    }
+
+    // Same pattern has to result in the same (cached) decision
+    success &= (B.AutoTuneFormat(benchmark) == selected);
+
+    // SpMV has to be independent of the format
+    x.SetRandomUniform(12345ULL, -1.0, 1.0);
+
+    A.ConvertToCSR();
+    A.Apply(x, &y);
+    B.Apply(x, &z);
+
+    z.ScaleAdd(-1.0, y);
+    success &= check_residual(z.Norm() / y.Norm());
+
+    // Solve with AMG, selecting the format of each level
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+    UAAMG<LocalMatrix<T>, LocalVector<T>, T> p;
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    p.SetCoarsestLevel(20);
+    p.SetOperatorFormatAuto(benchmark);
+    p.InitMaxIter(1);
+    p.Verbose(0);
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.SetPreconditioner(p);
+
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    // Fine level operator
+    A.AutoTuneFormat(benchmark);
+
+    ls.Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    success &= check_residual(nrm2);
+
+    // Clean up
+    ls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_FORMAT_AUTOTUNE_HPP
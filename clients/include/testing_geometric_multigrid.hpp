@@ -0,0 +1,206 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#pragma once
+#ifndef TESTING_GEOMETRIC_MULTIGRID_HPP
+#define TESTING_GEOMETRIC_MULTIGRID_HPP
+
+#include "utility.hpp"
+
+#include <rocalution.hpp>
+#include <math.h>
+#include <vector>
+
+using namespace rocalution;
+
+static bool check_gmg_error(float err)
+{
+    return (err < 1e-2f);
+}
+
+static bool check_gmg_error(double err)
+{
+    return (err < 1e-6);
+}
+
+static bool check_gmg_galerkin(float err)
+{
+    return (err < 1e-5f);
+}
+
+static bool check_gmg_galerkin(double err)
+{
+    return (err < 1e-12);
+}
+
+template <typename T>
+bool testing_geometric_multigrid(Arguments argus)
+{
+    int size            = argus.size;
+    int pre_iter        = argus.pre_smooth;
+    int post_iter       = argus.post_smooth;
+    std::string solver  = argus.solver;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    bool success = true;
+
+    // Stencil, a variable coefficient diffusion operator for the general stencil
+    LocalStencil<T> A(format);
+
+    if(format == GeneralStencil)
+    {
+        int offset[21] = {0, 0, 0, -1, 0, 0, 1, 0, 0, 0, -1, 0, 0, 1, 0, 0, 0, -1, 0, 0, 1};
+        T coef[7]      = {6, -1, -1, -1, -1, -1, -1};
+
+        A.SetStencil(3, 7, offset, coef);
+        A.SetGrid(size, size + 3, size - 2);
+
+        int m = A.GetM();
+
+        std::vector<T> var(7 * m);
+
+        for(int i = 0; i < m; ++i)
+        {
+            T k = static_cast<T>(1.0 + 0.5 * sin(0.3 * i));
+
+            var[i] = static_cast<T>(6) * k + static_cast<T>(0.01);
+
+            for(int p = 1; p < 7; ++p)
+            {
+                var[p * m + i] = -k;
+            }
+        }
+
+        A.SetCoefficients(&var[0]);
+    }
+    else
+    {
+        A.SetGrid((format == Laplace2D) ? 2 * size : size);
+    }
+
+    // The Galerkin coarse grid stencil has to match R * A * P
+    {
+        LocalStencil<T> C(GeneralStencil);
+        A.Coarsen(true, &C);
+
+        LocalVector<T> v;
+        LocalVector<T> f;
+        LocalVector<T> z;
+        LocalVector<T> r;
+        LocalVector<T> c;
+
+        v.Allocate("v", C.GetM());
+        f.Allocate("f", A.GetM());
+        z.Allocate("z", A.GetM());
+        r.Allocate("r", C.GetM());
+        c.Allocate("c", C.GetM());
+
+        v.SetRandomUniform(12345ULL, -1.0, 1.0);
+        f.Zeros();
+        z.Zeros();
+
+        // r = R (0 - A P v)
+        A.ProlongAdd(v, &f);
+        A.ResidualRestrict(z, f, &r);
+
+        C.Apply(v, &c);
+        c.AddScale(r, 1.0);
+
+        success &= check_gmg_galerkin(std::abs(c.Norm() / r.Norm()));
+    }
+
+    // Solve with Galerkin and with rediscretized coarse grid stencils
+    for(int galerkin = 0; galerkin < 2; ++galerkin)
+    {
+        LocalVector<T> x;
+        LocalVector<T> b;
+        LocalVector<T> e;
+
+        x.Allocate("x", A.GetN());
+        b.Allocate("b", A.GetM());
+        e.Allocate("e", A.GetN());
+
+        e.SetRandomUniform(67890ULL, -1.0, 1.0);
+        A.Apply(e, &b);
+
+        // Random initial guess
+        x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+        GeometricMultiGrid<LocalStencil<T>, LocalVector<T>, T> mg;
+
+        mg.SetGalerkin(galerkin == 1);
+        mg.SetSmootherPreIter(pre_iter);
+        mg.SetSmootherPostIter(post_iter);
+        mg.Verbose(0);
+
+        double tol = (sizeof(T) == sizeof(float)) ? 1e-5 : 1e-12;
+        int iter;
+
+        if(solver == "CG")
+        {
+            CG<LocalStencil<T>, LocalVector<T>, T> ls;
+
+            mg.InitMaxIter(1);
+
+            ls.SetOperator(A);
+            ls.SetPreconditioner(mg);
+            ls.Verbose(0);
+            ls.Init(0.0, tol, 1e+8, 100);
+            ls.Build();
+            ls.Solve(b, &x);
+
+            iter = ls.GetIterationCount();
+
+            ls.Clear();
+        }
+        else
+        {
+            mg.SetOperator(A);
+            mg.Init(0.0, tol, 1e+8, 100);
+            mg.Build();
+            mg.Solve(b, &x);
+
+            iter = mg.GetIterationCount();
+
+            mg.Clear();
+        }
+
+        // Multigrid convergence does not depend on the grid size
+        success &= (iter < 40);
+
+        // Verify solution
+        x.ScaleAdd(-1.0, e);
+        success &= check_gmg_error(std::abs(x.Norm() / e.Norm()));
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_GEOMETRIC_MULTIGRID_HPP
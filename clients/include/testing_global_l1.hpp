@@ -0,0 +1,302 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#pragma once
+#ifndef TESTING_GLOBAL_L1_HPP
+#define TESTING_GLOBAL_L1_HPP
+
+#include "common.hpp"
+#include "utility.hpp"
+
+#include <rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-3f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-8);
+}
+
+// Global index of the first row owned by this rank
+static int global_row_offset(int nrow)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    int offset = 0;
+
+    MPI_Exscan(&nrow, &offset, 1, MPI_INT, MPI_SUM, comm);
+
+    return (rank == 0) ? 0 : offset;
+}
+
+template <typename T>
+bool testing_global_l1_diagonal(Arguments argus)
+{
+    int ndim = argus.size;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    // Undistributed reference, kept on the host
+    int* ref_ptr = NULL;
+    int* ref_col = NULL;
+    T* ref_val   = NULL;
+
+    gen_2d_laplacian(ndim, &ref_ptr, &ref_col, &ref_val);
+
+    // Distributed matrix
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> lmat;
+    lmat.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix(&comm, &lmat, &A, &pm);
+
+    int m      = A.GetLocalM();
+    int offset = global_row_offset(m);
+
+    GlobalVector<T> b(pm);
+    GlobalVector<T> x(pm);
+
+    b.Allocate("b", A.GetM());
+    x.Allocate("x", A.GetN());
+
+    for(int i = 0; i < m; ++i)
+    {
+        b[i] = static_cast<T>(1 + (offset + i) % 5);
+    }
+
+    bool success = true;
+
+    // L1Jacobi scales by 1 / (a_ii + sum_{j != i} |a_ij|) over the whole row
+    L1Jacobi<GlobalMatrix<T>, GlobalVector<T>, T> jac;
+    jac.SetOperator(A);
+    jac.Build();
+    jac.Solve(b, &x);
+
+    for(int i = 0; i < m; ++i)
+    {
+        int row = offset + i;
+        T diag  = static_cast<T>(0);
+
+        for(int j = ref_ptr[row]; j < ref_ptr[row + 1]; ++j)
+        {
+            diag += (ref_col[j] == row) ? ref_val[j] : std::abs(ref_val[j]);
+        }
+
+        if(std::abs(x[i] * diag - b[i]) > 100 * std::numeric_limits<T>::epsilon() * b[i])
+        {
+            success = false;
+        }
+    }
+
+    // L1GS solves (L + D_l1) x = b with the local lower triangle and the diagonal
+    // augmented by the ghost part of the row only
+    L1GS<GlobalMatrix<T>, GlobalVector<T>, T> gs;
+    gs.SetOperator(A);
+    gs.Build();
+    gs.Solve(b, &x);
+
+    T nrm = static_cast<T>(0);
+    T err = static_cast<T>(0);
+
+    for(int i = 0; i < m; ++i)
+    {
+        int row = offset + i;
+        T sum   = static_cast<T>(0);
+
+        for(int j = ref_ptr[row]; j < ref_ptr[row + 1]; ++j)
+        {
+            int col = ref_col[j];
+
+            if(col == row)
+            {
+                sum += ref_val[j] * x[i];
+            }
+            else if(col < offset || col >= offset + m)
+            {
+                sum += std::abs(ref_val[j]) * x[i];
+            }
+            else if(col < row)
+            {
+                sum += ref_val[j] * x[col - offset];
+            }
+        }
+
+        nrm += b[i] * b[i];
+        err += (sum - b[i]) * (sum - b[i]);
+    }
+
+    success &= check_residual(std::sqrt(err / nrm));
+
+    free_host(&ref_ptr);
+    free_host(&ref_col);
+    free_host(&ref_val);
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_global_l1(Arguments argus)
+{
+    int ndim            = argus.size;
+    std::string precond = argus.precond;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> lmat;
+    lmat.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix(&comm, &lmat, &A, &pm);
+
+    GlobalVector<T> x(pm);
+    GlobalVector<T> b(pm);
+    GlobalVector<T> e(pm);
+
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    x.Zeros();
+
+    // Preconditioner
+    Preconditioner<GlobalMatrix<T>, GlobalVector<T>, T>* p = NULL;
+    GlobalPairwiseAMG<GlobalMatrix<T>, GlobalVector<T>, T>* amg = NULL;
+
+    // Solver, L1GS is not symmetric
+    IterativeLinearSolver<GlobalMatrix<T>, GlobalVector<T>, T>* ls;
+
+    if(precond == "L1GS")
+    {
+        ls = new BiCGStab<GlobalMatrix<T>, GlobalVector<T>, T>;
+    }
+    else
+    {
+        ls = new CG<GlobalMatrix<T>, GlobalVector<T>, T>;
+    }
+
+    if(precond == "L1Jacobi")
+    {
+        p = new L1Jacobi<GlobalMatrix<T>, GlobalVector<T>, T>;
+        ls->SetPreconditioner(*p);
+    }
+    else if(precond == "L1GS")
+    {
+        p = new L1GS<GlobalMatrix<T>, GlobalVector<T>, T>;
+        ls->SetPreconditioner(*p);
+    }
+    else if(precond == "L1SGS")
+    {
+        p = new L1SGS<GlobalMatrix<T>, GlobalVector<T>, T>;
+        ls->SetPreconditioner(*p);
+    }
+    else if(precond == "PairwiseAMG")
+    {
+        // AMG with l1-Jacobi smoothing on all levels
+        amg = new GlobalPairwiseAMG<GlobalMatrix<T>, GlobalVector<T>, T>;
+        amg->SetDefaultSmoother(L1JacobiSmoother);
+        amg->SetCoarsestLevel(20);
+        amg->InitMaxIter(1);
+        amg->Verbose(0);
+        ls->SetPreconditioner(*amg);
+    }
+    else
+    {
+        delete ls;
+        stop_rocalution();
+        return false;
+    }
+
+    ls->Verbose(0);
+    ls->SetOperator(A);
+    ls->Init(1e-8, 0.0, 1e+8, 10000);
+    ls->Build();
+
+    ls->Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm() / e.Norm();
+
+    bool success = check_residual(nrm2);
+
+    // Clean up
+    ls->Clear();
+    delete ls;
+
+    if(p != NULL)
+    {
+        delete p;
+    }
+
+    if(amg != NULL)
+    {
+        delete amg;
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_GLOBAL_L1_HPP
@@ -25,6 +25,7 @@
 #ifndef TESTING_GLOBAL_MATRIX_HPP
 #define TESTING_GLOBAL_MATRIX_HPP
 
+#include "common.hpp"
 #include "utility.hpp"
 
 #include <rocalution.hpp>
@@ -211,6 +212,33 @@ void testing_global_matrix_bad_args(void)
         ASSERT_DEATH(mat.ExtractInverseDiagonal(null_vec), ".*Assertion.*vec_inv_diag != NULL*");
     }
 
+    // ExtractDiagonal
+    {
+        GlobalVector<T> *null_vec = nullptr;
+        ASSERT_DEATH(mat.ExtractDiagonal(null_vec), ".*Assertion.*vec_diag != NULL*");
+    }
+
+    // Transpose
+    {
+        ParallelManager *null_pm = nullptr;
+        ASSERT_DEATH(mat.Transpose(null_pm), ".*Assertion.*pm != NULL*");
+    }
+
+    // MatrixAdd
+    {
+        GlobalMatrix<T> mat2;
+        ParallelManager *null_pm = nullptr;
+        ASSERT_DEATH(mat.MatrixAdd(mat2, 1.0, 1.0, null_pm), ".*Assertion.*pm != NULL*");
+    }
+
+    // MatrixMult
+    {
+        GlobalMatrix<T> A;
+        GlobalMatrix<T> B;
+        ParallelManager *null_pm = nullptr;
+        ASSERT_DEATH(mat.MatrixMult(A, B, null_pm), ".*Assertion.*pm != NULL*");
+    }
+
     // InitialPairwiseAggregation
     {
         int val;
@@ -251,4 +279,180 @@ void testing_global_matrix_bad_args(void)
     stop_rocalution();
 }
 
+static bool check_residual(float res)
+{
+    return (res < 1e-4f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-10);
+}
+
+template <typename T>
+static bool check_global_spmv(const ParallelManager& pm,
+                              const GlobalMatrix<T>& mat,
+                              const LocalMatrix<T>& ref)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    // Global index of the first local row
+    int nrow   = mat.GetLocalM();
+    int offset = 0;
+
+    MPI_Exscan(&nrow, &offset, 1, MPI_INT, MPI_SUM, comm);
+
+    if(rank == 0)
+    {
+        offset = 0;
+    }
+
+    GlobalVector<T> x(pm);
+    GlobalVector<T> y(pm);
+    LocalVector<T> x_ref;
+    LocalVector<T> y_ref;
+
+    x.Allocate("x", mat.GetN());
+    y.Allocate("y", mat.GetM());
+    x_ref.Allocate("x", ref.GetN());
+    y_ref.Allocate("y", ref.GetM());
+
+    for(int i = 0; i < ref.GetN(); ++i)
+    {
+        x_ref[i] = static_cast<T>(1 + i % 7);
+    }
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        x[i] = x_ref[offset + i];
+    }
+
+    mat.Apply(x, &y);
+    ref.Apply(x_ref, &y_ref);
+
+    T nrm = static_cast<T>(0);
+    T err = static_cast<T>(0);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        nrm += y_ref[offset + i] * y_ref[offset + i];
+        err += (y[i] - y_ref[offset + i]) * (y[i] - y_ref[offset + i]);
+    }
+
+    return check_residual(std::sqrt(err / nrm));
+}
+
+// Generate a non-symmetric matrix by scaling the rows of the 2D Laplacian
+template <typename T>
+static void gen_nonsymmetric_matrix(int ndim, LocalMatrix<T>* mat)
+{
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        for(int j = csr_ptr[i]; j < csr_ptr[i + 1]; ++j)
+        {
+            csr_val[j] *= static_cast<T>(1 + i % 3);
+        }
+    }
+
+    mat->SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+}
+
+template <typename T>
+bool testing_global_matrix_apply(Arguments argus)
+{
+    int ndim            = argus.size;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    // Reference on the undistributed matrix
+    LocalMatrix<T> A_ref;
+    LocalMatrix<T> tmp;
+
+    gen_nonsymmetric_matrix(ndim, &A_ref);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    tmp.CloneFrom(A_ref);
+    distribute_matrix(&comm, &tmp, &A, &pm);
+
+    // Formats without a row subset kernel compute the whole interior product at once
+    A.ConvertTo(format);
+
+    bool success = check_global_spmv(pm, A, A_ref);
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_global_matrix_transpose_mult(Arguments argus)
+{
+    int ndim = argus.size;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    // Reference on the undistributed matrix
+    LocalMatrix<T> A_ref;
+    LocalMatrix<T> At_ref;
+    LocalMatrix<T> C_ref;
+    LocalMatrix<T> tmp;
+
+    gen_nonsymmetric_matrix(ndim, &A_ref);
+
+    At_ref.CloneFrom(A_ref);
+    At_ref.Transpose();
+
+    C_ref.MatrixMult(A_ref, At_ref);
+
+    // Distributed matrices, the local matrix is consumed by the distribution
+    ParallelManager pm_A;
+    ParallelManager pm_B;
+    ParallelManager pm_At;
+    ParallelManager pm_C;
+
+    GlobalMatrix<T> A;
+    GlobalMatrix<T> At;
+    GlobalMatrix<T> C;
+
+    tmp.CloneFrom(A_ref);
+    distribute_matrix(&comm, &tmp, &A, &pm_A);
+
+    tmp.CloneFrom(A_ref);
+    distribute_matrix(&comm, &tmp, &At, &pm_B);
+
+    // At = A^T and C = A * A^T
+    At.Transpose(&pm_At);
+    C.MatrixMult(A, At, &pm_C);
+
+    bool success = true;
+
+    success &= check_global_spmv(pm_At, At, At_ref);
+    success &= check_global_spmv(pm_C, C, C_ref);
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_GLOBAL_MATRIX_HPP
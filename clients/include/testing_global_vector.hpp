@@ -25,6 +25,7 @@
 #ifndef TESTING_GLOBAL_VECTOR_HPP
 #define TESTING_GLOBAL_VECTOR_HPP
 
+#include "common.hpp"
 #include "utility.hpp"
 
 #include <rocalution.hpp>
@@ -32,6 +33,16 @@
 
 using namespace rocalution;
 
+static bool check_residual(float res)
+{
+    return (res < 1e-3f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-6);
+}
+
 template <typename T>
 void testing_global_vector_bad_args(void)
 {
@@ -61,4 +72,176 @@ void testing_global_vector_bad_args(void)
     stop_rocalution();
 }
 
+template <typename T>
+bool testing_global_vector_multi_dot(Arguments argus)
+{
+    int ndim = argus.size;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    // Distribute a matrix to obtain the parallel manager
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> lmat;
+    lmat.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix(&comm, &lmat, &A, &pm);
+
+    const int n = 3;
+
+    GlobalVector<T> x0(pm);
+    GlobalVector<T> x1(pm);
+    GlobalVector<T> x2(pm);
+    GlobalVector<T> y(pm);
+
+    x0.Allocate("x0", A.GetN());
+    x1.Allocate("x1", A.GetN());
+    x2.Allocate("x2", A.GetN());
+    y.Allocate("y", A.GetN());
+
+    x0.Ones();
+    x1.SetRandomUniform(12345ULL, -1.0, 1.0);
+    x2.SetRandomUniform(67890ULL, -1.0, 1.0);
+    y.SetRandomUniform(13579ULL, -1.0, 1.0);
+
+    const GlobalVector<T>* xs[n] = {&x0, &x1, &x2};
+    const GlobalVector<T>* ys[n] = {&y, &y, &y};
+
+    // All dot products with a single reduction
+    T result[n];
+    GlobalVector<T>::MultiDot(n, xs, ys, result);
+
+    bool success = true;
+
+    for(int i = 0; i < n; ++i)
+    {
+        T ref = xs[i]->Dot(y);
+
+        if(std::abs(result[i] - ref) > 100 * std::numeric_limits<T>::epsilon() * A.GetN())
+        {
+            success = false;
+        }
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_global_vector_multi_dot_async(Arguments argus)
+{
+    int ndim = argus.size;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    LocalMatrix<T> lmat;
+    lmat.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    ParallelManager pm;
+    GlobalMatrix<T> A;
+
+    distribute_matrix(&comm, &lmat, &A, &pm);
+
+    const int n = 2;
+
+    GlobalVector<T> x0(pm);
+    GlobalVector<T> x1(pm);
+    GlobalVector<T> y(pm);
+    GlobalVector<T> z(pm);
+
+    x0.Allocate("x0", A.GetN());
+    x1.Allocate("x1", A.GetN());
+    y.Allocate("y", A.GetN());
+    z.Allocate("z", A.GetM());
+
+    x0.Ones();
+    x1.SetRandomUniform(12345ULL, -1.0, 1.0);
+    y.SetRandomUniform(13579ULL, -1.0, 1.0);
+
+    const GlobalVector<T>* xs[n] = {&x0, &x1};
+    const GlobalVector<T>* ys[n] = {&y, &y};
+
+    T ref[n];
+    GlobalVector<T>::MultiDot(n, xs, ys, ref);
+
+    // The reduction proceeds while the operator, with its own ghost value exchange, is
+    // applied. Modifying the vectors does not affect the pending result.
+    T result[n];
+    y.MultiDotAsync(n, xs, ys, result);
+
+    A.Apply(x1, &z);
+    x1.CopyFrom(z);
+
+    y.MultiDotSync();
+
+    bool success = true;
+
+    for(int i = 0; i < n; ++i)
+    {
+        if(std::abs(result[i] - ref[i]) > 100 * std::numeric_limits<T>::epsilon() * A.GetN())
+        {
+            success = false;
+        }
+    }
+
+    // CA-CG overlaps its Gram matrix reduction with the generation of the Krylov basis
+    GlobalVector<T> x(pm);
+    GlobalVector<T> b(pm);
+    GlobalVector<T> e(pm);
+
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    e.Ones();
+    A.Apply(e, &b);
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    CACG<GlobalMatrix<T>, GlobalVector<T>, T> ls;
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.SetStepSize(4);
+    ls.SetBasis(ChebyshevBasis);
+    ls.SetSpectralBounds(static_cast<T>(0), static_cast<T>(8));
+    ls.Build();
+    ls.Solve(b, &x);
+
+    x.ScaleAdd(static_cast<T>(-1), e);
+
+    success &= check_residual(std::abs(x.Norm()));
+
+    ls.Clear();
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_GLOBAL_VECTOR_HPP
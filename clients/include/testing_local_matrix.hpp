@@ -27,6 +27,8 @@
 
 #include "utility.hpp"
 
+#include "utility.hpp"
+
 #include <rocalution.hpp>
 #include <gtest/gtest.h>
 
@@ -233,4 +235,534 @@ void testing_local_matrix_bad_args(void)
     stop_rocalution();
 }
 
+template <typename T>
+bool testing_local_matrix_extract_submatrices(Arguments argus)
+{
+    int ndim            = argus.size;
+    int num_blocks      = argus.index;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    LocalMatrix<T> A;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+    A.ConvertTo(format);
+
+    // Non-empty blocks of different sizes, the column blocks differ from the row blocks
+    int* row_offset = NULL;
+    int* col_offset = NULL;
+
+    allocate_host(num_blocks + 1, &row_offset);
+    allocate_host(num_blocks + 2, &col_offset);
+
+    for(int i = 0; i <= num_blocks; ++i)
+    {
+        row_offset[i] = i + (nrow - num_blocks) * i * i / (num_blocks * num_blocks);
+    }
+
+    for(int j = 0; j <= num_blocks + 1; ++j)
+    {
+        col_offset[j] = j + (nrow - num_blocks - 1) * j / (num_blocks + 1);
+    }
+
+    LocalMatrix<T>*** mat = new LocalMatrix<T>**[num_blocks];
+
+    for(int i = 0; i < num_blocks; ++i)
+    {
+        mat[i] = new LocalMatrix<T>*[num_blocks + 1];
+
+        for(int j = 0; j < num_blocks + 1; ++j)
+        {
+            mat[i][j] = new LocalMatrix<T>;
+        }
+    }
+
+    A.ExtractSubMatrices(num_blocks, num_blocks + 1, row_offset, col_offset, mat);
+
+    bool success = true;
+
+    // Compare against extracting each block separately
+    int nnz_blocks = 0;
+
+    for(int i = 0; i < num_blocks; ++i)
+    {
+        for(int j = 0; j < num_blocks + 1; ++j)
+        {
+            int m = row_offset[i + 1] - row_offset[i];
+            int n = col_offset[j + 1] - col_offset[j];
+
+            nnz_blocks += static_cast<int>(mat[i][j]->GetNnz());
+
+            LocalMatrix<T> B;
+            A.ExtractSubMatrix(row_offset[i], col_offset[j], m, n, &B);
+
+            success &= (mat[i][j]->GetNnz() == B.GetNnz());
+
+            if(B.GetNnz() == 0)
+            {
+                continue;
+            }
+
+            success &= (mat[i][j]->GetFormat() == format);
+            success &= (mat[i][j]->GetM() == m);
+            success &= (mat[i][j]->GetN() == n);
+
+            LocalVector<T> x;
+            LocalVector<T> y;
+            LocalVector<T> z;
+
+            x.Allocate("x", n);
+            y.Allocate("y", m);
+            z.Allocate("z", m);
+
+            x.SetRandomUniform(12345ULL, -1.0, 1.0);
+
+            mat[i][j]->Apply(x, &y);
+            B.Apply(x, &z);
+
+            z.ScaleAdd(-1.0, y);
+            success &= (z.Norm() == static_cast<T>(0));
+        }
+    }
+
+    // The blocks cover the whole matrix
+    success &= (nnz_blocks == nnz);
+
+    for(int i = 0; i < num_blocks; ++i)
+    {
+        for(int j = 0; j < num_blocks + 1; ++j)
+        {
+            delete mat[i][j];
+        }
+
+        delete[] mat[i];
+    }
+
+    delete[] mat;
+
+    free_host(&row_offset);
+    free_host(&col_offset);
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
+// Check that perm is a permutation and that the permuted matrix represents the same
+// operator
+template <typename T>
+static bool check_permutation(const LocalMatrix<T>& A, const LocalVector<int>& perm)
+{
+    int n = static_cast<int>(A.GetM());
+
+    if(perm.GetSize() != n)
+    {
+        return false;
+    }
+
+    std::vector<int> count(n, 0);
+
+    for(int i = 0; i < n; ++i)
+    {
+        if(perm[i] < 0 || perm[i] >= n || count[perm[i]]++ > 0)
+        {
+            return false;
+        }
+    }
+
+    LocalMatrix<T> B;
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> z;
+
+    B.CloneFrom(A);
+    B.Permute(perm);
+
+    x.Allocate("x", n);
+    y.Allocate("y", n);
+    z.Allocate("z", n);
+
+    x.SetRandomUniform(12345ULL, -1.0, 1.0);
+
+    // P A x == (P A P^T) P x
+    A.Apply(x, &y);
+    y.Permute(perm);
+
+    x.Permute(perm);
+    B.Apply(x, &z);
+
+    z.ScaleAdd(-1.0, y);
+
+    // Entries of the permuted rows may be summed up in different order
+    return (std::abs(z.Norm()) <= static_cast<T>(1e-4) * std::abs(y.Norm()));
+}
+
+template <typename T>
+bool testing_local_matrix_reordering(Arguments argus)
+{
+    int ndim      = argus.size;
+    int num_parts = argus.index;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    LocalMatrix<T> A;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    bool success = true;
+
+    LocalVector<int> perm;
+
+    A.CMK(&perm);
+    success &= check_permutation(A, perm);
+
+    A.RCMK(&perm);
+    success &= check_permutation(A, perm);
+
+    A.NestedDissection(&perm);
+    success &= check_permutation(A, perm);
+
+    // K-way partitioning into parts of balanced size
+    int* size_parts = NULL;
+
+    A.KWayPartitioning(num_parts, &size_parts, &perm);
+    success &= check_permutation(A, perm);
+
+    int total = 0;
+
+    for(int p = 0; p < num_parts; ++p)
+    {
+        total += size_parts[p];
+        success &= (size_parts[p] <= 1.5 * nrow / num_parts + 1);
+    }
+
+    success &= (total == nrow);
+
+    // The edge cut has to be smaller than the one of contiguous blocks of rows with
+    // the same sizes. The nodes of each part are numbered contiguously.
+    std::vector<int> part(nrow);
+    std::vector<int> block(nrow);
+
+    for(int p = 0, offset = 0; p < num_parts; offset += size_parts[p++])
+    {
+        for(int i = offset; i < offset + size_parts[p]; ++i)
+        {
+            block[i] = p;
+        }
+    }
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        part[i] = block[perm[i]];
+    }
+
+    int* row_offset = NULL;
+    int* col        = NULL;
+    T* val          = NULL;
+
+    A.LeaveDataPtrCSR(&row_offset, &col, &val);
+
+    int cut       = 0;
+    int block_cut = 0;
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            cut += (part[i] != part[col[j]]) ? 1 : 0;
+            block_cut += (block[i] != block[col[j]]) ? 1 : 0;
+        }
+    }
+
+    success &= (cut <= block_cut);
+
+    free_host(&row_offset);
+    free_host(&col);
+    free_host(&val);
+    free_host(&size_parts);
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_restrict_residual(Arguments argus)
+{
+    int ndim = argus.size;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    LocalMatrix<T> A;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    LocalVector<T> b;
+    LocalVector<T> x;
+    LocalVector<T> s;
+    LocalVector<T> r;
+
+    b.Allocate("b", nrow);
+    x.Allocate("x", nrow);
+    s.Allocate("s", nrow);
+    r.Allocate("r", nrow);
+
+    b.SetRandomUniform(12345ULL, -1.0, 1.0);
+    x.SetRandomUniform(54321ULL, -1.0, 1.0);
+
+    // Reference residual
+    A.Apply(x, &r);
+    r.ScaleAdd(-1.0, b);
+
+    bool success = true;
+
+    // Aggregates of four fine points, some of the fine points are not aggregated. The
+    // general restriction additionally weights the next aggregate.
+    int ncoarse = (nrow + 3) / 4;
+
+    for(int overlap = 0; overlap < 2; ++overlap)
+    {
+        int* row_offset = NULL;
+        int* col        = NULL;
+        T* val          = NULL;
+
+        allocate_host(ncoarse + 1, &row_offset);
+        allocate_host(2 * nrow, &col);
+        allocate_host(2 * nrow, &val);
+
+        int nnz_r = 0;
+
+        row_offset[0] = 0;
+
+        for(int c = 0; c < ncoarse; ++c)
+        {
+            int end = (overlap == 1) ? 4 * c + 8 : 4 * c + 4;
+
+            for(int i = 4 * c; i < end && i < nrow; ++i)
+            {
+                if(i % 7 != 0)
+                {
+                    col[nnz_r] = i;
+                    val[nnz_r] = (i < 4 * c + 4) ? static_cast<T>(1) : static_cast<T>(0.5);
+                    ++nnz_r;
+                }
+            }
+
+            row_offset[c + 1] = nnz_r;
+        }
+
+        LocalMatrix<T> R;
+        R.SetDataPtrCSR(&row_offset, &col, &val, "R", nnz_r, ncoarse, nrow);
+
+        LocalVector<T> out;
+        LocalVector<T> ref;
+
+        out.Allocate("out", ncoarse);
+        ref.Allocate("ref", ncoarse);
+
+        R.Apply(r, &ref);
+
+        // Restricted residual only
+        s.Zeros();
+        R.RestrictResidual(A, b, x, false, &s, &out);
+
+        out.ScaleAdd(-1.0, ref);
+        success &= (out.Norm() <= static_cast<T>(1e-5) * ref.Norm());
+
+        // Restricted residual and residual
+        s.Zeros();
+        R.RestrictResidual(A, b, x, true, &s, &out);
+
+        out.ScaleAdd(-1.0, ref);
+        success &= (out.Norm() <= static_cast<T>(1e-5) * ref.Norm());
+
+        s.ScaleAdd(-1.0, r);
+        success &= (s.Norm() <= static_cast<T>(1e-5) * r.Norm());
+    }
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_local_matrix_coo_spmv(Arguments argus)
+{
+    int nrow = argus.size * argus.size;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    // Split the non-zeros among several threads, regardless of the problem size
+    int threshold = _get_backend_descriptor()->OpenMP_threshold;
+
+    set_omp_threads_rocalution(4);
+    set_omp_threshold_rocalution(0);
+
+    // Rows of uneven length, some of them empty, and one dense row that spans several
+    // thread chunks
+    int dense = nrow / 3;
+
+    int* csr_ptr = NULL;
+    allocate_host(nrow + 1, &csr_ptr);
+
+    csr_ptr[0] = 0;
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        int len = (i == dense) ? nrow : ((i % 11 == 5) ? 0 : 1 + i % 3);
+
+        csr_ptr[i + 1] = csr_ptr[i] + len;
+    }
+
+    int nnz = csr_ptr[nrow];
+
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    allocate_host(nnz, &csr_col);
+    allocate_host(nnz, &csr_val);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        for(int j = csr_ptr[i]; j < csr_ptr[i + 1]; ++j)
+        {
+            int stride = (i == dense) ? 1 : 7;
+
+            csr_col[j] = (i + stride * (j - csr_ptr[i])) % nrow;
+            csr_val[j] = static_cast<T>(1 + (i + j) % 5) / static_cast<T>(4);
+        }
+    }
+
+    // Unsorted copy of the non-zeros, stored by columns such that the entries of each
+    // row are scattered over all thread chunks
+    int* coo_row = NULL;
+    int* coo_col = NULL;
+    T* coo_val   = NULL;
+    int* pos     = NULL;
+
+    allocate_host(nnz, &coo_row);
+    allocate_host(nnz, &coo_col);
+    allocate_host(nnz, &coo_val);
+    allocate_host(nrow + 1, &pos);
+
+    set_to_zero_host(nrow + 1, pos);
+
+    for(int j = 0; j < nnz; ++j)
+    {
+        ++pos[csr_col[j] + 1];
+    }
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        pos[i + 1] += pos[i];
+    }
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        for(int j = csr_ptr[i]; j < csr_ptr[i + 1]; ++j)
+        {
+            int k = pos[csr_col[j]]++;
+
+            coo_row[k] = i;
+            coo_col[k] = csr_col[j];
+            coo_val[k] = csr_val[j];
+        }
+    }
+
+    free_host(&pos);
+
+    LocalMatrix<T> A;
+    LocalMatrix<T> B;
+    LocalMatrix<T> C;
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Row-sorted COO
+    B.CloneFrom(A);
+    B.ConvertToCOO();
+
+    // Unsorted COO
+    C.SetDataPtrCOO(&coo_row, &coo_col, &coo_val, "C", nnz, nrow, nrow);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> ref;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    ref.Allocate("ref", nrow);
+
+    x.SetRandomUniform(12345ULL, -1.0, 1.0);
+
+    bool success = true;
+
+    // Apply
+    A.Apply(x, &ref);
+
+    for(int k = 0; k < 2; ++k)
+    {
+        LocalMatrix<T>& coo = (k == 0) ? B : C;
+
+        coo.Apply(x, &y);
+
+        y.ScaleAdd(-1.0, ref);
+        success &= (y.Norm() <= static_cast<T>(1e-5) * ref.Norm());
+    }
+
+    // ApplyAdd, out = out + 2 * A * x
+    ref.Ones();
+    A.ApplyAdd(x, static_cast<T>(2), &ref);
+
+    for(int k = 0; k < 2; ++k)
+    {
+        LocalMatrix<T>& coo = (k == 0) ? B : C;
+
+        y.Ones();
+        coo.ApplyAdd(x, static_cast<T>(2), &y);
+
+        y.ScaleAdd(-1.0, ref);
+        success &= (y.Norm() <= static_cast<T>(1e-5) * ref.Norm());
+    }
+
+    // Restore the previous threshold
+    set_omp_threshold_rocalution(threshold);
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_LOCAL_MATRIX_HPP
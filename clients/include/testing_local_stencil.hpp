@@ -29,6 +29,8 @@
 
 #include <rocalution.hpp>
 #include <gtest/gtest.h>
+#include <stdlib.h>
+#include <vector>
 
 using namespace rocalution;
 
@@ -57,4 +59,236 @@ void testing_local_stencil_bad_args(void)
     stop_rocalution();
 }
 
+static bool check_stencil_error(float err)
+{
+    return (err < 1e-5f);
+}
+
+static bool check_stencil_error(double err)
+{
+    return (err < 1e-12);
+}
+
+template <typename T>
+bool testing_local_stencil(Arguments argus)
+{
+    int size            = argus.size;
+    int nsweep          = argus.pre_smooth;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // Grid size, Laplace2D only supports square grids
+    int ndim  = (format == Laplace2D) ? 2 : 3;
+    int nx    = size;
+    int ny    = (format == Laplace2D) ? size : size + 1;
+    int nz    = (format == Laplace2D) ? 1 : size + 2;
+    int nrow  = nx * ny * nz;
+
+    // Stencil points (dx, dy, dz) and their constant coefficients
+    std::vector<int> offset;
+    std::vector<T> coef;
+
+    if(format == GeneralStencil)
+    {
+        // Non-symmetric stencil with reach 2 in z direction
+        int off[24] = {0, 0, 0, -1, 0, 0, 1, 0, 0, 0, -1, 0,
+                       0, 1, 0, 0, 0, -2, 0, 0, 2, 1, 1, 0};
+        T val[8] = {12, -1, -2, -1, -1, -3, -1, -0.5};
+
+        offset.assign(off, off + 24);
+        coef.assign(val, val + 8);
+    }
+    else
+    {
+        for(int dz = (ndim == 3) ? -1 : 0; dz <= ((ndim == 3) ? 1 : 0); ++dz)
+        {
+            for(int dy = -1; dy <= 1; ++dy)
+            {
+                for(int dx = -1; dx <= 1; ++dx)
+                {
+                    int dist = std::abs(dx) + std::abs(dy) + std::abs(dz);
+
+                    if((format == Laplace2D || format == Laplace3D) && dist > 1)
+                    {
+                        continue;
+                    }
+
+                    if(format == Laplace3D19 && dist > 2)
+                    {
+                        continue;
+                    }
+
+                    T val = static_cast<T>(-1);
+
+                    if(dist == 0)
+                    {
+                        val = static_cast<T>((format == Laplace2D)
+                                                 ? 4
+                                                 : (format == Laplace3D)
+                                                       ? 6
+                                                       : (format == Laplace3D19) ? 24 : 26);
+                    }
+                    else if(dist == 1 && format == Laplace3D19)
+                    {
+                        val = static_cast<T>(-2);
+                    }
+
+                    offset.push_back(dx);
+                    offset.push_back(dy);
+                    offset.push_back(dz);
+                    coef.push_back(val);
+                }
+            }
+        }
+    }
+
+    int npoint = static_cast<int>(coef.size());
+
+    // Variable coefficients for the general stencil
+    std::vector<T> var_coef(npoint * nrow);
+
+    for(int k = 0; k < npoint; ++k)
+    {
+        for(int i = 0; i < nrow; ++i)
+        {
+            var_coef[k * nrow + i] = coef[k] * static_cast<T>(1 + (i * (k + 3)) % 5);
+        }
+    }
+
+    // Stencil
+    LocalStencil<T> S(format);
+
+    if(format == GeneralStencil)
+    {
+        S.SetStencil(3, npoint, &offset[0], &coef[0]);
+    }
+
+    S.SetGrid(nx, ny, nz);
+
+    if(format == GeneralStencil)
+    {
+        S.SetCoefficients(&var_coef[0]);
+    }
+
+    // Assemble the corresponding CSR matrix
+    int* csr_ptr = new int[nrow + 1];
+    int* csr_col = new int[nrow * npoint];
+    T* csr_val   = new T[nrow * npoint];
+
+    int nnz    = 0;
+    csr_ptr[0] = 0;
+
+    for(int z = 0; z < nz; ++z)
+    {
+        for(int y = 0; y < ny; ++y)
+        {
+            for(int x = 0; x < nx; ++x)
+            {
+                int row = (z * ny + y) * nx + x;
+
+                for(int k = 0; k < npoint; ++k)
+                {
+                    int xx = x + offset[3 * k + 0];
+                    int yy = y + offset[3 * k + 1];
+                    int zz = z + offset[3 * k + 2];
+
+                    if(xx < 0 || xx >= nx || yy < 0 || yy >= ny || zz < 0 || zz >= nz)
+                    {
+                        continue;
+                    }
+
+                    csr_col[nnz] = (zz * ny + yy) * nx + xx;
+                    csr_val[nnz]
+                        = (format == GeneralStencil) ? var_coef[k * nrow + row] : coef[k];
+                    ++nnz;
+                }
+
+                csr_ptr[row + 1] = nnz;
+            }
+        }
+    }
+
+    LocalMatrix<T> A;
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+    A.Sort();
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+    LocalVector<T> b;
+    LocalVector<T> r;
+    LocalVector<T> d;
+
+    x.Allocate("x", nrow);
+    y.Allocate("y", nrow);
+    b.Allocate("b", nrow);
+    r.Allocate("r", nrow);
+
+    x.SetRandomUniform(12345ULL, -1.0, 1.0);
+    b.SetRandomUniform(67890ULL, -1.0, 1.0);
+
+    bool success = true;
+
+    // Apply
+    A.Apply(x, &r);
+    S.Apply(x, &y);
+
+    y.ScaleAdd(-1.0, r);
+    success &= check_stencil_error(std::abs(y.Norm() / r.Norm()));
+
+    // ApplyAdd
+    y.CopyFrom(b);
+    S.ApplyAdd(x, static_cast<T>(-0.5), &y);
+
+    r.ScaleAdd(static_cast<T>(-0.5), b);
+    y.ScaleAdd(-1.0, r);
+    success &= check_stencil_error(std::abs(y.Norm() / r.Norm()));
+
+    // Weighted Jacobi sweeps on the assembled matrix
+    A.ExtractInverseDiagonal(&d);
+
+    T omega = static_cast<T>(0.6);
+
+    y.CopyFrom(x);
+
+    for(int k = 0; k < nsweep; ++k)
+    {
+        A.Apply(y, &r);
+        r.ScaleAdd(-1.0, b);
+        r.PointWiseMult(d);
+        y.AddScale(r, omega);
+    }
+
+    S.JacobiSmooth(b, &x, omega, nsweep);
+
+    x.ScaleAdd(-1.0, y);
+    success &= check_stencil_error(std::abs(x.Norm() / y.Norm()));
+
+    // Chebyshev smoothing has to reduce the smooth and the oscillatory error components
+    if(format != GeneralStencil)
+    {
+        T lambda_min;
+        T lambda_max;
+        A.Gershgorin(lambda_min, lambda_max);
+
+        // Gershgorin bounds of A scaled to D^-1 A
+        lambda_max /= coef[npoint / 2];
+        lambda_min = lambda_max / static_cast<T>(30);
+
+        b.Zeros();
+        y.SetRandomUniform(13579ULL, -1.0, 1.0);
+
+        x.CopyFrom(y);
+        S.ChebyshevSmooth(b, &x, lambda_min, lambda_max, nsweep + 1);
+
+        success &= (std::abs(x.Norm()) < std::abs(y.Norm()));
+    }
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_LOCAL_STENCIL_HPP
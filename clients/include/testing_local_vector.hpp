@@ -126,4 +126,166 @@ void testing_local_vector_bad_args(void)
     stop_rocalution();
 }
 
+template <typename T>
+bool testing_local_vector_random(Arguments argus)
+{
+    int size     = argus.size;
+    int nthreads = argus.omp_nthreads;
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    // Use all threads, independent of the size
+    int threshold = _get_backend_descriptor()->OpenMP_threshold;
+
+    set_omp_threshold_rocalution(0);
+
+    LocalVector<T> x;
+    LocalVector<T> y;
+
+    x.Allocate("x", size);
+    y.Allocate("y", size);
+
+    T* vx = NULL;
+    T* vy = NULL;
+
+    allocate_host(size, &vx);
+    allocate_host(size, &vy);
+
+    bool success = true;
+
+    // Uniform distribution
+    set_omp_threads_rocalution(1);
+    x.SetRandomUniform(12345ULL, static_cast<T>(-2), static_cast<T>(4));
+
+    set_omp_threads_rocalution(nthreads);
+    y.SetRandomUniform(12345ULL, static_cast<T>(-2), static_cast<T>(4));
+
+    x.CopyToData(vx);
+    y.CopyToData(vy);
+
+    double mean = 0.0;
+
+    for(int i = 0; i < size; ++i)
+    {
+        // Independent of the number of threads
+        success &= (vx[i] == vy[i]);
+        success &= (vx[i] >= static_cast<T>(-2) && vx[i] <= static_cast<T>(4));
+
+        mean += static_cast<double>(vx[i]);
+    }
+
+    mean /= size;
+    success &= (std::abs(mean - 1.0) < 0.2);
+
+    // Different seeds result in different streams
+    y.SetRandomUniform(54321ULL, static_cast<T>(-2), static_cast<T>(4));
+    y.CopyToData(vy);
+
+    int equal = 0;
+
+    for(int i = 0; i < size; ++i)
+    {
+        equal += (vx[i] == vy[i]) ? 1 : 0;
+    }
+
+    success &= (equal < size / 100 + 1);
+
+    // Normal distribution
+    set_omp_threads_rocalution(1);
+    x.SetRandomNormal(12345ULL, static_cast<T>(1), static_cast<T>(2));
+
+    set_omp_threads_rocalution(nthreads);
+    y.SetRandomNormal(12345ULL, static_cast<T>(1), static_cast<T>(2));
+
+    x.CopyToData(vx);
+    y.CopyToData(vy);
+
+    mean            = 0.0;
+    double variance = 0.0;
+
+    for(int i = 0; i < size; ++i)
+    {
+        success &= (vx[i] == vy[i]);
+
+        mean += static_cast<double>(vx[i]);
+    }
+
+    mean /= size;
+
+    for(int i = 0; i < size; ++i)
+    {
+        variance += (static_cast<double>(vx[i]) - mean) * (static_cast<double>(vx[i]) - mean);
+    }
+
+    variance /= size;
+
+    success &= (std::abs(mean - 1.0) < 0.3);
+    success &= (std::abs(variance - 4.0) < 0.8);
+
+    free_host(&vx);
+    free_host(&vy);
+
+    // Restore the previous threshold
+    set_omp_threshold_rocalution(threshold);
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
+static bool testing_local_vector_philox_kat(void)
+{
+    // Known-answer vectors of the Random123 reference implementation. Each entry holds
+    // the counter, the two key words and the expected output.
+    const unsigned int kat[3][10]
+        = {{0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000000u,
+            0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u},
+           {0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu,
+            0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu},
+           {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u, 0xa4093822u, 0x299f31d0u,
+            0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}};
+
+    bool success = true;
+
+    for(int t = 0; t < 3; ++t)
+    {
+        unsigned int ctr[4] = {kat[t][0], kat[t][1], kat[t][2], kat[t][3]};
+        unsigned long long seed
+            = (static_cast<unsigned long long>(kat[t][5]) << 32) | kat[t][4];
+
+        philox4x32_10(ctr, seed);
+
+        for(int k = 0; k < 4; ++k)
+        {
+            success &= (ctr[k] == kat[t][6 + k]);
+        }
+    }
+
+    // The first pair of the stream with seed 0 is drawn from the first vector
+    double u0;
+    double u1;
+
+    random_uniform_pair(0ULL, 0ULL, u0, u1);
+
+    success &= (u0 == static_cast<double>(0x6627e8d5e169c58dULL >> 11) / 9007199254740992.0);
+    success &= (u1 == static_cast<double>(0xbc57ac4c9b00dbd8ULL >> 11) / 9007199254740992.0);
+
+    // Initialize rocALUTION
+    init_rocalution();
+
+    LocalVector<double> x;
+    x.Allocate("x", 2);
+    x.SetRandomUniform(0ULL, 0.0, 1.0);
+
+    success &= (x[0] == u0);
+    success &= (x[1] == u1);
+
+    // Stop rocALUTION
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_LOCAL_VECTOR_HPP
@@ -0,0 +1,149 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#pragma once
+#ifndef TESTING_MULTICOLORED_HPP
+#define TESTING_MULTICOLORED_HPP
+
+#include "utility.hpp"
+
+#include <rocalution.hpp>
+
+using namespace rocalution;
+
+static bool check_residual(float res)
+{
+    return (res < 1e-4f);
+}
+
+static bool check_residual(double res)
+{
+    return (res < 1e-10);
+}
+
+template <typename T>
+static MultiColored<LocalMatrix<T>, LocalVector<T>, T>* create_multicolored(std::string precond)
+{
+    if(precond == "MCGS")
+    {
+        MultiColoredGS<LocalMatrix<T>, LocalVector<T>, T>* p
+            = new MultiColoredGS<LocalMatrix<T>, LocalVector<T>, T>;
+        p->SetRelaxation(static_cast<T>(1.3));
+        return p;
+    }
+    else if(precond == "MCSGS")
+    {
+        MultiColoredSGS<LocalMatrix<T>, LocalVector<T>, T>* p
+            = new MultiColoredSGS<LocalMatrix<T>, LocalVector<T>, T>;
+        p->SetRelaxation(static_cast<T>(1.3));
+        return p;
+    }
+    else if(precond == "MCILU")
+    {
+        return new MultiColoredILU<LocalMatrix<T>, LocalVector<T>, T>;
+    }
+
+    return NULL;
+}
+
+template <typename T>
+bool testing_multicolored(Arguments argus)
+{
+    int ndim            = argus.size;
+    std::string precond = argus.precond;
+    unsigned int format = argus.format;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> L;
+    LocalMatrix<T> A;
+    LocalVector<T> b;
+    LocalVector<T> x_fused;
+    LocalVector<T> x_block;
+
+    // Generate A as the squared 2D Laplacian, which requires several colors
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    L.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "L", nnz, nrow, nrow);
+    A.MatrixMult(L, L);
+
+    b.Allocate("b", A.GetM());
+    x_fused.Allocate("x", A.GetN());
+    x_block.Allocate("x", A.GetN());
+
+    b.SetRandomUniform(12345ULL, -1.0, 1.0);
+
+    // Fused sweeps on the permuted host CSR matrix
+    MultiColored<LocalMatrix<T>, LocalVector<T>, T>* p_fused = create_multicolored<T>(precond);
+
+    // One SpMV per block, selected by a block format other than CSR
+    MultiColored<LocalMatrix<T>, LocalVector<T>, T>* p_block = create_multicolored<T>(precond);
+
+    if(p_fused == NULL || p_block == NULL)
+    {
+        delete p_fused;
+        delete p_block;
+        stop_rocalution();
+        return false;
+    }
+
+    p_block->SetPrecondMatrixFormat(format);
+
+    p_fused->SetOperator(A);
+    p_block->SetOperator(A);
+
+    p_fused->Build();
+    p_block->Build();
+
+    p_fused->Solve(b, &x_fused);
+    p_block->Solve(b, &x_block);
+
+    // Both paths have to compute the same sweeps
+    T nrm = x_fused.Norm();
+
+    x_block.ScaleAdd(static_cast<T>(-1), x_fused);
+
+    bool success = check_residual(x_block.Norm() / nrm);
+
+    // Clean up
+    p_fused->Clear();
+    p_block->Clear();
+
+    delete p_fused;
+    delete p_block;
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_MULTICOLORED_HPP
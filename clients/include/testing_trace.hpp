@@ -0,0 +1,143 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#pragma once
+#ifndef TESTING_TRACE_HPP
+#define TESTING_TRACE_HPP
+
+#include "utility.hpp"
+
+#include <rocalution.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace rocalution;
+
+// Number of occurrences of pattern in str
+static int count_occurrences(const std::string& str, const std::string& pattern)
+{
+    int count = 0;
+
+    for(size_t pos = str.find(pattern); pos != std::string::npos;
+        pos = str.find(pattern, pos + pattern.size()))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+static std::string read_trace(const std::string& filename)
+{
+    std::ifstream in(filename.c_str());
+    std::stringstream buffer;
+
+    buffer << in.rdbuf();
+
+    return buffer.str();
+}
+
+template <typename T>
+bool testing_trace(Arguments argus)
+{
+    int ndim = argus.size;
+    int napply = 3;
+
+    std::string filename = "rocalution-test-trace.json";
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> y;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz  = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    x.Allocate("x", A.GetN());
+    y.Allocate("y", A.GetM());
+
+    x.Ones();
+
+    enable_trace_rocalution(true);
+    reset_trace_rocalution();
+
+    for(int i = 0; i < napply; ++i)
+    {
+        A.Apply(x, &y);
+    }
+
+    write_trace_rocalution(filename);
+
+    std::string trace = read_trace(filename);
+
+    bool success = true;
+
+    // One event per SpMV
+    success &= (count_occurrences(trace, "{\"name\":\"LocalMatrix::Apply\",\"cat\":\"matrix\","
+                                         "\"ph\":\"X\"")
+                == napply);
+
+    // Counter with the number of calls and the bytes moved per SpMV
+    std::ostringstream counter;
+    counter << "{\"name\":\"LocalMatrix::Apply\",\"cat\":\"matrix\",\"calls\":" << napply
+            << ",";
+
+    success &= (count_occurrences(trace, counter.str()) == 1);
+    success &= (count_occurrences(trace, "\"bytes\":0,\"flops\":0}}") == 0);
+
+    // Reset discards events and counters, disabled tracing records nothing
+    reset_trace_rocalution();
+    enable_trace_rocalution(false);
+
+    A.Apply(x, &y);
+
+    write_trace_rocalution(filename);
+
+    trace = read_trace(filename);
+
+    success &= (count_occurrences(trace, "LocalMatrix::Apply") == 0);
+    success &= (count_occurrences(trace, "\"traceEvents\":[") == 1);
+
+    std::remove(filename.c_str());
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+#endif // TESTING_TRACE_HPP
@@ -164,4 +164,224 @@ bool testing_uaamg(Arguments argus)
     return success;
 }
 
+template <typename T>
+bool testing_uaamg_aggregation(Arguments argus)
+{
+    int ndim = argus.size;
+    unsigned int aggregation = argus.aggregation;
+    std::string precond = argus.precond;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    bool success = true;
+
+    // Aggregates have to be independent of the number of threads
+    if(aggregation == MIS2)
+    {
+        LocalVector<int> conn;
+        LocalVector<int> agg1;
+        LocalVector<int> agg4;
+
+        A.AMGConnect(static_cast<T>(0.01), &conn);
+
+        set_omp_threads_rocalution(1);
+        A.AMGMIS2Aggregate(conn, &agg1);
+
+        set_omp_threads_rocalution(4);
+        A.AMGMIS2Aggregate(conn, &agg4);
+
+        int nagg = 0;
+
+        for(int i = 0; i < nrow; ++i)
+        {
+            success &= (agg1[i] == agg4[i]);
+            success &= (agg1[i] >= 0);
+
+            nagg = (agg1[i] + 1 > nagg) ? agg1[i] + 1 : nagg;
+        }
+
+        success &= (nagg > 0 && nagg < nrow);
+    }
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    // Solver
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    // AMG
+    UAAMG<LocalMatrix<T>, LocalVector<T>, T> ua;
+    SAAMG<LocalMatrix<T>, LocalVector<T>, T> sa;
+
+    ua.SetAggregationStrategy(aggregation);
+    sa.SetAggregationStrategy(aggregation);
+
+    BaseAMG<LocalMatrix<T>, LocalVector<T>, T>* p;
+
+    if(precond == "UAAMG") p = &ua;
+    else if(precond == "SAAMG") p = &sa;
+    else return false;
+
+    p->SetCoarsestLevel(200);
+    p->InitMaxIter(1);
+    p->Verbose(0);
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.SetPreconditioner(*p);
+
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    ls.Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    success &= check_residual(nrm2);
+
+    // Clean up
+    ls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
+template <typename T>
+bool testing_uaamg_default_smoother(Arguments argus)
+{
+    int ndim = argus.size;
+    std::string smoother = argus.smoother;
+    std::string precond = argus.precond;
+
+    // Initialize rocALUTION platform
+    init_rocalution();
+
+    // rocALUTION structures
+    LocalMatrix<T> A;
+    LocalVector<T> x;
+    LocalVector<T> b;
+    LocalVector<T> e;
+
+    // Generate A
+    int* csr_ptr = NULL;
+    int* csr_col = NULL;
+    T* csr_val   = NULL;
+
+    int nrow = gen_2d_laplacian(ndim, &csr_ptr, &csr_col, &csr_val);
+    int nnz = csr_ptr[nrow];
+
+    A.SetDataPtrCSR(&csr_ptr, &csr_col, &csr_val, "A", nnz, nrow, nrow);
+
+    // Move data to accelerator
+    A.MoveToAccelerator();
+    x.MoveToAccelerator();
+    b.MoveToAccelerator();
+    e.MoveToAccelerator();
+
+    // Allocate x, b and e
+    x.Allocate("x", A.GetN());
+    b.Allocate("b", A.GetM());
+    e.Allocate("e", A.GetN());
+
+    // b = A * 1
+    e.Ones();
+    A.Apply(e, &b);
+
+    // Random initial guess
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+
+    // Solver
+    CG<LocalMatrix<T>, LocalVector<T>, T> ls;
+
+    // AMG
+    UAAMG<LocalMatrix<T>, LocalVector<T>, T> ua;
+    SAAMG<LocalMatrix<T>, LocalVector<T>, T> sa;
+
+    BaseAMG<LocalMatrix<T>, LocalVector<T>, T>* p;
+
+    if(precond == "UAAMG") p = &ua;
+    else if(precond == "SAAMG") p = &sa;
+    else return false;
+
+    if(smoother == "Chebyshev") p->SetDefaultSmoother(ChebyshevSmoother);
+    else if(smoother == "L1Jacobi") p->SetDefaultSmoother(L1JacobiSmoother);
+    else if(smoother == "Jacobi") p->SetDefaultSmoother(JacobiSmoother);
+    else if(smoother == "GS") p->SetDefaultSmoother(GaussSeidelSmoother);
+    else return false;
+
+    p->SetCoarsestLevel(200);
+    p->InitMaxIter(1);
+    p->Verbose(0);
+
+    ls.Verbose(0);
+    ls.SetOperator(A);
+    ls.SetPreconditioner(*p);
+
+    ls.Init(1e-8, 0.0, 1e+8, 10000);
+    ls.Build();
+
+    ls.Solve(b, &x);
+
+    // Verify solution
+    x.ScaleAdd(-1.0, e);
+    T nrm2 = x.Norm();
+
+    bool success = check_residual(nrm2);
+
+    // The smoothers have to be rebuilt with the operator
+    ls.ReBuildNumeric();
+
+    x.SetRandomUniform(12345ULL, -4.0, 6.0);
+    ls.Solve(b, &x);
+
+    x.ScaleAdd(-1.0, e);
+    nrm2 = x.Norm();
+
+    success &= check_residual(nrm2);
+
+    // Clean up
+    ls.Clear();
+
+    // Stop rocALUTION platform
+    stop_rocalution();
+
+    return success;
+}
+
 #endif // TESTING_UAAMG_HPP
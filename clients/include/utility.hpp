@@ -136,6 +136,11 @@ class Arguments
     int post_smooth   = 2;
     int ordering      = 1;
     int cycle         = 0;
+    int coarsening    = 0;
+    int aggregation   = 0;
+    int estimate      = 0;
+    int basis         = 0;
+    int benchmark     = 0;
 
     unsigned int format;
 
@@ -167,6 +172,11 @@ class Arguments
         this->post_smooth = rhs.post_smooth;
         this->ordering    = rhs.ordering;
         this->cycle       = rhs.cycle;
+        this->coarsening  = rhs.coarsening;
+        this->aggregation = rhs.aggregation;
+        this->estimate    = rhs.estimate;
+        this->basis       = rhs.basis;
+        this->benchmark   = rhs.benchmark;
 
         this->format = rhs.format;
 
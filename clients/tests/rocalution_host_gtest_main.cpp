@@ -25,17 +25,31 @@
 #include <stdexcept>
 #include <rocalution.hpp>
 
+#ifdef SUPPORT_MPI
+#include <mpi.h>
+#endif
+
 /* =====================================================================
       Main function:
 =================================================================== */
 
 int main(int argc, char** argv)
 {
+#ifdef SUPPORT_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
     rocalution::init_rocalution();
     rocalution::info_rocalution();
     rocalution::stop_rocalution();
 
     ::testing::InitGoogleTest(&argc, argv);
 
-    return RUN_ALL_TESTS();
+    int status = RUN_ALL_TESTS();
+
+#ifdef SUPPORT_MPI
+    MPI_Finalize();
+#endif
+
+    return status;
 }
@@ -63,6 +63,11 @@ TEST(backend_init_order, backend)
     testing_backend_init_order();
 }
 
+TEST(backend_numa, backend)
+{
+    testing_backend_numa();
+}
+
 TEST_P(parameterized_backend, backend)
 {
     Arguments arg = setup_backend_arguments(GetParam());
@@ -0,0 +1,76 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "testing_block_krylov.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, std::string, std::string, unsigned int> block_krylov_tuple;
+
+int block_krylov_size[] = {7, 31};
+int block_krylov_nrhs[] = {1, 4};
+std::string block_krylov_solver[] = {"BlockCG", "BlockGMRES"};
+std::string block_krylov_precond[] = {"None", "BlockCG"};
+unsigned int block_krylov_format[] = {1, 4, 6};
+
+class parameterized_block_krylov : public testing::TestWithParam<block_krylov_tuple>
+{
+    protected:
+    parameterized_block_krylov() {}
+    virtual ~parameterized_block_krylov() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_block_krylov_arguments(block_krylov_tuple tup)
+{
+    Arguments arg;
+    arg.size       = std::get<0>(tup);
+    arg.index      = std::get<1>(tup);
+    arg.solver     = std::get<2>(tup);
+    arg.precond    = std::get<3>(tup);
+    arg.format     = std::get<4>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_block_krylov, block_krylov_float)
+{
+    Arguments arg = setup_block_krylov_arguments(GetParam());
+    ASSERT_EQ(testing_block_krylov<float>(arg), true);
+}
+
+TEST_P(parameterized_block_krylov, block_krylov_double)
+{
+    Arguments arg = setup_block_krylov_arguments(GetParam());
+    ASSERT_EQ(testing_block_krylov<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(block_krylov,
+                        parameterized_block_krylov,
+                        testing::Combine(testing::ValuesIn(block_krylov_size),
+                                         testing::ValuesIn(block_krylov_nrhs),
+                                         testing::ValuesIn(block_krylov_solver),
+                                         testing::ValuesIn(block_krylov_precond),
+                                         testing::ValuesIn(block_krylov_format)));
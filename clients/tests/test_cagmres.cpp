@@ -0,0 +1,76 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "testing_cagmres.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, int, int, std::string, unsigned int> cagmres_tuple;
+
+int cagmres_size[] = {7, 63};
+int cagmres_step[] = {1, 4, 8};
+int cagmres_basis[] = {0, 1, 2};
+std::string cagmres_precond[] = {"None", "Jacobi", "SGS", "ILU"};
+unsigned int cagmres_format[] = {1, 2, 4, 5, 6, 7, 8};
+
+class parameterized_cagmres : public testing::TestWithParam<cagmres_tuple>
+{
+    protected:
+    parameterized_cagmres() {}
+    virtual ~parameterized_cagmres() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_cagmres_arguments(cagmres_tuple tup)
+{
+    Arguments arg;
+    arg.size       = std::get<0>(tup);
+    arg.index      = std::get<1>(tup);
+    arg.basis      = std::get<2>(tup);
+    arg.precond    = std::get<3>(tup);
+    arg.format     = std::get<4>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_cagmres, cagmres_float)
+{
+    Arguments arg = setup_cagmres_arguments(GetParam());
+    ASSERT_EQ(testing_cagmres<float>(arg), true);
+}
+
+TEST_P(parameterized_cagmres, cagmres_double)
+{
+    Arguments arg = setup_cagmres_arguments(GetParam());
+    ASSERT_EQ(testing_cagmres<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(cagmres,
+                        parameterized_cagmres,
+                        testing::Combine(testing::ValuesIn(cagmres_size),
+                                         testing::ValuesIn(cagmres_step),
+                                         testing::ValuesIn(cagmres_basis),
+                                         testing::ValuesIn(cagmres_precond),
+                                         testing::ValuesIn(cagmres_format)));
@@ -0,0 +1,70 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_callback_operator.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, std::string> callback_operator_tuple;
+
+int callback_operator_size[] = {7, 63};
+std::string callback_operator_solver[] = {"CG", "FCG", "CR", "BiCGStab", "BiCGStabl", "QMRCGStab",
+                                          "GMRES", "FGMRES", "IDR", "CACG", "CAGMRES"};
+std::string callback_operator_precond[] = {"None", "Jacobi", "Chebyshev"};
+
+class parameterized_callback_operator : public testing::TestWithParam<callback_operator_tuple>
+{
+    protected:
+    parameterized_callback_operator() {}
+    virtual ~parameterized_callback_operator() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_callback_operator_arguments(callback_operator_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.solver  = std::get<1>(tup);
+    arg.precond = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_callback_operator, callback_operator_float)
+{
+    Arguments arg = setup_callback_operator_arguments(GetParam());
+    ASSERT_EQ(testing_callback_operator<float>(arg), true);
+}
+
+TEST_P(parameterized_callback_operator, callback_operator_double)
+{
+    Arguments arg = setup_callback_operator_arguments(GetParam());
+    ASSERT_EQ(testing_callback_operator<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(callback_operator,
+                        parameterized_callback_operator,
+                        testing::Combine(testing::ValuesIn(callback_operator_size),
+                                         testing::ValuesIn(callback_operator_solver),
+                                         testing::ValuesIn(callback_operator_precond)));
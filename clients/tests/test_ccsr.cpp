@@ -0,0 +1,67 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "testing_ccsr.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, unsigned int> ccsr_tuple;
+
+int ccsr_size[] = {7, 63};
+unsigned int ccsr_format[] = {9, 10};
+
+class parameterized_ccsr : public testing::TestWithParam<ccsr_tuple>
+{
+    protected:
+    parameterized_ccsr() {}
+    virtual ~parameterized_ccsr() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_ccsr_arguments(ccsr_tuple tup)
+{
+    Arguments arg;
+    arg.size   = std::get<0>(tup);
+    arg.format = std::get<1>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_ccsr, ccsr_float)
+{
+    Arguments arg = setup_ccsr_arguments(GetParam());
+    ASSERT_EQ(testing_ccsr<float>(arg), true);
+}
+
+TEST_P(parameterized_ccsr, ccsr_double)
+{
+    Arguments arg = setup_ccsr_arguments(GetParam());
+    ASSERT_EQ(testing_ccsr<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(ccsr,
+                        parameterized_ccsr,
+                        testing::Combine(testing::ValuesIn(ccsr_size),
+                                         testing::ValuesIn(ccsr_format)));
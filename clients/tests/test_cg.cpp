@@ -30,7 +30,13 @@ typedef std::tuple<int, std::string, unsigned int> cg_tuple;
 
 int cg_size[] = {7, 63};
 std::string cg_precond[] = {"None", "Chebyshev", "FSAI", "SPAI", "TNS", "Jacobi", "SGS", "ILU", "ILUT", "IC", "MCSGS", "MCILU"};
-unsigned int cg_format[] = {1, 2, 4, 5, 6, 7};
+unsigned int cg_format[] = {1, 2, 4, 5, 6, 7, 8};
+
+typedef std::tuple<int, std::string, int> cg_fused_tuple;
+
+int cg_fused_size[] = {7, 63};
+std::string cg_fused_precond[] = {"None", "Jacobi"};
+int cg_fused_threads[] = {1, 4};
 
 class parameterized_cg : public testing::TestWithParam<cg_tuple>
 {
@@ -50,6 +56,24 @@ Arguments setup_cg_arguments(cg_tuple tup)
     return arg;
 }
 
+class parameterized_cg_fused : public testing::TestWithParam<cg_fused_tuple>
+{
+    protected:
+    parameterized_cg_fused() {}
+    virtual ~parameterized_cg_fused() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_cg_fused_arguments(cg_fused_tuple tup)
+{
+    Arguments arg;
+    arg.size         = std::get<0>(tup);
+    arg.precond      = std::get<1>(tup);
+    arg.omp_nthreads = std::get<2>(tup);
+    return arg;
+}
+
 TEST_P(parameterized_cg, cg_float)
 {
     Arguments arg = setup_cg_arguments(GetParam());
@@ -67,3 +91,21 @@ INSTANTIATE_TEST_CASE_P(cg,
                         testing::Combine(testing::ValuesIn(cg_size),
                                          testing::ValuesIn(cg_precond),
                                          testing::ValuesIn(cg_format)));
+
+TEST_P(parameterized_cg_fused, cg_fused_float)
+{
+    Arguments arg = setup_cg_fused_arguments(GetParam());
+    ASSERT_EQ(testing_cg_fused<float>(arg), true);
+}
+
+TEST_P(parameterized_cg_fused, cg_fused_double)
+{
+    Arguments arg = setup_cg_fused_arguments(GetParam());
+    ASSERT_EQ(testing_cg_fused<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(cg_fused,
+                        parameterized_cg_fused,
+                        testing::Combine(testing::ValuesIn(cg_fused_size),
+                                         testing::ValuesIn(cg_fused_precond),
+                                         testing::ValuesIn(cg_fused_threads)));
@@ -0,0 +1,69 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_chebyshev.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, int> chebyshev_tuple;
+
+int chebyshev_size[] = {7, 63};
+std::string chebyshev_precond[] = {"None", "Jacobi"};
+int chebyshev_estimate[] = {0, 1};
+
+class parameterized_chebyshev : public testing::TestWithParam<chebyshev_tuple>
+{
+    protected:
+    parameterized_chebyshev() {}
+    virtual ~parameterized_chebyshev() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_chebyshev_arguments(chebyshev_tuple tup)
+{
+    Arguments arg;
+    arg.size     = std::get<0>(tup);
+    arg.precond  = std::get<1>(tup);
+    arg.estimate = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_chebyshev, chebyshev_float)
+{
+    Arguments arg = setup_chebyshev_arguments(GetParam());
+    ASSERT_EQ(testing_chebyshev<float>(arg), true);
+}
+
+TEST_P(parameterized_chebyshev, chebyshev_double)
+{
+    Arguments arg = setup_chebyshev_arguments(GetParam());
+    ASSERT_EQ(testing_chebyshev<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(chebyshev,
+                        parameterized_chebyshev,
+                        testing::Combine(testing::ValuesIn(chebyshev_size),
+                                         testing::ValuesIn(chebyshev_precond),
+                                         testing::ValuesIn(chebyshev_estimate)));
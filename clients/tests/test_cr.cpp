@@ -30,7 +30,7 @@ typedef std::tuple<int, std::string, unsigned int> cr_tuple;
 
 int cr_size[] = {7, 63};
 std::string cr_precond[] = {"None", "Chebyshev", "FSAI", "SPAI", "TNS", "Jacobi", "SGS", "ILU", "ILUT", "IC", "MCSGS", "MCILU"};
-unsigned int cr_format[] = {1, 2, 4, 5, 6, 7};
+unsigned int cr_format[] = {1, 2, 4, 5, 6, 7, 8};
 
 class parameterized_cr : public testing::TestWithParam<cr_tuple>
 {
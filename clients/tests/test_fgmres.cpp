@@ -31,7 +31,7 @@ typedef std::tuple<int, int, std::string, unsigned int> fgmres_tuple;
 int fgmres_size[] = {7, 63};
 int fgmres_basis[] = {20, 60};
 std::string fgmres_precond[] = {"None", "Chebyshev", "SPAI", "TNS", "Jacobi", "GS", "ILU", "ILUT", "MCGS", "MCILU"};
-unsigned int fgmres_format[] = {1, 2, 4, 5, 6, 7};
+unsigned int fgmres_format[] = {1, 2, 4, 5, 6, 7, 8};
 
 class parameterized_fgmres : public testing::TestWithParam<fgmres_tuple>
 {
@@ -0,0 +1,69 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_format_autotune.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, unsigned int, int> format_autotune_tuple;
+
+int format_autotune_size[] = {7, 63};
+unsigned int format_autotune_format[] = {1, 4, 6, 8};
+int format_autotune_benchmark[] = {0, 1};
+
+class parameterized_format_autotune : public testing::TestWithParam<format_autotune_tuple>
+{
+    protected:
+    parameterized_format_autotune() {}
+    virtual ~parameterized_format_autotune() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_format_autotune_arguments(format_autotune_tuple tup)
+{
+    Arguments arg;
+    arg.size      = std::get<0>(tup);
+    arg.format    = std::get<1>(tup);
+    arg.benchmark = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_format_autotune, format_autotune_float)
+{
+    Arguments arg = setup_format_autotune_arguments(GetParam());
+    ASSERT_EQ(testing_format_autotune<float>(arg), true);
+}
+
+TEST_P(parameterized_format_autotune, format_autotune_double)
+{
+    Arguments arg = setup_format_autotune_arguments(GetParam());
+    ASSERT_EQ(testing_format_autotune<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(format_autotune,
+                        parameterized_format_autotune,
+                        testing::Combine(testing::ValuesIn(format_autotune_size),
+                                         testing::ValuesIn(format_autotune_format),
+                                         testing::ValuesIn(format_autotune_benchmark)));
@@ -0,0 +1,76 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_geometric_multigrid.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string, int, int, unsigned int> gmg_tuple;
+
+int gmg_size[] = {16, 33};
+std::string gmg_solver[] = {"GMG", "CG"};
+int gmg_pre_iter[] = {1, 2};
+int gmg_post_iter[] = {2};
+
+unsigned int gmg_format[] = {Laplace2D, Laplace3D, Laplace3D19, Laplace3D27, GeneralStencil};
+
+class parameterized_geometric_multigrid : public testing::TestWithParam<gmg_tuple>
+{
+    protected:
+    parameterized_geometric_multigrid() {}
+    virtual ~parameterized_geometric_multigrid() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_gmg_arguments(gmg_tuple tup)
+{
+    Arguments arg;
+    arg.size        = std::get<0>(tup);
+    arg.solver      = std::get<1>(tup);
+    arg.pre_smooth  = std::get<2>(tup);
+    arg.post_smooth = std::get<3>(tup);
+    arg.format      = std::get<4>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_geometric_multigrid, geometric_multigrid_float)
+{
+    Arguments arg = setup_gmg_arguments(GetParam());
+    ASSERT_EQ(testing_geometric_multigrid<float>(arg), true);
+}
+
+TEST_P(parameterized_geometric_multigrid, geometric_multigrid_double)
+{
+    Arguments arg = setup_gmg_arguments(GetParam());
+    ASSERT_EQ(testing_geometric_multigrid<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(geometric_multigrid,
+                        parameterized_geometric_multigrid,
+                        testing::Combine(testing::ValuesIn(gmg_size),
+                                         testing::ValuesIn(gmg_solver),
+                                         testing::ValuesIn(gmg_pre_iter),
+                                         testing::ValuesIn(gmg_post_iter),
+                                         testing::ValuesIn(gmg_format)));
@@ -0,0 +1,98 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_global_l1.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+typedef std::tuple<int, std::string> global_l1_tuple;
+
+int global_l1_size[] = {7, 63};
+std::string global_l1_precond[] = {"L1Jacobi", "L1GS", "L1SGS", "PairwiseAMG"};
+
+class parameterized_global_l1_diagonal : public testing::TestWithParam<int>
+{
+    protected:
+    parameterized_global_l1_diagonal() {}
+    virtual ~parameterized_global_l1_diagonal() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_global_l1_diagonal_arguments(int size)
+{
+    Arguments arg;
+    arg.size = size;
+    return arg;
+}
+
+TEST_P(parameterized_global_l1_diagonal, global_l1_diagonal_float)
+{
+    Arguments arg = setup_global_l1_diagonal_arguments(GetParam());
+    ASSERT_EQ(testing_global_l1_diagonal<float>(arg), true);
+}
+
+TEST_P(parameterized_global_l1_diagonal, global_l1_diagonal_double)
+{
+    Arguments arg = setup_global_l1_diagonal_arguments(GetParam());
+    ASSERT_EQ(testing_global_l1_diagonal<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(global_l1_diagonal,
+                        parameterized_global_l1_diagonal,
+                        testing::ValuesIn(global_l1_size));
+
+class parameterized_global_l1 : public testing::TestWithParam<global_l1_tuple>
+{
+    protected:
+    parameterized_global_l1() {}
+    virtual ~parameterized_global_l1() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_global_l1_arguments(global_l1_tuple tup)
+{
+    Arguments arg;
+    arg.size    = std::get<0>(tup);
+    arg.precond = std::get<1>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_global_l1, global_l1_float)
+{
+    Arguments arg = setup_global_l1_arguments(GetParam());
+    ASSERT_EQ(testing_global_l1<float>(arg), true);
+}
+
+TEST_P(parameterized_global_l1, global_l1_double)
+{
+    Arguments arg = setup_global_l1_arguments(GetParam());
+    ASSERT_EQ(testing_global_l1<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(global_l1,
+                        parameterized_global_l1,
+                        testing::Combine(testing::ValuesIn(global_l1_size),
+                                         testing::ValuesIn(global_l1_precond)));
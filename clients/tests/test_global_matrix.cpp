@@ -62,6 +62,80 @@ TEST(global_matrix_bad_args, global_matrix)
 {
     testing_global_matrix_bad_args<float>();
 }
+
+typedef std::tuple<int> global_matrix_tuple;
+
+int global_matrix_size[] = {7, 63};
+
+class parameterized_global_matrix : public testing::TestWithParam<global_matrix_tuple>
+{
+    protected:
+    parameterized_global_matrix() {}
+    virtual ~parameterized_global_matrix() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_global_matrix_arguments(global_matrix_tuple tup)
+{
+    Arguments arg;
+    arg.size = std::get<0>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_global_matrix, transpose_mult_float)
+{
+    Arguments arg = setup_global_matrix_arguments(GetParam());
+    ASSERT_EQ(testing_global_matrix_transpose_mult<float>(arg), true);
+}
+
+TEST_P(parameterized_global_matrix, transpose_mult_double)
+{
+    Arguments arg = setup_global_matrix_arguments(GetParam());
+    ASSERT_EQ(testing_global_matrix_transpose_mult<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(global_matrix,
+                        parameterized_global_matrix,
+                        testing::Combine(testing::ValuesIn(global_matrix_size)));
+
+typedef std::tuple<int, unsigned int> global_matrix_apply_tuple;
+
+unsigned int global_matrix_apply_format[] = {CSR, ELL};
+
+class parameterized_global_matrix_apply : public testing::TestWithParam<global_matrix_apply_tuple>
+{
+    protected:
+    parameterized_global_matrix_apply() {}
+    virtual ~parameterized_global_matrix_apply() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_global_matrix_apply_arguments(global_matrix_apply_tuple tup)
+{
+    Arguments arg;
+    arg.size   = std::get<0>(tup);
+    arg.format = std::get<1>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_global_matrix_apply, apply_float)
+{
+    Arguments arg = setup_global_matrix_apply_arguments(GetParam());
+    ASSERT_EQ(testing_global_matrix_apply<float>(arg), true);
+}
+
+TEST_P(parameterized_global_matrix_apply, apply_double)
+{
+    Arguments arg = setup_global_matrix_apply_arguments(GetParam());
+    ASSERT_EQ(testing_global_matrix_apply<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(global_matrix_apply,
+                        parameterized_global_matrix_apply,
+                        testing::Combine(testing::ValuesIn(global_matrix_size),
+                                         testing::ValuesIn(global_matrix_apply_format)));
 /*
 TEST_P(parameterized_backend, backend)
 {
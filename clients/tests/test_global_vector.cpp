@@ -62,6 +62,52 @@ TEST(global_vector_bad_args, global_vector)
 {
     testing_global_vector_bad_args<float>();
 }
+
+int global_vector_size[] = {7, 63};
+
+class parameterized_global_vector : public testing::TestWithParam<int>
+{
+    protected:
+    parameterized_global_vector() {}
+    virtual ~parameterized_global_vector() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_global_vector_arguments(int size)
+{
+    Arguments arg;
+    arg.size = size;
+    return arg;
+}
+
+TEST_P(parameterized_global_vector, global_vector_multi_dot_float)
+{
+    Arguments arg = setup_global_vector_arguments(GetParam());
+    ASSERT_EQ(testing_global_vector_multi_dot<float>(arg), true);
+}
+
+TEST_P(parameterized_global_vector, global_vector_multi_dot_double)
+{
+    Arguments arg = setup_global_vector_arguments(GetParam());
+    ASSERT_EQ(testing_global_vector_multi_dot<double>(arg), true);
+}
+
+TEST_P(parameterized_global_vector, global_vector_multi_dot_async_float)
+{
+    Arguments arg = setup_global_vector_arguments(GetParam());
+    ASSERT_EQ(testing_global_vector_multi_dot_async<float>(arg), true);
+}
+
+TEST_P(parameterized_global_vector, global_vector_multi_dot_async_double)
+{
+    Arguments arg = setup_global_vector_arguments(GetParam());
+    ASSERT_EQ(testing_global_vector_multi_dot_async<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(global_vector,
+                        parameterized_global_vector,
+                        testing::ValuesIn(global_vector_size));
 /*
 TEST_P(parameterized_backend, backend)
 {
@@ -31,7 +31,7 @@ typedef std::tuple<int, int, std::string, unsigned int> gmres_tuple;
 int gmres_size[] = {7, 63};
 int gmres_basis[] = {20, 60};
 std::string gmres_precond[] = {"None", "Chebyshev", "SPAI", "TNS", "Jacobi", "GS", "ILU", "ILUT", "MCGS", "MCILU"};
-unsigned int gmres_format[] = {1, 2, 4, 5, 6, 7};
+unsigned int gmres_format[] = {1, 2, 4, 5, 6, 7, 8};
 
 class parameterized_gmres : public testing::TestWithParam<gmres_tuple>
 {
@@ -25,6 +25,87 @@
 #include "utility.hpp"
 
 #include <gtest/gtest.h>
+
+typedef std::tuple<int, int, unsigned int> extract_tuple;
+
+int extract_size[] = {7, 63};
+int extract_blocks[] = {1, 3, 16};
+unsigned int extract_format[] = {1, 4};
+
+class parameterized_extract_submatrices : public testing::TestWithParam<extract_tuple>
+{
+    protected:
+    parameterized_extract_submatrices() {}
+    virtual ~parameterized_extract_submatrices() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+typedef std::tuple<int, int> reordering_tuple;
+
+int reordering_size[] = {7, 63};
+int reordering_parts[] = {1, 2, 7, 16};
+
+class parameterized_reordering : public testing::TestWithParam<reordering_tuple>
+{
+    protected:
+    parameterized_reordering() {}
+    virtual ~parameterized_reordering() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+int restrict_size[] = {7, 63};
+int coo_spmv_size[] = {7, 63};
+
+class parameterized_restrict_residual : public testing::TestWithParam<int>
+{
+    protected:
+    parameterized_restrict_residual() {}
+    virtual ~parameterized_restrict_residual() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+class parameterized_coo_spmv : public testing::TestWithParam<int>
+{
+    protected:
+    parameterized_coo_spmv() {}
+    virtual ~parameterized_coo_spmv() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_reordering_arguments(reordering_tuple tup)
+{
+    Arguments arg;
+    arg.size  = std::get<0>(tup);
+    arg.index = std::get<1>(tup);
+    return arg;
+}
+
+Arguments setup_restrict_arguments(int size)
+{
+    Arguments arg;
+    arg.size = size;
+    return arg;
+}
+
+Arguments setup_coo_spmv_arguments(int size)
+{
+    Arguments arg;
+    arg.size = size;
+    return arg;
+}
+
+Arguments setup_extract_arguments(extract_tuple tup)
+{
+    Arguments arg;
+    arg.size   = std::get<0>(tup);
+    arg.index  = std::get<1>(tup);
+    arg.format = std::get<2>(tup);
+    return arg;
+}
 /*
 typedef std::tuple<int, int, int, int, bool, int, bool> backend_tuple;
 
@@ -62,6 +143,73 @@ TEST(local_matrix_bad_args, local_matrix)
 {
     testing_local_matrix_bad_args<float>();
 }
+
+TEST_P(parameterized_extract_submatrices, extract_submatrices_float)
+{
+    Arguments arg = setup_extract_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_extract_submatrices<float>(arg), true);
+}
+
+TEST_P(parameterized_extract_submatrices, extract_submatrices_double)
+{
+    Arguments arg = setup_extract_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_extract_submatrices<double>(arg), true);
+}
+
+TEST_P(parameterized_reordering, reordering_float)
+{
+    Arguments arg = setup_reordering_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_reordering<float>(arg), true);
+}
+
+TEST_P(parameterized_reordering, reordering_double)
+{
+    Arguments arg = setup_reordering_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_reordering<double>(arg), true);
+}
+
+TEST_P(parameterized_restrict_residual, restrict_residual_float)
+{
+    Arguments arg = setup_restrict_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_restrict_residual<float>(arg), true);
+}
+
+TEST_P(parameterized_restrict_residual, restrict_residual_double)
+{
+    Arguments arg = setup_restrict_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_restrict_residual<double>(arg), true);
+}
+
+TEST_P(parameterized_coo_spmv, coo_spmv_float)
+{
+    Arguments arg = setup_coo_spmv_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_coo_spmv<float>(arg), true);
+}
+
+TEST_P(parameterized_coo_spmv, coo_spmv_double)
+{
+    Arguments arg = setup_coo_spmv_arguments(GetParam());
+    ASSERT_EQ(testing_local_matrix_coo_spmv<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(coo_spmv,
+                        parameterized_coo_spmv,
+                        testing::ValuesIn(coo_spmv_size));
+
+INSTANTIATE_TEST_CASE_P(restrict_residual,
+                        parameterized_restrict_residual,
+                        testing::ValuesIn(restrict_size));
+
+INSTANTIATE_TEST_CASE_P(reordering,
+                        parameterized_reordering,
+                        testing::Combine(testing::ValuesIn(reordering_size),
+                                         testing::ValuesIn(reordering_parts)));
+
+INSTANTIATE_TEST_CASE_P(extract_submatrices,
+                        parameterized_extract_submatrices,
+                        testing::Combine(testing::ValuesIn(extract_size),
+                                         testing::ValuesIn(extract_blocks),
+                                         testing::ValuesIn(extract_format)));
 /*
 TEST_P(parameterized_backend, backend)
 {
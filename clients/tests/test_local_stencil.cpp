@@ -58,10 +58,53 @@ Arguments setup_backend_arguments(backend_tuple tup)
     return arg;
 }
 */
+typedef std::tuple<int, int, unsigned int> local_stencil_tuple;
+
+int local_stencil_size[] = {1, 5, 17};
+int local_stencil_sweep[] = {1, 3};
+unsigned int local_stencil_type[]
+    = {Laplace2D, Laplace3D, Laplace3D19, Laplace3D27, GeneralStencil};
+
+class parameterized_local_stencil : public testing::TestWithParam<local_stencil_tuple>
+{
+    protected:
+    parameterized_local_stencil() {}
+    virtual ~parameterized_local_stencil() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_local_stencil_arguments(local_stencil_tuple tup)
+{
+    Arguments arg;
+    arg.size       = std::get<0>(tup);
+    arg.pre_smooth = std::get<1>(tup);
+    arg.format     = std::get<2>(tup);
+    return arg;
+}
+
 TEST(local_stencil_bad_args, local_stencil)
 {
     testing_local_stencil_bad_args<float>();
 }
+
+TEST_P(parameterized_local_stencil, local_stencil_float)
+{
+    Arguments arg = setup_local_stencil_arguments(GetParam());
+    ASSERT_EQ(testing_local_stencil<float>(arg), true);
+}
+
+TEST_P(parameterized_local_stencil, local_stencil_double)
+{
+    Arguments arg = setup_local_stencil_arguments(GetParam());
+    ASSERT_EQ(testing_local_stencil<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(local_stencil,
+                        parameterized_local_stencil,
+                        testing::Combine(testing::ValuesIn(local_stencil_size),
+                                         testing::ValuesIn(local_stencil_sweep),
+                                         testing::ValuesIn(local_stencil_type)));
 /*
 TEST_P(parameterized_backend, backend)
 {
@@ -25,6 +25,28 @@
 #include "utility.hpp"
 
 #include <gtest/gtest.h>
+
+typedef std::tuple<int, int> random_tuple;
+
+int random_size[] = {1000, 100001};
+int random_omp_threads[] = {2, 4};
+
+class parameterized_local_vector_random : public testing::TestWithParam<random_tuple>
+{
+    protected:
+    parameterized_local_vector_random() {}
+    virtual ~parameterized_local_vector_random() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_random_arguments(random_tuple tup)
+{
+    Arguments arg;
+    arg.size         = std::get<0>(tup);
+    arg.omp_nthreads = std::get<1>(tup);
+    return arg;
+}
 /*
 typedef std::tuple<int, int, int, int, bool, int, bool> backend_tuple;
 
@@ -62,6 +84,28 @@ TEST(local_vector_bad_args, local_vector)
 {
     testing_local_vector_bad_args<float>();
 }
+
+TEST(local_vector_philox_kat, local_vector)
+{
+    ASSERT_EQ(testing_local_vector_philox_kat(), true);
+}
+
+TEST_P(parameterized_local_vector_random, random_float)
+{
+    Arguments arg = setup_random_arguments(GetParam());
+    ASSERT_EQ(testing_local_vector_random<float>(arg), true);
+}
+
+TEST_P(parameterized_local_vector_random, random_double)
+{
+    Arguments arg = setup_random_arguments(GetParam());
+    ASSERT_EQ(testing_local_vector_random<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(local_vector_random,
+                        parameterized_local_vector_random,
+                        testing::Combine(testing::ValuesIn(random_size),
+                                         testing::ValuesIn(random_omp_threads)));
 /*
 TEST_P(parameterized_backend, backend)
 {
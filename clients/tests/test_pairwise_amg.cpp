@@ -32,7 +32,7 @@ int pwamg_size[] = {63, 134};
 std::string pwamg_smoother[] = {"Jacobi", "MCILU"};
 int pwamg_pre_iter[] = {1, 2};
 int pwamg_post_iter[] = {1, 2};
-int pwamg_ordering[] = {0, 1, 2, 3, 4, 5};
+int pwamg_ordering[] = {0, 1, 2, 3, 4, 5, 6};
 
 unsigned int pwamg_format[] = {1, 7};
 
@@ -30,7 +30,7 @@ typedef std::tuple<int, std::string, unsigned int> qmrcgstab_tuple;
 
 int qmrcgstab_size[] = {7, 63};
 std::string qmrcgstab_precond[] = {"None", "Chebyshev", "SPAI", "TNS", "Jacobi", "GS", "ILU", "ILUT", "MCGS", "MCILU"};
-unsigned int qmrcgstab_format[] = {1, 2, 4, 5, 6, 7};
+unsigned int qmrcgstab_format[] = {1, 2, 4, 5, 6, 7, 8};
 
 class parameterized_qmrcgstab : public testing::TestWithParam<qmrcgstab_tuple>
 {
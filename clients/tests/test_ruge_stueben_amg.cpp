@@ -37,6 +37,13 @@ int rsamg_scaling[] = {0, 1};
 
 unsigned int rsamg_format[] = {1, 7};
 
+typedef std::tuple<int, int, int, int> rsamg_coarsening_tuple;
+
+int rsamg_coarsening_size[] = {63, 134};
+int rsamg_coarsening[] = {0, 1, 2};
+int rsamg_interpolation[] = {0, 1};
+int rsamg_aggressive[] = {0, 1};
+
 class parameterized_ruge_stueben_amg : public testing::TestWithParam<rsamg_tuple>
 {
     protected:
@@ -80,3 +87,42 @@ INSTANTIATE_TEST_CASE_P(ruge_stueben_amg,
                                          testing::ValuesIn(rsamg_format),
                                          testing::ValuesIn(rsamg_cycle),
                                          testing::ValuesIn(rsamg_scaling)));
+
+class parameterized_ruge_stueben_amg_coarsening
+    : public testing::TestWithParam<rsamg_coarsening_tuple>
+{
+    protected:
+    parameterized_ruge_stueben_amg_coarsening() {}
+    virtual ~parameterized_ruge_stueben_amg_coarsening() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_rsamg_coarsening_arguments(rsamg_coarsening_tuple tup)
+{
+    Arguments arg;
+    arg.size       = std::get<0>(tup);
+    arg.coarsening = std::get<1>(tup);
+    arg.cycle      = std::get<2>(tup);
+    arg.index      = std::get<3>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_ruge_stueben_amg_coarsening, ruge_stueben_amg_coarsening_float)
+{
+    Arguments arg = setup_rsamg_coarsening_arguments(GetParam());
+    ASSERT_EQ(testing_ruge_stueben_amg_coarsening<float>(arg), true);
+}
+
+TEST_P(parameterized_ruge_stueben_amg_coarsening, ruge_stueben_amg_coarsening_double)
+{
+    Arguments arg = setup_rsamg_coarsening_arguments(GetParam());
+    ASSERT_EQ(testing_ruge_stueben_amg_coarsening<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(ruge_stueben_amg_coarsening,
+                        parameterized_ruge_stueben_amg_coarsening,
+                        testing::Combine(testing::ValuesIn(rsamg_coarsening_size),
+                                         testing::ValuesIn(rsamg_coarsening),
+                                         testing::ValuesIn(rsamg_interpolation),
+                                         testing::ValuesIn(rsamg_aggressive)));
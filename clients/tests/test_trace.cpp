@@ -0,0 +1,59 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "testing_trace.hpp"
+#include "utility.hpp"
+
+#include <gtest/gtest.h>
+
+int trace_size[] = {7, 63};
+
+class parameterized_trace : public testing::TestWithParam<int>
+{
+    protected:
+    parameterized_trace() {}
+    virtual ~parameterized_trace() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_trace_arguments(int size)
+{
+    Arguments arg;
+    arg.size = size;
+    return arg;
+}
+
+TEST_P(parameterized_trace, trace_float)
+{
+    Arguments arg = setup_trace_arguments(GetParam());
+    ASSERT_EQ(testing_trace<float>(arg), true);
+}
+
+TEST_P(parameterized_trace, trace_double)
+{
+    Arguments arg = setup_trace_arguments(GetParam());
+    ASSERT_EQ(testing_trace<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(trace, parameterized_trace, testing::ValuesIn(trace_size));
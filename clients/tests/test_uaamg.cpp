@@ -37,6 +37,18 @@ int uaamg_scaling[] = {0, 1};
 
 unsigned int uaamg_format[] = {1, 6};
 
+typedef std::tuple<int, int, std::string> uaamg_aggregation_tuple;
+
+int uaamg_aggregation_size[] = {63, 134};
+int uaamg_aggregation[] = {0, 1};
+std::string uaamg_aggregation_precond[] = {"UAAMG", "SAAMG"};
+
+typedef std::tuple<int, std::string, std::string> uaamg_default_smoother_tuple;
+
+int uaamg_default_smoother_size[] = {63, 134};
+std::string uaamg_default_smoother[] = {"Chebyshev", "L1Jacobi", "Jacobi", "GS"};
+std::string uaamg_default_smoother_precond[] = {"UAAMG", "SAAMG"};
+
 class parameterized_uaamg : public testing::TestWithParam<uaamg_tuple>
 {
     protected:
@@ -80,3 +92,76 @@ INSTANTIATE_TEST_CASE_P(uaamg,
                                          testing::ValuesIn(uaamg_format),
                                          testing::ValuesIn(uaamg_cycle),
                                          testing::ValuesIn(uaamg_scaling)));
+
+class parameterized_uaamg_aggregation : public testing::TestWithParam<uaamg_aggregation_tuple>
+{
+    protected:
+    parameterized_uaamg_aggregation() {}
+    virtual ~parameterized_uaamg_aggregation() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_uaamg_aggregation_arguments(uaamg_aggregation_tuple tup)
+{
+    Arguments arg;
+    arg.size        = std::get<0>(tup);
+    arg.aggregation = std::get<1>(tup);
+    arg.precond     = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_uaamg_aggregation, uaamg_aggregation_float)
+{
+    Arguments arg = setup_uaamg_aggregation_arguments(GetParam());
+    ASSERT_EQ(testing_uaamg_aggregation<float>(arg), true);
+}
+
+TEST_P(parameterized_uaamg_aggregation, uaamg_aggregation_double)
+{
+    Arguments arg = setup_uaamg_aggregation_arguments(GetParam());
+    ASSERT_EQ(testing_uaamg_aggregation<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(uaamg_aggregation,
+                        parameterized_uaamg_aggregation,
+                        testing::Combine(testing::ValuesIn(uaamg_aggregation_size),
+                                         testing::ValuesIn(uaamg_aggregation),
+                                         testing::ValuesIn(uaamg_aggregation_precond)));
+
+class parameterized_uaamg_default_smoother
+    : public testing::TestWithParam<uaamg_default_smoother_tuple>
+{
+    protected:
+    parameterized_uaamg_default_smoother() {}
+    virtual ~parameterized_uaamg_default_smoother() {}
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+Arguments setup_uaamg_default_smoother_arguments(uaamg_default_smoother_tuple tup)
+{
+    Arguments arg;
+    arg.size     = std::get<0>(tup);
+    arg.smoother = std::get<1>(tup);
+    arg.precond  = std::get<2>(tup);
+    return arg;
+}
+
+TEST_P(parameterized_uaamg_default_smoother, uaamg_default_smoother_float)
+{
+    Arguments arg = setup_uaamg_default_smoother_arguments(GetParam());
+    ASSERT_EQ(testing_uaamg_default_smoother<float>(arg), true);
+}
+
+TEST_P(parameterized_uaamg_default_smoother, uaamg_default_smoother_double)
+{
+    Arguments arg = setup_uaamg_default_smoother_arguments(GetParam());
+    ASSERT_EQ(testing_uaamg_default_smoother<double>(arg), true);
+}
+
+INSTANTIATE_TEST_CASE_P(uaamg_default_smoother,
+                        parameterized_uaamg_default_smoother,
+                        testing::Combine(testing::ValuesIn(uaamg_default_smoother_size),
+                                         testing::ValuesIn(uaamg_default_smoother),
+                                         testing::ValuesIn(uaamg_default_smoother_precond)));
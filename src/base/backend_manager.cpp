@@ -33,11 +33,14 @@
 #include "host/host_matrix_coo.hpp"
 #include "host/host_matrix_dia.hpp"
 #include "host/host_matrix_ell.hpp"
+#include "host/host_matrix_sell.hpp"
+#include "host/host_matrix_ccsr.hpp"
 #include "host/host_matrix_hyb.hpp"
 #include "host/host_matrix_dense.hpp"
 #include "host/host_matrix_mcsr.hpp"
 #include "host/host_matrix_bcsr.hpp"
 #include "../utils/log.hpp"
+#include "../utils/trace.hpp"
 
 #include <stdlib.h>
 #include <string.h>
@@ -71,6 +74,8 @@ Rocalution_Backend_Descriptor _Backend_Descriptor = {
     -1,    // pre-init OpenMP threads
     0,     // pre-init OpenMP threads
     true,  // host affinity (active)
+    false, // host NUMA placement (inactive)
+    1,     // NUMA nodes
     10000, // threshold size
     // HIP section
     NULL,  // *HIP_blas_handle
@@ -131,6 +136,7 @@ int init_rocalution(int rank, int dev_per_node)
     }
 
     _rocalution_open_log_file();
+    _rocalution_init_trace();
 
     log_debug(0, "init_rocalution()", "* begin", rank, dev_per_node);
 
@@ -154,7 +160,15 @@ int init_rocalution(int rank, int dev_per_node)
     // the default in rocALUTION is 0
     omp_set_nested(0);
 
-    rocalution_set_omp_affinity(_get_backend_descriptor()->OpenMP_affinity);
+    if(_get_backend_descriptor()->OpenMP_numa == true)
+    {
+        _get_backend_descriptor()->OpenMP_numa_nodes =
+            rocalution_set_omp_numa_affinity(_get_backend_descriptor()->OpenMP_threads);
+    }
+    else
+    {
+        rocalution_set_omp_affinity(_get_backend_descriptor()->OpenMP_affinity);
+    }
 #else
     _get_backend_descriptor()->OpenMP_threads = 1;
 #endif
@@ -222,6 +236,8 @@ int stop_rocalution(void)
     omp_set_nested(_get_backend_descriptor()->OpenMP_def_nested);
 #endif
 
+    _rocalution_stop_trace();
+
     _get_backend_descriptor()->init = false;
 
     log_debug(0, "stop_rocalution()", "* end");
@@ -244,7 +260,14 @@ void set_omp_threads_rocalution(int nthreads)
 
 #if defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__)
 
-    rocalution_set_omp_affinity(_get_backend_descriptor()->OpenMP_affinity);
+    if(_get_backend_descriptor()->OpenMP_numa == true)
+    {
+        _get_backend_descriptor()->OpenMP_numa_nodes = rocalution_set_omp_numa_affinity(nthreads);
+    }
+    else
+    {
+        rocalution_set_omp_affinity(_get_backend_descriptor()->OpenMP_affinity);
+    }
 
 #endif // linux
 
@@ -315,6 +338,11 @@ void info_rocalution(const struct Rocalution_Backend_Descriptor backend_descript
 
 #ifdef _OPENMP
     LOG_INFO("OpenMP threads:" << backend_descriptor.OpenMP_threads);
+
+    if(backend_descriptor.OpenMP_numa == true)
+    {
+        LOG_INFO("OpenMP NUMA nodes:" << backend_descriptor.OpenMP_numa_nodes);
+    }
 #else
     LOG_INFO("No OpenMP support");
 #endif
@@ -375,6 +403,13 @@ void set_omp_affinity_rocalution(bool affinity)
     _get_backend_descriptor()->OpenMP_affinity = affinity;
 }
 
+void set_omp_numa_rocalution(bool numa)
+{
+    assert(_get_backend_descriptor()->init == false);
+
+    _get_backend_descriptor()->OpenMP_numa = numa;
+}
+
 void set_omp_threshold_rocalution(int threshold)
 {
     assert(_get_backend_descriptor()->init == true);
@@ -468,6 +503,9 @@ _rocalution_init_base_host_matrix(const struct Rocalution_Backend_Descriptor bac
     case DENSE: return new HostMatrixDENSE<ValueType>(backend_descriptor); break;
     case MCSR: return new HostMatrixMCSR<ValueType>(backend_descriptor); break;
     case BCSR: return new HostMatrixBCSR<ValueType>(backend_descriptor); break;
+    case SELL: return new HostMatrixSELL<ValueType>(backend_descriptor); break;
+    case CCSR: return new HostMatrixCCSR<ValueType>(backend_descriptor, false); break;
+    case CCSRBF16: return new HostMatrixCCSR<ValueType>(backend_descriptor, true); break;
     default: return NULL;
     }
 }
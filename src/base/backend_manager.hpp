@@ -59,6 +59,10 @@ struct Rocalution_Backend_Descriptor
     int OpenMP_def_nested;
     // Host affinity (true-yes/false-no)
     bool OpenMP_affinity;
+    // Host NUMA placement (true-yes/false-no)
+    bool OpenMP_numa;
+    // Number of NUMA nodes the host threads are bound to
+    int OpenMP_numa_nodes;
     // Host threshold size
     int OpenMP_threshold;
 
@@ -199,6 +203,47 @@ void set_omp_threads_rocalution(int nthreads);
   */
 void set_omp_affinity_rocalution(bool affinity);
 
+/** \ingroup backend_module
+  * \brief Enable/disable OpenMP NUMA placement
+  * \details
+  * \p set_omp_numa_rocalution enables / disables the NUMA mode of the host backend. In
+  * NUMA mode, the OpenMP threads are bound in contiguous blocks to the NUMA nodes (e.g.
+  * on a 2 socket system, the first half of the threads runs on the first socket and the
+  * second half on the second socket). All host kernels process vectors and matrix rows
+  * with a static schedule and host objects first touch their data with the same
+  * schedule when they are allocated or copied. Thus, every socket owns a contiguous
+  * block of rows of all matrices and vectors, that is placed in its local memory and
+  * processed by its own threads. The NUMA mode replaces the thread affinity set by
+  * set_omp_affinity_rocalution(). It has to be called before init_rocalution().
+  *
+  * To minimize the vector entries that have to be read from remote sockets, the
+  * unknowns should be reordered such that the coupling between the row blocks is small,
+  * e.g. using LocalMatrix::KWayPartitioning() with one part per socket.
+  *
+  * \note
+  * The NUMA mode is available only for Linux. If a single NUMA node is detected, the
+  * default thread affinity is used.
+  *
+  * @param[in]
+  * numa    boolean to turn on/off OpenMP NUMA placement
+  *
+  * \par Example
+  * \code{.cpp}
+  *   set_omp_numa_rocalution(true);
+  *   init_rocalution();
+  *
+  *   // Reorder for a 2 socket system
+  *   LocalVector<int> perm;
+  *   int* size = NULL;
+  *
+  *   mat.KWayPartitioning(2, &size, &perm);
+  *   mat.Permute(perm);
+  *
+  *   free_host(&size);
+  * \endcode
+  */
+void set_omp_numa_rocalution(bool numa);
+
 /** \ingroup backend_module
   * \brief Set OpenMP threshold size
   * \details
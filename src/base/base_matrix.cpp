@@ -251,6 +251,16 @@ bool BaseMatrix<ValueType>::ExtractSubMatrix(
     return false;
 }
 
+template <typename ValueType>
+bool BaseMatrix<ValueType>::ExtractSubMatrices(int row_num_blocks,
+                                               int col_num_blocks,
+                                               const int* row_offset,
+                                               const int* col_offset,
+                                               BaseMatrix<ValueType>** mat) const
+{
+    return false;
+}
+
 template <typename ValueType>
 bool BaseMatrix<ValueType>::ExtractL(BaseMatrix<ValueType>* L) const
 {
@@ -345,6 +355,20 @@ bool BaseMatrix<ValueType>::ConnectivityOrder(BaseVector<int>* permutation) cons
     return false;
 }
 
+template <typename ValueType>
+bool BaseMatrix<ValueType>::KWayPartitioning(int num_parts,
+                                             int** size_parts,
+                                             BaseVector<int>* permutation) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseMatrix<ValueType>::NestedDissection(BaseVector<int>* permutation) const
+{
+    return false;
+}
+
 template <typename ValueType>
 bool BaseMatrix<ValueType>::MultiColoring(int& num_colors,
                                           int** size_colors,
@@ -398,6 +422,47 @@ bool BaseMatrix<ValueType>::Gershgorin(ValueType& lambda_min, ValueType& lambda_
     return false;
 }
 
+template <typename ValueType>
+bool BaseMatrix<ValueType>::ApplyRows(int nrow,
+                                      const int* rows,
+                                      const BaseVector<ValueType>& in,
+                                      BaseVector<ValueType>* out) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseMatrix<ValueType>::ApplyMulti(int k,
+                                       const BaseVector<ValueType>& in,
+                                       BaseVector<ValueType>* out) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseMatrix<ValueType>::RestrictResidual(const BaseMatrix<ValueType>& A,
+                                             const BaseVector<ValueType>& b,
+                                             const BaseVector<ValueType>& x,
+                                             bool residual,
+                                             BaseVector<ValueType>* s,
+                                             BaseVector<ValueType>* out) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseMatrix<ValueType>::CGIterations(const BaseVector<ValueType>* inv_diag,
+                                         ValueType rho,
+                                         bool (*check)(double res, void* data),
+                                         void* data,
+                                         BaseVector<ValueType>* x,
+                                         BaseVector<ValueType>* r,
+                                         BaseVector<ValueType>* p,
+                                         BaseVector<ValueType>* q) const
+{
+    return false;
+}
+
 template <typename ValueType>
 bool BaseMatrix<ValueType>::Scale(ValueType alpha)
 {
@@ -528,6 +593,26 @@ bool BaseMatrix<ValueType>::USolve(const BaseVector<ValueType>& in,
     return false;
 }
 
+template <typename ValueType>
+bool BaseMatrix<ValueType>::MultiColoredLSweep(int num_colors,
+                                               const int* color_offsets,
+                                               bool diag_unit,
+                                               ValueType omega,
+                                               BaseVector<ValueType>* x) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseMatrix<ValueType>::MultiColoredUSweep(int num_colors,
+                                               const int* color_offsets,
+                                               bool diag_unit,
+                                               ValueType omega,
+                                               BaseVector<ValueType>* x) const
+{
+    return false;
+}
+
 template <typename ValueType>
 bool BaseMatrix<ValueType>::NumericMatMatMult(const BaseMatrix<ValueType>& A,
                                               const BaseMatrix<ValueType>& B)
@@ -555,6 +640,13 @@ bool BaseMatrix<ValueType>::AMGAggregate(const BaseVector<int>& connections,
     return false;
 }
 
+template <typename ValueType>
+bool BaseMatrix<ValueType>::AMGMIS2Aggregate(const BaseVector<int>& connections,
+                                             BaseVector<int>* aggregates) const
+{
+    return false;
+}
+
 template <typename ValueType>
 bool BaseMatrix<ValueType>::AMGSmoothedAggregation(ValueType relax,
                                                    const BaseVector<int>& aggregates,
@@ -581,6 +673,19 @@ bool BaseMatrix<ValueType>::RugeStueben(ValueType eps,
     return false;
 }
 
+template <typename ValueType>
+bool BaseMatrix<ValueType>::RugeStueben(ValueType eps,
+                                        int coarsening,
+                                        int interpolation,
+                                        bool aggressive,
+                                        ValueType trunc_factor,
+                                        int trunc_max_elements,
+                                        BaseMatrix<ValueType>* prolong,
+                                        BaseMatrix<ValueType>* restrict) const
+{
+    return false;
+}
+
 template <typename ValueType>
 bool BaseMatrix<ValueType>::InitialPairwiseAggregation(ValueType beta,
                                                        int& nc,
@@ -741,6 +846,15 @@ bool BaseMatrix<ValueType>::Key(long int& row_key, long int& col_key, long int&
     return false;
 }
 
+template <typename ValueType>
+bool BaseMatrix<ValueType>::AnalyseStructure(int* max_row_nnz,
+                                             double* row_nnz_var,
+                                             int* num_diag,
+                                             int* block_dim) const
+{
+    return false;
+}
+
 template <typename ValueType>
 void BaseMatrix<ValueType>::SetDataPtrCOO(
     int** row, int** col, ValueType** val, int nnz, int nrow, int ncol)
@@ -52,6 +52,10 @@ template <typename ValueType>
 class HostMatrixMCSR;
 template <typename ValueType>
 class HostMatrixBCSR;
+template <typename ValueType>
+class HostMatrixSELL;
+template <typename ValueType>
+class HostMatrixCCSR;
 
 template <typename ValueType>
 class HIPAcceleratorMatrixCSR;
@@ -167,6 +171,13 @@ class BaseMatrix
                                   int row_size,
                                   int col_size,
                                   BaseMatrix<ValueType>* mat) const;
+    /// Extract array of non-overlapping sub-matrices, mat is stored row-major with
+    /// row_num_blocks x col_num_blocks entries
+    virtual bool ExtractSubMatrices(int row_num_blocks,
+                                    int col_num_blocks,
+                                    const int* row_offset,
+                                    const int* col_offset,
+                                    BaseMatrix<ValueType>** mat) const;
 
     /// Extract the diagonal values of the matrix into a LocalVector
     virtual bool ExtractDiagonal(BaseVector<ValueType>* vec_diag) const;
@@ -193,6 +204,13 @@ class BaseMatrix
     virtual bool RCMK(BaseVector<int>* permutation) const;
     /// Create permutation vector for connectivity reordering of the matrix (increasing nnz per row)
     virtual bool ConnectivityOrder(BaseVector<int>* permutation) const;
+    /// Create permutation vector for a k-way partitioning of the matrix graph; Returns
+    /// the sizes of the parts (the array is allocated in the function) and the
+    /// permutation, that numbers the nodes of each part contiguously
+    virtual bool
+    KWayPartitioning(int num_parts, int** size_parts, BaseVector<int>* permutation) const;
+    /// Create permutation vector for nested dissection reordering of the matrix
+    virtual bool NestedDissection(BaseVector<int>* permutation) const;
 
     /// Perform multi-coloring decomposition of the matrix; Returns number of
     /// colors, the corresponding sizes (the array is allocated in the function)
@@ -337,6 +355,23 @@ class BaseMatrix
     /// graph traversing is performed in parallel
     virtual bool USolve(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
 
+    /// Perform a multi-colored forward sweep in place on a matrix, whose rows are
+    /// ordered by colors; for each color c in ascending order
+    /// x_c = (x_c - A_c,<c x_<c) / (omega * D_c);
+    /// diag_unit == true treats the diagonal as identity and omega is ignored
+    virtual bool MultiColoredLSweep(int num_colors,
+                                    const int* color_offsets,
+                                    bool diag_unit,
+                                    ValueType omega,
+                                    BaseVector<ValueType>* x) const;
+    /// Perform a multi-colored backward sweep in place, for each color c in descending
+    /// order x_c = (x_c - A_c,>c x_>c) / (omega * D_c) (see MultiColoredLSweep)
+    virtual bool MultiColoredUSweep(int num_colors,
+                                    const int* color_offsets,
+                                    bool diag_unit,
+                                    ValueType omega,
+                                    BaseVector<ValueType>* x) const;
+
     /// Compute Householder vector
     virtual bool Householder(int idx, ValueType& beta, BaseVector<ValueType>* vec) const;
     /// QR Decomposition
@@ -356,6 +391,37 @@ class BaseMatrix
     virtual void ApplyAdd(const BaseVector<ValueType>& in,
                           ValueType scalar,
                           BaseVector<ValueType>* out) const = 0;
+    /// Apply the matrix rows listed in the host array rows to vector,
+    /// out[rows[i]] = (this*in)[rows[i]]; all other entries of out remain unchanged
+    virtual bool ApplyRows(int nrow,
+                           const int* rows,
+                           const BaseVector<ValueType>& in,
+                           BaseVector<ValueType>* out) const;
+    /// Apply the matrix to k vectors stored row-major interleaved in a multi-vector,
+    /// out(:,j) = this*in(:,j) for all columns j;
+    /// each matrix entry is read once for all k columns
+    virtual bool
+    ApplyMulti(int k, const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+    /// Restrict the residual of A, out = this*(b - A*x); s = b - A*x if residual == true,
+    /// otherwise s is a buffer and does not necessarily hold the residual on return
+    virtual bool RestrictResidual(const BaseMatrix<ValueType>& A,
+                                  const BaseVector<ValueType>& b,
+                                  const BaseVector<ValueType>& x,
+                                  bool residual,
+                                  BaseVector<ValueType>* s,
+                                  BaseVector<ValueType>* out) const;
+    /// Perform (Jacobi preconditioned) CG iterations in a single parallel region,
+    /// starting from residual r, search direction p and rho = (r,z), until
+    /// check(|r|_2, data) returns true; inv_diag is the inverse diagonal of the
+    /// preconditioner (NULL if there is none), q is used as buffer
+    virtual bool CGIterations(const BaseVector<ValueType>* inv_diag,
+                              ValueType rho,
+                              bool (*check)(double res, void* data),
+                              void* data,
+                              BaseVector<ValueType>* x,
+                              BaseVector<ValueType>* r,
+                              BaseVector<ValueType>* p,
+                              BaseVector<ValueType>* q) const;
 
     /// Delete all entries abs(a_ij) <= drop_off;
     /// the diagonal elements are never deleted
@@ -370,6 +436,13 @@ class BaseMatrix
     // Return key for row, col and val
     virtual bool Key(long int& row_key, long int& col_key, long int& val_key) const;
 
+    /// Analyse the sparsity structure - maximum and variance of the row lengths, number
+    /// of occupied diagonals and natural block dimension (1 if no dense blocks are found)
+    virtual bool AnalyseStructure(int* max_row_nnz,
+                                  double* row_nnz_var,
+                                  int* num_diag,
+                                  int* block_dim) const;
+
     /// Replace a column vector of a matrix
     virtual bool ReplaceColumnVector(int idx, const BaseVector<ValueType>& vec);
 
@@ -385,6 +458,8 @@ class BaseMatrix
     virtual bool AMGConnect(ValueType eps, BaseVector<int>* connections) const;
     virtual bool AMGAggregate(const BaseVector<int>& connections,
                               BaseVector<int>* aggregates) const;
+    virtual bool AMGMIS2Aggregate(const BaseVector<int>& connections,
+                                  BaseVector<int>* aggregates) const;
     virtual bool AMGSmoothedAggregation(ValueType relax,
                                         const BaseVector<int>& aggregates,
                                         const BaseVector<int>& connections,
@@ -398,6 +473,16 @@ class BaseMatrix
     virtual bool RugeStueben(ValueType eps,
                              BaseMatrix<ValueType>* prolong,
                              BaseMatrix<ValueType>* restrict) const;
+    /// Ruge Stüben coarsening with selectable C/F splitting, interpolation, aggressive
+    /// coarsening and interpolation truncation
+    virtual bool RugeStueben(ValueType eps,
+                             int coarsening,
+                             int interpolation,
+                             bool aggressive,
+                             ValueType trunc_factor,
+                             int trunc_max_elements,
+                             BaseMatrix<ValueType>* prolong,
+                             BaseMatrix<ValueType>* restrict) const;
 
     /// Factorized Sparse Approximate Inverse assembly for given system
     /// matrix power pattern or external sparsity pattern
@@ -39,6 +39,10 @@ BaseStencil<ValueType>::BaseStencil()
 
     this->ndim_ = 0;
     this->size_ = 0;
+
+    this->grid_[0] = 0;
+    this->grid_[1] = 0;
+    this->grid_[2] = 0;
 }
 
 template <typename ValueType>
@@ -56,7 +60,7 @@ int BaseStencil<ValueType>::GetM(void) const
     {
         for(int i = 0; i < ndim_; ++i)
         {
-            dim *= this->size_;
+            dim *= this->grid_[i];
         }
     }
 
@@ -75,6 +79,14 @@ int BaseStencil<ValueType>::GetNDim(void) const
     return this->ndim_;
 }
 
+template <typename ValueType>
+int BaseStencil<ValueType>::GetGridSize(int dim) const
+{
+    assert(dim >= 0 && dim < 3);
+
+    return this->grid_[dim];
+}
+
 template <typename ValueType>
 void BaseStencil<ValueType>::set_backend(const Rocalution_Backend_Descriptor local_backend)
 {
@@ -86,6 +98,70 @@ void BaseStencil<ValueType>::SetGrid(int size)
 {
     assert(size >= 0);
     this->size_ = size;
+
+    for(int i = 0; i < 3; ++i)
+    {
+        this->grid_[i] = (i < this->ndim_) ? size : 1;
+    }
+}
+
+template <typename ValueType>
+void BaseStencil<ValueType>::SetGrid(int nx, int ny, int nz)
+{
+    assert(nx >= 0);
+    assert(ny >= 0);
+    assert(nz >= 0);
+
+    this->size_ = nx;
+
+    this->grid_[0] = nx;
+    this->grid_[1] = ny;
+    this->grid_[2] = nz;
+}
+
+template <typename ValueType>
+bool BaseStencil<ValueType>::SetStencil(int ndim,
+                                        int npoint,
+                                        const int* offset,
+                                        const ValueType* coef)
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseStencil<ValueType>::SetCoefficients(const ValueType* coef)
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseStencil<ValueType>::Smooth(const BaseVector<ValueType>& rhs,
+                                    int nsweep,
+                                    const ValueType* omega,
+                                    BaseVector<ValueType>* x) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseStencil<ValueType>::Coarsen(bool galerkin, BaseStencil<ValueType>* coarse) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseStencil<ValueType>::ResidualRestrict(const BaseVector<ValueType>& rhs,
+                                              const BaseVector<ValueType>& x,
+                                              BaseVector<ValueType>* res) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseStencil<ValueType>::ProlongAdd(const BaseVector<ValueType>& cor,
+                                        BaseVector<ValueType>* x) const
+{
+    return false;
 }
 
 template <typename ValueType>
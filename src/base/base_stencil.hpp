@@ -36,7 +36,7 @@ template <typename ValueType>
 class HIPAcceleratorVector;
 
 template <typename ValueType>
-class HostStencilLaplace2D;
+class HostStencilGeneral;
 template <typename ValueType>
 class HIPAcceleratorStencil;
 template <typename ValueType>
@@ -63,10 +63,33 @@ class BaseStencil
     virtual void Info(void) const = 0;
     /// Return the stencil format id (see stencil_formats.hpp)
     virtual unsigned int GetStencilId(void) const = 0;
+    /// Return the grid size in dimension dim (0 = x, 1 = y, 2 = z)
+    int GetGridSize(int dim) const;
     /// Copy the backend descriptor information
     virtual void set_backend(const Rocalution_Backend_Descriptor local_backend);
     // Set the grid size
     virtual void SetGrid(int size);
+    /// Set the grid size in each dimension
+    virtual void SetGrid(int nx, int ny, int nz);
+
+    /// Set the stencil offsets (npoint x ndim) and the constant coefficients
+    virtual bool SetStencil(int ndim, int npoint, const int* offset, const ValueType* coef);
+    /// Set variable coefficients, coef[k * m + i] is the coefficient of stencil point k
+    /// at grid point i
+    virtual bool SetCoefficients(const ValueType* coef);
+    /// Perform nsweep weighted Jacobi sweeps, x = x + omega[k] D^-1 (rhs - this*x)
+    virtual bool Smooth(const BaseVector<ValueType>& rhs,
+                        int nsweep,
+                        const ValueType* omega,
+                        BaseVector<ValueType>* x) const;
+    /// Build the coarse grid stencil, by Galerkin product or by rediscretization
+    virtual bool Coarsen(bool galerkin, BaseStencil<ValueType>* coarse) const;
+    /// Restrict the residual to the coarse grid, res = R (rhs - this*x)
+    virtual bool ResidualRestrict(const BaseVector<ValueType>& rhs,
+                                  const BaseVector<ValueType>& x,
+                                  BaseVector<ValueType>* res) const;
+    /// Prolongate and add a coarse grid correction, x = x + P cor
+    virtual bool ProlongAdd(const BaseVector<ValueType>& cor, BaseVector<ValueType>* x) const;
 
     /// Apply the stencil to vector, out = this*in;
     virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const = 0;
@@ -80,6 +103,8 @@ class BaseStencil
     int ndim_;
     /// Number of columns
     int size_;
+    /// Grid size in each dimension
+    int grid_[3];
 
     /// Backend descriptor (local copy)
     Rocalution_Backend_Descriptor local_backend_;
@@ -120,6 +120,40 @@ bool BaseVector<ValueType>::Prolongation(const BaseVector<ValueType>& vec_coarse
     return false;
 }
 
+template <typename ValueType>
+bool BaseVector<ValueType>::BlockDot(int k,
+                                     const BaseVector<ValueType>& x,
+                                     int kx,
+                                     ValueType* result) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseVector<ValueType>::BlockUpdate(
+    int k, ValueType beta, const BaseVector<ValueType>& x, int kx, const ValueType* coef)
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseVector<ValueType>::BlockNorm(int k, ValueType* norms) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseVector<ValueType>::ExtractColumn(int k, int j, BaseVector<ValueType>* vec) const
+{
+    return false;
+}
+
+template <typename ValueType>
+bool BaseVector<ValueType>::InsertColumn(int k, int j, const BaseVector<ValueType>& vec)
+{
+    return false;
+}
+
 template <typename ValueType>
 void BaseVector<ValueType>::CopyFromAsync(const BaseVector<ValueType>& vec)
 {
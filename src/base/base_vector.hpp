@@ -153,6 +153,22 @@ class BaseVector
     virtual void PointWiseMult(const BaseVector<ValueType>& x, const BaseVector<ValueType>& y) = 0;
     virtual void Power(double power) = 0;
 
+    /// Compute the block dot product of two multi-vectors, stored row-major interleaved
+    /// with k (this) and kx (x) columns; result = this^H x (column-major k x kx)
+    virtual bool
+    BlockDot(int k, const BaseVector<ValueType>& x, int kx, ValueType* result) const;
+    /// Perform multi-vector update of type this = beta*this + x*coef, where this has k
+    /// and x has kx interleaved columns and coef is a column-major kx x k matrix;
+    /// this is not read if beta == 0
+    virtual bool BlockUpdate(
+        int k, ValueType beta, const BaseVector<ValueType>& x, int kx, const ValueType* coef);
+    /// Compute the L2 norm of each of the k interleaved columns
+    virtual bool BlockNorm(int k, ValueType* norms) const;
+    /// Copy column j of the k interleaved columns into vec
+    virtual bool ExtractColumn(int k, int j, BaseVector<ValueType>* vec) const;
+    /// Copy vec into column j of the k interleaved columns
+    virtual bool InsertColumn(int k, int j, const BaseVector<ValueType>& vec);
+
     /// Sets index array
     virtual void SetIndexArray(int size, const int* index) = 0;
     /// Gets index values
@@ -0,0 +1,351 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../utils/def.hpp"
+#include "global_callback_operator.hpp"
+#include "global_vector.hpp"
+#include "local_vector.hpp"
+#include "backend_manager.hpp"
+
+#include "../utils/log.hpp"
+#include "../utils/trace.hpp"
+
+#include <complex>
+#include <string>
+
+namespace rocalution {
+
+template <typename ValueType>
+GlobalCallbackOperator<ValueType>::GlobalCallbackOperator()
+{
+    log_debug(this, "GlobalCallbackOperator::GlobalCallbackOperator()");
+
+#ifndef SUPPORT_MULTINODE
+    LOG_INFO("Multinode support disabled");
+    FATAL_ERROR(__FILE__, __LINE__);
+#endif
+
+    this->object_name_ = "";
+
+    this->apply_  = NULL;
+    this->diag_   = NULL;
+    this->data_   = NULL;
+    this->accel_  = false;
+    this->buffer_ = NULL;
+}
+
+template <typename ValueType>
+GlobalCallbackOperator<ValueType>::GlobalCallbackOperator(const ParallelManager& pm)
+{
+    log_debug(this, "GlobalCallbackOperator::GlobalCallbackOperator()", (const void*&)pm);
+
+    assert(pm.Status() == true);
+
+    this->object_name_ = "";
+
+    this->pm_ = &pm;
+
+    this->apply_  = NULL;
+    this->diag_   = NULL;
+    this->data_   = NULL;
+    this->accel_  = false;
+    this->buffer_ = NULL;
+}
+
+template <typename ValueType>
+GlobalCallbackOperator<ValueType>::~GlobalCallbackOperator()
+{
+    log_debug(this, "GlobalCallbackOperator::~GlobalCallbackOperator()");
+
+    this->Clear();
+}
+
+template <typename ValueType>
+IndexType2 GlobalCallbackOperator<ValueType>::GetM(void) const
+{
+    return this->pm_->GetGlobalSize();
+}
+
+template <typename ValueType>
+IndexType2 GlobalCallbackOperator<ValueType>::GetN(void) const
+{
+    return this->pm_->GetGlobalSize();
+}
+
+template <typename ValueType>
+IndexType2 GlobalCallbackOperator<ValueType>::GetNnz(void) const
+{
+    // The operator is not stored
+    return 0;
+}
+
+template <typename ValueType>
+int GlobalCallbackOperator<ValueType>::GetLocalM(void) const
+{
+    return this->pm_->GetLocalSize();
+}
+
+template <typename ValueType>
+int GlobalCallbackOperator<ValueType>::GetLocalN(void) const
+{
+    return this->pm_->GetLocalSize();
+}
+
+template <typename ValueType>
+int GlobalCallbackOperator<ValueType>::GetLocalNnz(void) const
+{
+    return 0;
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::Info(void) const
+{
+    std::string current_backend_name;
+
+    if(this->is_host_() == true)
+    {
+        current_backend_name = _rocalution_host_name[0];
+    }
+    else
+    {
+        assert(this->is_accel_() == true);
+        current_backend_name = _rocalution_backend_name[this->local_backend_.backend];
+    }
+
+    LOG_INFO("GlobalCallbackOperator"
+             << " name="
+             << this->object_name_
+             << ";"
+             << " rows="
+             << this->GetM()
+             << ";"
+             << " cols="
+             << this->GetN()
+             << ";"
+             << " diagonal="
+             << ((this->diag_ != NULL) ? "yes" : "no")
+             << ";"
+             << " prec="
+             << 8 * sizeof(ValueType)
+             << "bit;"
+             << " subdomains="
+             << this->pm_->GetNumProcs()
+             << ";"
+             << " host backend={"
+             << _rocalution_host_name[0]
+             << "};"
+             << " accelerator backend={"
+             << _rocalution_backend_name[this->local_backend_.backend]
+             << "};"
+             << " current="
+             << current_backend_name);
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::SetParallelManager(const ParallelManager& pm)
+{
+    log_debug(this, "GlobalCallbackOperator::SetParallelManager()", (const void*&)pm);
+
+    assert(pm.Status() == true);
+
+    this->pm_ = &pm;
+
+    if(this->buffer_ != NULL)
+    {
+        delete this->buffer_;
+        this->buffer_ = NULL;
+    }
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::SetApply(ApplyFunc apply, void* data)
+{
+    log_debug(this, "GlobalCallbackOperator::SetApply()", apply, data);
+
+    assert(apply != NULL);
+
+    this->apply_ = apply;
+    this->data_  = data;
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::SetDiagonal(DiagonalFunc diag)
+{
+    log_debug(this, "GlobalCallbackOperator::SetDiagonal()", diag);
+
+    assert(diag != NULL);
+
+    this->diag_ = diag;
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::Clear(void)
+{
+    log_debug(this, "GlobalCallbackOperator::Clear()");
+
+    this->apply_ = NULL;
+    this->diag_  = NULL;
+    this->data_  = NULL;
+
+    if(this->buffer_ != NULL)
+    {
+        delete this->buffer_;
+        this->buffer_ = NULL;
+    }
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::Apply(const GlobalVector<ValueType>& in,
+                                              GlobalVector<ValueType>* out) const
+{
+    log_debug(this, "GlobalCallbackOperator::Apply()", (const void*&)in, out);
+
+    ROCALUTION_TRACE_SCOPE("GlobalCallbackOperator::Apply", "global");
+
+    assert(out != NULL);
+    assert(&in != out);
+    assert(this->apply_ != NULL);
+
+    assert(this->GetM() == out->GetSize());
+    assert(this->GetN() == in.GetSize());
+    assert(this->is_host_() == in.is_host_());
+    assert(this->is_host_() == out->is_host_());
+
+    // The ghost values of in are received into the ghost part of out, as in
+    // GlobalMatrix::Apply()
+    out->UpdateGhostValuesAsync_(in);
+    out->UpdateGhostValuesSync_();
+
+    this->apply_(in.vector_interior_, out->vector_ghost_, &out->vector_interior_, this->data_);
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::ApplyAdd(const GlobalVector<ValueType>& in,
+                                                 ValueType scalar,
+                                                 GlobalVector<ValueType>* out) const
+{
+    log_debug(this, "GlobalCallbackOperator::ApplyAdd()", (const void*&)in, scalar, out);
+
+    ROCALUTION_TRACE_SCOPE("GlobalCallbackOperator::ApplyAdd", "global");
+
+    assert(out != NULL);
+    assert(&in != out);
+
+    if(this->buffer_ == NULL)
+    {
+        this->buffer_ = new GlobalVector<ValueType>(*this->pm_);
+        this->buffer_->CloneBackend(*this);
+        this->buffer_->Allocate("callback operator buffer", this->GetM());
+    }
+
+    this->Apply(in, this->buffer_);
+
+    out->AddScale(*this->buffer_, scalar);
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::ExtractDiagonal(GlobalVector<ValueType>* vec_diag) const
+{
+    log_debug(this, "GlobalCallbackOperator::ExtractDiagonal()", vec_diag);
+
+    assert(vec_diag != NULL);
+    assert(this->is_host_() == vec_diag->is_host_());
+
+    if(this->diag_ == NULL)
+    {
+        LOG_INFO("GlobalCallbackOperator::ExtractDiagonal() no diagonal function set");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    if(vec_diag->GetLocalSize() != this->GetLocalM())
+    {
+        vec_diag->SetParallelManager(*this->pm_);
+        vec_diag->Allocate("Diagonal elements of " + this->object_name_, this->GetM());
+    }
+
+    this->diag_(&vec_diag->vector_interior_, this->data_);
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::ExtractInverseDiagonal(
+    GlobalVector<ValueType>* vec_inv_diag) const
+{
+    log_debug(this, "GlobalCallbackOperator::ExtractInverseDiagonal()", vec_inv_diag);
+
+    this->ExtractDiagonal(vec_inv_diag);
+
+    vec_inv_diag->Power(-1.0);
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::MoveToAccelerator(void)
+{
+    log_debug(this, "GlobalCallbackOperator::MoveToAccelerator()");
+
+    // Nothing to transfer, only the backend of the vectors passed to the user functions
+    // changes
+    if(_rocalution_available_accelerator() == true)
+    {
+        this->accel_ = true;
+    }
+
+    if(this->buffer_ != NULL)
+    {
+        this->buffer_->MoveToAccelerator();
+    }
+}
+
+template <typename ValueType>
+void GlobalCallbackOperator<ValueType>::MoveToHost(void)
+{
+    log_debug(this, "GlobalCallbackOperator::MoveToHost()");
+
+    this->accel_ = false;
+
+    if(this->buffer_ != NULL)
+    {
+        this->buffer_->MoveToHost();
+    }
+}
+
+template <typename ValueType>
+bool GlobalCallbackOperator<ValueType>::is_host_(void) const
+{
+    return !this->accel_;
+}
+
+template <typename ValueType>
+bool GlobalCallbackOperator<ValueType>::is_accel_(void) const
+{
+    return this->accel_;
+}
+
+template class GlobalCallbackOperator<double>;
+template class GlobalCallbackOperator<float>;
+#ifdef SUPPORT_COMPLEX
+template class GlobalCallbackOperator<std::complex<double>>;
+template class GlobalCallbackOperator<std::complex<float>>;
+#endif
+
+} // namespace rocalution
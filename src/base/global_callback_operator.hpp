@@ -0,0 +1,133 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_GLOBAL_CALLBACK_OPERATOR_HPP_
+#define ROCALUTION_GLOBAL_CALLBACK_OPERATOR_HPP_
+
+#include "../utils/types.hpp"
+#include "operator.hpp"
+#include "global_vector.hpp"
+#include "parallel_manager.hpp"
+
+namespace rocalution {
+
+template <typename ValueType>
+class LocalVector;
+template <typename ValueType>
+class GlobalVector;
+
+/** \ingroup op_vec_module
+  * \class GlobalCallbackOperator
+  * \brief GlobalCallbackOperator class
+  * \details
+  * A GlobalCallbackOperator is the distributed counterpart of the
+  * LocalCallbackOperator. The rows of the operator are distributed as described by
+  * the parallel manager. Before the user function is called, the ghost values of the
+  * input vector are exchanged, such that each process can compute its rows of the
+  * product from local data only.
+  *
+  * \tparam ValueType - can be int, float, double, std::complex<float> and
+  *                     std::complex<double>
+  */
+template <typename ValueType>
+class GlobalCallbackOperator : public Operator<ValueType>
+{
+    public:
+    /** \brief Function that computes the local rows \p out = A * \p in, where
+      * \p interior holds the local and \p ghost the received values of \p in
+      */
+    typedef void (*ApplyFunc)(const LocalVector<ValueType>& interior,
+                              const LocalVector<ValueType>& ghost,
+                              LocalVector<ValueType>* out,
+                              void* data);
+    /** \brief Function that fills the allocated vector \p diag with the local part of the
+      * diagonal of A
+      */
+    typedef void (*DiagonalFunc)(LocalVector<ValueType>* diag, void* data);
+
+    GlobalCallbackOperator();
+    /** \brief Initialize a global callback operator with a parallel manager */
+    GlobalCallbackOperator(const ParallelManager& pm);
+    virtual ~GlobalCallbackOperator();
+
+    virtual void Info() const;
+
+    virtual IndexType2 GetM(void) const;
+    virtual IndexType2 GetN(void) const;
+    virtual IndexType2 GetNnz(void) const;
+    virtual int GetLocalM(void) const;
+    virtual int GetLocalN(void) const;
+    virtual int GetLocalNnz(void) const;
+
+    /** \brief Set the parallel manager of a global callback operator */
+    void SetParallelManager(const ParallelManager& pm);
+
+    /** \brief Set the operator function
+      * \details
+      * The ghost values are ordered as the receivers of the parallel manager, i.e.
+      * \p ghost has the same layout as the columns of the ghost part of a GlobalMatrix.
+      * \p data is passed unchanged to \p apply.
+      */
+    void SetApply(ApplyFunc apply, void* data);
+
+    /** \brief Set the function that extracts the local part of the diagonal of the
+      * operator (optional, required by ExtractDiagonal() and ExtractInverseDiagonal())
+      */
+    void SetDiagonal(DiagonalFunc diag);
+
+    virtual void Clear();
+
+    virtual void Apply(const GlobalVector<ValueType>& in, GlobalVector<ValueType>* out) const;
+    virtual void ApplyAdd(const GlobalVector<ValueType>& in,
+                          ValueType scalar,
+                          GlobalVector<ValueType>* out) const;
+
+    /** \brief Extract the diagonal values of the operator into a GlobalVector */
+    void ExtractDiagonal(GlobalVector<ValueType>* vec_diag) const;
+    /** \brief Extract the inverse (reciprocal) diagonal values of the operator into a
+      * GlobalVector
+      */
+    void ExtractInverseDiagonal(GlobalVector<ValueType>* vec_inv_diag) const;
+
+    virtual void MoveToAccelerator(void);
+    virtual void MoveToHost(void);
+
+    protected:
+    virtual bool is_host_(void) const;
+    virtual bool is_accel_(void) const;
+
+    private:
+    ApplyFunc apply_;
+    DiagonalFunc diag_;
+    void* data_;
+
+    // Backend the vectors that are passed to the user functions are located on
+    bool accel_;
+
+    // Buffer for ApplyAdd(), allocated on first use
+    mutable GlobalVector<ValueType>* buffer_;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_GLOBAL_CALLBACK_OPERATOR_HPP_
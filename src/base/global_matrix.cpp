@@ -26,8 +26,11 @@
 #include "global_vector.hpp"
 #include "local_matrix.hpp"
 #include "local_vector.hpp"
+#include "base_matrix.hpp"
+#include "base_vector.hpp"
 #include "matrix_formats.hpp"
 #include "../utils/log.hpp"
+#include "../utils/trace.hpp"
 #include "../utils/allocate_free.hpp"
 #include "../utils/math_functions.hpp"
 
@@ -39,9 +42,198 @@
 #include <limits>
 #include <algorithm>
 #include <complex>
+#include <vector>
+#include <utility>
 
 namespace rocalution {
 
+#ifdef SUPPORT_MULTINODE
+// Copy a local matrix into host CSR arrays, rows without entries are kept
+template <typename ValueType>
+static void copy_to_host_csr(const LocalMatrix<ValueType>& mat,
+                             int nrow,
+                             int** row_offset,
+                             int** col,
+                             ValueType** val)
+{
+    allocate_host(nrow + 1, row_offset);
+    set_to_zero_host(nrow + 1, *row_offset);
+
+    if(mat.GetNnz() > 0)
+    {
+        assert(mat.GetM() == nrow);
+
+        LocalMatrix<ValueType> tmp;
+        tmp.ConvertTo(mat.GetFormat());
+        tmp.CopyFrom(mat);
+        tmp.ConvertToCSR();
+
+        allocate_host(tmp.GetLocalNnz(), col);
+        allocate_host(tmp.GetLocalNnz(), val);
+
+        tmp.CopyToCSR(*row_offset, *col, *val);
+    }
+}
+
+template <typename ValueType>
+static bool compare_sparse_entry(const std::pair<int, ValueType>& a,
+                                 const std::pair<int, ValueType>& b)
+{
+    return a.first < b.first;
+}
+
+// Sort the entries of a sparse row by column index and sum up duplicates
+template <typename ValueType>
+static void compress_sparse_row(std::vector<std::pair<int, ValueType>>& row)
+{
+    if(row.empty() == true)
+    {
+        return;
+    }
+
+    std::sort(row.begin(), row.end(), compare_sparse_entry<ValueType>);
+
+    size_t n = 0;
+    for(size_t i = 1; i < row.size(); ++i)
+    {
+        if(row[i].first == row[n].first)
+        {
+            row[n].second += row[i].second;
+        }
+        else
+        {
+            row[++n] = row[i];
+        }
+    }
+
+    row.resize(n + 1);
+}
+
+// Number of distinct columns of row i of the product A * B, where column k of A refers to
+// row k of B. Columns that are already marked with i are not counted.
+static int sparse_row_product_count(int i,
+                                    const int* A_row_offset,
+                                    const int* A_col,
+                                    const int* B_row_offset,
+                                    const int* B_col,
+                                    int* marker)
+{
+    int cnt = 0;
+
+    for(int j = A_row_offset[i]; j < A_row_offset[i + 1]; ++j)
+    {
+        int k = A_col[j];
+
+        for(int l = B_row_offset[k]; l < B_row_offset[k + 1]; ++l)
+        {
+            if(marker[B_col[l]] != i)
+            {
+                marker[B_col[l]] = i;
+                ++cnt;
+            }
+        }
+    }
+
+    return cnt;
+}
+
+// Accumulate row i of the product A * B into the row of C starting at begin, whose first
+// entries up to end are already filled. marker holds the position of each column in C,
+// positions below begin belong to previous rows. Returns the new end of the row.
+template <typename ValueType>
+static int sparse_row_product_fill(int i,
+                                   const int* A_row_offset,
+                                   const int* A_col,
+                                   const ValueType* A_val,
+                                   const int* B_row_offset,
+                                   const int* B_col,
+                                   const ValueType* B_val,
+                                   int begin,
+                                   int end,
+                                   int* marker,
+                                   int* col,
+                                   ValueType* val)
+{
+    for(int j = A_row_offset[i]; j < A_row_offset[i + 1]; ++j)
+    {
+        int k       = A_col[j];
+        ValueType a = A_val[j];
+
+        for(int l = B_row_offset[k]; l < B_row_offset[k + 1]; ++l)
+        {
+            int c = B_col[l];
+
+            if(marker[c] < begin)
+            {
+                marker[c] = end;
+                col[end]  = c;
+                val[end]  = a * B_val[l];
+                ++end;
+            }
+            else
+            {
+                val[marker[c]] += a * B_val[l];
+            }
+        }
+    }
+
+    return end;
+}
+
+// Convert sparse rows into host CSR arrays
+template <typename ValueType>
+static void sparse_rows_to_csr(const std::vector<std::vector<std::pair<int, ValueType>>>& rows,
+                               int** row_offset,
+                               int** col,
+                               ValueType** val)
+{
+    int nrow = static_cast<int>(rows.size());
+
+    allocate_host(nrow + 1, row_offset);
+
+    (*row_offset)[0] = 0;
+    for(int i = 0; i < nrow; ++i)
+    {
+        (*row_offset)[i + 1] = (*row_offset)[i] + static_cast<int>(rows[i].size());
+    }
+
+    allocate_host((*row_offset)[nrow], col);
+    allocate_host((*row_offset)[nrow], val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        int idx = (*row_offset)[i];
+
+        for(size_t j = 0; j < rows[i].size(); ++j)
+        {
+            (*col)[idx + j] = rows[i][j].first;
+            (*val)[idx + j] = rows[i][j].second;
+        }
+    }
+}
+
+// Free host CSR arrays, empty arrays are skipped
+template <typename ValueType>
+static void free_host_csr(int** row_offset, int** col, ValueType** val)
+{
+    if(*row_offset != NULL)
+    {
+        free_host(row_offset);
+    }
+    if(*col != NULL)
+    {
+        free_host(col);
+    }
+    if(*val != NULL)
+    {
+        free_host(val);
+    }
+}
+#endif
+
 template <typename ValueType>
 GlobalMatrix<ValueType>::GlobalMatrix()
 {
@@ -87,6 +279,9 @@ void GlobalMatrix<ValueType>::Clear(void)
     this->matrix_interior_.Clear();
     this->matrix_ghost_.Clear();
 
+    this->interior_rows_.clear();
+    this->boundary_rows_.clear();
+
     this->nnz_ = 0;
 }
 
@@ -189,14 +384,13 @@ void GlobalMatrix<ValueType>::AllocateCSR(const std::string name, int local_nnz,
         ghost_name, ghost_nnz, this->pm_->GetLocalSize(), this->pm_->GetNumReceivers());
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
+    // The ghost structure is not known yet
+    this->interior_rows_.clear();
+    this->boundary_rows_.clear();
 
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -219,14 +413,13 @@ void GlobalMatrix<ValueType>::AllocateCOO(const std::string name, int local_nnz,
         ghost_name, ghost_nnz, this->pm_->GetLocalSize(), this->pm_->GetNumReceivers());
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
+    // The ghost structure is not known yet
+    this->interior_rows_.clear();
+    this->boundary_rows_.clear();
 
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -297,14 +490,11 @@ void GlobalMatrix<ValueType>::SetDataPtrCSR(int** local_row_offset,
     this->matrix_ghost_.ConvertTo(COO);
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
+    this->SplitRows_();
 
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -373,14 +563,11 @@ void GlobalMatrix<ValueType>::SetDataPtrCOO(int** local_row,
                                       this->pm_->GetNumReceivers());
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
+    this->SplitRows_();
 
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -414,14 +601,11 @@ void GlobalMatrix<ValueType>::SetLocalDataPtrCSR(
                                          this->pm_->GetLocalSize());
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
+    this->SplitRows_();
 
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -450,14 +634,11 @@ void GlobalMatrix<ValueType>::SetLocalDataPtrCOO(
         row, col, val, interior_name, nnz, this->pm_->GetLocalSize(), this->pm_->GetLocalSize());
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
+    this->SplitRows_();
 
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -492,14 +673,11 @@ void GlobalMatrix<ValueType>::SetGhostDataPtrCSR(
     this->matrix_ghost_.ConvertTo(COO);
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
+    this->SplitRows_();
 
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -530,14 +708,11 @@ void GlobalMatrix<ValueType>::SetGhostDataPtrCOO(
     this->matrix_ghost_.Sort();
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
+    this->SplitRows_();
 
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -577,6 +752,9 @@ void GlobalMatrix<ValueType>::LeaveDataPtrCSR(int** local_row_offset,
     this->matrix_interior_.LeaveDataPtrCSR(local_row_offset, local_col, local_val);
     this->matrix_ghost_.LeaveDataPtrCSR(ghost_row_offset, ghost_col, ghost_val);
 
+    this->interior_rows_.clear();
+    this->boundary_rows_.clear();
+
     this->nnz_ = 0;
 }
 
@@ -616,6 +794,9 @@ void GlobalMatrix<ValueType>::LeaveDataPtrCOO(int** local_row,
     this->matrix_interior_.LeaveDataPtrCOO(local_row, local_col, local_val);
     this->matrix_ghost_.LeaveDataPtrCOO(ghost_row, ghost_col, ghost_val);
 
+    this->interior_rows_.clear();
+    this->boundary_rows_.clear();
+
     this->nnz_ = 0;
 }
 
@@ -670,6 +851,9 @@ void GlobalMatrix<ValueType>::LeaveGhostDataPtrCSR(int** row_offset, int** col,
 
     this->matrix_ghost_.LeaveDataPtrCSR(row_offset, col, val);
 
+    this->interior_rows_.clear();
+    this->boundary_rows_.clear();
+
     this->nnz_ = 0;
 }
 
@@ -688,6 +872,9 @@ void GlobalMatrix<ValueType>::LeaveGhostDataPtrCOO(int** row, int** col, ValueTy
 
     this->matrix_ghost_.LeaveDataPtrCOO(row, col, val);
 
+    this->interior_rows_.clear();
+    this->boundary_rows_.clear();
+
     this->nnz_ = 0;
 }
 
@@ -808,6 +995,9 @@ void GlobalMatrix<ValueType>::CopyFrom(const GlobalMatrix<ValueType>& src)
     this->matrix_interior_.CopyFrom(src.GetInterior());
     this->matrix_ghost_.CopyFrom(src.GetGhost());
 
+    this->interior_rows_ = src.interior_rows_;
+    this->boundary_rows_ = src.boundary_rows_;
+
     this->object_name_ = "Copy from " + src.object_name_;
     this->pm_          = src.pm_;
 
@@ -862,6 +1052,18 @@ void GlobalMatrix<ValueType>::ConvertToDENSE(void)
     this->ConvertTo(DENSE);
 }
 
+template <typename ValueType>
+void GlobalMatrix<ValueType>::ConvertToSELL(void)
+{
+    this->ConvertTo(SELL);
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::ConvertToCCSR(bool bfloat16)
+{
+    this->ConvertTo(bfloat16 ? CCSRBF16 : CCSR);
+}
+
 template <typename ValueType>
 void GlobalMatrix<ValueType>::ConvertTo(unsigned int matrix_format)
 {
@@ -873,12 +1075,27 @@ void GlobalMatrix<ValueType>::ConvertTo(unsigned int matrix_format)
     this->matrix_ghost_.ConvertTo(COO);
 }
 
+template <typename ValueType>
+unsigned int GlobalMatrix<ValueType>::AutoTuneFormat(bool benchmark)
+{
+    log_debug(this, "GlobalMatrix::AutoTuneFormat()", benchmark);
+
+    unsigned int format = this->matrix_interior_.AutoTuneFormat(benchmark);
+
+    // Ghost part remains COO
+    this->matrix_ghost_.ConvertTo(COO);
+
+    return format;
+}
+
 template <typename ValueType>
 void GlobalMatrix<ValueType>::Apply(const GlobalVector<ValueType>& in,
                                     GlobalVector<ValueType>* out) const
 {
     log_debug(this, "GlobalMatrix::Apply()", (const void*&)in, out);
 
+    ROCALUTION_TRACE_SCOPE("GlobalMatrix::Apply", "global");
+
     assert(out != NULL);
     assert(&in != out);
 
@@ -889,7 +1106,51 @@ void GlobalMatrix<ValueType>::Apply(const GlobalVector<ValueType>& in,
 
     out->UpdateGhostValuesAsync_(in);
 
-    this->matrix_interior_.Apply(in.vector_interior_, &out->vector_interior_);
+    // The interior product only depends on local data. The rows without ghost entries are
+    // computed in GLOBAL_APPLY_BLOCKS blocks while the ghost values are exchanged,
+    // followed by the interior part of the boundary rows. MPI is given the chance to
+    // progress the exchange in between two blocks.
+    const LocalMatrix<ValueType>& interior = this->matrix_interior_;
+
+    int ninterior = static_cast<int>(this->interior_rows_.size());
+    int nsplit    = ninterior + static_cast<int>(this->boundary_rows_.size());
+    int block     = std::max((ninterior - 1) / GLOBAL_APPLY_BLOCKS + 1, 1);
+    bool done     = false;
+
+    if(interior.GetNnz() > 0 && nsplit == interior.GetLocalM())
+    {
+        done = true;
+
+        for(int begin = 0; begin < ninterior; begin += block)
+        {
+            out->UpdateGhostValuesProgress_();
+
+            done = interior.matrix_->ApplyRows(std::min(block, ninterior - begin),
+                                               this->interior_rows_.data() + begin,
+                                               *in.vector_interior_.vector_,
+                                               out->vector_interior_.vector_);
+
+            if(done == false)
+            {
+                break;
+            }
+        }
+
+        if(done == true)
+        {
+            out->UpdateGhostValuesProgress_();
+
+            done = interior.matrix_->ApplyRows(static_cast<int>(this->boundary_rows_.size()),
+                                               this->boundary_rows_.data(),
+                                               *in.vector_interior_.vector_,
+                                               out->vector_interior_.vector_);
+        }
+    }
+
+    if(done == false)
+    {
+        interior.Apply(in.vector_interior_, &out->vector_interior_);
+    }
 
     out->UpdateGhostValuesSync_();
 
@@ -904,6 +1165,8 @@ void GlobalMatrix<ValueType>::ApplyAdd(const GlobalVector<ValueType>& in,
 {
     log_debug(this, "GlobalMatrix::ApplyAdd()", (const void*&)in, scalar, out);
 
+    ROCALUTION_TRACE_SCOPE("GlobalMatrix::ApplyAdd", "global");
+
     assert(out != NULL);
     assert(&in != out);
 
@@ -963,14 +1226,9 @@ void GlobalMatrix<ValueType>::ReadFileMTX(const std::string filename)
     this->object_name_ = filename;
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
-
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -1062,14 +1320,9 @@ void GlobalMatrix<ValueType>::ReadFileCSR(const std::string filename)
     this->object_name_ = filename;
 
 #ifdef SUPPORT_MULTINODE
-    IndexType2 nnz_local;
-    IndexType2 nnz_ghost;
-
-    communication_allreduce_single_sum(
-        this->matrix_interior_.GetNnz(), &nnz_local, this->pm_->comm_);
-    communication_allreduce_single_sum(this->matrix_ghost_.GetNnz(), &nnz_ghost, this->pm_->comm_);
+    IndexType2 nnz_sum = this->matrix_interior_.GetNnz() + this->matrix_ghost_.GetNnz();
 
-    this->nnz_ = nnz_local + nnz_ghost;
+    communication_allreduce_single_sum(nnz_sum, &this->nnz_, this->pm_->comm_);
 #endif
 }
 
@@ -1124,6 +1377,17 @@ void GlobalMatrix<ValueType>::ExtractInverseDiagonal(GlobalVector<ValueType>* ve
     this->matrix_interior_.ExtractInverseDiagonal(&vec_inv_diag->vector_interior_);
 }
 
+template <typename ValueType>
+void GlobalMatrix<ValueType>::ExtractDiagonal(GlobalVector<ValueType>* vec_diag) const
+{
+    log_debug(this, "GlobalMatrix::ExtractDiagonal()", vec_diag);
+
+    assert(vec_diag != NULL);
+    assert(vec_diag->GetSize() == this->GetM());
+
+    this->matrix_interior_.ExtractDiagonal(&vec_diag->vector_interior_);
+}
+
 template <typename ValueType>
 void GlobalMatrix<ValueType>::Sort(void)
 {
@@ -1142,147 +1406,759 @@ void GlobalMatrix<ValueType>::Scale(ValueType alpha)
 }
 
 template <typename ValueType>
-void GlobalMatrix<ValueType>::InitialPairwiseAggregation(ValueType beta,
-                                                         int& nc,
-                                                         LocalVector<int>* G,
-                                                         int& Gsize,
-                                                         int** rG,
-                                                         int& rGsize,
-                                                         int ordering) const
+void GlobalMatrix<ValueType>::Transpose(ParallelManager* pm)
 {
-    log_debug(this,
-              "GlobalMatrix::InitialPairwiseAggregation()",
-              beta,
-              nc,
-              G,
-              Gsize,
-              rG,
-              rGsize,
-              ordering);
+    log_debug(this, "GlobalMatrix::Transpose()", pm);
 
-    // TODO asserts
+    assert(pm != NULL);
+    assert(pm != this->pm_);
 
-    LocalMatrix<ValueType> tmp;
-    tmp.CloneFrom(this->matrix_ghost_);
-    tmp.ConvertToCSR();
+#ifdef SUPPORT_MULTINODE
+    const ParallelManager* src = this->pm_;
 
-    this->matrix_interior_.InitialPairwiseAggregation(
-        tmp, beta, nc, G, Gsize, rG, rGsize, ordering);
-}
+    int num_procs = src->num_procs_;
+    int nrow      = src->GetLocalSize();
 
-template <typename ValueType>
-void GlobalMatrix<ValueType>::FurtherPairwiseAggregation(ValueType beta,
-                                                         int& nc,
-                                                         LocalVector<int>* G,
-                                                         int& Gsize,
-                                                         int** rG,
-                                                         int& rGsize,
-                                                         int ordering) const
-{
-    log_debug(this,
-              "GlobalMatrix::FurtherPairwiseAggregation()",
-              beta,
-              nc,
-              G,
-              Gsize,
-              rG,
-              rGsize,
-              ordering);
+    std::vector<int> global_offset(num_procs + 1);
+    this->GlobalOffsets_(&global_offset[0]);
 
-    // TODO asserts
+    int offset = global_offset[src->rank_];
 
-    LocalMatrix<ValueType> tmp;
-    tmp.CloneFrom(this->matrix_ghost_);
-    tmp.ConvertToCSR();
+    // The columns are distributed like the rows, the owner of column j is the owner of
+    // row j
+    if(global_offset[num_procs] != this->GetN())
+    {
+        LOG_INFO("GlobalMatrix::Transpose() - local sizes do not match the global size");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
 
-    this->matrix_interior_.FurtherPairwiseAggregation(
-        tmp, beta, nc, G, Gsize, rG, rGsize, ordering);
-}
+    // Local rows with global column indices
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
 
-template <typename ValueType>
-void GlobalMatrix<ValueType>::CoarsenOperator(GlobalMatrix<ValueType>* Ac,
-                                              ParallelManager* pm,
-                                              int nrow,
-                                              int ncol,
-                                              const LocalVector<int>& G,
-                                              int Gsize,
-                                              const int* rG,
-                                              int rGsize) const
-{
-    log_debug(this,
-              "GlobalMatrix::CoarsenOperator()",
-              Ac,
-              pm,
-              nrow,
-              ncol,
-              (const void*&)G,
-              Gsize,
-              rG,
-              rGsize);
+    this->GetGlobalRowsCSR_(&global_offset[0], &row_offset, &col, &val);
 
-    assert(Ac != NULL);
-    assert(pm != NULL);
-    assert(rG != NULL);
+    int nnz = row_offset[nrow];
 
-// TODO asserts
+    // Each entry (i,j) becomes entry (j,i), which is owned by the owner of row j
+    std::vector<int> owner(nnz);
+    std::vector<int> send_count(num_procs, 0);
+    std::vector<int> recv_count(num_procs, 0);
 
-#ifdef SUPPORT_MULTINODE
-    // MPI Requests for sync
-    std::vector<MRequest> req_mapping(this->pm_->nrecv_ + this->pm_->nsend_);
-    std::vector<MRequest> req_offsets(this->pm_->nrecv_ + this->pm_->nsend_);
+    for(int i = 0; i < nnz; ++i)
+    {
+        owner[i] = static_cast<int>(
+            std::upper_bound(global_offset.begin(), global_offset.end(), col[i]) -
+            global_offset.begin() - 1);
 
-    // Determine connected pairs for the ghost layer of neighboring ranks
-    int** send_ghost_map = new int*[this->pm_->nsend_];
-    int** recv_ghost_map = new int*[this->pm_->nrecv_];
+        ++send_count[owner[i]];
+    }
 
-    int* send_map_size = NULL;
-    int* recv_map_size = NULL;
+    communication_alltoall_single(&send_count[0], &recv_count[0], src->comm_);
 
-    allocate_host(this->pm_->nsend_, &send_map_size);
-    allocate_host(this->pm_->nrecv_, &recv_map_size);
+    std::vector<int> send_offset(num_procs + 1, 0);
+    std::vector<int> recv_offset(num_procs + 1, 0);
 
-    // Receive sizes
-    for(int n = 0; n < this->pm_->nrecv_; ++n)
+    for(int p = 0; p < num_procs; ++p)
     {
-        communication_async_recv(
-            &recv_map_size[n], 1, this->pm_->recvs_[n], 0, &req_mapping[n], this->pm_->comm_);
+        send_offset[p + 1] = send_offset[p] + send_count[p];
+        recv_offset[p + 1] = recv_offset[p] + recv_count[p];
     }
 
-    // Loop over neighbor ranks
-    for(int n = 0; n < this->pm_->nsend_; ++n)
-    {
-        send_ghost_map[n] =
-            new int[this->pm_->send_offset_index_[n + 1] - this->pm_->send_offset_index_[n]];
+    // Pack the entries ordered by their new owner
+    std::vector<int> send_row(nnz);
+    std::vector<int> send_col(nnz);
+    std::vector<ValueType> send_val(nnz);
+    std::vector<int> pos(send_offset.begin(), send_offset.end() - 1);
 
-        G.ExtractCoarseMapping(this->pm_->send_offset_index_[n],
-                               this->pm_->send_offset_index_[n + 1],
-                               this->pm_->boundary_index_,
-                               nrow,
-                               &send_map_size[n],
-                               send_ghost_map[n]);
+    for(int i = 0; i < nrow; ++i)
+    {
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            int idx = pos[owner[j]]++;
 
-        // Send sizes
-        communication_async_send(&send_map_size[n],
-                                 1,
-                                 this->pm_->sends_[n],
-                                 0,
-                                 &req_mapping[this->pm_->nrecv_ + n],
-                                 this->pm_->comm_);
+            send_row[idx] = col[j];
+            send_col[idx] = offset + i;
+            send_val[idx] = val[j];
+        }
     }
 
-    // Wait for mapping sizes communication to finish
-    communication_syncall(this->pm_->nrecv_ + this->pm_->nsend_, &req_mapping[0]);
+    free_host_csr(&row_offset, &col, &val);
 
-    // Receive mapping pairs
-    for(int n = 0; n < this->pm_->nrecv_; ++n)
+    // All-to-all exchange of the transposed entries
+    std::vector<int> recv_row(recv_offset[num_procs]);
+    std::vector<int> recv_col(recv_offset[num_procs]);
+    std::vector<ValueType> recv_val(recv_offset[num_procs]);
+
+    std::vector<MRequest> req(6 * num_procs);
+    int nreq = 0;
+
+    for(int p = 0; p < num_procs; ++p)
     {
-        recv_ghost_map[n] = new int[recv_map_size[n]];
-        communication_async_recv(recv_ghost_map[n],
-                                 recv_map_size[n],
-                                 this->pm_->recvs_[n],
-                                 0,
-                                 &req_mapping[n],
-                                 this->pm_->comm_);
+        if(recv_count[p] > 0)
+        {
+            communication_async_recv(
+                &recv_row[recv_offset[p]], recv_count[p], p, 0, &req[nreq++], src->comm_);
+            communication_async_recv(
+                &recv_col[recv_offset[p]], recv_count[p], p, 1, &req[nreq++], src->comm_);
+            communication_async_recv(
+                &recv_val[recv_offset[p]], recv_count[p], p, 2, &req[nreq++], src->comm_);
+        }
+    }
+
+    for(int p = 0; p < num_procs; ++p)
+    {
+        if(send_count[p] > 0)
+        {
+            communication_async_send(
+                &send_row[send_offset[p]], send_count[p], p, 0, &req[nreq++], src->comm_);
+            communication_async_send(
+                &send_col[send_offset[p]], send_count[p], p, 1, &req[nreq++], src->comm_);
+            communication_async_send(
+                &send_val[send_offset[p]], send_count[p], p, 2, &req[nreq++], src->comm_);
+        }
+    }
+
+    if(nreq > 0)
+    {
+        communication_syncall(nreq, &req[0]);
+    }
+
+    // Assemble the rows of the transposed matrix
+    std::vector<std::vector<std::pair<int, ValueType>>> rows(nrow);
+
+    for(int i = 0; i < recv_offset[num_procs]; ++i)
+    {
+        rows[recv_row[i] - offset].push_back(std::make_pair(recv_col[i], recv_val[i]));
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        compress_sparse_row(rows[i]);
+    }
+
+    sparse_rows_to_csr(rows, &row_offset, &col, &val);
+
+    bool isaccel = this->is_accel_();
+    std::string name = this->object_name_;
+
+    this->MoveToHost();
+    this->SetGlobalRowsCSR_(*src, &global_offset[0], row_offset, col, val, pm);
+    this->object_name_ = name;
+
+    free_host_csr(&row_offset, &col, &val);
+
+    if(isaccel == true)
+    {
+        this->MoveToAccelerator();
+    }
+#else
+    LOG_INFO("Multinode support disabled");
+    FATAL_ERROR(__FILE__, __LINE__);
+#endif
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::MatrixAdd(const GlobalMatrix<ValueType>& mat,
+                                        ValueType alpha,
+                                        ValueType beta,
+                                        ParallelManager* pm)
+{
+    log_debug(this, "GlobalMatrix::MatrixAdd()", (const void*&)mat, alpha, beta, pm);
+
+    assert(pm != NULL);
+    assert(&mat != this);
+    assert(pm != this->pm_);
+    assert(pm != mat.pm_);
+    assert(this->GetM() == mat.GetM());
+    assert(this->GetLocalM() == mat.GetLocalM());
+
+#ifdef SUPPORT_MULTINODE
+    const ParallelManager* src = this->pm_;
+
+    int nrow = src->GetLocalSize();
+
+    std::vector<int> global_offset(src->num_procs_ + 1);
+    std::vector<int> mat_global_offset(src->num_procs_ + 1);
+
+    this->GlobalOffsets_(&global_offset[0]);
+    mat.GlobalOffsets_(&mat_global_offset[0]);
+
+    if(global_offset != mat_global_offset)
+    {
+        LOG_INFO("GlobalMatrix::MatrixAdd() - matrices are distributed differently");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    // Local rows of both matrices with global column indices
+    int* row_offset     = NULL;
+    int* col            = NULL;
+    ValueType* val      = NULL;
+    int* mat_row_offset = NULL;
+    int* mat_col        = NULL;
+    ValueType* mat_val  = NULL;
+
+    this->GetGlobalRowsCSR_(&global_offset[0], &row_offset, &col, &val);
+    mat.GetGlobalRowsCSR_(&global_offset[0], &mat_row_offset, &mat_col, &mat_val);
+
+    std::vector<std::vector<std::pair<int, ValueType>>> rows(nrow);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        rows[i].reserve(row_offset[i + 1] - row_offset[i] + mat_row_offset[i + 1] -
+                        mat_row_offset[i]);
+
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            rows[i].push_back(std::make_pair(col[j], alpha * val[j]));
+        }
+
+        for(int j = mat_row_offset[i]; j < mat_row_offset[i + 1]; ++j)
+        {
+            rows[i].push_back(std::make_pair(mat_col[j], beta * mat_val[j]));
+        }
+
+        compress_sparse_row(rows[i]);
+    }
+
+    free_host_csr(&row_offset, &col, &val);
+    free_host_csr(&mat_row_offset, &mat_col, &mat_val);
+
+    sparse_rows_to_csr(rows, &row_offset, &col, &val);
+
+    bool isaccel = this->is_accel_();
+    std::string name = this->object_name_;
+
+    this->MoveToHost();
+    this->SetGlobalRowsCSR_(*src, &global_offset[0], row_offset, col, val, pm);
+    this->object_name_ = name;
+
+    free_host_csr(&row_offset, &col, &val);
+
+    if(isaccel == true)
+    {
+        this->MoveToAccelerator();
+    }
+#else
+    LOG_INFO("Multinode support disabled");
+    FATAL_ERROR(__FILE__, __LINE__);
+#endif
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::MatrixMult(const GlobalMatrix<ValueType>& A,
+                                         const GlobalMatrix<ValueType>& B,
+                                         ParallelManager* pm)
+{
+    log_debug(this, "GlobalMatrix::MatrixMult()", (const void*&)A, (const void*&)B, pm);
+
+    assert(pm != NULL);
+    assert(&A != this);
+    assert(&B != this);
+    assert(pm != A.pm_);
+    assert(pm != B.pm_);
+    assert(A.GetN() == B.GetM());
+    assert(A.GetLocalN() == B.GetLocalM());
+    assert(A.is_host_() == B.is_host_());
+
+#ifdef SUPPORT_MULTINODE
+    const ParallelManager* src = A.pm_;
+
+    int nrow = src->GetLocalSize();
+
+    std::vector<int> global_offset(src->num_procs_ + 1);
+    std::vector<int> B_global_offset(src->num_procs_ + 1);
+
+    A.GlobalOffsets_(&global_offset[0]);
+    B.GlobalOffsets_(&B_global_offset[0]);
+
+    // The ghost columns of A are mapped to rows of B and the columns of B are mapped with
+    // the row offsets of A, both require B to be distributed like A
+    if(global_offset != B_global_offset || global_offset[src->num_procs_] != A.GetN())
+    {
+        LOG_INFO("GlobalMatrix::MatrixMult() - matrices are distributed differently");
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    // Local rows of B with global column indices
+    int* B_row_offset = NULL;
+    int* B_col        = NULL;
+    ValueType* B_val  = NULL;
+
+    B.GetGlobalRowsCSR_(&global_offset[0], &B_row_offset, &B_col, &B_val);
+
+    // The ghost columns of A refer to boundary rows of B on the neighboring ranks,
+    // following the communication pattern of A
+    int nsend_row = src->send_index_size_;
+    int nrecv_row = src->recv_index_size_;
+
+    std::vector<int> send_row_nnz(nsend_row);
+    std::vector<int> recv_row_offset(nrecv_row + 1, 0);
+
+    for(int i = 0; i < nsend_row; ++i)
+    {
+        int row = src->boundary_index_[i];
+        send_row_nnz[i] = B_row_offset[row + 1] - B_row_offset[row];
+    }
+
+    // The boundary rows are exchanged by neighborhood collectives on a graph communicator
+    // of the sending and receiving ranks
+    void* neighbor_comm = NULL;
+
+    communication_create_neighbor_comm(
+        src->nrecv_, src->recvs_, src->nsend_, src->sends_, src->comm_, &neighbor_comm);
+
+    std::vector<int> send_count(src->nsend_);
+    std::vector<int> recv_count(src->nrecv_);
+
+    for(int n = 0; n < src->nsend_; ++n)
+    {
+        send_count[n] = src->send_offset_index_[n + 1] - src->send_offset_index_[n];
+    }
+
+    for(int n = 0; n < src->nrecv_; ++n)
+    {
+        recv_count[n] = src->recv_offset_index_[n + 1] - src->recv_offset_index_[n];
+    }
+
+    // Exchange the number of entries of each boundary row
+    MRequest req_nnz;
+
+    communication_async_neighbor_alltoallv(send_row_nnz.data(),
+                                           send_count.data(),
+                                           src->send_offset_index_,
+                                           recv_row_offset.data() + 1,
+                                           recv_count.data(),
+                                           src->recv_offset_index_,
+                                           &req_nnz,
+                                           neighbor_comm);
+
+    // Pack the boundary rows of B
+    std::vector<int> send_row_offset(nsend_row + 1, 0);
+
+    for(int i = 0; i < nsend_row; ++i)
+    {
+        send_row_offset[i + 1] = send_row_offset[i] + send_row_nnz[i];
+    }
+
+    std::vector<int> send_col(send_row_offset[nsend_row]);
+    std::vector<ValueType> send_val(send_row_offset[nsend_row]);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nsend_row; ++i)
+    {
+        int row = src->boundary_index_[i];
+        int idx = send_row_offset[i];
+
+        for(int j = B_row_offset[row]; j < B_row_offset[row + 1]; ++j)
+        {
+            send_col[idx] = B_col[j];
+            send_val[idx] = B_val[j];
+            ++idx;
+        }
+    }
+
+    communication_sync(&req_nnz);
+
+    for(int i = 0; i < nrecv_row; ++i)
+    {
+        recv_row_offset[i + 1] += recv_row_offset[i];
+    }
+
+    std::vector<int> recv_col(recv_row_offset[nrecv_row]);
+    std::vector<ValueType> recv_val(recv_row_offset[nrecv_row]);
+
+    // Number of entries and their offsets per neighbor
+    std::vector<int> send_entry_count(src->nsend_);
+    std::vector<int> send_entry_offset(src->nsend_);
+    std::vector<int> recv_entry_count(src->nrecv_);
+    std::vector<int> recv_entry_offset(src->nrecv_);
+
+    for(int n = 0; n < src->nsend_; ++n)
+    {
+        send_entry_offset[n] = send_row_offset[src->send_offset_index_[n]];
+        send_entry_count[n]
+            = send_row_offset[src->send_offset_index_[n + 1]] - send_entry_offset[n];
+    }
+
+    for(int n = 0; n < src->nrecv_; ++n)
+    {
+        recv_entry_offset[n] = recv_row_offset[src->recv_offset_index_[n]];
+        recv_entry_count[n]
+            = recv_row_offset[src->recv_offset_index_[n + 1]] - recv_entry_offset[n];
+    }
+
+    // Start the exchange of the boundary rows
+    MRequest req_col;
+    MRequest req_val;
+
+    communication_async_neighbor_alltoallv(send_col.data(),
+                                           send_entry_count.data(),
+                                           send_entry_offset.data(),
+                                           recv_col.data(),
+                                           recv_entry_count.data(),
+                                           recv_entry_offset.data(),
+                                           &req_col,
+                                           neighbor_comm);
+
+    communication_async_neighbor_alltoallv(send_val.data(),
+                                           send_entry_count.data(),
+                                           send_entry_offset.data(),
+                                           recv_val.data(),
+                                           recv_entry_count.data(),
+                                           recv_entry_offset.data(),
+                                           &req_val,
+                                           neighbor_comm);
+
+    // Interior part of the product, while the boundary rows are in flight
+    int* A_row_offset = NULL;
+    int* A_col        = NULL;
+    ValueType* A_val  = NULL;
+
+    copy_to_host_csr(A.matrix_interior_, nrow, &A_row_offset, &A_col, &A_val);
+
+    // Dense markers over the global columns of B, one per thread
+    int ncol = global_offset[src->num_procs_];
+
+    int* I_row_offset = NULL;
+    int* I_col        = NULL;
+    ValueType* I_val  = NULL;
+
+    allocate_host(nrow + 1, &I_row_offset);
+
+    I_row_offset[0] = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> marker(ncol, -1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            I_row_offset[i + 1] = sparse_row_product_count(
+                i, A_row_offset, A_col, B_row_offset, B_col, &marker[0]);
+        }
+    }
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        I_row_offset[i + 1] += I_row_offset[i];
+    }
+
+    allocate_host(I_row_offset[nrow], &I_col);
+    allocate_host(I_row_offset[nrow], &I_val);
+
+    // Each thread processes its rows in increasing order, such that the positions of
+    // previous rows are below the begin of the current row
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> marker(ncol, -1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            sparse_row_product_fill(i,
+                                    A_row_offset,
+                                    A_col,
+                                    A_val,
+                                    B_row_offset,
+                                    B_col,
+                                    B_val,
+                                    I_row_offset[i],
+                                    I_row_offset[i],
+                                    &marker[0],
+                                    I_col,
+                                    I_val);
+        }
+    }
+
+    free_host_csr(&A_row_offset, &A_col, &A_val);
+    free_host_csr(&B_row_offset, &B_col, &B_val);
+
+    // Ghost part of the product, using the received boundary rows
+    copy_to_host_csr(A.matrix_ghost_, nrow, &A_row_offset, &A_col, &A_val);
+
+    communication_sync(&req_col);
+    communication_sync(&req_val);
+
+    communication_free_neighbor_comm(&neighbor_comm);
+
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
+
+    allocate_host(nrow + 1, &row_offset);
+
+    row_offset[0] = 0;
+
+    // Merge the ghost part into the interior part of each row
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> marker(ncol, -1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            for(int j = I_row_offset[i]; j < I_row_offset[i + 1]; ++j)
+            {
+                marker[I_col[j]] = i;
+            }
+
+            row_offset[i + 1] = I_row_offset[i + 1] - I_row_offset[i]
+                                + sparse_row_product_count(i,
+                                                           A_row_offset,
+                                                           A_col,
+                                                           recv_row_offset.data(),
+                                                           recv_col.data(),
+                                                           &marker[0]);
+        }
+    }
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        row_offset[i + 1] += row_offset[i];
+    }
+
+    allocate_host(row_offset[nrow], &col);
+    allocate_host(row_offset[nrow], &val);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> marker(ncol, -1);
+        std::vector<std::pair<int, ValueType>> row;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            int begin = row_offset[i];
+            int end   = begin;
+
+            for(int j = I_row_offset[i]; j < I_row_offset[i + 1]; ++j)
+            {
+                marker[I_col[j]] = end;
+                col[end]         = I_col[j];
+                val[end]         = I_val[j];
+                ++end;
+            }
+
+            end = sparse_row_product_fill(i,
+                                          A_row_offset,
+                                          A_col,
+                                          A_val,
+                                          recv_row_offset.data(),
+                                          recv_col.data(),
+                                          recv_val.data(),
+                                          begin,
+                                          end,
+                                          &marker[0],
+                                          col,
+                                          val);
+
+            // Only the merged row is sorted by column
+            row.clear();
+
+            for(int j = begin; j < end; ++j)
+            {
+                row.push_back(std::make_pair(col[j], val[j]));
+            }
+
+            std::sort(row.begin(), row.end(), compare_sparse_entry<ValueType>);
+
+            for(int j = begin; j < end; ++j)
+            {
+                col[j] = row[j - begin].first;
+                val[j] = row[j - begin].second;
+            }
+        }
+    }
+
+    free_host_csr(&A_row_offset, &A_col, &A_val);
+    free_host_csr(&I_row_offset, &I_col, &I_val);
+
+    this->Clear();
+    this->MoveToHost();
+    this->SetGlobalRowsCSR_(*src, &global_offset[0], row_offset, col, val, pm);
+    this->object_name_ = A.object_name_ + " * " + B.object_name_;
+
+    free_host_csr(&row_offset, &col, &val);
+
+    if(A.is_accel_() == true)
+    {
+        this->MoveToAccelerator();
+    }
+#else
+    LOG_INFO("Multinode support disabled");
+    FATAL_ERROR(__FILE__, __LINE__);
+#endif
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::InitialPairwiseAggregation(ValueType beta,
+                                                         int& nc,
+                                                         LocalVector<int>* G,
+                                                         int& Gsize,
+                                                         int** rG,
+                                                         int& rGsize,
+                                                         int ordering) const
+{
+    log_debug(this,
+              "GlobalMatrix::InitialPairwiseAggregation()",
+              beta,
+              nc,
+              G,
+              Gsize,
+              rG,
+              rGsize,
+              ordering);
+
+    // TODO asserts
+
+    LocalMatrix<ValueType> tmp;
+    tmp.CloneFrom(this->matrix_ghost_);
+    tmp.ConvertToCSR();
+
+    this->matrix_interior_.InitialPairwiseAggregation(
+        tmp, beta, nc, G, Gsize, rG, rGsize, ordering);
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::FurtherPairwiseAggregation(ValueType beta,
+                                                         int& nc,
+                                                         LocalVector<int>* G,
+                                                         int& Gsize,
+                                                         int** rG,
+                                                         int& rGsize,
+                                                         int ordering) const
+{
+    log_debug(this,
+              "GlobalMatrix::FurtherPairwiseAggregation()",
+              beta,
+              nc,
+              G,
+              Gsize,
+              rG,
+              rGsize,
+              ordering);
+
+    // TODO asserts
+
+    LocalMatrix<ValueType> tmp;
+    tmp.CloneFrom(this->matrix_ghost_);
+    tmp.ConvertToCSR();
+
+    this->matrix_interior_.FurtherPairwiseAggregation(
+        tmp, beta, nc, G, Gsize, rG, rGsize, ordering);
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::CoarsenOperator(GlobalMatrix<ValueType>* Ac,
+                                              ParallelManager* pm,
+                                              int nrow,
+                                              int ncol,
+                                              const LocalVector<int>& G,
+                                              int Gsize,
+                                              const int* rG,
+                                              int rGsize) const
+{
+    log_debug(this,
+              "GlobalMatrix::CoarsenOperator()",
+              Ac,
+              pm,
+              nrow,
+              ncol,
+              (const void*&)G,
+              Gsize,
+              rG,
+              rGsize);
+
+    assert(Ac != NULL);
+    assert(pm != NULL);
+    assert(rG != NULL);
+
+// TODO asserts
+
+#ifdef SUPPORT_MULTINODE
+    // MPI Requests for sync
+    std::vector<MRequest> req_mapping(this->pm_->nrecv_ + this->pm_->nsend_);
+    std::vector<MRequest> req_offsets(this->pm_->nrecv_ + this->pm_->nsend_);
+
+    // Determine connected pairs for the ghost layer of neighboring ranks
+    int** send_ghost_map = new int*[this->pm_->nsend_];
+    int** recv_ghost_map = new int*[this->pm_->nrecv_];
+
+    int* send_map_size = NULL;
+    int* recv_map_size = NULL;
+
+    allocate_host(this->pm_->nsend_, &send_map_size);
+    allocate_host(this->pm_->nrecv_, &recv_map_size);
+
+    // Receive sizes
+    for(int n = 0; n < this->pm_->nrecv_; ++n)
+    {
+        communication_async_recv(
+            &recv_map_size[n], 1, this->pm_->recvs_[n], 0, &req_mapping[n], this->pm_->comm_);
+    }
+
+    // Loop over neighbor ranks
+    for(int n = 0; n < this->pm_->nsend_; ++n)
+    {
+        send_ghost_map[n] =
+            new int[this->pm_->send_offset_index_[n + 1] - this->pm_->send_offset_index_[n]];
+
+        G.ExtractCoarseMapping(this->pm_->send_offset_index_[n],
+                               this->pm_->send_offset_index_[n + 1],
+                               this->pm_->boundary_index_,
+                               nrow,
+                               &send_map_size[n],
+                               send_ghost_map[n]);
+
+        // Send sizes
+        communication_async_send(&send_map_size[n],
+                                 1,
+                                 this->pm_->sends_[n],
+                                 0,
+                                 &req_mapping[this->pm_->nrecv_ + n],
+                                 this->pm_->comm_);
+    }
+
+    // Wait for mapping sizes communication to finish
+    communication_syncall(this->pm_->nrecv_ + this->pm_->nsend_, &req_mapping[0]);
+
+    // Receive mapping pairs
+    for(int n = 0; n < this->pm_->nrecv_; ++n)
+    {
+        recv_ghost_map[n] = new int[recv_map_size[n]];
+        communication_async_recv(recv_ghost_map[n],
+                                 recv_map_size[n],
+                                 this->pm_->recvs_[n],
+                                 0,
+                                 &req_mapping[n],
+                                 this->pm_->comm_);
     }
 
     // Send mapping pairs
@@ -1487,6 +2363,426 @@ void GlobalMatrix<ValueType>::CoarsenOperator(GlobalMatrix<ValueType>* Ac,
 #endif
 }
 
+template <typename ValueType>
+void GlobalMatrix<ValueType>::SplitRows_(void)
+{
+    log_debug(this, "GlobalMatrix::SplitRows_()");
+
+    assert(this->pm_ != NULL);
+
+    this->interior_rows_.clear();
+    this->boundary_rows_.clear();
+
+#ifdef SUPPORT_MULTINODE
+    int nrow = this->pm_->GetLocalSize();
+
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
+
+    copy_to_host_csr(this->matrix_ghost_, nrow, &row_offset, &col, &val);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        if(row_offset[i] == row_offset[i + 1])
+        {
+            this->interior_rows_.push_back(i);
+        }
+        else
+        {
+            this->boundary_rows_.push_back(i);
+        }
+    }
+
+    free_host_csr(&row_offset, &col, &val);
+#endif
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::GlobalOffsets_(int* global_offset) const
+{
+    log_debug(this, "GlobalMatrix::GlobalOffsets_()", global_offset);
+
+    assert(global_offset != NULL);
+    assert(this->pm_ != NULL);
+
+#ifdef SUPPORT_MULTINODE
+    communication_allgather_single(
+        this->pm_->GetLocalSize(), global_offset + 1, this->pm_->comm_);
+
+    global_offset[0] = 0;
+    for(int i = 0; i < this->pm_->num_procs_; ++i)
+    {
+        global_offset[i + 1] += global_offset[i];
+    }
+#endif
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::GhostToGlobal_(const int* global_offset, int* ghost_global) const
+{
+    log_debug(this, "GlobalMatrix::GhostToGlobal_()", global_offset, ghost_global);
+
+    assert(global_offset != NULL);
+    assert(this->pm_ != NULL);
+
+#ifdef SUPPORT_MULTINODE
+    const ParallelManager* pm = this->pm_;
+
+    // Global index of each boundary row
+    std::vector<int> send_buffer(pm->send_index_size_);
+
+    for(int i = 0; i < pm->send_index_size_; ++i)
+    {
+        send_buffer[i] = global_offset[pm->rank_] + pm->boundary_index_[i];
+    }
+
+    std::vector<MRequest> req(pm->nrecv_ + pm->nsend_);
+    int nreq = 0;
+
+    for(int n = 0; n < pm->nrecv_; ++n)
+    {
+        int size = pm->recv_offset_index_[n + 1] - pm->recv_offset_index_[n];
+
+        if(size > 0)
+        {
+            communication_async_recv(ghost_global + pm->recv_offset_index_[n],
+                                     size,
+                                     pm->recvs_[n],
+                                     0,
+                                     &req[nreq++],
+                                     pm->comm_);
+        }
+    }
+
+    for(int n = 0; n < pm->nsend_; ++n)
+    {
+        int size = pm->send_offset_index_[n + 1] - pm->send_offset_index_[n];
+
+        if(size > 0)
+        {
+            communication_async_send(&send_buffer[pm->send_offset_index_[n]],
+                                     size,
+                                     pm->sends_[n],
+                                     0,
+                                     &req[nreq++],
+                                     pm->comm_);
+        }
+    }
+
+    if(nreq > 0)
+    {
+        communication_syncall(nreq, &req[0]);
+    }
+#endif
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::GetGlobalRowsCSR_(const int* global_offset,
+                                                int** row_offset,
+                                                int** col,
+                                                ValueType** val) const
+{
+    log_debug(this, "GlobalMatrix::GetGlobalRowsCSR_()", global_offset, row_offset, col, val);
+
+    assert(global_offset != NULL);
+    assert(row_offset != NULL);
+    assert(col != NULL);
+    assert(val != NULL);
+    assert(this->pm_ != NULL);
+
+#ifdef SUPPORT_MULTINODE
+    int nrow   = this->pm_->GetLocalSize();
+    int offset = global_offset[this->pm_->rank_];
+
+    int* interior_row_offset = NULL;
+    int* interior_col        = NULL;
+    ValueType* interior_val  = NULL;
+    int* ghost_row_offset    = NULL;
+    int* ghost_col           = NULL;
+    ValueType* ghost_val     = NULL;
+
+    copy_to_host_csr(
+        this->matrix_interior_, nrow, &interior_row_offset, &interior_col, &interior_val);
+    copy_to_host_csr(this->matrix_ghost_, nrow, &ghost_row_offset, &ghost_col, &ghost_val);
+
+    // Global column index of the ghost columns
+    std::vector<int> ghost_global(this->pm_->GetNumReceivers() + 1);
+    this->GhostToGlobal_(global_offset, &ghost_global[0]);
+
+    allocate_host(nrow + 1, row_offset);
+
+    (*row_offset)[0] = 0;
+    for(int i = 0; i < nrow; ++i)
+    {
+        (*row_offset)[i + 1] = (*row_offset)[i] + interior_row_offset[i + 1] -
+                               interior_row_offset[i] + ghost_row_offset[i + 1] -
+                               ghost_row_offset[i];
+    }
+
+    allocate_host((*row_offset)[nrow], col);
+    allocate_host((*row_offset)[nrow], val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        int idx = (*row_offset)[i];
+
+        for(int j = interior_row_offset[i]; j < interior_row_offset[i + 1]; ++j)
+        {
+            (*col)[idx] = offset + interior_col[j];
+            (*val)[idx] = interior_val[j];
+            ++idx;
+        }
+
+        for(int j = ghost_row_offset[i]; j < ghost_row_offset[i + 1]; ++j)
+        {
+            (*col)[idx] = ghost_global[ghost_col[j]];
+            (*val)[idx] = ghost_val[j];
+            ++idx;
+        }
+    }
+
+    free_host_csr(&interior_row_offset, &interior_col, &interior_val);
+    free_host_csr(&ghost_row_offset, &ghost_col, &ghost_val);
+#endif
+}
+
+template <typename ValueType>
+void GlobalMatrix<ValueType>::SetGlobalRowsCSR_(const ParallelManager& src,
+                                                const int* global_offset,
+                                                const int* row_offset,
+                                                const int* col,
+                                                const ValueType* val,
+                                                ParallelManager* pm)
+{
+    log_debug(this,
+              "GlobalMatrix::SetGlobalRowsCSR_()",
+              (const void*&)src,
+              global_offset,
+              row_offset,
+              col,
+              val,
+              pm);
+
+    assert(global_offset != NULL);
+    assert(row_offset != NULL);
+    assert(pm != NULL);
+    assert(pm != &src);
+
+#ifdef SUPPORT_MULTINODE
+    int num_procs = src.num_procs_;
+    int nrow      = src.GetLocalSize();
+    int nnz       = row_offset[nrow];
+
+    int lower = global_offset[src.rank_];
+    int upper = global_offset[src.rank_ + 1];
+
+    // Sorted global indices of all ghost columns, they are implicitly grouped by their
+    // owning rank
+    std::vector<int> ghost_global;
+
+    for(int i = 0; i < nnz; ++i)
+    {
+        if(col[i] < lower || col[i] >= upper)
+        {
+            ghost_global.push_back(col[i]);
+        }
+    }
+
+    std::sort(ghost_global.begin(), ghost_global.end());
+    ghost_global.erase(std::unique(ghost_global.begin(), ghost_global.end()),
+                       ghost_global.end());
+
+    int nghost = static_cast<int>(ghost_global.size());
+
+    // Determine the owners of the ghost columns and their local row index
+    std::vector<int> recv_count(num_procs, 0);
+    std::vector<int> send_count(num_procs, 0);
+    std::vector<int> ghost_local(nghost);
+
+    int p = 0;
+    for(int i = 0; i < nghost; ++i)
+    {
+        while(ghost_global[i] >= global_offset[p + 1])
+        {
+            ++p;
+        }
+
+        ++recv_count[p];
+        ghost_local[i] = ghost_global[i] - global_offset[p];
+    }
+
+    // Each owner needs to know how many of its rows are required
+    communication_alltoall_single(&recv_count[0], &send_count[0], src.comm_);
+
+    std::vector<int> recvs;
+    std::vector<int> sends;
+    std::vector<int> recv_offset(1, 0);
+    std::vector<int> send_offset(1, 0);
+
+    for(p = 0; p < num_procs; ++p)
+    {
+        if(recv_count[p] > 0)
+        {
+            recvs.push_back(p);
+            recv_offset.push_back(recv_offset.back() + recv_count[p]);
+        }
+
+        if(send_count[p] > 0)
+        {
+            sends.push_back(p);
+            send_offset.push_back(send_offset.back() + send_count[p]);
+        }
+    }
+
+    int nrecv         = static_cast<int>(recvs.size());
+    int nsend         = static_cast<int>(sends.size());
+    int boundary_size = send_offset[nsend];
+
+    // Request the boundary rows from their owners
+    std::vector<int> boundary_index(boundary_size);
+    std::vector<MRequest> req(nrecv + nsend);
+
+    for(int n = 0; n < nsend; ++n)
+    {
+        communication_async_recv(&boundary_index[send_offset[n]],
+                                 send_offset[n + 1] - send_offset[n],
+                                 sends[n],
+                                 0,
+                                 &req[n],
+                                 src.comm_);
+    }
+
+    for(int n = 0; n < nrecv; ++n)
+    {
+        communication_async_send(&ghost_local[recv_offset[n]],
+                                 recv_offset[n + 1] - recv_offset[n],
+                                 recvs[n],
+                                 0,
+                                 &req[nsend + n],
+                                 src.comm_);
+    }
+
+    // Split the rows into interior and ghost part
+    int* interior_row_offset = NULL;
+    int* interior_col        = NULL;
+    ValueType* interior_val  = NULL;
+    int* ghost_row_offset    = NULL;
+    int* ghost_col           = NULL;
+    ValueType* ghost_val     = NULL;
+
+    allocate_host(nrow + 1, &interior_row_offset);
+    allocate_host(nrow + 1, &ghost_row_offset);
+
+    interior_row_offset[0] = 0;
+    ghost_row_offset[0]    = 0;
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        int interior_nnz = 0;
+
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            if(col[j] >= lower && col[j] < upper)
+            {
+                ++interior_nnz;
+            }
+        }
+
+        interior_row_offset[i + 1] = interior_row_offset[i] + interior_nnz;
+        ghost_row_offset[i + 1] =
+            ghost_row_offset[i] + row_offset[i + 1] - row_offset[i] - interior_nnz;
+    }
+
+    int interior_nnz = interior_row_offset[nrow];
+    int ghost_nnz    = ghost_row_offset[nrow];
+
+    allocate_host(interior_nnz, &interior_col);
+    allocate_host(interior_nnz, &interior_val);
+    allocate_host(ghost_nnz, &ghost_col);
+    allocate_host(ghost_nnz, &ghost_val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        int interior_idx = interior_row_offset[i];
+        int ghost_idx    = ghost_row_offset[i];
+
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            if(col[j] >= lower && col[j] < upper)
+            {
+                interior_col[interior_idx] = col[j] - lower;
+                interior_val[interior_idx] = val[j];
+                ++interior_idx;
+            }
+            else
+            {
+                ghost_col[ghost_idx] = static_cast<int>(
+                    std::lower_bound(ghost_global.begin(), ghost_global.end(), col[j]) -
+                    ghost_global.begin());
+                ghost_val[ghost_idx] = val[j];
+                ++ghost_idx;
+            }
+        }
+    }
+
+    if(nrecv + nsend > 0)
+    {
+        communication_syncall(nrecv + nsend, &req[0]);
+    }
+
+    // Set up the communication pattern
+    pm->Clear();
+    pm->SetMPICommunicator(src.comm_);
+    pm->SetGlobalSize(global_offset[num_procs]);
+    pm->SetLocalSize(nrow);
+
+    if(boundary_size > 0)
+    {
+        pm->SetBoundaryIndex(boundary_size, &boundary_index[0]);
+    }
+
+    if(nrecv > 0)
+    {
+        pm->SetReceivers(nrecv, &recvs[0], &recv_offset[0]);
+    }
+
+    if(nsend > 0)
+    {
+        pm->SetSenders(nsend, &sends[0], &send_offset[0]);
+    }
+
+    this->Clear();
+    this->SetParallelManager(*pm);
+
+    if(ghost_nnz > 0)
+    {
+        this->SetDataPtrCSR(&interior_row_offset,
+                            &interior_col,
+                            &interior_val,
+                            &ghost_row_offset,
+                            &ghost_col,
+                            &ghost_val,
+                            "",
+                            interior_nnz,
+                            ghost_nnz);
+    }
+    else
+    {
+        this->SetLocalDataPtrCSR(
+            &interior_row_offset, &interior_col, &interior_val, "", interior_nnz);
+
+        free_host(&ghost_row_offset);
+    }
+#endif
+}
+
 template class GlobalMatrix<double>;
 template class GlobalMatrix<float>;
 #ifdef SUPPORT_COMPLEX
@@ -28,6 +28,8 @@
 #include "operator.hpp"
 #include "parallel_manager.hpp"
 
+#include <vector>
+
 namespace rocalution {
 
 template <typename ValueType>
@@ -168,8 +170,18 @@ class GlobalMatrix : public Operator<ValueType>
     void ConvertToHYB(void);
     /** \brief Convert the matrix to DENSE structure */
     void ConvertToDENSE(void);
+    /** \brief Convert the matrix to SELL-C-sigma structure */
+    void ConvertToSELL(void);
+    /** \brief Convert the matrix to compressed CSR structure, with single precision or
+      * bfloat16 values
+      */
+    void ConvertToCCSR(bool bfloat16 = false);
     /** \brief Convert the matrix to specified matrix ID format */
     void ConvertTo(unsigned int matrix_format);
+    /** \brief Select the format of the interior matrix automatically, see
+      * LocalMatrix::AutoTuneFormat(). The ghost part remains COO.
+      */
+    unsigned int AutoTuneFormat(bool benchmark = false);
 
     virtual void Apply(const GlobalVector<ValueType>& in, GlobalVector<ValueType>* out) const;
     virtual void ApplyAdd(const GlobalVector<ValueType>& in,
@@ -193,9 +205,43 @@ class GlobalMatrix : public Operator<ValueType>
       */
     void ExtractInverseDiagonal(GlobalVector<ValueType>* vec_inv_diag) const;
 
+    /** \brief Extract the diagonal values of the matrix into a GlobalVector */
+    void ExtractDiagonal(GlobalVector<ValueType>* vec_diag) const;
+
     /** \brief Scale all the values in the matrix */
     void Scale(ValueType alpha);
 
+    /** \brief Transpose the matrix
+      * \details
+      * The entries are redistributed among all ranks. The columns are owned by the same
+      * ranks as the rows with the same index, as given by the ParallelManager of the
+      * matrix. The communication pattern of the transposed matrix is set up in \p pm,
+      * which becomes the parallel manager of the matrix and therefore has to stay valid
+      * as long as the matrix is in use.
+      */
+    void Transpose(ParallelManager* pm);
+
+    /** \brief Perform matrix addition, this = alpha*this + beta*mat
+      * \details
+      * Both matrices need to share the same row distribution. The communication pattern
+      * of the result is set up in \p pm.
+      */
+    void MatrixAdd(const GlobalMatrix<ValueType>& mat,
+                   ValueType alpha,
+                   ValueType beta,
+                   ParallelManager* pm);
+
+    /** \brief Multiply two matrices, this = A * B
+      * \details
+      * Rows of \p B that are required by the ghost part of \p A are fetched from the
+      * neighboring ranks, following the communication pattern of \p A, while the
+      * interior part of the product is computed. \p A and \p B need to share the same
+      * row distribution. The communication pattern of the result is set up in \p pm.
+      */
+    void MatrixMult(const GlobalMatrix<ValueType>& A,
+                    const GlobalMatrix<ValueType>& B,
+                    ParallelManager* pm);
+
     /** \brief Initial Pairwise Aggregation scheme */
     void InitialPairwiseAggregation(ValueType beta,
                                     int& nc,
@@ -227,11 +273,39 @@ class GlobalMatrix : public Operator<ValueType>
     virtual bool is_accel_(void) const;
 
     private:
+    /** \brief Split the local rows into rows with and without ghost entries */
+    void SplitRows_(void);
+    /** \brief Compute the global row offset of each rank */
+    void GlobalOffsets_(int* global_offset) const;
+    /** \brief Map each ghost column to its global column index */
+    void GhostToGlobal_(const int* global_offset, int* ghost_global) const;
+    /** \brief Extract the local rows (interior and ghost) on the host, using global
+      * column indices
+      */
+    void GetGlobalRowsCSR_(const int* global_offset,
+                           int** row_offset,
+                           int** col,
+                           ValueType** val) const;
+    /** \brief Initialize the matrix from local rows with global column indices and set
+      * up the corresponding communication pattern in pm
+      */
+    void SetGlobalRowsCSR_(const ParallelManager& src,
+                           const int* global_offset,
+                           const int* row_offset,
+                           const int* col,
+                           const ValueType* val,
+                           ParallelManager* pm);
+
     IndexType2 nnz_;
 
     LocalMatrix<ValueType> matrix_interior_;
     LocalMatrix<ValueType> matrix_ghost_;
 
+    // Local rows without (interior) and with (boundary) entries in the ghost part,
+    // empty if the rows have not been split
+    std::vector<int> interior_rows_;
+    std::vector<int> boundary_rows_;
+
     friend class GlobalVector<ValueType>;
     friend class LocalMatrix<ValueType>;
     friend class LocalVector<ValueType>;
@@ -25,6 +25,7 @@
 #include "global_vector.hpp"
 #include "local_vector.hpp"
 #include "../utils/log.hpp"
+#include "../utils/trace.hpp"
 #include "../utils/allocate_free.hpp"
 
 #ifdef SUPPORT_MULTINODE
@@ -37,6 +38,7 @@
 #include <limits>
 #include <algorithm>
 #include <complex>
+#include <vector>
 
 namespace rocalution {
 
@@ -59,6 +61,14 @@ GlobalVector<ValueType>::GlobalVector()
     this->recv_event_ = NULL;
     this->send_event_ = NULL;
 #endif
+
+    this->nrecv_event_ = -1;
+    this->nsend_event_ = -1;
+
+    this->dot_event_   = NULL;
+    this->dot_local_   = NULL;
+    this->dot_size_    = 0;
+    this->dot_pending_ = false;
 }
 
 template <typename ValueType>
@@ -79,6 +89,14 @@ GlobalVector<ValueType>::GlobalVector(const ParallelManager& pm)
     this->recv_event_ = new MRequest[pm.nrecv_];
     this->send_event_ = new MRequest[pm.nsend_];
 #endif
+
+    this->nrecv_event_ = -1;
+    this->nsend_event_ = -1;
+
+    this->dot_event_   = NULL;
+    this->dot_local_   = NULL;
+    this->dot_size_    = 0;
+    this->dot_pending_ = false;
 }
 
 template <typename ValueType>
@@ -88,7 +106,20 @@ GlobalVector<ValueType>::~GlobalVector()
 
     this->Clear();
 
+    this->MultiDotSync();
+
+    if(this->dot_local_ != NULL)
+    {
+        free_host(&this->dot_local_);
+    }
+
 #ifdef SUPPORT_MULTINODE
+    if(this->dot_event_ != NULL)
+    {
+        delete this->dot_event_;
+        this->dot_event_ = NULL;
+    }
+
     if(this->recv_event_ != NULL)
     {
         delete[] this->recv_event_;
@@ -108,6 +139,8 @@ void GlobalVector<ValueType>::Clear(void)
 {
     log_debug(this, "GlobalVector::Clear()");
 
+    this->FreeGhostRequests_();
+
     this->vector_interior_.Clear();
     this->vector_ghost_.Clear();
 
@@ -129,6 +162,8 @@ void GlobalVector<ValueType>::SetParallelManager(const ParallelManager& pm)
 
     assert(pm.Status() == true);
 
+    this->FreeGhostRequests_();
+
     this->pm_ = &pm;
 }
 
@@ -206,6 +241,8 @@ void GlobalVector<ValueType>::Allocate(std::string name, IndexType2 size)
     this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(), this->pm_->boundary_index_);
 
     // Allocate send and receive buffer
+    this->FreeGhostRequests_();
+
     allocate_host(this->pm_->GetNumReceivers(), &this->recv_boundary_);
     allocate_host(this->pm_->GetNumSenders(), &this->send_boundary_);
 }
@@ -270,6 +307,8 @@ void GlobalVector<ValueType>::SetDataPtr(ValueType** ptr, std::string name, Inde
     this->vector_interior_.SetIndexArray(this->pm_->GetNumSenders(), this->pm_->boundary_index_);
 
     // Allocate send and receive buffer
+    this->FreeGhostRequests_();
+
     allocate_host(this->pm_->GetNumReceivers(), &this->recv_boundary_);
     allocate_host(this->pm_->GetNumSenders(), &this->send_boundary_);
 }
@@ -284,6 +323,8 @@ void GlobalVector<ValueType>::LeaveDataPtr(ValueType** ptr)
 
     this->vector_interior_.LeaveDataPtr(ptr);
 
+    this->FreeGhostRequests_();
+
     free_host(&this->recv_boundary_);
     free_host(&this->send_boundary_);
 
@@ -295,7 +336,7 @@ void GlobalVector<ValueType>::SetRandomUniform(unsigned long long seed, ValueTyp
 {
     log_debug(this, "GlobalVector::SetRandomUniform()", seed, a, b);
 
-    this->vector_interior_.SetRandomUniform(seed, a, b);
+    this->vector_interior_.SetRandomUniform_(seed, a, b, this->GetGlobalOffset_());
 }
 
 template <typename ValueType>
@@ -305,7 +346,30 @@ void GlobalVector<ValueType>::SetRandomNormal(unsigned long long seed,
 {
     log_debug(this, "GlobalVector::SetRandomNormal()", seed, mean, var);
 
-    this->vector_interior_.SetRandomUniform(seed, mean, var);
+    this->vector_interior_.SetRandomNormal_(seed, mean, var, this->GetGlobalOffset_());
+}
+
+template <typename ValueType>
+IndexType2 GlobalVector<ValueType>::GetGlobalOffset_(void) const
+{
+    IndexType2 offset = 0;
+
+#ifdef SUPPORT_MULTINODE
+    assert(this->pm_ != NULL);
+
+    // The interior parts of the ranks are ordered by rank
+    std::vector<int> local_size(this->pm_->num_procs_);
+
+    communication_allgather_single(
+        static_cast<int>(this->vector_interior_.GetSize()), &local_size[0], this->pm_->comm_);
+
+    for(int i = 0; i < this->pm_->rank_; ++i)
+    {
+        offset += local_size[i];
+    }
+#endif
+
+    return offset;
 }
 
 template <typename ValueType>
@@ -476,6 +540,8 @@ void GlobalVector<ValueType>::ReadFileASCII(const std::string filename)
     this->vector_ghost_.Allocate("ghost", this->pm_->GetNumReceivers());
 
     // Allocate send and receive buffer
+    this->FreeGhostRequests_();
+
     allocate_host(this->pm_->GetNumReceivers(), &this->recv_boundary_);
     allocate_host(this->pm_->GetNumSenders(), &this->send_boundary_);
 }
@@ -571,6 +637,8 @@ void GlobalVector<ValueType>::ReadFileBinary(const std::string filename)
     this->vector_ghost_.Allocate("ghost", this->pm_->GetNumReceivers());
 
     // Allocate send and receive buffer
+    this->FreeGhostRequests_();
+
     allocate_host(this->pm_->GetNumReceivers(), &this->recv_boundary_);
     allocate_host(this->pm_->GetNumSenders(), &this->send_boundary_);
 }
@@ -663,6 +731,8 @@ ValueType GlobalVector<ValueType>::Dot(const GlobalVector<ValueType>& x) const
 {
     log_debug(this, "GlobalVector::Dot()", (const void*&)x);
 
+    ROCALUTION_TRACE_SCOPE("GlobalVector::Dot", "global");
+
     ValueType local = this->vector_interior_.Dot(x.vector_interior_);
     ValueType global;
 
@@ -680,6 +750,8 @@ ValueType GlobalVector<ValueType>::DotNonConj(const GlobalVector<ValueType>& x)
 {
     log_debug(this, "GlobalVector::DotNonConj()", (const void*&)x);
 
+    ROCALUTION_TRACE_SCOPE("GlobalVector::DotNonConj", "global");
+
     ValueType local = this->vector_interior_.DotNonConj(x.vector_interior_);
     ValueType global;
 
@@ -697,6 +769,8 @@ ValueType GlobalVector<ValueType>::Norm(void) const
 {
     log_debug(this, "GlobalVector::Norm()");
 
+    ROCALUTION_TRACE_SCOPE("GlobalVector::Norm", "global");
+
     ValueType result = this->Dot(*this);
     return sqrt(result);
 }
@@ -760,14 +834,27 @@ void GlobalVector<ValueType>::PointWiseMult(const GlobalVector<ValueType>& x,
 }
 
 template <typename ValueType>
-void GlobalVector<ValueType>::UpdateGhostValuesAsync_(const GlobalVector<ValueType>& in)
+void GlobalVector<ValueType>::InitGhostRequests_(void)
 {
-    log_debug(this, "GlobalVector::UpdateGhostValuesAsync_()", "#*# begin", (const void*&)in);
+    log_debug(this, "GlobalVector::InitGhostRequests_()");
+
+    assert(this->nrecv_event_ < 0);
+    assert(this->nsend_event_ < 0);
 
 #ifdef SUPPORT_MULTINODE
+    // The parallel manager might have changed since the request arrays were allocated
+    delete[] this->recv_event_;
+    delete[] this->send_event_;
+
+    this->recv_event_ = new MRequest[this->pm_->nrecv_];
+    this->send_event_ = new MRequest[this->pm_->nsend_];
+
     int tag = 0;
 
-    // async recv boundary from neighbors
+    this->nrecv_event_ = 0;
+    this->nsend_event_ = 0;
+
+    // persistent recv of the boundary from neighbors
     for(int i = 0; i < this->pm_->nrecv_; ++i)
     {
         // nnz that we receive from process i
@@ -776,19 +863,16 @@ void GlobalVector<ValueType>::UpdateGhostValuesAsync_(const GlobalVector<ValueTy
         // if this has ghost values that belong to process i
         if(boundary_nnz > 0)
         {
-            communication_async_recv(this->recv_boundary_ + this->pm_->recv_offset_index_[i],
-                                     boundary_nnz,
-                                     this->pm_->recvs_[i],
-                                     tag,
-                                     &this->recv_event_[i],
-                                     this->pm_->comm_);
+            communication_persistent_recv(this->recv_boundary_ + this->pm_->recv_offset_index_[i],
+                                          boundary_nnz,
+                                          this->pm_->recvs_[i],
+                                          tag,
+                                          &this->recv_event_[this->nrecv_event_++],
+                                          this->pm_->comm_);
         }
     }
 
-    // prepare send buffer
-    in.vector_interior_.GetIndexValues(this->send_boundary_);
-
-    // async send boundary to neighbors
+    // persistent send of the boundary to neighbors
     for(int i = 0; i < this->pm_->nsend_; ++i)
     {
         // nnz that we send to process i
@@ -797,28 +881,104 @@ void GlobalVector<ValueType>::UpdateGhostValuesAsync_(const GlobalVector<ValueTy
         // if process i has ghost values that belong to this
         if(boundary_nnz > 0)
         {
-            communication_async_send(this->send_boundary_ + this->pm_->send_offset_index_[i],
-                                     boundary_nnz,
-                                     this->pm_->sends_[i],
-                                     tag,
-                                     &this->send_event_[i],
-                                     this->pm_->comm_);
+            communication_persistent_send(this->send_boundary_ + this->pm_->send_offset_index_[i],
+                                          boundary_nnz,
+                                          this->pm_->sends_[i],
+                                          tag,
+                                          &this->send_event_[this->nsend_event_++],
+                                          this->pm_->comm_);
         }
     }
 #endif
+}
+
+template <typename ValueType>
+void GlobalVector<ValueType>::FreeGhostRequests_(void)
+{
+    log_debug(this, "GlobalVector::FreeGhostRequests_()");
+
+#ifdef SUPPORT_MULTINODE
+    if(this->nrecv_event_ > 0)
+    {
+        communication_freeall(this->nrecv_event_, this->recv_event_);
+    }
+
+    if(this->nsend_event_ > 0)
+    {
+        communication_freeall(this->nsend_event_, this->send_event_);
+    }
+#endif
+
+    this->nrecv_event_ = -1;
+    this->nsend_event_ = -1;
+}
+
+template <typename ValueType>
+void GlobalVector<ValueType>::UpdateGhostValuesAsync_(const GlobalVector<ValueType>& in)
+{
+    log_debug(this, "GlobalVector::UpdateGhostValuesAsync_()", "#*# begin", (const void*&)in);
+
+    ROCALUTION_TRACE_SCOPE("GlobalVector::UpdateGhostValuesAsync_", "communication");
+
+#ifdef SUPPORT_MULTINODE
+    // Persistent requests are created once and restarted for every update
+    if(this->nrecv_event_ < 0)
+    {
+        this->InitGhostRequests_();
+    }
+
+    // async recv boundary from neighbors
+    if(this->nrecv_event_ > 0)
+    {
+        communication_startall(this->nrecv_event_, this->recv_event_);
+    }
+
+    // prepare send buffer
+    in.vector_interior_.GetIndexValues(this->send_boundary_);
+
+    // async send boundary to neighbors
+    if(this->nsend_event_ > 0)
+    {
+        communication_startall(this->nsend_event_, this->send_event_);
+    }
+#endif
 
     log_debug(this, "GlobalVector::UpdateGhostValuesAsync_()", "#*# end");
 }
 
+template <typename ValueType>
+void GlobalVector<ValueType>::UpdateGhostValuesProgress_(void)
+{
+    log_debug(this, "GlobalVector::UpdateGhostValuesProgress_()");
+
+#ifdef SUPPORT_MULTINODE
+    // Testing the requests lets MPI progress the messages that are in flight
+    if(this->nrecv_event_ > 0)
+    {
+        communication_testall(this->nrecv_event_, this->recv_event_);
+    }
+
+    if(this->nsend_event_ > 0)
+    {
+        communication_testall(this->nsend_event_, this->send_event_);
+    }
+#endif
+}
+
 template <typename ValueType>
 void GlobalVector<ValueType>::UpdateGhostValuesSync_(void)
 {
     log_debug(this, "GlobalVector::UpdateGhostValuesSync_()", "#*# begin");
 
+    ROCALUTION_TRACE_SCOPE("GlobalVector::UpdateGhostValuesSync_", "communication");
+
 #ifdef SUPPORT_MULTINODE
+    assert(this->nrecv_event_ >= 0);
+    assert(this->nsend_event_ >= 0);
+
     // Sync before updating ghost values
-    communication_syncall(this->pm_->nrecv_, this->recv_event_);
-    communication_syncall(this->pm_->nsend_, this->send_event_);
+    communication_syncall(this->nrecv_event_, this->recv_event_);
+    communication_syncall(this->nsend_event_, this->send_event_);
 
     this->vector_ghost_.SetContinuousValues(0, this->pm_->GetNumReceivers(), this->recv_boundary_);
 #endif
@@ -834,6 +994,110 @@ void GlobalVector<ValueType>::Power(double power)
     this->vector_interior_.Power(power);
 }
 
+template <typename ValueType>
+void GlobalVector<ValueType>::MultiDot(int n,
+                                       const GlobalVector<ValueType>* const* x,
+                                       const GlobalVector<ValueType>* const* y,
+                                       ValueType* result)
+{
+    ROCALUTION_TRACE_SCOPE("GlobalVector::MultiDot", "global");
+
+    assert(n > 0);
+    assert(x != NULL);
+    assert(y != NULL);
+    assert(result != NULL);
+
+    log_debug(x[0], "GlobalVector::MultiDot()", n, x, y, result);
+
+    std::vector<ValueType> local(n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        local[i] = x[i]->vector_interior_.Dot(y[i]->vector_interior_);
+    }
+
+#ifdef SUPPORT_MULTINODE
+    assert(x[0]->pm_ != NULL);
+
+    communication_allreduce_sum(&local[0], result, n, x[0]->pm_->comm_);
+#else
+    for(int i = 0; i < n; ++i)
+    {
+        result[i] = local[i];
+    }
+#endif
+}
+
+template <typename ValueType>
+void GlobalVector<ValueType>::MultiDotAsync(int n,
+                                            const GlobalVector<ValueType>* const* x,
+                                            const GlobalVector<ValueType>* const* y,
+                                            ValueType* result)
+{
+    ROCALUTION_TRACE_SCOPE("GlobalVector::MultiDotAsync", "global");
+
+    log_debug(this, "GlobalVector::MultiDotAsync()", n, x, y, result);
+
+    assert(n > 0);
+    assert(x != NULL);
+    assert(y != NULL);
+    assert(result != NULL);
+    assert(this->dot_pending_ == false);
+
+    // The local dot products have to persist until the reduction is complete
+    if(this->dot_size_ < n)
+    {
+        if(this->dot_local_ != NULL)
+        {
+            free_host(&this->dot_local_);
+        }
+
+        allocate_host(n, &this->dot_local_);
+        this->dot_size_ = n;
+    }
+
+    for(int i = 0; i < n; ++i)
+    {
+        this->dot_local_[i] = x[i]->vector_interior_.Dot(y[i]->vector_interior_);
+    }
+
+#ifdef SUPPORT_MULTINODE
+    assert(x[0]->pm_ != NULL);
+
+    if(this->dot_event_ == NULL)
+    {
+        this->dot_event_ = new MRequest;
+    }
+
+    communication_async_allreduce_sum(
+        this->dot_local_, result, n, this->dot_event_, x[0]->pm_->comm_);
+
+    this->dot_pending_ = true;
+#else
+    for(int i = 0; i < n; ++i)
+    {
+        result[i] = this->dot_local_[i];
+    }
+#endif
+}
+
+template <typename ValueType>
+void GlobalVector<ValueType>::MultiDotSync(void)
+{
+    log_debug(this, "GlobalVector::MultiDotSync()");
+
+#ifdef SUPPORT_MULTINODE
+    if(this->dot_pending_ == true)
+    {
+        ROCALUTION_TRACE_SCOPE("GlobalVector::MultiDotSync", "global");
+
+        communication_sync(this->dot_event_);
+
+        this->dot_pending_ = false;
+    }
+#endif
+}
+
 template <typename ValueType>
 void GlobalVector<ValueType>::Restriction(const GlobalVector<ValueType>& vec_fine,
                                           const LocalVector<int>& map)
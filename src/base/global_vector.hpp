@@ -36,6 +36,8 @@ template <typename ValueType>
 class LocalMatrix;
 template <typename ValueType>
 class GlobalMatrix;
+template <typename ValueType>
+class GlobalCallbackOperator;
 struct MRequest;
 
 /** \ingroup op_vec_module
@@ -132,6 +134,30 @@ class GlobalVector : public Vector<ValueType>
 
     virtual void Power(double power);
 
+    /** \brief Compute the dot products of n vector pairs, such that
+      * \p result[i] = \p x[i]->Dot(*\p y[i]), using a single global reduction
+      */
+    static void MultiDot(int n,
+                         const GlobalVector<ValueType>* const* x,
+                         const GlobalVector<ValueType>* const* y,
+                         ValueType* result);
+
+    /** \brief Start the computation of the dot products of n vector pairs, such that
+      * \p result[i] = \p x[i]->Dot(*\p y[i]), using a single non-blocking global
+      * reduction
+      * \details
+      * The reduction is attached to this vector and completed by MultiDotSync(), \p result
+      * must not be accessed before. In between, other work such as operator applications
+      * can hide the latency of the reduction. Only one reduction can be pending per
+      * vector.
+      */
+    void MultiDotAsync(int n,
+                       const GlobalVector<ValueType>* const* x,
+                       const GlobalVector<ValueType>* const* y,
+                       ValueType* result);
+    /** \brief Complete the dot products started by MultiDotAsync() */
+    void MultiDotSync(void);
+
     /** \brief Restriction operator based on restriction mapping vector */
     void Restriction(const GlobalVector<ValueType>& vec_fine, const LocalVector<int>& map);
 
@@ -144,13 +170,32 @@ class GlobalVector : public Vector<ValueType>
 
     /** \brief Update ghost values asynchronously */
     void UpdateGhostValuesAsync_(const GlobalVector<ValueType>& in);
+    /** \brief Progress an ongoing asynchronous ghost value update */
+    void UpdateGhostValuesProgress_(void);
     /** \brief Update ghost values synchronously */
     void UpdateGhostValuesSync_(void);
 
     private:
+    /** \brief Create the persistent requests of the ghost value update */
+    void InitGhostRequests_(void);
+    /** \brief Free the persistent requests of the ghost value update */
+    void FreeGhostRequests_(void);
+    /** \brief Global index of the first interior entry of this rank */
+    IndexType2 GetGlobalOffset_(void) const;
+
     MRequest* recv_event_;
     MRequest* send_event_;
 
+    // Number of persistent receive and send requests, -1 if not created
+    int nrecv_event_;
+    int nsend_event_;
+
+    // Request and local dot products of the reduction started by MultiDotAsync()
+    MRequest* dot_event_;
+    ValueType* dot_local_;
+    int dot_size_;
+    bool dot_pending_;
+
     ValueType* recv_boundary_;
     ValueType* send_boundary_;
 
@@ -159,6 +204,7 @@ class GlobalVector : public Vector<ValueType>
 
     friend class LocalMatrix<ValueType>;
     friend class GlobalMatrix<ValueType>;
+    friend class GlobalCallbackOperator<ValueType>;
 
     friend class BaseRocalution<ValueType>;
 };
@@ -45,8 +45,54 @@
 
 #include "../../utils/log.hpp"
 
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
 namespace rocalution {
 
+#if defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__)
+// Read a sysfs list such as "0-15,32-47"
+static void rocalution_read_sysfs_list(const std::string& filename, std::vector<int>* list)
+{
+    list->clear();
+
+    std::ifstream in(filename.c_str());
+
+    if(!in.is_open())
+    {
+        return;
+    }
+
+    std::string range;
+
+    while(std::getline(in, range, ','))
+    {
+        std::istringstream ss(range);
+
+        int first = -1;
+        int last  = -1;
+        char dash;
+
+        if(!(ss >> first))
+        {
+            continue;
+        }
+
+        if(!(ss >> dash >> last))
+        {
+            last = first;
+        }
+
+        for(int i = first; i <= last; ++i)
+        {
+            list->push_back(i);
+        }
+    }
+}
+#endif // linux
+
 void rocalution_set_omp_affinity(bool aff)
 {
     if(aff == true)
@@ -141,4 +187,80 @@ void rocalution_set_omp_affinity(bool aff)
     }
 }
 
+int rocalution_set_omp_numa_affinity(int nthreads)
+{
+    int nnodes = 1;
+
+#ifdef _OPENMP
+#if defined(__gnu_linux__) || defined(linux) || defined(__linux) || defined(__linux__)
+    if(nthreads < 1)
+    {
+        return nnodes;
+    }
+
+    std::vector<int> online;
+    rocalution_read_sysfs_list("/sys/devices/system/node/online", &online);
+
+    // CPUs of all nodes that have CPUs (memory-only nodes are skipped)
+    std::vector<std::vector<int> > cpus;
+
+    for(size_t i = 0; i < online.size(); ++i)
+    {
+        std::ostringstream filename;
+        filename << "/sys/devices/system/node/node" << online[i] << "/cpulist";
+
+        std::vector<int> list;
+        rocalution_read_sysfs_list(filename.str(), &list);
+
+        if(list.empty() == false)
+        {
+            cpus.push_back(list);
+        }
+    }
+
+    nnodes = static_cast<int>(cpus.size());
+
+    if(nnodes < 2)
+    {
+        LOG_VERBOSE_INFO(2, "Host NUMA placement - single NUMA node, using default affinity");
+        rocalution_set_omp_affinity(true);
+
+        return 1;
+    }
+
+    // Not more nodes than threads
+    nnodes = (nthreads < nnodes) ? nthreads : nnodes;
+
+    // Thread t works on node t * nnodes / nthreads. The static schedule of the host
+    // kernels assigns contiguous row blocks to contiguous thread ids, such that each
+    // node processes (and first touches) a contiguous block of rows.
+#pragma omp parallel num_threads(nthreads)
+    {
+        int tid  = omp_get_thread_num();
+        int node = static_cast<int>(static_cast<long>(tid) * nnodes / nthreads);
+
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+
+        for(size_t i = 0; i < cpus[node].size(); ++i)
+        {
+            CPU_SET(cpus[node][i], &mask);
+        }
+
+        sched_setaffinity(0, sizeof(mask), &mask);
+    }
+
+    LOG_VERBOSE_INFO(2,
+                     "Host thread affinity policy - " << nthreads << " threads on " << nnodes
+                                                      << " NUMA nodes");
+#else // !linux
+
+    LOG_VERBOSE_INFO(2, "The default OS thread affinity configuration will be used");
+
+#endif // linux
+#endif // omp
+
+    return nnodes;
+}
+
 } // namespace rocalution
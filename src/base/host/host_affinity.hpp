@@ -28,6 +28,10 @@ namespace rocalution {
 
 void rocalution_set_omp_affinity(bool aff);
 
+// Bind the threads of the OpenMP team in contiguous blocks to the NUMA nodes and return
+// the number of nodes in use
+int rocalution_set_omp_numa_affinity(int nthreads);
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HOST_HOST_AFFINITY_HPP_
@@ -29,7 +29,10 @@
 #include "../../utils/log.hpp"
 
 #include <stdlib.h>
+#include <algorithm>
 #include <complex>
+#include <utility>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -509,6 +512,391 @@ bool ell_to_csr(int omp_threads,
     return true;
 }
 
+template <typename ValueType, typename IndexType>
+bool csr_to_sell(int omp_threads,
+                 IndexType nnz,
+                 IndexType nrow,
+                 IndexType ncol,
+                 IndexType chunk_size,
+                 IndexType sigma,
+                 const MatrixCSR<ValueType, IndexType>& src,
+                 MatrixSELL<ValueType, IndexType>* dst,
+                 IndexType* size_sell)
+{
+    assert(nnz > 0);
+    assert(nrow > 0);
+    assert(ncol > 0);
+    assert(chunk_size > 0);
+    assert(sigma > 0);
+    assert(sigma % chunk_size == 0);
+
+    omp_set_num_threads(omp_threads);
+
+    IndexType nchunk = (nrow - 1) / chunk_size + 1;
+
+    dst->chunk_size = chunk_size;
+    dst->sigma      = sigma;
+
+    allocate_host(nchunk + 1, &dst->chunk_offset);
+    allocate_host(nrow, &dst->row_perm);
+    allocate_host(nrow, &dst->row_nnz);
+
+    // Sort the rows by descending length within each sorting window
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType w = 0; w < nrow; w += sigma)
+    {
+        IndexType end = std::min(w + sigma, nrow);
+
+        // Negative length first, ties are kept in the original order
+        std::vector<std::pair<IndexType, IndexType>> rows(end - w);
+
+        for(IndexType i = w; i < end; ++i)
+        {
+            rows[i - w] = std::make_pair(src.row_offset[i] - src.row_offset[i + 1], i);
+        }
+
+        std::sort(rows.begin(), rows.end());
+
+        for(IndexType i = w; i < end; ++i)
+        {
+            dst->row_perm[i] = rows[i - w].second;
+            dst->row_nnz[i]  = -rows[i - w].first;
+        }
+    }
+
+    // Each chunk is padded to its longest row, which is its first slot
+    dst->chunk_offset[0] = 0;
+
+    for(IndexType c = 0; c < nchunk; ++c)
+    {
+        dst->chunk_offset[c + 1] = dst->chunk_offset[c] + dst->row_nnz[c * chunk_size] * chunk_size;
+    }
+
+    *size_sell = dst->chunk_offset[nchunk];
+
+    allocate_host(*size_sell, &dst->col);
+    allocate_host(*size_sell, &dst->val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType c = 0; c < nchunk; ++c)
+    {
+        IndexType offset = dst->chunk_offset[c];
+        IndexType width  = (dst->chunk_offset[c + 1] - offset) / chunk_size;
+
+        for(IndexType r = 0; r < chunk_size; ++r)
+        {
+            IndexType slot    = c * chunk_size + r;
+            IndexType n       = 0;
+            IndexType pad_col = 0;
+
+            if(slot < nrow)
+            {
+                IndexType row = dst->row_perm[slot];
+
+                for(IndexType j = src.row_offset[row]; j < src.row_offset[row + 1]; ++j)
+                {
+                    IndexType ind = SELL_IND(offset, r, n, chunk_size);
+
+                    dst->col[ind] = src.col[j];
+                    dst->val[ind] = src.val[j];
+                    pad_col       = src.col[j];
+                    ++n;
+                }
+            }
+
+            // Padding repeats the last column of the row with a zero value, such that
+            // the SpMV does not need to skip it
+            for(; n < width; ++n)
+            {
+                IndexType ind = SELL_IND(offset, r, n, chunk_size);
+
+                dst->col[ind] = pad_col;
+                dst->val[ind] = static_cast<ValueType>(0);
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType, typename IndexType>
+bool sell_to_csr(int omp_threads,
+                 IndexType nnz,
+                 IndexType nrow,
+                 IndexType ncol,
+                 const MatrixSELL<ValueType, IndexType>& src,
+                 MatrixCSR<ValueType, IndexType>* dst,
+                 IndexType* nnz_csr)
+{
+    assert(nnz > 0);
+    assert(nrow > 0);
+    assert(ncol > 0);
+
+    omp_set_num_threads(omp_threads);
+
+    allocate_host(nrow + 1, &dst->row_offset);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType slot = 0; slot < nrow; ++slot)
+    {
+        dst->row_offset[src.row_perm[slot]] = src.row_nnz[slot];
+    }
+
+    *nnz_csr = 0;
+    for(IndexType i = 0; i < nrow; ++i)
+    {
+        IndexType tmp      = dst->row_offset[i];
+        dst->row_offset[i] = *nnz_csr;
+        *nnz_csr += tmp;
+    }
+
+    dst->row_offset[nrow] = *nnz_csr;
+
+    assert(*nnz_csr == nnz);
+
+    allocate_host(*nnz_csr, &dst->col);
+    allocate_host(*nnz_csr, &dst->val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType slot = 0; slot < nrow; ++slot)
+    {
+        IndexType offset = src.chunk_offset[slot / src.chunk_size];
+        IndexType r      = slot % src.chunk_size;
+        IndexType ind    = dst->row_offset[src.row_perm[slot]];
+
+        for(IndexType n = 0; n < src.row_nnz[slot]; ++n)
+        {
+            IndexType aj = SELL_IND(offset, r, n, src.chunk_size);
+
+            dst->col[ind + n] = src.col[aj];
+            dst->val[ind + n] = src.val[aj];
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType, typename IndexType>
+bool csr_to_ccsr(int omp_threads,
+                 IndexType nnz,
+                 IndexType nrow,
+                 IndexType ncol,
+                 bool bfloat16,
+                 const MatrixCSR<ValueType, IndexType>& src,
+                 MatrixCCSR<ValueType, IndexType>* dst,
+                 IndexType* size_ccsr)
+{
+    assert(nnz > 0);
+    assert(nrow > 0);
+    assert(ncol > 0);
+
+    omp_set_num_threads(omp_threads);
+
+    allocate_host(nrow + 1, &dst->row_offset);
+    allocate_host(nrow, &dst->col_base);
+
+    dst->row_offset[0] = 0;
+
+    // Number of entries per row, including the fillers
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType i = 0; i < nrow; ++i)
+    {
+        IndexType row_begin = src.row_offset[i];
+        IndexType row_end   = src.row_offset[i + 1];
+
+        std::vector<IndexType> col(src.col + row_begin, src.col + row_end);
+        std::sort(col.begin(), col.end());
+
+        IndexType size = row_end - row_begin;
+
+        for(IndexType j = 1; j < row_end - row_begin; ++j)
+        {
+            size += (col[j] - col[j - 1]) / CCSR_FILLER;
+        }
+
+        dst->row_offset[i + 1] = size;
+        dst->col_base[i]       = (size > 0) ? col[0] : 0;
+    }
+
+    for(IndexType i = 0; i < nrow; ++i)
+    {
+        dst->row_offset[i + 1] += dst->row_offset[i];
+    }
+
+    *size_ccsr = dst->row_offset[nrow];
+
+    int ncomp = ccsr_components(src.val);
+
+    allocate_host(*size_ccsr, &dst->col_delta);
+
+    if(bfloat16 == true)
+    {
+        allocate_host(*size_ccsr * ncomp, &dst->val_bf16);
+    }
+    else
+    {
+        allocate_host(*size_ccsr * ncomp, &dst->val);
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType i = 0; i < nrow; ++i)
+    {
+        IndexType row_begin = src.row_offset[i];
+        IndexType row_end   = src.row_offset[i + 1];
+
+        // Entries of the row, sorted by column
+        std::vector<std::pair<IndexType, IndexType>> entries(row_end - row_begin);
+
+        for(IndexType j = row_begin; j < row_end; ++j)
+        {
+            entries[j - row_begin] = std::make_pair(src.col[j], j);
+        }
+
+        std::sort(entries.begin(), entries.end());
+
+        IndexType ind  = dst->row_offset[i];
+        IndexType prev = dst->col_base[i];
+
+        for(IndexType j = 0; j < row_end - row_begin; ++j)
+        {
+            IndexType delta = entries[j].first - prev;
+
+            // Bridge the gap by filler entries, the remaining delta is then smaller than
+            // the filler delta
+            while(delta >= CCSR_FILLER)
+            {
+                dst->col_delta[ind] = CCSR_FILLER;
+
+                if(bfloat16 == true)
+                {
+                    ccsr_encode(static_cast<ValueType>(0), ind, dst->val_bf16);
+                }
+                else
+                {
+                    ccsr_encode(static_cast<ValueType>(0), ind, dst->val);
+                }
+
+                delta -= CCSR_FILLER;
+                ++ind;
+            }
+
+            dst->col_delta[ind] = static_cast<unsigned short>(delta);
+
+            if(bfloat16 == true)
+            {
+                ccsr_encode(src.val[entries[j].second], ind, dst->val_bf16);
+            }
+            else
+            {
+                ccsr_encode(src.val[entries[j].second], ind, dst->val);
+            }
+
+            prev = entries[j].first;
+            ++ind;
+        }
+
+        assert(ind == dst->row_offset[i + 1]);
+    }
+
+    return true;
+}
+
+template <typename ValueType, typename IndexType>
+bool ccsr_to_csr(int omp_threads,
+                 IndexType nnz,
+                 IndexType nrow,
+                 IndexType ncol,
+                 const MatrixCCSR<ValueType, IndexType>& src,
+                 MatrixCSR<ValueType, IndexType>* dst,
+                 IndexType* nnz_csr)
+{
+    assert(nnz > 0);
+    assert(nrow > 0);
+    assert(ncol > 0);
+    assert((src.val != NULL) != (src.val_bf16 != NULL));
+
+    omp_set_num_threads(omp_threads);
+
+    allocate_host(nrow + 1, &dst->row_offset);
+
+    dst->row_offset[0] = 0;
+
+    // Number of entries per row, without the fillers
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType i = 0; i < nrow; ++i)
+    {
+        IndexType n = 0;
+
+        for(IndexType j = src.row_offset[i]; j < src.row_offset[i + 1]; ++j)
+        {
+            if(src.col_delta[j] != CCSR_FILLER)
+            {
+                ++n;
+            }
+        }
+
+        dst->row_offset[i + 1] = n;
+    }
+
+    for(IndexType i = 0; i < nrow; ++i)
+    {
+        dst->row_offset[i + 1] += dst->row_offset[i];
+    }
+
+    *nnz_csr = dst->row_offset[nrow];
+
+    assert(*nnz_csr == nnz);
+
+    allocate_host(*nnz_csr, &dst->col);
+    allocate_host(*nnz_csr, &dst->val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType i = 0; i < nrow; ++i)
+    {
+        IndexType ind = dst->row_offset[i];
+        IndexType col = src.col_base[i];
+
+        for(IndexType j = src.row_offset[i]; j < src.row_offset[i + 1]; ++j)
+        {
+            col += src.col_delta[j];
+
+            if(src.col_delta[j] != CCSR_FILLER)
+            {
+                dst->col[ind] = col;
+
+                if(src.val_bf16 != NULL)
+                {
+                    ccsr_decode(src.val_bf16, j, &dst->val[ind]);
+                }
+                else
+                {
+                    ccsr_decode(src.val, j, &dst->val[ind]);
+                }
+
+                ++ind;
+            }
+        }
+    }
+
+    return true;
+}
+
 template <typename ValueType, typename IndexType>
 bool hyb_to_csr(int omp_threads,
                 IndexType nnz,
@@ -1350,6 +1738,154 @@ template bool dia_to_csr(int omp_threads,
                          MatrixCSR<int, int>* dst,
                          int* nnz_csr);
 
+template bool csr_to_sell(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          int chunk_size,
+                          int sigma,
+                          const MatrixCSR<double, int>& src,
+                          MatrixSELL<double, int>* dst,
+                          int* size_sell);
+
+template bool csr_to_sell(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          int chunk_size,
+                          int sigma,
+                          const MatrixCSR<float, int>& src,
+                          MatrixSELL<float, int>* dst,
+                          int* size_sell);
+
+#ifdef SUPPORT_COMPLEX
+template bool csr_to_sell(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          int chunk_size,
+                          int sigma,
+                          const MatrixCSR<std::complex<double>, int>& src,
+                          MatrixSELL<std::complex<double>, int>* dst,
+                          int* size_sell);
+
+template bool csr_to_sell(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          int chunk_size,
+                          int sigma,
+                          const MatrixCSR<std::complex<float>, int>& src,
+                          MatrixSELL<std::complex<float>, int>* dst,
+                          int* size_sell);
+#endif
+
+template bool sell_to_csr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          const MatrixSELL<double, int>& src,
+                          MatrixCSR<double, int>* dst,
+                          int* nnz_csr);
+
+template bool sell_to_csr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          const MatrixSELL<float, int>& src,
+                          MatrixCSR<float, int>* dst,
+                          int* nnz_csr);
+
+#ifdef SUPPORT_COMPLEX
+template bool sell_to_csr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          const MatrixSELL<std::complex<double>, int>& src,
+                          MatrixCSR<std::complex<double>, int>* dst,
+                          int* nnz_csr);
+
+template bool sell_to_csr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          const MatrixSELL<std::complex<float>, int>& src,
+                          MatrixCSR<std::complex<float>, int>* dst,
+                          int* nnz_csr);
+#endif
+
+template bool csr_to_ccsr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          bool bfloat16,
+                          const MatrixCSR<double, int>& src,
+                          MatrixCCSR<double, int>* dst,
+                          int* size_ccsr);
+
+template bool csr_to_ccsr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          bool bfloat16,
+                          const MatrixCSR<float, int>& src,
+                          MatrixCCSR<float, int>* dst,
+                          int* size_ccsr);
+
+#ifdef SUPPORT_COMPLEX
+template bool csr_to_ccsr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          bool bfloat16,
+                          const MatrixCSR<std::complex<double>, int>& src,
+                          MatrixCCSR<std::complex<double>, int>* dst,
+                          int* size_ccsr);
+
+template bool csr_to_ccsr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          bool bfloat16,
+                          const MatrixCSR<std::complex<float>, int>& src,
+                          MatrixCCSR<std::complex<float>, int>* dst,
+                          int* size_ccsr);
+#endif
+
+template bool ccsr_to_csr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          const MatrixCCSR<double, int>& src,
+                          MatrixCSR<double, int>* dst,
+                          int* nnz_csr);
+
+template bool ccsr_to_csr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          const MatrixCCSR<float, int>& src,
+                          MatrixCSR<float, int>* dst,
+                          int* nnz_csr);
+
+#ifdef SUPPORT_COMPLEX
+template bool ccsr_to_csr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          const MatrixCCSR<std::complex<double>, int>& src,
+                          MatrixCSR<std::complex<double>, int>* dst,
+                          int* nnz_csr);
+
+template bool ccsr_to_csr(int omp_threads,
+                          int nnz,
+                          int nrow,
+                          int ncol,
+                          const MatrixCCSR<std::complex<float>, int>& src,
+                          MatrixCSR<std::complex<float>, int>* dst,
+                          int* nnz_csr);
+#endif
+
 template bool ell_to_csr(int omp_threads,
                          int nnz,
                          int nrow,
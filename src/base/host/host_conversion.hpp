@@ -26,6 +26,9 @@
 
 #include "../matrix_formats.hpp"
 
+#include <complex>
+#include <string.h>
+
 namespace rocalution {
 
 template <typename ValueType, typename IndexType>
@@ -98,6 +101,45 @@ bool dia_to_csr(int omp_threads,
                 MatrixCSR<ValueType, IndexType>* dst,
                 IndexType* nnz_csr);
 
+template <typename ValueType, typename IndexType>
+bool csr_to_sell(int omp_threads,
+                 IndexType nnz,
+                 IndexType nrow,
+                 IndexType ncol,
+                 IndexType chunk_size,
+                 IndexType sigma,
+                 const MatrixCSR<ValueType, IndexType>& src,
+                 MatrixSELL<ValueType, IndexType>* dst,
+                 IndexType* size_sell);
+
+template <typename ValueType, typename IndexType>
+bool sell_to_csr(int omp_threads,
+                 IndexType nnz,
+                 IndexType nrow,
+                 IndexType ncol,
+                 const MatrixSELL<ValueType, IndexType>& src,
+                 MatrixCSR<ValueType, IndexType>* dst,
+                 IndexType* nnz_csr);
+
+template <typename ValueType, typename IndexType>
+bool csr_to_ccsr(int omp_threads,
+                 IndexType nnz,
+                 IndexType nrow,
+                 IndexType ncol,
+                 bool bfloat16,
+                 const MatrixCSR<ValueType, IndexType>& src,
+                 MatrixCCSR<ValueType, IndexType>* dst,
+                 IndexType* size_ccsr);
+
+template <typename ValueType, typename IndexType>
+bool ccsr_to_csr(int omp_threads,
+                 IndexType nnz,
+                 IndexType nrow,
+                 IndexType ncol,
+                 const MatrixCCSR<ValueType, IndexType>& src,
+                 MatrixCSR<ValueType, IndexType>* dst,
+                 IndexType* nnz_csr);
+
 template <typename ValueType, typename IndexType>
 bool ell_to_csr(int omp_threads,
                 IndexType nnz,
@@ -134,6 +176,100 @@ bool hyb_to_csr(int omp_threads,
                 MatrixCSR<ValueType, IndexType>* dst,
                 IndexType* nnz_csr);
 
+// Round single precision to bfloat16 (round to nearest even)
+inline unsigned short float_to_bfloat16(float v)
+{
+    unsigned int bits;
+    memcpy(&bits, &v, sizeof(float));
+
+    // Keep NaN a (quiet) NaN
+    if((bits & 0x7fffffffu) > 0x7f800000u)
+    {
+        return static_cast<unsigned short>((bits >> 16) | 0x0040u);
+    }
+
+    bits += 0x7fffu + ((bits >> 16) & 1u);
+
+    return static_cast<unsigned short>(bits >> 16);
+}
+
+inline float bfloat16_to_float(unsigned short v)
+{
+    unsigned int bits = static_cast<unsigned int>(v) << 16;
+
+    float f;
+    memcpy(&f, &bits, sizeof(float));
+
+    return f;
+}
+
+// Number of reduced precision words per value of the CCSR formats
+template <typename ValueType>
+inline int ccsr_components(const ValueType*)
+{
+    return 1;
+}
+
+template <typename ValueType>
+inline int ccsr_components(const std::complex<ValueType>*)
+{
+    return 2;
+}
+
+// Store value j in reduced precision
+template <typename ValueType>
+inline void ccsr_encode(ValueType v, int j, float* dst)
+{
+    dst[j] = static_cast<float>(v);
+}
+
+template <typename ValueType>
+inline void ccsr_encode(std::complex<ValueType> v, int j, float* dst)
+{
+    dst[2 * j]     = static_cast<float>(v.real());
+    dst[2 * j + 1] = static_cast<float>(v.imag());
+}
+
+template <typename ValueType>
+inline void ccsr_encode(ValueType v, int j, unsigned short* dst)
+{
+    dst[j] = float_to_bfloat16(static_cast<float>(v));
+}
+
+template <typename ValueType>
+inline void ccsr_encode(std::complex<ValueType> v, int j, unsigned short* dst)
+{
+    dst[2 * j]     = float_to_bfloat16(static_cast<float>(v.real()));
+    dst[2 * j + 1] = float_to_bfloat16(static_cast<float>(v.imag()));
+}
+
+// Load value j in working precision
+template <typename ValueType>
+inline void ccsr_decode(const float* src, int j, ValueType* v)
+{
+    *v = static_cast<ValueType>(src[j]);
+}
+
+template <typename ValueType>
+inline void ccsr_decode(const float* src, int j, std::complex<ValueType>* v)
+{
+    *v = std::complex<ValueType>(static_cast<ValueType>(src[2 * j]),
+                                 static_cast<ValueType>(src[2 * j + 1]));
+}
+
+template <typename ValueType>
+inline void ccsr_decode(const unsigned short* src, int j, ValueType* v)
+{
+    *v = static_cast<ValueType>(bfloat16_to_float(src[j]));
+}
+
+template <typename ValueType>
+inline void ccsr_decode(const unsigned short* src, int j, std::complex<ValueType>* v)
+{
+    *v = std::complex<ValueType>(static_cast<ValueType>(bfloat16_to_float(src[2 * j])),
+                                 static_cast<ValueType>(bfloat16_to_float(src[2 * j + 1])));
+}
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HOST_CONVERSION_HPP_
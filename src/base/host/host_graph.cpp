@@ -0,0 +1,955 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../../utils/def.hpp"
+#include "host_graph.hpp"
+#include "../../utils/log.hpp"
+
+#include <algorithm>
+#include <assert.h>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace rocalution {
+
+// Graphs with fewer nodes are not coarsened any further
+#define GRAPH_COARSEST_SIZE 100
+// Coarsening stops, if the graph does not shrink below this ratio
+#define GRAPH_COARSEN_RATIO 0.9
+// Allowed imbalance of each bisection
+#define GRAPH_IMBALANCE 0.03
+// Number of initial bisections, that are grown from different nodes
+#define GRAPH_INITIAL_TRIALS 4
+// Maximum number of refinement passes per level
+#define GRAPH_FM_PASSES 8
+// Subgraphs with fewer nodes are not dissected any further
+#define GRAPH_ND_LEAF_SIZE 64
+
+// Weighted graph, used by the multilevel algorithms
+struct WeightedGraph
+{
+    int n;
+    std::vector<int> xadj;
+    std::vector<int> adj;
+    std::vector<int> ewgt;
+    std::vector<int> vwgt;
+};
+
+void graph_symmetrize(int n,
+                      const int* row_offset,
+                      const int* col,
+                      std::vector<int>& xadj,
+                      std::vector<int>& adj)
+{
+    // Count each off-diagonal entry for its row and for its column, duplicates that
+    // appear in both triangles are removed afterwards
+    std::vector<int> cnt(n + 1, 0);
+
+    for(int i = 0; i < n; ++i)
+    {
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            if(col[j] != i)
+            {
+                ++cnt[i + 1];
+                ++cnt[col[j] + 1];
+            }
+        }
+    }
+
+    for(int i = 0; i < n; ++i)
+    {
+        cnt[i + 1] += cnt[i];
+    }
+
+    std::vector<int> tmp(cnt[n]);
+
+    for(int i = 0; i < n; ++i)
+    {
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            int c = col[j];
+
+            if(c != i)
+            {
+                tmp[cnt[i]++] = c;
+                tmp[cnt[c]++] = i;
+            }
+        }
+    }
+
+    // cnt[i] now points to the end of row i
+    xadj.resize(n + 1);
+    adj.clear();
+    adj.reserve(tmp.size());
+
+    std::vector<int> marker(n, -1);
+
+    xadj[0] = 0;
+
+    for(int i = 0; i < n; ++i)
+    {
+        int begin = (i == 0) ? 0 : cnt[i - 1];
+
+        for(int j = begin; j < cnt[i]; ++j)
+        {
+            if(marker[tmp[j]] != i)
+            {
+                marker[tmp[j]] = i;
+                adj.push_back(tmp[j]);
+            }
+        }
+
+        std::sort(adj.begin() + xadj[i], adj.end());
+
+        xadj[i + 1] = static_cast<int>(adj.size());
+    }
+}
+
+// Breadth first search from root, that stores the level of each reached node and
+// returns the reached nodes in BFS order
+static int graph_bfs(const int* xadj,
+                     const int* adj,
+                     int root,
+                     std::vector<int>& level,
+                     std::vector<int>& queue)
+{
+    queue.clear();
+    queue.push_back(root);
+    level[root] = 0;
+
+    int depth = 0;
+
+    for(size_t h = 0; h < queue.size(); ++h)
+    {
+        int v = queue[h];
+
+        depth = level[v];
+
+        for(int j = xadj[v]; j < xadj[v + 1]; ++j)
+        {
+            if(level[adj[j]] == -1)
+            {
+                level[adj[j]] = level[v] + 1;
+                queue.push_back(adj[j]);
+            }
+        }
+    }
+
+    return depth;
+}
+
+int graph_pseudo_peripheral_node(
+    int n, const int* xadj, const int* adj, int root, std::vector<int>& level)
+{
+    assert(root >= 0 && root < n);
+    assert(static_cast<int>(level.size()) == n);
+
+    std::vector<int> queue;
+
+    int depth = graph_bfs(xadj, adj, root, level, queue);
+
+    while(true)
+    {
+        // Node of minimum degree in the last level
+        int cand = -1;
+
+        for(int h = static_cast<int>(queue.size()) - 1; h >= 0 && level[queue[h]] == depth; --h)
+        {
+            int v = queue[h];
+
+            int deg      = xadj[v + 1] - xadj[v];
+            int cand_deg = (cand == -1) ? 0 : xadj[cand + 1] - xadj[cand];
+
+            if(cand == -1 || deg < cand_deg || (deg == cand_deg && v < cand))
+            {
+                cand = v;
+            }
+        }
+
+        for(size_t h = 0; h < queue.size(); ++h)
+        {
+            level[queue[h]] = -1;
+        }
+
+        int cand_depth = graph_bfs(xadj, adj, cand, level, queue);
+
+        if(cand_depth <= depth)
+        {
+            break;
+        }
+
+        root  = cand;
+        depth = cand_depth;
+    }
+
+    for(size_t h = 0; h < queue.size(); ++h)
+    {
+        level[queue[h]] = -1;
+    }
+
+    return root;
+}
+
+// Coarsen g by heavy-edge matching, cmap holds the coarse node of each node of g
+static void graph_coarsen(const WeightedGraph& g, WeightedGraph& c, std::vector<int>& cmap)
+{
+    // Visit the nodes in order of increasing degree, such that nodes with few
+    // neighbours are matched first
+    int max_deg = 0;
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        max_deg = std::max(max_deg, g.xadj[v + 1] - g.xadj[v]);
+    }
+
+    std::vector<int> bucket(max_deg + 2, 0);
+    std::vector<int> order(g.n);
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        ++bucket[g.xadj[v + 1] - g.xadj[v] + 1];
+    }
+
+    for(int d = 0; d <= max_deg; ++d)
+    {
+        bucket[d + 1] += bucket[d];
+    }
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        order[bucket[g.xadj[v + 1] - g.xadj[v]]++] = v;
+    }
+
+    std::vector<int> match(g.n, -1);
+
+    cmap.resize(g.n);
+    c.n = 0;
+
+    for(int k = 0; k < g.n; ++k)
+    {
+        int v = order[k];
+
+        if(match[v] != -1)
+        {
+            continue;
+        }
+
+        // Unmatched neighbour with the heaviest edge
+        int best   = -1;
+        int best_w = 0;
+
+        for(int j = g.xadj[v]; j < g.xadj[v + 1]; ++j)
+        {
+            int u = g.adj[j];
+
+            if(match[u] == -1 && u != v && g.ewgt[j] > best_w)
+            {
+                best   = u;
+                best_w = g.ewgt[j];
+            }
+        }
+
+        match[v] = (best == -1) ? v : best;
+        cmap[v]  = c.n;
+
+        if(best != -1)
+        {
+            match[best] = v;
+            cmap[best]  = c.n;
+        }
+
+        ++c.n;
+    }
+
+    // Fine nodes of each coarse node
+    std::vector<int> first(c.n, -1);
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        if(first[cmap[v]] == -1)
+        {
+            first[cmap[v]] = v;
+        }
+    }
+
+    c.xadj.resize(c.n + 1);
+    c.vwgt.resize(c.n);
+    c.adj.clear();
+    c.ewgt.clear();
+
+    std::vector<int> pos(c.n, -1);
+
+    c.xadj[0] = 0;
+
+    for(int cv = 0; cv < c.n; ++cv)
+    {
+        int v0 = first[cv];
+        int v1 = match[v0];
+
+        c.vwgt[cv] = g.vwgt[v0] + ((v1 != v0) ? g.vwgt[v1] : 0);
+
+        for(int m = 0; m < 2; ++m)
+        {
+            int v = (m == 0) ? v0 : v1;
+
+            if(m == 1 && v1 == v0)
+            {
+                break;
+            }
+
+            for(int j = g.xadj[v]; j < g.xadj[v + 1]; ++j)
+            {
+                int cu = cmap[g.adj[j]];
+
+                if(cu == cv)
+                {
+                    continue;
+                }
+
+                if(pos[cu] == -1)
+                {
+                    pos[cu] = static_cast<int>(c.adj.size());
+                    c.adj.push_back(cu);
+                    c.ewgt.push_back(g.ewgt[j]);
+                }
+                else
+                {
+                    c.ewgt[pos[cu]] += g.ewgt[j];
+                }
+            }
+        }
+
+        c.xadj[cv + 1] = static_cast<int>(c.adj.size());
+
+        for(int j = c.xadj[cv]; j < c.xadj[cv + 1]; ++j)
+        {
+            pos[c.adj[j]] = -1;
+        }
+    }
+}
+
+// Weight of the edges between both parts
+static int graph_cut(const WeightedGraph& g, const std::vector<int>& where)
+{
+    int cut = 0;
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        for(int j = g.xadj[v]; j < g.xadj[v + 1]; ++j)
+        {
+            if(where[g.adj[j]] != where[v])
+            {
+                cut += g.ewgt[j];
+            }
+        }
+    }
+
+    return cut / 2;
+}
+
+// Fiduccia-Mattheyses refinement of a bisection with target weight tw0 of part 0.
+// Each pass moves boundary nodes with the highest gain and keeps the best prefix of
+// the moves, where balanced bisections are preferred over smaller cuts.
+static void graph_fm_refine(const WeightedGraph& g, std::vector<int>& where, long tw0)
+{
+    long total = 0;
+    int max_vwgt = 0;
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        total += g.vwgt[v];
+        max_vwgt = std::max(max_vwgt, g.vwgt[v]);
+    }
+
+    long tw[2]   = {tw0, total - tw0};
+    long maxw[2] = {static_cast<long>(tw[0] * (1.0 + GRAPH_IMBALANCE)) + max_vwgt,
+                    static_cast<long>(tw[1] * (1.0 + GRAPH_IMBALANCE)) + max_vwgt};
+
+    std::vector<int> id(g.n);
+    std::vector<int> ed(g.n);
+    std::vector<bool> locked(g.n);
+    std::vector<int> moves;
+
+    for(int pass = 0; pass < GRAPH_FM_PASSES; ++pass)
+    {
+        long pw[2] = {0, 0};
+        int cut    = 0;
+
+        for(int v = 0; v < g.n; ++v)
+        {
+            pw[where[v]] += g.vwgt[v];
+
+            id[v] = 0;
+            ed[v] = 0;
+
+            for(int j = g.xadj[v]; j < g.xadj[v + 1]; ++j)
+            {
+                if(where[g.adj[j]] == where[v])
+                {
+                    id[v] += g.ewgt[j];
+                }
+                else
+                {
+                    ed[v] += g.ewgt[j];
+                }
+            }
+
+            cut += ed[v];
+            locked[v] = false;
+        }
+
+        cut /= 2;
+
+        // Max-heaps of the gains of the boundary nodes of each part, outdated entries
+        // are skipped
+        std::priority_queue<std::pair<int, int>> heap[2];
+
+        for(int v = 0; v < g.n; ++v)
+        {
+            if(ed[v] > 0)
+            {
+                heap[where[v]].push(std::make_pair(ed[v] - id[v], v));
+            }
+        }
+
+        long imbalance = std::max(std::max(pw[0] - maxw[0], pw[1] - maxw[1]), 0L);
+
+        long best_imbalance = imbalance;
+        int best_cut        = cut;
+        size_t best_moves   = 0;
+
+        int limit = std::max(50, g.n / 100);
+
+        moves.clear();
+
+        while(true)
+        {
+            // Top of both heaps
+            int cand[2] = {-1, -1};
+
+            for(int p = 0; p < 2; ++p)
+            {
+                while(!heap[p].empty())
+                {
+                    int gain = heap[p].top().first;
+                    int v    = heap[p].top().second;
+
+                    if(locked[v] == true || where[v] != p || gain != ed[v] - id[v])
+                    {
+                        heap[p].pop();
+                        continue;
+                    }
+
+                    // Move has to keep the target part within its limit, unless the
+                    // source part is overweight
+                    if(pw[1 - p] + g.vwgt[v] > maxw[1 - p] && pw[p] <= maxw[p])
+                    {
+                        break;
+                    }
+
+                    cand[p] = v;
+                    break;
+                }
+            }
+
+            int from;
+
+            if(cand[0] == -1 && cand[1] == -1)
+            {
+                break;
+            }
+            else if(cand[0] == -1 || cand[1] == -1)
+            {
+                from = (cand[0] == -1) ? 1 : 0;
+            }
+            else if(pw[0] > maxw[0] || pw[1] > maxw[1])
+            {
+                from = (pw[0] - tw[0] > pw[1] - tw[1]) ? 0 : 1;
+            }
+            else
+            {
+                int g0 = ed[cand[0]] - id[cand[0]];
+                int g1 = ed[cand[1]] - id[cand[1]];
+
+                from = (g0 > g1 || (g0 == g1 && pw[0] - tw[0] >= pw[1] - tw[1])) ? 0 : 1;
+            }
+
+            int v  = cand[from];
+            int to = 1 - from;
+
+            heap[from].pop();
+
+            // Move v
+            cut -= ed[v] - id[v];
+            pw[from] -= g.vwgt[v];
+            pw[to] += g.vwgt[v];
+
+            where[v]  = to;
+            locked[v] = true;
+            std::swap(id[v], ed[v]);
+
+            moves.push_back(v);
+
+            for(int j = g.xadj[v]; j < g.xadj[v + 1]; ++j)
+            {
+                int u = g.adj[j];
+
+                if(where[u] == to)
+                {
+                    id[u] += g.ewgt[j];
+                    ed[u] -= g.ewgt[j];
+                }
+                else
+                {
+                    id[u] -= g.ewgt[j];
+                    ed[u] += g.ewgt[j];
+                }
+
+                if(locked[u] == false && ed[u] > 0)
+                {
+                    heap[where[u]].push(std::make_pair(ed[u] - id[u], u));
+                }
+            }
+
+            imbalance = std::max(std::max(pw[0] - maxw[0], pw[1] - maxw[1]), 0L);
+
+            if(imbalance < best_imbalance || (imbalance == best_imbalance && cut < best_cut))
+            {
+                best_imbalance = imbalance;
+                best_cut       = cut;
+                best_moves     = moves.size();
+            }
+            else if(moves.size() - best_moves > static_cast<size_t>(limit))
+            {
+                break;
+            }
+        }
+
+        // Undo all moves after the best state
+        for(size_t k = moves.size(); k > best_moves; --k)
+        {
+            where[moves[k - 1]] = 1 - where[moves[k - 1]];
+        }
+
+        if(best_moves == 0)
+        {
+            break;
+        }
+    }
+}
+
+// Grow part 0 from start until its weight reaches tw0, by adding the node that
+// increases the cut the least
+static void graph_grow(const WeightedGraph& g, int start, long tw0, std::vector<int>& where)
+{
+    where.assign(g.n, 1);
+
+    std::vector<int> gain(g.n, 0);
+    std::priority_queue<std::pair<int, int>> heap;
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        for(int j = g.xadj[v]; j < g.xadj[v + 1]; ++j)
+        {
+            gain[v] -= g.ewgt[j];
+        }
+    }
+
+    long w0  = 0;
+    int next = 0;
+
+    heap.push(std::make_pair(gain[start], start));
+
+    while(w0 < tw0)
+    {
+        int v = -1;
+
+        while(!heap.empty())
+        {
+            int gv = heap.top().first;
+            v      = heap.top().second;
+
+            heap.pop();
+
+            if(where[v] == 1 && gv == gain[v])
+            {
+                break;
+            }
+
+            v = -1;
+        }
+
+        // Disconnected graph, continue with any remaining node
+        if(v == -1)
+        {
+            while(next < g.n && where[next] == 0)
+            {
+                ++next;
+            }
+
+            if(next == g.n)
+            {
+                break;
+            }
+
+            v = next;
+        }
+
+        where[v] = 0;
+        w0 += g.vwgt[v];
+
+        for(int j = g.xadj[v]; j < g.xadj[v + 1]; ++j)
+        {
+            int u = g.adj[j];
+
+            if(where[u] == 1)
+            {
+                gain[u] += 2 * g.ewgt[j];
+                heap.push(std::make_pair(gain[u], u));
+            }
+        }
+    }
+}
+
+// Bisection of the coarsest graph, best of several grown and refined bisections
+static void graph_initial_bisection(const WeightedGraph& g, long tw0, std::vector<int>& where)
+{
+    int trials = std::min(g.n, GRAPH_INITIAL_TRIALS);
+    int best   = -1;
+
+    std::vector<int> level(g.n, -1);
+    std::vector<int> trial;
+
+    for(int t = 0; t < trials; ++t)
+    {
+        // Spread the start nodes over the graph, the first one is pseudo-peripheral
+        int start = static_cast<int>(static_cast<long>(g.n) * t / trials);
+
+        if(t == 0)
+        {
+            start = graph_pseudo_peripheral_node(g.n, g.xadj.data(), g.adj.data(), start, level);
+        }
+
+        graph_grow(g, start, tw0, trial);
+        graph_fm_refine(g, trial, tw0);
+
+        int cut = graph_cut(g, trial);
+
+        if(best == -1 || cut < best)
+        {
+            best = cut;
+            where.swap(trial);
+        }
+    }
+}
+
+// Multilevel bisection of g, where part 0 gets the fraction frac of the total weight
+static void graph_bisect(const WeightedGraph& g, double frac, std::vector<int>& where)
+{
+    if(g.n == 0)
+    {
+        where.clear();
+        return;
+    }
+
+    // Coarsening phase
+    std::vector<WeightedGraph> coarse;
+    std::vector<std::vector<int>> cmap;
+
+    const WeightedGraph* cur = &g;
+
+    while(cur->n > GRAPH_COARSEST_SIZE)
+    {
+        WeightedGraph c;
+        std::vector<int> map;
+
+        graph_coarsen(*cur, c, map);
+
+        if(c.n > GRAPH_COARSEN_RATIO * cur->n)
+        {
+            break;
+        }
+
+        coarse.push_back(WeightedGraph());
+        coarse.back().n = c.n;
+        coarse.back().xadj.swap(c.xadj);
+        coarse.back().adj.swap(c.adj);
+        coarse.back().ewgt.swap(c.ewgt);
+        coarse.back().vwgt.swap(c.vwgt);
+        cmap.push_back(std::vector<int>());
+        cmap.back().swap(map);
+
+        cur = &coarse.back();
+    }
+
+    long total = 0;
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        total += g.vwgt[v];
+    }
+
+    long tw0 = static_cast<long>(frac * total + 0.5);
+
+    // Initial bisection of the coarsest graph
+    graph_initial_bisection(*cur, tw0, where);
+
+    // Uncoarsening phase, project and refine
+    for(int l = static_cast<int>(coarse.size()) - 1; l >= 0; --l)
+    {
+        const WeightedGraph& fine = (l == 0) ? g : coarse[l - 1];
+
+        std::vector<int> fine_where(fine.n);
+
+        for(int v = 0; v < fine.n; ++v)
+        {
+            fine_where[v] = where[cmap[l][v]];
+        }
+
+        where.swap(fine_where);
+
+        graph_fm_refine(fine, where, tw0);
+    }
+}
+
+// Subgraph of g induced by the nodes with where[v] == p, ids maps the subgraph nodes
+// to the nodes of g
+static void graph_subgraph(const WeightedGraph& g,
+                           const std::vector<int>& where,
+                           int p,
+                           WeightedGraph& s,
+                           std::vector<int>& ids)
+{
+    std::vector<int> map(g.n, -1);
+
+    ids.clear();
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        if(where[v] == p)
+        {
+            map[v] = static_cast<int>(ids.size());
+            ids.push_back(v);
+        }
+    }
+
+    s.n = static_cast<int>(ids.size());
+    s.xadj.resize(s.n + 1);
+    s.vwgt.resize(s.n);
+    s.adj.clear();
+    s.ewgt.clear();
+
+    s.xadj[0] = 0;
+
+    for(int k = 0; k < s.n; ++k)
+    {
+        int v = ids[k];
+
+        s.vwgt[k] = g.vwgt[v];
+
+        for(int j = g.xadj[v]; j < g.xadj[v + 1]; ++j)
+        {
+            if(map[g.adj[j]] != -1)
+            {
+                s.adj.push_back(map[g.adj[j]]);
+                s.ewgt.push_back(g.ewgt[j]);
+            }
+        }
+
+        s.xadj[k + 1] = static_cast<int>(s.adj.size());
+    }
+}
+
+// Unit weighted graph of the adjacency structure
+static void graph_unit_weights(int n, const int* xadj, const int* adj, WeightedGraph& g)
+{
+    g.n = n;
+    g.xadj.assign(xadj, xadj + n + 1);
+    g.adj.assign(adj, adj + xadj[n]);
+    g.ewgt.assign(xadj[n], 1);
+    g.vwgt.assign(n, 1);
+}
+
+static void graph_recursive_bisection(
+    const WeightedGraph& g, const std::vector<int>& ids, int nparts, int offset, int* part)
+{
+    if(nparts == 1 || g.n <= 1)
+    {
+        for(int v = 0; v < g.n; ++v)
+        {
+            part[ids[v]] = offset;
+        }
+
+        return;
+    }
+
+    int nparts0 = nparts / 2;
+
+    std::vector<int> where;
+    graph_bisect(g, static_cast<double>(nparts0) / nparts, where);
+
+    for(int p = 0; p < 2; ++p)
+    {
+        WeightedGraph s;
+        std::vector<int> sids;
+
+        graph_subgraph(g, where, p, s, sids);
+
+        for(int k = 0; k < s.n; ++k)
+        {
+            sids[k] = ids[sids[k]];
+        }
+
+        if(p == 0)
+        {
+            graph_recursive_bisection(s, sids, nparts0, offset, part);
+        }
+        else
+        {
+            graph_recursive_bisection(s, sids, nparts - nparts0, offset + nparts0, part);
+        }
+    }
+}
+
+void graph_partition(int n, const int* xadj, const int* adj, int nparts, int* part)
+{
+    assert(nparts > 0);
+
+    WeightedGraph g;
+    graph_unit_weights(n, xadj, adj, g);
+
+    std::vector<int> ids(n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        ids[i] = i;
+    }
+
+    graph_recursive_bisection(g, ids, nparts, 0, part);
+}
+
+static void
+    graph_dissect(const WeightedGraph& g, const std::vector<int>& ids, int first, int* perm)
+{
+    std::vector<int> where;
+
+    if(g.n > GRAPH_ND_LEAF_SIZE)
+    {
+        graph_bisect(g, 0.5, where);
+
+        // Vertex separator from the edge separator, the boundary nodes of the part with
+        // fewer boundary nodes
+        int nbnd[2] = {0, 0};
+
+        std::vector<bool> bnd(g.n, false);
+
+        for(int v = 0; v < g.n; ++v)
+        {
+            for(int j = g.xadj[v]; j < g.xadj[v + 1]; ++j)
+            {
+                if(where[g.adj[j]] != where[v])
+                {
+                    bnd[v] = true;
+                    ++nbnd[where[v]];
+                    break;
+                }
+            }
+        }
+
+        int sep = (nbnd[0] <= nbnd[1]) ? 0 : 1;
+
+        int size[3] = {0, 0, 0};
+
+        for(int v = 0; v < g.n; ++v)
+        {
+            if(bnd[v] == true && where[v] == sep)
+            {
+                where[v] = 2;
+            }
+
+            ++size[where[v]];
+        }
+
+        // Dissection did not reduce the graph
+        if(size[0] == g.n || size[1] == g.n)
+        {
+            where.clear();
+        }
+    }
+
+    // Leaves are numbered in their given order
+    if(where.empty())
+    {
+        for(int v = 0; v < g.n; ++v)
+        {
+            perm[ids[v]] = first + v;
+        }
+
+        return;
+    }
+
+    // Both parts first, followed by the separator
+    for(int p = 0; p < 2; ++p)
+    {
+        WeightedGraph s;
+        std::vector<int> sids;
+
+        graph_subgraph(g, where, p, s, sids);
+
+        for(int k = 0; k < s.n; ++k)
+        {
+            sids[k] = ids[sids[k]];
+        }
+
+        graph_dissect(s, sids, first, perm);
+
+        first += s.n;
+    }
+
+    for(int v = 0; v < g.n; ++v)
+    {
+        if(where[v] == 2)
+        {
+            perm[ids[v]] = first++;
+        }
+    }
+}
+
+void graph_nested_dissection(int n, const int* xadj, const int* adj, int* perm)
+{
+    WeightedGraph g;
+    graph_unit_weights(n, xadj, adj, g);
+
+    std::vector<int> ids(n);
+
+    for(int i = 0; i < n; ++i)
+    {
+        ids[i] = i;
+    }
+
+    graph_dissect(g, ids, 0, perm);
+}
+
+} // namespace rocalution
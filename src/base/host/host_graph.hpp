@@ -0,0 +1,55 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_HOST_GRAPH_HPP_
+#define ROCALUTION_HOST_GRAPH_HPP_
+
+#include <vector>
+
+namespace rocalution {
+
+// Adjacency structure of the symmetrized sparsity pattern of a square CSR matrix,
+// without diagonal entries
+void graph_symmetrize(int n,
+                      const int* row_offset,
+                      const int* col,
+                      std::vector<int>& xadj,
+                      std::vector<int>& adj);
+
+// George-Liu pseudo-peripheral node of the connected component that contains root.
+// level has to be of size n and initialized with -1, it is restored on return.
+int graph_pseudo_peripheral_node(
+    int n, const int* xadj, const int* adj, int root, std::vector<int>& level);
+
+// Multilevel k-way partitioning by recursive bisection (heavy-edge matching coarsening,
+// greedy graph growing and Fiduccia-Mattheyses refinement). part[i] is the part of
+// node i, all parts are of balanced size.
+void graph_partition(int n, const int* xadj, const int* adj, int nparts, int* part);
+
+// Nested dissection ordering based on the multilevel bisection, perm[i] is the new
+// index of node i. Separators are ordered after the two parts they separate.
+void graph_nested_dissection(int n, const int* xadj, const int* adj, int* perm);
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HOST_GRAPH_HPP_
@@ -0,0 +1,383 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "../../utils/def.hpp"
+#include "host_matrix_ccsr.hpp"
+#include "host_matrix_csr.hpp"
+#include "host_conversion.hpp"
+#include "host_vector.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/allocate_free.hpp"
+
+#include <complex>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#endif
+
+namespace rocalution {
+
+// out = scalar * A * in (add == false) or out = out + scalar * A * in (add == true), the
+// values are loaded in reduced precision and the products are accumulated in ValueType
+template <typename ValueType, typename StorageType>
+static void ccsr_spmv(int nrow,
+                      const MatrixCCSR<ValueType, int>& mat,
+                      const StorageType* val,
+                      const ValueType* in,
+                      ValueType scalar,
+                      bool add,
+                      ValueType* out)
+{
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        int col       = mat.col_base[i];
+        ValueType sum = static_cast<ValueType>(0);
+
+        for(int j = mat.row_offset[i]; j < mat.row_offset[i + 1]; ++j)
+        {
+            ValueType v;
+            ccsr_decode(val, j, &v);
+
+            // Filler entries have zero value
+            col += mat.col_delta[j];
+            sum += v * in[col];
+        }
+
+        if(add == true)
+        {
+            out[i] += scalar * sum;
+        }
+        else
+        {
+            out[i] = sum;
+        }
+    }
+}
+
+template <typename ValueType>
+HostMatrixCCSR<ValueType>::HostMatrixCCSR()
+{
+    // no default constructors
+    LOG_INFO("no default constructor");
+    FATAL_ERROR(__FILE__, __LINE__);
+}
+
+template <typename ValueType>
+HostMatrixCCSR<ValueType>::HostMatrixCCSR(const Rocalution_Backend_Descriptor local_backend,
+                                          bool bfloat16)
+{
+    log_debug(this, "HostMatrixCCSR::HostMatrixCCSR()", "constructor with local_backend");
+
+    this->mat_.row_offset = NULL;
+    this->mat_.col_base   = NULL;
+    this->mat_.col_delta  = NULL;
+    this->mat_.val        = NULL;
+    this->mat_.val_bf16   = NULL;
+
+    this->bfloat16_ = bfloat16;
+    this->size_     = 0;
+
+    this->set_backend(local_backend);
+}
+
+template <typename ValueType>
+HostMatrixCCSR<ValueType>::~HostMatrixCCSR()
+{
+    log_debug(this, "HostMatrixCCSR::~HostMatrixCCSR()", "destructor");
+
+    this->Clear();
+}
+
+template <typename ValueType>
+void HostMatrixCCSR<ValueType>::Info(void) const
+{
+    LOG_INFO("HostMatrixCCSR<ValueType>, values="
+             << (this->bfloat16_ ? "bfloat16" : "float") << " size=" << this->size_);
+}
+
+template <typename ValueType>
+void HostMatrixCCSR<ValueType>::Clear()
+{
+    if(this->nnz_ > 0)
+    {
+        free_host(&this->mat_.row_offset);
+        free_host(&this->mat_.col_base);
+        free_host(&this->mat_.col_delta);
+
+        if(this->bfloat16_ == true)
+        {
+            free_host(&this->mat_.val_bf16);
+        }
+        else
+        {
+            free_host(&this->mat_.val);
+        }
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+        this->nnz_  = 0;
+        this->size_ = 0;
+    }
+}
+
+template <typename ValueType>
+void HostMatrixCCSR<ValueType>::CopyFrom(const BaseMatrix<ValueType>& mat)
+{
+    // copy only in the same format
+    assert(this->GetMatFormat() == mat.GetMatFormat());
+
+    if(const HostMatrixCCSR<ValueType>* cast_mat =
+           dynamic_cast<const HostMatrixCCSR<ValueType>*>(&mat))
+    {
+        this->Clear();
+
+        if(cast_mat->nnz_ > 0)
+        {
+            int nrow = cast_mat->nrow_;
+            int size = cast_mat->size_;
+            int nval = size * ccsr_components(static_cast<const ValueType*>(NULL));
+
+            allocate_host(nrow + 1, &this->mat_.row_offset);
+            allocate_host(nrow, &this->mat_.col_base);
+            allocate_host(size, &this->mat_.col_delta);
+
+            if(this->bfloat16_ == true)
+            {
+                allocate_host(nval, &this->mat_.val_bf16);
+            }
+            else
+            {
+                allocate_host(nval, &this->mat_.val);
+            }
+
+            this->nrow_ = nrow;
+            this->ncol_ = cast_mat->ncol_;
+            this->nnz_  = cast_mat->nnz_;
+            this->size_ = size;
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < nrow + 1; ++i)
+            {
+                this->mat_.row_offset[i] = cast_mat->mat_.row_offset[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < nrow; ++i)
+            {
+                this->mat_.col_base[i] = cast_mat->mat_.col_base[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < size; ++i)
+            {
+                this->mat_.col_delta[i] = cast_mat->mat_.col_delta[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < nval; ++i)
+            {
+                if(this->bfloat16_ == true)
+                {
+                    this->mat_.val_bf16[i] = cast_mat->mat_.val_bf16[i];
+                }
+                else
+                {
+                    this->mat_.val[i] = cast_mat->mat_.val[i];
+                }
+            }
+        }
+    }
+    else
+    {
+        // Host matrix knows only host matrices
+        // -> dispatching
+        mat.CopyTo(this);
+    }
+}
+
+template <typename ValueType>
+void HostMatrixCCSR<ValueType>::CopyTo(BaseMatrix<ValueType>* mat) const
+{
+    mat->CopyFrom(*this);
+}
+
+template <typename ValueType>
+bool HostMatrixCCSR<ValueType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
+{
+    this->Clear();
+
+    // empty matrix is empty matrix
+    if(mat.GetNnz() == 0)
+    {
+        return true;
+    }
+
+    if(const HostMatrixCCSR<ValueType>* cast_mat =
+           dynamic_cast<const HostMatrixCCSR<ValueType>*>(&mat))
+    {
+        // Values cannot be converted between the reduced precisions
+        if(cast_mat->bfloat16_ != this->bfloat16_)
+        {
+            return false;
+        }
+
+        this->CopyFrom(*cast_mat);
+        return true;
+    }
+
+    if(const HostMatrixCSR<ValueType>* cast_mat =
+           dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat))
+    {
+        this->Clear();
+        int size = 0;
+
+        if(csr_to_ccsr(this->local_backend_.OpenMP_threads,
+                       cast_mat->nnz_,
+                       cast_mat->nrow_,
+                       cast_mat->ncol_,
+                       this->bfloat16_,
+                       cast_mat->mat_,
+                       &this->mat_,
+                       &size) == true)
+        {
+            this->nrow_ = cast_mat->nrow_;
+            this->ncol_ = cast_mat->ncol_;
+            this->nnz_  = cast_mat->nnz_;
+            this->size_ = size;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename ValueType>
+void HostMatrixCCSR<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                      BaseVector<ValueType>* out) const
+{
+    if(this->nnz_ > 0)
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        if(this->bfloat16_ == true)
+        {
+            ccsr_spmv(this->nrow_,
+                      this->mat_,
+                      this->mat_.val_bf16,
+                      cast_in->vec_,
+                      static_cast<ValueType>(1),
+                      false,
+                      cast_out->vec_);
+        }
+        else
+        {
+            ccsr_spmv(this->nrow_,
+                      this->mat_,
+                      this->mat_.val,
+                      cast_in->vec_,
+                      static_cast<ValueType>(1),
+                      false,
+                      cast_out->vec_);
+        }
+    }
+}
+
+template <typename ValueType>
+void HostMatrixCCSR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                         ValueType scalar,
+                                         BaseVector<ValueType>* out) const
+{
+    if(this->nnz_ > 0)
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        if(this->bfloat16_ == true)
+        {
+            ccsr_spmv(this->nrow_,
+                      this->mat_,
+                      this->mat_.val_bf16,
+                      cast_in->vec_,
+                      scalar,
+                      true,
+                      cast_out->vec_);
+        }
+        else
+        {
+            ccsr_spmv(this->nrow_,
+                      this->mat_,
+                      this->mat_.val,
+                      cast_in->vec_,
+                      scalar,
+                      true,
+                      cast_out->vec_);
+        }
+    }
+}
+
+template class HostMatrixCCSR<double>;
+template class HostMatrixCCSR<float>;
+#ifdef SUPPORT_COMPLEX
+template class HostMatrixCCSR<std::complex<double>>;
+template class HostMatrixCCSR<std::complex<float>>;
+#endif
+
+} // namespace rocalution
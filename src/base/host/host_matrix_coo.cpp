@@ -39,6 +39,7 @@
 #include <stdio.h>
 #include <algorithm>
 #include <complex>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -408,10 +409,11 @@ void HostMatrixCOO<ValueType>::Apply(const BaseVector<ValueType>& in,
         cast_out->vec_[i] = static_cast<ValueType>(0);
     }
 
-    for(int i = 0; i < this->nnz_; ++i)
-    {
-        cast_out->vec_[this->mat_.row[i]] += this->mat_.val[i] * cast_in->vec_[this->mat_.col[i]];
-    }
+    host_coo_spmv(this->nnz_,
+                  this->mat_,
+                  cast_in->vec_,
+                  static_cast<ValueType>(1),
+                  cast_out->vec_);
 }
 
 template <typename ValueType>
@@ -432,11 +434,9 @@ void HostMatrixCOO<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
         assert(cast_in != NULL);
         assert(cast_out != NULL);
 
-        for(int i = 0; i < this->nnz_; ++i)
-        {
-            cast_out->vec_[this->mat_.row[i]] +=
-                scalar * this->mat_.val[i] * cast_in->vec_[this->mat_.col[i]];
-        }
+        _set_omp_backend_threads(this->local_backend_, this->nnz_);
+
+        host_coo_spmv(this->nnz_, this->mat_, cast_in->vec_, scalar, cast_out->vec_);
     }
 }
 
@@ -671,6 +671,144 @@ bool HostMatrixCOO<ValueType>::AddScalarOffDiagonal(ValueType alpha)
     return true;
 }
 
+template <typename ValueType>
+void host_coo_spmv(int nnz,
+                   const MatrixCOO<ValueType, int>& mat,
+                   const ValueType* in,
+                   ValueType scalar,
+                   ValueType* out)
+{
+    if(nnz == 0)
+    {
+        return;
+    }
+
+    // The segmented reduction requires the non-zeros to be sorted by rows
+    int unsorted = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : unsorted)
+#endif
+    for(int i = 1; i < nnz; ++i)
+    {
+        if(mat.row[i] < mat.row[i - 1])
+        {
+            ++unsorted;
+        }
+    }
+
+    if(unsorted > 0)
+    {
+        for(int i = 0; i < nnz; ++i)
+        {
+            out[mat.row[i]] += scalar * mat.val[i] * in[mat.col[i]];
+        }
+
+        return;
+    }
+
+#ifdef _OPENMP
+    int nthreads = omp_get_max_threads();
+#else
+    int nthreads = 1;
+#endif
+
+    // Row and partial sum of the first row of each segment
+    std::vector<int> carry_row(nthreads, -1);
+    std::vector<ValueType> carry_val(nthreads, static_cast<ValueType>(0));
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads)
+#endif
+    {
+#ifdef _OPENMP
+        int tid = omp_get_thread_num();
+        int nt  = omp_get_num_threads();
+#else
+        int tid = 0;
+        int nt  = 1;
+#endif
+
+        // Segment of non-zeros of this thread
+        int begin = static_cast<int>(static_cast<long int>(nnz) * tid / nt);
+        int end   = static_cast<int>(static_cast<long int>(nnz) * (tid + 1) / nt);
+
+        if(begin < end)
+        {
+            int row       = mat.row[begin];
+            bool first    = true;
+            ValueType sum = static_cast<ValueType>(0);
+
+            for(int i = begin; i < end; ++i)
+            {
+                if(mat.row[i] != row)
+                {
+                    // The first row might be shared with the previous segment
+                    if(first == true)
+                    {
+                        carry_row[tid] = row;
+                        carry_val[tid] = sum;
+                        first          = false;
+                    }
+                    else
+                    {
+                        out[row] += scalar * sum;
+                    }
+
+                    row = mat.row[i];
+                    sum = static_cast<ValueType>(0);
+                }
+
+                sum += mat.val[i] * in[mat.col[i]];
+            }
+
+            // The last row is owned by this segment, subsequent segments carry out their
+            // part of it
+            if(first == true)
+            {
+                carry_row[tid] = row;
+                carry_val[tid] = sum;
+            }
+            else
+            {
+                out[row] += scalar * sum;
+            }
+        }
+    }
+
+    // Carry-out fix-up
+    for(int t = 0; t < nthreads; ++t)
+    {
+        if(carry_row[t] >= 0)
+        {
+            out[carry_row[t]] += scalar * carry_val[t];
+        }
+    }
+}
+
+template void host_coo_spmv(int nnz,
+                            const MatrixCOO<double, int>& mat,
+                            const double* in,
+                            double scalar,
+                            double* out);
+template void host_coo_spmv(int nnz,
+                            const MatrixCOO<float, int>& mat,
+                            const float* in,
+                            float scalar,
+                            float* out);
+#ifdef SUPPORT_COMPLEX
+template void host_coo_spmv(int nnz,
+                            const MatrixCOO<std::complex<double>, int>& mat,
+                            const std::complex<double>* in,
+                            std::complex<double> scalar,
+                            std::complex<double>* out);
+template void host_coo_spmv(int nnz,
+                            const MatrixCOO<std::complex<float>, int>& mat,
+                            const std::complex<float>* in,
+                            std::complex<float> scalar,
+                            std::complex<float>* out);
+#endif
+
 template class HostMatrixCOO<double>;
 template class HostMatrixCOO<float>;
 #ifdef SUPPORT_COMPLEX
@@ -87,6 +87,18 @@ class HostMatrixCOO : public HostMatrix<ValueType>
     friend class HIPAcceleratorMatrixCOO<ValueType>;
 };
 
+/// Perform out = out + scalar * A * in for a COO matrix A. If A is sorted by rows, the
+/// non-zeros are split evenly among the OpenMP threads. Each thread accumulates its rows
+/// (segmented reduction), the partial sum of the first row of each segment is carried
+/// out and added after the parallel region, such that no atomics are required. Unsorted
+/// matrices, e.g. after Permute() or SetDataPtrCOO(), are multiplied serially.
+template <typename ValueType>
+void host_coo_spmv(int nnz,
+                   const MatrixCOO<ValueType, int>& mat,
+                   const ValueType* in,
+                   ValueType scalar,
+                   ValueType* out);
+
 } // namespace rocalution
 
 #endif // ROCALUTION_HOST_MATRIX_COO_HPP_
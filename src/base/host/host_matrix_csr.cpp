@@ -30,11 +30,15 @@
 #include "host_matrix_ell.hpp"
 #include "host_matrix_hyb.hpp"
 #include "host_matrix_dense.hpp"
+#include "host_matrix_sell.hpp"
+#include "host_matrix_ccsr.hpp"
 #include "host_conversion.hpp"
+#include "host_graph.hpp"
 #include "host_vector.hpp"
 #include "../../utils/log.hpp"
 #include "../../utils/allocate_free.hpp"
 #include "../../utils/math_functions.hpp"
+#include "../../utils/random.hpp"
 #include "../matrix_formats_ind.hpp"
 #include "version.hpp"
 
@@ -234,9 +238,27 @@ void HostMatrixCSR<ValueType>::AllocateCSR(int nnz, int nrow, int ncol)
         allocate_host(nnz, &this->mat_.col);
         allocate_host(nnz, &this->mat_.val);
 
-        set_to_zero_host(nrow + 1, mat_.row_offset);
-        set_to_zero_host(nnz, mat_.col);
-        set_to_zero_host(nnz, mat_.val);
+        // Zero with a static schedule, such that the pages are first touched by the
+        // threads that work on them. The row structure is not known yet, CopyFrom()
+        // places the entries by rows.
+        _set_omp_backend_threads(this->local_backend_, nrow);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < nrow + 1; ++i)
+        {
+            this->mat_.row_offset[i] = 0;
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int j = 0; j < nnz; ++j)
+        {
+            this->mat_.col[j] = 0;
+            this->mat_.val[j] = static_cast<ValueType>(0);
+        }
 
         this->nrow_ = nrow;
         this->ncol_ = ncol;
@@ -356,9 +378,17 @@ void HostMatrixCSR<ValueType>::CopyFrom(const BaseMatrix<ValueType>& mat)
     if(const HostMatrixCSR<ValueType>* cast_mat =
            dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat))
     {
-        if(this->nnz_ == 0)
+        if(this->nnz_ == 0 && cast_mat->nnz_ > 0)
         {
-            this->AllocateCSR(cast_mat->nnz_, cast_mat->nrow_, cast_mat->ncol_);
+            // Allocate without touching the data, the pages are first touched by the
+            // row-wise copy below
+            allocate_host(cast_mat->nrow_ + 1, &this->mat_.row_offset);
+            allocate_host(cast_mat->nnz_, &this->mat_.col);
+            allocate_host(cast_mat->nnz_, &this->mat_.val);
+
+            this->nrow_ = cast_mat->nrow_;
+            this->ncol_ = cast_mat->ncol_;
+            this->nnz_  = cast_mat->nnz_;
         }
 
         assert((this->nnz_ == cast_mat->nnz_) && (this->nrow_ == cast_mat->nrow_) &&
@@ -368,18 +398,33 @@ void HostMatrixCSR<ValueType>::CopyFrom(const BaseMatrix<ValueType>& mat)
         {
             _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
+            // Copy by rows with the static schedule of SpMV, such that each thread
+            // places the rows it works on in its local memory
+            this->mat_.row_offset[0] = cast_mat->mat_.row_offset[0];
+
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-            for(int i = 0; i < this->nrow_ + 1; ++i)
+            for(int i = 0; i < this->nrow_; ++i)
             {
-                this->mat_.row_offset[i] = cast_mat->mat_.row_offset[i];
+                this->mat_.row_offset[i + 1] = cast_mat->mat_.row_offset[i + 1];
+
+                for(int j = cast_mat->mat_.row_offset[i]; j < cast_mat->mat_.row_offset[i + 1];
+                    ++j)
+                {
+                    this->mat_.col[j] = cast_mat->mat_.col[j];
+                    this->mat_.val[j] = cast_mat->mat_.val[j];
+                }
             }
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-            for(int j = 0; j < this->nnz_; ++j)
+            // Entries outside of the row structure (if any)
+            for(int j = 0; j < cast_mat->mat_.row_offset[0]; ++j)
+            {
+                this->mat_.col[j] = cast_mat->mat_.col[j];
+                this->mat_.val[j] = cast_mat->mat_.val[j];
+            }
+
+            for(int j = cast_mat->mat_.row_offset[this->nrow_]; j < this->nnz_; ++j)
             {
                 this->mat_.col[j] = cast_mat->mat_.col[j];
                 this->mat_.val[j] = cast_mat->mat_.val[j];
@@ -743,6 +788,50 @@ bool HostMatrixCSR<ValueType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
         }
     }
 
+    if(const HostMatrixSELL<ValueType>* cast_mat =
+           dynamic_cast<const HostMatrixSELL<ValueType>*>(&mat))
+    {
+        this->Clear();
+        int nnz;
+
+        if(sell_to_csr(this->local_backend_.OpenMP_threads,
+                       cast_mat->nnz_,
+                       cast_mat->nrow_,
+                       cast_mat->ncol_,
+                       cast_mat->mat_,
+                       &this->mat_,
+                       &nnz) == true)
+        {
+            this->nrow_ = cast_mat->nrow_;
+            this->ncol_ = cast_mat->ncol_;
+            this->nnz_  = nnz;
+
+            return true;
+        }
+    }
+
+    if(const HostMatrixCCSR<ValueType>* cast_mat =
+           dynamic_cast<const HostMatrixCCSR<ValueType>*>(&mat))
+    {
+        this->Clear();
+        int nnz;
+
+        if(ccsr_to_csr(this->local_backend_.OpenMP_threads,
+                       cast_mat->nnz_,
+                       cast_mat->nrow_,
+                       cast_mat->ncol_,
+                       cast_mat->mat_,
+                       &this->mat_,
+                       &nnz) == true)
+        {
+            this->nrow_ = cast_mat->nrow_;
+            this->ncol_ = cast_mat->ncol_;
+            this->nnz_  = nnz;
+
+            return true;
+        }
+    }
+
     return false;
 }
 
@@ -782,1074 +871,2370 @@ void HostMatrixCSR<ValueType>::Apply(const BaseVector<ValueType>& in,
 }
 
 template <typename ValueType>
-void HostMatrixCSR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
-                                        ValueType scalar,
-                                        BaseVector<ValueType>* out) const
+bool HostMatrixCSR<ValueType>::ApplyMulti(int k,
+                                          const BaseVector<ValueType>& in,
+                                          BaseVector<ValueType>* out) const
 {
-    if(this->nnz_ > 0)
-    {
-        assert(in.GetSize() >= 0);
-        assert(out->GetSize() >= 0);
-        assert(in.GetSize() == this->ncol_);
-        assert(out->GetSize() == this->nrow_);
+    assert(k > 0);
+    assert(in.GetSize() == static_cast<IndexType2>(this->ncol_) * k);
+    assert(out->GetSize() == static_cast<IndexType2>(this->nrow_) * k);
 
-        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
-        HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
 
-        assert(cast_in != NULL);
-        assert(cast_out != NULL);
+    assert(cast_in != NULL);
+    assert(cast_out != NULL);
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int ai = 0; ai < this->nrow_; ++ai)
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        ValueType* sum = cast_out->vec_ + static_cast<IndexType2>(ai) * k;
+        int row_beg    = this->mat_.row_offset[ai];
+        int row_end    = this->mat_.row_offset[ai + 1];
+
+        for(int j = 0; j < k; ++j)
         {
-            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            sum[j] = static_cast<ValueType>(0);
+        }
+
+        // Each entry of the matrix is loaded once and applied to all k columns
+        for(int aj = row_beg; aj < row_end; ++aj)
+        {
+            ValueType val      = this->mat_.val[aj];
+            const ValueType* x = cast_in->vec_ + static_cast<IndexType2>(this->mat_.col[aj]) * k;
+
+            for(int j = 0; j < k; ++j)
             {
-                cast_out->vec_[ai] +=
-                    scalar * this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
+                sum[j] += val * x[j];
             }
         }
     }
+
+    return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ExtractDiagonal(BaseVector<ValueType>* vec_diag) const
+bool HostMatrixCSR<ValueType>::RestrictResidual(const BaseMatrix<ValueType>& A,
+                                                const BaseVector<ValueType>& b,
+                                                const BaseVector<ValueType>& x,
+                                                bool residual,
+                                                BaseVector<ValueType>* s,
+                                                BaseVector<ValueType>* out) const
 {
-    assert(vec_diag != NULL);
-    assert(vec_diag->GetSize() == this->nrow_);
+    assert(s != NULL);
+    assert(out != NULL);
+    assert(A.GetN() == x.GetSize());
+    assert(A.GetM() == b.GetSize());
+    assert(A.GetM() == s->GetSize());
+    assert(A.GetM() == this->ncol_);
+    assert(out->GetSize() == this->nrow_);
 
-    HostVector<ValueType>* cast_vec_diag = dynamic_cast<HostVector<ValueType>*>(vec_diag);
+    const HostMatrixCSR<ValueType>* cast_A = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+    const HostVector<ValueType>* cast_b    = dynamic_cast<const HostVector<ValueType>*>(&b);
+    const HostVector<ValueType>* cast_x    = dynamic_cast<const HostVector<ValueType>*>(&x);
+    HostVector<ValueType>* cast_s          = dynamic_cast<HostVector<ValueType>*>(s);
+    HostVector<ValueType>* cast_out        = dynamic_cast<HostVector<ValueType>*>(out);
 
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    if(cast_A == NULL)
+    {
+        return false;
+    }
+
+    assert(cast_b != NULL);
+    assert(cast_x != NULL);
+    assert(cast_s != NULL);
+    assert(cast_out != NULL);
+
+    const int* A_row_offset = cast_A->mat_.row_offset;
+    const int* A_col        = cast_A->mat_.col;
+    const ValueType* A_val  = cast_A->mat_.val;
+
+    const ValueType* bv = cast_b->vec_;
+    const ValueType* xv = cast_x->vec_;
+
+    if(residual == false && this->nnz_ <= this->ncol_)
+    {
+        // Aggregation type restriction (at most one entry per fine column), each residual
+        // entry is computed within the coarse row that restricts it and is not stored
+        _set_omp_backend_threads(this->local_backend_, this->ncol_);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
-    {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            if(ai == this->mat_.col[aj])
+            ValueType sum = static_cast<ValueType>(0);
+
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                cast_vec_diag->vec_[ai] = this->mat_.val[aj];
-                break;
-            }
-        }
-    }
+                int row = this->mat_.col[j];
 
-    return true;
-}
+                ValueType res = bv[row];
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const
-{
-    assert(vec_inv_diag != NULL);
-    assert(vec_inv_diag->GetSize() == this->nrow_);
+                for(int k = A_row_offset[row]; k < A_row_offset[row + 1]; ++k)
+                {
+                    res -= A_val[k] * xv[A_col[k]];
+                }
 
-    HostVector<ValueType>* cast_vec_inv_diag = dynamic_cast<HostVector<ValueType>*>(vec_inv_diag);
+                sum += this->mat_.val[j] * res;
+            }
 
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+            cast_out->vec_[i] = sum;
+        }
+    }
+    else
+    {
+        // s = b - Ax in a single sweep and out = Rs
+        _set_omp_backend_threads(this->local_backend_, this->ncol_);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
-    {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        for(int i = 0; i < this->ncol_; ++i)
         {
-            if(ai == this->mat_.col[aj])
+            ValueType res = bv[i];
+
+            for(int k = A_row_offset[i]; k < A_row_offset[i + 1]; ++k)
             {
-                cast_vec_inv_diag->vec_[ai] = static_cast<ValueType>(1) / this->mat_.val[aj];
-                break;
+                res -= A_val[k] * xv[A_col[k]];
             }
+
+            cast_s->vec_[i] = res;
         }
+
+        this->Apply(*s, out);
     }
 
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ExtractSubMatrix(
-    int row_offset, int col_offset, int row_size, int col_size, BaseMatrix<ValueType>* mat) const
+bool HostMatrixCSR<ValueType>::CGIterations(const BaseVector<ValueType>* inv_diag,
+                                            ValueType rho,
+                                            bool (*check)(double res, void* data),
+                                            void* data,
+                                            BaseVector<ValueType>* x,
+                                            BaseVector<ValueType>* r,
+                                            BaseVector<ValueType>* p,
+                                            BaseVector<ValueType>* q) const
 {
-    assert(mat != NULL);
-
-    assert(row_offset >= 0);
-    assert(col_offset >= 0);
-
-    assert(this->nrow_ > 0);
-    assert(this->ncol_ > 0);
+    assert(check != NULL);
+    assert(this->nrow_ == this->ncol_);
+    assert(x->GetSize() == this->nrow_);
+    assert(r->GetSize() == this->nrow_);
+    assert(p->GetSize() == this->nrow_);
+    assert(q->GetSize() == this->nrow_);
+
+    const HostVector<ValueType>* cast_d = dynamic_cast<const HostVector<ValueType>*>(inv_diag);
+    HostVector<ValueType>* cast_x       = dynamic_cast<HostVector<ValueType>*>(x);
+    HostVector<ValueType>* cast_r       = dynamic_cast<HostVector<ValueType>*>(r);
+    HostVector<ValueType>* cast_p       = dynamic_cast<HostVector<ValueType>*>(p);
+    HostVector<ValueType>* cast_q       = dynamic_cast<HostVector<ValueType>*>(q);
+
+    assert((inv_diag == NULL) || (cast_d != NULL));
+    assert(cast_x != NULL);
+    assert(cast_r != NULL);
+    assert(cast_p != NULL);
+    assert(cast_q != NULL);
+
+    const ValueType* d = (cast_d != NULL) ? cast_d->vec_ : NULL;
+    ValueType* xv      = cast_x->vec_;
+    ValueType* rv      = cast_r->vec_;
+    ValueType* pv      = cast_p->vec_;
+    ValueType* qv      = cast_q->vec_;
 
-    HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<HostMatrixCSR<ValueType>*>(mat);
-    assert(cast_mat != NULL);
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-    int mat_nnz = 0;
+    int nthreads = 1;
 
-    // use omp in local_matrix (higher level)
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
 
-    //  _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    // Each thread owns a contiguous row range with (roughly) the same number of non-zeros
+    // for all iterations, all vector operations work on the same range
+    std::vector<int> range(nthreads + 1);
 
-    //#ifdef _OPENMP
-    //#pragma omp parallel for reduction(+:mat_nnz)
-    //#endif
-    for(int ai = row_offset; ai < row_offset + row_size; ++ai)
+    for(int t = 0; t < nthreads; ++t)
     {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-        {
-            if((this->mat_.col[aj] >= col_offset) && (this->mat_.col[aj] < col_offset + col_size))
-            {
-                ++mat_nnz;
-            }
-        }
+        int nnz_begin = static_cast<int>(static_cast<long>(this->nnz_) * t / nthreads);
+
+        range[t] = static_cast<int>(
+            std::lower_bound(this->mat_.row_offset, this->mat_.row_offset + this->nrow_, nnz_begin)
+            - this->mat_.row_offset);
     }
 
-    // not empty submatrix
-    if(mat_nnz > 0)
+    range[nthreads] = this->nrow_;
+
+    // Partial sums of each thread, padded to separate cache lines
+    const int pad    = 64 / sizeof(ValueType);
+    const int pad_rr = 64 / sizeof(double);
+
+    std::vector<ValueType> part_pq(nthreads * pad);
+    std::vector<ValueType> part_rz(nthreads * pad);
+    std::vector<double> part_rr(nthreads * pad_rr);
+
+    bool stop = false;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads)
+#endif
     {
-        cast_mat->AllocateCSR(mat_nnz, row_size, col_size);
+        int tid = 0;
 
-        int mat_row_offset           = 0;
-        cast_mat->mat_.row_offset[0] = mat_row_offset;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
 
-        for(int ai = row_offset; ai < row_offset + row_size; ++ai)
+        int row_begin = range[tid];
+        int row_end   = range[tid + 1];
+
+        ValueType rho_old = rho;
+        ValueType beta    = static_cast<ValueType>(0);
+        bool first        = true;
+
+        while(true)
         {
-            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            // p = z + beta*p, the initial direction is given
+            if(first == false)
             {
-                if((this->mat_.col[aj] >= col_offset) &&
-                   (this->mat_.col[aj] < col_offset + col_size))
+                for(int i = row_begin; i < row_end; ++i)
                 {
-                    cast_mat->mat_.col[mat_row_offset] = this->mat_.col[aj] - col_offset;
-                    cast_mat->mat_.val[mat_row_offset] = this->mat_.val[aj];
-                    ++mat_row_offset;
+                    ValueType z = (d != NULL) ? d[i] * rv[i] : rv[i];
+                    pv[i]       = z + beta * pv[i];
                 }
             }
 
-            cast_mat->mat_.row_offset[ai - row_offset + 1] = mat_row_offset;
-        }
+            first = false;
 
-        cast_mat->mat_.row_offset[row_size] = mat_row_offset;
-        assert(mat_row_offset == mat_nnz);
-    }
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
 
-    return true;
-}
+            // q = Ap, partial (p,q)
+            ValueType pq = static_cast<ValueType>(0);
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ExtractU(BaseMatrix<ValueType>* U) const
-{
-    assert(U != NULL);
+            for(int i = row_begin; i < row_end; ++i)
+            {
+                ValueType sum = static_cast<ValueType>(0);
 
-    assert(this->nrow_ > 0);
-    assert(this->ncol_ > 0);
+                for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    sum += this->mat_.val[j] * pv[this->mat_.col[j]];
+                }
 
-    HostMatrixCSR<ValueType>* cast_U = dynamic_cast<HostMatrixCSR<ValueType>*>(U);
+                qv[i] = sum;
+                pq += pv[i] * sum;
+            }
 
-    assert(cast_U != NULL);
+            part_pq[tid * pad] = pq;
 
-    // count nnz of upper triangular part
-    int nnz_U = 0;
 #ifdef _OPENMP
-#pragma omp parallel for reduction(+ : nnz_U)
+#pragma omp barrier
 #endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
-    {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-        {
-            if(this->mat_.col[aj] > ai)
+
+            // All threads reduce in the same order and obtain the same alpha
+            pq = static_cast<ValueType>(0);
+
+            for(int t = 0; t < nthreads; ++t)
             {
-                ++nnz_U;
+                pq += part_pq[t * pad];
             }
-        }
-    }
 
-    // allocate upper triangular part structure
-    int* row_offset = NULL;
-    int* col        = NULL;
-    ValueType* val  = NULL;
+            ValueType alpha = rho_old / pq;
 
-    allocate_host(this->nrow_ + 1, &row_offset);
-    allocate_host(nnz_U, &col);
-    allocate_host(nnz_U, &val);
+            // x = x + alpha*p, r = r - alpha*q, partial (r,r) and (r,z)
+            ValueType rz = static_cast<ValueType>(0);
+            double rr    = 0.0;
 
-    // fill upper triangular part
-    int nnz       = 0;
-    row_offset[0] = 0;
-    for(int ai = 0; ai < this->nrow_; ++ai)
-    {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-        {
-            if(this->mat_.col[aj] > ai)
+            for(int i = row_begin; i < row_end; ++i)
             {
-                col[nnz] = this->mat_.col[aj];
-                val[nnz] = this->mat_.val[aj];
-                ++nnz;
+                xv[i] += alpha * pv[i];
+                rv[i] -= alpha * qv[i];
+
+                double abs_r = rocalution_abs(rv[i]);
+
+                rr += abs_r * abs_r;
+                rz += (d != NULL) ? rv[i] * d[i] * rv[i] : rv[i] * rv[i];
             }
-        }
 
-        row_offset[ai + 1] = nnz;
-    }
+            part_rr[tid * pad_rr] = rr;
+            part_rz[tid * pad] = rz;
 
-    cast_U->Clear();
-    cast_U->SetDataPtrCSR(&row_offset, &col, &val, nnz_U, this->nrow_, this->ncol_);
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+
+            rr = 0.0;
+            rz = static_cast<ValueType>(0);
+
+            for(int t = 0; t < nthreads; ++t)
+            {
+                rr += part_rr[t * pad_rr];
+                rz += part_rz[t * pad];
+            }
+
+            // Check convergence
+#ifdef _OPENMP
+#pragma omp single
+#endif
+            {
+                stop = check(sqrt(rr), data);
+            }
+
+            if(stop == true)
+            {
+                break;
+            }
+
+            beta    = rz / rho_old;
+            rho_old = rz;
+        }
+    }
 
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ExtractUDiagonal(BaseMatrix<ValueType>* U) const
+bool HostMatrixCSR<ValueType>::ApplyRows(int nrow,
+                                         const int* rows,
+                                         const BaseVector<ValueType>& in,
+                                         BaseVector<ValueType>* out) const
 {
-    assert(U != NULL);
+    assert(nrow >= 0);
+    assert(nrow <= this->nrow_);
+    assert(nrow == 0 || rows != NULL);
+    assert(in.GetSize() == this->ncol_);
+    assert(out->GetSize() == this->nrow_);
 
-    assert(this->nrow_ > 0);
-    assert(this->ncol_ > 0);
+    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
 
-    HostMatrixCSR<ValueType>* cast_U = dynamic_cast<HostMatrixCSR<ValueType>*>(U);
+    assert(cast_in != NULL);
+    assert(cast_out != NULL);
 
-    assert(cast_U != NULL);
+    _set_omp_backend_threads(this->local_backend_, nrow);
 
-    // count nnz of upper triangular part
-    int nnz_U = 0;
 #ifdef _OPENMP
-#pragma omp parallel for reduction(+ : nnz_U)
+#pragma omp parallel for
 #endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    for(int i = 0; i < nrow; ++i)
     {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        int ai        = rows[i];
+        ValueType sum = static_cast<ValueType>(0);
+        int aj_begin  = this->mat_.row_offset[ai];
+        int aj_end    = this->mat_.row_offset[ai + 1];
+
+        for(int aj = aj_begin; aj < aj_end; ++aj)
         {
-            if(this->mat_.col[aj] >= ai)
-            {
-                ++nnz_U;
-            }
+            sum += this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
         }
-    }
 
-    // allocate upper triangular part structure
-    int* row_offset = NULL;
-    int* col        = NULL;
-    ValueType* val  = NULL;
+        cast_out->vec_[ai] = sum;
+    }
 
-    allocate_host(this->nrow_ + 1, &row_offset);
-    allocate_host(nnz_U, &col);
-    allocate_host(nnz_U, &val);
+    return true;
+}
 
-    // fill upper triangular part
-    int nnz       = 0;
-    row_offset[0] = 0;
-    for(int ai = 0; ai < this->nrow_; ++ai)
+template <typename ValueType>
+void HostMatrixCSR<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                        ValueType scalar,
+                                        BaseVector<ValueType>* out) const
+{
+    if(this->nnz_ > 0)
     {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            if(this->mat_.col[aj] >= ai)
+            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                col[nnz] = this->mat_.col[aj];
-                val[nnz] = this->mat_.val[aj];
-                ++nnz;
+                cast_out->vec_[ai] +=
+                    scalar * this->mat_.val[aj] * cast_in->vec_[this->mat_.col[aj]];
             }
         }
-
-        row_offset[ai + 1] = nnz;
     }
-
-    cast_U->Clear();
-    cast_U->SetDataPtrCSR(&row_offset, &col, &val, nnz_U, this->nrow_, this->ncol_);
-
-    return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ExtractL(BaseMatrix<ValueType>* L) const
+bool HostMatrixCSR<ValueType>::ExtractDiagonal(BaseVector<ValueType>* vec_diag) const
 {
-    assert(L != NULL);
-
-    assert(this->nrow_ > 0);
-    assert(this->ncol_ > 0);
+    assert(vec_diag != NULL);
+    assert(vec_diag->GetSize() == this->nrow_);
 
-    HostMatrixCSR<ValueType>* cast_L = dynamic_cast<HostMatrixCSR<ValueType>*>(L);
+    HostVector<ValueType>* cast_vec_diag = dynamic_cast<HostVector<ValueType>*>(vec_diag);
 
-    assert(cast_L != NULL);
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-    // count nnz of lower triangular part
-    int nnz_L = 0;
 #ifdef _OPENMP
-#pragma omp parallel for reduction(+ : nnz_L)
+#pragma omp parallel for
 #endif
     for(int ai = 0; ai < this->nrow_; ++ai)
     {
         for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            if(this->mat_.col[aj] < ai)
+            if(ai == this->mat_.col[aj])
             {
-                ++nnz_L;
+                cast_vec_diag->vec_[ai] = this->mat_.val[aj];
+                break;
             }
         }
     }
 
-    // allocate lower triangular part structure
-    int* row_offset = NULL;
-    int* col        = NULL;
-    ValueType* val  = NULL;
+    return true;
+}
 
-    allocate_host(this->nrow_ + 1, &row_offset);
-    allocate_host(nnz_L, &col);
-    allocate_host(nnz_L, &val);
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const
+{
+    assert(vec_inv_diag != NULL);
+    assert(vec_inv_diag->GetSize() == this->nrow_);
 
-    // fill lower triangular part
-    int nnz       = 0;
-    row_offset[0] = 0;
+    HostVector<ValueType>* cast_vec_inv_diag = dynamic_cast<HostVector<ValueType>*>(vec_inv_diag);
+
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(int ai = 0; ai < this->nrow_; ++ai)
     {
         for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            if(this->mat_.col[aj] < ai)
+            if(ai == this->mat_.col[aj])
             {
-                col[nnz] = this->mat_.col[aj];
-                val[nnz] = this->mat_.val[aj];
-                ++nnz;
+                cast_vec_inv_diag->vec_[ai] = static_cast<ValueType>(1) / this->mat_.val[aj];
+                break;
             }
         }
-
-        row_offset[ai + 1] = nnz;
     }
 
-    cast_L->Clear();
-    cast_L->SetDataPtrCSR(&row_offset, &col, &val, nnz_L, this->nrow_, this->ncol_);
-
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ExtractLDiagonal(BaseMatrix<ValueType>* L) const
+bool HostMatrixCSR<ValueType>::ExtractSubMatrix(
+    int row_offset, int col_offset, int row_size, int col_size, BaseMatrix<ValueType>* mat) const
 {
-    assert(L != NULL);
+    assert(mat != NULL);
+
+    assert(row_offset >= 0);
+    assert(col_offset >= 0);
 
     assert(this->nrow_ > 0);
     assert(this->ncol_ > 0);
 
-    HostMatrixCSR<ValueType>* cast_L = dynamic_cast<HostMatrixCSR<ValueType>*>(L);
+    HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<HostMatrixCSR<ValueType>*>(mat);
+    assert(cast_mat != NULL);
 
-    assert(cast_L != NULL);
+    int mat_nnz = 0;
 
-    // count nnz of lower triangular part
-    int nnz_L = 0;
-#ifdef _OPENMP
-#pragma omp parallel for reduction(+ : nnz_L)
-#endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    // use omp in local_matrix (higher level)
+
+    //  _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+    //#ifdef _OPENMP
+    //#pragma omp parallel for reduction(+:mat_nnz)
+    //#endif
+    for(int ai = row_offset; ai < row_offset + row_size; ++ai)
     {
         for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            if(this->mat_.col[aj] <= ai)
+            if((this->mat_.col[aj] >= col_offset) && (this->mat_.col[aj] < col_offset + col_size))
             {
-                ++nnz_L;
+                ++mat_nnz;
             }
         }
     }
 
-    // allocate lower triangular part structure
-    int* row_offset = NULL;
-    int* col        = NULL;
-    ValueType* val  = NULL;
+    // not empty submatrix
+    if(mat_nnz > 0)
+    {
+        cast_mat->AllocateCSR(mat_nnz, row_size, col_size);
 
-    allocate_host(this->nrow_ + 1, &row_offset);
-    allocate_host(nnz_L, &col);
-    allocate_host(nnz_L, &val);
+        int mat_row_offset           = 0;
+        cast_mat->mat_.row_offset[0] = mat_row_offset;
 
-    // fill lower triangular part
-    int nnz       = 0;
-    row_offset[0] = 0;
-    for(int ai = 0; ai < this->nrow_; ++ai)
-    {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        for(int ai = row_offset; ai < row_offset + row_size; ++ai)
         {
-            if(this->mat_.col[aj] <= ai)
+            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                col[nnz] = this->mat_.col[aj];
-                val[nnz] = this->mat_.val[aj];
-                ++nnz;
+                if((this->mat_.col[aj] >= col_offset) &&
+                   (this->mat_.col[aj] < col_offset + col_size))
+                {
+                    cast_mat->mat_.col[mat_row_offset] = this->mat_.col[aj] - col_offset;
+                    cast_mat->mat_.val[mat_row_offset] = this->mat_.val[aj];
+                    ++mat_row_offset;
+                }
             }
+
+            cast_mat->mat_.row_offset[ai - row_offset + 1] = mat_row_offset;
         }
 
-        row_offset[ai + 1] = nnz;
+        cast_mat->mat_.row_offset[row_size] = mat_row_offset;
+        assert(mat_row_offset == mat_nnz);
     }
 
-    cast_L->Clear();
-    cast_L->SetDataPtrCSR(&row_offset, &col, &val, nnz_L, this->nrow_, this->ncol_);
-
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::LUSolve(const BaseVector<ValueType>& in,
-                                       BaseVector<ValueType>* out) const
+bool HostMatrixCSR<ValueType>::ExtractSubMatrices(int row_num_blocks,
+                                                  int col_num_blocks,
+                                                  const int* row_offset,
+                                                  const int* col_offset,
+                                                  BaseMatrix<ValueType>** mat) const
 {
-    assert(in.GetSize() >= 0);
-    assert(out->GetSize() >= 0);
-    assert(in.GetSize() == this->ncol_);
-    assert(out->GetSize() == this->nrow_);
+    assert(row_num_blocks > 0);
+    assert(col_num_blocks > 0);
+    assert(row_offset != NULL);
+    assert(col_offset != NULL);
+    assert(mat != NULL);
 
-    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
-    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+    assert(this->nrow_ > 0);
+    assert(this->ncol_ > 0);
 
-    assert(cast_in != NULL);
-    assert(cast_out != NULL);
+    int num_blocks = row_num_blocks * col_num_blocks;
 
-    // Solve L
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    std::vector<HostMatrixCSR<ValueType>*> cast_mat(num_blocks);
+
+    for(int k = 0; k < num_blocks; ++k)
     {
-        cast_out->vec_[ai] = cast_in->vec_[ai];
+        cast_mat[k] = dynamic_cast<HostMatrixCSR<ValueType>*>(mat[k]);
+        assert(cast_mat[k] != NULL);
+    }
 
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+    // Map rows and columns to their block, -1 if not covered by any block
+    std::vector<int> row_block(this->nrow_, -1);
+    std::vector<int> col_block(this->ncol_, -1);
+
+    for(int i = 0; i < row_num_blocks; ++i)
+    {
+        assert(row_offset[i] >= 0);
+        assert(row_offset[i] <= row_offset[i + 1]);
+        assert(row_offset[i + 1] <= this->nrow_);
+
+        for(int ai = row_offset[i]; ai < row_offset[i + 1]; ++ai)
         {
-            if(this->mat_.col[aj] < ai)
-            {
-                // under the diagonal
-                cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
-            }
-            else
-            {
-                // CSR should be sorted
-                break;
-            }
+            row_block[ai] = i;
         }
     }
 
-    // last elements should be the diagonal one (last)
-    int diag_aj = this->nnz_ - 1;
+    for(int j = 0; j < col_num_blocks; ++j)
+    {
+        assert(col_offset[j] >= 0);
+        assert(col_offset[j] <= col_offset[j + 1]);
+        assert(col_offset[j + 1] <= this->ncol_);
 
-    // Solve U
-    for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+        for(int aj = col_offset[j]; aj < col_offset[j + 1]; ++aj)
+        {
+            col_block[aj] = j;
+        }
+    }
+
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+    // Number of entries of each block
+    std::vector<int> block_nnz(num_blocks, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        std::vector<int> thread_nnz(num_blocks, 0);
+
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
         {
-            if(this->mat_.col[aj] > ai)
+            int i = row_block[ai];
+
+            if(i == -1)
             {
-                // above the diagonal
-                cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+                continue;
             }
 
-            if(this->mat_.col[aj] == ai)
+            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
             {
-                diag_aj = aj;
+                int j = col_block[this->mat_.col[aj]];
+
+                if(j != -1)
+                {
+                    ++thread_nnz[i * col_num_blocks + j];
+                }
             }
         }
 
-        cast_out->vec_[ai] /= this->mat_.val[diag_aj];
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            for(int k = 0; k < num_blocks; ++k)
+            {
+                block_nnz[k] += thread_nnz[k];
+            }
+        }
     }
 
-    return true;
-}
-
-template <typename ValueType>
-void HostMatrixCSR<ValueType>::LLAnalyse(void)
-{
-    // do nothing
-}
-
-template <typename ValueType>
-void HostMatrixCSR<ValueType>::LLAnalyseClear(void)
-{
-    // do nothing
-}
-
-template <typename ValueType>
-void HostMatrixCSR<ValueType>::LUAnalyse(void)
-{
-    // do nothing
-}
-
-template <typename ValueType>
-void HostMatrixCSR<ValueType>::LUAnalyseClear(void)
-{
-    // do nothing
-}
+    // Allocate the non-empty sub-matrices, empty sub-matrices stay cleared
+    std::vector<int*> sub_row_offset(num_blocks, NULL);
+    std::vector<int*> sub_col(num_blocks, NULL);
+    std::vector<ValueType*> sub_val(num_blocks, NULL);
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
-                                       BaseVector<ValueType>* out) const
-{
-    assert(in.GetSize() >= 0);
-    assert(out->GetSize() >= 0);
-    assert(in.GetSize() == this->ncol_);
-    assert(out->GetSize() == this->nrow_);
+    for(int k = 0; k < num_blocks; ++k)
+    {
+        if(block_nnz[k] > 0)
+        {
+            int row_size = row_offset[k / col_num_blocks + 1] - row_offset[k / col_num_blocks];
 
-    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
-    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+            allocate_host(row_size + 1, &sub_row_offset[k]);
+            allocate_host(block_nnz[k], &sub_col[k]);
+            allocate_host(block_nnz[k], &sub_val[k]);
 
-    assert(cast_in != NULL);
-    assert(cast_out != NULL);
+            set_to_zero_host(row_size + 1, sub_row_offset[k]);
+        }
+    }
 
-    // Solve L
+    // Count the entries of each row in all column blocks in a single pass
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        ValueType value = cast_in->vec_[ai];
-        int diag_idx    = this->mat_.row_offset[ai + 1] - 1;
+        int i = row_block[ai];
 
-        for(int aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+        if(i == -1)
         {
-            value -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+            continue;
         }
 
-        cast_out->vec_[ai] = value / this->mat_.val[diag_idx];
+        int row = ai - row_offset[i] + 1;
+
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            int j = col_block[this->mat_.col[aj]];
+
+            if(j != -1)
+            {
+                ++sub_row_offset[i * col_num_blocks + j][row];
+            }
+        }
     }
 
-    // Solve L^T
-    for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+    // Exclusive scan of the row offsets
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(int k = 0; k < num_blocks; ++k)
     {
-        int diag_idx    = this->mat_.row_offset[ai + 1] - 1;
-        ValueType value = cast_out->vec_[ai] / this->mat_.val[diag_idx];
+        if(block_nnz[k] == 0)
+        {
+            continue;
+        }
 
-        for(int aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+        int row_size = row_offset[k / col_num_blocks + 1] - row_offset[k / col_num_blocks];
+        int* ptr     = sub_row_offset[k];
+
+        for(int ai = 0; ai < row_size; ++ai)
         {
-            cast_out->vec_[this->mat_.col[aj]] -= value * this->mat_.val[aj];
+            ptr[ai + 1] += ptr[ai];
         }
 
-        cast_out->vec_[ai] = value;
+        assert(ptr[row_size] == block_nnz[k]);
     }
 
-    return true;
-}
+    // Fill the sub-matrices, the order of the entries within each row is preserved
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        // Position in each column block and the row it belongs to
+        std::vector<int> pos(col_num_blocks);
+        std::vector<int> pos_row(col_num_blocks, -1);
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
-                                       const BaseVector<ValueType>& inv_diag,
-                                       BaseVector<ValueType>* out) const
-{
-    assert(in.GetSize() >= 0);
-    assert(out->GetSize() >= 0);
-    assert(in.GetSize() == this->ncol_);
-    assert(out->GetSize() == this->nrow_);
-    assert(inv_diag.GetSize() == this->nrow_ || inv_diag.GetSize() == this->ncol_);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for(int ai = 0; ai < this->nrow_; ++ai)
+        {
+            int i = row_block[ai];
 
-    const HostVector<ValueType>* cast_in   = dynamic_cast<const HostVector<ValueType>*>(&in);
-    const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&inv_diag);
-    HostVector<ValueType>* cast_out        = dynamic_cast<HostVector<ValueType>*>(out);
+            if(i == -1)
+            {
+                continue;
+            }
 
-    assert(cast_in != NULL);
-    assert(cast_out != NULL);
+            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                int j = col_block[this->mat_.col[aj]];
 
-    // Solve L
-    for(int ai = 0; ai < this->nrow_; ++ai)
-    {
-        ValueType value = cast_in->vec_[ai];
-        int diag_idx    = this->mat_.row_offset[ai + 1] - 1;
+                if(j == -1)
+                {
+                    continue;
+                }
 
-        for(int aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
-        {
-            value -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
-        }
+                int k = i * col_num_blocks + j;
 
-        cast_out->vec_[ai] = value * cast_diag->vec_[ai];
+                if(pos_row[j] != ai)
+                {
+                    pos[j]     = sub_row_offset[k][ai - row_offset[i]];
+                    pos_row[j] = ai;
+                }
+
+                sub_col[k][pos[j]] = this->mat_.col[aj] - col_offset[j];
+                sub_val[k][pos[j]] = this->mat_.val[aj];
+                ++pos[j];
+            }
+        }
     }
 
-    // Solve L^T
-    for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+    for(int k = 0; k < num_blocks; ++k)
     {
-        int diag_idx    = this->mat_.row_offset[ai + 1] - 1;
-        ValueType value = cast_out->vec_[ai] * cast_diag->vec_[ai];
-
-        for(int aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+        if(block_nnz[k] > 0)
         {
-            cast_out->vec_[this->mat_.col[aj]] -= value * this->mat_.val[aj];
-        }
+            int i = k / col_num_blocks;
+            int j = k % col_num_blocks;
 
-        cast_out->vec_[ai] = value;
+            cast_mat[k]->SetDataPtrCSR(&sub_row_offset[k],
+                                       &sub_col[k],
+                                       &sub_val[k],
+                                       block_nnz[k],
+                                       row_offset[i + 1] - row_offset[i],
+                                       col_offset[j + 1] - col_offset[j]);
+        }
     }
 
     return true;
 }
 
 template <typename ValueType>
-void HostMatrixCSR<ValueType>::LAnalyse(bool diag_unit)
-{
-    this->L_diag_unit_ = diag_unit;
-}
-
-template <typename ValueType>
-void HostMatrixCSR<ValueType>::LAnalyseClear(void)
-{
-    // do nothing
-    this->L_diag_unit_ = true;
-}
-
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::LSolve(const BaseVector<ValueType>& in,
-                                      BaseVector<ValueType>* out) const
+bool HostMatrixCSR<ValueType>::ExtractU(BaseMatrix<ValueType>* U) const
 {
-    assert(in.GetSize() >= 0);
-    assert(out->GetSize() >= 0);
-    assert(in.GetSize() == this->ncol_);
-    assert(out->GetSize() == this->nrow_);
+    assert(U != NULL);
 
-    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
-    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+    assert(this->nrow_ > 0);
+    assert(this->ncol_ > 0);
 
-    assert(cast_in != NULL);
-    assert(cast_out != NULL);
+    HostMatrixCSR<ValueType>* cast_U = dynamic_cast<HostMatrixCSR<ValueType>*>(U);
 
-    int diag_aj = 0;
+    assert(cast_U != NULL);
 
-    // Solve L
+    // count nnz of upper triangular part
+    int nnz_U = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nnz_U)
+#endif
     for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        cast_out->vec_[ai] = cast_in->vec_[ai];
-
         for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            if(this->mat_.col[aj] < ai)
-            {
-                // under the diagonal
-                cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
-            }
-            else
+            if(this->mat_.col[aj] > ai)
             {
-                // CSR should be sorted
-                if(this->L_diag_unit_ == false)
-                {
-                    assert(this->mat_.col[aj] == ai);
-                    diag_aj = aj;
-                }
-                break;
+                ++nnz_U;
             }
         }
-
-        if(this->L_diag_unit_ == false)
-        {
-            cast_out->vec_[ai] /= this->mat_.val[diag_aj];
-        }
     }
 
-    return true;
-}
+    // allocate upper triangular part structure
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
 
-template <typename ValueType>
-void HostMatrixCSR<ValueType>::UAnalyse(bool diag_unit)
-{
-    this->U_diag_unit_ = diag_unit;
-}
+    allocate_host(this->nrow_ + 1, &row_offset);
+    allocate_host(nnz_U, &col);
+    allocate_host(nnz_U, &val);
 
-template <typename ValueType>
-void HostMatrixCSR<ValueType>::UAnalyseClear(void)
-{
-    // do nothing
-    this->U_diag_unit_ = false;
+    // fill upper triangular part
+    int nnz       = 0;
+    row_offset[0] = 0;
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(this->mat_.col[aj] > ai)
+            {
+                col[nnz] = this->mat_.col[aj];
+                val[nnz] = this->mat_.val[aj];
+                ++nnz;
+            }
+        }
+
+        row_offset[ai + 1] = nnz;
+    }
+
+    cast_U->Clear();
+    cast_U->SetDataPtrCSR(&row_offset, &col, &val, nnz_U, this->nrow_, this->ncol_);
+
+    return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::USolve(const BaseVector<ValueType>& in,
-                                      BaseVector<ValueType>* out) const
+bool HostMatrixCSR<ValueType>::ExtractUDiagonal(BaseMatrix<ValueType>* U) const
 {
-    assert(in.GetSize() >= 0);
-    assert(out->GetSize() >= 0);
-    assert(in.GetSize() == this->ncol_);
-    assert(out->GetSize() == this->nrow_);
+    assert(U != NULL);
 
-    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
-    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+    assert(this->nrow_ > 0);
+    assert(this->ncol_ > 0);
 
-    assert(cast_in != NULL);
-    assert(cast_out != NULL);
+    HostMatrixCSR<ValueType>* cast_U = dynamic_cast<HostMatrixCSR<ValueType>*>(U);
 
-    // last elements should the diagonal one (last)
-    int diag_aj = this->nnz_ - 1;
+    assert(cast_U != NULL);
 
-    // Solve U
-    for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+    // count nnz of upper triangular part
+    int nnz_U = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nnz_U)
+#endif
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        cast_out->vec_[ai] = cast_in->vec_[ai];
-
         for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            if(this->mat_.col[aj] > ai)
+            if(this->mat_.col[aj] >= ai)
             {
-                // above the diagonal
-                cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+                ++nnz_U;
             }
+        }
+    }
 
-            if(this->L_diag_unit_ == false)
+    // allocate upper triangular part structure
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
+
+    allocate_host(this->nrow_ + 1, &row_offset);
+    allocate_host(nnz_U, &col);
+    allocate_host(nnz_U, &val);
+
+    // fill upper triangular part
+    int nnz       = 0;
+    row_offset[0] = 0;
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(this->mat_.col[aj] >= ai)
             {
-                if(this->mat_.col[aj] == ai)
-                {
-                    diag_aj = aj;
-                }
+                col[nnz] = this->mat_.col[aj];
+                val[nnz] = this->mat_.val[aj];
+                ++nnz;
             }
         }
 
-        if(this->L_diag_unit_ == false)
-        {
-            cast_out->vec_[ai] /= this->mat_.val[diag_aj];
-        }
+        row_offset[ai + 1] = nnz;
     }
 
+    cast_U->Clear();
+    cast_U->SetDataPtrCSR(&row_offset, &col, &val, nnz_U, this->nrow_, this->ncol_);
+
     return true;
 }
 
-// Algorithm for ILU factorization is based on
-// Y. Saad, Iterative methods for sparse linear systems, 2nd edition, SIAM
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ILU0Factorize(void)
+bool HostMatrixCSR<ValueType>::ExtractL(BaseMatrix<ValueType>* L) const
 {
-    assert(this->nrow_ == this->ncol_);
-    assert(this->nnz_ > 0);
+    assert(L != NULL);
 
-    // pointer of upper part of each row
-    int* diag_offset = NULL;
-    int* nnz_entries = NULL;
+    assert(this->nrow_ > 0);
+    assert(this->ncol_ > 0);
 
-    allocate_host(this->nrow_, &diag_offset);
-    allocate_host(this->nrow_, &nnz_entries);
+    HostMatrixCSR<ValueType>* cast_L = dynamic_cast<HostMatrixCSR<ValueType>*>(L);
 
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        nnz_entries[i] = 0;
-    }
+    assert(cast_L != NULL);
 
-    // ai = 0 to N loop over all rows
+    // count nnz of lower triangular part
+    int nnz_L = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nnz_L)
+#endif
     for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        // ai-th row entries
-        int row_start = this->mat_.row_offset[ai];
-        int row_end   = this->mat_.row_offset[ai + 1];
-        int j;
-
-        // nnz position of ai-th row in mat_.val array
-        for(j = row_start; j < row_end; ++j)
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            nnz_entries[this->mat_.col[j]] = j;
+            if(this->mat_.col[aj] < ai)
+            {
+                ++nnz_L;
+            }
         }
+    }
 
-        // loop over ai-th row nnz entries
-        for(j = row_start; j < row_end; ++j)
-        {
-            // if nnz entry is in lower matrix
-            if(this->mat_.col[j] < ai)
-            {
-                int col_j  = this->mat_.col[j];
-                int diag_j = diag_offset[col_j];
+    // allocate lower triangular part structure
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
 
-                if(this->mat_.val[diag_j] != static_cast<ValueType>(0))
-                {
-                    // multiplication factor
-                    this->mat_.val[j] = this->mat_.val[j] / this->mat_.val[diag_j];
+    allocate_host(this->nrow_ + 1, &row_offset);
+    allocate_host(nnz_L, &col);
+    allocate_host(nnz_L, &val);
 
-                    // loop over upper offset pointer and do linear combination for nnz entry
-                    for(int k = diag_j + 1; k < this->mat_.row_offset[col_j + 1]; ++k)
-                    {
-                        // if nnz at this position do linear combination
-                        if(nnz_entries[this->mat_.col[k]] != 0)
-                        {
-                            this->mat_.val[nnz_entries[this->mat_.col[k]]] -=
-                                this->mat_.val[j] * this->mat_.val[k];
-                        }
-                    }
-                }
-            }
-            else
+    // fill lower triangular part
+    int nnz       = 0;
+    row_offset[0] = 0;
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(this->mat_.col[aj] < ai)
             {
-                break;
+                col[nnz] = this->mat_.col[aj];
+                val[nnz] = this->mat_.val[aj];
+                ++nnz;
             }
         }
 
-        // set diagonal pointer to diagonal element
-        diag_offset[ai] = j;
-
-        // clear nnz entries
-        for(j = row_start; j < row_end; ++j)
-        {
-            nnz_entries[this->mat_.col[j]] = 0;
-        }
+        row_offset[ai + 1] = nnz;
     }
 
-    free_host(&diag_offset);
-    free_host(&nnz_entries);
+    cast_L->Clear();
+    cast_L->SetDataPtrCSR(&row_offset, &col, &val, nnz_L, this->nrow_, this->ncol_);
 
     return true;
 }
 
-// Algorithm for ILUT factorization is based on
-// Y. Saad, Iterative methods for sparse linear systems, 2nd edition, SIAM
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ILUTFactorize(double t, int maxrow)
+bool HostMatrixCSR<ValueType>::ExtractLDiagonal(BaseMatrix<ValueType>* L) const
 {
-    assert(this->nrow_ == this->ncol_);
-    assert(this->nnz_ > 0);
+    assert(L != NULL);
 
-    int nrow = this->nrow_;
-    int ncol = this->ncol_;
+    assert(this->nrow_ > 0);
+    assert(this->ncol_ > 0);
 
-    int* row_offset  = NULL;
-    int* diag_offset = NULL;
-    int* nnz_entries = NULL;
-    bool* nnz_pos    = (bool*)malloc(nrow * sizeof(bool));
-    ValueType* w     = NULL;
+    HostMatrixCSR<ValueType>* cast_L = dynamic_cast<HostMatrixCSR<ValueType>*>(L);
 
-    allocate_host(nrow + 1, &row_offset);
-    allocate_host(nrow, &diag_offset);
-    allocate_host(nrow, &nnz_entries);
-    allocate_host(nrow, &w);
+    assert(cast_L != NULL);
 
-    for(int i = 0; i < nrow; ++i)
+    // count nnz of lower triangular part
+    int nnz_L = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : nnz_L)
+#endif
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        w[i]           = 0.0;
-        nnz_entries[i] = -1;
-        nnz_pos[i]     = false;
-        diag_offset[i] = 0;
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(this->mat_.col[aj] <= ai)
+            {
+                ++nnz_L;
+            }
+        }
     }
 
-    // pre-allocate 1.5x nnz arrays for preconditioner matrix
-    int nnzA       = this->nnz_;
-    int alloc_size = int(nnzA * 1.5);
-    int* col       = (int*)malloc(alloc_size * sizeof(int));
-    ValueType* val = (ValueType*)malloc(alloc_size * sizeof(ValueType));
+    // allocate lower triangular part structure
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
 
-    // initialize row_offset
-    row_offset[0] = 0;
-    int nnz       = 0;
+    allocate_host(this->nrow_ + 1, &row_offset);
+    allocate_host(nnz_L, &col);
+    allocate_host(nnz_L, &val);
 
-    // loop over all rows
+    // fill lower triangular part
+    int nnz       = 0;
+    row_offset[0] = 0;
     for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        row_offset[ai + 1] = row_offset[ai];
-
-        int row_begin   = this->mat_.row_offset[ai];
-        int row_end     = this->mat_.row_offset[ai + 1];
-        double row_norm = 0.0;
-
-        // fill working array with ai-th row
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(this->mat_.col[aj] <= ai)
+            {
+                col[nnz] = this->mat_.col[aj];
+                val[nnz] = this->mat_.val[aj];
+                ++nnz;
+            }
+        }
+
+        row_offset[ai + 1] = nnz;
+    }
+
+    cast_L->Clear();
+    cast_L->SetDataPtrCSR(&row_offset, &col, &val, nnz_L, this->nrow_, this->ncol_);
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::LUSolve(const BaseVector<ValueType>& in,
+                                       BaseVector<ValueType>* out) const
+{
+    assert(in.GetSize() >= 0);
+    assert(out->GetSize() >= 0);
+    assert(in.GetSize() == this->ncol_);
+    assert(out->GetSize() == this->nrow_);
+
+    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+    assert(cast_in != NULL);
+    assert(cast_out != NULL);
+
+    // Solve L
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        cast_out->vec_[ai] = cast_in->vec_[ai];
+
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(this->mat_.col[aj] < ai)
+            {
+                // under the diagonal
+                cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+            }
+            else
+            {
+                // CSR should be sorted
+                break;
+            }
+        }
+    }
+
+    // last elements should be the diagonal one (last)
+    int diag_aj = this->nnz_ - 1;
+
+    // Solve U
+    for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+    {
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(this->mat_.col[aj] > ai)
+            {
+                // above the diagonal
+                cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+            }
+
+            if(this->mat_.col[aj] == ai)
+            {
+                diag_aj = aj;
+            }
+        }
+
+        cast_out->vec_[ai] /= this->mat_.val[diag_aj];
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+void HostMatrixCSR<ValueType>::LLAnalyse(void)
+{
+    // do nothing
+}
+
+template <typename ValueType>
+void HostMatrixCSR<ValueType>::LLAnalyseClear(void)
+{
+    // do nothing
+}
+
+template <typename ValueType>
+void HostMatrixCSR<ValueType>::LUAnalyse(void)
+{
+    // do nothing
+}
+
+template <typename ValueType>
+void HostMatrixCSR<ValueType>::LUAnalyseClear(void)
+{
+    // do nothing
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
+                                       BaseVector<ValueType>* out) const
+{
+    assert(in.GetSize() >= 0);
+    assert(out->GetSize() >= 0);
+    assert(in.GetSize() == this->ncol_);
+    assert(out->GetSize() == this->nrow_);
+
+    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+    assert(cast_in != NULL);
+    assert(cast_out != NULL);
+
+    // Solve L
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        ValueType value = cast_in->vec_[ai];
+        int diag_idx    = this->mat_.row_offset[ai + 1] - 1;
+
+        for(int aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+        {
+            value -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+        }
+
+        cast_out->vec_[ai] = value / this->mat_.val[diag_idx];
+    }
+
+    // Solve L^T
+    for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+    {
+        int diag_idx    = this->mat_.row_offset[ai + 1] - 1;
+        ValueType value = cast_out->vec_[ai] / this->mat_.val[diag_idx];
+
+        for(int aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+        {
+            cast_out->vec_[this->mat_.col[aj]] -= value * this->mat_.val[aj];
+        }
+
+        cast_out->vec_[ai] = value;
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::LLSolve(const BaseVector<ValueType>& in,
+                                       const BaseVector<ValueType>& inv_diag,
+                                       BaseVector<ValueType>* out) const
+{
+    assert(in.GetSize() >= 0);
+    assert(out->GetSize() >= 0);
+    assert(in.GetSize() == this->ncol_);
+    assert(out->GetSize() == this->nrow_);
+    assert(inv_diag.GetSize() == this->nrow_ || inv_diag.GetSize() == this->ncol_);
+
+    const HostVector<ValueType>* cast_in   = dynamic_cast<const HostVector<ValueType>*>(&in);
+    const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&inv_diag);
+    HostVector<ValueType>* cast_out        = dynamic_cast<HostVector<ValueType>*>(out);
+
+    assert(cast_in != NULL);
+    assert(cast_out != NULL);
+
+    // Solve L
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        ValueType value = cast_in->vec_[ai];
+        int diag_idx    = this->mat_.row_offset[ai + 1] - 1;
+
+        for(int aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+        {
+            value -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+        }
+
+        cast_out->vec_[ai] = value * cast_diag->vec_[ai];
+    }
+
+    // Solve L^T
+    for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+    {
+        int diag_idx    = this->mat_.row_offset[ai + 1] - 1;
+        ValueType value = cast_out->vec_[ai] * cast_diag->vec_[ai];
+
+        for(int aj = this->mat_.row_offset[ai]; aj < diag_idx; ++aj)
+        {
+            cast_out->vec_[this->mat_.col[aj]] -= value * this->mat_.val[aj];
+        }
+
+        cast_out->vec_[ai] = value;
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+void HostMatrixCSR<ValueType>::LAnalyse(bool diag_unit)
+{
+    this->L_diag_unit_ = diag_unit;
+}
+
+template <typename ValueType>
+void HostMatrixCSR<ValueType>::LAnalyseClear(void)
+{
+    // do nothing
+    this->L_diag_unit_ = true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::LSolve(const BaseVector<ValueType>& in,
+                                      BaseVector<ValueType>* out) const
+{
+    assert(in.GetSize() >= 0);
+    assert(out->GetSize() >= 0);
+    assert(in.GetSize() == this->ncol_);
+    assert(out->GetSize() == this->nrow_);
+
+    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+    assert(cast_in != NULL);
+    assert(cast_out != NULL);
+
+    int diag_aj = 0;
+
+    // Solve L
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        cast_out->vec_[ai] = cast_in->vec_[ai];
+
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(this->mat_.col[aj] < ai)
+            {
+                // under the diagonal
+                cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+            }
+            else
+            {
+                // CSR should be sorted
+                if(this->L_diag_unit_ == false)
+                {
+                    assert(this->mat_.col[aj] == ai);
+                    diag_aj = aj;
+                }
+                break;
+            }
+        }
+
+        if(this->L_diag_unit_ == false)
+        {
+            cast_out->vec_[ai] /= this->mat_.val[diag_aj];
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+void HostMatrixCSR<ValueType>::UAnalyse(bool diag_unit)
+{
+    this->U_diag_unit_ = diag_unit;
+}
+
+template <typename ValueType>
+void HostMatrixCSR<ValueType>::UAnalyseClear(void)
+{
+    // do nothing
+    this->U_diag_unit_ = false;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::USolve(const BaseVector<ValueType>& in,
+                                      BaseVector<ValueType>* out) const
+{
+    assert(in.GetSize() >= 0);
+    assert(out->GetSize() >= 0);
+    assert(in.GetSize() == this->ncol_);
+    assert(out->GetSize() == this->nrow_);
+
+    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+    assert(cast_in != NULL);
+    assert(cast_out != NULL);
+
+    // last elements should the diagonal one (last)
+    int diag_aj = this->nnz_ - 1;
+
+    // Solve U
+    for(int ai = this->nrow_ - 1; ai >= 0; --ai)
+    {
+        cast_out->vec_[ai] = cast_in->vec_[ai];
+
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(this->mat_.col[aj] > ai)
+            {
+                // above the diagonal
+                cast_out->vec_[ai] -= this->mat_.val[aj] * cast_out->vec_[this->mat_.col[aj]];
+            }
+
+            if(this->L_diag_unit_ == false)
+            {
+                if(this->mat_.col[aj] == ai)
+                {
+                    diag_aj = aj;
+                }
+            }
+        }
+
+        if(this->L_diag_unit_ == false)
+        {
+            cast_out->vec_[ai] /= this->mat_.val[diag_aj];
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::MultiColoredLSweep(int num_colors,
+                                                  const int* color_offsets,
+                                                  bool diag_unit,
+                                                  ValueType omega,
+                                                  BaseVector<ValueType>* x) const
+{
+    assert(num_colors >= 0);
+    assert(color_offsets != NULL);
+    assert(x != NULL);
+    assert(x->GetSize() == this->nrow_);
+    assert(this->nrow_ == this->ncol_);
+    assert(color_offsets[num_colors] == this->nrow_);
+
+    HostVector<ValueType>* cast_x = dynamic_cast<HostVector<ValueType>*>(x);
+
+    assert(cast_x != NULL);
+
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+    // All colors are processed within a single parallel region, the rows of a color are
+    // independent of each other and only depend on the previous colors
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        for(int c = 0; c < num_colors; ++c)
+        {
+            int begin = color_offsets[c];
+            int end   = color_offsets[c + 1];
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int ai = begin; ai < end; ++ai)
+            {
+                ValueType sum  = cast_x->vec_[ai];
+                ValueType diag = static_cast<ValueType>(1);
+
+                for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+                {
+                    int col = this->mat_.col[aj];
+
+                    if(col < begin)
+                    {
+                        sum -= this->mat_.val[aj] * cast_x->vec_[col];
+                    }
+                    else if(col == ai)
+                    {
+                        diag = this->mat_.val[aj];
+                    }
+                }
+
+                cast_x->vec_[ai] = (diag_unit == true) ? sum : sum / (omega * diag);
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::MultiColoredUSweep(int num_colors,
+                                                  const int* color_offsets,
+                                                  bool diag_unit,
+                                                  ValueType omega,
+                                                  BaseVector<ValueType>* x) const
+{
+    assert(num_colors >= 0);
+    assert(color_offsets != NULL);
+    assert(x != NULL);
+    assert(x->GetSize() == this->nrow_);
+    assert(this->nrow_ == this->ncol_);
+    assert(color_offsets[num_colors] == this->nrow_);
+
+    HostVector<ValueType>* cast_x = dynamic_cast<HostVector<ValueType>*>(x);
+
+    assert(cast_x != NULL);
+
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+    // All colors are processed within a single parallel region, the rows of a color are
+    // independent of each other and only depend on the subsequent colors
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        for(int c = num_colors - 1; c >= 0; --c)
+        {
+            int begin = color_offsets[c];
+            int end   = color_offsets[c + 1];
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int ai = begin; ai < end; ++ai)
+            {
+                ValueType sum  = cast_x->vec_[ai];
+                ValueType diag = static_cast<ValueType>(1);
+
+                for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+                {
+                    int col = this->mat_.col[aj];
+
+                    if(col >= end)
+                    {
+                        sum -= this->mat_.val[aj] * cast_x->vec_[col];
+                    }
+                    else if(col == ai)
+                    {
+                        diag = this->mat_.val[aj];
+                    }
+                }
+
+                cast_x->vec_[ai] = (diag_unit == true) ? sum : sum / (omega * diag);
+            }
+        }
+    }
+
+    return true;
+}
+
+// Algorithm for ILU factorization is based on
+// Y. Saad, Iterative methods for sparse linear systems, 2nd edition, SIAM
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::ILU0Factorize(void)
+{
+    assert(this->nrow_ == this->ncol_);
+    assert(this->nnz_ > 0);
+
+    // pointer of upper part of each row
+    int* diag_offset = NULL;
+    int* nnz_entries = NULL;
+
+    allocate_host(this->nrow_, &diag_offset);
+    allocate_host(this->nrow_, &nnz_entries);
+
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        nnz_entries[i] = 0;
+    }
+
+    // ai = 0 to N loop over all rows
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        // ai-th row entries
+        int row_start = this->mat_.row_offset[ai];
+        int row_end   = this->mat_.row_offset[ai + 1];
+        int j;
+
+        // nnz position of ai-th row in mat_.val array
+        for(j = row_start; j < row_end; ++j)
+        {
+            nnz_entries[this->mat_.col[j]] = j;
+        }
+
+        // loop over ai-th row nnz entries
+        for(j = row_start; j < row_end; ++j)
+        {
+            // if nnz entry is in lower matrix
+            if(this->mat_.col[j] < ai)
+            {
+                int col_j  = this->mat_.col[j];
+                int diag_j = diag_offset[col_j];
+
+                if(this->mat_.val[diag_j] != static_cast<ValueType>(0))
+                {
+                    // multiplication factor
+                    this->mat_.val[j] = this->mat_.val[j] / this->mat_.val[diag_j];
+
+                    // loop over upper offset pointer and do linear combination for nnz entry
+                    for(int k = diag_j + 1; k < this->mat_.row_offset[col_j + 1]; ++k)
+                    {
+                        // if nnz at this position do linear combination
+                        if(nnz_entries[this->mat_.col[k]] != 0)
+                        {
+                            this->mat_.val[nnz_entries[this->mat_.col[k]]] -=
+                                this->mat_.val[j] * this->mat_.val[k];
+                        }
+                    }
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        // set diagonal pointer to diagonal element
+        diag_offset[ai] = j;
+
+        // clear nnz entries
+        for(j = row_start; j < row_end; ++j)
+        {
+            nnz_entries[this->mat_.col[j]] = 0;
+        }
+    }
+
+    free_host(&diag_offset);
+    free_host(&nnz_entries);
+
+    return true;
+}
+
+// Algorithm for ILUT factorization is based on
+// Y. Saad, Iterative methods for sparse linear systems, 2nd edition, SIAM
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::ILUTFactorize(double t, int maxrow)
+{
+    assert(this->nrow_ == this->ncol_);
+    assert(this->nnz_ > 0);
+
+    int nrow = this->nrow_;
+    int ncol = this->ncol_;
+
+    int* row_offset  = NULL;
+    int* diag_offset = NULL;
+    int* nnz_entries = NULL;
+    bool* nnz_pos    = (bool*)malloc(nrow * sizeof(bool));
+    ValueType* w     = NULL;
+
+    allocate_host(nrow + 1, &row_offset);
+    allocate_host(nrow, &diag_offset);
+    allocate_host(nrow, &nnz_entries);
+    allocate_host(nrow, &w);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        w[i]           = 0.0;
+        nnz_entries[i] = -1;
+        nnz_pos[i]     = false;
+        diag_offset[i] = 0;
+    }
+
+    // pre-allocate 1.5x nnz arrays for preconditioner matrix
+    int nnzA       = this->nnz_;
+    int alloc_size = int(nnzA * 1.5);
+    int* col       = (int*)malloc(alloc_size * sizeof(int));
+    ValueType* val = (ValueType*)malloc(alloc_size * sizeof(ValueType));
+
+    // initialize row_offset
+    row_offset[0] = 0;
+    int nnz       = 0;
+
+    // loop over all rows
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        row_offset[ai + 1] = row_offset[ai];
+
+        int row_begin   = this->mat_.row_offset[ai];
+        int row_end     = this->mat_.row_offset[ai + 1];
+        double row_norm = 0.0;
+
+        // fill working array with ai-th row
         int m = 0;
         for(int aj = row_begin; aj < row_end; ++aj)
         {
-            int idx        = this->mat_.col[aj];
-            w[idx]         = this->mat_.val[aj];
-            nnz_entries[m] = idx;
-            nnz_pos[idx]   = true;
+            int idx        = this->mat_.col[aj];
+            w[idx]         = this->mat_.val[aj];
+            nnz_entries[m] = idx;
+            nnz_pos[idx]   = true;
+
+            row_norm += rocalution_abs(this->mat_.val[aj]);
+            ++m;
+        }
+
+        // threshold for dropping strategy
+        double threshold = t * row_norm / (row_end - row_begin);
+
+        for(int k = 0; k < nrow; ++k)
+        {
+            if(nnz_entries[k] == -1)
+            {
+                break;
+            }
+
+            int aj = nnz_entries[k];
+
+            // get smallest column index
+            int sidx = k;
+            for(int j = k + 1; j < nrow; ++j)
+            {
+                if(nnz_entries[j] == -1)
+                {
+                    break;
+                }
+
+                if(nnz_entries[j] < aj)
+                {
+                    sidx = j;
+                    aj   = nnz_entries[j];
+                }
+            }
+
+            aj = nnz_entries[k];
+
+            // swap column index
+            if(k != sidx)
+            {
+                nnz_entries[k]    = nnz_entries[sidx];
+                nnz_entries[sidx] = aj;
+                aj                = nnz_entries[k];
+            }
+
+            // lower matrix part
+            if(aj < ai)
+            {
+                // if zero diagonal entry do nothing
+                if(val[diag_offset[aj]] == static_cast<ValueType>(0))
+                {
+                    LOG_INFO("(ILUT) zero row");
+                    continue;
+                }
+
+                w[aj] /= val[diag_offset[aj]];
+
+                // do linear combination with previous row
+                for(int l = diag_offset[aj] + 1; l < row_offset[aj + 1]; ++l)
+                {
+                    int idx          = col[l];
+                    ValueType fillin = w[aj] * val[l];
+
+                    // drop off strategy for fill in
+                    if(nnz_pos[idx] == false)
+                    {
+                        if(rocalution_abs(fillin) >= threshold)
+                        {
+                            nnz_entries[m] = idx;
+                            nnz_pos[idx]   = true;
+                            w[idx] -= fillin;
+                            ++m;
+                        }
+                    }
+                    else
+                    {
+                        w[idx] -= fillin;
+                    }
+                }
+            }
+        }
+
+        // fill ai-th row of preconditioner matrix
+        for(int k = 0, num_lower = 0, num_upper = 0; k < nrow; ++k)
+        {
+            int aj = nnz_entries[k];
+
+            if(aj == -1)
+            {
+                break;
+            }
+
+            if(nnz_pos[aj] == false)
+            {
+                break;
+            }
+
+            // lower part
+            if(aj < ai && num_lower < maxrow)
+            {
+                val[nnz] = w[aj];
+                col[nnz] = aj;
+
+                ++row_offset[ai + 1];
+                ++num_lower;
+                ++nnz;
+
+                // upper part
+            }
+            else if(aj > ai && num_upper < maxrow)
+            {
+                val[nnz] = w[aj];
+                col[nnz] = aj;
+
+                ++row_offset[ai + 1];
+                ++num_upper;
+                ++nnz;
+
+                // diagonal part
+            }
+            else if(aj == ai)
+            {
+                val[nnz] = w[aj];
+                col[nnz] = aj;
+
+                diag_offset[ai] = row_offset[ai + 1];
+
+                ++row_offset[ai + 1];
+                ++nnz;
+            }
+
+            // clear working arrays
+            w[aj]          = static_cast<ValueType>(0);
+            nnz_entries[k] = -1;
+            nnz_pos[aj]    = false;
+        }
+
+        // resize preconditioner matrix if needed
+        if(alloc_size < nnz + 2 * maxrow + 1)
+        {
+            alloc_size += int(nnzA * 1.5);
+            col = (int*)realloc(col, alloc_size * sizeof(int));
+            val = (ValueType*)realloc(val, alloc_size * sizeof(ValueType));
+        }
+    }
+
+    //  col = (int*) realloc(col, nnz*sizeof(int));
+    //  val = (ValueType*) realloc(val, nnz*sizeof(ValueType));
+
+    free_host(&w);
+    free_host(&diag_offset);
+    free_host(&nnz_entries);
+    free(nnz_pos);
+
+    // pinned memory
+    int* p_col       = NULL;
+    ValueType* p_val = NULL;
+
+    allocate_host(nnz, &p_col);
+    allocate_host(nnz, &p_val);
+
+    for(int i = 0; i < nnz; ++i)
+    {
+        p_col[i] = col[i];
+        p_val[i] = val[i];
+    }
+
+    free(col);
+    free(val);
+
+    this->Clear();
+    this->SetDataPtrCSR(&row_offset, &p_col, &p_val, nnz, nrow, ncol);
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::ICFactorize(BaseVector<ValueType>* inv_diag)
+{
+    assert(this->nrow_ == this->ncol_);
+    assert(this->nnz_ > 0);
+
+    assert(inv_diag != NULL);
+    HostVector<ValueType>* cast_diag = dynamic_cast<HostVector<ValueType>*>(inv_diag);
+    assert(cast_diag != NULL);
+
+    cast_diag->Allocate(this->nrow_);
+
+    // i=0,..n
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        // j=0,..i
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        {
+            // k=0,..j-1
+            for(int k = this->mat_.row_offset[i]; k < j; ++k)
+            {
+                // loop through j-th row to find matching k
+                for(int l = this->mat_.row_offset[this->mat_.col[j]];
+                    l < this->mat_.row_offset[this->mat_.col[j] + 1];
+                    ++l)
+                {
+                    if(this->mat_.col[l] == this->mat_.col[k])
+                    {
+                        this->mat_.val[j] -= this->mat_.val[k] * this->mat_.val[l];
+                        break;
+                    }
+                }
+            }
+
+            if(i > this->mat_.col[j])
+            {
+                // Fill lower part
+                this->mat_.val[j] /=
+                    this->mat_.val[this->mat_.row_offset[this->mat_.col[j] + 1] - 1];
+            }
+            else if(this->mat_.val[j] > static_cast<ValueType>(0))
+            {
+                // Fill diagonal part
+                this->mat_.val[j]  = sqrt(this->mat_.val[j]);
+                cast_diag->vec_[i] = static_cast<ValueType>(1) / this->mat_.val[j];
+            }
+            else
+            {
+                LOG_INFO("IC breakdown");
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::MultiColoring(int& num_colors,
+                                             int** size_colors,
+                                             BaseVector<int>* permutation) const
+{
+    assert(*size_colors == NULL);
+    assert(permutation != NULL);
+    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+    assert(cast_perm != NULL);
+
+    // node colors (init value = 0 i.e. no color)
+    int* color = NULL;
+    allocate_host(this->nrow_, &color);
+
+    memset(color, 0, sizeof(int) * this->nrow_);
+    num_colors = 0;
+    std::vector<bool> row_col;
+
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        color[ai] = 1;
+        row_col.clear();
+        row_col.reserve(num_colors + 2);
+        row_col.assign(num_colors + 2, false);
+
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(ai != this->mat_.col[aj])
+            {
+                row_col[color[this->mat_.col[aj]]] = true;
+            }
+        }
+
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(row_col[color[ai]] == true)
+            {
+                ++color[ai];
+            }
+        }
+
+        if(color[ai] > num_colors)
+        {
+            num_colors = color[ai];
+        }
+    }
+
+    allocate_host(num_colors, size_colors);
+    set_to_zero_host(num_colors, *size_colors);
+
+    int* offsets_color = NULL;
+    allocate_host(num_colors, &offsets_color);
+    memset(offsets_color, 0, sizeof(int) * num_colors);
+
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        ++(*size_colors)[color[i] - 1];
+    }
+
+    int total = 0;
+    for(int i = 1; i < num_colors; ++i)
+    {
+        total += (*size_colors)[i - 1];
+        offsets_color[i] = total;
+        //   LOG_INFO("offsets = " << total);
+    }
+
+    cast_perm->Allocate(this->nrow_);
+
+    for(int i = 0; i < permutation->GetSize(); ++i)
+    {
+        cast_perm->vec_[i] = offsets_color[color[i] - 1];
+        ++offsets_color[color[i] - 1];
+    }
+
+    free_host(&color);
+    free_host(&offsets_color);
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::MaximalIndependentSet(int& size, BaseVector<int>* permutation) const
+{
+    assert(permutation != NULL);
+    assert(this->nrow_ == this->ncol_);
+
+    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+    assert(cast_perm != NULL);
+
+    int* mis = NULL;
+    allocate_host(this->nrow_, &mis);
+    memset(mis, 0, sizeof(int) * this->nrow_);
+
+    size = 0;
+
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        if(mis[ai] == 0)
+        {
+            // set the node
+            mis[ai] = 1;
+            ++size;
+
+            // remove all nbh nodes (without diagonal)
+            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            {
+                if(ai != this->mat_.col[aj])
+                {
+                    mis[this->mat_.col[aj]] = -1;
+                }
+            }
+        }
+    }
+
+    cast_perm->Allocate(this->nrow_);
+
+    int pos = 0;
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        if(mis[ai] == 1)
+        {
+            cast_perm->vec_[ai] = pos;
+            ++pos;
+        }
+        else
+        {
+            cast_perm->vec_[ai] = size + ai - pos;
+        }
+    }
+
+    // Check the permutation
+    //
+    //  for (int ai=0; ai<this->nrow_; ++ai) {
+    //    assert( cast_perm->vec_[ai] >= 0 );
+    //    assert( cast_perm->vec_[ai] < this->nrow_ );
+    //  }
+
+    free_host(&mis);
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::ZeroBlockPermutation(int& size, BaseVector<int>* permutation) const
+{
+    assert(permutation != NULL);
+    assert(permutation->GetSize() == this->nrow_);
+    assert(permutation->GetSize() == this->ncol_);
+
+    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+    assert(cast_perm != NULL);
+
+    size = 0;
+
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(ai == this->mat_.col[aj])
+            {
+                ++size;
+            }
+        }
+    }
+
+    int k_z  = size;
+    int k_nz = 0;
+
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        bool hit = false;
+
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            if(ai == this->mat_.col[aj])
+            {
+                cast_perm->vec_[ai] = k_nz;
+                ++k_nz;
+                hit = true;
+            }
+        }
+
+        if(hit == false)
+        {
+            cast_perm->vec_[ai] = k_z;
+            ++k_z;
+        }
+    }
+
+    return true;
+}
+
+// following R.E.Bank and C.C.Douglas paper
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::SymbolicMatMatMult(const BaseMatrix<ValueType>& src)
+{
+    const HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<const HostMatrixCSR<ValueType>*>(&src);
+
+    assert(cast_mat != NULL);
+    assert(this->ncol_ == cast_mat->nrow_);
+
+    std::vector<int> row_offset;
+    std::vector<int>* new_col = new std::vector<int>[this->nrow_];
+
+    row_offset.resize(this->nrow_ + 1);
+
+    row_offset[0] = 0;
+
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        // loop over the row
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        {
+            int ii = this->mat_.col[j];
+
+            // loop corresponding row
+            for(int k = cast_mat->mat_.row_offset[ii]; k < cast_mat->mat_.row_offset[ii + 1]; ++k)
+            {
+                new_col[i].push_back(cast_mat->mat_.col[k]);
+            }
+        }
+
+        std::sort(new_col[i].begin(), new_col[i].end());
+        new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
+
+        row_offset[i + 1] = int(new_col[i].size());
+    }
+
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        row_offset[i + 1] += row_offset[i];
+    }
+
+    this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < this->nrow_ + 1; ++i)
+    {
+        this->mat_.row_offset[i] = row_offset[i];
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        int jj = 0;
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        {
+            this->mat_.col[j] = new_col[i][jj];
+            ++jj;
+        }
+    }
+
+    //#ifdef _OPENMP
+    //#pragma omp parallel for
+    //#endif
+    //  for (unsigned int i=0; i<this->nnz_; ++i)
+    //    this->mat_.val[i] = static_cast<ValueType>(1);
+
+    delete[] new_col;
+
+    return true;
+}
 
-            row_norm += rocalution_abs(this->mat_.val[aj]);
-            ++m;
-        }
+// ----------------------------------------------------------
+// original function prod(const spmat1 &A, const spmat2 &B)
+// ----------------------------------------------------------
+// Modified and adapted from AMGCL,
+// https://github.com/ddemidov/amgcl
+// MIT License
+// ----------------------------------------------------------
+// CHANGELOG
+// - adapted interface
+// sorting is added
+// ----------------------------------------------------------
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::MatMatMult(const BaseMatrix<ValueType>& A,
+                                          const BaseMatrix<ValueType>& B)
+{
+    assert((this != &A) && (this != &B));
 
-        // threshold for dropping strategy
-        double threshold = t * row_norm / (row_end - row_begin);
+    //  this->SymbolicMatMatMult(A, B);
+    //  this->NumericMatMatMult (A, B);
+    //
+    //  return true;
 
-        for(int k = 0; k < nrow; ++k)
-        {
-            if(nnz_entries[k] == -1)
-            {
-                break;
-            }
+    const HostMatrixCSR<ValueType>* cast_mat_A = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+    const HostMatrixCSR<ValueType>* cast_mat_B = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
 
-            int aj = nnz_entries[k];
+    assert(cast_mat_A != NULL);
+    assert(cast_mat_B != NULL);
+    assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
 
-            // get smallest column index
-            int sidx = k;
-            for(int j = k + 1; j < nrow; ++j)
+    int n = cast_mat_A->nrow_;
+    int m = cast_mat_B->ncol_;
+
+    int* row_offset = NULL;
+    allocate_host(n + 1, &row_offset);
+    int* col       = NULL;
+    ValueType* val = NULL;
+
+    for(int i = 0; i < n + 1; ++i)
+    {
+        row_offset[i] = 0;
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> marker(m, -1);
+
+#ifdef _OPENMP
+        int nt  = omp_get_num_threads();
+        int tid = omp_get_thread_num();
+
+        int chunk_size  = (n + nt - 1) / nt;
+        int chunk_start = tid * chunk_size;
+        int chunk_end   = std::min(n, chunk_start + chunk_size);
+#else
+        int chunk_start = 0;
+        int chunk_end   = n;
+#endif
+
+        for(int ia = chunk_start; ia < chunk_end; ++ia)
+        {
+            for(int ja = cast_mat_A->mat_.row_offset[ia], ea = cast_mat_A->mat_.row_offset[ia + 1];
+                ja < ea;
+                ++ja)
             {
-                if(nnz_entries[j] == -1)
+                int ca = cast_mat_A->mat_.col[ja];
+                for(int jb = cast_mat_B->mat_.row_offset[ca],
+                        eb = cast_mat_B->mat_.row_offset[ca + 1];
+                    jb < eb;
+                    ++jb)
                 {
-                    break;
-                }
+                    int cb = cast_mat_B->mat_.col[jb];
 
-                if(nnz_entries[j] < aj)
-                {
-                    sidx = j;
-                    aj   = nnz_entries[j];
+                    if(marker[cb] != ia)
+                    {
+                        marker[cb] = ia;
+                        ++row_offset[ia + 1];
+                    }
                 }
             }
+        }
 
-            aj = nnz_entries[k];
+        std::fill(marker.begin(), marker.end(), -1);
 
-            // swap column index
-            if(k != sidx)
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+#ifdef _OPENMP
+#pragma omp single
+#endif
+        {
+            for(int i = 1; i < n + 1; ++i)
             {
-                nnz_entries[k]    = nnz_entries[sidx];
-                nnz_entries[sidx] = aj;
-                aj                = nnz_entries[k];
+                row_offset[i] += row_offset[i - 1];
             }
 
-            // lower matrix part
-            if(aj < ai)
-            {
-                // if zero diagonal entry do nothing
-                if(val[diag_offset[aj]] == static_cast<ValueType>(0))
-                {
-                    LOG_INFO("(ILUT) zero row");
-                    continue;
-                }
+            allocate_host(row_offset[n], &col);
+            allocate_host(row_offset[n], &val);
+        }
 
-                w[aj] /= val[diag_offset[aj]];
+        for(int ia = chunk_start; ia < chunk_end; ++ia)
+        {
+            int row_begin = row_offset[ia];
+            int row_end   = row_begin;
 
-                // do linear combination with previous row
-                for(int l = diag_offset[aj] + 1; l < row_offset[aj + 1]; ++l)
+            for(int ja = cast_mat_A->mat_.row_offset[ia], ea = cast_mat_A->mat_.row_offset[ia + 1];
+                ja < ea;
+                ++ja)
+            {
+                int ca       = cast_mat_A->mat_.col[ja];
+                ValueType va = cast_mat_A->mat_.val[ja];
+
+                for(int jb = cast_mat_B->mat_.row_offset[ca],
+                        eb = cast_mat_B->mat_.row_offset[ca + 1];
+                    jb < eb;
+                    ++jb)
                 {
-                    int idx          = col[l];
-                    ValueType fillin = w[aj] * val[l];
+                    int cb       = cast_mat_B->mat_.col[jb];
+                    ValueType vb = cast_mat_B->mat_.val[jb];
 
-                    // drop off strategy for fill in
-                    if(nnz_pos[idx] == false)
+                    if(marker[cb] < row_begin)
                     {
-                        if(rocalution_abs(fillin) >= threshold)
-                        {
-                            nnz_entries[m] = idx;
-                            nnz_pos[idx]   = true;
-                            w[idx] -= fillin;
-                            ++m;
-                        }
+                        marker[cb]   = row_end;
+                        col[row_end] = cb;
+                        val[row_end] = va * vb;
+                        ++row_end;
                     }
                     else
                     {
-                        w[idx] -= fillin;
+                        val[marker[cb]] += va * vb;
                     }
                 }
             }
         }
+    }
 
-        // fill ai-th row of preconditioner matrix
-        for(int k = 0, num_lower = 0, num_upper = 0; k < nrow; ++k)
-        {
-            int aj = nnz_entries[k];
+    this->SetDataPtrCSR(
+        &row_offset, &col, &val, row_offset[n], cast_mat_A->nrow_, cast_mat_B->ncol_);
 
-            if(aj == -1)
-            {
-                break;
-            }
+// Sorting the col (per row)
+// Bubble sort algorithm
 
-            if(nnz_pos[aj] == false)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        {
+            for(int jj = this->mat_.row_offset[i]; jj < this->mat_.row_offset[i + 1] - 1; ++jj)
             {
-                break;
+                if(this->mat_.col[jj] > this->mat_.col[jj + 1])
+                {
+                    // swap elements
+                    int ind       = this->mat_.col[jj];
+                    ValueType val = this->mat_.val[jj];
+
+                    this->mat_.col[jj] = this->mat_.col[jj + 1];
+                    this->mat_.val[jj] = this->mat_.val[jj + 1];
+
+                    this->mat_.col[jj + 1] = ind;
+                    this->mat_.val[jj + 1] = val;
+                }
             }
+        }
+    }
 
-            // lower part
-            if(aj < ai && num_lower < maxrow)
-            {
-                val[nnz] = w[aj];
-                col[nnz] = aj;
+    return true;
+}
 
-                ++row_offset[ai + 1];
-                ++num_lower;
-                ++nnz;
+// following R.E.Bank and C.C.Douglas paper
+// this = A * B
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::SymbolicMatMatMult(const BaseMatrix<ValueType>& A,
+                                                  const BaseMatrix<ValueType>& B)
+{
+    const HostMatrixCSR<ValueType>* cast_mat_A = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+    const HostMatrixCSR<ValueType>* cast_mat_B = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
 
-                // upper part
-            }
-            else if(aj > ai && num_upper < maxrow)
-            {
-                val[nnz] = w[aj];
-                col[nnz] = aj;
+    assert(cast_mat_A != NULL);
+    assert(cast_mat_B != NULL);
+    assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
 
-                ++row_offset[ai + 1];
-                ++num_upper;
-                ++nnz;
+    std::vector<int> row_offset;
+    std::vector<int>* new_col = new std::vector<int>[cast_mat_A->nrow_];
 
-                // diagonal part
-            }
-            else if(aj == ai)
-            {
-                val[nnz] = w[aj];
-                col[nnz] = aj;
+    row_offset.resize(cast_mat_A->nrow_ + 1);
 
-                diag_offset[ai] = row_offset[ai + 1];
+    row_offset[0] = 0;
 
-                ++row_offset[ai + 1];
-                ++nnz;
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < cast_mat_A->nrow_; ++i)
+    {
+        // loop over the row
+        for(int j = cast_mat_A->mat_.row_offset[i]; j < cast_mat_A->mat_.row_offset[i + 1]; ++j)
+        {
+            int ii = cast_mat_A->mat_.col[j];
+            //      new_col[i].push_back(ii);
+
+            // loop corresponding row
+            for(int k = cast_mat_B->mat_.row_offset[ii]; k < cast_mat_B->mat_.row_offset[ii + 1];
+                ++k)
+            {
+                new_col[i].push_back(cast_mat_B->mat_.col[k]);
             }
-
-            // clear working arrays
-            w[aj]          = static_cast<ValueType>(0);
-            nnz_entries[k] = -1;
-            nnz_pos[aj]    = false;
         }
 
-        // resize preconditioner matrix if needed
-        if(alloc_size < nnz + 2 * maxrow + 1)
-        {
-            alloc_size += int(nnzA * 1.5);
-            col = (int*)realloc(col, alloc_size * sizeof(int));
-            val = (ValueType*)realloc(val, alloc_size * sizeof(ValueType));
-        }
-    }
+        std::sort(new_col[i].begin(), new_col[i].end());
+        new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
 
-    //  col = (int*) realloc(col, nnz*sizeof(int));
-    //  val = (ValueType*) realloc(val, nnz*sizeof(ValueType));
+        row_offset[i + 1] = int(new_col[i].size());
+    }
 
-    free_host(&w);
-    free_host(&diag_offset);
-    free_host(&nnz_entries);
-    free(nnz_pos);
+    for(int i = 0; i < cast_mat_A->nrow_; ++i)
+    {
+        row_offset[i + 1] += row_offset[i];
+    }
 
-    // pinned memory
-    int* p_col       = NULL;
-    ValueType* p_val = NULL;
+    this->AllocateCSR(row_offset[cast_mat_A->nrow_], cast_mat_A->nrow_, cast_mat_B->ncol_);
 
-    allocate_host(nnz, &p_col);
-    allocate_host(nnz, &p_val);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < cast_mat_A->nrow_ + 1; ++i)
+    {
+        this->mat_.row_offset[i] = row_offset[i];
+    }
 
-    for(int i = 0; i < nnz; ++i)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < cast_mat_A->nrow_; ++i)
     {
-        p_col[i] = col[i];
-        p_val[i] = val[i];
+        int jj = 0;
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        {
+            this->mat_.col[j] = new_col[i][jj];
+            ++jj;
+        }
     }
 
-    free(col);
-    free(val);
+    //#ifdef _OPENMP
+    //#pragma omp parallel for
+    //#endif
+    //      for (unsigned int i=0; i<this->nnz_; ++i)
+    //      this->mat_.val[i] = static_cast<ValueType>(1);
 
-    this->Clear();
-    this->SetDataPtrCSR(&row_offset, &p_col, &p_val, nnz, nrow, ncol);
+    delete[] new_col;
 
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ICFactorize(BaseVector<ValueType>* inv_diag)
+bool HostMatrixCSR<ValueType>::NumericMatMatMult(const BaseMatrix<ValueType>& A,
+                                                 const BaseMatrix<ValueType>& B)
 {
-    assert(this->nrow_ == this->ncol_);
-    assert(this->nnz_ > 0);
+    const HostMatrixCSR<ValueType>* cast_mat_A = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
+    const HostMatrixCSR<ValueType>* cast_mat_B = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
 
-    assert(inv_diag != NULL);
-    HostVector<ValueType>* cast_diag = dynamic_cast<HostVector<ValueType>*>(inv_diag);
-    assert(cast_diag != NULL);
+    assert(cast_mat_A != NULL);
+    assert(cast_mat_B != NULL);
+    assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
+    assert(this->nrow_ == cast_mat_A->nrow_);
+    assert(this->ncol_ == cast_mat_B->ncol_);
 
-    cast_diag->Allocate(this->nrow_);
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-    // i=0,..n
-    for(int i = 0; i < this->nrow_; ++i)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < cast_mat_A->nrow_; ++i)
     {
-        // j=0,..i
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        // loop over the row
+        for(int j = cast_mat_A->mat_.row_offset[i]; j < cast_mat_A->mat_.row_offset[i + 1]; ++j)
         {
-            // k=0,..j-1
-            for(int k = this->mat_.row_offset[i]; k < j; ++k)
+            int ii = cast_mat_A->mat_.col[j];
+
+            // loop corresponding row
+            for(int k = cast_mat_B->mat_.row_offset[ii]; k < cast_mat_B->mat_.row_offset[ii + 1];
+                ++k)
             {
-                // loop through j-th row to find matching k
-                for(int l = this->mat_.row_offset[this->mat_.col[j]];
-                    l < this->mat_.row_offset[this->mat_.col[j] + 1];
-                    ++l)
+                for(int p = this->mat_.row_offset[i]; p < this->mat_.row_offset[i + 1]; ++p)
                 {
-                    if(this->mat_.col[l] == this->mat_.col[k])
+                    if(cast_mat_B->mat_.col[k] == this->mat_.col[p])
                     {
-                        this->mat_.val[j] -= this->mat_.val[k] * this->mat_.val[l];
+                        this->mat_.val[p] += cast_mat_B->mat_.val[k] * cast_mat_A->mat_.val[j];
                         break;
                     }
                 }
             }
-
-            if(i > this->mat_.col[j])
-            {
-                // Fill lower part
-                this->mat_.val[j] /=
-                    this->mat_.val[this->mat_.row_offset[this->mat_.col[j] + 1] - 1];
-            }
-            else if(this->mat_.val[j] > static_cast<ValueType>(0))
-            {
-                // Fill diagonal part
-                this->mat_.val[j]  = sqrt(this->mat_.val[j]);
-                cast_diag->vec_[i] = static_cast<ValueType>(1) / this->mat_.val[j];
-            }
-            else
-            {
-                LOG_INFO("IC breakdown");
-                FATAL_ERROR(__FILE__, __LINE__);
-            }
         }
     }
 
@@ -1857,442 +3242,488 @@ bool HostMatrixCSR<ValueType>::ICFactorize(BaseVector<ValueType>* inv_diag)
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::MultiColoring(int& num_colors,
-                                             int** size_colors,
-                                             BaseVector<int>* permutation) const
+bool HostMatrixCSR<ValueType>::SymbolicPower(int p)
 {
-    assert(*size_colors == NULL);
-    assert(permutation != NULL);
-    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-    assert(cast_perm != NULL);
+    assert(p > 1);
 
-    // node colors (init value = 0 i.e. no color)
-    int* color = NULL;
-    allocate_host(this->nrow_, &color);
+    // The optimal values for the firsts values
 
-    memset(color, 0, sizeof(int) * this->nrow_);
-    num_colors = 0;
-    std::vector<bool> row_col;
+    if(p == 2)
+    {
+        this->SymbolicMatMatMult(*this);
+    }
 
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    if(p == 3)
     {
-        color[ai] = 1;
-        row_col.clear();
-        row_col.reserve(num_colors + 2);
-        row_col.assign(num_colors + 2, false);
+        HostMatrixCSR<ValueType> tmp(this->local_backend_);
+        tmp.CopyFrom(*this);
 
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-        {
-            if(ai != this->mat_.col[aj])
-            {
-                row_col[color[this->mat_.col[aj]]] = true;
-            }
-        }
+        this->SymbolicPower(2);
+        this->SymbolicMatMatMult(tmp);
+    }
 
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+    if(p == 4)
+    {
+        this->SymbolicPower(2);
+        this->SymbolicPower(2);
+    }
+
+    if(p == 5)
+    {
+        HostMatrixCSR<ValueType> tmp(this->local_backend_);
+        tmp.CopyFrom(*this);
+
+        this->SymbolicPower(4);
+        this->SymbolicMatMatMult(tmp);
+    }
+
+    if(p == 6)
+    {
+        this->SymbolicPower(2);
+        this->SymbolicPower(3);
+    }
+
+    if(p == 7)
+    {
+        HostMatrixCSR<ValueType> tmp(this->local_backend_);
+        tmp.CopyFrom(*this);
+
+        this->SymbolicPower(6);
+        this->SymbolicMatMatMult(tmp);
+    }
+
+    if(p == 8)
+    {
+        HostMatrixCSR<ValueType> tmp(this->local_backend_);
+        tmp.CopyFrom(*this);
+
+        this->SymbolicPower(6);
+        tmp.SymbolicPower(2);
+
+        this->SymbolicMatMatMult(tmp);
+    }
+
+    if(p > 8)
+    {
+        HostMatrixCSR<ValueType> tmp(this->local_backend_);
+        tmp.CopyFrom(*this);
+
+        for(int i = 0; i < p; ++i)
         {
-            if(row_col[color[ai]] == true)
-            {
-                ++color[ai];
-            }
+            this->SymbolicMatMatMult(tmp);
         }
+    }
 
-        if(color[ai] > num_colors)
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::ILUpFactorizeNumeric(int p, const BaseMatrix<ValueType>& mat)
+{
+    const HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
+
+    assert(cast_mat != NULL);
+    assert(cast_mat->nrow_ == this->nrow_);
+    assert(cast_mat->ncol_ == this->ncol_);
+    assert(this->nnz_ > 0);
+    assert(cast_mat->nnz_ > 0);
+
+    int* row_offset = NULL;
+    int* ind_diag   = NULL;
+    int* levels     = NULL;
+    ValueType* val  = NULL;
+
+    allocate_host(cast_mat->nrow_ + 1, &row_offset);
+    allocate_host(cast_mat->nrow_, &ind_diag);
+    allocate_host(cast_mat->nnz_, &levels);
+    allocate_host(cast_mat->nnz_, &val);
+
+    int inf_level = 99999;
+    int nnz       = 0;
+
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+// find diagonals
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int ai = 0; ai < cast_mat->nrow_; ++ai)
+    {
+        for(int aj = cast_mat->mat_.row_offset[ai]; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
         {
-            num_colors = color[ai];
+            if(ai == cast_mat->mat_.col[aj])
+            {
+                ind_diag[ai] = aj;
+                break;
+            }
         }
     }
 
-    allocate_host(num_colors, size_colors);
-    set_to_zero_host(num_colors, *size_colors);
-
-    int* offsets_color = NULL;
-    allocate_host(num_colors, &offsets_color);
-    memset(offsets_color, 0, sizeof(int) * num_colors);
-
-    for(int i = 0; i < this->nrow_; ++i)
+// init row_offset
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < cast_mat->nrow_ + 1; ++i)
     {
-        ++(*size_colors)[color[i] - 1];
+        row_offset[i] = 0;
     }
 
-    int total = 0;
-    for(int i = 1; i < num_colors; ++i)
+// init inf levels
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < cast_mat->nnz_; ++i)
     {
-        total += (*size_colors)[i - 1];
-        offsets_color[i] = total;
-        //   LOG_INFO("offsets = " << total);
+        levels[i] = inf_level;
     }
 
-    cast_perm->Allocate(this->nrow_);
-
-    for(int i = 0; i < permutation->GetSize(); ++i)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < cast_mat->nnz_; ++i)
     {
-        cast_perm->vec_[i] = offsets_color[color[i] - 1];
-        ++offsets_color[color[i] - 1];
+        val[i] = static_cast<ValueType>(0);
     }
 
-    free_host(&color);
-    free_host(&offsets_color);
-
-    return true;
-}
-
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::MaximalIndependentSet(int& size, BaseVector<int>* permutation) const
-{
-    assert(permutation != NULL);
-    assert(this->nrow_ == this->ncol_);
-
-    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-    assert(cast_perm != NULL);
-
-    int* mis = NULL;
-    allocate_host(this->nrow_, &mis);
-    memset(mis, 0, sizeof(int) * this->nrow_);
-
-    size = 0;
-
-    for(int ai = 0; ai < this->nrow_; ++ai)
+// fill levels and values
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int ai = 0; ai < cast_mat->nrow_; ++ai)
     {
-        if(mis[ai] == 0)
+        for(int aj = cast_mat->mat_.row_offset[ai]; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
         {
-            // set the node
-            mis[ai] = 1;
-            ++size;
-
-            // remove all nbh nodes (without diagonal)
-            for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+            for(int ajj = this->mat_.row_offset[ai]; ajj < this->mat_.row_offset[ai + 1]; ++ajj)
             {
-                if(ai != this->mat_.col[aj])
+                if(cast_mat->mat_.col[aj] == this->mat_.col[ajj])
                 {
-                    mis[this->mat_.col[aj]] = -1;
+                    val[aj]    = this->mat_.val[ajj];
+                    levels[aj] = 0;
+                    break;
                 }
             }
         }
     }
 
-    cast_perm->Allocate(this->nrow_);
-
-    int pos = 0;
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    // ai = 1 to N
+    for(int ai = 1; ai < cast_mat->nrow_; ++ai)
     {
-        if(mis[ai] == 1)
-        {
-            cast_perm->vec_[ai] = pos;
-            ++pos;
-        }
-        else
+        // ak = 1 to ai-1
+        for(int ak = cast_mat->mat_.row_offset[ai]; ai > cast_mat->mat_.col[ak]; ++ak)
         {
-            cast_perm->vec_[ai] = size + ai - pos;
-        }
-    }
-
-    // Check the permutation
-    //
-    //  for (int ai=0; ai<this->nrow_; ++ai) {
-    //    assert( cast_perm->vec_[ai] >= 0 );
-    //    assert( cast_perm->vec_[ai] < this->nrow_ );
-    //  }
+            if(levels[ak] <= p)
+            {
+                val[ak] /= val[ind_diag[cast_mat->mat_.col[ak]]];
 
-    free_host(&mis);
+                // aj = ak+1 to N
+                for(int aj = ak + 1; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
+                {
+                    ValueType val_kj = static_cast<ValueType>(0);
+                    int level_kj     = inf_level;
 
-    return true;
-}
+                    // find a_k,j
+                    for(int kj = cast_mat->mat_.row_offset[cast_mat->mat_.col[ak]];
+                        kj < cast_mat->mat_.row_offset[cast_mat->mat_.col[ak] + 1];
+                        ++kj)
+                    {
+                        if(cast_mat->mat_.col[aj] == cast_mat->mat_.col[kj])
+                        {
+                            level_kj = levels[kj];
+                            val_kj   = val[kj];
+                            break;
+                        }
+                    }
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ZeroBlockPermutation(int& size, BaseVector<int>* permutation) const
-{
-    assert(permutation != NULL);
-    assert(permutation->GetSize() == this->nrow_);
-    assert(permutation->GetSize() == this->ncol_);
+                    int lev = level_kj + levels[ak] + 1;
 
-    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-    assert(cast_perm != NULL);
+                    if(levels[aj] > lev)
+                    {
+                        levels[aj] = lev;
+                    }
 
-    size = 0;
+                    // a_i,j = a_i,j - a_i,k * a_k,j
+                    val[aj] -= val[ak] * val_kj;
+                }
+            }
+        }
 
-    for(int ai = 0; ai < this->nrow_; ++ai)
-    {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        for(int ak = cast_mat->mat_.row_offset[ai]; ak < cast_mat->mat_.row_offset[ai + 1]; ++ak)
         {
-            if(ai == this->mat_.col[aj])
+            if(levels[ak] > p)
             {
-                ++size;
+                levels[ak] = inf_level;
+                val[ak]    = static_cast<ValueType>(0);
+            }
+            else
+            {
+                ++row_offset[ai + 1];
             }
         }
     }
 
-    int k_z  = size;
-    int k_nz = 0;
+    row_offset[0] = this->mat_.row_offset[0];
+    row_offset[1] = this->mat_.row_offset[1];
 
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    for(int i = 0; i < cast_mat->nrow_; ++i)
     {
-        bool hit = false;
+        row_offset[i + 1] += row_offset[i];
+    }
 
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+    nnz = row_offset[cast_mat->nrow_];
+
+    this->AllocateCSR(nnz, cast_mat->nrow_, cast_mat->ncol_);
+
+    int jj = 0;
+    for(int i = 0; i < cast_mat->nrow_; ++i)
+    {
+        for(int j = cast_mat->mat_.row_offset[i]; j < cast_mat->mat_.row_offset[i + 1]; ++j)
         {
-            if(ai == this->mat_.col[aj])
+            if(levels[j] <= p)
             {
-                cast_perm->vec_[ai] = k_nz;
-                ++k_nz;
-                hit = true;
+                this->mat_.col[jj] = cast_mat->mat_.col[j];
+                this->mat_.val[jj] = val[j];
+                ++jj;
             }
         }
+    }
 
-        if(hit == false)
-        {
-            cast_perm->vec_[ai] = k_z;
-            ++k_z;
-        }
+    assert(jj == nnz);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < this->nrow_ + 1; ++i)
+    {
+        this->mat_.row_offset[i] = row_offset[i];
     }
 
+    free_host(&row_offset);
+    free_host(&ind_diag);
+    free_host(&levels);
+    free_host(&val);
+
     return true;
 }
 
-// following R.E.Bank and C.C.Douglas paper
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::SymbolicMatMatMult(const BaseMatrix<ValueType>& src)
+bool HostMatrixCSR<ValueType>::MatrixAdd(const BaseMatrix<ValueType>& mat,
+                                         ValueType alpha,
+                                         ValueType beta,
+                                         bool structure)
 {
-    const HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<const HostMatrixCSR<ValueType>*>(&src);
+    const HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
 
     assert(cast_mat != NULL);
-    assert(this->ncol_ == cast_mat->nrow_);
+    assert(cast_mat->nrow_ == this->nrow_);
+    assert(cast_mat->ncol_ == this->ncol_);
+    assert(this->nnz_ > 0);
+    assert(cast_mat->nnz_ > 0);
 
-    std::vector<int> row_offset;
-    std::vector<int>* new_col = new std::vector<int>[this->nrow_];
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+    // the structure is sub-set
+    if(structure == false)
+    {
+// CSR should be sorted
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int ai = 0; ai < cast_mat->nrow_; ++ai)
+        {
+            int first_col = cast_mat->mat_.row_offset[ai];
+
+            for(int ajj = this->mat_.row_offset[ai]; ajj < this->mat_.row_offset[ai + 1]; ++ajj)
+            {
+                for(int aj = first_col; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
+                {
+                    if(cast_mat->mat_.col[aj] == this->mat_.col[ajj])
+                    {
+                        this->mat_.val[ajj] =
+                            alpha * this->mat_.val[ajj] + beta * cast_mat->mat_.val[aj];
+                        ++first_col;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        std::vector<int> row_offset;
+        std::vector<int>* new_col = new std::vector<int>[this->nrow_];
 
-    row_offset.resize(this->nrow_ + 1);
+        HostMatrixCSR<ValueType> tmp(this->local_backend_);
 
-    row_offset[0] = 0;
+        tmp.CopyFrom(*this);
 
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        row_offset.resize(this->nrow_ + 1);
+
+        row_offset[0] = 0;
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        // loop over the row
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            int ii = this->mat_.col[j];
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                new_col[i].push_back(this->mat_.col[j]);
+            }
 
-            // loop corresponding row
-            for(int k = cast_mat->mat_.row_offset[ii]; k < cast_mat->mat_.row_offset[ii + 1]; ++k)
+            for(int k = cast_mat->mat_.row_offset[i]; k < cast_mat->mat_.row_offset[i + 1]; ++k)
             {
                 new_col[i].push_back(cast_mat->mat_.col[k]);
             }
-        }
 
-        std::sort(new_col[i].begin(), new_col[i].end());
-        new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
+            std::sort(new_col[i].begin(), new_col[i].end());
+            new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
 
-        row_offset[i + 1] = int(new_col[i].size());
-    }
+            row_offset[i + 1] = int(new_col[i].size());
+        }
 
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        row_offset[i + 1] += row_offset[i];
-    }
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            row_offset[i + 1] += row_offset[i];
+        }
 
-    this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+        this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
 
+// copy structure
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int i = 0; i < this->nrow_ + 1; ++i)
-    {
-        this->mat_.row_offset[i] = row_offset[i];
-    }
+        for(int i = 0; i < this->nrow_ + 1; ++i)
+        {
+            this->mat_.row_offset[i] = row_offset[i];
+        }
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        int jj = 0;
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            this->mat_.col[j] = new_col[i][jj];
-            ++jj;
+            int jj = 0;
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                this->mat_.col[j] = new_col[i][jj];
+                ++jj;
+            }
         }
-    }
 
-    //#ifdef _OPENMP
-    //#pragma omp parallel for
-    //#endif
-    //  for (unsigned int i=0; i<this->nnz_; ++i)
-    //    this->mat_.val[i] = static_cast<ValueType>(1);
+// add values
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            int Aj = tmp.mat_.row_offset[i];
+            int Bj = cast_mat->mat_.row_offset[i];
 
-    delete[] new_col;
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                for(int jj = Aj; jj < tmp.mat_.row_offset[i + 1]; ++jj)
+                {
+                    if(this->mat_.col[j] == tmp.mat_.col[jj])
+                    {
+                        this->mat_.val[j] += alpha * tmp.mat_.val[jj];
+                        ++Aj;
+                        break;
+                    }
+                }
+
+                for(int jj = Bj; jj < cast_mat->mat_.row_offset[i + 1]; ++jj)
+                {
+                    if(this->mat_.col[j] == cast_mat->mat_.col[jj])
+                    {
+                        this->mat_.val[j] += beta * cast_mat->mat_.val[jj];
+                        ++Bj;
+                        break;
+                    }
+                }
+            }
+        }
+        delete[] new_col;
+    }
 
     return true;
 }
 
-// ----------------------------------------------------------
-// original function prod(const spmat1 &A, const spmat2 &B)
-// ----------------------------------------------------------
-// Modified and adapted from AMGCL,
-// https://github.com/ddemidov/amgcl
-// MIT License
-// ----------------------------------------------------------
-// CHANGELOG
-// - adapted interface
-// sorting is added
-// ----------------------------------------------------------
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::MatMatMult(const BaseMatrix<ValueType>& A,
-                                          const BaseMatrix<ValueType>& B)
+bool HostMatrixCSR<ValueType>::Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const
 {
-    assert((this != &A) && (this != &B));
-
-    //  this->SymbolicMatMatMult(A, B);
-    //  this->NumericMatMatMult (A, B);
-    //
-    //  return true;
-
-    const HostMatrixCSR<ValueType>* cast_mat_A = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
-    const HostMatrixCSR<ValueType>* cast_mat_B = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
-
-    assert(cast_mat_A != NULL);
-    assert(cast_mat_B != NULL);
-    assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
-
-    int n = cast_mat_A->nrow_;
-    int m = cast_mat_B->ncol_;
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-    int* row_offset = NULL;
-    allocate_host(n + 1, &row_offset);
-    int* col       = NULL;
-    ValueType* val = NULL;
+    lambda_min = static_cast<ValueType>(0);
+    lambda_max = static_cast<ValueType>(0);
 
-    for(int i = 0; i < n + 1; ++i)
-    {
-        row_offset[i] = 0;
-    }
+    // TODO (parallel max, min)
+    //#ifdef _OPENMP
+    // #pragma omp parallel for
+    //#endif
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        std::vector<int> marker(m, -1);
-
-#ifdef _OPENMP
-        int nt  = omp_get_num_threads();
-        int tid = omp_get_thread_num();
-
-        int chunk_size  = (n + nt - 1) / nt;
-        int chunk_start = tid * chunk_size;
-        int chunk_end   = std::min(n, chunk_start + chunk_size);
-#else
-        int chunk_start = 0;
-        int chunk_end   = n;
-#endif
+        ValueType sum  = static_cast<ValueType>(0);
+        ValueType diag = static_cast<ValueType>(0);
 
-        for(int ia = chunk_start; ia < chunk_end; ++ia)
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            for(int ja = cast_mat_A->mat_.row_offset[ia], ea = cast_mat_A->mat_.row_offset[ia + 1];
-                ja < ea;
-                ++ja)
+            if(ai != this->mat_.col[aj])
             {
-                int ca = cast_mat_A->mat_.col[ja];
-                for(int jb = cast_mat_B->mat_.row_offset[ca],
-                        eb = cast_mat_B->mat_.row_offset[ca + 1];
-                    jb < eb;
-                    ++jb)
-                {
-                    int cb = cast_mat_B->mat_.col[jb];
-
-                    if(marker[cb] != ia)
-                    {
-                        marker[cb] = ia;
-                        ++row_offset[ia + 1];
-                    }
-                }
+                sum += rocalution_abs(this->mat_.val[aj]);
             }
-        }
-
-        std::fill(marker.begin(), marker.end(), -1);
-
-#ifdef _OPENMP
-#pragma omp barrier
-#endif
-#ifdef _OPENMP
-#pragma omp single
-#endif
-        {
-            for(int i = 1; i < n + 1; ++i)
+            else
             {
-                row_offset[i] += row_offset[i - 1];
+                diag = this->mat_.val[aj];
             }
+        }
 
-            allocate_host(row_offset[n], &col);
-            allocate_host(row_offset[n], &val);
+        if(sum + diag > lambda_max)
+        {
+            lambda_max = sum + diag;
         }
 
-        for(int ia = chunk_start; ia < chunk_end; ++ia)
+        if(diag - sum < lambda_min)
         {
-            int row_begin = row_offset[ia];
-            int row_end   = row_begin;
+            lambda_min = diag - sum;
+        }
+    }
 
-            for(int ja = cast_mat_A->mat_.row_offset[ia], ea = cast_mat_A->mat_.row_offset[ia + 1];
-                ja < ea;
-                ++ja)
-            {
-                int ca       = cast_mat_A->mat_.col[ja];
-                ValueType va = cast_mat_A->mat_.val[ja];
+    return true;
+}
 
-                for(int jb = cast_mat_B->mat_.row_offset[ca],
-                        eb = cast_mat_B->mat_.row_offset[ca + 1];
-                    jb < eb;
-                    ++jb)
-                {
-                    int cb       = cast_mat_B->mat_.col[jb];
-                    ValueType vb = cast_mat_B->mat_.val[jb];
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::Scale(ValueType alpha)
+{
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-                    if(marker[cb] < row_begin)
-                    {
-                        marker[cb]   = row_end;
-                        col[row_end] = cb;
-                        val[row_end] = va * vb;
-                        ++row_end;
-                    }
-                    else
-                    {
-                        val[marker[cb]] += va * vb;
-                    }
-                }
-            }
-        }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int ai = 0; ai < this->nnz_; ++ai)
+    {
+        this->mat_.val[ai] *= alpha;
     }
 
-    this->SetDataPtrCSR(
-        &row_offset, &col, &val, row_offset[n], cast_mat_A->nrow_, cast_mat_B->ncol_);
+    return true;
+}
 
-// Sorting the col (per row)
-// Bubble sort algorithm
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::ScaleDiagonal(ValueType alpha)
+{
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int i = 0; i < this->nrow_; ++i)
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            for(int jj = this->mat_.row_offset[i]; jj < this->mat_.row_offset[i + 1] - 1; ++jj)
+            if(ai == this->mat_.col[aj])
             {
-                if(this->mat_.col[jj] > this->mat_.col[jj + 1])
-                {
-                    // swap elements
-                    int ind       = this->mat_.col[jj];
-                    ValueType val = this->mat_.val[jj];
-
-                    this->mat_.col[jj] = this->mat_.col[jj + 1];
-                    this->mat_.val[jj] = this->mat_.val[jj + 1];
-
-                    this->mat_.col[jj + 1] = ind;
-                    this->mat_.val[jj + 1] = val;
-                }
+                this->mat_.val[aj] *= alpha;
+                break;
             }
         }
     }
@@ -2300,129 +3731,82 @@ bool HostMatrixCSR<ValueType>::MatMatMult(const BaseMatrix<ValueType>& A,
     return true;
 }
 
-// following R.E.Bank and C.C.Douglas paper
-// this = A * B
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::SymbolicMatMatMult(const BaseMatrix<ValueType>& A,
-                                                  const BaseMatrix<ValueType>& B)
+bool HostMatrixCSR<ValueType>::ScaleOffDiagonal(ValueType alpha)
 {
-    const HostMatrixCSR<ValueType>* cast_mat_A = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
-    const HostMatrixCSR<ValueType>* cast_mat_B = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
-
-    assert(cast_mat_A != NULL);
-    assert(cast_mat_B != NULL);
-    assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
-
-    std::vector<int> row_offset;
-    std::vector<int>* new_col = new std::vector<int>[cast_mat_A->nrow_];
-
-    row_offset.resize(cast_mat_A->nrow_ + 1);
-
-    row_offset[0] = 0;
-
     _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int i = 0; i < cast_mat_A->nrow_; ++i)
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        // loop over the row
-        for(int j = cast_mat_A->mat_.row_offset[i]; j < cast_mat_A->mat_.row_offset[i + 1]; ++j)
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            int ii = cast_mat_A->mat_.col[j];
-            //      new_col[i].push_back(ii);
-
-            // loop corresponding row
-            for(int k = cast_mat_B->mat_.row_offset[ii]; k < cast_mat_B->mat_.row_offset[ii + 1];
-                ++k)
+            if(ai != this->mat_.col[aj])
             {
-                new_col[i].push_back(cast_mat_B->mat_.col[k]);
+                this->mat_.val[aj] *= alpha;
             }
         }
-
-        std::sort(new_col[i].begin(), new_col[i].end());
-        new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
-
-        row_offset[i + 1] = int(new_col[i].size());
     }
 
-    for(int i = 0; i < cast_mat_A->nrow_; ++i)
-    {
-        row_offset[i + 1] += row_offset[i];
-    }
+    return true;
+}
 
-    this->AllocateCSR(row_offset[cast_mat_A->nrow_], cast_mat_A->nrow_, cast_mat_B->ncol_);
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::AddScalar(ValueType alpha)
+{
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int i = 0; i < cast_mat_A->nrow_ + 1; ++i)
+    for(int ai = 0; ai < this->nnz_; ++ai)
     {
-        this->mat_.row_offset[i] = row_offset[i];
+        this->mat_.val[ai] += alpha;
     }
 
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::AddScalarDiagonal(ValueType alpha)
+{
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int i = 0; i < cast_mat_A->nrow_; ++i)
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        int jj = 0;
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            this->mat_.col[j] = new_col[i][jj];
-            ++jj;
+            if(ai == this->mat_.col[aj])
+            {
+                this->mat_.val[aj] += alpha;
+                break;
+            }
         }
     }
 
-    //#ifdef _OPENMP
-    //#pragma omp parallel for
-    //#endif
-    //      for (unsigned int i=0; i<this->nnz_; ++i)
-    //      this->mat_.val[i] = static_cast<ValueType>(1);
-
-    delete[] new_col;
-
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::NumericMatMatMult(const BaseMatrix<ValueType>& A,
-                                                 const BaseMatrix<ValueType>& B)
+bool HostMatrixCSR<ValueType>::AddScalarOffDiagonal(ValueType alpha)
 {
-    const HostMatrixCSR<ValueType>* cast_mat_A = dynamic_cast<const HostMatrixCSR<ValueType>*>(&A);
-    const HostMatrixCSR<ValueType>* cast_mat_B = dynamic_cast<const HostMatrixCSR<ValueType>*>(&B);
-
-    assert(cast_mat_A != NULL);
-    assert(cast_mat_B != NULL);
-    assert(cast_mat_A->ncol_ == cast_mat_B->nrow_);
-    assert(this->nrow_ == cast_mat_A->nrow_);
-    assert(this->ncol_ == cast_mat_B->ncol_);
-
     _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int i = 0; i < cast_mat_A->nrow_; ++i)
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        // loop over the row
-        for(int j = cast_mat_A->mat_.row_offset[i]; j < cast_mat_A->mat_.row_offset[i + 1]; ++j)
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            int ii = cast_mat_A->mat_.col[j];
-
-            // loop corresponding row
-            for(int k = cast_mat_B->mat_.row_offset[ii]; k < cast_mat_B->mat_.row_offset[ii + 1];
-                ++k)
+            if(ai != this->mat_.col[aj])
             {
-                for(int p = this->mat_.row_offset[i]; p < this->mat_.row_offset[i + 1]; ++p)
-                {
-                    if(cast_mat_B->mat_.col[k] == this->mat_.col[p])
-                    {
-                        this->mat_.val[p] += cast_mat_B->mat_.val[k] * cast_mat_A->mat_.val[j];
-                        break;
-                    }
-                }
+                this->mat_.val[aj] += alpha;
             }
         }
     }
@@ -2431,75 +3815,47 @@ bool HostMatrixCSR<ValueType>::NumericMatMatMult(const BaseMatrix<ValueType>& A,
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::SymbolicPower(int p)
+bool HostMatrixCSR<ValueType>::DiagonalMatrixMultR(const BaseVector<ValueType>& diag)
 {
-    assert(p > 1);
-
-    // The optimal values for the firsts values
-
-    if(p == 2)
-    {
-        this->SymbolicMatMatMult(*this);
-    }
-
-    if(p == 3)
-    {
-        HostMatrixCSR<ValueType> tmp(this->local_backend_);
-        tmp.CopyFrom(*this);
-
-        this->SymbolicPower(2);
-        this->SymbolicMatMatMult(tmp);
-    }
-
-    if(p == 4)
-    {
-        this->SymbolicPower(2);
-        this->SymbolicPower(2);
-    }
+    assert(diag.GetSize() == this->ncol_);
 
-    if(p == 5)
-    {
-        HostMatrixCSR<ValueType> tmp(this->local_backend_);
-        tmp.CopyFrom(*this);
+    const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
+    assert(cast_diag != NULL);
 
-        this->SymbolicPower(4);
-        this->SymbolicMatMatMult(tmp);
-    }
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-    if(p == 6)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        this->SymbolicPower(2);
-        this->SymbolicPower(3);
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            this->mat_.val[aj] *= cast_diag->vec_[this->mat_.col[aj]];
+        }
     }
 
-    if(p == 7)
-    {
-        HostMatrixCSR<ValueType> tmp(this->local_backend_);
-        tmp.CopyFrom(*this);
-
-        this->SymbolicPower(6);
-        this->SymbolicMatMatMult(tmp);
-    }
+    return true;
+}
 
-    if(p == 8)
-    {
-        HostMatrixCSR<ValueType> tmp(this->local_backend_);
-        tmp.CopyFrom(*this);
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::DiagonalMatrixMultL(const BaseVector<ValueType>& diag)
+{
+    assert(diag.GetSize() == this->ncol_);
 
-        this->SymbolicPower(6);
-        tmp.SymbolicPower(2);
+    const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
+    assert(cast_diag != NULL);
 
-        this->SymbolicMatMatMult(tmp);
-    }
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-    if(p > 8)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        HostMatrixCSR<ValueType> tmp(this->local_backend_);
-        tmp.CopyFrom(*this);
-
-        for(int i = 0; i < p; ++i)
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
         {
-            this->SymbolicMatMatMult(tmp);
+            this->mat_.val[aj] *= cast_diag->vec_[ai];
         }
     }
 
@@ -2507,612 +3863,719 @@ bool HostMatrixCSR<ValueType>::SymbolicPower(int p)
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ILUpFactorizeNumeric(int p, const BaseMatrix<ValueType>& mat)
+bool HostMatrixCSR<ValueType>::Compress(double drop_off)
 {
-    const HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
+    if(this->nnz_ > 0)
+    {
+        std::vector<int> row_offset;
 
-    assert(cast_mat != NULL);
-    assert(cast_mat->nrow_ == this->nrow_);
-    assert(cast_mat->ncol_ == this->ncol_);
-    assert(this->nnz_ > 0);
-    assert(cast_mat->nnz_ > 0);
+        HostMatrixCSR<ValueType> tmp(this->local_backend_);
 
-    int* row_offset = NULL;
-    int* ind_diag   = NULL;
-    int* levels     = NULL;
-    ValueType* val  = NULL;
+        tmp.CopyFrom(*this);
 
-    allocate_host(cast_mat->nrow_ + 1, &row_offset);
-    allocate_host(cast_mat->nrow_, &ind_diag);
-    allocate_host(cast_mat->nnz_, &levels);
-    allocate_host(cast_mat->nnz_, &val);
+        row_offset.resize(this->nrow_ + 1);
 
-    int inf_level = 99999;
-    int nnz       = 0;
+        row_offset[0] = 0;
 
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
 
-// find diagonals
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int ai = 0; ai < cast_mat->nrow_; ++ai)
-    {
-        for(int aj = cast_mat->mat_.row_offset[ai]; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            if(ai == cast_mat->mat_.col[aj])
+            row_offset[i + 1] = 0;
+
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                ind_diag[ai] = aj;
-                break;
+                if((rocalution_abs(this->mat_.val[j]) > drop_off) || (this->mat_.col[j] == i))
+                {
+                    row_offset[i + 1] += 1;
+                }
             }
         }
-    }
 
-// init row_offset
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < cast_mat->nrow_ + 1; ++i)
-    {
-        row_offset[i] = 0;
-    }
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            row_offset[i + 1] += row_offset[i];
+        }
 
-// init inf levels
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < cast_mat->nnz_; ++i)
-    {
-        levels[i] = inf_level;
-    }
+        this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int i = 0; i < cast_mat->nnz_; ++i)
-    {
-        val[i] = static_cast<ValueType>(0);
-    }
+        for(int i = 0; i < this->nrow_ + 1; ++i)
+        {
+            this->mat_.row_offset[i] = row_offset[i];
+        }
 
-// fill levels and values
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int ai = 0; ai < cast_mat->nrow_; ++ai)
-    {
-        for(int aj = cast_mat->mat_.row_offset[ai]; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            for(int ajj = this->mat_.row_offset[ai]; ajj < this->mat_.row_offset[ai + 1]; ++ajj)
+            int jj = this->mat_.row_offset[i];
+
+            for(int j = tmp.mat_.row_offset[i]; j < tmp.mat_.row_offset[i + 1]; ++j)
             {
-                if(cast_mat->mat_.col[aj] == this->mat_.col[ajj])
+                if((rocalution_abs(tmp.mat_.val[j]) > drop_off) || (tmp.mat_.col[j] == i))
                 {
-                    val[aj]    = this->mat_.val[ajj];
-                    levels[aj] = 0;
-                    break;
+                    this->mat_.col[jj] = tmp.mat_.col[j];
+                    this->mat_.val[jj] = tmp.mat_.val[j];
+                    ++jj;
                 }
             }
         }
     }
 
-    // ai = 1 to N
-    for(int ai = 1; ai < cast_mat->nrow_; ++ai)
-    {
-        // ak = 1 to ai-1
-        for(int ak = cast_mat->mat_.row_offset[ai]; ai > cast_mat->mat_.col[ak]; ++ak)
-        {
-            if(levels[ak] <= p)
-            {
-                val[ak] /= val[ind_diag[cast_mat->mat_.col[ak]]];
-
-                // aj = ak+1 to N
-                for(int aj = ak + 1; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
-                {
-                    ValueType val_kj = static_cast<ValueType>(0);
-                    int level_kj     = inf_level;
+    return true;
+}
 
-                    // find a_k,j
-                    for(int kj = cast_mat->mat_.row_offset[cast_mat->mat_.col[ak]];
-                        kj < cast_mat->mat_.row_offset[cast_mat->mat_.col[ak] + 1];
-                        ++kj)
-                    {
-                        if(cast_mat->mat_.col[aj] == cast_mat->mat_.col[kj])
-                        {
-                            level_kj = levels[kj];
-                            val_kj   = val[kj];
-                            break;
-                        }
-                    }
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::Transpose(void)
+{
+    if(this->nnz_ > 0)
+    {
+        HostMatrixCSR<ValueType> tmp(this->local_backend_);
 
-                    int lev = level_kj + levels[ak] + 1;
+        tmp.CopyFrom(*this);
 
-                    if(levels[aj] > lev)
-                    {
-                        levels[aj] = lev;
-                    }
+        this->Clear();
+        this->AllocateCSR(tmp.nnz_, tmp.ncol_, tmp.nrow_);
 
-                    // a_i,j = a_i,j - a_i,k * a_k,j
-                    val[aj] -= val[ak] * val_kj;
-                }
-            }
+        for(int i = 0; i < this->nnz_; ++i)
+        {
+            this->mat_.row_offset[tmp.mat_.col[i] + 1] += 1;
         }
 
-        for(int ak = cast_mat->mat_.row_offset[ai]; ak < cast_mat->mat_.row_offset[ai + 1]; ++ak)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            if(levels[ak] > p)
-            {
-                levels[ak] = inf_level;
-                val[ak]    = static_cast<ValueType>(0);
-            }
-            else
-            {
-                ++row_offset[ai + 1];
-            }
+            this->mat_.row_offset[i + 1] += this->mat_.row_offset[i];
         }
-    }
-
-    row_offset[0] = this->mat_.row_offset[0];
-    row_offset[1] = this->mat_.row_offset[1];
 
-    for(int i = 0; i < cast_mat->nrow_; ++i)
-    {
-        row_offset[i + 1] += row_offset[i];
-    }
+        for(int ai = 0; ai < this->ncol_; ++ai)
+        {
+            for(int aj = tmp.mat_.row_offset[ai]; aj < tmp.mat_.row_offset[ai + 1]; ++aj)
+            {
+                int ind_col = tmp.mat_.col[aj];
+                int ind     = this->mat_.row_offset[ind_col];
 
-    nnz = row_offset[cast_mat->nrow_];
+                this->mat_.col[ind] = ai;
+                this->mat_.val[ind] = tmp.mat_.val[aj];
 
-    this->AllocateCSR(nnz, cast_mat->nrow_, cast_mat->ncol_);
+                this->mat_.row_offset[ind_col] += 1;
+            }
+        }
 
-    int jj = 0;
-    for(int i = 0; i < cast_mat->nrow_; ++i)
-    {
-        for(int j = cast_mat->mat_.row_offset[i]; j < cast_mat->mat_.row_offset[i + 1]; ++j)
+        int shift = 0;
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            if(levels[j] <= p)
-            {
-                this->mat_.col[jj] = cast_mat->mat_.col[j];
-                this->mat_.val[jj] = val[j];
-                ++jj;
-            }
+            int tmp                  = this->mat_.row_offset[i];
+            this->mat_.row_offset[i] = shift;
+            shift                    = tmp;
         }
-    }
 
-    assert(jj == nnz);
+        this->mat_.row_offset[this->nrow_] = shift;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < this->nrow_ + 1; ++i)
-    {
-        this->mat_.row_offset[i] = row_offset[i];
+        assert(tmp.nnz_ == shift);
     }
 
-    free_host(&row_offset);
-    free_host(&ind_diag);
-    free_host(&levels);
-    free_host(&val);
-
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::MatrixAdd(const BaseMatrix<ValueType>& mat,
-                                         ValueType alpha,
-                                         ValueType beta,
-                                         bool structure)
+bool HostMatrixCSR<ValueType>::Sort(void)
 {
-    const HostMatrixCSR<ValueType>* cast_mat = dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat);
-
-    assert(cast_mat != NULL);
-    assert(cast_mat->nrow_ == this->nrow_);
-    assert(cast_mat->ncol_ == this->ncol_);
-    assert(this->nnz_ > 0);
-    assert(cast_mat->nnz_ > 0);
-
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
-
-    // the structure is sub-set
-    if(structure == false)
+    if(this->nnz_ > 0)
     {
-// CSR should be sorted
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-        for(int ai = 0; ai < cast_mat->nrow_; ++ai)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            int first_col = cast_mat->mat_.row_offset[ai];
-
-            for(int ajj = this->mat_.row_offset[ai]; ajj < this->mat_.row_offset[ai + 1]; ++ajj)
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                for(int aj = first_col; aj < cast_mat->mat_.row_offset[ai + 1]; ++aj)
+                for(int jj = this->mat_.row_offset[i]; jj < this->mat_.row_offset[i + 1] - 1; ++jj)
                 {
-                    if(cast_mat->mat_.col[aj] == this->mat_.col[ajj])
+                    if(this->mat_.col[jj] > this->mat_.col[jj + 1])
                     {
-                        this->mat_.val[ajj] =
-                            alpha * this->mat_.val[ajj] + beta * cast_mat->mat_.val[aj];
-                        ++first_col;
-                        break;
+                        // swap elements
+                        int ind       = this->mat_.col[jj];
+                        ValueType val = this->mat_.val[jj];
+
+                        this->mat_.col[jj] = this->mat_.col[jj + 1];
+                        this->mat_.val[jj] = this->mat_.val[jj + 1];
+
+                        this->mat_.col[jj + 1] = ind;
+                        this->mat_.val[jj + 1] = val;
                     }
                 }
             }
         }
     }
-    else
-    {
-        std::vector<int> row_offset;
-        std::vector<int>* new_col = new std::vector<int>[this->nrow_];
 
-        HostMatrixCSR<ValueType> tmp(this->local_backend_);
+    return true;
+}
 
-        tmp.CopyFrom(*this);
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::Permute(const BaseVector<int>& permutation)
+{
+    assert((permutation.GetSize() == this->nrow_) && (permutation.GetSize() == this->ncol_));
 
-        row_offset.resize(this->nrow_ + 1);
+    if(this->nnz_ > 0)
+    {
+        const HostVector<int>* cast_perm = dynamic_cast<const HostVector<int>*>(&permutation);
+        assert(cast_perm != NULL);
 
-        row_offset[0] = 0;
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+        // Calculate nnz per row
+        int* row_nnz = NULL;
+        allocate_host<int>(this->nrow_, &row_nnz);
 
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-            {
-                new_col[i].push_back(this->mat_.col[j]);
-            }
-
-            for(int k = cast_mat->mat_.row_offset[i]; k < cast_mat->mat_.row_offset[i + 1]; ++k)
-            {
-                new_col[i].push_back(cast_mat->mat_.col[k]);
-            }
-
-            std::sort(new_col[i].begin(), new_col[i].end());
-            new_col[i].erase(std::unique(new_col[i].begin(), new_col[i].end()), new_col[i].end());
-
-            row_offset[i + 1] = int(new_col[i].size());
+            row_nnz[i] = this->mat_.row_offset[i + 1] - this->mat_.row_offset[i];
         }
 
+        // Permute vector of nnz per row
+        int* perm_row_nnz = NULL;
+        allocate_host<int>(this->nrow_, &perm_row_nnz);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            row_offset[i + 1] += row_offset[i];
+            perm_row_nnz[cast_perm->vec_[i]] = row_nnz[i];
         }
 
-        this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+        // Calculate new nnz
+        int* perm_nnz = NULL;
+        allocate_host<int>(this->nrow_ + 1, &perm_nnz);
+        int sum = 0;
 
-// copy structure
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < this->nrow_ + 1; ++i)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            this->mat_.row_offset[i] = row_offset[i];
+            perm_nnz[i] = sum;
+            sum += perm_row_nnz[i];
         }
 
+        perm_nnz[this->nrow_] = sum;
+
+        // Permute rows
+        int* col       = NULL;
+        ValueType* val = NULL;
+        allocate_host<int>(this->nnz_, &col);
+        allocate_host<ValueType>(this->nnz_, &val);
+
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            int jj = 0;
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            int permIndex = perm_nnz[cast_perm->vec_[i]];
+            int prevIndex = this->mat_.row_offset[i];
+
+            for(int j = 0; j < row_nnz[i]; ++j)
             {
-                this->mat_.col[j] = new_col[i][jj];
-                ++jj;
+                col[permIndex + j] = this->mat_.col[prevIndex + j];
+                val[permIndex + j] = this->mat_.val[prevIndex + j];
             }
         }
 
-// add values
+// Permute columns
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            int Aj = tmp.mat_.row_offset[i];
-            int Bj = cast_mat->mat_.row_offset[i];
+            int row_index = perm_nnz[i];
 
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            for(int j = 0; j < perm_row_nnz[i]; ++j)
             {
-                for(int jj = Aj; jj < tmp.mat_.row_offset[i + 1]; ++jj)
+                int k     = j - 1;
+                int aComp = col[row_index + j];
+                int comp  = cast_perm->vec_[aComp];
+                for(; k >= 0; --k)
                 {
-                    if(this->mat_.col[j] == tmp.mat_.col[jj])
+                    if(this->mat_.col[row_index + k] > comp)
                     {
-                        this->mat_.val[j] += alpha * tmp.mat_.val[jj];
-                        ++Aj;
-                        break;
+                        this->mat_.val[row_index + k + 1] = this->mat_.val[row_index + k];
+                        this->mat_.col[row_index + k + 1] = this->mat_.col[row_index + k];
                     }
-                }
-
-                for(int jj = Bj; jj < cast_mat->mat_.row_offset[i + 1]; ++jj)
-                {
-                    if(this->mat_.col[j] == cast_mat->mat_.col[jj])
+                    else
                     {
-                        this->mat_.val[j] += beta * cast_mat->mat_.val[jj];
-                        ++Bj;
                         break;
                     }
                 }
+
+                this->mat_.val[row_index + k + 1] = val[row_index + j];
+                this->mat_.col[row_index + k + 1] = comp;
             }
         }
-        delete[] new_col;
+
+        free_host<int>(&this->mat_.row_offset);
+        this->mat_.row_offset = perm_nnz;
+        free_host<int>(&col);
+        free_host<ValueType>(&val);
+        free_host<int>(&row_nnz);
+        free_host<int>(&perm_row_nnz);
     }
 
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const
+bool HostMatrixCSR<ValueType>::CMK(BaseVector<int>* permutation) const
 {
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    assert(this->nnz_ > 0);
+    assert(permutation != NULL);
+    assert(this->nrow_ == this->ncol_);
 
-    lambda_min = static_cast<ValueType>(0);
-    lambda_max = static_cast<ValueType>(0);
+    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+    assert(cast_perm != NULL);
 
-    // TODO (parallel max, min)
-    //#ifdef _OPENMP
-    // #pragma omp parallel for
-    //#endif
+    cast_perm->Clear();
+    cast_perm->Allocate(this->nrow_);
 
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    // Symmetric adjacency structure
+    std::vector<int> xadj;
+    std::vector<int> adj;
+
+    graph_symmetrize(this->nrow_, this->mat_.row_offset, this->mat_.col, xadj, adj);
+
+    std::vector<int> level(this->nrow_, -1);
+    std::vector<int> queue(this->nrow_);
+    std::vector<std::pair<int, int>> next_nodes;
+
+    for(int i = 0; i < this->nrow_; ++i)
     {
-        ValueType sum  = static_cast<ValueType>(0);
-        ValueType diag = static_cast<ValueType>(0);
+        cast_perm->vec_[i] = -1;
+    }
 
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+    int next = 0;
+    int tail = 0;
+
+    // Each connected component is numbered, starting from a pseudo-peripheral node
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        if(cast_perm->vec_[i] != -1)
         {
-            if(ai != this->mat_.col[aj])
+            continue;
+        }
+
+        int root = graph_pseudo_peripheral_node(this->nrow_, xadj.data(), adj.data(), i, level);
+
+        int head = tail;
+
+        queue[tail++]         = root;
+        cast_perm->vec_[root] = next++;
+
+        while(head < tail)
+        {
+            int v = queue[head++];
+
+            // Unnumbered neighbours in order of increasing degree
+            next_nodes.clear();
+
+            for(int j = xadj[v]; j < xadj[v + 1]; ++j)
             {
-                sum += rocalution_abs(this->mat_.val[aj]);
+                int u = adj[j];
+
+                if(cast_perm->vec_[u] == -1)
+                {
+                    next_nodes.push_back(std::make_pair(xadj[u + 1] - xadj[u], u));
+                }
             }
-            else
+
+            std::sort(next_nodes.begin(), next_nodes.end());
+
+            for(size_t k = 0; k < next_nodes.size(); ++k)
             {
-                diag = this->mat_.val[aj];
+                int u = next_nodes[k].second;
+
+                queue[tail++]      = u;
+                cast_perm->vec_[u] = next++;
             }
         }
+    }
 
-        if(sum + diag > lambda_max)
-        {
-            lambda_max = sum + diag;
-        }
+    assert(next == this->nrow_);
 
-        if(diag - sum < lambda_min)
-        {
-            lambda_min = diag - sum;
-        }
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::RCMK(BaseVector<int>* permutation) const
+{
+    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+    assert(cast_perm != NULL);
+
+    cast_perm->Clear();
+    cast_perm->Allocate(this->nrow_);
+
+    HostVector<int> tmp_perm(this->local_backend_);
+
+    this->CMK(&tmp_perm);
+
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        cast_perm->vec_[i] = this->nrow_ - tmp_perm.vec_[i] - 1;
     }
 
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::Scale(ValueType alpha)
+bool HostMatrixCSR<ValueType>::ConnectivityOrder(BaseVector<int>* permutation) const
 {
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+    assert(cast_perm != NULL);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int ai = 0; ai < this->nnz_; ++ai)
+    cast_perm->Clear();
+    cast_perm->Allocate(this->nrow_);
+
+    std::multimap<int, int> map;
+
+    for(int i = 0; i < this->nrow_; ++i)
     {
-        this->mat_.val[ai] *= alpha;
+        map.insert(std::pair<int, int>(this->mat_.row_offset[i + 1] - this->mat_.row_offset[i], i));
+    }
+
+    std::multimap<int, int>::iterator it = map.begin();
+
+    for(int i = 0; i < this->nrow_; ++i, ++it)
+    {
+        cast_perm->vec_[i] = it->second;
     }
 
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ScaleDiagonal(ValueType alpha)
+bool HostMatrixCSR<ValueType>::KWayPartitioning(int num_parts,
+                                                int** size_parts,
+                                                BaseVector<int>* permutation) const
 {
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    assert(num_parts > 0);
+    assert(*size_parts == NULL);
+    assert(permutation != NULL);
+    assert(this->nrow_ == this->ncol_);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+    assert(cast_perm != NULL);
+
+    std::vector<int> xadj;
+    std::vector<int> adj;
+
+    graph_symmetrize(this->nrow_, this->mat_.row_offset, this->mat_.col, xadj, adj);
+
+    std::vector<int> part(this->nrow_);
+
+    graph_partition(this->nrow_, xadj.data(), adj.data(), num_parts, part.data());
+
+    // The nodes of each part are numbered contiguously, in their original order
+    allocate_host(num_parts, size_parts);
+    set_to_zero_host(num_parts, *size_parts);
+
+    for(int i = 0; i < this->nrow_; ++i)
     {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-        {
-            if(ai == this->mat_.col[aj])
-            {
-                this->mat_.val[aj] *= alpha;
-                break;
-            }
-        }
+        ++(*size_parts)[part[i]];
+    }
+
+    std::vector<int> offset(num_parts, 0);
+
+    for(int p = 1; p < num_parts; ++p)
+    {
+        offset[p] = offset[p - 1] + (*size_parts)[p - 1];
+    }
+
+    cast_perm->Clear();
+    cast_perm->Allocate(this->nrow_);
+
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        cast_perm->vec_[i] = offset[part[i]]++;
     }
 
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ScaleOffDiagonal(ValueType alpha)
+bool HostMatrixCSR<ValueType>::NestedDissection(BaseVector<int>* permutation) const
 {
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    assert(permutation != NULL);
+    assert(this->nrow_ == this->ncol_);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
+    assert(cast_perm != NULL);
+
+    std::vector<int> xadj;
+    std::vector<int> adj;
+
+    graph_symmetrize(this->nrow_, this->mat_.row_offset, this->mat_.col, xadj, adj);
+
+    cast_perm->Clear();
+    cast_perm->Allocate(this->nrow_);
+
+    graph_nested_dissection(this->nrow_, xadj.data(), adj.data(), cast_perm->vec_);
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map, int n, int m)
+{
+    assert(map.GetSize() == n);
+
+    const HostVector<int>* cast_map = dynamic_cast<const HostVector<int>*>(&map);
+
+    assert(cast_map != NULL);
+
+    int* row_nnz    = NULL;
+    int* row_buffer = NULL;
+    allocate_host<int>(m, &row_nnz);
+    allocate_host<int>(m + 1, &row_buffer);
+
+    set_to_zero_host(m, row_nnz);
+
+    int nnz = 0;
+
+    for(int i = 0; i < n; ++i)
     {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-        {
-            if(ai != this->mat_.col[aj])
-            {
-                this->mat_.val[aj] *= alpha;
-            }
+        assert(cast_map->vec_[i] < m);
+
+        if(cast_map->vec_[i] < 0)
+        {
+            continue;
         }
+
+        ++row_nnz[cast_map->vec_[i]];
+        ++nnz;
     }
 
-    return true;
-}
+    this->Clear();
+    this->AllocateCSR(nnz, m, n);
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::AddScalar(ValueType alpha)
-{
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    this->mat_.row_offset[0] = 0;
+    row_buffer[0]            = 0;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int ai = 0; ai < this->nnz_; ++ai)
+    for(int i = 0; i < m; ++i)
     {
-        this->mat_.val[ai] += alpha;
+        this->mat_.row_offset[i + 1] = this->mat_.row_offset[i] + row_nnz[i];
+        row_buffer[i + 1]            = this->mat_.row_offset[i + 1];
     }
 
-    return true;
-}
-
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::AddScalarDiagonal(ValueType alpha)
-{
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
-
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    for(int i = 0; i < nnz; ++i)
     {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        if(cast_map->vec_[i] < 0)
         {
-            if(ai == this->mat_.col[aj])
-            {
-                this->mat_.val[aj] += alpha;
-                break;
-            }
+            continue;
         }
+
+        this->mat_.col[row_buffer[cast_map->vec_[i]]] = i;
+        this->mat_.val[i]                             = static_cast<ValueType>(1);
+        row_buffer[cast_map->vec_[i]]++;
     }
 
+    assert(this->mat_.row_offset[m] == nnz);
+
+    free_host<int>(&row_nnz);
+    free_host<int>(&row_buffer);
+
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::AddScalarOffDiagonal(ValueType alpha)
+bool HostMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map,
+                                             int n,
+                                             int m,
+                                             BaseMatrix<ValueType>* pro)
 {
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    assert(map.GetSize() == n);
+    assert(pro != NULL);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
-    {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
-        {
-            if(ai != this->mat_.col[aj])
-            {
-                this->mat_.val[aj] += alpha;
-            }
-        }
-    }
+    const HostVector<int>* cast_map    = dynamic_cast<const HostVector<int>*>(&map);
+    HostMatrixCSR<ValueType>* cast_pro = dynamic_cast<HostMatrixCSR<ValueType>*>(pro);
 
-    return true;
-}
+    assert(cast_pro != NULL);
+    assert(cast_map != NULL);
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::DiagonalMatrixMultR(const BaseVector<ValueType>& diag)
-{
-    assert(diag.GetSize() == this->ncol_);
+    // Build restriction operator
+    this->CreateFromMap(map, n, m);
 
-    const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
-    assert(cast_diag != NULL);
+    int nnz = this->GetNnz();
 
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    // Build prolongation operator
+    cast_pro->Clear();
+    cast_pro->AllocateCSR(nnz, n, m);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    int k = 0;
+
+    for(int i = 0; i < n; ++i)
     {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        cast_pro->mat_.row_offset[i + 1] = cast_pro->mat_.row_offset[i];
+
+        // Check for entry in i-th row
+        if(cast_map->vec_[i] < 0)
         {
-            this->mat_.val[aj] *= cast_diag->vec_[this->mat_.col[aj]];
+            continue;
         }
+
+        assert(cast_map->vec_[i] < m);
+
+        ++cast_pro->mat_.row_offset[i + 1];
+        cast_pro->mat_.col[k] = cast_map->vec_[i];
+        cast_pro->mat_.val[k] = static_cast<ValueType>(1);
+        ++k;
     }
 
     return true;
 }
 
+// ----------------------------------------------------------
+// original function connect(const spmat &A,
+//                           float eps_strong)
+// ----------------------------------------------------------
+// Modified and adapted from AMGCL,
+// https://github.com/ddemidov/amgcl
+// MIT License
+// ----------------------------------------------------------
+// CHANGELOG
+// - adapted interface
+// ----------------------------------------------------------
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::DiagonalMatrixMultL(const BaseVector<ValueType>& diag)
+bool HostMatrixCSR<ValueType>::AMGConnect(ValueType eps, BaseVector<int>* connections) const
 {
-    assert(diag.GetSize() == this->ncol_);
+    assert(connections != NULL);
 
-    const HostVector<ValueType>* cast_diag = dynamic_cast<const HostVector<ValueType>*>(&diag);
-    assert(cast_diag != NULL);
+    HostVector<int>* cast_conn = dynamic_cast<HostVector<int>*>(connections);
+    assert(cast_conn != NULL);
 
-    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    cast_conn->Clear();
+    cast_conn->Allocate(this->nnz_);
+
+    ValueType eps2 = eps * eps;
+
+    HostVector<ValueType> vec_diag(this->local_backend_);
+    vec_diag.Allocate(this->nrow_);
+    this->ExtractDiagonal(&vec_diag);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 1024)
 #endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
+    for(int i = 0; i < this->nrow_; ++i)
     {
-        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        ValueType eps_dia_i = eps2 * vec_diag.vec_[i];
+
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
         {
-            this->mat_.val[aj] *= cast_diag->vec_[ai];
+            int c       = this->mat_.col[j];
+            ValueType v = this->mat_.val[j];
+
+            cast_conn->vec_[j] = (c != i) && (v * v > eps_dia_i * vec_diag.vec_[c]);
         }
     }
 
     return true;
 }
 
+// ----------------------------------------------------------
+// original function aggregates( const spmat &A,
+//                               const std::vector<char> &S )
+// ----------------------------------------------------------
+// Modified and adapted from AMGCL,
+// https://github.com/ddemidov/amgcl
+// MIT License
+// ----------------------------------------------------------
+// CHANGELOG
+// - adapted interface
+// ----------------------------------------------------------
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::Compress(double drop_off)
+bool HostMatrixCSR<ValueType>::AMGAggregate(const BaseVector<int>& connections,
+                                            BaseVector<int>* aggregates) const
 {
-    if(this->nnz_ > 0)
-    {
-        std::vector<int> row_offset;
+    assert(aggregates != NULL);
 
-        HostMatrixCSR<ValueType> tmp(this->local_backend_);
+    HostVector<int>* cast_agg        = dynamic_cast<HostVector<int>*>(aggregates);
+    const HostVector<int>* cast_conn = dynamic_cast<const HostVector<int>*>(&connections);
 
-        tmp.CopyFrom(*this);
+    assert(cast_agg != NULL);
+    assert(cast_conn != NULL);
 
-        row_offset.resize(this->nrow_ + 1);
+    aggregates->Clear();
+    aggregates->Allocate(this->nrow_);
 
-        row_offset[0] = 0;
+    const int undefined = -1;
+    const int removed   = -2;
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+    // Remove nodes without neighbours
+    int max_neib = 0;
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        int j = this->mat_.row_offset[i];
+        int e = this->mat_.row_offset[i + 1];
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
-        {
-            row_offset[i + 1] = 0;
+        max_neib = std::max(e - j, max_neib);
 
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        int state = removed;
+        for(; j < e; ++j)
+        {
+            if(cast_conn->vec_[j])
             {
-                if((rocalution_abs(this->mat_.val[j]) > drop_off) || (this->mat_.col[j] == i))
-                {
-                    row_offset[i + 1] += 1;
-                }
+                state = undefined;
+                break;
             }
         }
 
-        for(int i = 0; i < this->nrow_; ++i)
+        cast_agg->vec_[i] = state;
+    }
+
+    std::vector<int> neib;
+    neib.reserve(max_neib);
+
+    int last_g = -1;
+
+    // Perform plain aggregation
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        if(cast_agg->vec_[i] != undefined)
         {
-            row_offset[i + 1] += row_offset[i];
+            continue;
         }
 
-        this->AllocateCSR(row_offset[this->nrow_], this->nrow_, this->ncol_);
+        // The point is not adjacent to a core of any previous aggregate:
+        // so its a seed of a new aggregate.
+        cast_agg->vec_[i] = ++last_g;
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < this->nrow_ + 1; ++i)
+        neib.clear();
+
+        // Include its neighbors as well.
+        for(int j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
         {
-            this->mat_.row_offset[i] = row_offset[i];
+            int c = this->mat_.col[j];
+            if(cast_conn->vec_[j] && cast_agg->vec_[c] != removed)
+            {
+                cast_agg->vec_[c] = last_g;
+                neib.push_back(c);
+            }
         }
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
+        // Temporarily mark undefined points adjacent to the new aggregate as
+        // belonging to the aggregate. If nobody claims them later, they will
+        // stay here.
+        for(typename std::vector<int>::const_iterator nb = neib.begin(); nb != neib.end(); ++nb)
         {
-            int jj = this->mat_.row_offset[i];
-
-            for(int j = tmp.mat_.row_offset[i]; j < tmp.mat_.row_offset[i + 1]; ++j)
+            for(int j = this->mat_.row_offset[*nb], e = this->mat_.row_offset[*nb + 1]; j < e; ++j)
             {
-                if((rocalution_abs(tmp.mat_.val[j]) > drop_off) || (tmp.mat_.col[j] == i))
+                if(cast_conn->vec_[j] && cast_agg->vec_[this->mat_.col[j]] == undefined)
                 {
-                    this->mat_.col[jj] = tmp.mat_.col[j];
-                    this->mat_.val[jj] = tmp.mat_.val[j];
-                    ++jj;
+                    cast_agg->vec_[this->mat_.col[j]] = last_g;
                 }
             }
         }
@@ -3121,1134 +4584,1271 @@ bool HostMatrixCSR<ValueType>::Compress(double drop_off)
     return true;
 }
 
+// Parallel aggregation based on a distance-2 maximal independent set of the strong
+// coupling graph (Bell, Dalton, Olson 2012). The roots of the aggregates are ranked by
+// a random weight, that only depends on the row index, such that the aggregates are
+// independent of the number of threads.
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::Transpose(void)
+bool HostMatrixCSR<ValueType>::AMGMIS2Aggregate(const BaseVector<int>& connections,
+                                                BaseVector<int>* aggregates) const
 {
-    if(this->nnz_ > 0)
+    assert(aggregates != NULL);
+
+    HostVector<int>* cast_agg        = dynamic_cast<HostVector<int>*>(aggregates);
+    const HostVector<int>* cast_conn = dynamic_cast<const HostVector<int>*>(&connections);
+
+    assert(cast_agg != NULL);
+    assert(cast_conn != NULL);
+
+    aggregates->Clear();
+    aggregates->Allocate(this->nrow_);
+
+    const int undefined = -1;
+    const int removed   = -2;
+
+    // Each node is ranked by the key (state, random weight, index). The state is stored
+    // in the two highest bits, such that comparing keys compares the states first.
+    const unsigned long long state_out       = 0ULL;
+    const unsigned long long state_undecided = 1ULL << 62;
+    const unsigned long long state_in        = 2ULL << 62;
+    const unsigned long long state_mask      = 3ULL << 62;
+
+    std::vector<unsigned long long> key(this->nrow_);
+    std::vector<unsigned long long> key1(this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+    for(int i = 0; i < this->nrow_; ++i)
     {
-        HostMatrixCSR<ValueType> tmp(this->local_backend_);
+        // Remove nodes without neighbours
+        int state = removed;
 
-        tmp.CopyFrom(*this);
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        {
+            if(cast_conn->vec_[j])
+            {
+                state = undefined;
+                break;
+            }
+        }
 
-        this->Clear();
-        this->AllocateCSR(tmp.nnz_, tmp.ncol_, tmp.nrow_);
+        cast_agg->vec_[i] = state;
 
-        for(int i = 0; i < this->nnz_; ++i)
+        if(state == removed)
         {
-            this->mat_.row_offset[tmp.mat_.col[i] + 1] += 1;
+            key[i] = state_out;
+            continue;
         }
 
-        for(int i = 0; i < this->nrow_; ++i)
+        unsigned int x = murmur3_fmix32(static_cast<unsigned int>(i) * 2654435761u);
+
+        key[i] = state_undecided | (static_cast<unsigned long long>(x >> 2) << 32)
+                 | static_cast<unsigned long long>(i);
+    }
+
+    // Distance-2 maximal independent set. Only the undecided nodes and their
+    // neighbours are processed in each round.
+    std::vector<int> active;
+    std::vector<int> mark(this->nrow_, -1);
+
+    active.reserve(this->nrow_);
+
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        if(cast_agg->vec_[i] != removed)
         {
-            this->mat_.row_offset[i + 1] += this->mat_.row_offset[i];
+            active.push_back(i);
         }
+    }
 
-        for(int ai = 0; ai < this->ncol_; ++ai)
+    int round = 0;
+
+    while(active.empty() == false)
+    {
+        int nactive = static_cast<int>(active.size());
+
+        // Mark the nodes, that are required for the distance 1 keys
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int k = 0; k < nactive; ++k)
         {
-            for(int aj = tmp.mat_.row_offset[ai]; aj < tmp.mat_.row_offset[ai + 1]; ++aj)
-            {
-                int ind_col = tmp.mat_.col[aj];
-                int ind     = this->mat_.row_offset[ind_col];
+            int i = active[k];
 
-                this->mat_.col[ind] = ai;
-                this->mat_.val[ind] = tmp.mat_.val[aj];
+            mark[i] = round;
 
-                this->mat_.row_offset[ind_col] += 1;
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                if(cast_conn->vec_[j])
+                {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+                    mark[this->mat_.col[j]] = round;
+                }
             }
         }
 
-        int shift = 0;
+        // Largest key within distance 1
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
         for(int i = 0; i < this->nrow_; ++i)
         {
-            int tmp                  = this->mat_.row_offset[i];
-            this->mat_.row_offset[i] = shift;
-            shift                    = tmp;
-        }
+            if(mark[i] != round)
+            {
+                continue;
+            }
 
-        this->mat_.row_offset[this->nrow_] = shift;
+            unsigned long long kmax = key[i];
 
-        assert(tmp.nnz_ == shift);
-    }
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                if(cast_conn->vec_[j])
+                {
+                    kmax = std::max(kmax, key[this->mat_.col[j]]);
+                }
+            }
 
-    return true;
-}
+            key1[i] = kmax;
+        }
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::Sort(void)
-{
-    if(this->nnz_ > 0)
-    {
+        // Undecided nodes with the largest key within distance 2 join the set, undecided
+        // nodes within distance 2 of the set are removed from it
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 1024)
 #endif
-        for(int i = 0; i < this->nrow_; ++i)
+        for(int k = 0; k < nactive; ++k)
         {
+            int i = active[k];
+
+            unsigned long long kmax = key1[i];
+
             for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                for(int jj = this->mat_.row_offset[i]; jj < this->mat_.row_offset[i + 1] - 1; ++jj)
+                if(cast_conn->vec_[j])
                 {
-                    if(this->mat_.col[jj] > this->mat_.col[jj + 1])
-                    {
-                        // swap elements
-                        int ind       = this->mat_.col[jj];
-                        ValueType val = this->mat_.val[jj];
-
-                        this->mat_.col[jj] = this->mat_.col[jj + 1];
-                        this->mat_.val[jj] = this->mat_.val[jj + 1];
-
-                        this->mat_.col[jj + 1] = ind;
-                        this->mat_.val[jj + 1] = val;
-                    }
+                    kmax = std::max(kmax, key1[this->mat_.col[j]]);
                 }
             }
+
+            if(kmax == key[i])
+            {
+                key[i] = (key[i] & ~state_mask) | state_in;
+            }
+            else if((kmax & state_mask) == state_in)
+            {
+                key[i] = (key[i] & ~state_mask) | state_out;
+            }
         }
-    }
 
-    return true;
-}
+        // Remaining undecided nodes
+        int nundecided = 0;
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::Permute(const BaseVector<int>& permutation)
-{
-    assert((permutation.GetSize() == this->nrow_) && (permutation.GetSize() == this->ncol_));
+        for(int k = 0; k < nactive; ++k)
+        {
+            if((key[active[k]] & state_mask) == state_undecided)
+            {
+                active[nundecided++] = active[k];
+            }
+        }
 
-    if(this->nnz_ > 0)
-    {
-        const HostVector<int>* cast_perm = dynamic_cast<const HostVector<int>*>(&permutation);
-        assert(cast_perm != NULL);
+        active.resize(nundecided);
 
-        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+        ++round;
+    }
 
-        // Calculate nnz per row
-        int* row_nnz = NULL;
-        allocate_host<int>(this->nrow_, &row_nnz);
+    // The nodes of the set are the roots of the aggregates, numbered in ascending order
+    std::vector<int> root(this->nrow_, undefined);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
+    int nagg = 0;
+
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        if((key[i] & state_mask) == state_in)
         {
-            row_nnz[i] = this->mat_.row_offset[i + 1] - this->mat_.row_offset[i];
+            root[i] = nagg++;
         }
+    }
 
-        // Permute vector of nnz per row
-        int* perm_row_nnz = NULL;
-        allocate_host<int>(this->nrow_, &perm_row_nnz);
-
+    // The roots and their strong neighbours form the aggregates
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 1024)
 #endif
-        for(int i = 0; i < this->nrow_; ++i)
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        if(root[i] != undefined)
         {
-            perm_row_nnz[cast_perm->vec_[i]] = row_nnz[i];
+            cast_agg->vec_[i] = root[i];
+            continue;
         }
 
-        // Calculate new nnz
-        int* perm_nnz = NULL;
-        allocate_host<int>(this->nrow_ + 1, &perm_nnz);
-        int sum = 0;
-
-        for(int i = 0; i < this->nrow_; ++i)
+        if(cast_agg->vec_[i] == removed)
         {
-            perm_nnz[i] = sum;
-            sum += perm_row_nnz[i];
+            continue;
         }
 
-        perm_nnz[this->nrow_] = sum;
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        {
+            int c = this->mat_.col[j];
 
-        // Permute rows
-        int* col       = NULL;
-        ValueType* val = NULL;
-        allocate_host<int>(this->nnz_, &col);
-        allocate_host<ValueType>(this->nnz_, &val);
+            if(cast_conn->vec_[j] && root[c] != undefined)
+            {
+                cast_agg->vec_[i] = root[c];
+                break;
+            }
+        }
+    }
+
+    // The remaining nodes join the aggregate of a strong neighbour
+    root.assign(cast_agg->vec_, cast_agg->vec_ + this->nrow_);
 
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 1024)
 #endif
-        for(int i = 0; i < this->nrow_; ++i)
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        if(root[i] != undefined)
         {
-            int permIndex = perm_nnz[cast_perm->vec_[i]];
-            int prevIndex = this->mat_.row_offset[i];
+            continue;
+        }
 
-            for(int j = 0; j < row_nnz[i]; ++j)
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        {
+            int c = this->mat_.col[j];
+
+            if(cast_conn->vec_[j] && root[c] >= 0)
             {
-                col[permIndex + j] = this->mat_.col[prevIndex + j];
-                val[permIndex + j] = this->mat_.val[prevIndex + j];
+                cast_agg->vec_[i] = root[c];
+                break;
             }
         }
+    }
 
-// Permute columns
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-        for(int i = 0; i < this->nrow_; ++i)
+    // Greedy cleanup of nodes, that are still not aggregated. This can only happen for
+    // non-symmetric strong couplings.
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        if(cast_agg->vec_[i] != undefined)
         {
-            int row_index = perm_nnz[i];
+            continue;
+        }
 
-            for(int j = 0; j < perm_row_nnz[i]; ++j)
-            {
-                int k     = j - 1;
-                int aComp = col[row_index + j];
-                int comp  = cast_perm->vec_[aComp];
-                for(; k >= 0; --k)
-                {
-                    if(this->mat_.col[row_index + k] > comp)
-                    {
-                        this->mat_.val[row_index + k + 1] = this->mat_.val[row_index + k];
-                        this->mat_.col[row_index + k + 1] = this->mat_.col[row_index + k];
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
+        cast_agg->vec_[i] = nagg;
 
-                this->mat_.val[row_index + k + 1] = val[row_index + j];
-                this->mat_.col[row_index + k + 1] = comp;
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        {
+            int c = this->mat_.col[j];
+
+            if(cast_conn->vec_[j] && cast_agg->vec_[c] == undefined)
+            {
+                cast_agg->vec_[c] = nagg;
             }
         }
 
-        free_host<int>(&this->mat_.row_offset);
-        this->mat_.row_offset = perm_nnz;
-        free_host<int>(&col);
-        free_host<ValueType>(&val);
-        free_host<int>(&row_nnz);
-        free_host<int>(&perm_row_nnz);
+        ++nagg;
     }
 
     return true;
 }
 
+// ----------------------------------------------------------
+// original function interp(const sparse::matrix<value_t,
+//                          index_t> &A, const params &prm)
+// ----------------------------------------------------------
+// Modified and adapted from AMGCL,
+// https://github.com/ddemidov/amgcl
+// MIT License
+// ----------------------------------------------------------
+// CHANGELOG
+// - adapted interface
+// ----------------------------------------------------------
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::CMK(BaseVector<int>* permutation) const
+bool HostMatrixCSR<ValueType>::AMGSmoothedAggregation(ValueType relax,
+                                                      const BaseVector<int>& aggregates,
+                                                      const BaseVector<int>& connections,
+                                                      BaseMatrix<ValueType>* prolong,
+                                                      BaseMatrix<ValueType>* restrict) const
 {
-    assert(this->nnz_ > 0);
-    assert(permutation != NULL);
-
-    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-    assert(cast_perm != NULL);
-
-    cast_perm->Clear();
-    cast_perm->Allocate(this->nrow_);
+    assert(prolong != NULL);
+    assert(restrict != NULL);
 
-    int next     = 0;
-    int head     = 0;
-    int tmp      = 0;
-    int test     = 1;
-    int position = 0;
-    int maxdeg   = 0;
+    const HostVector<int>* cast_agg         = dynamic_cast<const HostVector<int>*>(&aggregates);
+    const HostVector<int>* cast_conn        = dynamic_cast<const HostVector<int>*>(&connections);
+    HostMatrixCSR<ValueType>* cast_prolong  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
+    HostMatrixCSR<ValueType>* cast_restrict = dynamic_cast<HostMatrixCSR<ValueType>*>(restrict);
 
-    int* nd         = NULL;
-    int* marker     = NULL;
-    int* levset     = NULL;
-    int* nextlevset = NULL;
+    assert(cast_agg != NULL);
+    assert(cast_conn != NULL);
+    assert(cast_prolong != NULL);
+    assert(cast_restrict != NULL);
 
-    allocate_host<int>(this->nrow_, &nd);
-    allocate_host<int>(this->nrow_, &marker);
-    allocate_host<int>(this->nrow_, &levset);
-    allocate_host<int>(this->nrow_, &nextlevset);
+    // Allocate
+    cast_prolong->Clear();
+    cast_prolong->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
 
-    int qlength = 1;
+    int ncol = 0;
 
-    for(int k = 0; k < this->nrow_; ++k)
+    for(int i = 0; i < cast_agg->GetSize(); ++i)
     {
-        marker[k] = 0;
-        nd[k]     = this->mat_.row_offset[k + 1] - this->mat_.row_offset[k] - 1;
-
-        if(nd[k] > maxdeg)
+        if(cast_agg->vec_[i] > ncol)
         {
-            maxdeg = nd[k];
+            ncol = cast_agg->vec_[i];
         }
     }
 
-    head               = this->mat_.col[0];
-    levset[0]          = head;
-    cast_perm->vec_[0] = 0;
-    ++next;
-    marker[head] = 1;
+    ++ncol;
 
-    while(next < this->nrow_)
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-        position = 0;
+        std::vector<int> marker(ncol, -1);
 
-        for(int h = 0; h < qlength; ++h)
-        {
-            head = levset[h];
+#ifdef _OPENMP
+        int nt  = omp_get_num_threads();
+        int tid = omp_get_thread_num();
+
+        int chunk_size  = (this->nrow_ + nt - 1) / nt;
+        int chunk_start = tid * chunk_size;
+        int chunk_end   = std::min(this->nrow_, chunk_start + chunk_size);
+#else
+        int chunk_start = 0;
+        int chunk_end   = this->nrow_;
+#endif
 
-            for(int k = this->mat_.row_offset[head]; k < this->mat_.row_offset[head + 1]; ++k)
+        // Count number of entries in prolong
+        for(int i = chunk_start; i < chunk_end; ++i)
+        {
+            for(int j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
             {
-                tmp = this->mat_.col[k];
+                int c = this->mat_.col[j];
+
+                if(c != i && !cast_conn->vec_[j])
+                {
+                    continue;
+                }
 
-                if((marker[tmp] == 0) && (tmp != head))
+                int g = cast_agg->vec_[c];
+
+                if(g >= 0 && marker[g] != i)
                 {
-                    nextlevset[position] = tmp;
-                    marker[tmp]          = 1;
-                    cast_perm->vec_[tmp] = next;
-                    ++next;
-                    ++position;
+                    marker[g] = i;
+                    ++cast_prolong->mat_.row_offset[i + 1];
                 }
             }
         }
 
-        qlength = position;
+        std::fill(marker.begin(), marker.end(), -1);
 
-        while(test == 1)
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
         {
-            test = 0;
+            int* row_offset = NULL;
+            allocate_host(cast_prolong->nrow_ + 1, &row_offset);
+
+            int* col       = NULL;
+            ValueType* val = NULL;
+
+            int nnz  = 0;
+            int nrow = cast_prolong->nrow_;
 
-            for(int j = position - 1; j > 0; --j)
+            row_offset[0] = 0;
+            for(int i = 1; i < nrow + 1; ++i)
             {
-                if(nd[nextlevset[j]] < nd[nextlevset[j - 1]])
-                {
-                    tmp               = nextlevset[j];
-                    nextlevset[j]     = nextlevset[j - 1];
-                    nextlevset[j - 1] = tmp;
-                    test              = 1;
-                }
+                row_offset[i] = cast_prolong->mat_.row_offset[i] + row_offset[i - 1];
             }
-        }
 
-        for(int i = 0; i < position; ++i)
-        {
-            levset[i] = nextlevset[i];
+            nnz = row_offset[nrow];
+
+            allocate_host(nnz, &col);
+            allocate_host(nnz, &val);
+
+            cast_prolong->Clear();
+            cast_prolong->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
         }
 
-        if(qlength == 0)
+        // Fill the interpolation matrix.
+        for(int i = chunk_start; i < chunk_end; ++i)
         {
-            for(int i = 0; i < this->nrow_; ++i)
+            // Diagonal of the filtered matrix is original matrix diagonal minus
+            // its weak connections.
+            ValueType dia = static_cast<ValueType>(0);
+            for(int j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
             {
-                if(marker[i] == 0)
+                if(this->mat_.col[j] == i)
                 {
-                    levset[0]          = i;
-                    qlength            = 1;
-                    cast_perm->vec_[i] = next;
-                    marker[i]          = 1;
-                    ++next;
+                    dia += this->mat_.val[j];
+                }
+                else if(!cast_conn->vec_[j])
+                {
+                    dia -= this->mat_.val[j];
                 }
             }
-        }
-    }
-
-    free_host(&nd);
-    free_host(&marker);
-    free_host(&levset);
-    free_host(&nextlevset);
 
-    return true;
-}
-
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::RCMK(BaseVector<int>* permutation) const
-{
-    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-    assert(cast_perm != NULL);
-
-    cast_perm->Clear();
-    cast_perm->Allocate(this->nrow_);
-
-    HostVector<int> tmp_perm(this->local_backend_);
-
-    this->CMK(&tmp_perm);
+            dia = static_cast<ValueType>(1) / dia;
 
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        cast_perm->vec_[i] = this->nrow_ - tmp_perm.vec_[i] - 1;
-    }
+            int row_begin = cast_prolong->mat_.row_offset[i];
+            int row_end   = row_begin;
 
-    return true;
-}
+            for(int j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
+            {
+                int c = this->mat_.col[j];
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::ConnectivityOrder(BaseVector<int>* permutation) const
-{
-    HostVector<int>* cast_perm = dynamic_cast<HostVector<int>*>(permutation);
-    assert(cast_perm != NULL);
+                // Skip weak couplings, ...
+                if(c != i && !cast_conn->vec_[j])
+                {
+                    continue;
+                }
 
-    cast_perm->Clear();
-    cast_perm->Allocate(this->nrow_);
+                // ... and the ones not in any aggregate.
+                int g = cast_agg->vec_[c];
+                if(g < 0)
+                {
+                    continue;
+                }
 
-    std::multimap<int, int> map;
+                ValueType v =
+                    (c == i) ? static_cast<ValueType>(1) - relax : -relax * dia * this->mat_.val[j];
 
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        map.insert(std::pair<int, int>(this->mat_.row_offset[i + 1] - this->mat_.row_offset[i], i));
+                if(marker[g] < row_begin)
+                {
+                    marker[g]                       = row_end;
+                    cast_prolong->mat_.col[row_end] = g;
+                    cast_prolong->mat_.val[row_end] = v;
+                    ++row_end;
+                }
+                else
+                {
+                    cast_prolong->mat_.val[marker[g]] += v;
+                }
+            }
+        }
     }
 
-    std::multimap<int, int>::iterator it = map.begin();
+    cast_prolong->Sort();
 
-    for(int i = 0; i < this->nrow_; ++i, ++it)
-    {
-        cast_perm->vec_[i] = it->second;
-    }
+    cast_restrict->CopyFrom(*cast_prolong);
+    cast_restrict->Transpose();
 
     return true;
 }
 
+// ----------------------------------------------------------
+// original function interp(const sparse::matrix<value_t,
+//                          index_t> &A, const params &prm)
+// ----------------------------------------------------------
+// Modified and adapted from AMGCL,
+// https://github.com/ddemidov/amgcl
+// MIT License
+// ----------------------------------------------------------
+// CHANGELOG
+// - adapted interface
+// ----------------------------------------------------------
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map, int n, int m)
+bool HostMatrixCSR<ValueType>::AMGAggregation(const BaseVector<int>& aggregates,
+                                              BaseMatrix<ValueType>* prolong,
+                                              BaseMatrix<ValueType>* restrict) const
 {
-    assert(map.GetSize() == n);
-
-    const HostVector<int>* cast_map = dynamic_cast<const HostVector<int>*>(&map);
-
-    assert(cast_map != NULL);
+    assert(prolong != NULL);
+    assert(restrict != NULL);
 
-    int* row_nnz    = NULL;
-    int* row_buffer = NULL;
-    allocate_host<int>(m, &row_nnz);
-    allocate_host<int>(m + 1, &row_buffer);
+    const HostVector<int>* cast_agg         = dynamic_cast<const HostVector<int>*>(&aggregates);
+    HostMatrixCSR<ValueType>* cast_prolong  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
+    HostMatrixCSR<ValueType>* cast_restrict = dynamic_cast<HostMatrixCSR<ValueType>*>(restrict);
 
-    set_to_zero_host(m, row_nnz);
+    assert(cast_agg != NULL);
+    assert(cast_prolong != NULL);
+    assert(cast_restrict != NULL);
 
-    int nnz = 0;
+    int ncol = 0;
 
-    for(int i = 0; i < n; ++i)
+    for(int i = 0; i < cast_agg->GetSize(); ++i)
     {
-        assert(cast_map->vec_[i] < m);
-
-        if(cast_map->vec_[i] < 0)
+        if(cast_agg->vec_[i] > ncol)
         {
-            continue;
+            ncol = cast_agg->vec_[i];
         }
-
-        ++row_nnz[cast_map->vec_[i]];
-        ++nnz;
     }
 
-    this->Clear();
-    this->AllocateCSR(nnz, m, n);
+    ++ncol;
 
-    this->mat_.row_offset[0] = 0;
-    row_buffer[0]            = 0;
+    int* row_offset = NULL;
+    allocate_host(this->nrow_ + 1, &row_offset);
 
-    for(int i = 0; i < m; ++i)
+    int* col       = NULL;
+    ValueType* val = NULL;
+
+    row_offset[0] = 0;
+    for(int i = 0; i < this->nrow_; ++i)
     {
-        this->mat_.row_offset[i + 1] = this->mat_.row_offset[i] + row_nnz[i];
-        row_buffer[i + 1]            = this->mat_.row_offset[i + 1];
+        if(cast_agg->vec_[i] >= 0)
+        {
+            row_offset[i + 1] = row_offset[i] + 1;
+        }
+        else
+        {
+            row_offset[i + 1] = row_offset[i];
+        }
     }
 
-    for(int i = 0; i < nnz; ++i)
+    allocate_host(row_offset[this->nrow_], &col);
+    allocate_host(row_offset[this->nrow_], &val);
+
+    for(int i = 0, j = 0; i < this->nrow_; ++i)
     {
-        if(cast_map->vec_[i] < 0)
+        if(cast_agg->vec_[i] >= 0)
         {
-            continue;
+            col[j] = cast_agg->vec_[i];
+            val[j] = 1.0;
+            ++j;
         }
-
-        this->mat_.col[row_buffer[cast_map->vec_[i]]] = i;
-        this->mat_.val[i]                             = static_cast<ValueType>(1);
-        row_buffer[cast_map->vec_[i]]++;
     }
 
-    assert(this->mat_.row_offset[m] == nnz);
+    cast_prolong->Clear();
+    cast_prolong->SetDataPtrCSR(
+        &row_offset, &col, &val, row_offset[this->nrow_], this->nrow_, ncol);
 
-    free_host<int>(&row_nnz);
-    free_host<int>(&row_buffer);
+    cast_restrict->CopyFrom(*cast_prolong);
+    cast_restrict->Transpose();
 
     return true;
 }
 
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::CreateFromMap(const BaseVector<int>& map,
-                                             int n,
-                                             int m,
-                                             BaseMatrix<ValueType>* pro)
+bool HostMatrixCSR<ValueType>::FSAI(int power, const BaseMatrix<ValueType>* pattern)
 {
-    assert(map.GetSize() == n);
-    assert(pro != NULL);
-
-    const HostVector<int>* cast_map    = dynamic_cast<const HostVector<int>*>(&map);
-    HostMatrixCSR<ValueType>* cast_pro = dynamic_cast<HostMatrixCSR<ValueType>*>(pro);
-
-    assert(cast_pro != NULL);
-    assert(cast_map != NULL);
+    // Extract lower triangular matrix of A
+    HostMatrixCSR<ValueType> L(this->local_backend_);
 
-    // Build restriction operator
-    this->CreateFromMap(map, n, m);
+    const HostMatrixCSR<ValueType>* cast_pattern = NULL;
+    if(pattern != NULL)
+    {
+        cast_pattern = dynamic_cast<const HostMatrixCSR<ValueType>*>(pattern);
+        assert(cast_pattern != NULL);
 
-    int nnz = this->GetNnz();
+        cast_pattern->ExtractLDiagonal(&L);
+    }
+    else if(power > 1)
+    {
+        HostMatrixCSR<ValueType> structure(this->local_backend_);
+        structure.CopyFrom(*this);
+        structure.SymbolicPower(power);
+        structure.ExtractLDiagonal(&L);
+    }
+    else
+    {
+        this->ExtractLDiagonal(&L);
+    }
 
-    // Build prolongation operator
-    cast_pro->Clear();
-    cast_pro->AllocateCSR(nnz, n, m);
+    int nnz         = L.nnz_;
+    int nrow        = L.nrow_;
+    int ncol        = L.ncol_;
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
 
-    int k = 0;
+    L.LeaveDataPtrCSR(&row_offset, &col, &val);
 
-    for(int i = 0; i < n; ++i)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int ai = 0; ai < this->nrow_; ++ai)
     {
-        cast_pro->mat_.row_offset[i + 1] = cast_pro->mat_.row_offset[i];
+        // entries of ai-th row
+        int nnz_row = row_offset[ai + 1] - row_offset[ai];
 
-        // Check for entry in i-th row
-        if(cast_map->vec_[i] < 0)
+        if(nnz_row == 1)
         {
-            continue;
+            int aj = this->mat_.row_offset[ai];
+            if(this->mat_.col[aj] == ai)
+            {
+                val[row_offset[ai]] = static_cast<ValueType>(1) / this->mat_.val[aj];
+            }
         }
+        else
+        {
+            // create submatrix taking only the lower tridiagonal part into account
+            std::vector<ValueType> Asub(nnz_row * nnz_row, static_cast<ValueType>(0));
 
-        assert(cast_map->vec_[i] < m);
+            for(int k = 0; k < nnz_row; ++k)
+            {
+                int row_begin = this->mat_.row_offset[col[row_offset[ai] + k]];
+                int row_end   = this->mat_.row_offset[col[row_offset[ai] + k] + 1];
 
-        ++cast_pro->mat_.row_offset[i + 1];
-        cast_pro->mat_.col[k] = cast_map->vec_[i];
-        cast_pro->mat_.val[k] = static_cast<ValueType>(1);
-        ++k;
-    }
+                for(int aj = row_begin; aj < row_end; ++aj)
+                {
+                    for(int j = 0; j < nnz_row; ++j)
+                    {
+                        int Asub_col = col[row_offset[ai] + j];
 
-    return true;
-}
+                        if(this->mat_.col[aj] < Asub_col)
+                        {
+                            break;
+                        }
 
-// ----------------------------------------------------------
-// original function connect(const spmat &A,
-//                           float eps_strong)
-// ----------------------------------------------------------
-// Modified and adapted from AMGCL,
-// https://github.com/ddemidov/amgcl
-// MIT License
-// ----------------------------------------------------------
-// CHANGELOG
-// - adapted interface
-// ----------------------------------------------------------
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::AMGConnect(ValueType eps, BaseVector<int>* connections) const
-{
-    assert(connections != NULL);
+                        if(this->mat_.col[aj] == Asub_col)
+                        {
+                            Asub[j + k * nnz_row] = this->mat_.val[aj];
+                            break;
+                        }
+                    }
 
-    HostVector<int>* cast_conn = dynamic_cast<HostVector<int>*>(connections);
-    assert(cast_conn != NULL);
+                    if(this->mat_.col[aj] == ai)
+                    {
+                        break;
+                    }
+                }
+            }
 
-    cast_conn->Clear();
-    cast_conn->Allocate(this->nnz_);
+            std::vector<ValueType> mk(nnz_row, static_cast<ValueType>(0));
+            mk[nnz_row - 1] = static_cast<ValueType>(1);
 
-    ValueType eps2 = eps * eps;
+            // compute inplace LU factorization of Asub
+            for(int i = 0; i < nnz_row - 1; ++i)
+            {
+                for(int k = i + 1; k < nnz_row; ++k)
+                {
+                    Asub[i + k * nnz_row] /= Asub[i + i * nnz_row];
 
-    HostVector<ValueType> vec_diag(this->local_backend_);
-    vec_diag.Allocate(this->nrow_);
-    this->ExtractDiagonal(&vec_diag);
+                    for(int j = i + 1; j < nnz_row; ++j)
+                    {
+                        Asub[j + k * nnz_row] -= Asub[i + k * nnz_row] * Asub[j + i * nnz_row];
+                    }
+                }
+            }
+
+            // backward sweeps
+            for(int i = nnz_row - 1; i >= 0; --i)
+            {
+                mk[i] /= Asub[i + i * nnz_row];
+
+                for(int j = 0; j < i; ++j)
+                {
+                    mk[j] -= mk[i] * Asub[i + j * nnz_row];
+                }
+            }
+
+            // update the preconditioner matrix with mk
+            for(int aj = row_offset[ai], k = 0; aj < row_offset[ai + 1]; ++aj, ++k)
+            {
+                val[aj] = mk[k];
+            }
+        }
+    }
 
+// Scaling
 #ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
+#pragma omp parallel for
 #endif
-    for(int i = 0; i < this->nrow_; ++i)
+    for(int ai = 0; ai < nrow; ++ai)
     {
-        ValueType eps_dia_i = eps2 * vec_diag.vec_[i];
+        ValueType fac =
+            sqrt(static_cast<ValueType>(1) / rocalution_abs(val[row_offset[ai + 1] - 1]));
 
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        for(int aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
         {
-            int c       = this->mat_.col[j];
-            ValueType v = this->mat_.val[j];
-
-            cast_conn->vec_[j] = (c != i) && (v * v > eps_dia_i * vec_diag.vec_[c]);
+            val[aj] *= fac;
         }
     }
 
+    this->Clear();
+    this->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
+
     return true;
 }
 
-// ----------------------------------------------------------
-// original function aggregates( const spmat &A,
-//                               const std::vector<char> &S )
-// ----------------------------------------------------------
-// Modified and adapted from AMGCL,
-// https://github.com/ddemidov/amgcl
-// MIT License
-// ----------------------------------------------------------
-// CHANGELOG
-// - adapted interface
-// ----------------------------------------------------------
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::AMGAggregate(const BaseVector<int>& connections,
-                                            BaseVector<int>* aggregates) const
+bool HostMatrixCSR<ValueType>::SPAI(void)
 {
-    assert(aggregates != NULL);
-
-    HostVector<int>* cast_agg        = dynamic_cast<HostVector<int>*>(aggregates);
-    const HostVector<int>* cast_conn = dynamic_cast<const HostVector<int>*>(&connections);
-
-    assert(cast_agg != NULL);
-    assert(cast_conn != NULL);
+    int nrow = this->nrow_;
+    int nnz  = this->nnz_;
 
-    aggregates->Clear();
-    aggregates->Allocate(this->nrow_);
+    ValueType* val = NULL;
+    allocate_host(nnz, &val);
 
-    const int undefined = -1;
-    const int removed   = -2;
+    HostMatrixCSR<ValueType> T(this->local_backend_);
+    T.CopyFrom(*this);
+    this->Transpose();
 
-    // Remove nodes without neighbours
-    int max_neib = 0;
-    for(int i = 0; i < this->nrow_; ++i)
+// Loop over each row to get J indexing vector
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
     {
-        int j = this->mat_.row_offset[i];
-        int e = this->mat_.row_offset[i + 1];
+        int* J    = NULL;
+        int Jsize = this->mat_.row_offset[i + 1] - this->mat_.row_offset[i];
+        allocate_host(Jsize, &J);
+        std::vector<int> I;
 
-        max_neib = std::max(e - j, max_neib);
+        // Setup J = {j | m(j) != 0}
+        for(int j = this->mat_.row_offset[i], idx = 0; j < this->mat_.row_offset[i + 1]; ++j, ++idx)
+        {
+            J[idx] = this->mat_.col[j];
+        }
 
-        int state = removed;
-        for(; j < e; ++j)
+        // Setup I = {i | row A(i,J) != 0}
+        for(int idx = 0; idx < Jsize; ++idx)
         {
-            if(cast_conn->vec_[j])
+            for(int j = this->mat_.row_offset[J[idx]]; j < this->mat_.row_offset[J[idx] + 1]; ++j)
             {
-                state = undefined;
-                break;
+                if(std::find(I.begin(), I.end(), this->mat_.col[j]) == I.end())
+                {
+                    I.push_back(this->mat_.col[j]);
+                }
             }
         }
 
-        cast_agg->vec_[i] = state;
-    }
-
-    std::vector<int> neib;
-    neib.reserve(max_neib);
-
-    int last_g = -1;
+        // Build dense matrix
+        HostMatrixDENSE<ValueType> Asub(this->local_backend_);
+        Asub.AllocateDENSE(int(I.size()), Jsize);
 
-    // Perform plain aggregation
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        if(cast_agg->vec_[i] != undefined)
+        for(int k = 0; k < Asub.nrow_; ++k)
         {
-            continue;
+            for(int aj = T.mat_.row_offset[I[k]]; aj < T.mat_.row_offset[I[k] + 1]; ++aj)
+            {
+                for(int j = 0; j < Jsize; ++j)
+                {
+                    if(T.mat_.col[aj] == J[j])
+                    {
+                        Asub.mat_.val[DENSE_IND(k, j, Asub.nrow_, Asub.ncol_)] = T.mat_.val[aj];
+                    }
+                }
+            }
         }
 
-        // The point is not adjacent to a core of any previous aggregate:
-        // so its a seed of a new aggregate.
-        cast_agg->vec_[i] = ++last_g;
+        // QR Decomposition of dense submatrix Ak
+        Asub.QRDecompose();
 
-        neib.clear();
+        // Solve least squares
+        HostVector<ValueType> ek(this->local_backend_);
+        HostVector<ValueType> mk(this->local_backend_);
 
-        // Include its neighbors as well.
-        for(int j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
+        ek.Allocate(Asub.nrow_);
+        mk.Allocate(Asub.ncol_);
+
+        for(int j = 0; j < ek.GetSize(); ++j)
         {
-            int c = this->mat_.col[j];
-            if(cast_conn->vec_[j] && cast_agg->vec_[c] != removed)
+            if(I[j] == i)
             {
-                cast_agg->vec_[c] = last_g;
-                neib.push_back(c);
+                ek.vec_[j] = 1.0;
             }
         }
 
-        // Temporarily mark undefined points adjacent to the new aggregate as
-        // belonging to the aggregate. If nobody claims them later, they will
-        // stay here.
-        for(typename std::vector<int>::const_iterator nb = neib.begin(); nb != neib.end(); ++nb)
+        Asub.QRSolve(ek, &mk);
+
+        // Write m_k into preconditioner matrix
+        for(int j = 0; j < Jsize; ++j)
         {
-            for(int j = this->mat_.row_offset[*nb], e = this->mat_.row_offset[*nb + 1]; j < e; ++j)
-            {
-                if(cast_conn->vec_[j] && cast_agg->vec_[this->mat_.col[j]] == undefined)
-                {
-                    cast_agg->vec_[this->mat_.col[j]] = last_g;
-                }
-            }
+            val[this->mat_.row_offset[i] + j] = mk.vec_[j];
         }
+
+        // Clear index vectors
+        I.clear();
+        ek.Clear();
+        mk.Clear();
+        Asub.Clear();
+        free_host(&J);
     }
 
+    // Only reset value array since we keep the sparsity pattern of A
+    free_host(&this->mat_.val);
+    this->mat_.val = val;
+
+    this->Transpose();
+
     return true;
 }
 
-// ----------------------------------------------------------
-// original function interp(const sparse::matrix<value_t,
-//                          index_t> &A, const params &prm)
-// ----------------------------------------------------------
-// Modified and adapted from AMGCL,
-// https://github.com/ddemidov/amgcl
-// MIT License
-// ----------------------------------------------------------
-// CHANGELOG
-// - adapted interface
-// ----------------------------------------------------------
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::AMGSmoothedAggregation(ValueType relax,
-                                                      const BaseVector<int>& aggregates,
-                                                      const BaseVector<int>& connections,
-                                                      BaseMatrix<ValueType>* prolong,
-                                                      BaseMatrix<ValueType>* restrict) const
+// Random tie-breaker in [0, 1) of the PMIS weights, independent of the thread schedule
+static inline double rs_random(int i)
 {
-    assert(prolong != NULL);
-    assert(restrict != NULL);
-
-    const HostVector<int>* cast_agg         = dynamic_cast<const HostVector<int>*>(&aggregates);
-    const HostVector<int>* cast_conn        = dynamic_cast<const HostVector<int>*>(&connections);
-    HostMatrixCSR<ValueType>* cast_prolong  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
-    HostMatrixCSR<ValueType>* cast_restrict = dynamic_cast<HostMatrixCSR<ValueType>*>(restrict);
+    unsigned int x = murmur3_fmix32(static_cast<unsigned int>(i) * 2654435761u);
 
-    assert(cast_agg != NULL);
-    assert(cast_conn != NULL);
-    assert(cast_prolong != NULL);
-    assert(cast_restrict != NULL);
+    return static_cast<double>(x) / 4294967296.0;
+}
 
-    // Allocate
-    cast_prolong->Clear();
-    cast_prolong->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
+// Classical Ruge Stueben C/F splitting of the rows [begin, end), taking only strong
+// couplings within the range into account. S_val marks the strong couplings in the
+// pattern of A, ST_row_offset / ST_col hold the transposed strength matrix. connect is
+// -1 for undecided, 0 for F and 1 for C points.
+static void rs_classic_split(int begin,
+                             int end,
+                             const int* row_offset,
+                             const int* col,
+                             const int* S_val,
+                             const int* ST_row_offset,
+                             const int* ST_col,
+                             int* connect)
+{
+    int n = end - begin;
 
-    int ncol = 0;
+    std::vector<int> lambda(n);
+    int max_lambda = 0;
 
-    for(int i = 0; i < cast_agg->GetSize(); ++i)
+    for(int i = 0; i < n; ++i)
     {
-        if(cast_agg->vec_[i] > ncol)
+        int temp = 0;
+        for(int j = ST_row_offset[begin + i]; j < ST_row_offset[begin + i + 1]; ++j)
         {
-            ncol = cast_agg->vec_[i];
+            int c = ST_col[j];
+
+            if(c < begin || c >= end)
+            {
+                continue;
+            }
+
+            temp += (connect[c] == -1 ? 1 : 2);
         }
+
+        lambda[i]  = temp;
+        max_lambda = std::max(max_lambda, temp);
     }
 
-    ++ncol;
+    int size = std::max(n, max_lambda + 1);
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
+    std::vector<int> ptr(size + 1, static_cast<int>(0));
+    std::vector<int> cnt(size, static_cast<int>(0));
+    std::vector<int> i2n(n);
+    std::vector<int> n2i(n);
+
+    for(int i = 0; i < n; ++i)
     {
-        std::vector<int> marker(ncol, -1);
+        ptr[lambda[i] + 1]++;
+    }
 
-#ifdef _OPENMP
-        int nt  = omp_get_num_threads();
-        int tid = omp_get_thread_num();
+    for(unsigned int i = 1; i < ptr.size(); ++i)
+    {
+        ptr[i] += ptr[i - 1];
+    }
 
-        int chunk_size  = (this->nrow_ + nt - 1) / nt;
-        int chunk_start = tid * chunk_size;
-        int chunk_end   = std::min(this->nrow_, chunk_start + chunk_size);
-#else
-        int chunk_start = 0;
-        int chunk_end   = this->nrow_;
-#endif
+    for(int i = 0; i < n; ++i)
+    {
+        int lam  = lambda[i];
+        int idx  = ptr[lam] + cnt[lam]++;
+        i2n[idx] = i;
+        n2i[i]   = idx;
+    }
 
-        // Count number of entries in prolong
-        for(int i = chunk_start; i < chunk_end; ++i)
+    for(int top = n - 1; top >= 0; --top)
+    {
+        int i   = i2n[top];
+        int lam = lambda[i];
+
+        if(lam == 0)
         {
-            for(int j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
+            for(int ai = begin; ai < end; ++ai)
             {
-                int c = this->mat_.col[j];
-
-                if(c != i && !cast_conn->vec_[j])
-                {
-                    continue;
-                }
-
-                int g = cast_agg->vec_[c];
-
-                if(g >= 0 && marker[g] != i)
+                if(connect[ai] == -1)
                 {
-                    marker[g] = i;
-                    ++cast_prolong->mat_.row_offset[i + 1];
+                    connect[ai] = 1;
                 }
             }
+
+            break;
         }
 
-        std::fill(marker.begin(), marker.end(), -1);
+        cnt[lam]--;
 
-#ifdef _OPENMP
-#pragma omp barrier
-#pragma omp single
-#endif
+        if(connect[begin + i] == 0)
         {
-            int* row_offset = NULL;
-            allocate_host(cast_prolong->nrow_ + 1, &row_offset);
-
-            int* col       = NULL;
-            ValueType* val = NULL;
-
-            int nnz  = 0;
-            int nrow = cast_prolong->nrow_;
-
-            row_offset[0] = 0;
-            for(int i = 1; i < nrow + 1; ++i)
-            {
-                row_offset[i] = cast_prolong->mat_.row_offset[i] + row_offset[i - 1];
-            }
-
-            nnz = row_offset[nrow];
+            continue;
+        }
 
-            allocate_host(nnz, &col);
-            allocate_host(nnz, &val);
+        assert(connect[begin + i] == -1);
 
-            cast_prolong->Clear();
-            cast_prolong->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
-        }
+        connect[begin + i] = 1;
 
-        // Fill the interpolation matrix.
-        for(int i = chunk_start; i < chunk_end; ++i)
+        for(int j = ST_row_offset[begin + i]; j < ST_row_offset[begin + i + 1]; ++j)
         {
-            // Diagonal of the filtered matrix is original matrix diagonal minus
-            // its weak connections.
-            ValueType dia = static_cast<ValueType>(0);
-            for(int j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
+            int c = ST_col[j];
+
+            if(c < begin || c >= end || connect[c] != -1)
             {
-                if(this->mat_.col[j] == i)
-                {
-                    dia += this->mat_.val[j];
-                }
-                else if(!cast_conn->vec_[j])
-                {
-                    dia -= this->mat_.val[j];
-                }
+                continue;
             }
 
-            dia = static_cast<ValueType>(1) / dia;
-
-            int row_begin = cast_prolong->mat_.row_offset[i];
-            int row_end   = row_begin;
+            connect[c] = 0;
 
-            for(int j = this->mat_.row_offset[i], e = this->mat_.row_offset[i + 1]; j < e; ++j)
+            for(int jj = row_offset[c]; jj < row_offset[c + 1]; ++jj)
             {
-                int c = this->mat_.col[j];
-
-                // Skip weak couplings, ...
-                if(c != i && !cast_conn->vec_[j])
-                {
-                    continue;
-                }
-
-                // ... and the ones not in any aggregate.
-                int g = cast_agg->vec_[c];
-                if(g < 0)
+                if(!S_val[jj])
                 {
                     continue;
                 }
 
-                ValueType v =
-                    (c == i) ? static_cast<ValueType>(1) - relax : -relax * dia * this->mat_.val[j];
+                int cc = col[jj];
 
-                if(marker[g] < row_begin)
-                {
-                    marker[g]                       = row_end;
-                    cast_prolong->mat_.col[row_end] = g;
-                    cast_prolong->mat_.val[row_end] = v;
-                    ++row_end;
-                }
-                else
+                if(cc < begin || cc >= end)
                 {
-                    cast_prolong->mat_.val[marker[g]] += v;
+                    continue;
                 }
-            }
-        }
-    }
 
-    cast_prolong->Sort();
+                int lam_cc = lambda[cc - begin];
 
-    cast_restrict->CopyFrom(*cast_prolong);
-    cast_restrict->Transpose();
+                if(connect[cc] != -1 || lam_cc >= n - 1)
+                {
+                    continue;
+                }
 
-    return true;
-}
+                int old_pos = n2i[cc - begin];
+                int new_pos = ptr[lam_cc] + cnt[lam_cc] - 1;
 
-// ----------------------------------------------------------
-// original function interp(const sparse::matrix<value_t,
-//                          index_t> &A, const params &prm)
-// ----------------------------------------------------------
-// Modified and adapted from AMGCL,
-// https://github.com/ddemidov/amgcl
-// MIT License
-// ----------------------------------------------------------
-// CHANGELOG
-// - adapted interface
-// ----------------------------------------------------------
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::AMGAggregation(const BaseVector<int>& aggregates,
-                                              BaseMatrix<ValueType>* prolong,
-                                              BaseMatrix<ValueType>* restrict) const
-{
-    assert(prolong != NULL);
-    assert(restrict != NULL);
+                n2i[i2n[old_pos]] = new_pos;
+                n2i[i2n[new_pos]] = old_pos;
 
-    const HostVector<int>* cast_agg         = dynamic_cast<const HostVector<int>*>(&aggregates);
-    HostMatrixCSR<ValueType>* cast_prolong  = dynamic_cast<HostMatrixCSR<ValueType>*>(prolong);
-    HostMatrixCSR<ValueType>* cast_restrict = dynamic_cast<HostMatrixCSR<ValueType>*>(restrict);
+                std::swap(i2n[old_pos], i2n[new_pos]);
 
-    assert(cast_agg != NULL);
-    assert(cast_prolong != NULL);
-    assert(cast_restrict != NULL);
+                --cnt[lam_cc];
+                ++cnt[lam_cc + 1];
+                ptr[lam_cc + 1] = ptr[lam_cc] + cnt[lam_cc];
 
-    int ncol = 0;
+                ++lambda[cc - begin];
+            }
+        }
 
-    for(int i = 0; i < cast_agg->GetSize(); ++i)
-    {
-        if(cast_agg->vec_[i] > ncol)
+        for(int j = row_offset[begin + i]; j < row_offset[begin + i + 1]; ++j)
         {
-            ncol = cast_agg->vec_[i];
-        }
-    }
+            if(!S_val[j])
+            {
+                continue;
+            }
 
-    ++ncol;
+            int c = col[j];
 
-    int* row_offset = NULL;
-    allocate_host(this->nrow_ + 1, &row_offset);
+            if(c < begin || c >= end)
+            {
+                continue;
+            }
 
-    int* col       = NULL;
-    ValueType* val = NULL;
+            int lam = lambda[c - begin];
 
-    row_offset[0] = 0;
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        if(cast_agg->vec_[i] >= 0)
-        {
-            row_offset[i + 1] = row_offset[i] + 1;
-        }
-        else
-        {
-            row_offset[i + 1] = row_offset[i];
-        }
-    }
+            if(connect[c] != -1 || lam == 0)
+            {
+                continue;
+            }
 
-    allocate_host(row_offset[this->nrow_], &col);
-    allocate_host(row_offset[this->nrow_], &val);
+            int old_pos = n2i[c - begin];
+            int new_pos = ptr[lam];
 
-    for(int i = 0, j = 0; i < this->nrow_; ++i)
-    {
-        if(cast_agg->vec_[i] >= 0)
-        {
-            col[j] = cast_agg->vec_[i];
-            val[j] = 1.0;
-            ++j;
-        }
-    }
+            n2i[i2n[old_pos]] = new_pos;
+            n2i[i2n[new_pos]] = old_pos;
 
-    cast_prolong->Clear();
-    cast_prolong->SetDataPtrCSR(
-        &row_offset, &col, &val, row_offset[this->nrow_], this->nrow_, ncol);
+            std::swap(i2n[old_pos], i2n[new_pos]);
 
-    cast_restrict->CopyFrom(*cast_prolong);
-    cast_restrict->Transpose();
+            --cnt[lam];
+            ++cnt[lam - 1];
+            ++ptr[lam];
+            --lambda[c - begin];
 
-    return true;
+            assert(ptr[lam - 1] == ptr[lam] - cnt[lam - 1]);
+        }
+    }
 }
 
-template <typename ValueType>
-bool HostMatrixCSR<ValueType>::FSAI(int power, const BaseMatrix<ValueType>* pattern)
+// Parallel modified independent set (PMIS) C/F splitting. Undecided points, that strongly
+// depend on a C point, become F points. Undecided points with a larger weight (number of
+// points that strongly depend on it, plus a random number) than all their undecided
+// strong neighbours become C points. Points that do not influence any other point become
+// F points. C points that are already set in connect are kept.
+static void rs_pmis_split(int nrow,
+                          const int* row_offset,
+                          const int* col,
+                          const int* S_val,
+                          const int* ST_row_offset,
+                          const int* ST_col,
+                          int* connect)
 {
-    // Extract lower triangular matrix of A
-    HostMatrixCSR<ValueType> L(this->local_backend_);
+    std::vector<double> weight(nrow);
+    std::vector<int> select(nrow);
 
-    const HostMatrixCSR<ValueType>* cast_pattern = NULL;
-    if(pattern != NULL)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
     {
-        cast_pattern = dynamic_cast<const HostMatrixCSR<ValueType>*>(pattern);
-        assert(cast_pattern != NULL);
+        weight[i] = static_cast<double>(ST_row_offset[i + 1] - ST_row_offset[i]) + rs_random(i);
 
-        cast_pattern->ExtractLDiagonal(&L);
-    }
-    else if(power > 1)
-    {
-        HostMatrixCSR<ValueType> structure(this->local_backend_);
-        structure.CopyFrom(*this);
-        structure.SymbolicPower(power);
-        structure.ExtractLDiagonal(&L);
-    }
-    else
-    {
-        this->ExtractLDiagonal(&L);
+        if(connect[i] == -1 && ST_row_offset[i + 1] == ST_row_offset[i])
+        {
+            connect[i] = 0;
+        }
     }
 
-    int nnz         = L.nnz_;
-    int nrow        = L.nrow_;
-    int ncol        = L.ncol_;
-    int* row_offset = NULL;
-    int* col        = NULL;
-    ValueType* val  = NULL;
-
-    L.LeaveDataPtrCSR(&row_offset, &col, &val);
+    while(true)
+    {
+        int undecided = 0;
 
+        // F points
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for reduction(+ : undecided)
 #endif
-    for(int ai = 0; ai < this->nrow_; ++ai)
-    {
-        // entries of ai-th row
-        int nnz_row = row_offset[ai + 1] - row_offset[ai];
-
-        if(nnz_row == 1)
+        for(int i = 0; i < nrow; ++i)
         {
-            int aj = this->mat_.row_offset[ai];
-            if(this->mat_.col[aj] == ai)
+            if(connect[i] != -1)
             {
-                val[row_offset[ai]] = static_cast<ValueType>(1) / this->mat_.val[aj];
+                continue;
             }
-        }
-        else
-        {
-            // create submatrix taking only the lower tridiagonal part into account
-            std::vector<ValueType> Asub(nnz_row * nnz_row, static_cast<ValueType>(0));
 
-            for(int k = 0; k < nnz_row; ++k)
+            for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
             {
-                int row_begin = this->mat_.row_offset[col[row_offset[ai] + k]];
-                int row_end   = this->mat_.row_offset[col[row_offset[ai] + k] + 1];
-
-                for(int aj = row_begin; aj < row_end; ++aj)
+                if(S_val[j] && connect[col[j]] == 1)
                 {
-                    for(int j = 0; j < nnz_row; ++j)
-                    {
-                        int Asub_col = col[row_offset[ai] + j];
+                    connect[i] = 0;
+                    break;
+                }
+            }
 
-                        if(this->mat_.col[aj] < Asub_col)
-                        {
-                            break;
-                        }
+            if(connect[i] == -1)
+            {
+                ++undecided;
+            }
+        }
 
-                        if(this->mat_.col[aj] == Asub_col)
-                        {
-                            Asub[j + k * nnz_row] = this->mat_.val[aj];
-                            break;
-                        }
-                    }
+        if(undecided == 0)
+        {
+            break;
+        }
 
-                    if(this->mat_.col[aj] == ai)
-                    {
-                        break;
-                    }
-                }
+        // C points, ties are broken by the index
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            select[i] = 0;
+
+            if(connect[i] != -1)
+            {
+                continue;
             }
 
-            std::vector<ValueType> mk(nnz_row, static_cast<ValueType>(0));
-            mk[nnz_row - 1] = static_cast<ValueType>(1);
+            bool max = true;
 
-            // compute inplace LU factorization of Asub
-            for(int i = 0; i < nnz_row - 1; ++i)
+            for(int j = row_offset[i]; j < row_offset[i + 1] && max == true; ++j)
             {
-                for(int k = i + 1; k < nnz_row; ++k)
-                {
-                    Asub[i + k * nnz_row] /= Asub[i + i * nnz_row];
+                int c = col[j];
 
-                    for(int j = i + 1; j < nnz_row; ++j)
-                    {
-                        Asub[j + k * nnz_row] -= Asub[i + k * nnz_row] * Asub[j + i * nnz_row];
-                    }
+                if(S_val[j] && connect[c] == -1 &&
+                   (weight[c] > weight[i] || (weight[c] == weight[i] && c > i)))
+                {
+                    max = false;
                 }
             }
 
-            // backward sweeps
-            for(int i = nnz_row - 1; i >= 0; --i)
+            for(int j = ST_row_offset[i]; j < ST_row_offset[i + 1] && max == true; ++j)
             {
-                mk[i] /= Asub[i + i * nnz_row];
+                int c = ST_col[j];
 
-                for(int j = 0; j < i; ++j)
+                if(connect[c] == -1 &&
+                   (weight[c] > weight[i] || (weight[c] == weight[i] && c > i)))
                 {
-                    mk[j] -= mk[i] * Asub[i + j * nnz_row];
+                    max = false;
                 }
             }
 
-            // update the preconditioner matrix with mk
-            for(int aj = row_offset[ai], k = 0; aj < row_offset[ai + 1]; ++aj, ++k)
+            select[i] = (max == true);
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            if(select[i] == 1)
             {
-                val[aj] = mk[k];
+                connect[i] = 1;
             }
         }
     }
+}
+
+// HMIS C/F splitting. The classical splitting is applied to blocks of rows independently
+// and in parallel, its C points are the initial C points of the PMIS splitting.
+static void rs_hmis_split(int nrow,
+                          const int* row_offset,
+                          const int* col,
+                          const int* S_val,
+                          const int* ST_row_offset,
+                          const int* ST_col,
+                          int* connect)
+{
+    std::vector<int> first(connect, connect + nrow);
+
+    int nblock = (nrow - 1) / RS_HMIS_BLOCK_ROWS + 1;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(int b = 0; b < nblock; ++b)
+    {
+        rs_classic_split(b * RS_HMIS_BLOCK_ROWS,
+                         std::min((b + 1) * RS_HMIS_BLOCK_ROWS, nrow),
+                         row_offset,
+                         col,
+                         S_val,
+                         ST_row_offset,
+                         ST_col,
+                         first.data());
+    }
 
-// Scaling
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
-    for(int ai = 0; ai < nrow; ++ai)
+    for(int i = 0; i < nrow; ++i)
     {
-        ValueType fac =
-            sqrt(static_cast<ValueType>(1) / rocalution_abs(val[row_offset[ai + 1] - 1]));
-
-        for(int aj = row_offset[ai]; aj < row_offset[ai + 1]; ++aj)
+        if(connect[i] == -1 && first[i] == 1)
         {
-            val[aj] *= fac;
+            connect[i] = 1;
         }
     }
 
-    this->Clear();
-    this->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, ncol);
+    rs_pmis_split(nrow, row_offset, col, S_val, ST_row_offset, ST_col, connect);
+}
 
-    return true;
+template <typename ValueType>
+static bool rs_pair_less(const std::pair<int, ValueType>& lhs, const std::pair<int, ValueType>& rhs)
+{
+    return lhs.first < rhs.first;
 }
 
+// Drop interpolation weights smaller than trunc_factor times the largest weight of each
+// row, and keep at most trunc_max_elements weights per row. The remaining weights are
+// scaled such that the row sums are preserved.
 template <typename ValueType>
-bool HostMatrixCSR<ValueType>::SPAI(void)
+static void rs_truncate(ValueType trunc_factor,
+                        int trunc_max_elements,
+                        int nrow,
+                        MatrixCSR<ValueType, int>* P,
+                        int* nnz)
 {
-    int nrow = this->nrow_;
-    int nnz  = this->nnz_;
+    double factor = static_cast<double>(rocalution_abs(trunc_factor));
 
-    ValueType* val = NULL;
-    allocate_host(nnz, &val);
+    std::vector<char> keep(*nnz, 0);
+    std::vector<ValueType> scale(nrow, static_cast<ValueType>(1));
 
-    HostMatrixCSR<ValueType> T(this->local_backend_);
-    T.CopyFrom(*this);
-    this->Transpose();
+    int* row_offset = NULL;
+    allocate_host(nrow + 1, &row_offset);
+
+    row_offset[0] = 0;
 
-// Loop over each row to get J indexing vector
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel
 #endif
-    for(int i = 0; i < nrow; ++i)
     {
-        int* J    = NULL;
-        int Jsize = this->mat_.row_offset[i + 1] - this->mat_.row_offset[i];
-        allocate_host(Jsize, &J);
-        std::vector<int> I;
+        std::vector<std::pair<double, int>> cand;
 
-        // Setup J = {j | m(j) != 0}
-        for(int j = this->mat_.row_offset[i], idx = 0; j < this->mat_.row_offset[i + 1]; ++j, ++idx)
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < nrow; ++i)
         {
-            J[idx] = this->mat_.col[j];
-        }
+            int row_begin = P->row_offset[i];
+            int row_end   = P->row_offset[i + 1];
 
-        // Setup I = {i | row A(i,J) != 0}
-        for(int idx = 0; idx < Jsize; ++idx)
-        {
-            for(int j = this->mat_.row_offset[J[idx]]; j < this->mat_.row_offset[J[idx] + 1]; ++j)
+            double amax = 0.0;
+
+            for(int j = row_begin; j < row_end; ++j)
             {
-                if(std::find(I.begin(), I.end(), this->mat_.col[j]) == I.end())
-                {
-                    I.push_back(this->mat_.col[j]);
-                }
+                amax = std::max(amax, static_cast<double>(rocalution_abs(P->val[j])));
             }
-        }
 
-        // Build dense matrix
-        HostMatrixDENSE<ValueType> Asub(this->local_backend_);
-        Asub.AllocateDENSE(int(I.size()), Jsize);
+            // Candidates by descending magnitude, ties by position
+            cand.clear();
 
-        for(int k = 0; k < Asub.nrow_; ++k)
-        {
-            for(int aj = T.mat_.row_offset[I[k]]; aj < T.mat_.row_offset[I[k] + 1]; ++aj)
+            for(int j = row_begin; j < row_end; ++j)
             {
-                for(int j = 0; j < Jsize; ++j)
+                double a = static_cast<double>(rocalution_abs(P->val[j]));
+
+                if(a >= factor * amax)
                 {
-                    if(T.mat_.col[aj] == J[j])
-                    {
-                        Asub.mat_.val[DENSE_IND(k, j, Asub.nrow_, Asub.ncol_)] = T.mat_.val[aj];
-                    }
+                    cand.push_back(std::make_pair(-a, j));
                 }
             }
-        }
 
-        // QR Decomposition of dense submatrix Ak
-        Asub.QRDecompose();
+            int nkeep = static_cast<int>(cand.size());
 
-        // Solve least squares
-        HostVector<ValueType> ek(this->local_backend_);
-        HostVector<ValueType> mk(this->local_backend_);
+            if(trunc_max_elements > 0 && nkeep > trunc_max_elements)
+            {
+                std::sort(cand.begin(), cand.end());
+                nkeep = trunc_max_elements;
+            }
 
-        ek.Allocate(Asub.nrow_);
-        mk.Allocate(Asub.ncol_);
+            ValueType sum      = static_cast<ValueType>(0);
+            ValueType sum_keep = static_cast<ValueType>(0);
 
-        for(int j = 0; j < ek.GetSize(); ++j)
-        {
-            if(I[j] == i)
+            for(int j = row_begin; j < row_end; ++j)
             {
-                ek.vec_[j] = 1.0;
+                sum += P->val[j];
+            }
+
+            for(int k = 0; k < nkeep; ++k)
+            {
+                keep[cand[k].second] = 1;
+                sum_keep += P->val[cand[k].second];
             }
+
+            if(rocalution_abs(sum_keep) > 1e-32)
+            {
+                scale[i] = sum / sum_keep;
+            }
+
+            row_offset[i + 1] = nkeep;
         }
+    }
 
-        Asub.QRSolve(ek, &mk);
+    for(int i = 0; i < nrow; ++i)
+    {
+        row_offset[i + 1] += row_offset[i];
+    }
 
-        // Write m_k into preconditioner matrix
-        for(int j = 0; j < Jsize; ++j)
+    int* col       = NULL;
+    ValueType* val = NULL;
+
+    allocate_host(row_offset[nrow], &col);
+    allocate_host(row_offset[nrow], &val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        int idx = row_offset[i];
+
+        for(int j = P->row_offset[i]; j < P->row_offset[i + 1]; ++j)
         {
-            val[this->mat_.row_offset[i] + j] = mk.vec_[j];
+            if(keep[j] == 1)
+            {
+                col[idx] = P->col[j];
+                val[idx] = scale[i] * P->val[j];
+                ++idx;
+            }
         }
-
-        // Clear index vectors
-        I.clear();
-        ek.Clear();
-        mk.Clear();
-        Asub.Clear();
-        free_host(&J);
     }
 
-    // Only reset value array since we keep the sparsity pattern of A
-    free_host(&this->mat_.val);
-    this->mat_.val = val;
+    free_host(&P->row_offset);
+    free_host(&P->col);
+    free_host(&P->val);
 
-    this->Transpose();
+    P->row_offset = row_offset;
+    P->col        = col;
+    P->val        = val;
 
-    return true;
+    *nnz = row_offset[nrow];
+}
+
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::RugeStueben(ValueType eps,
+                                           BaseMatrix<ValueType>* prolong,
+                                           BaseMatrix<ValueType>* restrict) const
+{
+    // Classical splitting and direct interpolation
+    return this->RugeStueben(
+        eps, 0, 0, false, static_cast<ValueType>(0), 0, prolong, restrict);
 }
 
 // ----------------------------------------------------------
@@ -4271,6 +5871,11 @@ bool HostMatrixCSR<ValueType>::SPAI(void)
 // ----------------------------------------------------------
 template <typename ValueType>
 bool HostMatrixCSR<ValueType>::RugeStueben(ValueType eps,
+                                           int coarsening,
+                                           int interpolation,
+                                           bool aggressive,
+                                           ValueType trunc_factor,
+                                           int trunc_max_elements,
                                            BaseMatrix<ValueType>* prolong,
                                            BaseMatrix<ValueType>* restrict) const
 {
@@ -4283,6 +5888,72 @@ bool HostMatrixCSR<ValueType>::RugeStueben(ValueType eps,
     assert(cast_prolong != NULL);
     assert(cast_restrict != NULL);
 
+    // Aggressive coarsening, the coarsening is applied to the coarse operator of the
+    // first coarsening and both interpolations are combined (two-stage interpolation)
+    if(aggressive == true)
+    {
+        HostMatrixCSR<ValueType> P1(this->local_backend_);
+        HostMatrixCSR<ValueType> R1(this->local_backend_);
+        HostMatrixCSR<ValueType> P2(this->local_backend_);
+        HostMatrixCSR<ValueType> R2(this->local_backend_);
+        HostMatrixCSR<ValueType> AP(this->local_backend_);
+        HostMatrixCSR<ValueType> Ac(this->local_backend_);
+
+        if(this->RugeStueben(eps,
+                             coarsening,
+                             interpolation,
+                             false,
+                             trunc_factor,
+                             trunc_max_elements,
+                             &P1,
+                             &R1) == false)
+        {
+            return false;
+        }
+
+        AP.MatMatMult(*this, P1);
+        Ac.MatMatMult(R1, AP);
+
+        if(Ac.nnz_ == 0)
+        {
+            cast_prolong->CopyFrom(P1);
+            cast_restrict->CopyFrom(R1);
+
+            return true;
+        }
+
+        if(Ac.RugeStueben(eps,
+                          coarsening,
+                          interpolation,
+                          false,
+                          trunc_factor,
+                          trunc_max_elements,
+                          &P2,
+                          &R2) == false)
+        {
+            return false;
+        }
+
+        cast_prolong->MatMatMult(P1, P2);
+
+        if(cast_prolong->nnz_ > 0 &&
+           (rocalution_abs(trunc_factor) > 0 || trunc_max_elements > 0))
+        {
+            rs_truncate(trunc_factor,
+                        trunc_max_elements,
+                        cast_prolong->nrow_,
+                        &cast_prolong->mat_,
+                        &cast_prolong->nnz_);
+        }
+
+        cast_prolong->Sort();
+
+        cast_restrict->CopyFrom(*cast_prolong);
+        cast_restrict->Transpose();
+
+        return true;
+    }
+
     // Allocate
     cast_prolong->Clear();
     cast_prolong->AllocateCSR(this->nnz_, this->nrow_, this->ncol_);
@@ -4362,11 +6033,20 @@ bool HostMatrixCSR<ValueType>::RugeStueben(ValueType eps,
     }
 
     // Transpose S
-    for(int i = 0; i < this->nnz_; ++i)
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < this->nrow_; ++i)
     {
-        if(S_val[i])
+        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
         {
-            S_row_offset[this->mat_.col[i] + 1]++;
+            if(S_val[j])
+            {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+                S_row_offset[this->mat_.col[j] + 1]++;
+            }
         }
     }
 
@@ -4377,370 +6057,718 @@ bool HostMatrixCSR<ValueType>::RugeStueben(ValueType eps,
 
     allocate_host(S_row_offset[this->nrow_], &S_col);
 
+    std::vector<int> S_pos(S_row_offset, S_row_offset + this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(int i = 0; i < this->nrow_; ++i)
     {
         for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
         {
             if(S_val[j])
             {
-                S_col[S_row_offset[this->mat_.col[j]]++] = i;
+                int pos;
+
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+                pos = S_pos[this->mat_.col[j]]++;
+
+                S_col[pos] = i;
+            }
+        }
+    }
+
+    // Sort the rows of S^T, such that they do not depend on the thread schedule
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        std::sort(S_col + S_row_offset[i], S_col + S_row_offset[i + 1]);
+    }
+
+    // Split into C and F
+    switch(coarsening)
+    {
+    case 0: // Classical
+        rs_classic_split(0,
+                         this->nrow_,
+                         this->mat_.row_offset,
+                         this->mat_.col,
+                         S_val,
+                         S_row_offset,
+                         S_col,
+                         connect);
+        break;
+    case 1: // PMIS
+        rs_pmis_split(this->nrow_,
+                      this->mat_.row_offset,
+                      this->mat_.col,
+                      S_val,
+                      S_row_offset,
+                      S_col,
+                      connect);
+        break;
+    case 2: // HMIS
+        rs_hmis_split(this->nrow_,
+                      this->mat_.row_offset,
+                      this->mat_.col,
+                      S_val,
+                      S_row_offset,
+                      S_col,
+                      connect);
+        break;
+    }
+
+    // Build coarsening operators
+    int nc = 0;
+    std::vector<int> cidx(this->nrow_);
+
+    for(int i = 0; i < this->nrow_; ++i)
+    {
+        if(connect[i] == 1)
+        {
+            cidx[i] = nc++;
+        }
+    }
+
+    // Extended+i interpolation
+    if(interpolation == 1)
+    {
+        std::vector<std::vector<int>> pcol(this->nrow_);
+        std::vector<std::vector<ValueType>> pval(this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            // Position of a point in the interpolatory set of the current row, or -1
+            std::vector<int> marker(this->nrow_, -1);
+            std::vector<int> cset;
+            std::vector<ValueType> w;
+            std::vector<std::pair<int, ValueType>> row;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+            for(int i = 0; i < this->nrow_; ++i)
+            {
+                if(connect[i] == 1)
+                {
+                    pcol[i].push_back(cidx[i]);
+                    pval[i].push_back(static_cast<ValueType>(1));
+                    continue;
+                }
+
+                // Interpolatory set, strong C neighbours and the strong C neighbours of
+                // strong F neighbours
+                cset.clear();
+                w.clear();
+
+                for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    int c = this->mat_.col[j];
+
+                    if(!S_val[j] || c == i)
+                    {
+                        continue;
+                    }
+
+                    if(connect[c] == 1)
+                    {
+                        if(marker[c] == -1)
+                        {
+                            marker[c] = static_cast<int>(cset.size());
+                            cset.push_back(c);
+                            w.push_back(static_cast<ValueType>(0));
+                        }
+                    }
+                    else if(connect[c] == 0)
+                    {
+                        for(int jj = this->mat_.row_offset[c]; jj < this->mat_.row_offset[c + 1];
+                            ++jj)
+                        {
+                            int cc = this->mat_.col[jj];
+
+                            if(S_val[jj] && connect[cc] == 1 && marker[cc] == -1)
+                            {
+                                marker[cc] = static_cast<int>(cset.size());
+                                cset.push_back(cc);
+                                w.push_back(static_cast<ValueType>(0));
+                            }
+                        }
+                    }
+                }
+
+                ValueType diag = static_cast<ValueType>(0);
+
+                for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    int c       = this->mat_.col[j];
+                    ValueType v = this->mat_.val[j];
+
+                    if(c == i)
+                    {
+                        diag += v;
+                        continue;
+                    }
+
+                    if(marker[c] >= 0)
+                    {
+                        w[marker[c]] += v;
+                        continue;
+                    }
+
+                    // Weak couplings are added to the diagonal
+                    if(!S_val[j] || connect[c] != 0)
+                    {
+                        diag += v;
+                        continue;
+                    }
+
+                    // Strong F neighbour k, a_ik is distributed to the interpolatory set
+                    // and to i, using the entries of row k with opposite sign to a_kk
+                    ValueType a_kk = static_cast<ValueType>(0);
+
+                    for(int jj = this->mat_.row_offset[c]; jj < this->mat_.row_offset[c + 1];
+                        ++jj)
+                    {
+                        if(this->mat_.col[jj] == c)
+                        {
+                            a_kk = this->mat_.val[jj];
+                        }
+                    }
+
+                    bool neg_kk = (a_kk < static_cast<ValueType>(0));
+
+                    ValueType sum = static_cast<ValueType>(0);
+
+                    for(int jj = this->mat_.row_offset[c]; jj < this->mat_.row_offset[c + 1]; ++jj)
+                    {
+                        int l        = this->mat_.col[jj];
+                        ValueType vl = this->mat_.val[jj];
+
+                        if(l != c && (marker[l] >= 0 || l == i) &&
+                           (vl < static_cast<ValueType>(0)) != neg_kk &&
+                           vl != static_cast<ValueType>(0))
+                        {
+                            sum += vl;
+                        }
+                    }
+
+                    if(rocalution_abs(sum) < 1e-32)
+                    {
+                        diag += v;
+                        continue;
+                    }
+
+                    for(int jj = this->mat_.row_offset[c]; jj < this->mat_.row_offset[c + 1]; ++jj)
+                    {
+                        int l        = this->mat_.col[jj];
+                        ValueType vl = this->mat_.val[jj];
+
+                        if(l == c || (vl < static_cast<ValueType>(0)) == neg_kk ||
+                           vl == static_cast<ValueType>(0))
+                        {
+                            continue;
+                        }
+
+                        if(l == i)
+                        {
+                            diag += v * vl / sum;
+                        }
+                        else if(marker[l] >= 0)
+                        {
+                            w[marker[l]] += v * vl / sum;
+                        }
+                    }
+                }
+
+                // Interpolation weights, sorted by coarse index
+                row.clear();
+
+                if(rocalution_abs(diag) > 1e-32)
+                {
+                    for(unsigned int k = 0; k < cset.size(); ++k)
+                    {
+                        row.push_back(std::make_pair(cidx[cset[k]], -w[k] / diag));
+                    }
+                }
+
+                for(unsigned int k = 0; k < cset.size(); ++k)
+                {
+                    marker[cset[k]] = -1;
+                }
+
+                std::sort(row.begin(), row.end(), rs_pair_less<ValueType>);
+
+                for(unsigned int k = 0; k < row.size(); ++k)
+                {
+                    pcol[i].push_back(row[k].first);
+                    pval[i].push_back(row[k].second);
+                }
             }
         }
-    }
 
-    for(int i = this->nrow_; i > 0; --i)
-    {
-        S_row_offset[i] = S_row_offset[i - 1];
-    }
+        cast_prolong->Clear();
 
-    S_row_offset[0] = 0;
+        int* row_offset = NULL;
+        allocate_host(this->nrow_ + 1, &row_offset);
 
-    // Split into C and F
-    std::vector<int> lambda(this->nrow_);
+        row_offset[0] = 0;
 
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        int temp = 0;
-        for(int j = S_row_offset[i]; j < S_row_offset[i + 1]; ++j)
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            temp += (connect[S_col[j]] == -1 ? 1 : 2);
+            row_offset[i + 1] = row_offset[i] + static_cast<int>(pcol[i].size());
         }
 
-        lambda[i] = temp;
-    }
-
-    std::vector<int> ptr(this->nrow_ + 1, static_cast<int>(0));
-    std::vector<int> cnt(this->nrow_, static_cast<int>(0));
-    std::vector<int> i2n(this->nrow_);
-    std::vector<int> n2i(this->nrow_);
+        int* col       = NULL;
+        ValueType* val = NULL;
 
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        ptr[lambda[i] + 1]++;
-    }
+        allocate_host(row_offset[this->nrow_], &col);
+        allocate_host(row_offset[this->nrow_], &val);
 
-    for(unsigned int i = 1; i < ptr.size(); ++i)
-    {
-        ptr[i] += ptr[i - 1];
-    }
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            for(unsigned int k = 0; k < pcol[i].size(); ++k)
+            {
+                col[row_offset[i] + k] = pcol[i][k];
+                val[row_offset[i] + k] = pval[i][k];
+            }
+        }
 
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        int lam  = lambda[i];
-        int idx  = ptr[lam] + cnt[lam]++;
-        i2n[idx] = i;
-        n2i[i]   = idx;
+        if(row_offset[this->nrow_] > 0)
+        {
+            cast_prolong->SetDataPtrCSR(
+                &row_offset, &col, &val, row_offset[this->nrow_], this->nrow_, nc);
+        }
+        else
+        {
+            free_host(&row_offset);
+        }
     }
-
-    for(int top = this->nrow_ - 1; top >= 0; --top)
+    else
     {
-        int i   = i2n[top];
-        int lam = lambda[i];
+        std::vector<ValueType> Amin(this->nrow_);
+        std::vector<ValueType> Amax(this->nrow_);
 
-        if(lam == 0)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            for(int ai = 0; ai < this->nrow_; ++ai)
+            if(connect[i] == 1)
             {
-                if(connect[ai] == -1)
+                ++cast_prolong->mat_.row_offset[i + 1];
+                continue;
+            }
+
+            ValueType amin = static_cast<ValueType>(0);
+            ValueType amax = static_cast<ValueType>(0);
+
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                if(!S_val[j] || connect[this->mat_.col[j]] != 1)
                 {
-                    connect[ai] = 1;
+                    continue;
                 }
+
+                amin = (amin < this->mat_.val[j]) ? amin : this->mat_.val[j];
+                amax = (amax > this->mat_.val[j]) ? amax : this->mat_.val[j];
             }
 
-            break;
-        }
+            Amin[i] = amin = amin * static_cast<ValueType>(0.2);
+            Amax[i] = amax = amax * static_cast<ValueType>(0.2);
 
-        cnt[lam]--;
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            {
+                if(!S_val[j] || connect[this->mat_.col[j]] != 1)
+                {
+                    continue;
+                }
 
-        if(connect[i] == 0)
+                if(this->mat_.val[j] <= amin || this->mat_.val[j] >= amax)
+                {
+                    ++cast_prolong->mat_.row_offset[i + 1];
+                }
+            }
+        }
+
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            continue;
+            cast_prolong->mat_.row_offset[i + 1] += cast_prolong->mat_.row_offset[i];
         }
 
-        assert(connect[i] == -1);
+        cast_prolong->mat_.col = (int*)realloc(
+            cast_prolong->mat_.col, cast_prolong->mat_.row_offset[this->nrow_] * sizeof(int));
+        cast_prolong->mat_.val = (ValueType*)realloc(
+            cast_prolong->mat_.val, cast_prolong->mat_.row_offset[this->nrow_] * sizeof(ValueType));
 
-        connect[i] = 1;
+        cast_prolong->nnz_  = cast_prolong->mat_.row_offset[this->nrow_];
+        cast_prolong->ncol_ = nc;
 
-        for(int j = S_row_offset[i]; j < S_row_offset[i + 1]; ++j)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for(int i = 0; i < this->nrow_; ++i)
         {
-            int c = S_col[j];
+            int row_head = cast_prolong->mat_.row_offset[i];
 
-            if(connect[c] != -1)
+            if(connect[i] == 1)
             {
+                cast_prolong->mat_.col[row_head] = cidx[i];
+                cast_prolong->mat_.val[row_head] = static_cast<ValueType>(1);
                 continue;
             }
 
-            connect[c] = 0;
+            ValueType diag  = static_cast<ValueType>(0);
+            ValueType a_num = static_cast<ValueType>(0), a_den = static_cast<ValueType>(0);
+            ValueType b_num = static_cast<ValueType>(0), b_den = static_cast<ValueType>(0);
+            ValueType d_neg = static_cast<ValueType>(0), d_pos = static_cast<ValueType>(0);
 
-            for(int jj = this->mat_.row_offset[c]; jj < this->mat_.row_offset[c + 1]; ++jj)
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                if(!S_val[jj])
+                int c       = this->mat_.col[j];
+                ValueType v = this->mat_.val[j];
+
+                if(c == i)
                 {
+                    diag = v;
                     continue;
                 }
 
-                int cc     = this->mat_.col[jj];
-                int lam_cc = lambda[cc];
-
-                if(connect[cc] != -1 || lam_cc >= this->nrow_ - 1)
+                if(v < static_cast<ValueType>(0))
                 {
-                    continue;
+                    a_num += v;
+                    if(S_val[j] && connect[c] == 1)
+                    {
+                        a_den += v;
+                        if(v > Amin[i])
+                        {
+                            d_neg += v;
+                        }
+                    }
                 }
+                else
+                {
+                    b_num += v;
+                    if(S_val[j] && connect[c] == 1)
+                    {
+                        b_den += v;
+                        if(v < Amax[i])
+                        {
+                            d_pos += v;
+                        }
+                    }
+                }
+            }
 
-                int old_pos = n2i[cc];
-                int new_pos = ptr[lam_cc] + cnt[lam_cc] - 1;
-
-                n2i[i2n[old_pos]] = new_pos;
-                n2i[i2n[new_pos]] = old_pos;
-
-                std::swap(i2n[old_pos], i2n[new_pos]);
+            ValueType cf_neg = static_cast<ValueType>(1);
+            ValueType cf_pos = static_cast<ValueType>(1);
 
-                --cnt[lam_cc];
-                ++cnt[lam_cc + 1];
-                ptr[lam_cc + 1] = ptr[lam_cc] + cnt[lam_cc];
+            if(rocalution_abs(a_den - d_neg) > 1e-32)
+            {
+                cf_neg = a_den / (a_den - d_neg);
+            }
 
-                ++lambda[cc];
+            if(rocalution_abs(b_den - d_pos) > 1e-32)
+            {
+                cf_pos = b_den / (b_den - d_pos);
             }
-        }
 
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-        {
-            if(!S_val[j])
+            if(b_num > static_cast<ValueType>(0) && rocalution_abs(b_den) < 1e-32)
             {
-                continue;
+                diag += b_num;
             }
 
-            int c   = this->mat_.col[j];
-            int lam = lambda[c];
+            ValueType alpha = rocalution_abs(a_den) > 1e-32 ? -cf_neg * a_num / (diag * a_den)
+                                                            : static_cast<ValueType>(0);
+            ValueType beta = rocalution_abs(b_den) > 1e-32 ? -cf_pos * b_num / (diag * b_den)
+                                                           : static_cast<ValueType>(0);
 
-            if(connect[c] != -1 || lam == 0)
+            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
             {
-                continue;
-            }
+                int c       = this->mat_.col[j];
+                ValueType v = this->mat_.val[j];
 
-            int old_pos = n2i[c];
-            int new_pos = ptr[lam];
+                if(!S_val[j] || connect[c] != 1)
+                {
+                    continue;
+                }
 
-            n2i[i2n[old_pos]] = new_pos;
-            n2i[i2n[new_pos]] = old_pos;
+                if(v > Amin[i] && v < Amax[i])
+                {
+                    continue;
+                }
 
-            std::swap(i2n[old_pos], i2n[new_pos]);
+                cast_prolong->mat_.col[row_head] = cidx[c];
+                cast_prolong->mat_.val[row_head] =
+                    (v < static_cast<ValueType>(0) ? alpha : beta) * v;
+                ++row_head;
+            }
+        }
 
-            --cnt[lam];
-            ++cnt[lam - 1];
-            ++ptr[lam];
-            --lambda[c];
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < cast_prolong->GetM(); ++i)
+        {
+            for(int j = cast_prolong->mat_.row_offset[i];
+                j < cast_prolong->mat_.row_offset[i + 1];
+                ++j)
+            {
+                for(int jj = cast_prolong->mat_.row_offset[i];
+                    jj < cast_prolong->mat_.row_offset[i + 1] - 1;
+                    ++jj)
+                {
+                    if(cast_prolong->mat_.col[jj] > cast_prolong->mat_.col[jj + 1])
+                    {
+                        // swap elements
+                        int ind       = cast_prolong->mat_.col[jj];
+                        ValueType val = cast_prolong->mat_.val[jj];
 
-            assert(ptr[lam - 1] == ptr[lam] - cnt[lam - 1]);
+                        cast_prolong->mat_.col[jj] = cast_prolong->mat_.col[jj + 1];
+                        cast_prolong->mat_.val[jj] = cast_prolong->mat_.val[jj + 1];
+
+                        cast_prolong->mat_.col[jj + 1] = ind;
+                        cast_prolong->mat_.val[jj + 1] = val;
+                    }
+                }
+            }
         }
     }
 
-    // Build coarsening operators
-    int nc = 0;
-    std::vector<int> cidx(this->nrow_);
+    free_host(&connect);
+    free_host(&S_row_offset);
+    free_host(&S_col);
+    free_host(&S_val);
 
-    for(int i = 0; i < this->nrow_; ++i)
+    if(cast_prolong->nnz_ > 0 &&
+       (rocalution_abs(trunc_factor) > 0 || trunc_max_elements > 0))
     {
-        if(connect[i] == 1)
-        {
-            cidx[i] = nc++;
-        }
+        rs_truncate(trunc_factor,
+                    trunc_max_elements,
+                    cast_prolong->nrow_,
+                    &cast_prolong->mat_,
+                    &cast_prolong->nnz_);
     }
 
-    std::vector<ValueType> Amin(this->nrow_);
-    std::vector<ValueType> Amax(this->nrow_);
+    cast_restrict->CopyFrom(*cast_prolong);
+    cast_restrict->Transpose();
+
+    return true;
+}
+
+// Symmetric random priority of the edge (i, j), used to break ties between equally
+// strong couplings in the parallel pairwise matching
+static inline unsigned int pairwise_edge_hash(int i, int j)
+{
+    unsigned int lo = static_cast<unsigned int>(std::min(i, j));
+    unsigned int hi = static_cast<unsigned int>(std::max(i, j));
+
+    return murmur3_fmix32(lo * 2654435761u ^ (hi + 0x9e3779b9u + (lo << 6) + (lo >> 2)));
+}
+
+// Parallel pairwise matching of locally dominant edges. On entry, partner is -2 for
+// excluded and -1 for free nodes. Each free node proposes the free neighbour with the
+// strongest negative coupling (relative to the sign of its diagonal), if the coupling
+// passes the beta criterion of its row. Mutual proposals are matched and nodes without
+// admissible proposal remain single. The rounds are repeated until no further node is
+// decided. Finally, single nodes join the pair of their strongest admissible neighbour
+// as third node, if the pair has no third node yet. Otherwise, single nodes would pile
+// up on the coarser levels and stall the coarsening.
+// On exit, partner holds the matched node, the node itself for single nodes, -2 for
+// excluded nodes and -3 for nodes that joined a pair. third holds the third node of
+// the pair for the smaller index of each pair, or -1. The matching is independent of
+// the number of threads.
+template <typename ValueType>
+static void pairwise_match(int nrow,
+                           const int* row_offset,
+                           const int* col,
+                           const ValueType* val,
+                           ValueType beta,
+                           int* partner,
+                           int* third)
+{
+    std::vector<int> cand(nrow, -1);
+
+    int ndecided = 1;
 
+    while(ndecided > 0)
+    {
+        ndecided = 0;
+
+        // Proposals
 #ifdef _OPENMP
 #pragma omp parallel for schedule(dynamic, 1024)
 #endif
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        if(connect[i] == 1)
+        for(int i = 0; i < nrow; ++i)
         {
-            ++cast_prolong->mat_.row_offset[i + 1];
-            continue;
-        }
+            cand[i] = -1;
 
-        ValueType amin = static_cast<ValueType>(0);
-        ValueType amax = static_cast<ValueType>(0);
-
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-        {
-            if(!S_val[j] || connect[this->mat_.col[j]] != 1)
+            if(partner[i] != -1)
             {
                 continue;
             }
 
-            amin = (amin < this->mat_.val[j]) ? amin : this->mat_.val[j];
-            amax = (amax > this->mat_.val[j]) ? amax : this->mat_.val[j];
-        }
-
-        Amin[i] = amin = amin * static_cast<ValueType>(0.2);
-        Amax[i] = amax = amax * static_cast<ValueType>(0.2);
+            bool neg = false;
 
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
-        {
-            if(!S_val[j] || connect[this->mat_.col[j]] != 1)
+            for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
             {
-                continue;
+                if(col[j] == i)
+                {
+                    neg = (val[j] < static_cast<ValueType>(0));
+                    break;
+                }
             }
 
-            if(this->mat_.val[j] <= amin || this->mat_.val[j] >= amax)
+            ValueType min_a_ij = static_cast<ValueType>(0);
+            ValueType max_a_ij = static_cast<ValueType>(0);
+            unsigned int min_h = 0;
+            int min_c          = -1;
+            bool first         = true;
+
+            for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
             {
-                ++cast_prolong->mat_.row_offset[i + 1];
-            }
-        }
-    }
+                int c = col[j];
 
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        cast_prolong->mat_.row_offset[i + 1] += cast_prolong->mat_.row_offset[i];
-    }
+                if(c == i)
+                {
+                    continue;
+                }
 
-    cast_prolong->mat_.col = (int*)realloc(
-        cast_prolong->mat_.col, cast_prolong->mat_.row_offset[this->nrow_] * sizeof(int));
-    cast_prolong->mat_.val = (ValueType*)realloc(
-        cast_prolong->mat_.val, cast_prolong->mat_.row_offset[this->nrow_] * sizeof(ValueType));
+                ValueType a_ij = (neg == true) ? -val[j] : val[j];
 
-    cast_prolong->nnz_  = cast_prolong->mat_.row_offset[this->nrow_];
-    cast_prolong->ncol_ = nc;
+                max_a_ij = (first == true || a_ij > max_a_ij) ? a_ij : max_a_ij;
+                first    = false;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(dynamic, 1024)
-#endif
-    for(int i = 0; i < this->nrow_; ++i)
-    {
-        int row_head = cast_prolong->mat_.row_offset[i];
+                if(partner[c] != -1)
+                {
+                    continue;
+                }
 
-        if(connect[i] == 1)
-        {
-            cast_prolong->mat_.col[row_head] = cidx[i];
-            cast_prolong->mat_.val[row_head] = static_cast<ValueType>(1);
-            continue;
-        }
+                unsigned int h = pairwise_edge_hash(i, c);
+
+                if(min_c == -1 || a_ij < min_a_ij || (a_ij == min_a_ij && h > min_h))
+                {
+                    min_a_ij = a_ij;
+                    min_h    = h;
+                    min_c    = c;
+                }
+            }
 
-        ValueType diag  = static_cast<ValueType>(0);
-        ValueType a_num = static_cast<ValueType>(0), a_den = static_cast<ValueType>(0);
-        ValueType b_num = static_cast<ValueType>(0), b_den = static_cast<ValueType>(0);
-        ValueType d_neg = static_cast<ValueType>(0), d_pos = static_cast<ValueType>(0);
+            cand[i] = (min_c != -1 && min_a_ij < -beta * max_a_ij) ? min_c : i;
+        }
 
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        // Mutual proposals are matched
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+ : ndecided)
+#endif
+        for(int i = 0; i < nrow; ++i)
         {
-            int c       = this->mat_.col[j];
-            ValueType v = this->mat_.val[j];
+            int c = cand[i];
 
-            if(c == i)
+            if(c == -1)
             {
-                diag = v;
                 continue;
             }
 
-            if(v < static_cast<ValueType>(0))
-            {
-                a_num += v;
-                if(S_val[j] && connect[c] == 1)
-                {
-                    a_den += v;
-                    if(v > Amin[i])
-                    {
-                        d_neg += v;
-                    }
-                }
-            }
-            else
+            if(c == i || cand[c] == i)
             {
-                b_num += v;
-                if(S_val[j] && connect[c] == 1)
-                {
-                    b_den += v;
-                    if(v < Amax[i])
-                    {
-                        d_pos += v;
-                    }
-                }
+                partner[i] = c;
+                ++ndecided;
             }
         }
+    }
+
+    // Proposals, that are not mutual in the final round, are resolved in ascending order
+    for(int i = 0; i < nrow; ++i)
+    {
+        if(partner[i] != -1)
+        {
+            continue;
+        }
+
+        int c = cand[i];
+
+        if(c != -1 && c != i && partner[c] == -1)
+        {
+            partner[i] = c;
+            partner[c] = i;
+        }
+        else
+        {
+            partner[i] = i;
+        }
+    }
 
-        ValueType cf_neg = static_cast<ValueType>(1);
-        ValueType cf_pos = static_cast<ValueType>(1);
+    // Single nodes join the pair of their strongest admissible neighbour
+    for(int i = 0; i < nrow; ++i)
+    {
+        third[i] = -1;
+    }
 
-        if(rocalution_abs(a_den - d_neg) > 1e-32)
+    for(int i = 0; i < nrow; ++i)
+    {
+        if(partner[i] != i)
         {
-            cf_neg = a_den / (a_den - d_neg);
+            continue;
         }
 
-        if(rocalution_abs(b_den - d_pos) > 1e-32)
-        {
-            cf_pos = b_den / (b_den - d_pos);
-        }
+        bool neg = false;
 
-        if(b_num > static_cast<ValueType>(0) && rocalution_abs(b_den) < 1e-32)
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
         {
-            diag += b_num;
+            if(col[j] == i)
+            {
+                neg = (val[j] < static_cast<ValueType>(0));
+                break;
+            }
         }
 
-        ValueType alpha = rocalution_abs(a_den) > 1e-32 ? -cf_neg * a_num / (diag * a_den)
-                                                        : static_cast<ValueType>(0);
-        ValueType beta = rocalution_abs(b_den) > 1e-32 ? -cf_pos * b_num / (diag * b_den)
-                                                       : static_cast<ValueType>(0);
+        ValueType min_a_ij = static_cast<ValueType>(0);
+        ValueType max_a_ij = static_cast<ValueType>(0);
+        int min_c          = -1;
+        bool first         = true;
 
-        for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
         {
-            int c       = this->mat_.col[j];
-            ValueType v = this->mat_.val[j];
+            int c = col[j];
 
-            if(!S_val[j] || connect[c] != 1)
+            if(c == i)
             {
                 continue;
             }
 
-            if(v > Amin[i] && v < Amax[i])
+            ValueType a_ij = (neg == true) ? -val[j] : val[j];
+
+            max_a_ij = (first == true || a_ij > max_a_ij) ? a_ij : max_a_ij;
+            first    = false;
+
+            // Only pairs without third node
+            if(partner[c] < 0 || partner[c] == c || third[std::min(c, partner[c])] != -1)
             {
                 continue;
             }
 
-            cast_prolong->mat_.col[row_head] = cidx[c];
-            cast_prolong->mat_.val[row_head] = (v < static_cast<ValueType>(0) ? alpha : beta) * v;
-            ++row_head;
+            if(min_c == -1 || a_ij < min_a_ij)
+            {
+                min_a_ij = a_ij;
+                min_c    = c;
+            }
         }
-    }
-
-    free_host(&connect);
-    free_host(&S_row_offset);
-    free_host(&S_col);
-    free_host(&S_val);
 
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < cast_prolong->GetM(); ++i)
-    {
-        for(int j = cast_prolong->mat_.row_offset[i]; j < cast_prolong->mat_.row_offset[i + 1]; ++j)
+        if(min_c != -1 && min_a_ij < -beta * max_a_ij)
         {
-            for(int jj = cast_prolong->mat_.row_offset[i];
-                jj < cast_prolong->mat_.row_offset[i + 1] - 1;
-                ++jj)
-            {
-                if(cast_prolong->mat_.col[jj] > cast_prolong->mat_.col[jj + 1])
-                {
-                    // swap elements
-                    int ind       = cast_prolong->mat_.col[jj];
-                    ValueType val = cast_prolong->mat_.val[jj];
-
-                    cast_prolong->mat_.col[jj] = cast_prolong->mat_.col[jj + 1];
-                    cast_prolong->mat_.val[jj] = cast_prolong->mat_.val[jj + 1];
-
-                    cast_prolong->mat_.col[jj + 1] = ind;
-                    cast_prolong->mat_.val[jj + 1] = val;
-                }
-            }
+            third[std::min(min_c, partner[min_c])] = i;
+            partner[i]                             = -3;
         }
     }
-
-    cast_restrict->CopyFrom(*cast_prolong);
-    cast_restrict->Transpose();
-
-    return true;
 }
 
 template <typename ValueType>
@@ -4769,6 +6797,9 @@ bool HostMatrixCSR<ValueType>::InitialPairwiseAggregation(ValueType beta,
     allocate_host(this->nrow_, &ind_diag);
 
     // Build U
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+ : Usize)
+#endif
     for(int i = 0; i < this->nrow_; ++i)
     {
         ValueType sum = static_cast<ValueType>(0);
@@ -4807,6 +6838,65 @@ bool HostMatrixCSR<ValueType>::InitialPairwiseAggregation(ValueType beta,
     nc              = 0;
     ValueType betam = -beta;
 
+    // Parallel matching
+    if(ordering == 6)
+    {
+        std::vector<int> partner(this->nrow_);
+        std::vector<int> third(this->nrow_);
+
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            partner[i] = (cast_G->vec_[i] == -1) ? -2 : -1;
+        }
+
+        pairwise_match(this->nrow_,
+                       this->mat_.row_offset,
+                       this->mat_.col,
+                       this->mat_.val,
+                       beta,
+                       &partner[0],
+                       &third[0]);
+
+        // Aggregates consist of up to three nodes
+        free_host(rG);
+
+        Gsize = 3;
+        allocate_host(Gsize * rGsize, rG);
+
+        for(int i = 0; i < Gsize * rGsize; ++i)
+        {
+            (*rG)[i] = -1;
+        }
+
+        // Number the aggregates in ascending order of their first node
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            int j = partner[i];
+
+            if(j < i)
+            {
+                continue;
+            }
+
+            int member[3] = {i, (j != i) ? j : -1, third[i]};
+
+            for(int m = 0; m < 3; ++m)
+            {
+                if(member[m] >= 0)
+                {
+                    cast_G->vec_[member[m]] = nc;
+                    (*rG)[m * rGsize + nc]  = member[m];
+                }
+            }
+
+            ++nc;
+        }
+
+        free_host(&ind_diag);
+
+        return true;
+    }
+
     // Ordering
     HostVector<int> perm(this->local_backend_);
 
@@ -5220,6 +7310,77 @@ bool HostMatrixCSR<ValueType>::FurtherPairwiseAggregation(ValueType beta,
     nc              = 0;
     ValueType betam = -beta;
 
+    // Parallel matching
+    if(ordering == 6)
+    {
+        std::vector<int> partner(this->nrow_, -1);
+        std::vector<int> third(this->nrow_);
+
+        pairwise_match(this->nrow_,
+                       this->mat_.row_offset,
+                       this->mat_.col,
+                       this->mat_.val,
+                       beta,
+                       &partner[0],
+                       &third[0]);
+
+        // Aggregates consist of up to three coarse nodes of the previous pass
+        int Gsizep = Gsize / 2;
+
+        free_host(&rGc);
+
+        Gsize = 3 * Gsizep;
+        allocate_host(Gsize * rGsizec, &rGc);
+
+        for(int i = 0; i < Gsize * rGsizec; ++i)
+        {
+            rGc[i] = -1;
+        }
+
+        // Number the aggregates in ascending order of their first node
+        for(int i = 0; i < this->nrow_; ++i)
+        {
+            int j = partner[i];
+
+            if(j < i)
+            {
+                continue;
+            }
+
+            int member[3] = {i, (j != i) ? j : -1, third[i]};
+
+            for(int m = 0; m < 3; ++m)
+            {
+                if(member[m] < 0)
+                {
+                    continue;
+                }
+
+                for(int r = 0; r < Gsizep; ++r)
+                {
+                    int fine = (*rG)[r * rGsize + member[m]];
+
+                    rGc[(m * Gsizep + r) * rGsizec + nc] = fine;
+
+                    if(fine >= 0)
+                    {
+                        cast_G->vec_[fine] = nc;
+                    }
+                }
+            }
+
+            ++nc;
+        }
+
+        free_host(&U);
+        free_host(rG);
+
+        (*rG)  = rGc;
+        rGsize = rGsizec;
+
+        return true;
+    }
+
     // Ordering
     HostVector<int> perm(this->local_backend_);
 
@@ -5646,112 +7807,137 @@ bool HostMatrixCSR<ValueType>::CoarsenOperator(BaseMatrix<ValueType>* Ac,
     assert(cast_Ac != NULL);
     assert(cast_G != NULL);
 
-    // Allocate
-    cast_Ac->Clear();
-
-    int* row_offset = NULL;
-    int* col        = NULL;
-    ValueType* val  = NULL;
-
-    allocate_host(nrow + 1, &row_offset);
-    allocate_host(this->nnz_, &col);
-    allocate_host(this->nnz_, &val);
-
     // Create P_ij: if i in G_j -> 1, else 0
     // (Ac)_kl = sum i in G_k (sum j in G_l (a_ij))) with k,l=1,...,nrow
+    // The coarse operator is assembled in two passes, the first pass determines the
+    // number of entries of each coarse row, the second pass fills the exactly sized
+    // arrays.
 
-    int* reverse_col = NULL;
-    int* Gl          = NULL;
-    int* erase       = NULL;
+    int* row_offset = NULL;
+    allocate_host(nrow + 1, &row_offset);
 
     int size = (nrow > ncol) ? nrow : ncol;
 
-    allocate_host(size, &reverse_col);
-    allocate_host(size, &Gl);
-    allocate_host(size, &erase);
-
-    for(int i = 0; i < size; ++i)
-    {
-        reverse_col[i] = -1;
-    }
-
-    set_to_zero_host(size, Gl);
-
-    row_offset[0] = 0;
+    _set_omp_backend_threads(this->local_backend_, nrow);
 
-    for(int k = 0; k < nrow; ++k)
+    // Count
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-        row_offset[k + 1] = row_offset[k];
-
-        int m = 0;
+        // Position of coarse column l in the current row, or -1
+        std::vector<int> reverse_col(size, -1);
+        std::vector<int> erase;
 
-        for(int r = 0; r < Gsize; ++r)
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+        for(int k = 0; k < nrow; ++k)
         {
-            int i = rG[r * rGsize + k];
-
-            if(i < 0)
-            {
-                continue;
-            }
+            erase.clear();
 
-            for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+            for(int r = 0; r < Gsize; ++r)
             {
-                int l = cast_G->vec_[this->mat_.col[j]];
+                int i = rG[r * rGsize + k];
 
-                if(l < 0)
+                if(i < 0)
                 {
                     continue;
                 }
 
-                if(Gl[l] == 0)
+                for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
                 {
-                    Gl[l]      = 1;
-                    erase[m++] = l;
+                    int l = cast_G->vec_[this->mat_.col[j]];
 
-                    col[row_offset[k + 1]] = l;
-                    val[row_offset[k + 1]] = this->mat_.val[j];
-                    reverse_col[l]         = row_offset[k + 1];
-
-                    ++row_offset[k + 1];
-                }
-                else
-                {
-                    val[reverse_col[l]] += this->mat_.val[j];
+                    if(l >= 0 && reverse_col[l] == -1)
+                    {
+                        reverse_col[l] = 1;
+                        erase.push_back(l);
+                    }
                 }
             }
-        }
 
-        for(int j = 0; j < m; ++j)
-        {
-            Gl[erase[j]] = 0;
+            row_offset[k + 1] = static_cast<int>(erase.size());
+
+            for(unsigned int j = 0; j < erase.size(); ++j)
+            {
+                reverse_col[erase[j]] = -1;
+            }
         }
     }
 
-    free_host(&reverse_col);
-    free_host(&Gl);
-    free_host(&erase);
+    row_offset[0] = 0;
+
+    for(int k = 0; k < nrow; ++k)
+    {
+        row_offset[k + 1] += row_offset[k];
+    }
 
     int nnz = row_offset[nrow];
 
-    int* col_resized       = NULL;
-    ValueType* val_resized = NULL;
+    int* col       = NULL;
+    ValueType* val = NULL;
 
-    allocate_host(nnz, &col_resized);
-    allocate_host(nnz, &val_resized);
+    allocate_host(nnz, &col);
+    allocate_host(nnz, &val);
 
-    // Resize
-    for(int i = 0; i < nnz; ++i)
+    // Fill
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
     {
-        col_resized[i] = col[i];
-        val_resized[i] = val[i];
-    }
+        std::vector<int> reverse_col(size, -1);
 
-    free_host(&col);
-    free_host(&val);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 1024)
+#endif
+        for(int k = 0; k < nrow; ++k)
+        {
+            int idx = row_offset[k];
+
+            for(int r = 0; r < Gsize; ++r)
+            {
+                int i = rG[r * rGsize + k];
+
+                if(i < 0)
+                {
+                    continue;
+                }
+
+                for(int j = this->mat_.row_offset[i]; j < this->mat_.row_offset[i + 1]; ++j)
+                {
+                    int l = cast_G->vec_[this->mat_.col[j]];
+
+                    if(l < 0)
+                    {
+                        continue;
+                    }
+
+                    if(reverse_col[l] == -1)
+                    {
+                        col[idx]       = l;
+                        val[idx]       = this->mat_.val[j];
+                        reverse_col[l] = idx;
+
+                        ++idx;
+                    }
+                    else
+                    {
+                        val[reverse_col[l]] += this->mat_.val[j];
+                    }
+                }
+            }
+
+            for(int j = row_offset[k]; j < idx; ++j)
+            {
+                reverse_col[col[j]] = -1;
+            }
+        }
+    }
 
     // Allocate
     cast_Ac->Clear();
-    cast_Ac->SetDataPtrCSR(&row_offset, &col_resized, &val_resized, nnz, nrow, nrow);
+    cast_Ac->SetDataPtrCSR(&row_offset, &col, &val, nnz, nrow, nrow);
 
     return true;
 }
@@ -5825,6 +8011,104 @@ bool HostMatrixCSR<ValueType>::Key(long int& row_key, long int& col_key, long in
     return true;
 }
 
+template <typename ValueType>
+bool HostMatrixCSR<ValueType>::AnalyseStructure(int* max_row_nnz,
+                                                double* row_nnz_var,
+                                                int* num_diag,
+                                                int* block_dim) const
+{
+    assert(max_row_nnz != NULL);
+    assert(row_nnz_var != NULL);
+    assert(num_diag != NULL);
+    assert(block_dim != NULL);
+
+    *max_row_nnz = 0;
+    *row_nnz_var = 0.0;
+    *num_diag    = 0;
+    *block_dim   = 1;
+
+    if(this->nnz_ == 0)
+    {
+        return true;
+    }
+
+    // Row length statistics
+    double mean = static_cast<double>(this->nnz_) / this->nrow_;
+
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        int row_nnz = this->mat_.row_offset[ai + 1] - this->mat_.row_offset[ai];
+
+        *max_row_nnz = std::max(*max_row_nnz, row_nnz);
+        *row_nnz_var += (row_nnz - mean) * (row_nnz - mean);
+    }
+
+    *row_nnz_var /= this->nrow_;
+
+    // Occupied diagonals, offset by nrow - 1
+    std::vector<bool> diag_idx(this->nrow_ + this->ncol_ - 1, false);
+
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        for(int aj = this->mat_.row_offset[ai]; aj < this->mat_.row_offset[ai + 1]; ++aj)
+        {
+            int offset = this->mat_.col[aj] - ai + this->nrow_ - 1;
+
+            if(diag_idx[offset] == false)
+            {
+                diag_idx[offset] = true;
+                ++(*num_diag);
+            }
+        }
+    }
+
+    // Natural block dimension - all non-zeros have to form dense b x b blocks
+    for(int b = 4; b > 1; --b)
+    {
+        if((this->nrow_ % b != 0) || (this->ncol_ % b != 0) || (this->nnz_ % (b * b) != 0))
+        {
+            continue;
+        }
+
+        int nblock = this->ncol_ / b;
+
+        std::vector<int> count(nblock, 0);
+
+        bool dense = true;
+
+        for(int bi = 0; bi < this->nrow_ / b && dense == true; ++bi)
+        {
+            int row_begin = this->mat_.row_offset[bi * b];
+            int row_end   = this->mat_.row_offset[(bi + 1) * b];
+
+            for(int aj = row_begin; aj < row_end; ++aj)
+            {
+                ++count[this->mat_.col[aj] / b];
+            }
+
+            for(int aj = row_begin; aj < row_end; ++aj)
+            {
+                int bj = this->mat_.col[aj] / b;
+
+                if(count[bj] != 0 && count[bj] != b * b)
+                {
+                    dense = false;
+                }
+
+                count[bj] = 0;
+            }
+        }
+
+        if(dense == true)
+        {
+            *block_dim = b;
+            break;
+        }
+    }
+
+    return true;
+}
+
 template <typename ValueType>
 bool HostMatrixCSR<ValueType>::ReplaceColumnVector(int idx, const BaseVector<ValueType>& vec)
 {
@@ -62,6 +62,11 @@ class HostMatrixCSR : public HostMatrix<ValueType>
                                   int row_size,
                                   int col_size,
                                   BaseMatrix<ValueType>* mat) const;
+    virtual bool ExtractSubMatrices(int row_num_blocks,
+                                    int col_num_blocks,
+                                    const int* row_offset,
+                                    const int* col_offset,
+                                    BaseMatrix<ValueType>** mat) const;
 
     virtual bool ExtractDiagonal(BaseVector<ValueType>* vec_diag) const;
     virtual bool ExtractInverseDiagonal(BaseVector<ValueType>* vec_inv_diag) const;
@@ -95,6 +100,9 @@ class HostMatrixCSR : public HostMatrix<ValueType>
     virtual bool CMK(BaseVector<int>* permutation) const;
     virtual bool RCMK(BaseVector<int>* permutation) const;
     virtual bool ConnectivityOrder(BaseVector<int>* permutation) const;
+    virtual bool
+    KWayPartitioning(int num_parts, int** size_parts, BaseVector<int>* permutation) const;
+    virtual bool NestedDissection(BaseVector<int>* permutation) const;
 
     virtual bool ConvertFrom(const BaseMatrix<ValueType>& mat);
 
@@ -140,9 +148,40 @@ class HostMatrixCSR : public HostMatrix<ValueType>
     virtual void UAnalyseClear(void);
     virtual bool USolve(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
 
+    virtual bool MultiColoredLSweep(int num_colors,
+                                    const int* color_offsets,
+                                    bool diag_unit,
+                                    ValueType omega,
+                                    BaseVector<ValueType>* x) const;
+    virtual bool MultiColoredUSweep(int num_colors,
+                                    const int* color_offsets,
+                                    bool diag_unit,
+                                    ValueType omega,
+                                    BaseVector<ValueType>* x) const;
+
     virtual bool Gershgorin(ValueType& lambda_min, ValueType& lambda_max) const;
 
     virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+    virtual bool ApplyRows(int nrow,
+                           const int* rows,
+                           const BaseVector<ValueType>& in,
+                           BaseVector<ValueType>* out) const;
+    virtual bool
+    ApplyMulti(int k, const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+    virtual bool RestrictResidual(const BaseMatrix<ValueType>& A,
+                                  const BaseVector<ValueType>& b,
+                                  const BaseVector<ValueType>& x,
+                                  bool residual,
+                                  BaseVector<ValueType>* s,
+                                  BaseVector<ValueType>* out) const;
+    virtual bool CGIterations(const BaseVector<ValueType>* inv_diag,
+                              ValueType rho,
+                              bool (*check)(double res, void* data),
+                              void* data,
+                              BaseVector<ValueType>* x,
+                              BaseVector<ValueType>* r,
+                              BaseVector<ValueType>* p,
+                              BaseVector<ValueType>* q) const;
     virtual void
     ApplyAdd(const BaseVector<ValueType>& in, ValueType scalar, BaseVector<ValueType>* out) const;
 
@@ -150,6 +189,10 @@ class HostMatrixCSR : public HostMatrix<ValueType>
     virtual bool Transpose(void);
     virtual bool Sort(void);
     virtual bool Key(long int& row_key, long int& col_key, long int& val_key) const;
+    virtual bool AnalyseStructure(int* max_row_nnz,
+                                  double* row_nnz_var,
+                                  int* num_diag,
+                                  int* block_dim) const;
 
     virtual bool ReplaceColumnVector(int idx, const BaseVector<ValueType>& vec);
     virtual bool ExtractColumnVector(int idx, BaseVector<ValueType>* vec) const;
@@ -160,6 +203,8 @@ class HostMatrixCSR : public HostMatrix<ValueType>
     virtual bool AMGConnect(ValueType eps, BaseVector<int>* connections) const;
     virtual bool AMGAggregate(const BaseVector<int>& connections,
                               BaseVector<int>* aggregates) const;
+    virtual bool AMGMIS2Aggregate(const BaseVector<int>& connections,
+                                  BaseVector<int>* aggregates) const;
     virtual bool AMGSmoothedAggregation(ValueType relax,
                                         const BaseVector<int>& aggregates,
                                         const BaseVector<int>& connections,
@@ -172,6 +217,14 @@ class HostMatrixCSR : public HostMatrix<ValueType>
     virtual bool RugeStueben(ValueType eps,
                              BaseMatrix<ValueType>* prolong,
                              BaseMatrix<ValueType>* restrict) const;
+    virtual bool RugeStueben(ValueType eps,
+                             int coarsening,
+                             int interpolation,
+                             bool aggressive,
+                             ValueType trunc_factor,
+                             int trunc_max_elements,
+                             BaseMatrix<ValueType>* prolong,
+                             BaseMatrix<ValueType>* restrict) const;
 
     virtual bool FSAI(int power, const BaseMatrix<ValueType>* pattern);
     virtual bool SPAI(void);
@@ -226,6 +279,8 @@ class HostMatrixCSR : public HostMatrix<ValueType>
     friend class HostMatrixDENSE<ValueType>;
     friend class HostMatrixMCSR<ValueType>;
     friend class HostMatrixBCSR<ValueType>;
+    friend class HostMatrixSELL<ValueType>;
+    friend class HostMatrixCCSR<ValueType>;
 
     friend class HIPAcceleratorMatrixCSR<ValueType>;
 
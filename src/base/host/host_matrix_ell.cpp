@@ -305,6 +305,58 @@ void HostMatrixELL<ValueType>::Apply(const BaseVector<ValueType>& in,
     }
 }
 
+template <typename ValueType>
+bool HostMatrixELL<ValueType>::ApplyMulti(int k,
+                                          const BaseVector<ValueType>& in,
+                                          BaseVector<ValueType>* out) const
+{
+    assert(k > 0);
+    assert(in.GetSize() == static_cast<IndexType2>(this->ncol_) * k);
+    assert(out->GetSize() == static_cast<IndexType2>(this->nrow_) * k);
+
+    const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+    HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+    assert(cast_in != NULL);
+    assert(cast_out != NULL);
+
+    _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int ai = 0; ai < this->nrow_; ++ai)
+    {
+        ValueType* sum = cast_out->vec_ + static_cast<IndexType2>(ai) * k;
+
+        for(int j = 0; j < k; ++j)
+        {
+            sum[j] = static_cast<ValueType>(0);
+        }
+
+        for(int n = 0; n < this->mat_.max_row; ++n)
+        {
+            int aj     = ELL_IND(ai, n, this->nrow_, this->mat_.max_row);
+            int col_aj = this->mat_.col[aj];
+
+            if(col_aj < 0)
+            {
+                break;
+            }
+
+            ValueType val      = this->mat_.val[aj];
+            const ValueType* x = cast_in->vec_ + static_cast<IndexType2>(col_aj) * k;
+
+            for(int j = 0; j < k; ++j)
+            {
+                sum[j] += val * x[j];
+            }
+        }
+    }
+
+    return true;
+}
+
 template <typename ValueType>
 void HostMatrixELL<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
                                         ValueType scalar,
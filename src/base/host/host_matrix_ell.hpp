@@ -55,6 +55,8 @@ class HostMatrixELL : public HostMatrix<ValueType>
     virtual void CopyTo(BaseMatrix<ValueType>* mat) const;
 
     virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+    virtual bool
+    ApplyMulti(int k, const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
     virtual void
     ApplyAdd(const BaseVector<ValueType>& in, ValueType scalar, BaseVector<ValueType>* out) const;
 
@@ -24,6 +24,7 @@
 #include "../../utils/def.hpp"
 #include "host_matrix_hyb.hpp"
 #include "host_matrix_csr.hpp"
+#include "host_matrix_coo.hpp"
 #include "host_conversion.hpp"
 #include "host_vector.hpp"
 #include "../../utils/log.hpp"
@@ -330,11 +331,13 @@ void HostMatrixHYB<ValueType>::Apply(const BaseVector<ValueType>& in,
         // COO
         if(this->coo_nnz_ > 0)
         {
-            for(int i = 0; i < this->coo_nnz_; ++i)
-            {
-                cast_out->vec_[this->mat_.COO.row[i]] +=
-                    this->mat_.COO.val[i] * cast_in->vec_[this->mat_.COO.col[i]];
-            }
+            _set_omp_backend_threads(this->local_backend_, this->coo_nnz_);
+
+            host_coo_spmv(this->coo_nnz_,
+                          this->mat_.COO,
+                          cast_in->vec_,
+                          static_cast<ValueType>(1),
+                          cast_out->vec_);
         }
     }
 }
@@ -383,11 +386,10 @@ void HostMatrixHYB<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
         // COO
         if(this->coo_nnz_ > 0)
         {
-            for(int i = 0; i < this->coo_nnz_; ++i)
-            {
-                cast_out->vec_[this->mat_.COO.row[i]] +=
-                    scalar * this->mat_.COO.val[i] * cast_in->vec_[this->mat_.COO.col[i]];
-            }
+            _set_omp_backend_threads(this->local_backend_, this->coo_nnz_);
+
+            host_coo_spmv(
+                this->coo_nnz_, this->mat_.COO, cast_in->vec_, scalar, cast_out->vec_);
         }
     }
 }
@@ -0,0 +1,353 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../../utils/def.hpp"
+#include "host_matrix_sell.hpp"
+#include "host_matrix_csr.hpp"
+#include "host_conversion.hpp"
+#include "host_vector.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../matrix_formats_ind.hpp"
+
+#include <algorithm>
+#include <complex>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#endif
+
+// Chunk height, such that one column of a chunk fills a SIMD register
+#define SELL_CHUNK_SIZE(type) (SELL_SIMD_BYTES >= sizeof(type) ? SELL_SIMD_BYTES / sizeof(type) : 1)
+
+namespace rocalution {
+
+template <typename ValueType>
+HostMatrixSELL<ValueType>::HostMatrixSELL()
+{
+    // no default constructors
+    LOG_INFO("no default constructor");
+    FATAL_ERROR(__FILE__, __LINE__);
+}
+
+template <typename ValueType>
+HostMatrixSELL<ValueType>::HostMatrixSELL(const Rocalution_Backend_Descriptor local_backend)
+{
+    log_debug(this, "HostMatrixSELL::HostMatrixSELL()", "constructor with local_backend");
+
+    this->mat_.chunk_size   = SELL_CHUNK_SIZE(ValueType);
+    this->mat_.sigma        = SELL_SIGMA_CHUNKS * this->mat_.chunk_size;
+    this->mat_.chunk_offset = NULL;
+    this->mat_.row_perm     = NULL;
+    this->mat_.row_nnz      = NULL;
+    this->mat_.col          = NULL;
+    this->mat_.val          = NULL;
+
+    this->size_ = 0;
+
+    this->set_backend(local_backend);
+}
+
+template <typename ValueType>
+HostMatrixSELL<ValueType>::~HostMatrixSELL()
+{
+    log_debug(this, "HostMatrixSELL::~HostMatrixSELL()", "destructor");
+
+    this->Clear();
+}
+
+template <typename ValueType>
+void HostMatrixSELL<ValueType>::Info(void) const
+{
+    LOG_INFO("HostMatrixSELL<ValueType>, C=" << this->mat_.chunk_size
+                                             << " sigma=" << this->mat_.sigma
+                                             << " size=" << this->size_);
+}
+
+template <typename ValueType>
+void HostMatrixSELL<ValueType>::Clear()
+{
+    if(this->nnz_ > 0)
+    {
+        free_host(&this->mat_.chunk_offset);
+        free_host(&this->mat_.row_perm);
+        free_host(&this->mat_.row_nnz);
+        free_host(&this->mat_.col);
+        free_host(&this->mat_.val);
+
+        this->nrow_ = 0;
+        this->ncol_ = 0;
+        this->nnz_  = 0;
+        this->size_ = 0;
+    }
+}
+
+template <typename ValueType>
+void HostMatrixSELL<ValueType>::CopyFrom(const BaseMatrix<ValueType>& mat)
+{
+    // copy only in the same format
+    assert(this->GetMatFormat() == mat.GetMatFormat());
+
+    if(const HostMatrixSELL<ValueType>* cast_mat =
+           dynamic_cast<const HostMatrixSELL<ValueType>*>(&mat))
+    {
+        this->Clear();
+
+        if(cast_mat->nnz_ > 0)
+        {
+            int nrow   = cast_mat->nrow_;
+            int nchunk = (nrow - 1) / cast_mat->mat_.chunk_size + 1;
+            int size   = cast_mat->size_;
+
+            allocate_host(nchunk + 1, &this->mat_.chunk_offset);
+            allocate_host(nrow, &this->mat_.row_perm);
+            allocate_host(nrow, &this->mat_.row_nnz);
+            allocate_host(size, &this->mat_.col);
+            allocate_host(size, &this->mat_.val);
+
+            this->mat_.chunk_size = cast_mat->mat_.chunk_size;
+            this->mat_.sigma      = cast_mat->mat_.sigma;
+
+            this->nrow_ = nrow;
+            this->ncol_ = cast_mat->ncol_;
+            this->nnz_  = cast_mat->nnz_;
+            this->size_ = size;
+
+            _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+            for(int i = 0; i < nchunk + 1; ++i)
+            {
+                this->mat_.chunk_offset[i] = cast_mat->mat_.chunk_offset[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < nrow; ++i)
+            {
+                this->mat_.row_perm[i] = cast_mat->mat_.row_perm[i];
+                this->mat_.row_nnz[i]  = cast_mat->mat_.row_nnz[i];
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < size; ++i)
+            {
+                this->mat_.col[i] = cast_mat->mat_.col[i];
+                this->mat_.val[i] = cast_mat->mat_.val[i];
+            }
+        }
+    }
+    else
+    {
+        // Host matrix knows only host matrices
+        // -> dispatching
+        mat.CopyTo(this);
+    }
+}
+
+template <typename ValueType>
+void HostMatrixSELL<ValueType>::CopyTo(BaseMatrix<ValueType>* mat) const
+{
+    mat->CopyFrom(*this);
+}
+
+template <typename ValueType>
+bool HostMatrixSELL<ValueType>::ConvertFrom(const BaseMatrix<ValueType>& mat)
+{
+    this->Clear();
+
+    // empty matrix is empty matrix
+    if(mat.GetNnz() == 0)
+    {
+        return true;
+    }
+
+    if(const HostMatrixSELL<ValueType>* cast_mat =
+           dynamic_cast<const HostMatrixSELL<ValueType>*>(&mat))
+    {
+        this->CopyFrom(*cast_mat);
+        return true;
+    }
+
+    if(const HostMatrixCSR<ValueType>* cast_mat =
+           dynamic_cast<const HostMatrixCSR<ValueType>*>(&mat))
+    {
+        this->Clear();
+        int size = 0;
+
+        if(csr_to_sell(this->local_backend_.OpenMP_threads,
+                       cast_mat->nnz_,
+                       cast_mat->nrow_,
+                       cast_mat->ncol_,
+                       this->mat_.chunk_size,
+                       this->mat_.sigma,
+                       cast_mat->mat_,
+                       &this->mat_,
+                       &size) == true)
+        {
+            this->nrow_ = cast_mat->nrow_;
+            this->ncol_ = cast_mat->ncol_;
+            this->nnz_  = cast_mat->nnz_;
+            this->size_ = size;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <typename ValueType>
+void HostMatrixSELL<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                      BaseVector<ValueType>* out) const
+{
+    if(this->nnz_ > 0)
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        // Compile time chunk height, the loops over the slots of a chunk vectorize
+        const int chunk_size = SELL_CHUNK_SIZE(ValueType);
+        assert(this->mat_.chunk_size == chunk_size);
+
+        int nchunk = (this->nrow_ - 1) / chunk_size + 1;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int c = 0; c < nchunk; ++c)
+        {
+            int offset = this->mat_.chunk_offset[c];
+            int width  = (this->mat_.chunk_offset[c + 1] - offset) / chunk_size;
+
+            ValueType sum[chunk_size];
+
+            for(int r = 0; r < chunk_size; ++r)
+            {
+                sum[r] = static_cast<ValueType>(0);
+            }
+
+            for(int n = 0; n < width; ++n)
+            {
+                const int* col       = this->mat_.col + SELL_IND(offset, 0, n, chunk_size);
+                const ValueType* val = this->mat_.val + SELL_IND(offset, 0, n, chunk_size);
+
+                for(int r = 0; r < chunk_size; ++r)
+                {
+                    sum[r] += val[r] * cast_in->vec_[col[r]];
+                }
+            }
+
+            int nslot = std::min(chunk_size, this->nrow_ - c * chunk_size);
+
+            for(int r = 0; r < nslot; ++r)
+            {
+                cast_out->vec_[this->mat_.row_perm[c * chunk_size + r]] = sum[r];
+            }
+        }
+    }
+}
+
+template <typename ValueType>
+void HostMatrixSELL<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                         ValueType scalar,
+                                         BaseVector<ValueType>* out) const
+{
+    if(this->nnz_ > 0)
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->ncol_);
+        assert(out->GetSize() == this->nrow_);
+
+        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+
+        const int chunk_size = SELL_CHUNK_SIZE(ValueType);
+        assert(this->mat_.chunk_size == chunk_size);
+
+        int nchunk = (this->nrow_ - 1) / chunk_size + 1;
+
+        _set_omp_backend_threads(this->local_backend_, this->nrow_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int c = 0; c < nchunk; ++c)
+        {
+            int offset = this->mat_.chunk_offset[c];
+            int width  = (this->mat_.chunk_offset[c + 1] - offset) / chunk_size;
+
+            ValueType sum[chunk_size];
+
+            for(int r = 0; r < chunk_size; ++r)
+            {
+                sum[r] = static_cast<ValueType>(0);
+            }
+
+            for(int n = 0; n < width; ++n)
+            {
+                const int* col       = this->mat_.col + SELL_IND(offset, 0, n, chunk_size);
+                const ValueType* val = this->mat_.val + SELL_IND(offset, 0, n, chunk_size);
+
+                for(int r = 0; r < chunk_size; ++r)
+                {
+                    sum[r] += val[r] * cast_in->vec_[col[r]];
+                }
+            }
+
+            int nslot = std::min(chunk_size, this->nrow_ - c * chunk_size);
+
+            for(int r = 0; r < nslot; ++r)
+            {
+                cast_out->vec_[this->mat_.row_perm[c * chunk_size + r]] += scalar * sum[r];
+            }
+        }
+    }
+}
+
+template class HostMatrixSELL<double>;
+template class HostMatrixSELL<float>;
+#ifdef SUPPORT_COMPLEX
+template class HostMatrixSELL<std::complex<double>>;
+template class HostMatrixSELL<std::complex<float>>;
+#endif
+
+} // namespace rocalution
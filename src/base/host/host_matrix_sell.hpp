@@ -21,38 +21,48 @@
  *
  * ************************************************************************ */
 
-#ifndef ROCALUTION_HOST_STENCIL_LAPLACE2D_HPP_
-#define ROCALUTION_HOST_STENCIL_LAPLACE2D_HPP_
+#ifndef ROCALUTION_HOST_MATRIX_SELL_HPP_
+#define ROCALUTION_HOST_MATRIX_SELL_HPP_
 
 #include "../base_vector.hpp"
-#include "../base_stencil.hpp"
-#include "../stencil_types.hpp"
+#include "../base_matrix.hpp"
+#include "../matrix_formats.hpp"
 
 namespace rocalution {
 
 template <typename ValueType>
-class HostStencilLaplace2D : public HostStencil<ValueType>
+class HostMatrixSELL : public HostMatrix<ValueType>
 {
     public:
-    HostStencilLaplace2D();
-    HostStencilLaplace2D(const Rocalution_Backend_Descriptor local_backend);
-    virtual ~HostStencilLaplace2D();
+    HostMatrixSELL();
+    HostMatrixSELL(const Rocalution_Backend_Descriptor local_backend);
+    virtual ~HostMatrixSELL();
 
-    virtual int GetNnz(void) const;
     virtual void Info(void) const;
-    virtual unsigned int GetStencilId(void) const { return Laplace2D; }
+    virtual unsigned int GetMatFormat(void) const { return SELL; }
+
+    virtual void Clear(void);
+
+    virtual bool ConvertFrom(const BaseMatrix<ValueType>& mat);
+
+    virtual void CopyFrom(const BaseMatrix<ValueType>& mat);
+    virtual void CopyTo(BaseMatrix<ValueType>* mat) const;
 
     virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
     virtual void
     ApplyAdd(const BaseVector<ValueType>& in, ValueType scalar, BaseVector<ValueType>* out) const;
 
     private:
+    MatrixSELL<ValueType, int> mat_;
+
+    // Number of stored entries, including padding
+    int size_;
+
     friend class BaseVector<ValueType>;
     friend class HostVector<ValueType>;
-
-    // friend class HIPAcceleratorStencilLaplace2D<ValueType>;
+    friend class HostMatrixCSR<ValueType>;
 };
 
 } // namespace rocalution
 
-#endif // ROCALUTION_HOST_STENCIL_LAPLACE2D_HPP_
+#endif // ROCALUTION_HOST_MATRIX_SELL_HPP_
@@ -0,0 +1,1325 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "../../utils/def.hpp"
+#include "../../utils/types.hpp"
+#include "host_stencil_general.hpp"
+#include "host_vector.hpp"
+#include "../../utils/log.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../stencil_types.hpp"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp_set_num_threads(num) ;
+#define omp_get_max_threads() 1
+#endif
+
+// Cache budget (in bytes) for the input planes of a block of grid lines
+#define STENCIL_BLOCK_BYTES 262144
+
+namespace rocalution {
+
+// Number of coarse grid points of a grid dimension with n points. Dimensions with less
+// than three points are not coarsened.
+static inline int coarse_grid_size(int n)
+{
+    return (n >= 3) ? n / 2 : n;
+}
+
+// Fine grid point that coincides with coarse grid point i
+static inline int coarse_to_fine(int i, int n, int m)
+{
+    return (m == n) ? i : 2 * i + 1;
+}
+
+// Fine grid points and weights of the full weighting restriction to coarse grid point i.
+// Points outside of [0, n) are dropped, if bounded is true.
+template <typename ValueType>
+static inline int restriction_weights(int i, int n, int m, bool bounded, int* idx, ValueType* w)
+{
+    if(m == n)
+    {
+        idx[0] = i;
+        w[0]   = static_cast<ValueType>(1);
+
+        return 1;
+    }
+
+    int cnt = 0;
+
+    for(int d = 0; d < 3; ++d)
+    {
+        int f = 2 * i + d;
+
+        if(bounded == false || f < n)
+        {
+            idx[cnt] = f;
+            w[cnt]   = static_cast<ValueType>((d == 1) ? 0.5 : 0.25);
+            ++cnt;
+        }
+    }
+
+    return cnt;
+}
+
+// Coarse grid points and weights of the linear interpolation to fine grid point i.
+// Points outside of [0, m) are dropped, if bounded is true.
+template <typename ValueType>
+static inline int
+    interpolation_weights(int i, int n, int m, bool bounded, int* idx, ValueType* w)
+{
+    if(m == n || i % 2 != 0)
+    {
+        idx[0] = (m == n) ? i : (i - 1) / 2;
+        w[0]   = static_cast<ValueType>(1);
+
+        return 1;
+    }
+
+    int cnt = 0;
+
+    if(bounded == false || i / 2 - 1 >= 0)
+    {
+        idx[cnt] = i / 2 - 1;
+        w[cnt]   = static_cast<ValueType>(0.5);
+        ++cnt;
+    }
+
+    if(bounded == false || i / 2 < m)
+    {
+        idx[cnt] = i / 2;
+        w[cnt]   = static_cast<ValueType>(0.5);
+        ++cnt;
+    }
+
+    return cnt;
+}
+
+template <typename ValueType>
+HostStencilGeneral<ValueType>::HostStencilGeneral()
+{
+    // no default constructors
+    LOG_INFO("no default constructor");
+    FATAL_ERROR(__FILE__, __LINE__);
+}
+
+template <typename ValueType>
+HostStencilGeneral<ValueType>::HostStencilGeneral(
+    const Rocalution_Backend_Descriptor local_backend, unsigned int type)
+{
+    log_debug(this, "HostStencilGeneral::HostStencilGeneral()", "constructor with local_backend");
+
+    this->set_backend(local_backend);
+
+    this->type_ = type;
+
+    this->npoint_   = 0;
+    this->offset_   = NULL;
+    this->coef_     = NULL;
+    this->var_coef_ = NULL;
+    this->inv_diag_ = NULL;
+    this->center_   = -1;
+    this->ry_       = 0;
+    this->rz_       = 0;
+}
+
+template <typename ValueType>
+HostStencilGeneral<ValueType>::~HostStencilGeneral()
+{
+    log_debug(this, "HostStencilGeneral::~HostStencilGeneral()", "destructor");
+
+    if(this->npoint_ > 0)
+    {
+        free_host(&this->offset_);
+        free_host(&this->coef_);
+    }
+
+    this->ClearCoefficients_();
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::Info(void) const
+{
+    LOG_INFO("Stencil " << _stencil_type_names[this->type_] << " (Host)"
+                        << " grid=" << this->grid_[0] << "x" << this->grid_[1] << "x"
+                        << this->grid_[2] << " dim=" << this->GetNDim()
+                        << " points=" << this->npoint_ << " coefficients="
+                        << ((this->var_coef_ != NULL) ? "variable" : "constant"));
+}
+
+template <typename ValueType>
+int HostStencilGeneral<ValueType>::GetNnz(void) const
+{
+    return this->npoint_;
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::GetDims_(int& nx, int& ny, int& nz) const
+{
+    nx = (this->ndim_ > 0) ? this->grid_[0] : 0;
+    ny = (this->ndim_ == 3) ? this->grid_[1] : 1;
+    nz = (this->ndim_ == 3) ? this->grid_[2] : ((this->ndim_ == 2) ? this->grid_[1] : 1);
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::GetCoarseDims_(int& mx, int& my, int& mz) const
+{
+    int nx, ny, nz;
+    this->GetDims_(nx, ny, nz);
+
+    mx = coarse_grid_size(nx);
+    my = coarse_grid_size(ny);
+    mz = coarse_grid_size(nz);
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::ExportOffsets_(int n, const int* offset, int* dst) const
+{
+    int ndim = this->ndim_;
+
+    for(int k = 0; k < n; ++k)
+    {
+        dst[ndim * k] = offset[3 * k + 0];
+
+        if(ndim == 2)
+        {
+            dst[ndim * k + 1] = offset[3 * k + 2];
+        }
+        else if(ndim == 3)
+        {
+            dst[ndim * k + 1] = offset[3 * k + 1];
+            dst[ndim * k + 2] = offset[3 * k + 2];
+        }
+    }
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::ClearCoefficients_(void)
+{
+    if(this->var_coef_ != NULL)
+    {
+        free_host(&this->var_coef_);
+    }
+
+    if(this->inv_diag_ != NULL)
+    {
+        free_host(&this->inv_diag_);
+    }
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::SetGrid(int size)
+{
+    // Variable coefficients are bound to the grid
+    this->ClearCoefficients_();
+
+    HostStencil<ValueType>::SetGrid(size);
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::SetGrid(int nx, int ny, int nz)
+{
+    // Variable coefficients are bound to the grid
+    this->ClearCoefficients_();
+
+    HostStencil<ValueType>::SetGrid(nx, ny, nz);
+}
+
+template <typename ValueType>
+bool HostStencilGeneral<ValueType>::SetStencil(int ndim,
+                                               int npoint,
+                                               const int* offset,
+                                               const ValueType* coef)
+{
+    assert(ndim > 0 && ndim <= 3);
+    assert(npoint > 0);
+    assert(offset != NULL);
+    assert(coef != NULL);
+
+    if(this->npoint_ > 0)
+    {
+        free_host(&this->offset_);
+        free_host(&this->coef_);
+    }
+
+    this->ClearCoefficients_();
+
+    this->ndim_   = ndim;
+    this->npoint_ = npoint;
+    this->center_ = -1;
+    this->ry_     = 0;
+    this->rz_     = 0;
+
+    allocate_host(3 * npoint, &this->offset_);
+    allocate_host(npoint, &this->coef_);
+
+    for(int k = 0; k < npoint; ++k)
+    {
+        int off[3] = {0, 0, 0};
+
+        for(int d = 0; d < ndim; ++d)
+        {
+            off[d] = offset[ndim * k + d];
+        }
+
+        // The slowest dimension is always stored as z
+        this->offset_[3 * k + 0] = off[0];
+        this->offset_[3 * k + 1] = (ndim == 3) ? off[1] : 0;
+        this->offset_[3 * k + 2] = (ndim == 3) ? off[2] : off[1];
+
+        this->coef_[k] = coef[k];
+
+        this->ry_ = std::max(this->ry_, std::abs(this->offset_[3 * k + 1]));
+        this->rz_ = std::max(this->rz_, std::abs(this->offset_[3 * k + 2]));
+
+        if(off[0] == 0 && off[1] == 0 && off[2] == 0)
+        {
+            // Each offset is only allowed once
+            assert(this->center_ < 0);
+
+            this->center_ = k;
+        }
+    }
+
+    // Re-apply the grid in the new dimension
+    HostStencil<ValueType>::SetGrid(this->grid_[0], this->grid_[1], this->grid_[2]);
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostStencilGeneral<ValueType>::SetCoefficients(const ValueType* coef)
+{
+    assert(coef != NULL);
+    assert(this->npoint_ > 0);
+
+    IndexType2 size = static_cast<IndexType2>(this->npoint_) * this->GetM();
+
+    if(this->var_coef_ == NULL)
+    {
+        allocate_host(IndexTypeToInt(size), &this->var_coef_);
+    }
+
+    _set_omp_backend_threads(this->local_backend_, this->GetM());
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType2 i = 0; i < size; ++i)
+    {
+        this->var_coef_[i] = coef[i];
+    }
+
+    // Inverse diagonal for smoothing
+    if(this->center_ >= 0)
+    {
+        int nrow = this->GetM();
+
+        if(this->inv_diag_ == NULL)
+        {
+            allocate_host(nrow, &this->inv_diag_);
+        }
+
+        const ValueType* diag = this->var_coef_ + static_cast<IndexType2>(this->center_) * nrow;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            this->inv_diag_[i] = static_cast<ValueType>(1) / diag[i];
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::ApplyLine_(const ValueType* const* plane,
+                                               int y,
+                                               int z,
+                                               ValueType* line) const
+{
+    int nx, ny, nz;
+    this->GetDims_(nx, ny, nz);
+
+    for(int x = 0; x < nx; ++x)
+    {
+        line[x] = static_cast<ValueType>(0);
+    }
+
+    // Accumulate one stencil point at a time, such that the inner loops are free of
+    // boundary checks and can be vectorized
+    for(int k = 0; k < this->npoint_; ++k)
+    {
+        int dx = this->offset_[3 * k + 0];
+        int dy = this->offset_[3 * k + 1];
+        int dz = this->offset_[3 * k + 2];
+
+        const ValueType* p = plane[dz + this->rz_];
+
+        if(p == NULL || y + dy < 0 || y + dy >= ny)
+        {
+            continue;
+        }
+
+        int xbeg = std::max(0, -dx);
+        int xend = std::min(nx, nx - dx);
+
+        const ValueType* src = p + (y + dy) * nx + dx;
+
+        if(this->var_coef_ != NULL)
+        {
+            const ValueType* c = this->var_coef_ + static_cast<IndexType2>(k) * this->GetM()
+                                 + (static_cast<IndexType2>(z) * ny + y) * nx;
+
+            for(int x = xbeg; x < xend; ++x)
+            {
+                line[x] += c[x] * src[x];
+            }
+        }
+        else
+        {
+            ValueType c = this->coef_[k];
+
+            for(int x = xbeg; x < xend; ++x)
+            {
+                line[x] += c * src[x];
+            }
+        }
+    }
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::ApplyInternal_(const ValueType* in,
+                                                   ValueType scalar,
+                                                   bool add,
+                                                   ValueType* out) const
+{
+    int nx, ny, nz;
+    this->GetDims_(nx, ny, nz);
+
+    int nrow = this->GetM();
+
+    _set_omp_backend_threads(this->local_backend_, nrow);
+
+    // The grid is processed in tiles of (block of y lines) x (chunk of z planes). Within a
+    // tile, the planes z-rz, ..., z+rz of the current y block stay in cache while z advances.
+    int nplane = 2 * this->rz_ + 1;
+    int by = std::max(1, STENCIL_BLOCK_BYTES / (nplane * nx * (int)sizeof(ValueType)));
+    by     = std::min(by, ny);
+
+    int nyb = (ny - 1) / by + 1;
+    int nzc = std::min(nz, std::max(1, (4 * omp_get_max_threads() - 1) / nyb + 1));
+    int bz  = (nz - 1) / nzc + 1;
+    nzc     = (nz - 1) / bz + 1;
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<const ValueType*> plane(nplane);
+        std::vector<ValueType> line(nx);
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(int tile = 0; tile < nyb * nzc; ++tile)
+        {
+            int ybeg = (tile % nyb) * by;
+            int yend = std::min(ybeg + by, ny);
+            int zbeg = (tile / nyb) * bz;
+            int zend = std::min(zbeg + bz, nz);
+
+            for(int z = zbeg; z < zend; ++z)
+            {
+                for(int dz = -this->rz_; dz <= this->rz_; ++dz)
+                {
+                    int zz = z + dz;
+
+                    plane[dz + this->rz_]
+                        = (zz >= 0 && zz < nz) ? in + static_cast<IndexType2>(zz) * nx * ny
+                                               : NULL;
+                }
+
+                for(int y = ybeg; y < yend; ++y)
+                {
+                    ValueType* dst = out + (static_cast<IndexType2>(z) * ny + y) * nx;
+
+                    if(add == false)
+                    {
+                        this->ApplyLine_(&plane[0], y, z, dst);
+                    }
+                    else
+                    {
+                        this->ApplyLine_(&plane[0], y, z, &line[0]);
+
+                        for(int x = 0; x < nx; ++x)
+                        {
+                            dst[x] += scalar * line[x];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::Apply(const BaseVector<ValueType>& in,
+                                          BaseVector<ValueType>* out) const
+{
+    if((this->ndim_ > 0) && (this->GetM() > 0))
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+
+        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+        assert(cast_in != cast_out);
+
+        this->ApplyInternal_(cast_in->vec_, static_cast<ValueType>(1), false, cast_out->vec_);
+    }
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::ApplyAdd(const BaseVector<ValueType>& in,
+                                             ValueType scalar,
+                                             BaseVector<ValueType>* out) const
+{
+    if((this->ndim_ > 0) && (this->GetM() > 0))
+    {
+        assert(in.GetSize() >= 0);
+        assert(out->GetSize() >= 0);
+        assert(in.GetSize() == this->GetN());
+        assert(out->GetSize() == this->GetM());
+
+        const HostVector<ValueType>* cast_in = dynamic_cast<const HostVector<ValueType>*>(&in);
+        HostVector<ValueType>* cast_out      = dynamic_cast<HostVector<ValueType>*>(out);
+
+        assert(cast_in != NULL);
+        assert(cast_out != NULL);
+        assert(cast_in != cast_out);
+
+        this->ApplyInternal_(cast_in->vec_, scalar, true, cast_out->vec_);
+    }
+}
+
+template <typename ValueType>
+bool HostStencilGeneral<ValueType>::Smooth(const BaseVector<ValueType>& rhs,
+                                           int nsweep,
+                                           const ValueType* omega,
+                                           BaseVector<ValueType>* x) const
+{
+    // Jacobi requires the center point
+    if(this->center_ < 0)
+    {
+        return false;
+    }
+
+    if((this->ndim_ == 0) || (this->GetM() == 0) || (nsweep == 0))
+    {
+        return true;
+    }
+
+    assert(nsweep > 0);
+    assert(omega != NULL);
+    assert(rhs.GetSize() == this->GetM());
+    assert(x->GetSize() == this->GetM());
+
+    const HostVector<ValueType>* cast_rhs = dynamic_cast<const HostVector<ValueType>*>(&rhs);
+    HostVector<ValueType>* cast_x         = dynamic_cast<HostVector<ValueType>*>(x);
+
+    assert(cast_rhs != NULL);
+    assert(cast_x != NULL);
+
+    int nx, ny, nz;
+    this->GetDims_(nx, ny, nz);
+
+    int nrow     = this->GetM();
+    int rz       = this->rz_;
+    int nplane   = 2 * rz + 1;
+    IndexType2 s = static_cast<IndexType2>(nx) * ny;
+
+    _set_omp_backend_threads(this->local_backend_, nrow);
+
+    // Inverse diagonal for constant coefficients
+    ValueType inv_diag = static_cast<ValueType>(1) / this->coef_[this->center_];
+
+    ValueType* out = NULL;
+    allocate_host(nrow, &out);
+
+    const ValueType* b = cast_rhs->vec_;
+    const ValueType* x0 = cast_x->vec_;
+
+    // Temporal blocking: each thread owns a slab of z planes and performs all sweeps on
+    // it in a wavefront, i.e. sweep t works on plane q while sweep t-1 has just finished
+    // plane q + rz. The intermediate iterates only live in ring buffers of 2 * rz + 1
+    // planes per sweep. To be independent of the other threads, the slab is extended by
+    // (nsweep - t) * rz planes on both sides for sweep t, which are computed redundantly.
+    int nslab = std::min(nz, omp_get_max_threads());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for(int slab = 0; slab < nslab; ++slab)
+    {
+        int z0 = static_cast<int>(static_cast<IndexType2>(slab) * nz / nslab);
+        int z1 = static_cast<int>(static_cast<IndexType2>(slab + 1) * nz / nslab);
+
+        std::vector<ValueType> ring(static_cast<size_t>(nsweep - 1) * nplane * s);
+        std::vector<const ValueType*> plane(nplane);
+        std::vector<ValueType> line(nx);
+
+        int zlo = std::max(0, z0 - (nsweep - 1) * rz);
+        int zhi = std::min(nz, z1 + (nsweep - 1) * rz);
+
+        for(int step = zlo; step < zhi + (nsweep - 1) * rz; ++step)
+        {
+            for(int t = 1; t <= nsweep; ++t)
+            {
+                int q = step - (t - 1) * rz;
+
+                if(q < std::max(0, z0 - (nsweep - t) * rz)
+                   || q >= std::min(nz, z1 + (nsweep - t) * rz))
+                {
+                    continue;
+                }
+
+                // Source planes (iterate t - 1)
+                for(int dz = -rz; dz <= rz; ++dz)
+                {
+                    int zz = q + dz;
+
+                    if(zz < 0 || zz >= nz)
+                    {
+                        plane[dz + rz] = NULL;
+                    }
+                    else if(t == 1)
+                    {
+                        plane[dz + rz] = x0 + zz * s;
+                    }
+                    else
+                    {
+                        plane[dz + rz] = &ring[((t - 2) * nplane + zz % nplane) * s];
+                    }
+                }
+
+                // Destination plane (iterate t)
+                ValueType* dst
+                    = (t == nsweep) ? out + q * s : &ring[((t - 1) * nplane + q % nplane) * s];
+
+                const ValueType* xold = plane[rz];
+                ValueType w           = omega[t - 1];
+
+                for(int y = 0; y < ny; ++y)
+                {
+                    this->ApplyLine_(&plane[0], y, q, &line[0]);
+
+                    IndexType2 base = q * s + static_cast<IndexType2>(y) * nx;
+
+                    if(this->inv_diag_ != NULL)
+                    {
+                        const ValueType* dinv = this->inv_diag_ + base;
+
+                        for(int x = 0; x < nx; ++x)
+                        {
+                            dst[y * nx + x]
+                                = xold[y * nx + x] + w * dinv[x] * (b[base + x] - line[x]);
+                        }
+                    }
+                    else
+                    {
+                        ValueType wd = w * inv_diag;
+
+                        for(int x = 0; x < nx; ++x)
+                        {
+                            dst[y * nx + x] = xold[y * nx + x] + wd * (b[base + x] - line[x]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        cast_x->vec_[i] = out[i];
+    }
+
+    free_host(&out);
+
+    return true;
+}
+
+template <typename ValueType>
+void HostStencilGeneral<ValueType>::GalerkinRow_(
+    int x, int y, int z, bool bounded, const int* r, ValueType* acc) const
+{
+    int n[3];
+    int m[3];
+
+    this->GetDims_(n[0], n[1], n[2]);
+    this->GetCoarseDims_(m[0], m[1], m[2]);
+
+    int c[3] = {x, y, z};
+    int b[2] = {2 * r[0] + 1, 2 * r[1] + 1};
+
+    IndexType2 nrow = this->GetM();
+
+    // Fine grid points of the restriction
+    int ri[3][3];
+    int rn[3];
+    ValueType rw[3][3];
+
+    for(int d = 0; d < 3; ++d)
+    {
+        rn[d] = restriction_weights(c[d], n[d], m[d], bounded, ri[d], rw[d]);
+    }
+
+    for(int fz = 0; fz < rn[2]; ++fz)
+    {
+        for(int fy = 0; fy < rn[1]; ++fy)
+        {
+            for(int fx = 0; fx < rn[0]; ++fx)
+            {
+                int f[3]     = {ri[0][fx], ri[1][fy], ri[2][fz]};
+                ValueType wr = rw[0][fx] * rw[1][fy] * rw[2][fz];
+
+                IndexType2 row = (static_cast<IndexType2>(f[2]) * n[1] + f[1]) * n[0] + f[0];
+
+                for(int k = 0; k < this->npoint_; ++k)
+                {
+                    int j[3];
+                    bool inside = true;
+
+                    for(int d = 0; d < 3; ++d)
+                    {
+                        j[d] = f[d] + this->offset_[3 * k + d];
+
+                        if(bounded == true && (j[d] < 0 || j[d] >= n[d]))
+                        {
+                            inside = false;
+                        }
+                    }
+
+                    if(inside == false)
+                    {
+                        continue;
+                    }
+
+                    ValueType val = wr
+                                    * ((bounded == true && this->var_coef_ != NULL)
+                                           ? this->var_coef_[k * nrow + row]
+                                           : this->coef_[k]);
+
+                    // Coarse grid points of the interpolation
+                    int pi[3][2];
+                    int pn[3];
+                    ValueType pw[3][2];
+
+                    for(int d = 0; d < 3; ++d)
+                    {
+                        pn[d] = interpolation_weights(j[d], n[d], m[d], bounded, pi[d], pw[d]);
+                    }
+
+                    for(int pz = 0; pz < pn[2]; ++pz)
+                    {
+                        for(int py = 0; py < pn[1]; ++py)
+                        {
+                            for(int px = 0; px < pn[0]; ++px)
+                            {
+                                int idx = ((pi[2][pz] - c[2] + r[2]) * b[1]
+                                           + (pi[1][py] - c[1] + r[1]))
+                                              * b[0]
+                                          + (pi[0][px] - c[0] + r[0]);
+
+                                acc[idx] += val * pw[0][px] * pw[1][py] * pw[2][pz];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename ValueType>
+bool HostStencilGeneral<ValueType>::Coarsen(bool galerkin, BaseStencil<ValueType>* coarse) const
+{
+    HostStencilGeneral<ValueType>* cast_coarse
+        = dynamic_cast<HostStencilGeneral<ValueType>*>(coarse);
+
+    assert(cast_coarse != NULL);
+    assert(cast_coarse != this);
+
+    if((this->npoint_ == 0) || (this->GetM() == 0))
+    {
+        return false;
+    }
+
+    int ndim = this->ndim_;
+
+    // Coarse grid in the user layout
+    int grid[3] = {1, 1, 1};
+    bool full   = true;
+
+    for(int d = 0; d < ndim; ++d)
+    {
+        grid[d] = coarse_grid_size(this->grid_[d]);
+        full    = full && (grid[d] != this->grid_[d]) && (this->grid_[d] % 2 == 1);
+    }
+
+    int n[3];
+    int m[3];
+
+    this->GetDims_(n[0], n[1], n[2]);
+    this->GetCoarseDims_(m[0], m[1], m[2]);
+
+    int mrow = m[0] * m[1] * m[2];
+
+    _set_omp_backend_threads(this->local_backend_, this->GetM());
+
+    // Rediscretization assumes a second order operator, whose coefficients scale with
+    // 1/h^2, such that doubling the grid spacing scales the stencil by 1/4. Variable
+    // coefficients are injected from the coinciding fine grid points. The coarse grid is
+    // only uniform with respect to the boundary, if all dimensions are coarsened from an
+    // odd number of points. Otherwise, the Galerkin product is used instead.
+    if(galerkin == false && full == true)
+    {
+        std::vector<int> offset(ndim * this->npoint_);
+        std::vector<ValueType> coef(this->npoint_);
+
+        this->ExportOffsets_(this->npoint_, this->offset_, &offset[0]);
+
+        for(int k = 0; k < this->npoint_; ++k)
+        {
+            coef[k] = static_cast<ValueType>(0.25) * this->coef_[k];
+        }
+
+        cast_coarse->SetStencil(ndim, this->npoint_, &offset[0], &coef[0]);
+        cast_coarse->SetGrid(grid[0], grid[1], grid[2]);
+
+        if(this->var_coef_ != NULL)
+        {
+            IndexType2 nrow = this->GetM();
+
+            std::vector<ValueType> var(static_cast<size_t>(this->npoint_) * mrow);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for(int i = 0; i < mrow; ++i)
+            {
+                int x = coarse_to_fine(i % m[0], n[0], m[0]);
+                int y = coarse_to_fine((i / m[0]) % m[1], n[1], m[1]);
+                int z = coarse_to_fine(i / (m[0] * m[1]), n[2], m[2]);
+
+                IndexType2 row = (static_cast<IndexType2>(z) * n[1] + y) * n[0] + x;
+
+                for(int k = 0; k < this->npoint_; ++k)
+                {
+                    var[static_cast<size_t>(k) * mrow + i]
+                        = static_cast<ValueType>(0.25) * this->var_coef_[k * nrow + row];
+                }
+            }
+
+            cast_coarse->SetCoefficients(&var[0]);
+        }
+
+        return true;
+    }
+
+    // Galerkin product R * this * P, where R is the full weighting restriction and P the
+    // (bi-, tri-)linear interpolation. With a stencil radius of r on the fine grid, the
+    // coarse stencil has radius (r + 2) / 2 in each coarsened dimension.
+    int rf[3] = {0, 0, 0};
+    int r[3];
+
+    for(int k = 0; k < this->npoint_; ++k)
+    {
+        for(int d = 0; d < 3; ++d)
+        {
+            rf[d] = std::max(rf[d], std::abs(this->offset_[3 * k + d]));
+        }
+    }
+
+    for(int d = 0; d < 3; ++d)
+    {
+        r[d] = (m[d] == n[d]) ? rf[d] : (rf[d] + 2) / 2;
+    }
+
+    int b[3]   = {2 * r[0] + 1, 2 * r[1] + 1, 2 * r[2] + 1};
+    int nbox   = b[0] * b[1] * b[2];
+    int center = (r[2] * b[1] + r[1]) * b[0] + r[0];
+
+    // For constant coefficients and an odd number of points in each coarsened dimension,
+    // the boundary truncates the fine and the coarse grid consistently, and the Galerkin
+    // product is the (constant) product on the unbounded grid
+    bool uniform = (this->var_coef_ == NULL);
+
+    for(int d = 0; d < 3; ++d)
+    {
+        if(m[d] != n[d] && n[d] % 2 == 0)
+        {
+            uniform = false;
+        }
+    }
+
+    int nrowc = uniform ? 1 : mrow;
+
+    std::vector<ValueType> rap(static_cast<size_t>(nbox) * nrowc, static_cast<ValueType>(0));
+    std::vector<ValueType> inner(nbox, static_cast<ValueType>(0));
+
+    if(this->var_coef_ == NULL)
+    {
+        this->GalerkinRow_(0, 0, 0, false, r, &inner[0]);
+    }
+
+    if(uniform == true)
+    {
+        rap = inner;
+    }
+    else
+    {
+        // Coarse rows, whose Galerkin product only involves points inside of the fine and
+        // the coarse grid, are equal to the unbounded product for constant coefficients
+        int lo[3];
+        int hi[3];
+
+        for(int d = 0; d < 3; ++d)
+        {
+            if(m[d] == n[d])
+            {
+                lo[d] = rf[d];
+                hi[d] = n[d] - rf[d];
+            }
+            else
+            {
+                // Fine points 2i - rf, ..., 2i + 2 + rf and coarse points i - r, ..., i + r
+                int top = n[d] - 3 - rf[d];
+
+                lo[d] = std::max(r[d], (rf[d] + 1) / 2);
+                hi[d] = std::min(m[d] - r[d], (top >= 0) ? top / 2 + 1 : 0);
+            }
+        }
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            std::vector<ValueType> acc(nbox);
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for(int i = 0; i < mrow; ++i)
+            {
+                int c[3] = {i % m[0], (i / m[0]) % m[1], i / (m[0] * m[1])};
+
+                bool interior = (this->var_coef_ == NULL);
+
+                for(int d = 0; d < 3; ++d)
+                {
+                    interior = interior && (c[d] >= lo[d]) && (c[d] < hi[d]);
+                }
+
+                if(interior == true)
+                {
+                    acc = inner;
+                }
+                else
+                {
+                    std::fill(acc.begin(), acc.end(), static_cast<ValueType>(0));
+
+                    this->GalerkinRow_(c[0], c[1], c[2], true, r, &acc[0]);
+                }
+
+                for(int k = 0; k < nbox; ++k)
+                {
+                    rap[static_cast<size_t>(k) * mrow + i] = acc[k];
+                }
+            }
+        }
+    }
+
+    // Keep the center and all offsets with a non-zero coefficient, and check whether the
+    // coefficients are constant
+    std::vector<int> keep;
+    bool constant = true;
+
+    for(int k = 0; k < nbox; ++k)
+    {
+        const ValueType* val = &rap[static_cast<size_t>(k) * nrowc];
+
+        bool nonzero = (k == center);
+
+        for(int i = 0; i < nrowc; ++i)
+        {
+            nonzero = nonzero || (val[i] != static_cast<ValueType>(0));
+            constant = constant && (val[i] == val[0]);
+        }
+
+        if(nonzero == true)
+        {
+            keep.push_back(k);
+        }
+    }
+
+    int npoint = static_cast<int>(keep.size());
+
+    std::vector<int> off(3 * npoint);
+    std::vector<int> offset(ndim * npoint);
+    std::vector<ValueType> coef(npoint);
+
+    for(int p = 0; p < npoint; ++p)
+    {
+        int k = keep[p];
+
+        off[3 * p + 0] = k % b[0] - r[0];
+        off[3 * p + 1] = (k / b[0]) % b[1] - r[1];
+        off[3 * p + 2] = k / (b[0] * b[1]) - r[2];
+
+        coef[p] = rap[static_cast<size_t>(k) * nrowc];
+    }
+
+    this->ExportOffsets_(npoint, &off[0], &offset[0]);
+
+    cast_coarse->SetStencil(ndim, npoint, &offset[0], &coef[0]);
+    cast_coarse->SetGrid(grid[0], grid[1], grid[2]);
+
+    if(constant == false)
+    {
+        // Compact the coefficients of the kept offsets
+        for(int p = 0; p < npoint; ++p)
+        {
+            if(keep[p] != p)
+            {
+                std::copy(rap.begin() + static_cast<size_t>(keep[p]) * mrow,
+                          rap.begin() + static_cast<size_t>(keep[p] + 1) * mrow,
+                          rap.begin() + static_cast<size_t>(p) * mrow);
+            }
+        }
+
+        cast_coarse->SetCoefficients(&rap[0]);
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostStencilGeneral<ValueType>::ResidualRestrict(const BaseVector<ValueType>& rhs,
+                                                     const BaseVector<ValueType>& x,
+                                                     BaseVector<ValueType>* res) const
+{
+    if((this->ndim_ == 0) || (this->GetM() == 0))
+    {
+        return true;
+    }
+
+    int nx, ny, nz;
+    int mx, my, mz;
+
+    this->GetDims_(nx, ny, nz);
+    this->GetCoarseDims_(mx, my, mz);
+
+    assert(rhs.GetSize() == this->GetM());
+    assert(x.GetSize() == this->GetM());
+    assert(res->GetSize() == mx * my * mz);
+
+    const HostVector<ValueType>* cast_rhs = dynamic_cast<const HostVector<ValueType>*>(&rhs);
+    const HostVector<ValueType>* cast_x   = dynamic_cast<const HostVector<ValueType>*>(&x);
+    HostVector<ValueType>* cast_res       = dynamic_cast<HostVector<ValueType>*>(res);
+
+    assert(cast_rhs != NULL);
+    assert(cast_x != NULL);
+    assert(cast_res != NULL);
+
+    const ValueType* b  = cast_rhs->vec_;
+    const ValueType* xv = cast_x->vec_;
+    ValueType* rc       = cast_res->vec_;
+
+    int rz       = this->rz_;
+    int nplane   = 2 * rz + 1;
+    IndexType2 s = static_cast<IndexType2>(nx) * ny;
+
+    _set_omp_backend_threads(this->local_backend_, this->GetM());
+
+    // Each thread owns a slab of coarse planes. The residual of the (up to three) fine
+    // planes that are restricted to a coarse plane is computed into a ring buffer, such
+    // that the fine residual never goes to memory and the fine plane shared by two
+    // consecutive coarse planes is computed only once.
+    int nslab = std::min(mz, omp_get_max_threads());
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static, 1)
+#endif
+    for(int slab = 0; slab < nslab; ++slab)
+    {
+        int z0 = static_cast<int>(static_cast<IndexType2>(slab) * mz / nslab);
+        int z1 = static_cast<int>(static_cast<IndexType2>(slab + 1) * mz / nslab);
+
+        std::vector<ValueType> ring(3 * s);
+        std::vector<ValueType> sum(s);
+        std::vector<ValueType> line(nx);
+        std::vector<const ValueType*> plane(nplane);
+
+        int tag[3] = {-1, -1, -1};
+
+        for(int zc = z0; zc < z1; ++zc)
+        {
+            int iz[3];
+            ValueType wz[3];
+
+            int cz = restriction_weights(zc, nz, mz, true, iz, wz);
+
+            // Fine residual planes
+            for(int c = 0; c < cz; ++c)
+            {
+                int q = iz[c];
+
+                if(tag[q % 3] == q)
+                {
+                    continue;
+                }
+
+                tag[q % 3] = q;
+
+                for(int dz = -rz; dz <= rz; ++dz)
+                {
+                    int zz = q + dz;
+
+                    plane[dz + rz] = (zz >= 0 && zz < nz) ? xv + zz * s : NULL;
+                }
+
+                ValueType* dst = &ring[(q % 3) * s];
+
+                for(int y = 0; y < ny; ++y)
+                {
+                    this->ApplyLine_(&plane[0], y, q, &line[0]);
+
+                    const ValueType* bq = b + q * s + static_cast<IndexType2>(y) * nx;
+
+                    for(int i = 0; i < nx; ++i)
+                    {
+                        dst[y * nx + i] = bq[i] - line[i];
+                    }
+                }
+            }
+
+            // Restriction in z
+            for(IndexType2 i = 0; i < s; ++i)
+            {
+                sum[i] = wz[0] * ring[(iz[0] % 3) * s + i];
+            }
+
+            for(int c = 1; c < cz; ++c)
+            {
+                const ValueType* src = &ring[(iz[c] % 3) * s];
+
+                for(IndexType2 i = 0; i < s; ++i)
+                {
+                    sum[i] += wz[c] * src[i];
+                }
+            }
+
+            // Restriction in y and x
+            for(int yc = 0; yc < my; ++yc)
+            {
+                int iy[3];
+                ValueType wy[3];
+
+                int cy = restriction_weights(yc, ny, my, true, iy, wy);
+
+                for(int i = 0; i < nx; ++i)
+                {
+                    line[i] = wy[0] * sum[iy[0] * nx + i];
+                }
+
+                for(int c = 1; c < cy; ++c)
+                {
+                    for(int i = 0; i < nx; ++i)
+                    {
+                        line[i] += wy[c] * sum[iy[c] * nx + i];
+                    }
+                }
+
+                ValueType* dst = rc + (static_cast<IndexType2>(zc) * my + yc) * mx;
+
+                for(int xc = 0; xc < mx; ++xc)
+                {
+                    int ix[3];
+                    ValueType wx[3];
+
+                    int cx = restriction_weights(xc, nx, mx, true, ix, wx);
+
+                    ValueType val = wx[0] * line[ix[0]];
+
+                    for(int c = 1; c < cx; ++c)
+                    {
+                        val += wx[c] * line[ix[c]];
+                    }
+
+                    dst[xc] = val;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostStencilGeneral<ValueType>::ProlongAdd(const BaseVector<ValueType>& cor,
+                                               BaseVector<ValueType>* x) const
+{
+    if((this->ndim_ == 0) || (this->GetM() == 0))
+    {
+        return true;
+    }
+
+    int nx, ny, nz;
+    int mx, my, mz;
+
+    this->GetDims_(nx, ny, nz);
+    this->GetCoarseDims_(mx, my, mz);
+
+    assert(cor.GetSize() == mx * my * mz);
+    assert(x->GetSize() == this->GetM());
+
+    const HostVector<ValueType>* cast_cor = dynamic_cast<const HostVector<ValueType>*>(&cor);
+    HostVector<ValueType>* cast_x         = dynamic_cast<HostVector<ValueType>*>(x);
+
+    assert(cast_cor != NULL);
+    assert(cast_x != NULL);
+
+    const ValueType* e = cast_cor->vec_;
+    ValueType* xv      = cast_x->vec_;
+
+    IndexType2 s  = static_cast<IndexType2>(nx) * ny;
+    IndexType2 sc = static_cast<IndexType2>(mx) * my;
+
+    _set_omp_backend_threads(this->local_backend_, this->GetM());
+
+    // The interpolation is applied dimension by dimension to the coarse planes and lines
+    // that contribute to a fine line, which is then added to x
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<ValueType> sum(sc);
+        std::vector<ValueType> line(mx);
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+        for(int z = 0; z < nz; ++z)
+        {
+            int iz[2]       = {0, 0};
+            ValueType wz[2] = {static_cast<ValueType>(0), static_cast<ValueType>(0)};
+
+            int cz = interpolation_weights(z, nz, mz, true, iz, wz);
+
+            // Interpolation in z
+            for(IndexType2 i = 0; i < sc; ++i)
+            {
+                sum[i] = wz[0] * e[iz[0] * sc + i];
+            }
+
+            if(cz > 1)
+            {
+                for(IndexType2 i = 0; i < sc; ++i)
+                {
+                    sum[i] += wz[1] * e[iz[1] * sc + i];
+                }
+            }
+
+            for(int y = 0; y < ny; ++y)
+            {
+                int iy[2]       = {0, 0};
+                ValueType wy[2] = {static_cast<ValueType>(0), static_cast<ValueType>(0)};
+
+                int cy = interpolation_weights(y, ny, my, true, iy, wy);
+
+                // Interpolation in y
+                for(int i = 0; i < mx; ++i)
+                {
+                    line[i] = wy[0] * sum[iy[0] * mx + i];
+                }
+
+                if(cy > 1)
+                {
+                    for(int i = 0; i < mx; ++i)
+                    {
+                        line[i] += wy[1] * sum[iy[1] * mx + i];
+                    }
+                }
+
+                // Interpolation in x and correction
+                ValueType* dst = xv + z * s + static_cast<IndexType2>(y) * nx;
+
+                for(int i = 0; i < nx; ++i)
+                {
+                    int ix[2]       = {0, 0};
+                    ValueType wx[2] = {static_cast<ValueType>(0), static_cast<ValueType>(0)};
+
+                    int cx = interpolation_weights(i, nx, mx, true, ix, wx);
+
+                    dst[i] += wx[0] * line[ix[0]];
+
+                    if(cx > 1)
+                    {
+                        dst[i] += wx[1] * line[ix[1]];
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+template class HostStencilGeneral<double>;
+template class HostStencilGeneral<float>;
+#ifdef SUPPORT_COMPLEX
+template class HostStencilGeneral<std::complex<double>>;
+template class HostStencilGeneral<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,121 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_HOST_STENCIL_GENERAL_HPP_
+#define ROCALUTION_HOST_STENCIL_GENERAL_HPP_
+
+#include "../base_vector.hpp"
+#include "../base_stencil.hpp"
+#include "../stencil_types.hpp"
+
+namespace rocalution {
+
+/// Structured grid stencil with arbitrary offsets and constant or variable (per grid
+/// point) coefficients on 1D, 2D and 3D grids. Points outside the grid are treated as
+/// homogeneous Dirichlet boundary.
+template <typename ValueType>
+class HostStencilGeneral : public HostStencil<ValueType>
+{
+    public:
+    HostStencilGeneral();
+    HostStencilGeneral(const Rocalution_Backend_Descriptor local_backend, unsigned int type);
+    virtual ~HostStencilGeneral();
+
+    virtual int GetNnz(void) const;
+    virtual void Info(void) const;
+    virtual unsigned int GetStencilId(void) const { return this->type_; }
+
+    virtual void SetGrid(int size);
+    virtual void SetGrid(int nx, int ny, int nz);
+
+    virtual bool SetStencil(int ndim, int npoint, const int* offset, const ValueType* coef);
+    virtual bool SetCoefficients(const ValueType* coef);
+
+    virtual void Apply(const BaseVector<ValueType>& in, BaseVector<ValueType>* out) const;
+    virtual void
+    ApplyAdd(const BaseVector<ValueType>& in, ValueType scalar, BaseVector<ValueType>* out) const;
+
+    virtual bool Smooth(const BaseVector<ValueType>& rhs,
+                        int nsweep,
+                        const ValueType* omega,
+                        BaseVector<ValueType>* x) const;
+
+    virtual bool Coarsen(bool galerkin, BaseStencil<ValueType>* coarse) const;
+    virtual bool ResidualRestrict(const BaseVector<ValueType>& rhs,
+                                  const BaseVector<ValueType>& x,
+                                  BaseVector<ValueType>* res) const;
+    virtual bool ProlongAdd(const BaseVector<ValueType>& cor, BaseVector<ValueType>* x) const;
+
+    private:
+    // Return the grid size, where the slowest dimension is always z (e.g. a 2D grid is
+    // treated as nx x 1 x ny grid)
+    void GetDims_(int& nx, int& ny, int& nz) const;
+
+    // out = add * out + scalar * this * in
+    void ApplyInternal_(const ValueType* in, ValueType scalar, bool add, ValueType* out) const;
+
+    // Compute line (y, z) of the stencil product, plane[dz + rz_] points to plane z + dz
+    // of the input (NULL if outside of the grid)
+    void ApplyLine_(const ValueType* const* plane, int y, int z, ValueType* line) const;
+
+    // Return the coarse grid size, in the same order as GetDims_()
+    void GetCoarseDims_(int& mx, int& my, int& mz) const;
+
+    // Accumulate row (x, y, z) of the Galerkin product R * this * P into acc, which holds
+    // the coarse offsets [-r[d], r[d]] in each dimension. If bounded is false, the row is
+    // computed on an unbounded grid with the constant coefficients.
+    void GalerkinRow_(int x, int y, int z, bool bounded, const int* r, ValueType* acc) const;
+
+    // Convert the internal offsets (dx, dy, dz) of n points into ndim offsets per point
+    void ExportOffsets_(int n, const int* offset, int* dst) const;
+
+    // Free variable coefficients
+    void ClearCoefficients_(void);
+
+    // Stencil id
+    unsigned int type_;
+
+    // Number of stencil points
+    int npoint_;
+    // Stencil offsets, stored as (dx, dy, dz) per point
+    int* offset_;
+    // Constant coefficients, one per stencil point
+    ValueType* coef_;
+    // Variable coefficients, npoint x m (NULL if constant)
+    ValueType* var_coef_;
+    // Inverse diagonal for variable coefficients (NULL if constant)
+    ValueType* inv_diag_;
+    // Index of the center point (-1 if not part of the stencil)
+    int center_;
+    // Maximum offset in y and z direction
+    int ry_;
+    int rz_;
+
+    friend class BaseVector<ValueType>;
+    friend class HostVector<ValueType>;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_HOST_STENCIL_GENERAL_HPP_
@@ -27,6 +27,7 @@
 #include "../../utils/log.hpp"
 #include "../../utils/allocate_free.hpp"
 #include "../../utils/math_functions.hpp"
+#include "../../utils/random.hpp"
 #include "version.hpp"
 
 #include <typeinfo>
@@ -34,6 +35,7 @@
 #include <math.h>
 #include <limits>
 #include <complex>
+#include <vector>
 #include <typeinfo>
 #include <typeindex>
 
@@ -129,7 +131,17 @@ void HostVector<ValueType>::Allocate(int n)
     {
         allocate_host(n, &this->vec_);
 
-        set_to_zero_host(n, this->vec_);
+        // Zero with the static schedule of the host kernels, such that each page is first
+        // touched (and placed) by the thread that works on it
+        _set_omp_backend_threads(this->local_backend_, n);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < n; ++i)
+        {
+            this->vec_[i] = static_cast<ValueType>(0);
+        }
 
         this->size_ = n;
     }
@@ -400,35 +412,81 @@ void HostVector<ValueType>::SetValues(ValueType val)
 }
 
 template <typename ValueType>
-void HostVector<ValueType>::SetRandomUniform(unsigned long long seed, ValueType a, ValueType b)
+void HostVector<ValueType>::SetRandomUniform(unsigned long long seed,
+                                             ValueType a,
+                                             ValueType b,
+                                             IndexType2 offset)
 {
     assert(a <= b);
+    assert(offset >= 0);
 
-    // Fill this with random data from interval [a,b]
-    srand(seed);
-    for(int i = 0; i < this->size_; ++i)
+    _set_omp_backend_threads(this->local_backend_, this->size_);
+
+    // Fill this with random data from interval [a,b]. Each pair of entries of the
+    // random stream is generated from its index only, thus the result is independent
+    // of the number of threads and of the offset of the first entry.
+    IndexType2 first = offset / 2;
+    IndexType2 last  = (offset + this->size_ + 1) / 2;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType2 p = first; p < last; ++p)
     {
-        this->vec_[i] =
-            a + static_cast<ValueType>(rand()) / static_cast<ValueType>(RAND_MAX) * (b - a);
+        double u[2];
+        random_uniform_pair(seed, static_cast<unsigned long long>(p), u[0], u[1]);
+
+        for(int k = 0; k < 2; ++k)
+        {
+            IndexType2 i = 2 * p + k - offset;
+
+            if(i >= 0 && i < this->size_)
+            {
+                this->vec_[i] = a + static_cast<ValueType>(u[k]) * (b - a);
+            }
+        }
     }
 }
 
 template <typename ValueType>
-void HostVector<ValueType>::SetRandomNormal(unsigned long long seed, ValueType mean, ValueType var)
+void HostVector<ValueType>::SetRandomNormal(unsigned long long seed,
+                                            ValueType mean,
+                                            ValueType var,
+                                            IndexType2 offset)
 {
-    // Fill this with random data from interval [a,b]
-    srand(seed);
-    for(int i = 0; i < this->size_; ++i)
+    assert(offset >= 0);
+
+    _set_omp_backend_threads(this->local_backend_, this->size_);
+
+    // Fill this with normally distributed random data. Box-Muller generates both
+    // entries of each pair of the random stream at once.
+    IndexType2 first = offset / 2;
+    IndexType2 last  = (offset + this->size_ + 1) / 2;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(IndexType2 p = first; p < last; ++p)
     {
-        // Box-Muller
-        ValueType u1 = static_cast<ValueType>(rand()) / RAND_MAX;
-        ValueType u2 = static_cast<ValueType>(rand()) / RAND_MAX;
+        double u1;
+        double u2;
+        random_uniform_pair(seed, static_cast<unsigned long long>(p), u1, u2);
 
-        this->vec_[i] =
-            sqrt(static_cast<ValueType>(-2) * log(u1)) * cos(static_cast<ValueType>(2 * M_PI) * u2);
+        // Box-Muller, u1 in (0,1]
+        double r   = sqrt(-2.0 * log(1.0 - u1));
+        double phi = 2.0 * M_PI * u2;
+        double z[2] = {r * cos(phi), r * sin(phi)};
 
-        // Shift
-        this->vec_[i] = mean + var * this->vec_[i];
+        for(int k = 0; k < 2; ++k)
+        {
+            IndexType2 i = 2 * p + k - offset;
+
+            if(i >= 0 && i < this->size_)
+            {
+                // Shift
+                this->vec_[i] = mean + var * static_cast<ValueType>(z[k]);
+            }
+        }
     }
 }
 
@@ -1549,6 +1607,218 @@ void HostVector<int>::Power(double power)
     }
 }
 
+template <typename ValueType>
+bool HostVector<ValueType>::BlockDot(int k,
+                                     const BaseVector<ValueType>& x,
+                                     int kx,
+                                     ValueType* result) const
+{
+    const HostVector<ValueType>* cast_x = dynamic_cast<const HostVector<ValueType>*>(&x);
+
+    assert(cast_x != NULL);
+    assert(k > 0);
+    assert(kx > 0);
+    assert(result != NULL);
+    assert(this->size_ % k == 0);
+
+    int nrow   = this->size_ / k;
+    int nblock = k * kx;
+
+    assert(cast_x->size_ == static_cast<IndexType2>(nrow) * kx);
+
+    set_to_zero_host(nblock, result);
+
+    _set_omp_backend_threads(this->local_backend_, nrow);
+
+    // Each thread accumulates its rows into a private k x kx block
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<ValueType> sum(nblock, static_cast<ValueType>(0));
+
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            const ValueType* row   = this->vec_ + static_cast<IndexType2>(i) * k;
+            const ValueType* row_x = cast_x->vec_ + static_cast<IndexType2>(i) * kx;
+
+            for(int c = 0; c < kx; ++c)
+            {
+                for(int r = 0; r < k; ++r)
+                {
+                    sum[r + c * k] += rocalution_conj(row[r]) * row_x[c];
+                }
+            }
+        }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        for(int j = 0; j < nblock; ++j)
+        {
+            result[j] += sum[j];
+        }
+    }
+
+    return true;
+}
+
+template <>
+bool HostVector<int>::BlockDot(int k, const BaseVector<int>& x, int kx, int* result) const
+{
+    LOG_INFO("What is bool HostVector<int>::BlockDot()?");
+    FATAL_ERROR(__FILE__, __LINE__);
+}
+
+template <typename ValueType>
+bool HostVector<ValueType>::BlockUpdate(
+    int k, ValueType beta, const BaseVector<ValueType>& x, int kx, const ValueType* coef)
+{
+    const HostVector<ValueType>* cast_x = dynamic_cast<const HostVector<ValueType>*>(&x);
+
+    assert(cast_x != NULL);
+    assert(cast_x != this);
+    assert(k > 0);
+    assert(kx > 0);
+    assert(coef != NULL);
+    assert(this->size_ % k == 0);
+
+    int nrow = this->size_ / k;
+
+    assert(cast_x->size_ == static_cast<IndexType2>(nrow) * kx);
+
+    _set_omp_backend_threads(this->local_backend_, nrow);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        ValueType* row         = this->vec_ + static_cast<IndexType2>(i) * k;
+        const ValueType* row_x = cast_x->vec_ + static_cast<IndexType2>(i) * kx;
+
+        for(int c = 0; c < k; ++c)
+        {
+            ValueType sum = static_cast<ValueType>(0);
+
+            for(int r = 0; r < kx; ++r)
+            {
+                sum += row_x[r] * coef[r + c * kx];
+            }
+
+            // beta == 0 does not read this, which might be uninitialized
+            row[c] = (beta == static_cast<ValueType>(0)) ? sum : beta * row[c] + sum;
+        }
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostVector<ValueType>::BlockNorm(int k, ValueType* norms) const
+{
+    assert(k > 0);
+    assert(norms != NULL);
+    assert(this->size_ % k == 0);
+
+    int nrow = this->size_ / k;
+
+    set_to_zero_host(k, norms);
+
+    _set_omp_backend_threads(this->local_backend_, nrow);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<ValueType> sum(k, static_cast<ValueType>(0));
+
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for(int i = 0; i < nrow; ++i)
+        {
+            const ValueType* row = this->vec_ + static_cast<IndexType2>(i) * k;
+
+            for(int c = 0; c < k; ++c)
+            {
+                sum[c] += rocalution_conj(row[c]) * row[c];
+            }
+        }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        for(int c = 0; c < k; ++c)
+        {
+            norms[c] += sum[c];
+        }
+    }
+
+    for(int c = 0; c < k; ++c)
+    {
+        norms[c] = sqrt(norms[c]);
+    }
+
+    return true;
+}
+
+template <>
+bool HostVector<int>::BlockNorm(int k, int* norms) const
+{
+    LOG_INFO("What is bool HostVector<int>::BlockNorm()?");
+    FATAL_ERROR(__FILE__, __LINE__);
+}
+
+template <typename ValueType>
+bool HostVector<ValueType>::ExtractColumn(int k, int j, BaseVector<ValueType>* vec) const
+{
+    HostVector<ValueType>* cast_vec = dynamic_cast<HostVector<ValueType>*>(vec);
+
+    assert(cast_vec != NULL);
+    assert(k > 0);
+    assert(j >= 0 && j < k);
+    assert(this->size_ == static_cast<IndexType2>(cast_vec->size_) * k);
+
+    _set_omp_backend_threads(this->local_backend_, cast_vec->size_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < cast_vec->size_; ++i)
+    {
+        cast_vec->vec_[i] = this->vec_[static_cast<IndexType2>(i) * k + j];
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+bool HostVector<ValueType>::InsertColumn(int k, int j, const BaseVector<ValueType>& vec)
+{
+    const HostVector<ValueType>* cast_vec = dynamic_cast<const HostVector<ValueType>*>(&vec);
+
+    assert(cast_vec != NULL);
+    assert(k > 0);
+    assert(j >= 0 && j < k);
+    assert(this->size_ == static_cast<IndexType2>(cast_vec->size_) * k);
+
+    _set_omp_backend_threads(this->local_backend_, cast_vec->size_);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < cast_vec->size_; ++i)
+    {
+        this->vec_[static_cast<IndexType2>(i) * k + j] = cast_vec->vec_[i];
+    }
+
+    return true;
+}
+
 template class HostVector<double>;
 template class HostVector<float>;
 #ifdef SUPPORT_COMPLEX
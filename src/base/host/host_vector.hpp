@@ -27,6 +27,7 @@
 #include "../base_vector.hpp"
 #include "../base_matrix.hpp"
 #include "../base_stencil.hpp"
+#include "../../utils/types.hpp"
 
 #include <complex>
 
@@ -53,8 +54,11 @@ class HostVector : public BaseVector<ValueType>
     virtual void Zeros(void);
     virtual void Ones(void);
     virtual void SetValues(ValueType val);
-    virtual void SetRandomUniform(unsigned long long seed, ValueType a, ValueType b);
-    virtual void SetRandomNormal(unsigned long long seed, ValueType mean, ValueType var);
+    // offset is the index of the first entry within the random stream
+    virtual void
+    SetRandomUniform(unsigned long long seed, ValueType a, ValueType b, IndexType2 offset = 0);
+    virtual void
+    SetRandomNormal(unsigned long long seed, ValueType mean, ValueType var, IndexType2 offset = 0);
 
     virtual void CopyFrom(const BaseVector<ValueType>& vec);
     virtual void CopyFromFloat(const BaseVector<float>& vec);
@@ -123,6 +127,14 @@ class HostVector : public BaseVector<ValueType>
     virtual void PointWiseMult(const BaseVector<ValueType>& x, const BaseVector<ValueType>& y);
     virtual void Power(double power);
 
+    virtual bool
+    BlockDot(int k, const BaseVector<ValueType>& x, int kx, ValueType* result) const;
+    virtual bool BlockUpdate(
+        int k, ValueType beta, const BaseVector<ValueType>& x, int kx, const ValueType* coef);
+    virtual bool BlockNorm(int k, ValueType* norms) const;
+    virtual bool ExtractColumn(int k, int j, BaseVector<ValueType>* vec) const;
+    virtual bool InsertColumn(int k, int j, const BaseVector<ValueType>& vec);
+
     // set index array
     virtual void SetIndexArray(int size, const int* index);
     // get index values
@@ -163,6 +175,8 @@ class HostVector : public BaseVector<ValueType>
     friend class HostMatrixDENSE<ValueType>;
     friend class HostMatrixMCSR<ValueType>;
     friend class HostMatrixBCSR<ValueType>;
+    friend class HostMatrixSELL<ValueType>;
+    friend class HostMatrixCCSR<ValueType>;
 
     friend class HostMatrixCOO<float>;
     friend class HostMatrixCOO<double>;
@@ -180,7 +194,7 @@ class HostVector : public BaseVector<ValueType>
     friend class HIPAcceleratorVector<ValueType>;
 
     friend class HostStencil<ValueType>;
-    friend class HostStencilLaplace2D<ValueType>;
+    friend class HostStencilGeneral<ValueType>;
 };
 
 } // namespace rocalution
@@ -0,0 +1,285 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../utils/def.hpp"
+#include "local_callback_operator.hpp"
+#include "local_vector.hpp"
+#include "backend_manager.hpp"
+
+#include "../utils/log.hpp"
+#include "../utils/trace.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <string>
+
+namespace rocalution {
+
+template <typename ValueType>
+LocalCallbackOperator<ValueType>::LocalCallbackOperator()
+{
+    log_debug(this, "LocalCallbackOperator::LocalCallbackOperator()");
+
+    this->object_name_ = "";
+
+    this->m_ = 0;
+    this->n_ = 0;
+
+    this->apply_ = NULL;
+    this->diag_  = NULL;
+    this->data_  = NULL;
+
+    this->accel_ = false;
+}
+
+template <typename ValueType>
+LocalCallbackOperator<ValueType>::~LocalCallbackOperator()
+{
+    log_debug(this, "LocalCallbackOperator::~LocalCallbackOperator()");
+
+    this->Clear();
+}
+
+template <typename ValueType>
+IndexType2 LocalCallbackOperator<ValueType>::GetM(void) const
+{
+    return this->m_;
+}
+
+template <typename ValueType>
+IndexType2 LocalCallbackOperator<ValueType>::GetN(void) const
+{
+    return this->n_;
+}
+
+template <typename ValueType>
+IndexType2 LocalCallbackOperator<ValueType>::GetNnz(void) const
+{
+    // The operator is not stored
+    return 0;
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::Info(void) const
+{
+    std::string current_backend_name;
+
+    if(this->is_host_() == true)
+    {
+        current_backend_name = _rocalution_host_name[0];
+    }
+    else
+    {
+        assert(this->is_accel_() == true);
+        current_backend_name = _rocalution_backend_name[this->local_backend_.backend];
+    }
+
+    LOG_INFO("LocalCallbackOperator"
+             << " name="
+             << this->object_name_
+             << ";"
+             << " rows="
+             << this->m_
+             << ";"
+             << " cols="
+             << this->n_
+             << ";"
+             << " diagonal="
+             << ((this->diag_ != NULL) ? "yes" : "no")
+             << ";"
+             << " prec="
+             << 8 * sizeof(ValueType)
+             << "bit;"
+             << " host backend={"
+             << _rocalution_host_name[0]
+             << "};"
+             << " accelerator backend={"
+             << _rocalution_backend_name[this->local_backend_.backend]
+             << "};"
+             << " current="
+             << current_backend_name);
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::SetApply(int m, int n, ApplyFunc apply, void* data)
+{
+    log_debug(this, "LocalCallbackOperator::SetApply()", m, n, apply, data);
+
+    assert(m >= 0);
+    assert(n >= 0);
+    assert(apply != NULL);
+
+    this->m_     = m;
+    this->n_     = n;
+    this->apply_ = apply;
+    this->data_  = data;
+
+    this->buffer_.Clear();
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::SetDiagonal(DiagonalFunc diag)
+{
+    log_debug(this, "LocalCallbackOperator::SetDiagonal()", diag);
+
+    assert(diag != NULL);
+
+    this->diag_ = diag;
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::Clear(void)
+{
+    log_debug(this, "LocalCallbackOperator::Clear()");
+
+    this->m_ = 0;
+    this->n_ = 0;
+
+    this->apply_ = NULL;
+    this->diag_  = NULL;
+    this->data_  = NULL;
+
+    this->buffer_.Clear();
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::Apply(const LocalVector<ValueType>& in,
+                                             LocalVector<ValueType>* out) const
+{
+    log_debug(this, "LocalCallbackOperator::Apply()", (const void*&)in, out);
+
+    ROCALUTION_TRACE_SCOPE("LocalCallbackOperator::Apply", "operator");
+
+    assert(out != NULL);
+    assert(&in != out);
+    assert(this->apply_ != NULL);
+
+    assert(in.GetSize() == this->n_);
+    assert(out->GetSize() == this->m_);
+    assert(this->is_host_() == in.is_host_());
+    assert(this->is_host_() == out->is_host_());
+
+    this->apply_(in, out, this->data_);
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
+                                                ValueType scalar,
+                                                LocalVector<ValueType>* out) const
+{
+    log_debug(this, "LocalCallbackOperator::ApplyAdd()", (const void*&)in, scalar, out);
+
+    ROCALUTION_TRACE_SCOPE("LocalCallbackOperator::ApplyAdd", "operator");
+
+    assert(out != NULL);
+    assert(&in != out);
+
+    if(this->buffer_.GetSize() != this->m_)
+    {
+        this->buffer_.Clear();
+        this->buffer_.CloneBackend(*this);
+        this->buffer_.Allocate("callback operator buffer", this->m_);
+    }
+
+    this->Apply(in, &this->buffer_);
+
+    out->AddScale(this->buffer_, scalar);
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::ExtractDiagonal(LocalVector<ValueType>* vec_diag) const
+{
+    log_debug(this, "LocalCallbackOperator::ExtractDiagonal()", vec_diag);
+
+    assert(vec_diag != NULL);
+    assert(this->is_host_() == vec_diag->is_host_());
+
+    if(this->diag_ == NULL)
+    {
+        LOG_INFO("LocalCallbackOperator::ExtractDiagonal() no diagonal function set");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    std::string vec_diag_name = "Diagonal elements of " + this->object_name_;
+    vec_diag->Allocate(vec_diag_name, std::min(this->m_, this->n_));
+
+    this->diag_(vec_diag, this->data_);
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::ExtractInverseDiagonal(
+    LocalVector<ValueType>* vec_inv_diag) const
+{
+    log_debug(this, "LocalCallbackOperator::ExtractInverseDiagonal()", vec_inv_diag);
+
+    this->ExtractDiagonal(vec_inv_diag);
+
+    vec_inv_diag->Power(-1.0);
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::MoveToAccelerator(void)
+{
+    log_debug(this, "LocalCallbackOperator::MoveToAccelerator()");
+
+    // Nothing to transfer, only the backend of the vectors passed to the user functions
+    // changes
+    if(_rocalution_available_accelerator() == true)
+    {
+        this->accel_ = true;
+    }
+
+    this->buffer_.MoveToAccelerator();
+}
+
+template <typename ValueType>
+void LocalCallbackOperator<ValueType>::MoveToHost(void)
+{
+    log_debug(this, "LocalCallbackOperator::MoveToHost()");
+
+    this->accel_ = false;
+
+    this->buffer_.MoveToHost();
+}
+
+template <typename ValueType>
+bool LocalCallbackOperator<ValueType>::is_host_(void) const
+{
+    return !this->accel_;
+}
+
+template <typename ValueType>
+bool LocalCallbackOperator<ValueType>::is_accel_(void) const
+{
+    return this->accel_;
+}
+
+template class LocalCallbackOperator<double>;
+template class LocalCallbackOperator<float>;
+#ifdef SUPPORT_COMPLEX
+template class LocalCallbackOperator<std::complex<double>>;
+template class LocalCallbackOperator<std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,159 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_LOCAL_CALLBACK_OPERATOR_HPP_
+#define ROCALUTION_LOCAL_CALLBACK_OPERATOR_HPP_
+
+#include "../utils/types.hpp"
+#include "operator.hpp"
+#include "local_vector.hpp"
+
+namespace rocalution {
+
+template <typename ValueType>
+class LocalVector;
+template <typename ValueType>
+class GlobalVector;
+
+/** \ingroup op_vec_module
+  * \class LocalCallbackOperator
+  * \brief LocalCallbackOperator class
+  * \details
+  * A LocalCallbackOperator is a matrix-free operator, whose product with a vector is
+  * computed by a user provided function. It can be passed to all iterative solvers
+  * that only require operator applications, such as the Krylov subspace solvers, the
+  * Chebyshev iteration and the Jacobi preconditioner. No matrix has to be assembled,
+  * e.g. the Jacobian within a Jacobian-free Newton-Krylov method can be applied by a
+  * finite difference of the residual function.
+  *
+  * \tparam ValueType - can be int, float, double, std::complex<float> and
+  *                     std::complex<double>
+  */
+template <typename ValueType>
+class LocalCallbackOperator : public Operator<ValueType>
+{
+    public:
+    /** \brief Function that computes \p out = A * \p in, \p data is the user context */
+    typedef void (*ApplyFunc)(const LocalVector<ValueType>& in,
+                              LocalVector<ValueType>* out,
+                              void* data);
+    /** \brief Function that fills the allocated vector \p diag with the diagonal of A */
+    typedef void (*DiagonalFunc)(LocalVector<ValueType>* diag, void* data);
+
+    LocalCallbackOperator();
+    virtual ~LocalCallbackOperator();
+
+    virtual void Info() const;
+
+    virtual IndexType2 GetM(void) const;
+    virtual IndexType2 GetN(void) const;
+    virtual IndexType2 GetNnz(void) const;
+
+    /** \brief Set the operator function
+      * \details
+      * \p SetApply defines the operator by its size and the function that computes its
+      * product with a vector. The input and output vectors that are passed to \p apply
+      * reside on the same backend as the operator, and the output vector is already
+      * allocated. \p data is passed unchanged to \p apply and can be used to access the
+      * user context.
+      *
+      * @param[in]
+      * m       number of rows of the operator
+      * @param[in]
+      * n       number of columns of the operator
+      * @param[in]
+      * apply   function computing \p out = A * \p in
+      * @param[in]
+      * data    user context that is passed to \p apply
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // 1D Laplacian
+      *   void laplace(const LocalVector<double>& in, LocalVector<double>* out, void* data)
+      *   {
+      *     int n = in.GetSize();
+      *
+      *     for(int i = 0; i < n; ++i)
+      *     {
+      *       (*out)[i] = 2.0 * in[i] - ((i > 0) ? in[i - 1] : 0.0)
+      *                   - ((i < n - 1) ? in[i + 1] : 0.0);
+      *     }
+      *   }
+      *
+      *   LocalCallbackOperator<double> op;
+      *   op.SetApply(100, 100, laplace, NULL);
+      *
+      *   CG<LocalCallbackOperator<double>, LocalVector<double>, double> ls;
+      *   ls.SetOperator(op);
+      *   ls.Build();
+      *   ls.Solve(rhs, &x);
+      * \endcode
+      */
+    void SetApply(int m, int n, ApplyFunc apply, void* data);
+
+    /** \brief Set the function that extracts the diagonal of the operator
+      * \details
+      * The diagonal function is optional, it is only required for ExtractDiagonal() and
+      * ExtractInverseDiagonal(), e.g. when the operator is preconditioned by Jacobi. It
+      * receives the same user context as the operator function.
+      */
+    void SetDiagonal(DiagonalFunc diag);
+
+    virtual void Clear();
+
+    virtual void Apply(const LocalVector<ValueType>& in, LocalVector<ValueType>* out) const;
+    virtual void
+    ApplyAdd(const LocalVector<ValueType>& in, ValueType scalar, LocalVector<ValueType>* out) const;
+
+    /** \brief Extract the diagonal values of the operator into a LocalVector */
+    void ExtractDiagonal(LocalVector<ValueType>* vec_diag) const;
+    /** \brief Extract the inverse (reciprocal) diagonal values of the operator into a
+      * LocalVector
+      */
+    void ExtractInverseDiagonal(LocalVector<ValueType>* vec_inv_diag) const;
+
+    virtual void MoveToAccelerator(void);
+    virtual void MoveToHost(void);
+
+    protected:
+    virtual bool is_host_(void) const;
+    virtual bool is_accel_(void) const;
+
+    private:
+    int m_;
+    int n_;
+
+    ApplyFunc apply_;
+    DiagonalFunc diag_;
+    void* data_;
+
+    // Backend the vectors that are passed to the user functions are located on
+    bool accel_;
+
+    // Buffer for ApplyAdd()
+    mutable LocalVector<ValueType> buffer_;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_LOCAL_CALLBACK_OPERATOR_HPP_
@@ -24,6 +24,7 @@
 #include "../utils/def.hpp"
 #include "local_matrix.hpp"
 #include "local_vector.hpp"
+#include "local_multi_vector.hpp"
 #include "base_vector.hpp"
 #include "base_matrix.hpp"
 #include "host/host_matrix_csr.hpp"
@@ -31,13 +32,20 @@
 #include "host/host_vector.hpp"
 #include "backend_manager.hpp"
 #include "../utils/log.hpp"
+#include "../utils/trace.hpp"
 #include "../utils/math_functions.hpp"
 #include "../utils/allocate_free.hpp"
+#include "../utils/time_functions.hpp"
 
 #include <algorithm>
+#include <list>
+#include <map>
+#include <math.h>
+#include <mutex>
 #include <sstream>
 #include <string.h>
 #include <complex>
+#include <vector>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -45,6 +53,74 @@
 
 namespace rocalution {
 
+// Maximum number of formats kept by the LocalMatrix::AutoTuneFormat() cache
+#define FORMAT_CACHE_SIZE 64
+
+struct FormatCacheEntry
+{
+    unsigned int format;
+
+    // Position in the recently used list
+    std::list<std::vector<long int>>::iterator lru;
+};
+
+// Formats selected by LocalMatrix::AutoTuneFormat(), keyed by sparsity pattern, size and
+// backend of the matrix. The cache is shared by all threads and evicts the least
+// recently used format, once it is full.
+static std::mutex _format_cache_mutex;
+static std::list<std::vector<long int>> _format_cache_lru;
+static std::map<std::vector<long int>, FormatCacheEntry> _format_cache;
+
+static bool format_cache_lookup(const std::vector<long int>& key, unsigned int* format)
+{
+    std::lock_guard<std::mutex> lock(_format_cache_mutex);
+
+    std::map<std::vector<long int>, FormatCacheEntry>::iterator it = _format_cache.find(key);
+
+    if(it == _format_cache.end())
+    {
+        return false;
+    }
+
+    // Mark as most recently used
+    _format_cache_lru.splice(_format_cache_lru.begin(), _format_cache_lru, it->second.lru);
+
+    *format = it->second.format;
+
+    return true;
+}
+
+static void format_cache_insert(const std::vector<long int>& key, unsigned int format)
+{
+    std::lock_guard<std::mutex> lock(_format_cache_mutex);
+
+    std::map<std::vector<long int>, FormatCacheEntry>::iterator it = _format_cache.find(key);
+
+    // Another thread might have tuned the same pattern in the meantime
+    if(it != _format_cache.end())
+    {
+        _format_cache_lru.splice(_format_cache_lru.begin(), _format_cache_lru, it->second.lru);
+        it->second.format = format;
+
+        return;
+    }
+
+    if(_format_cache.size() >= FORMAT_CACHE_SIZE)
+    {
+        _format_cache.erase(_format_cache_lru.back());
+        _format_cache_lru.pop_back();
+    }
+
+    _format_cache_lru.push_front(key);
+
+    FormatCacheEntry entry;
+
+    entry.format = format;
+    entry.lru    = _format_cache_lru.begin();
+
+    _format_cache[key] = entry;
+}
+
 template <typename ValueType>
 LocalMatrix<ValueType>::LocalMatrix()
 {
@@ -1360,6 +1436,8 @@ void LocalMatrix<ValueType>::MoveToAccelerator(void)
 {
     log_debug(this, "LocalMatrix::MoveToAccelerator()");
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::MoveToAccelerator", "transfer");
+
 #ifdef DEBUG_MODE
     this->Check();
 #endif
@@ -1373,6 +1451,26 @@ void LocalMatrix<ValueType>::MoveToAccelerator(void)
 
     if((_rocalution_available_accelerator()) && (this->matrix_ == this->matrix_host_))
     {
+        // SELL is a host format, ELL is used on the accelerator instead
+        if(this->GetFormat() == SELL)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: SELL format is not available on the accelerator, "
+                             "converting to ELL format");
+
+            this->ConvertToELL();
+        }
+
+        // CCSR formats are host formats, CSR is used on the accelerator instead
+        if((this->GetFormat() == CCSR) || (this->GetFormat() == CCSRBF16))
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: CCSR format is not available on the accelerator, "
+                             "converting to CSR format");
+
+            this->ConvertToCSR();
+        }
+
         this->matrix_accel_ = _rocalution_init_base_backend_matrix<ValueType>(this->local_backend_,
                                                                               this->GetFormat());
         this->matrix_accel_->CopyFrom(*this->matrix_host_);
@@ -1393,6 +1491,8 @@ void LocalMatrix<ValueType>::MoveToHost(void)
 {
     log_debug(this, "LocalMatrix::MoveToHost()");
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::MoveToHost", "transfer");
+
     if((_rocalution_available_accelerator()) && (this->matrix_ == this->matrix_accel_))
     {
         this->matrix_host_ =
@@ -1566,14 +1666,49 @@ void LocalMatrix<ValueType>::ConvertToDENSE(void)
     this->ConvertTo(DENSE);
 }
 
+template <typename ValueType>
+void LocalMatrix<ValueType>::ConvertToSELL(void)
+{
+    this->ConvertTo(SELL);
+}
+
+template <typename ValueType>
+void LocalMatrix<ValueType>::ConvertToCCSR(bool bfloat16)
+{
+    this->ConvertTo(bfloat16 ? CCSRBF16 : CCSR);
+}
+
 template <typename ValueType>
 void LocalMatrix<ValueType>::ConvertTo(unsigned int matrix_format)
 {
     log_debug(this, "LocalMatrix::ConvertTo()", matrix_format);
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::ConvertTo", "matrix");
+
     assert((matrix_format == DENSE) || (matrix_format == CSR) || (matrix_format == MCSR) ||
            (matrix_format == BCSR) || (matrix_format == COO) || (matrix_format == DIA) ||
-           (matrix_format == ELL) || (matrix_format == HYB));
+           (matrix_format == ELL) || (matrix_format == HYB) || (matrix_format == SELL) ||
+           (matrix_format == CCSR) || (matrix_format == CCSRBF16));
+
+    // SELL is a host format, ELL is used on the accelerator instead
+    if((matrix_format == SELL) && (this->is_accel_() == true))
+    {
+        LOG_VERBOSE_INFO(2,
+                         "*** warning: SELL format is not available on the accelerator, "
+                         "converting to ELL format");
+
+        matrix_format = ELL;
+    }
+
+    // CCSR formats are host formats, CSR is used on the accelerator instead
+    if(((matrix_format == CCSR) || (matrix_format == CCSRBF16)) && (this->is_accel_() == true))
+    {
+        LOG_VERBOSE_INFO(2,
+                         "*** warning: CCSR format is not available on the accelerator, "
+                         "converting to CSR format");
+
+        matrix_format = CSR;
+    }
 
     LOG_VERBOSE_INFO(5,
                      "Converting " << _matrix_format_names[matrix_format] << " <- "
@@ -1655,12 +1790,207 @@ void LocalMatrix<ValueType>::ConvertTo(unsigned int matrix_format)
     }
 }
 
+template <typename ValueType>
+unsigned int LocalMatrix<ValueType>::AutoTuneFormat(bool benchmark)
+{
+    log_debug(this, "LocalMatrix::AutoTuneFormat()", benchmark);
+
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::AutoTuneFormat", "matrix");
+
+#ifdef DEBUG_MODE
+    this->Check();
+#endif
+
+    if(this->GetNnz() == 0)
+    {
+        return this->GetFormat();
+    }
+
+    // Look up a previous decision for this sparsity pattern
+    long int row_key;
+    long int col_key;
+    long int val_key;
+
+    this->Key(row_key, col_key, val_key);
+
+    // The number of non-zeros is covered by the row key and would differ for padded
+    // formats, e.g. ELL
+    std::vector<long int> key(7);
+
+    key[0] = row_key;
+    key[1] = col_key;
+    key[2] = this->GetM();
+    key[3] = this->GetN();
+    key[4] = sizeof(ValueType);
+    key[5] = this->is_accel_();
+    key[6] = benchmark;
+
+    unsigned int cached_format;
+
+    if(format_cache_lookup(key, &cached_format) == true)
+    {
+        this->ConvertTo(cached_format);
+
+        return this->GetFormat();
+    }
+
+    int    max_row_nnz;
+    double row_nnz_var;
+    int    num_diag;
+    int    block_dim;
+
+    bool err = this->matrix_->AnalyseStructure(&max_row_nnz, &row_nnz_var, &num_diag, &block_dim);
+
+    if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+    {
+        LOG_INFO("Computation of LocalMatrix::AutoTuneFormat() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    if(err == false)
+    {
+        // Move to host
+        LocalMatrix<ValueType> mat_host;
+        mat_host.ConvertTo(this->GetFormat());
+        mat_host.CopyFrom(*this);
+
+        // Convert to CSR
+        mat_host.ConvertToCSR();
+
+        if(mat_host.matrix_->AnalyseStructure(&max_row_nnz, &row_nnz_var, &num_diag, &block_dim)
+           == false)
+        {
+            LOG_INFO("Computation of LocalMatrix::AutoTuneFormat() failed");
+            mat_host.Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(this->GetFormat() != CSR)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: LocalMatrix::AutoTuneFormat() is performed in CSR "
+                             "format");
+        }
+
+        if(this->is_accel_() == true)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: LocalMatrix::AutoTuneFormat() is performed on the "
+                             "host");
+        }
+    }
+
+    double nnz  = static_cast<double>(this->GetNnz());
+    double mean = nnz / this->GetM();
+    double cv   = sqrt(row_nnz_var) / mean;
+    double size = static_cast<double>(std::max(this->GetM(), this->GetN()));
+
+    LOG_VERBOSE_INFO(4,
+                     "*** info: LocalMatrix::AutoTuneFormat() row length mean="
+                         << mean << " max=" << max_row_nnz << " cv=" << cv
+                         << " diagonals=" << num_diag << " block dim=" << block_dim);
+
+    // Structural heuristic, DIA and ELL are used if at most a third of the stored
+    // entries are padding. HYB stores its ELL part with the mean row length, that
+    // fits well as long as the row lengths vary moderately.
+    unsigned int format = CSR;
+
+    if(num_diag * size <= 1.5 * nnz)
+    {
+        format = DIA;
+    }
+    else if(max_row_nnz * static_cast<double>(this->GetM()) <= 1.5 * nnz)
+    {
+        format = ELL;
+    }
+    else if((this->is_accel_() == true) && (cv <= 1.0))
+    {
+        format = HYB;
+    }
+
+    if(benchmark == true)
+    {
+        LocalVector<ValueType> in;
+        LocalVector<ValueType> out;
+
+        in.CloneBackend(*this);
+        out.CloneBackend(*this);
+
+        in.Allocate("in", this->GetN());
+        out.Allocate("out", this->GetM());
+
+        in.Ones();
+
+        const unsigned int candidates[7] = {CSR, MCSR, COO, DIA, ELL, HYB, SELL};
+        const int          nspmv         = 10;
+
+        double best_time = -1.0;
+
+        for(int i = 0; i < 7; ++i)
+        {
+            if((candidates[i] == MCSR) && (this->GetM() != this->GetN()))
+            {
+                continue;
+            }
+
+            LocalMatrix<ValueType> mat;
+            mat.CloneFrom(*this);
+            mat.ConvertTo(candidates[i]);
+
+            // Conversion is not feasible (e.g. too many diagonals)
+            if(mat.GetFormat() != candidates[i])
+            {
+                continue;
+            }
+
+            // Warm up
+            mat.Apply(in, &out);
+
+            double time = rocalution_time();
+
+            for(int k = 0; k < nspmv; ++k)
+            {
+                mat.Apply(in, &out);
+            }
+
+            time = rocalution_time() - time;
+
+            LOG_VERBOSE_INFO(4,
+                             "*** info: LocalMatrix::AutoTuneFormat() "
+                                 << _matrix_format_names[candidates[i]]
+                                 << " SpMV time=" << time / nspmv << " usec");
+
+            if((best_time < 0.0) || (time < best_time))
+            {
+                best_time = time;
+                format    = candidates[i];
+            }
+        }
+    }
+
+    format_cache_insert(key, format);
+
+    LOG_VERBOSE_INFO(4,
+                     "*** info: LocalMatrix::AutoTuneFormat() selected "
+                         << _matrix_format_names[format]);
+
+    this->ConvertTo(format);
+
+    return this->GetFormat();
+}
+
 template <typename ValueType>
 void LocalMatrix<ValueType>::Apply(const LocalVector<ValueType>& in,
                                    LocalVector<ValueType>* out) const
 {
     log_debug(this, "LocalMatrix::Apply()", (const void*&)in, out);
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::Apply", "matrix");
+    ROCALUTION_TRACE_COUNT(this->GetNnz() * (sizeof(ValueType) + sizeof(int))
+                               + (this->GetM() + this->GetN()) * sizeof(ValueType),
+                           2 * this->GetNnz());
+
     assert(out != NULL);
 
 #ifdef DEBUG_MODE
@@ -1681,6 +2011,202 @@ void LocalMatrix<ValueType>::Apply(const LocalVector<ValueType>& in,
     }
 }
 
+template <typename ValueType>
+void LocalMatrix<ValueType>::Apply(const LocalMultiVector<ValueType>& in,
+                                   LocalMultiVector<ValueType>* out) const
+{
+    log_debug(this, "LocalMatrix::Apply()", (const void*&)in, out);
+
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::ApplyMulti", "matrix");
+    ROCALUTION_TRACE_COUNT(this->GetNnz() * (sizeof(ValueType) + sizeof(int))
+                               + (this->GetM() + this->GetN()) * in.GetNumCols()
+                                     * sizeof(ValueType),
+                           2 * this->GetNnz() * in.GetNumCols());
+
+    assert(out != NULL);
+    assert(&in != out);
+
+#ifdef DEBUG_MODE
+    this->Check();
+#endif
+
+    assert(in.GetNumRows() == this->GetN());
+    assert(out->GetNumRows() == this->GetM());
+    assert(in.GetNumCols() == out->GetNumCols());
+
+    assert(((this->matrix_ == this->matrix_host_) && (in.is_host_() == true) &&
+            (out->is_host_() == true)) ||
+           ((this->matrix_ == this->matrix_accel_) && (in.is_accel_() == true) &&
+            (out->is_accel_() == true)));
+
+    if(this->GetNnz() > 0 && in.GetNumCols() > 0)
+    {
+        int k = in.GetNumCols();
+
+        bool err = this->matrix_->ApplyMulti(k, *in.vector_.vector_, out->vector_.vector_);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::Apply() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat());
+            mat_host.CopyFrom(*this);
+
+            LocalVector<ValueType> in_host;
+            in_host.Allocate("in", in.vector_.GetSize());
+            in_host.CopyFrom(in.vector_);
+
+            out->MoveToHost();
+
+            mat_host.ConvertToCSR();
+
+            if(mat_host.matrix_->ApplyMulti(k, *in_host.vector_, out->vector_.vector_) == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::Apply() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(this->GetFormat() != CSR)
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: LocalMatrix::Apply() for multi-vectors is "
+                                 "performed in CSR format");
+            }
+
+            if(this->is_accel_() == true)
+            {
+                LOG_VERBOSE_INFO(2,
+                                 "*** warning: LocalMatrix::Apply() for multi-vectors is "
+                                 "performed on the host");
+
+                out->MoveToAccelerator();
+            }
+        }
+    }
+    else
+    {
+        out->Zeros();
+    }
+}
+
+template <typename ValueType>
+void LocalMatrix<ValueType>::RestrictResidual(const LocalMatrix<ValueType>& A,
+                                              const LocalVector<ValueType>& b,
+                                              const LocalVector<ValueType>& x,
+                                              bool residual,
+                                              LocalVector<ValueType>* s,
+                                              LocalVector<ValueType>* out) const
+{
+    log_debug(this,
+              "LocalMatrix::RestrictResidual()",
+              (const void*&)A,
+              (const void*&)b,
+              (const void*&)x,
+              residual,
+              s,
+              out);
+
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::RestrictResidual", "matrix");
+
+    assert(s != NULL);
+    assert(out != NULL);
+    assert(A.GetN() == x.GetSize());
+    assert(A.GetM() == b.GetSize());
+    assert(A.GetM() == s->GetSize());
+    assert(A.GetM() == this->GetN());
+    assert(out->GetSize() == this->GetM());
+
+    assert(((this->matrix_ == this->matrix_host_) && (A.matrix_ == A.matrix_host_) &&
+            (b.vector_ == b.vector_host_) && (x.vector_ == x.vector_host_) &&
+            (s->vector_ == s->vector_host_) && (out->vector_ == out->vector_host_)) ||
+           ((this->matrix_ == this->matrix_accel_) && (A.matrix_ == A.matrix_accel_) &&
+            (b.vector_ == b.vector_accel_) && (x.vector_ == x.vector_accel_) &&
+            (s->vector_ == s->vector_accel_) && (out->vector_ == out->vector_accel_)));
+
+#ifdef DEBUG_MODE
+    this->Check();
+    A.Check();
+#endif
+
+    bool err = false;
+
+    if(this->GetNnz() > 0 && A.GetNnz() > 0)
+    {
+        err = this->matrix_->RestrictResidual(
+            *A.matrix_, *b.vector_, *x.vector_, residual, s->vector_, out->vector_);
+    }
+
+    // Residual and restriction by separate kernels
+    if(err == false)
+    {
+        A.Apply(x, s);
+        s->ScaleAdd(static_cast<ValueType>(-1), b);
+
+        this->Apply(*s, out);
+    }
+}
+
+template <typename ValueType>
+bool LocalMatrix<ValueType>::CGIterations(LocalVector<ValueType>* inv_diag,
+                                          ValueType rho,
+                                          bool (*check)(double res, void* data),
+                                          void* data,
+                                          LocalVector<ValueType>* x,
+                                          LocalVector<ValueType>* r,
+                                          LocalVector<ValueType>* p,
+                                          LocalVector<ValueType>* q) const
+{
+    log_debug(this, "LocalMatrix::CGIterations()", inv_diag, rho, data, x, r, p, q);
+
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::CGIterations", "matrix");
+
+    assert(check != NULL);
+    assert(x != NULL);
+    assert(r != NULL);
+    assert(p != NULL);
+    assert(q != NULL);
+    assert(this->GetM() == this->GetN());
+
+#ifdef DEBUG_MODE
+    this->Check();
+#endif
+
+    if(this->GetNnz() == 0 || this->is_host_() == false || this->GetFormat() != CSR)
+    {
+        return false;
+    }
+
+    if(x->is_host_() == false || r->is_host_() == false || p->is_host_() == false ||
+       q->is_host_() == false || (inv_diag != NULL && inv_diag->is_host_() == false))
+    {
+        return false;
+    }
+
+    // The inverse diagonal is extracted once and reused by subsequent calls
+    if(inv_diag != NULL && inv_diag->GetSize() == 0)
+    {
+        this->ExtractInverseDiagonal(inv_diag);
+    }
+
+    assert((inv_diag == NULL) || (inv_diag->GetSize() == this->GetM()));
+
+    return this->matrix_->CGIterations((inv_diag != NULL) ? inv_diag->vector_ : NULL,
+                                       rho,
+                                       check,
+                                       data,
+                                       x->vector_,
+                                       r->vector_,
+                                       p->vector_,
+                                       q->vector_);
+}
+
 template <typename ValueType>
 void LocalMatrix<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
                                       ValueType scalar,
@@ -1688,6 +2214,11 @@ void LocalMatrix<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
 {
     log_debug(this, "LocalMatrix::ApplyAdd()", (const void*&)in, scalar, out);
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::ApplyAdd", "matrix");
+    ROCALUTION_TRACE_COUNT(this->GetNnz() * (sizeof(ValueType) + sizeof(int))
+                               + (this->GetM() + this->GetN()) * sizeof(ValueType),
+                           2 * this->GetNnz());
+
     assert(out != NULL);
 
 #ifdef DEBUG_MODE
@@ -1967,31 +2498,93 @@ void LocalMatrix<ValueType>::ExtractSubMatrices(int row_num_blocks,
               col_offset,
               mat);
 
-    assert(row_num_blocks > 0);
-    assert(col_num_blocks > 0);
-    assert(row_offset != NULL);
-    assert(col_offset != NULL);
-    assert(mat != NULL);
-    assert(*mat != NULL);
+    assert(row_num_blocks > 0);
+    assert(col_num_blocks > 0);
+    assert(row_offset != NULL);
+    assert(col_offset != NULL);
+    assert(mat != NULL);
+    assert(*mat != NULL);
+
+#ifdef DEBUG_MODE
+    this->Check();
+#endif
+
+    if(this->GetNnz() > 0)
+    {
+        std::vector<BaseMatrix<ValueType>*> mat_base(row_num_blocks * col_num_blocks);
+
+        for(int i = 0; i < row_num_blocks; ++i)
+        {
+            for(int j = 0; j < col_num_blocks; ++j)
+            {
+                assert(mat[i][j] != NULL);
+                assert(mat[i][j] != this);
+                assert(((this->matrix_ == this->matrix_host_) &&
+                        (mat[i][j]->matrix_ == mat[i][j]->matrix_host_)) ||
+                       ((this->matrix_ == this->matrix_accel_) &&
+                        (mat[i][j]->matrix_ == mat[i][j]->matrix_accel_)));
+
+                // Submatrices should be same format as full matrix
+                mat[i][j]->Clear();
+                mat[i][j]->ConvertTo(this->GetFormat());
+
+                mat_base[i * col_num_blocks + j] = mat[i][j]->matrix_;
+            }
+        }
+
+        // Extract all blocks in a single pass over the matrix
+        bool err = this->matrix_->ExtractSubMatrices(
+            row_num_blocks, col_num_blocks, row_offset, col_offset, &mat_base[0]);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::ExtractSubMatrices() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            LOG_VERBOSE_INFO(2,
+                             "*** warning: LocalMatrix::ExtractSubMatrices() is performed "
+                             "block-wise");
+
+            // Fall back to ExtractSubMatrix() calls
+            for(int i = 0; i < row_num_blocks; ++i)
+            {
+                for(int j = 0; j < col_num_blocks; ++j)
+                {
+                    this->ExtractSubMatrix(row_offset[i],
+                                           col_offset[j],
+                                           row_offset[i + 1] - row_offset[i],
+                                           col_offset[j + 1] - col_offset[j],
+                                           mat[i][j]);
+                }
+            }
+        }
+        else
+        {
+            for(int i = 0; i < row_num_blocks; ++i)
+            {
+                for(int j = 0; j < col_num_blocks; ++j)
+                {
+                    if(mat[i][j]->GetNnz() == 0)
+                    {
+                        continue;
+                    }
+
+                    std::ostringstream mat_name;
+
+                    mat_name << "Submatrix of " << this->object_name_ << " [" << row_offset[i]
+                             << "," << col_offset[j] << "]-[" << row_offset[i + 1] - 1 << ","
+                             << col_offset[j + 1] - 1 << "]";
+
+                    mat[i][j]->object_name_ = mat_name.str();
 
 #ifdef DEBUG_MODE
-    this->Check();
+                    mat[i][j]->Check();
 #endif
-
-    if(this->GetNnz() > 0)
-    {
-        // implementation via ExtractSubMatrix() calls
-        // TODO OMP
-        //#pragma omp parallel for schedule(dynamic,1) collapse(2)
-        for(int i = 0; i < row_num_blocks; ++i)
-        {
-            for(int j = 0; j < col_num_blocks; ++j)
-            {
-                this->ExtractSubMatrix(row_offset[i],
-                                       col_offset[j],
-                                       row_offset[i + 1] - row_offset[i],
-                                       col_offset[j + 1] - col_offset[j],
-                                       mat[i][j]);
+                }
             }
         }
     }
@@ -2197,6 +2790,8 @@ void LocalMatrix<ValueType>::LUSolve(const LocalVector<ValueType>& in,
 {
     log_debug(this, "LocalMatrix::LUSolve()", (const void*&)in, out);
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::LUSolve", "matrix");
+
     assert(out != NULL);
     assert(in.GetSize() == this->GetN());
     assert(out->GetSize() == this->GetM());
@@ -2291,6 +2886,8 @@ void LocalMatrix<ValueType>::LLSolve(const LocalVector<ValueType>& in,
 {
     log_debug(this, "LocalMatrix::LLSolve()", (const void*&)in, out);
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::LLSolve", "matrix");
+
     assert(out != NULL);
     assert(in.GetSize() == this->GetN());
     assert(out->GetSize() == this->GetM());
@@ -2358,6 +2955,8 @@ void LocalMatrix<ValueType>::LLSolve(const LocalVector<ValueType>& in,
 {
     log_debug(this, "LocalMatrix::LLSolve()", (const void*&)in, (const void*&)inv_diag, out);
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::LLSolve", "matrix");
+
     assert(out != NULL);
     assert(in.GetSize() == this->GetN());
     assert(out->GetSize() == this->GetM());
@@ -2598,11 +3197,125 @@ void LocalMatrix<ValueType>::USolve(const LocalVector<ValueType>& in,
     }
 }
 
+template <typename ValueType>
+bool LocalMatrix<ValueType>::MultiColoredLSweep(int num_colors,
+                                                const int* color_offsets,
+                                                bool diag_unit,
+                                                ValueType omega,
+                                                LocalVector<ValueType>* x) const
+{
+    log_debug(this,
+              "LocalMatrix::MultiColoredLSweep()",
+              num_colors,
+              color_offsets,
+              diag_unit,
+              omega,
+              x);
+
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::MultiColoredLSweep", "matrix");
+
+    assert(num_colors >= 0);
+    assert(color_offsets != NULL);
+    assert(x != NULL);
+    assert(x->GetSize() == this->GetM());
+    assert(this->GetM() == this->GetN());
+
+    assert(((this->matrix_ == this->matrix_host_) && (x->vector_ == x->vector_host_)) ||
+           ((this->matrix_ == this->matrix_accel_) && (x->vector_ == x->vector_accel_)));
+
+#ifdef DEBUG_MODE
+    this->Check();
+#endif
+
+    if(this->GetNnz() == 0)
+    {
+        return true;
+    }
+
+    // Only supported on the host in CSR format, the caller falls back to per-color SpMVs
+    if(this->is_host_() == false || this->GetFormat() != CSR)
+    {
+        return false;
+    }
+
+    ROCALUTION_TRACE_COUNT(this->GetNnz() * (sizeof(ValueType) + sizeof(int))
+                               + this->GetM() * sizeof(ValueType),
+                           2 * this->GetNnz());
+
+    if(this->matrix_->MultiColoredLSweep(num_colors, color_offsets, diag_unit, omega, x->vector_)
+       == false)
+    {
+        LOG_INFO("Computation of LocalMatrix::MultiColoredLSweep() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    return true;
+}
+
+template <typename ValueType>
+bool LocalMatrix<ValueType>::MultiColoredUSweep(int num_colors,
+                                                const int* color_offsets,
+                                                bool diag_unit,
+                                                ValueType omega,
+                                                LocalVector<ValueType>* x) const
+{
+    log_debug(this,
+              "LocalMatrix::MultiColoredUSweep()",
+              num_colors,
+              color_offsets,
+              diag_unit,
+              omega,
+              x);
+
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::MultiColoredUSweep", "matrix");
+
+    assert(num_colors >= 0);
+    assert(color_offsets != NULL);
+    assert(x != NULL);
+    assert(x->GetSize() == this->GetM());
+    assert(this->GetM() == this->GetN());
+
+    assert(((this->matrix_ == this->matrix_host_) && (x->vector_ == x->vector_host_)) ||
+           ((this->matrix_ == this->matrix_accel_) && (x->vector_ == x->vector_accel_)));
+
+#ifdef DEBUG_MODE
+    this->Check();
+#endif
+
+    if(this->GetNnz() == 0)
+    {
+        return true;
+    }
+
+    // Only supported on the host in CSR format, the caller falls back to per-color SpMVs
+    if(this->is_host_() == false || this->GetFormat() != CSR)
+    {
+        return false;
+    }
+
+    ROCALUTION_TRACE_COUNT(this->GetNnz() * (sizeof(ValueType) + sizeof(int))
+                               + this->GetM() * sizeof(ValueType),
+                           2 * this->GetNnz());
+
+    if(this->matrix_->MultiColoredUSweep(num_colors, color_offsets, diag_unit, omega, x->vector_)
+       == false)
+    {
+        LOG_INFO("Computation of LocalMatrix::MultiColoredUSweep() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    return true;
+}
+
 template <typename ValueType>
 void LocalMatrix<ValueType>::ILU0Factorize(void)
 {
     log_debug(this, "LocalMatrix::ILU0Factorize()");
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::ILU0Factorize", "matrix");
+
 #ifdef DEBUG_MODE
     this->Check();
 #endif
@@ -3660,6 +4373,145 @@ void LocalMatrix<ValueType>::ConnectivityOrder(LocalVector<int>* permutation) co
     permutation->object_name_ = vec_name;
 }
 
+template <typename ValueType>
+void LocalMatrix<ValueType>::KWayPartitioning(int num_parts,
+                                              int** size_parts,
+                                              LocalVector<int>* permutation) const
+{
+    log_debug(this, "LocalMatrix::KWayPartitioning()", num_parts, size_parts, permutation);
+
+    assert(num_parts > 0);
+    assert(*size_parts == NULL);
+    assert(permutation != NULL);
+    assert(this->GetM() == this->GetN());
+
+    assert(((this->matrix_ == this->matrix_host_) &&
+            (permutation->vector_ == permutation->vector_host_)) ||
+           ((this->matrix_ == this->matrix_accel_) &&
+            (permutation->vector_ == permutation->vector_accel_)));
+
+#ifdef DEBUG_MODE
+    this->Check();
+#endif
+
+    if(this->GetNnz() > 0)
+    {
+        std::string vec_perm_name = "KWayPartitioning permutation of " + this->object_name_;
+        permutation->Allocate(vec_perm_name, 0);
+        permutation->CloneBackend(*this);
+
+        bool err = this->matrix_->KWayPartitioning(num_parts, size_parts, permutation->vector_);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::KWayPartitioning() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat());
+            mat_host.CopyFrom(*this);
+
+            // Move to host
+            permutation->MoveToHost();
+
+            // Convert to CSR
+            mat_host.ConvertToCSR();
+
+            if(mat_host.matrix_->KWayPartitioning(
+                   num_parts, size_parts, permutation->vector_) == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::KWayPartitioning() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(this->GetFormat() != CSR)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::KWayPartitioning() is performed in CSR format");
+            }
+
+            if(this->is_accel_() == true)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::KWayPartitioning() is performed on the host");
+
+                permutation->MoveToAccelerator();
+            }
+        }
+    }
+}
+
+template <typename ValueType>
+void LocalMatrix<ValueType>::NestedDissection(LocalVector<int>* permutation) const
+{
+    log_debug(this, "LocalMatrix::NestedDissection()", permutation);
+
+    assert(permutation != NULL);
+
+    assert(((this->matrix_ == this->matrix_host_) &&
+            (permutation->vector_ == permutation->vector_host_)) ||
+           ((this->matrix_ == this->matrix_accel_) &&
+            (permutation->vector_ == permutation->vector_accel_)));
+
+#ifdef DEBUG_MODE
+    this->Check();
+#endif
+
+    if(this->GetNnz() > 0)
+    {
+        bool err = this->matrix_->NestedDissection(permutation->vector_);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::NestedDissection() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            LocalMatrix<ValueType> mat_host;
+            mat_host.ConvertTo(this->GetFormat());
+            mat_host.CopyFrom(*this);
+
+            // Move to host
+            permutation->MoveToHost();
+
+            // Convert to CSR
+            mat_host.ConvertToCSR();
+
+            if(mat_host.matrix_->NestedDissection(permutation->vector_) == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::NestedDissection() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(this->GetFormat() != CSR)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::NestedDissection() is performed in CSR format");
+            }
+
+            if(this->is_accel_() == true)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::NestedDissection() is performed on the host");
+
+                permutation->MoveToAccelerator();
+            }
+        }
+    }
+
+    std::string vec_name      = "NestedDissection permutation of " + this->object_name_;
+    permutation->object_name_ = vec_name;
+}
+
 template <typename ValueType>
 void LocalMatrix<ValueType>::SymbolicPower(int p)
 {
@@ -4206,6 +5058,8 @@ void LocalMatrix<ValueType>::MatrixMult(const LocalMatrix<ValueType>& A,
 {
     log_debug(this, "LocalMatrix::AddScalarDiagonal()", (const void*&)A, (const void*&)B);
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::MatrixMult", "matrix");
+
     assert(&A != this);
     assert(&B != this);
     assert(A.GetN() == B.GetM());
@@ -4797,6 +5651,74 @@ void LocalMatrix<ValueType>::AMGAggregate(const LocalVector<int>& connections,
     }
 }
 
+template <typename ValueType>
+void LocalMatrix<ValueType>::AMGMIS2Aggregate(const LocalVector<int>& connections,
+                                              LocalVector<int>* aggregates) const
+{
+    log_debug(this, "LocalMatrix::AMGMIS2Aggregate()", (const void*&)connections, aggregates);
+
+    assert(aggregates != NULL);
+
+    assert(((this->matrix_ == this->matrix_host_) &&
+            (connections.vector_ == connections.vector_host_) &&
+            (aggregates->vector_ == aggregates->vector_host_)) ||
+           ((this->matrix_ == this->matrix_accel_) &&
+            (connections.vector_ == connections.vector_accel_) &&
+            (aggregates->vector_ == aggregates->vector_accel_)));
+
+#ifdef DEBUG_MODE
+    this->Check();
+#endif
+
+    if(this->GetNnz() > 0)
+    {
+        bool err = this->matrix_->AMGMIS2Aggregate(*connections.vector_, aggregates->vector_);
+
+        if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
+        {
+            LOG_INFO("Computation of LocalMatrix::AMGMIS2Aggregate() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            LocalMatrix<ValueType> mat_host;
+            LocalVector<int> conn_host;
+            mat_host.ConvertTo(this->GetFormat());
+            mat_host.CopyFrom(*this);
+            conn_host.CopyFrom(connections);
+
+            // Move to host
+            aggregates->MoveToHost();
+
+            // Convert to CSR
+            mat_host.ConvertToCSR();
+
+            if(mat_host.matrix_->AMGMIS2Aggregate(*conn_host.vector_, aggregates->vector_) == false)
+            {
+                LOG_INFO("Computation of LocalMatrix::AMGMIS2Aggregate() failed");
+                mat_host.Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            if(this->GetFormat() != CSR)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::AMGMIS2Aggregate() is performed in CSR format");
+            }
+
+            if(this->is_accel_() == true)
+            {
+                LOG_VERBOSE_INFO(
+                    2, "*** warning: LocalMatrix::AMGMIS2Aggregate() is performed on the host");
+
+                aggregates->MoveToAccelerator();
+            }
+        }
+    }
+}
+
 template <typename ValueType>
 void LocalMatrix<ValueType>::AMGSmoothedAggregation(ValueType relax,
                                                     const LocalVector<int>& aggregates,
@@ -4998,8 +5920,37 @@ void LocalMatrix<ValueType>::RugeStueben(ValueType eps,
 {
     log_debug(this, "LocalMatrix::RugeStueben()", eps, prolong, restrict);
 
+    // Classical splitting and direct interpolation
+    this->RugeStueben(eps, 0, 0, false, static_cast<ValueType>(0), 0, prolong, restrict);
+}
+
+template <typename ValueType>
+void LocalMatrix<ValueType>::RugeStueben(ValueType eps,
+                                         int coarsening,
+                                         int interpolation,
+                                         bool aggressive,
+                                         ValueType trunc_factor,
+                                         int trunc_max_elements,
+                                         LocalMatrix<ValueType>* prolong,
+                                         LocalMatrix<ValueType>* restrict) const
+{
+    log_debug(this,
+              "LocalMatrix::RugeStueben()",
+              eps,
+              coarsening,
+              interpolation,
+              aggressive,
+              trunc_factor,
+              trunc_max_elements,
+              prolong,
+              restrict);
+
     assert(eps < static_cast<ValueType>(1));
     assert(eps > static_cast<ValueType>(0));
+    assert((coarsening >= 0) && (coarsening <= 2));
+    assert((interpolation == 0) || (interpolation == 1));
+    assert(trunc_factor >= static_cast<ValueType>(0));
+    assert(trunc_max_elements >= 0);
     assert(prolong != NULL);
     assert(restrict != NULL);
     assert(this != prolong);
@@ -5017,7 +5968,14 @@ void LocalMatrix<ValueType>::RugeStueben(ValueType eps,
 
     if(this->GetNnz() > 0)
     {
-        bool err = this->matrix_->RugeStueben(eps, prolong->matrix_, restrict->matrix_);
+        bool err = this->matrix_->RugeStueben(eps,
+                                              coarsening,
+                                              interpolation,
+                                              aggressive,
+                                              trunc_factor,
+                                              trunc_max_elements,
+                                              prolong->matrix_,
+                                              restrict->matrix_);
 
         if((err == false) && (this->is_host_() == true) && (this->GetFormat() == CSR))
         {
@@ -5039,7 +5997,14 @@ void LocalMatrix<ValueType>::RugeStueben(ValueType eps,
             // Convert to CSR
             mat_host.ConvertToCSR();
 
-            if(mat_host.matrix_->RugeStueben(eps, prolong->matrix_, restrict->matrix_) == false)
+            if(mat_host.matrix_->RugeStueben(eps,
+                                             coarsening,
+                                             interpolation,
+                                             aggressive,
+                                             trunc_factor,
+                                             trunc_max_elements,
+                                             prolong->matrix_,
+                                             restrict->matrix_) == false)
             {
                 LOG_INFO("Computation of LocalMatrix::RugeStueben() failed");
                 mat_host.Info();
@@ -5662,6 +6627,8 @@ void LocalMatrix<ValueType>::LUFactorize(void)
 {
     log_debug(this, "LocalMatrix::LUFactorize()");
 
+    ROCALUTION_TRACE_SCOPE("LocalMatrix::LUFactorize", "matrix");
+
 #ifdef DEBUG_MODE
     this->Check();
 #endif
@@ -38,6 +38,8 @@ template <typename ValueType>
 class LocalVector;
 template <typename ValueType>
 class GlobalVector;
+template <typename ValueType>
+class LocalMultiVector;
 
 template <typename ValueType>
 class GlobalMatrix;
@@ -259,7 +261,9 @@ class LocalMatrix : public Operator<ValueType>
 
     /** \brief Create permutation vector for CMK reordering of the matrix
       * \details
-      * The Cuthill-McKee ordering minimize the bandwidth of a given sparse matrix.
+      * The Cuthill-McKee ordering minimize the bandwidth of a given sparse matrix. Each
+      * connected component of the (symmetrized) matrix graph is numbered starting from
+      * a pseudo-peripheral node, that is determined by the George-Liu algorithm.
       *
       * @param[out]
       * permutation permutation vector for CMK reordering
@@ -310,6 +314,53 @@ class LocalMatrix : public Operator<ValueType>
       */
     void ConnectivityOrder(LocalVector<int>* permutation) const;
 
+    /** \brief Perform k-way partitioning of the matrix graph
+      * \details
+      * The multilevel graph partitioning splits the graph of the (symmetrized) matrix
+      * into parts of balanced size with a small number of edges between the parts. The
+      * graph is coarsened by heavy-edge matching, bisected by greedy graph growing and
+      * refined by Fiduccia-Mattheyses on each level. The k-way partitioning is obtained
+      * by recursive bisection. The permutation numbers the nodes of each part
+      * contiguously, such that each part can be processed by a single thread or form a
+      * subdomain of a block preconditioner.
+      *
+      * @param[in]
+      * num_parts   number of parts
+      * @param[out]
+      * size_parts  pointer to array that holds the number of nodes for each part
+      * @param[out]
+      * permutation permutation vector for k-way partitioning reordering
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> kway;
+      *   int* size_parts = NULL;
+      *
+      *   mat.KWayPartitioning(8, &size_parts, &kway);
+      *   mat.Permute(kway);
+      * \endcode
+      */
+    void KWayPartitioning(int num_parts, int** size_parts, LocalVector<int>* permutation) const;
+
+    /** \brief Create permutation vector for nested dissection reordering of the matrix
+      * \details
+      * Nested dissection recursively bisects the graph of the (symmetrized) matrix by
+      * the multilevel graph partitioning and orders the vertex separator after both
+      * parts. The ordering reduces the fill-in of (incomplete) factorizations.
+      *
+      * @param[out]
+      * permutation permutation vector for nested dissection reordering
+      *
+      * \par Example
+      * \code{.cpp}
+      *   LocalVector<int> nd;
+      *
+      *   mat.NestedDissection(&nd);
+      *   mat.Permute(nd);
+      * \endcode
+      */
+    void NestedDissection(LocalVector<int>* permutation) const;
+
     /** \brief Perform multi-coloring decomposition of the matrix
       * \details
       * The Multi-Coloring algorithm builds a permutation (coloring of the matrix) in a
@@ -441,6 +492,49 @@ class LocalMatrix : public Operator<ValueType>
       */
     void USolve(const LocalVector<ValueType>& in, LocalVector<ValueType>* out) const;
 
+    /** \brief Perform a multi-colored forward sweep in place
+      * \details
+      * The rows of the matrix have to be ordered by colors, such that color \p c
+      * consists of the rows \p color_offsets[c] to \p color_offsets[c+1]-1 and the
+      * diagonal block of each color is diagonal. For each color c in ascending order,
+      * \f$x_c = (x_c - A_{c,<c} x_{<c}) / (\omega D_c)\f$ is computed. If
+      * \p diag_unit is true, the diagonal is treated as identity. All colors are
+      * processed by a single kernel, directly on the CSR structure. The sweep is only
+      * available on the host in CSR format.
+      *
+      * @param[in]
+      * num_colors      number of colors
+      * @param[in]
+      * color_offsets   host array of size \p num_colors + 1, containing the first row of
+      *                 each color
+      * @param[in]
+      * diag_unit       treat the diagonal as identity
+      * @param[in]
+      * omega           relaxation parameter
+      * @param[inout]
+      * x               vector that is swept in place
+      *
+      * \retval     true if the sweep has been performed
+      * \retval     false if the sweep is not supported for the matrix format or location,
+      *             nothing is computed in this case
+      */
+    bool MultiColoredLSweep(int num_colors,
+                            const int* color_offsets,
+                            bool diag_unit,
+                            ValueType omega,
+                            LocalVector<ValueType>* x) const;
+    /** \brief Perform a multi-colored backward sweep in place
+      * \details
+      * For each color c in descending order,
+      * \f$x_c = (x_c - A_{c,>c} x_{>c}) / (\omega D_c)\f$ is computed (see
+      * MultiColoredLSweep()).
+      */
+    bool MultiColoredUSweep(int num_colors,
+                            const int* color_offsets,
+                            bool diag_unit,
+                            ValueType omega,
+                            LocalVector<ValueType>* x) const;
+
     /** \brief Compute Householder vector */
     void Householder(int idx, ValueType& beta, LocalVector<ValueType>* vec) const;
     /** \brief QR Decomposition */
@@ -683,12 +777,139 @@ class LocalMatrix : public Operator<ValueType>
     void ConvertToHYB(void);
     /** \brief Convert the matrix to DENSE structure */
     void ConvertToDENSE(void);
+    /** \brief Convert the matrix to SELL-C-sigma structure
+      * \details
+      * SELL is only available on the host. On the accelerator, and when the matrix is
+      * moved to the accelerator, it is converted to ELL instead.
+      */
+    void ConvertToSELL(void);
+    /** \brief Convert the matrix to compressed CSR structure
+      * \details
+      * The compressed CSR format stores the column indices as 16 bit differences to the
+      * previous entry of the row, and the values in single precision (CCSR) or in
+      * bfloat16 (CCSRBF16, if \p bfloat16 is true). The SpMV still computes in the
+      * precision of the matrix, but requires 6 (CCSR) or 4 (CCSRBF16) instead of 12
+      * bytes per non-zero entry in double precision. The values are rounded, hence the
+      * format is intended for preconditioner and multigrid level operators, that
+      * tolerate reduced precision. Converting back to any other format keeps the
+      * rounded values.
+      *
+      * CCSR is only available on the host. On the accelerator, and when the matrix is
+      * moved to the accelerator, it is converted to CSR instead.
+      */
+    void ConvertToCCSR(bool bfloat16 = false);
     /** \brief Convert the matrix to specified matrix ID format */
     void ConvertTo(unsigned int matrix_format);
 
+    /** \brief Select a matrix format for SpMV and convert the matrix to it
+      * \details
+      * \p AutoTuneFormat analyses the sparsity structure of the matrix, i.e. the
+      * distribution of the row lengths and the number of occupied diagonals, and
+      * selects the format with the least padding overhead. Regular stencils are
+      * converted to DIA, matrices with nearly constant row lengths to ELL. Irregular
+      * matrices stay in CSR format on the host and are converted to HYB on the
+      * accelerator.
+      *
+      * If \p benchmark is set, all formats that can hold the matrix are timed
+      * with a few SpMVs on the current backend and the fastest one is selected instead.
+      *
+      * The decision is cached, using the sparsity pattern keys (see Key()), size and
+      * backend of the matrix. Further calls on matrices with the same pattern, e.g.
+      * after a numerical update, convert without repeating the analysis.
+      * The cache is shared by all threads and holds the decisions of the 64 most
+      * recently used patterns.
+      *
+      * @param[in]
+      * benchmark   time the candidate formats instead of using the structural
+      *             heuristic
+      *
+      * \retval      the selected matrix format ID
+      *
+      * \par Example
+      * \code{.cpp}
+      *   mat.MoveToAccelerator();
+      *   mat.AutoTuneFormat();
+      * \endcode
+      */
+    unsigned int AutoTuneFormat(bool benchmark = false);
+
     virtual void Apply(const LocalVector<ValueType>& in, LocalVector<ValueType>* out) const;
     virtual void
     ApplyAdd(const LocalVector<ValueType>& in, ValueType scalar, LocalVector<ValueType>* out) const;
+    /** \brief Apply the matrix to all columns of a multi-vector (SpMM), out = this*in
+      * \details
+      * Each matrix entry is read once for all columns of \p in. CSR and ELL provide
+      * dedicated host kernels, all other formats are applied in CSR format.
+      */
+    void Apply(const LocalMultiVector<ValueType>& in, LocalMultiVector<ValueType>* out) const;
+
+    /** \brief Restrict the residual of a fine level operator, out = this * (b - Ax)
+      * \details
+      * The residual is computed and restricted in a fused kernel. If the residual itself
+      * is not required and each column of this restriction holds at most one entry
+      * (e.g. aggregation based AMG), every residual entry is computed within the coarse
+      * row that restricts it and the residual is never stored. Otherwise, the residual
+      * is computed in a single sweep into \p s and restricted afterwards.
+      *
+      * @param[in]
+      * A           fine level operator
+      * @param[in]
+      * b           fine level right-hand side
+      * @param[in]
+      * x           fine level solution
+      * @param[in]
+      * residual    if true, \p s holds the residual on return
+      * @param[out]
+      * s           residual or buffer of the fine level size
+      * @param[out]
+      * out         restricted residual
+      */
+    void RestrictResidual(const LocalMatrix<ValueType>& A,
+                          const LocalVector<ValueType>& b,
+                          const LocalVector<ValueType>& x,
+                          bool residual,
+                          LocalVector<ValueType>* s,
+                          LocalVector<ValueType>* out) const;
+
+    /** \brief Perform CG iterations in a single parallel region
+      * \details
+      * The whole CG loop runs in one OpenMP parallel region. Each thread owns a fixed
+      * range of rows for all iterations, the phases (SpMV, vector updates, dot products)
+      * are separated by barriers and the dot products are reduced from per-thread
+      * partial sums. This avoids the fork/join of every single operation and is used by
+      * the CG solver on the host. Only CSR matrices on the host are supported.
+      *
+      * @param[inout]
+      * inv_diag    if not NULL, the iterations are Jacobi preconditioned with the inverse
+      *             diagonal \p inv_diag. If \p inv_diag is empty, the inverse diagonal
+      *             is extracted and stored in \p inv_diag for subsequent calls
+      * @param[in]
+      * rho         \f$(r,z)\f$ of the initial residual
+      * @param[in]
+      * check       called with \f$\|r\|_2\f$ after each iteration, iterating stops
+      *             when it returns true
+      * @param[in]
+      * data        user data passed to \p check
+      * @param[inout]
+      * x           solution
+      * @param[inout]
+      * r           residual
+      * @param[inout]
+      * p           search direction, initialized with the preconditioned residual
+      * @param[out]
+      * q           buffer
+      *
+      * \retval     false if the iterations are not supported for the matrix format or
+      *             location, nothing is computed in this case
+      */
+    bool CGIterations(LocalVector<ValueType>* inv_diag,
+                      ValueType rho,
+                      bool (*check)(double res, void* data),
+                      void* data,
+                      LocalVector<ValueType>* x,
+                      LocalVector<ValueType>* r,
+                      LocalVector<ValueType>* p,
+                      LocalVector<ValueType>* q) const;
 
     /** \brief Perform symbolic computation (structure only) of \f$|this|^p\f$ */
     void SymbolicPower(int p);
@@ -772,6 +993,12 @@ class LocalMatrix : public Operator<ValueType>
       * Vanek (1996)
       */
     void AMGAggregate(const LocalVector<int>& connections, LocalVector<int>* aggregates) const;
+    /** \brief Parallel aggregation based on a distance-2 maximal independent set of the
+      * strong couplings - Bell, Dalton, Olson (2012)
+      * \details
+      * The aggregates are independent of the number of threads.
+      */
+    void AMGMIS2Aggregate(const LocalVector<int>& connections, LocalVector<int>* aggregates) const;
     /** \brief Interpolation scheme based on smoothed aggregation from Vanek (1996) */
     void AMGSmoothedAggregation(ValueType relax,
                                 const LocalVector<int>& aggregates,
@@ -787,6 +1014,25 @@ class LocalMatrix : public Operator<ValueType>
     void RugeStueben(ValueType eps,
                      LocalMatrix<ValueType>* prolong,
                      LocalMatrix<ValueType>* restrict) const;
+    /** \brief Ruge Stueben coarsening with selectable C/F splitting and interpolation
+      * \details
+      * \p coarsening selects the C/F splitting, 0 for the classical (serial) Ruge
+      * Stueben splitting, 1 for PMIS and 2 for HMIS. \p interpolation selects direct (0)
+      * or extended+i (1) interpolation. If \p aggressive is true, the coarsening is
+      * applied twice and the two interpolation operators are multiplied (two-stage
+      * interpolation). Interpolation weights smaller than \p trunc_factor times the
+      * largest weight of a row are dropped and at most \p trunc_max_elements weights
+      * are kept per row, while the row sums are preserved. A value of zero disables the
+      * respective truncation.
+      */
+    void RugeStueben(ValueType eps,
+                     int coarsening,
+                     int interpolation,
+                     bool aggressive,
+                     ValueType trunc_factor,
+                     int trunc_max_elements,
+                     LocalMatrix<ValueType>* prolong,
+                     LocalMatrix<ValueType>* restrict) const;
 
     /** \brief Factorized Sparse Approximate Inverse assembly for given system matrix
       * power pattern or external sparsity pattern
@@ -0,0 +1,570 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../utils/def.hpp"
+#include "local_multi_vector.hpp"
+#include "local_vector.hpp"
+#include "base_vector.hpp"
+#include "backend_manager.hpp"
+
+#include "../utils/log.hpp"
+#include "../utils/trace.hpp"
+#include "../utils/allocate_free.hpp"
+
+#include <complex>
+#include <string>
+
+namespace rocalution {
+
+template <typename ValueType>
+LocalMultiVector<ValueType>::LocalMultiVector()
+{
+    log_debug(this, "LocalMultiVector::LocalMultiVector()");
+
+    this->object_name_ = "";
+
+    this->nrow_ = 0;
+    this->ncol_ = 0;
+}
+
+template <typename ValueType>
+LocalMultiVector<ValueType>::~LocalMultiVector()
+{
+    log_debug(this, "LocalMultiVector::~LocalMultiVector()");
+
+    this->Clear();
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::MoveToAccelerator(void)
+{
+    log_debug(this, "LocalMultiVector::MoveToAccelerator()");
+
+    this->vector_.MoveToAccelerator();
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::MoveToHost(void)
+{
+    log_debug(this, "LocalMultiVector::MoveToHost()");
+
+    this->vector_.MoveToHost();
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::Info(void) const
+{
+    std::string current_backend_name;
+
+    if(this->is_host_() == true)
+    {
+        current_backend_name = _rocalution_host_name[0];
+    }
+    else
+    {
+        assert(this->is_accel_() == true);
+        current_backend_name = _rocalution_backend_name[this->local_backend_.backend];
+    }
+
+    LOG_INFO("LocalMultiVector"
+             << " name="
+             << this->object_name_
+             << ";"
+             << " rows="
+             << this->nrow_
+             << ";"
+             << " cols="
+             << this->ncol_
+             << ";"
+             << " prec="
+             << 8 * sizeof(ValueType)
+             << "bit;"
+             << " host backend={"
+             << _rocalution_host_name[0]
+             << "};"
+             << " accelerator backend={"
+             << _rocalution_backend_name[this->local_backend_.backend]
+             << "};"
+             << " current="
+             << current_backend_name);
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::Clear(void)
+{
+    log_debug(this, "LocalMultiVector::Clear()");
+
+    this->vector_.Clear();
+
+    this->nrow_ = 0;
+    this->ncol_ = 0;
+}
+
+template <typename ValueType>
+bool LocalMultiVector<ValueType>::is_host_(void) const
+{
+    return this->vector_.is_host_();
+}
+
+template <typename ValueType>
+bool LocalMultiVector<ValueType>::is_accel_(void) const
+{
+    return this->vector_.is_accel_();
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::Allocate(std::string name, int nrow, int ncol)
+{
+    log_debug(this, "LocalMultiVector::Allocate()", name, nrow, ncol);
+
+    assert(nrow >= 0);
+    assert(ncol >= 0);
+
+    this->Clear();
+
+    this->object_name_ = name;
+
+    this->vector_.CloneBackend(*this);
+    this->vector_.Allocate(name, static_cast<IndexType2>(nrow) * ncol);
+
+    this->nrow_ = nrow;
+    this->ncol_ = ncol;
+}
+
+template <typename ValueType>
+int LocalMultiVector<ValueType>::GetNumRows(void) const
+{
+    return this->nrow_;
+}
+
+template <typename ValueType>
+int LocalMultiVector<ValueType>::GetNumCols(void) const
+{
+    return this->ncol_;
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::Zeros(void)
+{
+    log_debug(this, "LocalMultiVector::Zeros()");
+
+    this->vector_.Zeros();
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::SetValues(ValueType val)
+{
+    log_debug(this, "LocalMultiVector::SetValues()", val);
+
+    this->vector_.SetValues(val);
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::SetRandomUniform(unsigned long long seed,
+                                                   ValueType a,
+                                                   ValueType b)
+{
+    log_debug(this, "LocalMultiVector::SetRandomUniform()", seed, a, b);
+
+    this->vector_.SetRandomUniform(seed, a, b);
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::CopyFrom(const LocalMultiVector<ValueType>& src)
+{
+    log_debug(this, "LocalMultiVector::CopyFrom()", (const void*&)src);
+
+    assert(this != &src);
+    assert(this->nrow_ == src.nrow_);
+    assert(this->ncol_ == src.ncol_);
+
+    this->vector_.CopyFrom(src.vector_);
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::CloneFrom(const LocalMultiVector<ValueType>& src)
+{
+    log_debug(this, "LocalMultiVector::CloneFrom()", (const void*&)src);
+
+    assert(this != &src);
+
+    this->Clear();
+    this->CloneBackend(src);
+
+    this->object_name_ = src.object_name_;
+    this->vector_.CloneFrom(src.vector_);
+
+    this->nrow_ = src.nrow_;
+    this->ncol_ = src.ncol_;
+}
+
+template <typename ValueType>
+ValueType& LocalMultiVector<ValueType>::operator()(int i, int j)
+{
+    assert(i >= 0 && i < this->nrow_);
+    assert(j >= 0 && j < this->ncol_);
+
+    return this->vector_[i * this->ncol_ + j];
+}
+
+template <typename ValueType>
+const ValueType& LocalMultiVector<ValueType>::operator()(int i, int j) const
+{
+    assert(i >= 0 && i < this->nrow_);
+    assert(j >= 0 && j < this->ncol_);
+
+    return this->vector_[i * this->ncol_ + j];
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::GetColumn(int j, LocalVector<ValueType>* vec) const
+{
+    log_debug(this, "LocalMultiVector::GetColumn()", j, vec);
+
+    assert(vec != NULL);
+    assert(j >= 0 && j < this->ncol_);
+
+    if(vec->GetSize() != this->nrow_)
+    {
+        vec->Clear();
+        vec->CloneBackend(*this);
+        vec->Allocate("column", this->nrow_);
+    }
+
+    assert(this->is_host_() == vec->is_host_());
+
+    if(this->nrow_ > 0)
+    {
+        bool err = this->vector_.vector_->ExtractColumn(this->ncol_, j, vec->vector_);
+
+        if((err == false) && (this->is_host_() == true))
+        {
+            LOG_INFO("Computation of LocalMultiVector::GetColumn() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            LocalVector<ValueType> host;
+            host.Allocate("host", this->vector_.GetSize());
+            host.CopyFrom(this->vector_);
+
+            vec->MoveToHost();
+
+            if(host.vector_->ExtractColumn(this->ncol_, j, vec->vector_) == false)
+            {
+                LOG_INFO("Computation of LocalMultiVector::GetColumn() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            LOG_VERBOSE_INFO(
+                2, "*** warning: LocalMultiVector::GetColumn() is performed on the host");
+
+            vec->MoveToAccelerator();
+        }
+    }
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::SetColumn(int j, const LocalVector<ValueType>& vec)
+{
+    log_debug(this, "LocalMultiVector::SetColumn()", j, (const void*&)vec);
+
+    assert(j >= 0 && j < this->ncol_);
+    assert(vec.GetSize() == this->nrow_);
+    assert(this->is_host_() == vec.is_host_());
+
+    if(this->nrow_ > 0)
+    {
+        bool err = this->vector_.vector_->InsertColumn(this->ncol_, j, *vec.vector_);
+
+        if((err == false) && (this->is_host_() == true))
+        {
+            LOG_INFO("Computation of LocalMultiVector::SetColumn() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        if(err == false)
+        {
+            LocalVector<ValueType> host;
+            host.Allocate("host", vec.GetSize());
+            host.CopyFrom(vec);
+
+            this->MoveToHost();
+
+            if(this->vector_.vector_->InsertColumn(this->ncol_, j, *host.vector_) == false)
+            {
+                LOG_INFO("Computation of LocalMultiVector::SetColumn() failed");
+                this->Info();
+                FATAL_ERROR(__FILE__, __LINE__);
+            }
+
+            LOG_VERBOSE_INFO(
+                2, "*** warning: LocalMultiVector::SetColumn() is performed on the host");
+
+            this->MoveToAccelerator();
+        }
+    }
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::SelectColumns(const LocalMultiVector<ValueType>& x,
+                                                int ncol,
+                                                const int* cols)
+{
+    log_debug(this, "LocalMultiVector::SelectColumns()", (const void*&)x, ncol, cols);
+
+    assert(this != &x);
+    assert(ncol >= 0);
+    assert((ncol == 0) || (cols != NULL));
+
+    if((this->nrow_ != x.nrow_) || (this->ncol_ != ncol))
+    {
+        this->CloneBackend(x);
+        this->Allocate(this->object_name_, x.nrow_, ncol);
+    }
+
+    if(ncol > 0)
+    {
+        // The selection is a block update with a 0/1 coefficient matrix
+        ValueType* coef = NULL;
+        allocate_host(x.ncol_ * ncol, &coef);
+        set_to_zero_host(x.ncol_ * ncol, coef);
+
+        for(int j = 0; j < ncol; ++j)
+        {
+            assert(cols[j] >= 0 && cols[j] < x.ncol_);
+            coef[cols[j] + j * x.ncol_] = static_cast<ValueType>(1);
+        }
+
+        this->BlockUpdate(static_cast<ValueType>(0), x, coef);
+
+        free_host(&coef);
+    }
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::AddScale(const LocalMultiVector<ValueType>& x, ValueType alpha)
+{
+    log_debug(this, "LocalMultiVector::AddScale()", (const void*&)x, alpha);
+
+    assert(this->nrow_ == x.nrow_);
+    assert(this->ncol_ == x.ncol_);
+
+    this->vector_.AddScale(x.vector_, alpha);
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::ScaleAdd(ValueType alpha, const LocalMultiVector<ValueType>& x)
+{
+    log_debug(this, "LocalMultiVector::ScaleAdd()", alpha, (const void*&)x);
+
+    assert(this->nrow_ == x.nrow_);
+    assert(this->ncol_ == x.ncol_);
+
+    this->vector_.ScaleAdd(alpha, x.vector_);
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::Scale(ValueType alpha)
+{
+    log_debug(this, "LocalMultiVector::Scale()", alpha);
+
+    this->vector_.Scale(alpha);
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::BlockDot(const LocalMultiVector<ValueType>& x,
+                                           ValueType* result) const
+{
+    log_debug(this, "LocalMultiVector::BlockDot()", (const void*&)x, result);
+
+    ROCALUTION_TRACE_SCOPE("LocalMultiVector::BlockDot", "vector");
+    ROCALUTION_TRACE_COUNT(this->vector_.GetSize() * sizeof(ValueType)
+                               + x.vector_.GetSize() * sizeof(ValueType),
+                           2 * this->nrow_ * this->ncol_ * x.ncol_);
+
+    assert(result != NULL);
+    assert(this->nrow_ == x.nrow_);
+    assert(this->ncol_ > 0);
+    assert(x.ncol_ > 0);
+    assert(this->is_host_() == x.is_host_());
+
+    bool err = this->vector_.vector_->BlockDot(this->ncol_, *x.vector_.vector_, x.ncol_, result);
+
+    if((err == false) && (this->is_host_() == true))
+    {
+        LOG_INFO("Computation of LocalMultiVector::BlockDot() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    if(err == false)
+    {
+        LocalVector<ValueType> host;
+        LocalVector<ValueType> host_x;
+
+        host.Allocate("host", this->vector_.GetSize());
+        host_x.Allocate("host", x.vector_.GetSize());
+
+        host.CopyFrom(this->vector_);
+        host_x.CopyFrom(x.vector_);
+
+        if(host.vector_->BlockDot(this->ncol_, *host_x.vector_, x.ncol_, result) == false)
+        {
+            LOG_INFO("Computation of LocalMultiVector::BlockDot() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        LOG_VERBOSE_INFO(2, "*** warning: LocalMultiVector::BlockDot() is performed on the host");
+    }
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::BlockUpdate(ValueType beta,
+                                              const LocalMultiVector<ValueType>& x,
+                                              const ValueType* coef)
+{
+    log_debug(this, "LocalMultiVector::BlockUpdate()", beta, (const void*&)x, coef);
+
+    ROCALUTION_TRACE_SCOPE("LocalMultiVector::BlockUpdate", "vector");
+    ROCALUTION_TRACE_COUNT(2 * this->vector_.GetSize() * sizeof(ValueType)
+                               + x.vector_.GetSize() * sizeof(ValueType),
+                           2 * this->nrow_ * this->ncol_ * x.ncol_);
+
+    assert(this != &x);
+    assert(coef != NULL);
+    assert(this->nrow_ == x.nrow_);
+    assert(this->ncol_ > 0);
+    assert(x.ncol_ > 0);
+    assert(this->is_host_() == x.is_host_());
+
+    bool err = this->vector_.vector_->BlockUpdate(
+        this->ncol_, beta, *x.vector_.vector_, x.ncol_, coef);
+
+    if((err == false) && (this->is_host_() == true))
+    {
+        LOG_INFO("Computation of LocalMultiVector::BlockUpdate() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    if(err == false)
+    {
+        LocalVector<ValueType> host_x;
+        host_x.Allocate("host", x.vector_.GetSize());
+        host_x.CopyFrom(x.vector_);
+
+        this->MoveToHost();
+
+        if(this->vector_.vector_->BlockUpdate(
+               this->ncol_, beta, *host_x.vector_, x.ncol_, coef)
+           == false)
+        {
+            LOG_INFO("Computation of LocalMultiVector::BlockUpdate() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        LOG_VERBOSE_INFO(2,
+                         "*** warning: LocalMultiVector::BlockUpdate() is performed on the host");
+
+        this->MoveToAccelerator();
+    }
+}
+
+template <typename ValueType>
+void LocalMultiVector<ValueType>::ColumnNorms(ValueType* norms) const
+{
+    log_debug(this, "LocalMultiVector::ColumnNorms()", norms);
+
+    ROCALUTION_TRACE_SCOPE("LocalMultiVector::ColumnNorms", "vector");
+    ROCALUTION_TRACE_COUNT(this->vector_.GetSize() * sizeof(ValueType),
+                           2 * this->vector_.GetSize());
+
+    assert(norms != NULL);
+    assert(this->ncol_ > 0);
+
+    bool err = this->vector_.vector_->BlockNorm(this->ncol_, norms);
+
+    if((err == false) && (this->is_host_() == true))
+    {
+        LOG_INFO("Computation of LocalMultiVector::ColumnNorms() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+
+    if(err == false)
+    {
+        LocalVector<ValueType> host;
+        host.Allocate("host", this->vector_.GetSize());
+        host.CopyFrom(this->vector_);
+
+        if(host.vector_->BlockNorm(this->ncol_, norms) == false)
+        {
+            LOG_INFO("Computation of LocalMultiVector::ColumnNorms() failed");
+            this->Info();
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        LOG_VERBOSE_INFO(2,
+                         "*** warning: LocalMultiVector::ColumnNorms() is performed on the host");
+    }
+}
+
+template <typename ValueType>
+ValueType LocalMultiVector<ValueType>::Norm(void) const
+{
+    log_debug(this, "LocalMultiVector::Norm()");
+
+    return this->vector_.Norm();
+}
+
+template <typename ValueType>
+ValueType LocalMultiVector<ValueType>::Asum(void) const
+{
+    log_debug(this, "LocalMultiVector::Asum()");
+
+    return this->vector_.Asum();
+}
+
+template <typename ValueType>
+int LocalMultiVector<ValueType>::Amax(ValueType& value) const
+{
+    log_debug(this, "LocalMultiVector::Amax()", value);
+
+    return this->vector_.Amax(value);
+}
+
+template class LocalMultiVector<double>;
+template class LocalMultiVector<float>;
+#ifdef SUPPORT_COMPLEX
+template class LocalMultiVector<std::complex<double>>;
+template class LocalMultiVector<std::complex<float>>;
+#endif
+
+} // namespace rocalution
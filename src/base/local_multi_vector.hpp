@@ -0,0 +1,151 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_LOCAL_MULTI_VECTOR_HPP_
+#define ROCALUTION_LOCAL_MULTI_VECTOR_HPP_
+
+#include "../utils/types.hpp"
+#include "base_rocalution.hpp"
+#include "local_vector.hpp"
+
+#include <string>
+
+namespace rocalution {
+
+template <typename ValueType>
+class LocalVector;
+template <typename ValueType>
+class LocalMatrix;
+
+/** \ingroup op_vec_module
+  * \class LocalMultiVector
+  * \brief LocalMultiVector class
+  * \details
+  * A LocalMultiVector holds a block of \p ncol vectors of equal length \p nrow, e.g.
+  * multiple right-hand sides of a linear system. The vectors are stored row-major
+  * interleaved, i.e. entry (i, j) is located at position i * ncol + j. Thus, a sparse
+  * matrix - multi-vector product (SpMM) reads each matrix entry only once for all
+  * columns. Like a LocalVector, a LocalMultiVector will always stay on a single system.
+  *
+  * Small dense matrices, that are passed to or returned by the block operations, are
+  * stored column-major on the host.
+  *
+  * \tparam ValueType - can be float, double, std::complex<float> and
+  *                     std::complex<double>
+  */
+template <typename ValueType>
+class LocalMultiVector : public BaseRocalution<ValueType>
+{
+    public:
+    LocalMultiVector();
+    virtual ~LocalMultiVector();
+
+    virtual void MoveToAccelerator(void);
+    virtual void MoveToHost(void);
+
+    virtual void Info(void) const;
+    virtual void Clear(void);
+
+    /** \brief Allocate a local multi-vector with name, number of rows and columns */
+    void Allocate(std::string name, int nrow, int ncol);
+
+    /** \brief Return the length of the vectors */
+    int GetNumRows(void) const;
+    /** \brief Return the number of vectors */
+    int GetNumCols(void) const;
+
+    /** \brief Set all values to zero */
+    void Zeros(void);
+    /** \brief Set all values to \p val */
+    void SetValues(ValueType val);
+    /** \brief Fill the multi-vector with random values from interval [a,b] */
+    void SetRandomUniform(unsigned long long seed,
+                          ValueType a = static_cast<ValueType>(-1),
+                          ValueType b = static_cast<ValueType>(1));
+
+    /** \brief Copy a multi-vector of the same size */
+    void CopyFrom(const LocalMultiVector<ValueType>& src);
+    /** \brief Clone the multi-vector (backend, size and values) */
+    void CloneFrom(const LocalMultiVector<ValueType>& src);
+
+    /** \brief Access operator for entry (i, j) (only for host data) */
+    ValueType& operator()(int i, int j);
+    /** \brief Access operator for entry (i, j) (only for host data) */
+    const ValueType& operator()(int i, int j) const;
+
+    /** \brief Copy column \p j into \p vec, which is allocated if required */
+    void GetColumn(int j, LocalVector<ValueType>* vec) const;
+    /** \brief Copy \p vec into column \p j */
+    void SetColumn(int j, const LocalVector<ValueType>& vec);
+    /** \brief Set this to the \p ncol columns \p cols of \p x
+      * \details
+      * The multi-vector is (re)allocated to \p x.GetNumRows() x \p ncol. This is used to
+      * deflate converged columns from a block of vectors.
+      */
+    void SelectColumns(const LocalMultiVector<ValueType>& x, int ncol, const int* cols);
+
+    /** \brief Perform this = this + alpha * x */
+    void AddScale(const LocalMultiVector<ValueType>& x, ValueType alpha);
+    /** \brief Perform this = alpha * this + x */
+    void ScaleAdd(ValueType alpha, const LocalMultiVector<ValueType>& x);
+    /** \brief Perform this = alpha * this */
+    void Scale(ValueType alpha);
+
+    /** \brief Compute the block dot product this^H * x
+      * \details
+      * \p result is a column-major \p GetNumCols() x \p x.GetNumCols() host array.
+      */
+    void BlockDot(const LocalMultiVector<ValueType>& x, ValueType* result) const;
+    /** \brief Perform this = beta * this + x * coef
+      * \details
+      * \p coef is a column-major \p x.GetNumCols() x \p GetNumCols() host array. If
+      * \p beta is zero, the previous values of this multi-vector are not read.
+      */
+    void BlockUpdate(ValueType beta, const LocalMultiVector<ValueType>& x, const ValueType* coef);
+    /** \brief Compute the L2 norm of each column into the host array \p norms */
+    void ColumnNorms(ValueType* norms) const;
+
+    /** \brief Compute the Frobenius norm of the multi-vector */
+    ValueType Norm(void) const;
+    /** \brief Compute the sum of absolute values of all entries */
+    ValueType Asum(void) const;
+    /** \brief Compute the absolute max of all entries and return its position */
+    int Amax(ValueType& value) const;
+
+    protected:
+    virtual bool is_host_(void) const;
+    virtual bool is_accel_(void) const;
+
+    private:
+    int nrow_;
+    int ncol_;
+
+    // Row-major interleaved storage of the nrow_ x ncol_ entries
+    LocalVector<ValueType> vector_;
+
+    friend class LocalMatrix<ValueType>;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_LOCAL_MULTI_VECTOR_HPP_
@@ -25,12 +25,17 @@
 #include "local_stencil.hpp"
 #include "local_vector.hpp"
 #include "stencil_types.hpp"
-#include "host/host_stencil_laplace2d.hpp"
+#include "host/host_stencil_general.hpp"
 #include "host/host_vector.hpp"
 
 #include "../utils/log.hpp"
+#include "../utils/trace.hpp"
+#include "../utils/math_functions.hpp"
 
+#include <math.h>
+#include <stdlib.h>
 #include <complex>
+#include <vector>
 
 namespace rocalution {
 
@@ -59,12 +64,62 @@ LocalStencil<ValueType>::LocalStencil(unsigned int type)
 {
     log_debug(this, "LocalStencil::LocalStencil()", type);
 
-    assert(type == Laplace2D); // the only one at the moment
+    assert(type <= GeneralStencil);
 
     this->object_name_ = _stencil_type_names[type];
 
-    this->stencil_host_ = new HostStencilLaplace2D<ValueType>(this->local_backend_);
+    this->stencil_accel_ = NULL;
+
+    this->stencil_host_ = new HostStencilGeneral<ValueType>(this->local_backend_, type);
     this->stencil_      = this->stencil_host_;
+
+    if(type == GeneralStencil)
+    {
+        return;
+    }
+
+    // Laplace stencils, 2D with 5 points and 3D with 7 (faces), 19 (faces and edges) or
+    // 27 points
+    int ndim = (type == Laplace2D) ? 2 : 3;
+
+    std::vector<int> offset(ndim, 0);
+    std::vector<ValueType> coef(1, static_cast<ValueType>(0));
+
+    for(int dz = (ndim == 3) ? -1 : 0; dz <= ((ndim == 3) ? 1 : 0); ++dz)
+    {
+        for(int dy = -1; dy <= 1; ++dy)
+        {
+            for(int dx = -1; dx <= 1; ++dx)
+            {
+                int dist = abs(dx) + abs(dy) + abs(dz);
+
+                if(dist == 0 || ((type == Laplace2D || type == Laplace3D) && dist > 1)
+                   || (type == Laplace3D19 && dist > 2))
+                {
+                    continue;
+                }
+
+                // The 19-point stencil weights the faces twice
+                ValueType val
+                    = static_cast<ValueType>((type == Laplace3D19 && dist == 1) ? -2 : -1);
+
+                offset.push_back(dx);
+                offset.push_back(dy);
+
+                if(ndim == 3)
+                {
+                    offset.push_back(dz);
+                }
+
+                coef.push_back(val);
+
+                // Zero row sum
+                coef[0] -= val;
+            }
+        }
+    }
+
+    this->stencil_->SetStencil(ndim, static_cast<int>(coef.size()), &offset[0], &coef[0]);
 }
 
 template <typename ValueType>
@@ -105,6 +160,12 @@ void LocalStencil<ValueType>::Clear(void)
     this->stencil_->SetGrid(0);
 }
 
+template <typename ValueType>
+int LocalStencil<ValueType>::GetGridSize(int dim) const
+{
+    return this->stencil_->GetGridSize(dim);
+}
+
 template <typename ValueType>
 void LocalStencil<ValueType>::SetGrid(int size)
 {
@@ -115,12 +176,68 @@ void LocalStencil<ValueType>::SetGrid(int size)
     this->stencil_->SetGrid(size);
 }
 
+template <typename ValueType>
+void LocalStencil<ValueType>::SetGrid(int nx, int ny, int nz)
+{
+    log_debug(this, "LocalStencil::SetGrid()", nx, ny, nz);
+
+    assert(nx >= 0);
+    assert(ny >= 0);
+    assert(nz >= 0);
+
+    assert(this->GetNDim() == 3 || nz == 1);
+
+    this->stencil_->SetGrid(nx, ny, nz);
+}
+
+template <typename ValueType>
+void LocalStencil<ValueType>::SetStencil(int ndim,
+                                         int npoint,
+                                         const int* offset,
+                                         const ValueType* coef)
+{
+    log_debug(this, "LocalStencil::SetStencil()", ndim, npoint, offset, coef);
+
+    assert(ndim > 0 && ndim <= 3);
+    assert(npoint > 0);
+    assert(offset != NULL);
+    assert(coef != NULL);
+    assert(this->stencil_->GetStencilId() == GeneralStencil);
+
+    if(this->stencil_->SetStencil(ndim, npoint, offset, coef) == false)
+    {
+        LOG_INFO("Computation of LocalStencil::SetStencil() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+}
+
+template <typename ValueType>
+void LocalStencil<ValueType>::SetCoefficients(const ValueType* coef)
+{
+    log_debug(this, "LocalStencil::SetCoefficients()", coef);
+
+    assert(coef != NULL);
+    assert(this->GetNDim() > 0);
+
+    if(this->stencil_->SetCoefficients(coef) == false)
+    {
+        LOG_INFO("Computation of LocalStencil::SetCoefficients() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+}
+
 template <typename ValueType>
 void LocalStencil<ValueType>::Apply(const LocalVector<ValueType>& in,
                                     LocalVector<ValueType>* out) const
 {
     log_debug(this, "LocalStencil::Apply()", (const void*&)in, out);
 
+    ROCALUTION_TRACE_SCOPE("LocalStencil::Apply", "stencil");
+    ROCALUTION_TRACE_COUNT((2 * this->GetM() + this->GetNnz()) * sizeof(ValueType),
+                           2 * this->GetNnz() * this->GetM());
+
     assert(out != NULL);
 
     assert(((this->stencil_ == this->stencil_host_) && (in.vector_ == in.vector_host_) &&
@@ -138,6 +255,10 @@ void LocalStencil<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
 {
     log_debug(this, "LocalStencil::ApplyAdd()", (const void*&)in, scalar, out);
 
+    ROCALUTION_TRACE_SCOPE("LocalStencil::ApplyAdd", "stencil");
+    ROCALUTION_TRACE_COUNT((3 * this->GetM() + this->GetNnz()) * sizeof(ValueType),
+                           2 * (this->GetNnz() + 1) * this->GetM());
+
     assert(out != NULL);
 
     assert(((this->stencil_ == this->stencil_host_) && (in.vector_ == in.vector_host_) &&
@@ -145,7 +266,165 @@ void LocalStencil<ValueType>::ApplyAdd(const LocalVector<ValueType>& in,
            ((this->stencil_ == this->stencil_accel_) && (in.vector_ == in.vector_accel_) &&
             (out->vector_ == out->vector_accel_)));
 
-    this->stencil_->Apply(*in.vector_, out->vector_);
+    this->stencil_->ApplyAdd(*in.vector_, scalar, out->vector_);
+}
+
+template <typename ValueType>
+void LocalStencil<ValueType>::JacobiSmooth(const LocalVector<ValueType>& rhs,
+                                           LocalVector<ValueType>* x,
+                                           ValueType omega,
+                                           int nsweep) const
+{
+    log_debug(this, "LocalStencil::JacobiSmooth()", (const void*&)rhs, x, omega, nsweep);
+
+    assert(nsweep >= 0);
+
+    std::vector<ValueType> weight(nsweep, omega);
+
+    this->Smooth_(rhs, nsweep, (nsweep > 0) ? &weight[0] : NULL, x);
+}
+
+template <typename ValueType>
+void LocalStencil<ValueType>::ChebyshevSmooth(const LocalVector<ValueType>& rhs,
+                                              LocalVector<ValueType>* x,
+                                              ValueType lambda_min,
+                                              ValueType lambda_max,
+                                              int degree) const
+{
+    log_debug(this,
+              "LocalStencil::ChebyshevSmooth()",
+              (const void*&)rhs,
+              x,
+              lambda_min,
+              lambda_max,
+              degree);
+
+    assert(degree >= 0);
+    assert(rocalution_abs(lambda_max) > rocalution_abs(lambda_min));
+
+    ValueType c = (lambda_max + lambda_min) / static_cast<ValueType>(2);
+    ValueType d = (lambda_max - lambda_min) / static_cast<ValueType>(2);
+
+    // The residual polynomial of degree n vanishes at the Chebyshev nodes, a Jacobi sweep
+    // with the inverse of a node as weight removes the corresponding factor
+    std::vector<ValueType> weight(degree);
+
+    for(int k = 0; k < degree; ++k)
+    {
+        ValueType node = c + d * static_cast<ValueType>(cos(M_PI * (2 * k + 1) / (2 * degree)));
+
+        weight[k] = static_cast<ValueType>(1) / node;
+    }
+
+    this->Smooth_(rhs, degree, (degree > 0) ? &weight[0] : NULL, x);
+}
+
+template <typename ValueType>
+void LocalStencil<ValueType>::Smooth_(const LocalVector<ValueType>& rhs,
+                                      int nsweep,
+                                      const ValueType* omega,
+                                      LocalVector<ValueType>* x) const
+{
+    log_debug(this, "LocalStencil::Smooth_()", (const void*&)rhs, nsweep, omega, x);
+
+    ROCALUTION_TRACE_SCOPE("LocalStencil::Smooth", "stencil");
+    ROCALUTION_TRACE_COUNT((4 * this->GetM() + this->GetNnz()) * sizeof(ValueType),
+                           nsweep * 2 * (this->GetNnz() + 2) * this->GetM());
+
+    assert(x != NULL);
+    assert(rhs.GetSize() == this->GetM());
+    assert(x->GetSize() == this->GetN());
+
+    assert(((this->stencil_ == this->stencil_host_) && (rhs.vector_ == rhs.vector_host_) &&
+            (x->vector_ == x->vector_host_)) ||
+           ((this->stencil_ == this->stencil_accel_) && (rhs.vector_ == rhs.vector_accel_) &&
+            (x->vector_ == x->vector_accel_)));
+
+    if(this->stencil_->Smooth(*rhs.vector_, nsweep, omega, x->vector_) == false)
+    {
+        LOG_INFO("Computation of LocalStencil::Smooth() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+}
+
+template <typename ValueType>
+void LocalStencil<ValueType>::Coarsen(bool galerkin, LocalStencil<ValueType>* coarse) const
+{
+    log_debug(this, "LocalStencil::Coarsen()", galerkin, coarse);
+
+    ROCALUTION_TRACE_SCOPE("LocalStencil::Coarsen", "stencil");
+
+    assert(coarse != NULL);
+    assert(coarse != this);
+    assert(coarse->stencil_->GetStencilId() == GeneralStencil);
+
+    assert(((this->stencil_ == this->stencil_host_) &&
+            (coarse->stencil_ == coarse->stencil_host_)) ||
+           ((this->stencil_ == this->stencil_accel_) &&
+            (coarse->stencil_ == coarse->stencil_accel_)));
+
+    if(this->stencil_->Coarsen(galerkin, coarse->stencil_) == false)
+    {
+        LOG_INFO("Computation of LocalStencil::Coarsen() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+}
+
+template <typename ValueType>
+void LocalStencil<ValueType>::ResidualRestrict(const LocalVector<ValueType>& rhs,
+                                               const LocalVector<ValueType>& x,
+                                               LocalVector<ValueType>* res) const
+{
+    log_debug(this, "LocalStencil::ResidualRestrict()", (const void*&)rhs, (const void*&)x, res);
+
+    ROCALUTION_TRACE_SCOPE("LocalStencil::ResidualRestrict", "stencil");
+    ROCALUTION_TRACE_COUNT(
+        (2 * this->GetM() + this->GetNnz() + res->GetSize()) * sizeof(ValueType),
+        2 * (this->GetNnz() + 2) * this->GetM());
+
+    assert(res != NULL);
+    assert(rhs.GetSize() == this->GetM());
+    assert(x.GetSize() == this->GetN());
+
+    assert(((this->stencil_ == this->stencil_host_) && (rhs.vector_ == rhs.vector_host_) &&
+            (x.vector_ == x.vector_host_) && (res->vector_ == res->vector_host_)) ||
+           ((this->stencil_ == this->stencil_accel_) && (rhs.vector_ == rhs.vector_accel_) &&
+            (x.vector_ == x.vector_accel_) && (res->vector_ == res->vector_accel_)));
+
+    if(this->stencil_->ResidualRestrict(*rhs.vector_, *x.vector_, res->vector_) == false)
+    {
+        LOG_INFO("Computation of LocalStencil::ResidualRestrict() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
+}
+
+template <typename ValueType>
+void LocalStencil<ValueType>::ProlongAdd(const LocalVector<ValueType>& cor,
+                                         LocalVector<ValueType>* x) const
+{
+    log_debug(this, "LocalStencil::ProlongAdd()", (const void*&)cor, x);
+
+    ROCALUTION_TRACE_SCOPE("LocalStencil::ProlongAdd", "stencil");
+    ROCALUTION_TRACE_COUNT((2 * this->GetM() + cor.GetSize()) * sizeof(ValueType),
+                           2 * this->GetM());
+
+    assert(x != NULL);
+    assert(x->GetSize() == this->GetN());
+
+    assert(((this->stencil_ == this->stencil_host_) && (cor.vector_ == cor.vector_host_) &&
+            (x->vector_ == x->vector_host_)) ||
+           ((this->stencil_ == this->stencil_accel_) && (cor.vector_ == cor.vector_accel_) &&
+            (x->vector_ == x->vector_accel_)));
+
+    if(this->stencil_->ProlongAdd(*cor.vector_, x->vector_) == false)
+    {
+        LOG_INFO("Computation of LocalStencil::ProlongAdd() failed");
+        this->Info();
+        FATAL_ERROR(__FILE__, __LINE__);
+    }
 }
 
 template <typename ValueType>
@@ -71,8 +71,58 @@ class LocalStencil : public Operator<ValueType>
     virtual IndexType2 GetN(void) const;
     virtual IndexType2 GetNnz(void) const;
 
-    /** \brief Set the stencil grid size */
+    /** \brief Return the grid size in dimension \p dim (0 = x, 1 = y, 2 = z) */
+    int GetGridSize(int dim) const;
+
+    /** \brief Set the stencil grid size (equal in all dimensions) */
     void SetGrid(int size);
+    /** \brief Set the stencil grid size in each dimension
+      * \details
+      * The grid points are numbered lexicographically, where x is the fastest running
+      * index, i.e. grid point (x, y, z) corresponds to the row (z * ny + y) * nx + x.
+      * For 2D stencils, \p nz has to be 1. Setting the grid removes all variable
+      * coefficients.
+      */
+    void SetGrid(int nx, int ny, int nz = 1);
+
+    /** \brief Set an arbitrary stencil with constant coefficients
+      * \details
+      * \p SetStencil defines a stencil of type \p GeneralStencil by its \p npoint
+      * offsets and coefficients. The offsets of stencil point \p k are stored in
+      * \p offset[k * ndim + d], d = 0, ..., ndim - 1. Stencil points that are outside of
+      * the grid are treated as homogeneous Dirichlet boundary, i.e. they are dropped.
+      *
+      * @param[in]
+      * ndim    dimension of the stencil (1, 2 or 3)
+      * @param[in]
+      * npoint  number of stencil points
+      * @param[in]
+      * offset  array of \p npoint * \p ndim offsets
+      * @param[in]
+      * coef    array of \p npoint coefficients
+      *
+      * \par Example
+      * \code{.cpp}
+      *   // 2D 9-point stencil
+      *   int offset[18]  = {-1, -1, 0, -1, 1, -1, -1, 0, 0, 0, 1, 0, -1, 1, 0, 1, 1, 1};
+      *   double coef[9]  = {-1.0, -1.0, -1.0, -1.0, 8.0, -1.0, -1.0, -1.0, -1.0};
+      *
+      *   LocalStencil<double> stencil(GeneralStencil);
+      *
+      *   stencil.SetStencil(2, 9, offset, coef);
+      *   stencil.SetGrid(100, 200);
+      * \endcode
+      */
+    void SetStencil(int ndim, int npoint, const int* offset, const ValueType* coef);
+
+    /** \brief Set variable coefficients
+      * \details
+      * \p SetCoefficients replaces the constant coefficients of the stencil by a
+      * coefficient per stencil point and grid point. \p coef[k * m + i] is the
+      * coefficient of stencil point \p k in row \p i, where \p m = GetM(). The grid has
+      * to be set before.
+      */
+    void SetCoefficients(const ValueType* coef);
 
     virtual void Clear();
 
@@ -80,6 +130,69 @@ class LocalStencil : public Operator<ValueType>
     virtual void
     ApplyAdd(const LocalVector<ValueType>& in, ValueType scalar, LocalVector<ValueType>* out) const;
 
+    /** \brief Perform damped Jacobi sweeps
+      * \details
+      * \p JacobiSmooth performs \p nsweep iterations of
+      * \f$x = x + \omega D^{-1}(rhs - Ax)\f$, where \f$D\f$ is the diagonal of the
+      * stencil. The sweeps are temporally blocked, i.e. all sweeps are applied to a few
+      * grid planes before moving on, such that the grid is loaded from memory only once.
+      */
+    void JacobiSmooth(const LocalVector<ValueType>& rhs,
+                      LocalVector<ValueType>* x,
+                      ValueType omega,
+                      int nsweep) const;
+
+    /** \brief Perform Jacobi-preconditioned Chebyshev smoothing
+      * \details
+      * \p ChebyshevSmooth applies a Chebyshev polynomial of degree \p degree that damps
+      * the error components corresponding to the eigenvalues of \f$D^{-1}A\f$ in
+      * [\p lambda_min, \p lambda_max]. It is performed as a sequence of Jacobi sweeps
+      * with the inverse Chebyshev nodes as weights, and uses the same temporal blocking
+      * as JacobiSmooth().
+      */
+    void ChebyshevSmooth(const LocalVector<ValueType>& rhs,
+                         LocalVector<ValueType>* x,
+                         ValueType lambda_min,
+                         ValueType lambda_max,
+                         int degree) const;
+
+    /** \brief Build the coarse grid stencil for geometric multigrid
+      * \details
+      * \p Coarsen sets \p coarse to the stencil on the next coarser grid, where each
+      * dimension with \f$n \geq 3\f$ grid points is coarsened to \f$n/2\f$ points and
+      * coarse grid point \f$i\f$ coincides with fine grid point \f$2i+1\f$. If
+      * \p galerkin is true, the coarse stencil is the Galerkin product \f$RAP\f$ of the
+      * full weighting restriction \f$R\f$ and the (bi-, tri-)linear interpolation
+      * \f$P\f$, see ResidualRestrict() and ProlongAdd(). Otherwise, the stencil is
+      * rediscretized on the coarse grid, assuming a second order operator, i.e. the
+      * coefficients are scaled by 1/4 and variable coefficients are injected. The
+      * rediscretization requires all dimensions to be coarsened from an odd number of
+      * grid points, else the Galerkin product is used.
+      *
+      * @param[in]
+      * galerkin    build the Galerkin product or rediscretize
+      * @param[out]
+      * coarse      stencil of type \p GeneralStencil
+      */
+    void Coarsen(bool galerkin, LocalStencil<ValueType>* coarse) const;
+
+    /** \brief Compute and restrict the residual to the coarse grid
+      * \details
+      * \p ResidualRestrict computes \f$res = R(rhs - Ax)\f$, where \f$R\f$ is the full
+      * weighting restriction to the grid of Coarsen(). The fine grid residual is computed
+      * plane by plane and restricted while it is in cache.
+      */
+    void ResidualRestrict(const LocalVector<ValueType>& rhs,
+                          const LocalVector<ValueType>& x,
+                          LocalVector<ValueType>* res) const;
+
+    /** \brief Prolongate and add a coarse grid correction
+      * \details
+      * \p ProlongAdd computes \f$x = x + P cor\f$, where \f$P\f$ is the (bi-, tri-)linear
+      * interpolation from the grid of Coarsen().
+      */
+    void ProlongAdd(const LocalVector<ValueType>& cor, LocalVector<ValueType>* x) const;
+
     virtual void MoveToAccelerator(void);
     virtual void MoveToHost(void);
 
@@ -88,6 +201,12 @@ class LocalStencil : public Operator<ValueType>
     virtual bool is_accel_(void) const { return false; };
 
     private:
+    /** \brief Perform nsweep weighted Jacobi sweeps with weights omega */
+    void Smooth_(const LocalVector<ValueType>& rhs,
+                 int nsweep,
+                 const ValueType* omega,
+                 LocalVector<ValueType>* x) const;
+
     std::string object_name_;
 
     BaseStencil<ValueType>* stencil_;
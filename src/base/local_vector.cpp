@@ -29,6 +29,7 @@
 #include "host/host_vector.hpp"
 #include "backend_manager.hpp"
 #include "../utils/log.hpp"
+#include "../utils/trace.hpp"
 #include "../utils/allocate_free.hpp"
 
 #include <stdlib.h>
@@ -219,6 +220,15 @@ void LocalVector<ValueType>::SetRandomUniform(unsigned long long seed, ValueType
 {
     log_debug(this, "LocalVector::SetRandomUniform()", seed, a, b);
 
+    this->SetRandomUniform_(seed, a, b, 0);
+}
+
+template <typename ValueType>
+void LocalVector<ValueType>::SetRandomUniform_(unsigned long long seed,
+                                               ValueType a,
+                                               ValueType b,
+                                               IndexType2 offset)
+{
     assert(a <= b);
 
     if(this->GetSize() > 0)
@@ -231,7 +241,7 @@ void LocalVector<ValueType>::SetRandomUniform(unsigned long long seed, ValueType
         }
 
         assert(this->vector_ == this->vector_host_);
-        this->vector_host_->SetRandomUniform(seed, a, b);
+        this->vector_host_->SetRandomUniform(seed, a, b, offset);
 
         if(on_host == false)
         {
@@ -248,6 +258,15 @@ void LocalVector<ValueType>::SetRandomNormal(unsigned long long seed, ValueType
 {
     log_debug(this, "LocalVector::SetRandomNormal()", seed, mean, var);
 
+    this->SetRandomNormal_(seed, mean, var, 0);
+}
+
+template <typename ValueType>
+void LocalVector<ValueType>::SetRandomNormal_(unsigned long long seed,
+                                              ValueType mean,
+                                              ValueType var,
+                                              IndexType2 offset)
+{
     if(this->GetSize() > 0)
     {
         // host only
@@ -258,7 +277,7 @@ void LocalVector<ValueType>::SetRandomNormal(unsigned long long seed, ValueType
         }
 
         assert(this->vector_ == this->vector_host_);
-        this->vector_host_->SetRandomNormal(seed, mean, var);
+        this->vector_host_->SetRandomNormal(seed, mean, var, offset);
 
         if(on_host == false)
         {
@@ -275,6 +294,9 @@ void LocalVector<ValueType>::CopyFrom(const LocalVector<ValueType>& src)
 {
     log_debug(this, "LocalVector::CopyFrom()", (const void*&)src);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::CopyFrom", "vector");
+    ROCALUTION_TRACE_COUNT(2 * this->GetSize() * sizeof(ValueType), 0);
+
     assert(this != &src);
 
     this->vector_->CopyFrom(*src.vector_);
@@ -337,6 +359,9 @@ void LocalVector<ValueType>::MoveToAccelerator(void)
 {
     log_debug(this, "LocalVector::MoveToAccelerator()");
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::MoveToAccelerator", "transfer");
+    ROCALUTION_TRACE_COUNT(this->GetSize() * sizeof(ValueType), 0);
+
     if(_rocalution_available_accelerator() == false)
     {
         LOG_VERBOSE_INFO(
@@ -365,6 +390,9 @@ void LocalVector<ValueType>::MoveToHost(void)
 {
     log_debug(this, "LocalVector::MoveToHost()");
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::MoveToHost", "transfer");
+    ROCALUTION_TRACE_COUNT(this->GetSize() * sizeof(ValueType), 0);
+
     if(_rocalution_available_accelerator() == false)
     {
         LOG_VERBOSE_INFO(
@@ -643,6 +671,9 @@ void LocalVector<ValueType>::AddScale(const LocalVector<ValueType>& x, ValueType
 {
     log_debug(this, "LocalVector::AddScale()", (const void*&)x, alpha);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::AddScale", "vector");
+    ROCALUTION_TRACE_COUNT(3 * this->GetSize() * sizeof(ValueType), 2 * this->GetSize());
+
     assert(this->GetSize() == x.GetSize());
     assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)) ||
            ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)));
@@ -658,6 +689,9 @@ void LocalVector<ValueType>::ScaleAdd(ValueType alpha, const LocalVector<ValueTy
 {
     log_debug(this, "LocalVector::ScaleAdd()", alpha, (const void*&)x);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::ScaleAdd", "vector");
+    ROCALUTION_TRACE_COUNT(3 * this->GetSize() * sizeof(ValueType), 2 * this->GetSize());
+
     assert(this->GetSize() == x.GetSize());
     assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)) ||
            ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)));
@@ -675,6 +709,9 @@ void LocalVector<ValueType>::ScaleAddScale(ValueType alpha,
 {
     log_debug(this, "LocalVector::ScaleAddScale()", alpha, (const void*&)x, beta);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::ScaleAddScale", "vector");
+    ROCALUTION_TRACE_COUNT(3 * this->GetSize() * sizeof(ValueType), 3 * this->GetSize());
+
     assert(this->GetSize() == x.GetSize());
     assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)) ||
            ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)));
@@ -702,6 +739,9 @@ void LocalVector<ValueType>::ScaleAddScale(ValueType alpha,
               dst_offset,
               size);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::ScaleAddScale", "vector");
+    ROCALUTION_TRACE_COUNT(3 * size * sizeof(ValueType), 3 * size);
+
     assert((IndexType2)src_offset < x.GetSize());
     assert((IndexType2)dst_offset < this->GetSize());
     assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)) ||
@@ -723,6 +763,9 @@ void LocalVector<ValueType>::ScaleAdd2(ValueType alpha,
     log_debug(
         this, "LocalVector::ScaleAdd2()", alpha, (const void*&)x, beta, (const void*&)y, gamma);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::ScaleAdd2", "vector");
+    ROCALUTION_TRACE_COUNT(4 * this->GetSize() * sizeof(ValueType), 5 * this->GetSize());
+
     assert(this->GetSize() == x.GetSize());
     assert(this->GetSize() == y.GetSize());
     assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_) &&
@@ -741,6 +784,9 @@ void LocalVector<ValueType>::Scale(ValueType alpha)
 {
     log_debug(this, "LocalVector::Scale()", alpha);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::Scale", "vector");
+    ROCALUTION_TRACE_COUNT(2 * this->GetSize() * sizeof(ValueType), this->GetSize());
+
     if(this->GetSize() > 0)
     {
         this->vector_->Scale(alpha);
@@ -752,6 +798,9 @@ ValueType LocalVector<ValueType>::Dot(const LocalVector<ValueType>& x) const
 {
     log_debug(this, "LocalVector::Dot()", (const void*&)x);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::Dot", "vector");
+    ROCALUTION_TRACE_COUNT(2 * this->GetSize() * sizeof(ValueType), 2 * this->GetSize());
+
     assert(this->GetSize() == x.GetSize());
     assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)) ||
            ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)));
@@ -771,6 +820,9 @@ ValueType LocalVector<ValueType>::DotNonConj(const LocalVector<ValueType>& x) co
 {
     log_debug(this, "LocalVector::DotNonConj()", (const void*&)x);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::DotNonConj", "vector");
+    ROCALUTION_TRACE_COUNT(2 * this->GetSize() * sizeof(ValueType), 2 * this->GetSize());
+
     assert(this->GetSize() == x.GetSize());
     assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)) ||
            ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)));
@@ -790,6 +842,9 @@ ValueType LocalVector<ValueType>::Norm(void) const
 {
     log_debug(this, "LocalVector::Norm()");
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::Norm", "vector");
+    ROCALUTION_TRACE_COUNT(this->GetSize() * sizeof(ValueType), 2 * this->GetSize());
+
     if(this->GetSize() > 0)
     {
         return this->vector_->Norm();
@@ -805,6 +860,9 @@ ValueType LocalVector<ValueType>::Reduce(void) const
 {
     log_debug(this, "LocalVector::Reduce()");
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::Reduce", "vector");
+    ROCALUTION_TRACE_COUNT(this->GetSize() * sizeof(ValueType), this->GetSize());
+
     if(this->GetSize() > 0)
     {
         return this->vector_->Reduce();
@@ -820,6 +878,9 @@ ValueType LocalVector<ValueType>::Asum(void) const
 {
     log_debug(this, "LocalVector::Asum()");
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::Asum", "vector");
+    ROCALUTION_TRACE_COUNT(this->GetSize() * sizeof(ValueType), this->GetSize());
+
     if(this->GetSize() > 0)
     {
         return this->vector_->Asum();
@@ -835,6 +896,9 @@ int LocalVector<ValueType>::Amax(ValueType& value) const
 {
     log_debug(this, "LocalVector::Amax()", value);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::Amax", "vector");
+    ROCALUTION_TRACE_COUNT(this->GetSize() * sizeof(ValueType), 0);
+
     if(this->GetSize() > 0)
     {
         return this->vector_->Amax(value);
@@ -851,6 +915,9 @@ void LocalVector<ValueType>::PointWiseMult(const LocalVector<ValueType>& x)
 {
     log_debug(this, "LocalVector::PointWiseMult()", (const void*&)x);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::PointWiseMult", "vector");
+    ROCALUTION_TRACE_COUNT(3 * this->GetSize() * sizeof(ValueType), this->GetSize());
+
     assert(this->GetSize() == x.GetSize());
     assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_)) ||
            ((this->vector_ == this->vector_accel_) && (x.vector_ == x.vector_accel_)));
@@ -867,6 +934,9 @@ void LocalVector<ValueType>::PointWiseMult(const LocalVector<ValueType>& x,
 {
     log_debug(this, "LocalVector::PointWiseMult()", (const void*&)x, (const void*&)y);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::PointWiseMult", "vector");
+    ROCALUTION_TRACE_COUNT(3 * this->GetSize() * sizeof(ValueType), this->GetSize());
+
     assert(this->GetSize() == x.GetSize());
     assert(this->GetSize() == y.GetSize());
     assert(((this->vector_ == this->vector_host_) && (x.vector_ == x.vector_host_) &&
@@ -888,6 +958,9 @@ void LocalVector<ValueType>::CopyFrom(const LocalVector<ValueType>& src,
 {
     log_debug(this, "LocalVector::CopyFrom()", (const void*&)src, src_offset, dst_offset, size);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::CopyFrom", "vector");
+    ROCALUTION_TRACE_COUNT(2 * size * sizeof(ValueType), 0);
+
     assert(&src != this);
     assert((IndexType2)src_offset < src.GetSize());
     assert((IndexType2)dst_offset < this->GetSize());
@@ -1009,6 +1082,8 @@ void LocalVector<ValueType>::Restriction(const LocalVector<ValueType>& vec_fine,
 {
     log_debug(this, "LocalVector::Restriction()", (const void*&)vec_fine, (const void*&)map);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::Restriction", "vector");
+
     assert(&vec_fine != this);
     assert(
         ((this->vector_ == this->vector_host_) && (vec_fine.vector_ == vec_fine.vector_host_)) ||
@@ -1057,6 +1132,8 @@ void LocalVector<ValueType>::Prolongation(const LocalVector<ValueType>& vec_coar
 {
     log_debug(this, "LocalVector::Prolongation()", (const void*&)vec_coarse, (const void*&)map);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::Prolongation", "vector");
+
     assert(&vec_coarse != this);
     assert(((this->vector_ == this->vector_host_) &&
             (vec_coarse.vector_ == vec_coarse.vector_host_)) ||
@@ -1227,12 +1304,53 @@ void LocalVector<ValueType>::Power(double power)
 {
     log_debug(this, "LocalVector::Power()", power);
 
+    ROCALUTION_TRACE_SCOPE("LocalVector::Power", "vector");
+    ROCALUTION_TRACE_COUNT(2 * this->GetSize() * sizeof(ValueType), this->GetSize());
+
     if(this->GetSize() > 0)
     {
         this->vector_->Power(power);
     }
 }
 
+template <typename ValueType>
+void LocalVector<ValueType>::MultiDot(int n,
+                                      const LocalVector<ValueType>* const* x,
+                                      const LocalVector<ValueType>* const* y,
+                                      ValueType* result)
+{
+    ROCALUTION_TRACE_SCOPE("LocalVector::MultiDot", "vector");
+
+    assert(n > 0);
+    assert(x != NULL);
+    assert(y != NULL);
+    assert(result != NULL);
+
+    log_debug(x[0], "LocalVector::MultiDot()", n, x, y, result);
+
+    for(int i = 0; i < n; ++i)
+    {
+        result[i] = x[i]->Dot(*y[i]);
+    }
+}
+
+template <typename ValueType>
+void LocalVector<ValueType>::MultiDotAsync(int n,
+                                           const LocalVector<ValueType>* const* x,
+                                           const LocalVector<ValueType>* const* y,
+                                           ValueType* result)
+{
+    log_debug(this, "LocalVector::MultiDotAsync()", n, x, y, result);
+
+    LocalVector<ValueType>::MultiDot(n, x, y, result);
+}
+
+template <typename ValueType>
+void LocalVector<ValueType>::MultiDotSync(void)
+{
+    log_debug(this, "LocalVector::MultiDotSync()");
+}
+
 template class LocalVector<double>;
 template class LocalVector<float>;
 #ifdef SUPPORT_COMPLEX
@@ -41,6 +41,10 @@ class GlobalMatrix;
 
 template <typename ValueType>
 class LocalStencil;
+template <typename ValueType>
+class LocalCallbackOperator;
+template <typename ValueType>
+class LocalMultiVector;
 
 /** \ingroup op_vec_module
   * \class LocalVector
@@ -271,6 +275,27 @@ class LocalVector : public Vector<ValueType>
     virtual void PointWiseMult(const LocalVector<ValueType>& x, const LocalVector<ValueType>& y);
     virtual void Power(double power);
 
+    /** \brief Compute the dot products of n vector pairs, such that
+      * \p result[i] = \p x[i]->Dot(*\p y[i])
+      */
+    static void MultiDot(int n,
+                         const LocalVector<ValueType>* const* x,
+                         const LocalVector<ValueType>* const* y,
+                         ValueType* result);
+
+    /** \brief Start the computation of the dot products of n vector pairs, such that
+      * \p result[i] = \p x[i]->Dot(*\p y[i])
+      * \details
+      * Local vectors need no reduction, the dot products are computed immediately and
+      * MultiDotSync() returns at once. See GlobalVector::MultiDotAsync().
+      */
+    void MultiDotAsync(int n,
+                       const LocalVector<ValueType>* const* x,
+                       const LocalVector<ValueType>* const* y,
+                       ValueType* result);
+    /** \brief Complete the dot products started by MultiDotAsync() */
+    void MultiDotSync(void);
+
     /** \brief Set index array */
     void SetIndexArray(int size, const int* index);
     /** \brief Get indexed values */
@@ -293,6 +318,13 @@ class LocalVector : public Vector<ValueType>
     virtual bool is_accel_(void) const;
 
     private:
+    /** \brief Fill the vector with random values, where offset is the index of the first
+      * entry within the random stream
+      */
+    void SetRandomUniform_(unsigned long long seed, ValueType a, ValueType b, IndexType2 offset);
+    void
+    SetRandomNormal_(unsigned long long seed, ValueType mean, ValueType var, IndexType2 offset);
+
     // Pointer from the base vector class to the current allocated vector (host_ or accel_)
     BaseVector<ValueType>* vector_;
 
@@ -318,6 +350,9 @@ class LocalVector : public Vector<ValueType>
     friend class LocalStencil<std::complex<double>>;
     friend class LocalStencil<std::complex<float>>;
 
+    friend class LocalCallbackOperator<ValueType>;
+    friend class LocalMultiVector<ValueType>;
+
     friend class GlobalVector<ValueType>;
     friend class LocalMatrix<ValueType>;
     friend class GlobalMatrix<ValueType>;
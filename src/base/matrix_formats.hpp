@@ -29,20 +29,23 @@
 namespace rocalution {
 
 // Matrix Names
-const std::string _matrix_format_names[8] = {
-    "DENSE", "CSR", "MCSR", "BCSR", "COO", "DIA", "ELL", "HYB"};
+const std::string _matrix_format_names[11] = {
+    "DENSE", "CSR", "MCSR", "BCSR", "COO", "DIA", "ELL", "HYB", "SELL", "CCSR", "CCSRBF16"};
 
 // Matrix Enumeration
 enum _matrix_format
 {
-    DENSE = 0,
-    CSR   = 1,
-    MCSR  = 2,
-    BCSR  = 3,
-    COO   = 4,
-    DIA   = 5,
-    ELL   = 6,
-    HYB   = 7
+    DENSE    = 0,
+    CSR      = 1,
+    MCSR     = 2,
+    BCSR     = 3,
+    COO      = 4,
+    DIA      = 5,
+    ELL      = 6,
+    HYB      = 7,
+    SELL     = 8,
+    CCSR     = 9,
+    CCSRBF16 = 10
 };
 
 // Sparse Matrix - Sparse Compressed Row Format CSR
@@ -128,6 +131,54 @@ struct MatrixHYB
     MatrixCOO<ValueType, IndexType> COO;
 };
 
+// Sparse Matrix - Sliced ELL Format SELL-C-sigma (see SELL_IND for indexing)
+template <typename ValueType, typename IndexType>
+struct MatrixSELL
+{
+    // Chunk height C, number of rows that are stored together
+    IndexType chunk_size;
+
+    // Sorting scope sigma, rows are sorted by length within windows of sigma rows
+    IndexType sigma;
+
+    // Chunk offsets into col and val
+    IndexType* chunk_offset;
+
+    // Original row of each slot
+    IndexType* row_perm;
+
+    // Number of non-zero entries of each slot
+    IndexType* row_nnz;
+
+    // Column index
+    IndexType* col;
+
+    // Values
+    ValueType* val;
+};
+
+// Sparse Matrix - Compressed CSR Format CCSR, 16 bit delta encoded column indices and
+// single precision (CCSR) or bfloat16 (CCSRBF16) values
+template <typename ValueType, typename IndexType>
+struct MatrixCCSR
+{
+    // Row offsets (row ptr), including filler entries
+    IndexType* row_offset;
+
+    // Column index of the first entry of each row
+    IndexType* col_base;
+
+    // Column index difference to the previous entry of the row, CCSR_FILLER marks
+    // filler entries with zero value, that bridge larger gaps
+    unsigned short* col_delta;
+
+    // Single precision values (real and imaginary part for complex values)
+    float* val;
+
+    // Bfloat16 values (real and imaginary part for complex values), used instead of val
+    unsigned short* val_bf16;
+};
+
 // Dense Matrix (see DENSE_IND for indexing)
 template <typename ValueType>
 struct MatrixDENSE
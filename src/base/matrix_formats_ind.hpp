@@ -44,4 +44,7 @@
 #define DIA_IND_EL(row, el, nrow, ndiag) (el) + (ndiag) * (row)
 #define DIA_IND(row, el, nrow, ndiag) DIA_IND_ROW(row, el, nrow, ndiag)
 
+// SELL indexing, entries of a chunk are stored column-major
+#define SELL_IND(offset, slot, el, chunk_size) (offset) + (el) * (chunk_size) + (slot)
+
 #endif // ROCALUTION_MATRIX_FORMATS_IND_HPP_
@@ -105,17 +105,14 @@ void ParallelManager::Clear(void)
         this->nsend_ = 0;
     }
 
-    if(this->recv_index_size_ > 0)
+    if(this->send_index_size_ > 0)
     {
         free_host(&this->boundary_index_);
 
-        this->recv_index_size_ = 0;
-    }
-
-    if(this->send_index_size_ > 0)
-    {
         this->send_index_size_ = 0;
     }
+
+    this->recv_index_size_ = 0;
 }
 
 int ParallelManager::GetNumProcs(void) const
@@ -258,7 +255,7 @@ bool ParallelManager::Status(void) const
     if(this->nsend_ > 0 && this->send_offset_index_ == NULL) return false;
     if(this->recv_index_size_ < 0) return false;
     if(this->send_index_size_ < 0) return false;
-    if(this->recv_index_size_ > 0 && this->boundary_index_ == NULL) return false;
+    if(this->send_index_size_ > 0 && this->boundary_index_ == NULL) return false;
     // clang-format on
 
     return true;
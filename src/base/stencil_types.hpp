@@ -29,12 +29,17 @@
 namespace rocalution {
 
 // Stencil Names
-const std::string _stencil_type_names[1] = {"Laplace2D"};
+const std::string _stencil_type_names[5]
+    = {"Laplace2D", "Laplace3D", "Laplace3D19", "Laplace3D27", "GeneralStencil"};
 
 // Stencil Enumeration
 enum _stencil_type
 {
-    Laplace2D = 0
+    Laplace2D      = 0,
+    Laplace3D      = 1,
+    Laplace3D19    = 2,
+    Laplace3D27    = 3,
+    GeneralStencil = 4
 };
 
 } // namespace rocalution
@@ -82,12 +82,21 @@ class Vector : public BaseRocalution<ValueType>
     /** \brief Set all values of the vector to given argument */
     virtual void SetValues(ValueType val) = 0;
 
-    /** \brief Fill the vector with random values from interval [a,b] */
+    /** \brief Fill the vector with random values from interval [a,b]
+      * \details
+      * The values are generated by a counter-based random number generator (Philox), such
+      * that they only depend on the seed and the global index of each entry, but not on
+      * the number of threads or processes.
+      */
     virtual void SetRandomUniform(unsigned long long seed,
                                   ValueType a = static_cast<ValueType>(-1),
                                   ValueType b = static_cast<ValueType>(1)) = 0;
 
-    /** \brief Fill the vector with random values from normal distribution */
+    /** \brief Fill the vector with random values from normal distribution
+      * \details
+      * The values are generated from the stream of SetRandomUniform() by the Box-Muller
+      * transform, with mean and standard deviation var.
+      */
     virtual void SetRandomNormal(unsigned long long seed,
                                  ValueType mean = static_cast<ValueType>(0),
                                  ValueType var = static_cast<ValueType>(1)) = 0;
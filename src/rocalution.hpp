@@ -42,10 +42,14 @@
 
 #include "base/global_vector.hpp"
 #include "base/local_vector.hpp"
+#include "base/local_multi_vector.hpp"
 
 #include "base/local_stencil.hpp"
 #include "base/stencil_types.hpp"
 
+#include "base/global_callback_operator.hpp"
+#include "base/local_callback_operator.hpp"
+
 #include "solvers/solver.hpp"
 #include "solvers/iter_ctrl.hpp"
 #include "solvers/chebyshev.hpp"
@@ -59,9 +63,14 @@
 #include "solvers/krylov/gmres.hpp"
 #include "solvers/krylov/fgmres.hpp"
 #include "solvers/krylov/idr.hpp"
+#include "solvers/krylov/cacg.hpp"
+#include "solvers/krylov/cagmres.hpp"
+#include "solvers/krylov/block_cg.hpp"
+#include "solvers/krylov/block_gmres.hpp"
 #include "solvers/multigrid/base_multigrid.hpp"
 #include "solvers/multigrid/base_amg.hpp"
 #include "solvers/multigrid/multigrid.hpp"
+#include "solvers/multigrid/geometric_multigrid.hpp"
 #include "solvers/multigrid/unsmoothed_amg.hpp"
 #include "solvers/multigrid/smoothed_amg.hpp"
 #include "solvers/multigrid/ruge_stueben_amg.hpp"
@@ -73,6 +82,7 @@
 
 #include "solvers/preconditioners/preconditioner.hpp"
 #include "solvers/preconditioners/preconditioner_blockjacobi.hpp"
+#include "solvers/preconditioners/preconditioner_l1.hpp"
 #include "solvers/preconditioners/preconditioner_ai.hpp"
 #include "solvers/preconditioners/preconditioner_as.hpp"
 #include "solvers/preconditioners/preconditioner_multicolored.hpp"
@@ -83,7 +93,9 @@
 #include "solvers/preconditioners/preconditioner_blockprecond.hpp"
 
 #include "utils/allocate_free.hpp"
+#include "utils/random.hpp"
 #include "utils/time_functions.hpp"
+#include "utils/trace.hpp"
 #include "utils/types.hpp"
 
 #endif // ROCALUTION_ROCALUTION_HPP_
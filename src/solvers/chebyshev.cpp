@@ -24,28 +24,222 @@
 #include "../utils/def.hpp"
 #include "chebyshev.hpp"
 #include "iter_ctrl.hpp"
+#include "preconditioners/preconditioner.hpp"
 
 #include "../base/local_matrix.hpp"
 #include "../base/local_stencil.hpp"
+#include "../base/local_callback_operator.hpp"
 #include "../base/local_vector.hpp"
 
 #include "../base/global_matrix.hpp"
+#include "../base/global_callback_operator.hpp"
 #include "../base/global_vector.hpp"
 
+#include "../utils/allocate_free.hpp"
 #include "../utils/log.hpp"
 #include "../utils/math_functions.hpp"
 
 #include <math.h>
 #include <complex>
+#include <vector>
 
 namespace rocalution {
 
+// Number of eigenvalues of the symmetric tridiagonal matrix (diag, offdiag) that are
+// smaller than x (Sturm sequence)
+static int tridiagonal_eigenvalues_below(const std::vector<double>& diag,
+                                         const std::vector<double>& offdiag,
+                                         double x)
+{
+    int count = 0;
+    double q  = 1.0;
+
+    for(size_t i = 0; i < diag.size(); ++i)
+    {
+        double off = (i > 0) ? offdiag[i - 1] * offdiag[i - 1] : 0.0;
+
+        q = diag[i] - x - ((i > 0) ? off / q : 0.0);
+
+        if(q == 0.0)
+        {
+            q = -1e-300;
+        }
+
+        if(q < 0.0)
+        {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+// Largest eigenvalue of the symmetric tridiagonal matrix (diag, offdiag) by bisection
+static double tridiagonal_max_eigenvalue(const std::vector<double>& diag,
+                                         const std::vector<double>& offdiag)
+{
+    int n = static_cast<int>(diag.size());
+
+    // Gershgorin interval
+    double lower = diag[0];
+    double upper = diag[0];
+
+    for(int i = 0; i < n; ++i)
+    {
+        double radius = ((i > 0) ? fabs(offdiag[i - 1]) : 0.0) +
+                        ((i < n - 1) ? fabs(offdiag[i]) : 0.0);
+
+        lower = (diag[i] - radius < lower) ? diag[i] - radius : lower;
+        upper = (diag[i] + radius > upper) ? diag[i] + radius : upper;
+    }
+
+    for(int k = 0; k < 100 && upper - lower > 1e-12 * fabs(upper); ++k)
+    {
+        double mid = 0.5 * (lower + upper);
+
+        if(tridiagonal_eigenvalues_below(diag, offdiag, mid) == n)
+        {
+            upper = mid;
+        }
+        else
+        {
+            lower = mid;
+        }
+    }
+
+    return upper;
+}
+
+// Add the absolute row sums of mat to sum. If diag is not NULL, the absolute values of the
+// diagonal entries are stored in diag.
+template <typename ValueType>
+static void abs_row_sums(const LocalMatrix<ValueType>& mat,
+                         std::vector<double>& sum,
+                         std::vector<double>* diag)
+{
+    if(mat.GetNnz() == 0)
+    {
+        return;
+    }
+
+    LocalMatrix<ValueType> tmp;
+    tmp.CloneFrom(mat);
+    tmp.MoveToHost();
+    tmp.ConvertToCSR();
+
+    int nrow = tmp.GetM();
+    int nnz  = tmp.GetNnz();
+
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
+
+    allocate_host(nrow + 1, &row_offset);
+    allocate_host(nnz, &col);
+    allocate_host(nnz, &val);
+
+    tmp.CopyToCSR(row_offset, col, val);
+
+    for(int i = 0; i < nrow; ++i)
+    {
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            double a = static_cast<double>(rocalution_abs(val[j]));
+
+            sum[i] += a;
+
+            if(diag != NULL && col[j] == i)
+            {
+                (*diag)[i] = a;
+            }
+        }
+    }
+
+    free_host(&row_offset);
+    free_host(&col);
+    free_host(&val);
+}
+
+// Maximum of the absolute row sums, scaled by the absolute diagonal entries if jacobi is
+// true. This bounds the spectral radius of A or D^-1 A by their infinity norm.
+static double max_scaled_row_sum(const std::vector<double>& sum,
+                                 const std::vector<double>& diag,
+                                 bool jacobi)
+{
+    double bound = 0.0;
+
+    for(size_t i = 0; i < sum.size(); ++i)
+    {
+        double s = (jacobi == true && diag[i] > 0.0) ? sum[i] / diag[i] : sum[i];
+
+        bound = (s > bound) ? s : bound;
+    }
+
+    return bound;
+}
+
+// Bound of the spectral radius of the (Jacobi preconditioned) operator, if its entries are
+// accessible. Returns false otherwise.
+template <class OperatorType, class VectorType>
+static bool
+    spectral_radius_bound(const OperatorType& op, bool jacobi, VectorType* work, double& bound)
+{
+    return false;
+}
+
+template <typename ValueType>
+static bool spectral_radius_bound(const LocalMatrix<ValueType>& op,
+                                  bool jacobi,
+                                  LocalVector<ValueType>* work,
+                                  double& bound)
+{
+    std::vector<double> sum(op.GetM(), 0.0);
+    std::vector<double> diag(op.GetM(), 0.0);
+
+    abs_row_sums(op, sum, &diag);
+
+    bound = max_scaled_row_sum(sum, diag, jacobi);
+
+    return true;
+}
+
+template <typename ValueType>
+static bool spectral_radius_bound(const GlobalMatrix<ValueType>& op,
+                                  bool jacobi,
+                                  GlobalVector<ValueType>* work,
+                                  double& bound)
+{
+    int nrow = op.GetInterior().GetM();
+
+    std::vector<double> sum(nrow, 0.0);
+    std::vector<double> diag(nrow, 0.0);
+
+    abs_row_sums(op.GetInterior(), sum, &diag);
+    abs_row_sums(op.GetGhost(), sum, NULL);
+
+    // The 2-norm of the bounds of all ranks is a common upper bound of their maximum
+    work->Zeros();
+
+    if(nrow > 0)
+    {
+        (*work)[0] = static_cast<ValueType>(max_scaled_row_sum(sum, diag, jacobi));
+    }
+
+    bound = static_cast<double>(rocalution_abs(work->Norm()));
+
+    return true;
+}
+
 template <class OperatorType, class VectorType, typename ValueType>
 Chebyshev<OperatorType, VectorType, ValueType>::Chebyshev()
 {
     log_debug(this, "Chebyshev::Chebyshev()");
 
     this->init_lambda_ = false;
+
+    this->estimate_lambda_ = false;
+    this->estimate_iter_   = 10;
+    this->estimate_ratio_  = static_cast<ValueType>(1);
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -67,6 +261,144 @@ void Chebyshev<OperatorType, VectorType, ValueType>::Set(ValueType lambda_min, V
     this->init_lambda_ = true;
 }
 
+template <class OperatorType, class VectorType, typename ValueType>
+void Chebyshev<OperatorType, VectorType, ValueType>::SetEigenvalueEstimation(int iter,
+                                                                             ValueType ratio)
+{
+    log_debug(this, "Chebyshev::SetEigenvalueEstimation()", iter, ratio);
+
+    assert(iter > 0);
+    assert(rocalution_abs(ratio) >= 1);
+
+    this->estimate_lambda_ = true;
+    this->estimate_iter_   = iter;
+    this->estimate_ratio_  = ratio;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void Chebyshev<OperatorType, VectorType, ValueType>::EstimateEigenvalues_(void)
+{
+    log_debug(this, "Chebyshev::EstimateEigenvalues_()", " #*# begin");
+
+    assert(this->build_ == true);
+
+    // The Lanczos coefficients are obtained from CG iterations with zero initial guess
+    // on a random right-hand side
+    VectorType* r = &this->r_;
+    VectorType* z = (this->precond_ != NULL) ? &this->z_ : &this->r_;
+    VectorType* p = &this->p_;
+
+    VectorType q;
+    q.CloneBackend(*this->op_);
+    q.Allocate("q", this->op_->GetM());
+
+    r->SetRandomUniform(12345ULL, static_cast<ValueType>(-1), static_cast<ValueType>(1));
+
+    if(this->precond_ != NULL)
+    {
+        this->precond_->SolveZeroSol(*r, z);
+    }
+
+    p->CopyFrom(*z);
+
+    ValueType rho = r->Dot(*z);
+
+    std::vector<double> diag;
+    std::vector<double> offdiag;
+
+    double alpha_old = 0.0;
+    double beta_old  = 0.0;
+
+    for(int i = 0; i < this->estimate_iter_; ++i)
+    {
+        // q = Ap
+        this->op_->Apply(*p, &q);
+
+        ValueType pq = p->Dot(q);
+
+        if(pq == static_cast<ValueType>(0))
+        {
+            break;
+        }
+
+        ValueType alpha = rho / pq;
+
+        // Diagonal entry of the Lanczos matrix
+        double a = static_cast<double>(rocalution_abs(alpha));
+
+        diag.push_back(1.0 / a + ((i > 0) ? beta_old / alpha_old : 0.0));
+
+        // r = r - alpha*q
+        r->AddScale(q, -alpha);
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SolveZeroSol(*r, z);
+        }
+
+        ValueType rho_old = rho;
+        rho               = r->Dot(*z);
+
+        // Invariant subspace
+        if(rocalution_abs(rho) <= 1e-12 * rocalution_abs(rho_old) ||
+           i == this->estimate_iter_ - 1)
+        {
+            break;
+        }
+
+        ValueType beta = rho / rho_old;
+
+        // Off-diagonal entry of the Lanczos matrix
+        double b = static_cast<double>(rocalution_abs(beta));
+
+        offdiag.push_back(sqrt(b) / a);
+
+        alpha_old = a;
+        beta_old  = b;
+
+        // p = z + beta*p
+        p->ScaleAdd(beta, *z);
+    }
+
+    double lambda_max;
+
+    if(diag.size() > 0)
+    {
+        lambda_max = 1.1 * tridiagonal_max_eigenvalue(diag, offdiag);
+    }
+    else
+    {
+        // (p,Ap) vanished in the first step, fall back to the infinity norm of the
+        // operator, which bounds its spectral radius
+        bool jacobi = (dynamic_cast<Jacobi<OperatorType, VectorType, ValueType>*>(
+                           this->precond_) != NULL);
+
+        if((this->precond_ != NULL && jacobi == false) ||
+           spectral_radius_bound(*this->op_, jacobi, &q, lambda_max) == false)
+        {
+            LOG_INFO("Chebyshev eigenvalue estimation failed, (p,Ap) = 0 in the first Lanczos "
+                     "step; set the eigenvalues with Set()");
+            FATAL_ERROR(__FILE__, __LINE__);
+        }
+
+        // Nothing to damp for a zero operator
+        if(lambda_max <= 0.0)
+        {
+            lambda_max = 1.0;
+        }
+
+        LOG_INFO("*** warning: Chebyshev eigenvalue estimation broke down, the maximum "
+                 "eigenvalue is bounded by the infinity norm "
+                 << lambda_max);
+    }
+
+    this->lambda_max_  = static_cast<ValueType>(lambda_max);
+    this->lambda_min_  = this->lambda_max_ / this->estimate_ratio_;
+    this->init_lambda_ = true;
+
+    log_debug(this, "Chebyshev::EstimateEigenvalues_()", " #*# end");
+}
+
 template <class OperatorType, class VectorType, typename ValueType>
 void Chebyshev<OperatorType, VectorType, ValueType>::Print(void) const
 {
@@ -140,6 +472,11 @@ void Chebyshev<OperatorType, VectorType, ValueType>::Build(void)
 
     this->p_.CloneBackend(*this->op_);
     this->p_.Allocate("p", this->op_->GetM());
+
+    if(this->estimate_lambda_ == true)
+    {
+        this->EstimateEigenvalues_();
+    }
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -179,13 +516,15 @@ void Chebyshev<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
 
         this->iter_ctrl_.Clear();
 
-        this->build_       = false;
-        this->init_lambda_ = false;
-
         if(this->precond_ != NULL)
         {
             this->precond_->ReBuildNumeric();
         }
+
+        if(this->estimate_lambda_ == true)
+        {
+            this->EstimateEigenvalues_();
+        }
     }
     else
     {
@@ -240,15 +579,25 @@ void Chebyshev<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const Vect
     assert(this->build_ == true);
     assert(this->init_lambda_ == true);
 
+    if(this->iter_ctrl_.GetMaximumIterations() == 0)
+    {
+        log_debug(this, "Chebyshev::SolveNonPrecond_()", " #*# end");
+
+        return;
+    }
+
     const OperatorType* op = this->op_;
 
     VectorType* r = &this->r_;
     VectorType* p = &this->p_;
 
-    ValueType two = static_cast<ValueType>(2);
-    ValueType alpha, beta;
-    ValueType d = (this->lambda_max_ + this->lambda_min_) / two;
-    ValueType c = (this->lambda_max_ - this->lambda_min_) / two;
+    ValueType one   = static_cast<ValueType>(1);
+    ValueType two   = static_cast<ValueType>(2);
+    ValueType d     = (this->lambda_max_ + this->lambda_min_) / two;
+    ValueType c     = (this->lambda_max_ - this->lambda_min_) / two;
+    ValueType sigma = d / c;
+    ValueType rho   = one / sigma;
+    ValueType rho_old;
 
     // initial residual = b - Ax
     op->Apply(*x, r);
@@ -263,13 +612,12 @@ void Chebyshev<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const Vect
         return;
     }
 
-    // p = r
+    // p = r / d
     p->CopyFrom(*r);
+    p->Scale(one / d);
 
-    alpha = two / d;
-
-    // x = x + alpha*p
-    x->AddScale(*p, alpha);
+    // x = x + p
+    x->AddScale(*p, one);
 
     // compute residual = b - Ax
     op->Apply(*x, r);
@@ -278,15 +626,14 @@ void Chebyshev<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const Vect
     res = this->Norm_(*r);
     while(!this->iter_ctrl_.CheckResidual(rocalution_abs(res), this->index_))
     {
-        beta = (c * alpha / two) * (c * alpha / two);
-
-        alpha = static_cast<ValueType>(1) / (d - beta);
+        rho_old = rho;
+        rho     = one / (two * sigma - rho_old);
 
-        // p = beta*p + r
-        p->ScaleAdd(beta, *r);
+        // p = rho*rho_old*p + 2*rho/c*r
+        p->ScaleAddScale(rho * rho_old, *r, two * rho / c);
 
-        // x = x + alpha*p
-        x->AddScale(*p, alpha);
+        // x = x + p
+        x->AddScale(*p, one);
 
         // compute residual = b - Ax
         op->Apply(*x, r);
@@ -310,16 +657,26 @@ void Chebyshev<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorT
     assert(this->build_ == true);
     assert(this->init_lambda_ == true);
 
+    if(this->iter_ctrl_.GetMaximumIterations() == 0)
+    {
+        log_debug(this, "Chebyshev::SolvePrecond_()", " #*# end");
+
+        return;
+    }
+
     const OperatorType* op = this->op_;
 
     VectorType* r = &this->r_;
     VectorType* z = &this->z_;
     VectorType* p = &this->p_;
 
-    ValueType two = static_cast<ValueType>(2);
-    ValueType alpha, beta;
-    ValueType d = (this->lambda_max_ + this->lambda_min_) / two;
-    ValueType c = (this->lambda_max_ - this->lambda_min_) / two;
+    ValueType one   = static_cast<ValueType>(1);
+    ValueType two   = static_cast<ValueType>(2);
+    ValueType d     = (this->lambda_max_ + this->lambda_min_) / two;
+    ValueType c     = (this->lambda_max_ - this->lambda_min_) / two;
+    ValueType sigma = d / c;
+    ValueType rho   = one / sigma;
+    ValueType rho_old;
 
     // initial residual = b - Ax
     op->Apply(*x, r);
@@ -337,13 +694,12 @@ void Chebyshev<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorT
     // Solve Mz=r
     this->precond_->SolveZeroSol(*r, z);
 
-    // p = z
+    // p = z / d
     p->CopyFrom(*z);
+    p->Scale(one / d);
 
-    alpha = two / d;
-
-    // x = x + alpha*p
-    x->AddScale(*p, alpha);
+    // x = x + p
+    x->AddScale(*p, one);
 
     // compute residual = b - Ax
     op->Apply(*x, r);
@@ -355,15 +711,14 @@ void Chebyshev<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorT
         // Solve Mz=r
         this->precond_->SolveZeroSol(*r, z);
 
-        beta = (c * alpha / two) * (c * alpha / two);
-
-        alpha = static_cast<ValueType>(1) / (d - beta);
+        rho_old = rho;
+        rho     = one / (two * sigma - rho_old);
 
-        // p = beta*p + z
-        p->ScaleAdd(beta, *z);
+        // p = rho*rho_old*p + 2*rho/c*z
+        p->ScaleAddScale(rho * rho_old, *z, two * rho / c);
 
-        // x = x + alpha*p
-        x->AddScale(*p, alpha);
+        // x = x + p
+        x->AddScale(*p, one);
 
         // compute residual = b - Ax
         op->Apply(*x, r);
@@ -407,4 +762,26 @@ template class Chebyshev<LocalStencil<std::complex<float>>,
                          std::complex<float>>;
 #endif
 
+template class Chebyshev<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class Chebyshev<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class Chebyshev<LocalCallbackOperator<std::complex<double>>,
+                         LocalVector<std::complex<double>>,
+                         std::complex<double>>;
+template class Chebyshev<LocalCallbackOperator<std::complex<float>>,
+                         LocalVector<std::complex<float>>,
+                         std::complex<float>>;
+#endif
+
+template class Chebyshev<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class Chebyshev<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class Chebyshev<GlobalCallbackOperator<std::complex<double>>,
+                         GlobalVector<std::complex<double>>,
+                         std::complex<double>>;
+template class Chebyshev<GlobalCallbackOperator<std::complex<float>>,
+                         GlobalVector<std::complex<float>>,
+                         std::complex<float>>;
+#endif
+
 } // namespace rocalution
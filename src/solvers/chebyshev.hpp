@@ -38,7 +38,15 @@ namespace rocalution {
   * CG method but requires minimum and maximum eigenvalues of the operator.
   * \cite templates
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * The eigenvalues can either be set by Set() or estimated during Build(), see
+  * SetEigenvalueEstimation(). Since the iteration is composed of operator applications
+  * and vector updates only, it is well suited as a parallel smoother for multigrid
+  * methods, with the Jacobi preconditioner and the upper part of the spectrum of
+  * \f$D^{-1}A\f$ as target interval. As smoother, the number of iterations is the
+  * degree of the Chebyshev polynomial.
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil,
+  *                        LocalCallbackOperator or GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -54,6 +62,21 @@ class Chebyshev : public IterativeLinearSolver<OperatorType, VectorType, ValueTy
     /** \brief Set the minimum and maximum eigenvalues of the operator */
     void Set(ValueType lambda_min, ValueType lambda_max);
 
+    /** \brief Estimate the eigenvalues of the (preconditioned) operator during Build()
+      * \details
+      * The maximum eigenvalue is estimated by a few steps of the Lanczos method on the
+      * preconditioned operator, starting from a random vector, and enlarged by 10%.
+      * The minimum eigenvalue is set to the maximum eigenvalue divided by \p ratio, such
+      * that only the upper part of the spectrum is damped (e.g. for smoothing). The
+      * estimation assumes a symmetric positive definite operator and preconditioner.
+      *
+      * @param[in]
+      * iter    number of Lanczos steps
+      * @param[in]
+      * ratio   ratio of the maximum and the minimum eigenvalue
+      */
+    void SetEigenvalueEstimation(int iter, ValueType ratio);
+
     virtual void Build(void);
     virtual void ReBuildNumeric(void);
     virtual void Clear(void);
@@ -69,9 +92,16 @@ class Chebyshev : public IterativeLinearSolver<OperatorType, VectorType, ValueTy
     virtual void MoveToAcceleratorLocalData_(void);
 
     private:
+    /** \brief Estimate the eigenvalues of the (preconditioned) operator */
+    void EstimateEigenvalues_(void);
+
     bool init_lambda_;
     ValueType lambda_min_, lambda_max_;
 
+    bool estimate_lambda_;
+    int estimate_iter_;
+    ValueType estimate_ratio_;
+
     VectorType r_, z_;
     VectorType p_;
 };
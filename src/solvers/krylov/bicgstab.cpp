@@ -27,9 +27,11 @@
 
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
 
 #include "../../utils/log.hpp"
@@ -520,4 +522,26 @@ template class BiCGStab<LocalStencil<std::complex<float>>,
                         std::complex<float>>;
 #endif
 
+template class BiCGStab<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class BiCGStab<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class BiCGStab<LocalCallbackOperator<std::complex<double>>,
+                        LocalVector<std::complex<double>>,
+                        std::complex<double>>;
+template class BiCGStab<LocalCallbackOperator<std::complex<float>>,
+                        LocalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+template class BiCGStab<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class BiCGStab<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class BiCGStab<GlobalCallbackOperator<std::complex<double>>,
+                        GlobalVector<std::complex<double>>,
+                        std::complex<double>>;
+template class BiCGStab<GlobalCallbackOperator<std::complex<float>>,
+                        GlobalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
 } // namespace rocalution
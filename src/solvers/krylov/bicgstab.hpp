@@ -36,7 +36,8 @@ namespace rocalution {
   * (non) symmetric linear systems \f$Ax=b\f$.
   * \cite SAAD
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil,
+  *                        LocalCallbackOperator or GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -27,9 +27,11 @@
 
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
 
 #include "../../utils/log.hpp"
@@ -714,4 +716,26 @@ template class BiCGStabl<GlobalMatrix<std::complex<float>>,
                          std::complex<float>>;
 #endif
 
+template class BiCGStabl<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class BiCGStabl<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class BiCGStabl<LocalCallbackOperator<std::complex<double>>,
+                         LocalVector<std::complex<double>>,
+                         std::complex<double>>;
+template class BiCGStabl<LocalCallbackOperator<std::complex<float>>,
+                         LocalVector<std::complex<float>>,
+                         std::complex<float>>;
+#endif
+
+template class BiCGStabl<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class BiCGStabl<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class BiCGStabl<GlobalCallbackOperator<std::complex<double>>,
+                         GlobalVector<std::complex<double>>,
+                         std::complex<double>>;
+template class BiCGStabl<GlobalCallbackOperator<std::complex<float>>,
+                         GlobalVector<std::complex<float>>,
+                         std::complex<float>>;
+#endif
+
 } // namespace rocalution
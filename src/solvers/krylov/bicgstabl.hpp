@@ -39,7 +39,8 @@ namespace rocalution {
   * \f$l\f$-dimensional Krylov subspaces. The degree \f$l\f$ can be set with SetOrder().
   * \cite bicgstabl
   *
-  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalCallbackOperator or
+  *                        GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -0,0 +1,632 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "../../utils/def.hpp"
+#include "block_cg.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_multi_vector.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <math.h>
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+namespace rocalution {
+
+// Allocate a block of vectors, if its size differs
+template <class VectorType>
+static void block_resize(VectorType* v, int nrow, int ncol, const std::string& name)
+{
+    if((v->GetNumRows() != nrow) || (v->GetNumCols() != ncol))
+    {
+        v->Allocate(name, nrow, ncol);
+    }
+}
+
+// Keep the columns keep of a block of vectors, using tmp as buffer
+template <class VectorType>
+static void block_select(VectorType* v, VectorType* tmp, const std::vector<int>& keep)
+{
+    tmp->SelectColumns(*v, static_cast<int>(keep.size()), keep.data());
+    v->CloneFrom(*tmp);
+}
+
+// Keep the rows and columns keep of a column-major n x n matrix
+template <typename ValueType>
+static void dense_select(int n, const std::vector<int>& keep, std::vector<ValueType>& A)
+{
+    int m = static_cast<int>(keep.size());
+
+    std::vector<ValueType> B(m * m);
+
+    for(int j = 0; j < m; ++j)
+    {
+        for(int i = 0; i < m; ++i)
+        {
+            B[i + j * m] = A[keep[i] + keep[j] * n];
+        }
+    }
+
+    A.swap(B);
+}
+
+// Maximum absolute value of all entries
+template <typename ValueType>
+static double max_abs(const std::vector<ValueType>& v)
+{
+    double res = 0.0;
+
+    for(size_t i = 0; i < v.size(); ++i)
+    {
+        res = std::max(res, static_cast<double>(rocalution_abs(v[i])));
+    }
+
+    return res;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+BlockCG<OperatorType, VectorType, ValueType>::BlockCG()
+{
+    log_debug(this, "BlockCG::BlockCG()", "default constructor");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+BlockCG<OperatorType, VectorType, ValueType>::~BlockCG()
+{
+    log_debug(this, "BlockCG::~BlockCG()", "destructor");
+
+    this->Clear();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::Print(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("BlockCG solver");
+    }
+    else
+    {
+        LOG_INFO("BlockPCG solver, with preconditioner:");
+        this->precond_->Print();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("BlockCG (non-precond) linear solver starts");
+    }
+    else
+    {
+        LOG_INFO("BlockPCG solver starts, with preconditioner:");
+        this->precond_->Print();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("BlockCG (non-precond) ends");
+    }
+    else
+    {
+        LOG_INFO("BlockPCG ends");
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::Build(void)
+{
+    log_debug(this, "BlockCG::Build()", this->build_, " #*# begin");
+
+    if(this->build_ == true)
+    {
+        this->Clear();
+    }
+
+    assert(this->build_ == false);
+
+    this->build_ = true;
+
+    assert(this->op_ != NULL);
+    assert(this->op_->GetM() == this->op_->GetN());
+    assert(this->op_->GetM() > 0);
+
+    if(this->res_norm_ != 2)
+    {
+        LOG_INFO("BlockCG solver supports only L2 residual norm. The solver is switching to L2 "
+                 "norm");
+        this->res_norm_ = 2;
+    }
+
+    if(this->precond_ != NULL)
+    {
+        this->precond_->SetOperator(*this->op_);
+
+        this->precond_->Build();
+
+        this->z_.CloneBackend(*this->op_);
+    }
+
+    // The work space is allocated in Solve(), as soon as the number of right-hand sides
+    // is known
+    this->r_.CloneBackend(*this->op_);
+    this->x_.CloneBackend(*this->op_);
+    this->rr_.CloneBackend(*this->op_);
+    this->p_.CloneBackend(*this->op_);
+    this->q_.CloneBackend(*this->op_);
+    this->t_.CloneBackend(*this->op_);
+    this->col_.CloneBackend(*this->op_);
+
+    log_debug(this, "BlockCG::Build()", this->build_, " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::Clear(void)
+{
+    log_debug(this, "BlockCG::Clear()", this->build_);
+
+    if(this->build_ == true)
+    {
+        if(this->precond_ != NULL)
+        {
+            this->precond_->Clear();
+            this->precond_ = NULL;
+        }
+
+        this->r_.Clear();
+        this->x_.Clear();
+        this->rr_.Clear();
+        this->z_.Clear();
+        this->p_.Clear();
+        this->q_.Clear();
+        this->t_.Clear();
+        this->col_.Clear();
+
+        this->iter_ctrl_.Clear();
+
+        this->build_ = false;
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+{
+    log_debug(this, "BlockCG::ReBuildNumeric()", this->build_);
+
+    if(this->build_ == true)
+    {
+        this->iter_ctrl_.Clear();
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->ReBuildNumeric();
+        }
+    }
+    else
+    {
+        this->Build();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+{
+    log_debug(this, "BlockCG::MoveToHostLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        this->r_.MoveToHost();
+        this->x_.MoveToHost();
+        this->rr_.MoveToHost();
+        this->p_.MoveToHost();
+        this->q_.MoveToHost();
+        this->t_.MoveToHost();
+        this->col_.MoveToHost();
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.MoveToHost();
+        }
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+{
+    log_debug(this, "BlockCG::MoveToAcceleratorLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        this->r_.MoveToAccelerator();
+        this->x_.MoveToAccelerator();
+        this->rr_.MoveToAccelerator();
+        this->p_.MoveToAccelerator();
+        this->q_.MoveToAccelerator();
+        this->t_.MoveToAccelerator();
+        this->col_.MoveToAccelerator();
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.MoveToAccelerator();
+        }
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::CopyColumn_(const VectorType& src,
+                                                               int c,
+                                                               VectorType* dst,
+                                                               int j)
+{
+    src.GetColumn(c, &this->col_);
+    dst->SetColumn(j, this->col_);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                    VectorType* x)
+{
+    log_debug(this, "BlockCG::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+    assert(x != NULL);
+    assert(x != &rhs);
+    assert(this->op_ != NULL);
+    assert(this->precond_ == NULL);
+    assert(this->build_ == true);
+
+    this->SolveBlock_(rhs, x);
+
+    log_debug(this, "BlockCG::SolveNonPrecond_()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                 VectorType* x)
+{
+    log_debug(this, "BlockCG::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+    assert(x != NULL);
+    assert(x != &rhs);
+    assert(this->op_ != NULL);
+    assert(this->precond_ != NULL);
+    assert(this->build_ == true);
+
+    this->SolveBlock_(rhs, x);
+
+    log_debug(this, "BlockCG::SolvePrecond_()", " #*# end");
+}
+
+// Block CG implementation is based on the algorithm described in
+// 'The block conjugate gradient algorithm and related methods' by D. P. O'Leary,
+// extended by deflation of converged and linearly dependent columns.
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockCG<OperatorType, VectorType, ValueType>::SolveBlock_(const VectorType& rhs,
+                                                               VectorType* x)
+{
+    ROCALUTION_TRACE_SCOPE("BlockCG::Solve", "solver");
+
+    const OperatorType* op = this->op_;
+
+    int nrow = rhs.GetNumRows();
+    int ncol = rhs.GetNumCols();
+
+    assert(nrow == this->op_->GetM());
+    assert(x->GetNumRows() == nrow);
+    assert(x->GetNumCols() == ncol);
+
+    if(ncol == 0)
+    {
+        return;
+    }
+
+    VectorType* r  = &this->r_;
+    VectorType* xa = &this->x_;
+    VectorType* ra = &this->rr_;
+    VectorType* p  = &this->p_;
+    VectorType* q  = &this->q_;
+    VectorType* t  = &this->t_;
+    VectorType* z  = (this->precond_ != NULL) ? &this->z_ : ra;
+
+    ValueType one = static_cast<ValueType>(1);
+
+    // Relative threshold of the Cholesky pivots, below which a column is treated as
+    // linearly dependent on the others
+    double tol = sqrt(static_cast<double>(rocalution_abs(rocalution_eps<ValueType>())));
+
+    // Current residual norm of each column
+    std::vector<ValueType> res(ncol);
+
+    // r = b - Ax
+    block_resize(r, nrow, ncol, "r");
+    op->Apply(*x, r);
+    r->ScaleAdd(-one, rhs);
+
+    r->ColumnNorms(res.data());
+
+    // Initial residual
+    if(this->iter_ctrl_.InitResidual(max_abs(res)) == false)
+    {
+        return;
+    }
+
+    std::vector<int> pending;
+
+    for(int j = 0; j < ncol; ++j)
+    {
+        if(this->iter_ctrl_.CheckResidualNoCount(rocalution_abs(res[j])) == false)
+        {
+            pending.push_back(j);
+        }
+    }
+
+    bool stop  = false;
+    bool first = true;
+
+    // Each pass solves the pending columns as one block; columns that are deferred
+    // during a pass are solved in the next pass
+    while(pending.empty() == false)
+    {
+        if(first == false)
+        {
+            // Residual of the deferred columns
+            op->Apply(*x, r);
+            r->ScaleAdd(-one, rhs);
+        }
+
+        first = false;
+
+        std::vector<int> active = pending;
+        std::vector<int> deferred;
+        std::vector<int> keep;
+
+        int ka   = static_cast<int>(active.size());
+        int iter = 0;
+
+        xa->SelectColumns(*x, ka, active.data());
+        ra->SelectColumns(*r, ka, active.data());
+
+        // z = M^-1 r
+        if(this->precond_ != NULL)
+        {
+            block_resize(z, nrow, ka, "z");
+            this->precond_->SolveZeroSol(*ra, z);
+        }
+
+        // p = z
+        block_resize(p, nrow, ka, "p");
+        p->CopyFrom(*z);
+
+        // rz = r^H z
+        std::vector<ValueType> rz(ka * ka);
+        ra->BlockDot(*z, rz.data());
+
+        std::vector<ValueType> pq;
+        std::vector<ValueType> L;
+        std::vector<ValueType> alpha;
+        std::vector<ValueType> beta;
+        std::vector<ValueType> rz_new(ka * ka);
+        std::vector<ValueType> norms(ka);
+
+        while(true)
+        {
+            // q = Ap
+            block_resize(q, nrow, ka, "q");
+            op->Apply(*p, q);
+
+            // pq = p^H q
+            pq.resize(ka * ka);
+            p->BlockDot(*q, pq.data());
+
+            // Factorize pq, defer columns with linearly dependent search directions
+            L = pq;
+
+            int piv;
+            while((piv = rocalution_cholesky(ka, L.data(), tol)) >= 0)
+            {
+                deferred.push_back(active[piv]);
+                this->CopyColumn_(*xa, piv, x, active[piv]);
+
+                keep.clear();
+                for(int c = 0; c < ka; ++c)
+                {
+                    if(c != piv)
+                    {
+                        keep.push_back(c);
+                    }
+                }
+
+                active.erase(active.begin() + piv);
+
+                if(--ka == 0)
+                {
+                    break;
+                }
+
+                block_select(xa, t, keep);
+                block_select(ra, t, keep);
+                block_select(p, t, keep);
+                block_select(q, t, keep);
+                dense_select(ka + 1, keep, pq);
+                dense_select(ka + 1, keep, rz);
+
+                L = pq;
+            }
+
+            if(ka == 0)
+            {
+                break;
+            }
+
+            // alpha = pq^-1 rz
+            alpha = rz;
+            rocalution_cholesky_solve(ka, L.data(), ka, alpha.data());
+
+            // x = x + p alpha
+            xa->BlockUpdate(one, *p, alpha.data());
+
+            // r = r - q alpha
+            for(int i = 0; i < ka * ka; ++i)
+            {
+                alpha[i] = -alpha[i];
+            }
+
+            ra->BlockUpdate(one, *q, alpha.data());
+
+            ++iter;
+
+            norms.resize(ka);
+            ra->ColumnNorms(norms.data());
+
+            for(int c = 0; c < ka; ++c)
+            {
+                res[active[c]] = norms[c];
+            }
+
+            if(this->iter_ctrl_.CheckResidual(max_abs(res)))
+            {
+                stop = true;
+                break;
+            }
+
+            // Deflate converged columns
+            keep.clear();
+            for(int c = 0; c < ka; ++c)
+            {
+                if(this->iter_ctrl_.CheckResidualNoCount(rocalution_abs(norms[c])))
+                {
+                    this->CopyColumn_(*xa, c, x, active[c]);
+                }
+                else
+                {
+                    keep.push_back(c);
+                }
+            }
+
+            if(static_cast<int>(keep.size()) < ka)
+            {
+                if(keep.empty() == true)
+                {
+                    active.clear();
+                    ka = 0;
+                    break;
+                }
+
+                block_select(xa, t, keep);
+                block_select(ra, t, keep);
+                block_select(p, t, keep);
+                dense_select(ka, keep, rz);
+
+                std::vector<int> active_keep;
+                for(size_t c = 0; c < keep.size(); ++c)
+                {
+                    active_keep.push_back(active[keep[c]]);
+                }
+
+                active.swap(active_keep);
+                ka = static_cast<int>(active.size());
+            }
+
+            // z = M^-1 r
+            if(this->precond_ != NULL)
+            {
+                block_resize(z, nrow, ka, "z");
+                this->precond_->SolveZeroSol(*ra, z);
+            }
+
+            // rz_new = r^H z
+            rz_new.resize(ka * ka);
+            ra->BlockDot(*z, rz_new.data());
+
+            // beta = rz^-1 rz_new, restart the pass with new search directions if the
+            // residuals became linearly dependent
+            L = rz;
+
+            if(rocalution_cholesky(ka, L.data(), tol) >= 0)
+            {
+                deferred.insert(deferred.end(), active.begin(), active.end());
+                break;
+            }
+
+            beta = rz_new;
+            rocalution_cholesky_solve(ka, L.data(), ka, beta.data());
+
+            // p = z + p beta
+            block_resize(t, nrow, ka, "t");
+            t->CopyFrom(*z);
+            t->BlockUpdate(one, *p, beta.data());
+
+            VectorType* tmp = p;
+            p               = t;
+            t               = tmp;
+
+            rz.swap(rz_new);
+        }
+
+        // Write back the remaining columns of the block
+        for(int c = 0; c < ka; ++c)
+        {
+            this->CopyColumn_(*xa, c, x, active[c]);
+        }
+
+        if(stop == true)
+        {
+            break;
+        }
+
+        if((iter == 0) && (deferred.size() == pending.size()))
+        {
+            LOG_INFO("BlockCG breakdown: the search directions of the remaining columns are "
+                     "linearly dependent");
+            break;
+        }
+
+        std::sort(deferred.begin(), deferred.end());
+        pending.swap(deferred);
+    }
+}
+
+template class BlockCG<LocalMatrix<double>, LocalMultiVector<double>, double>;
+template class BlockCG<LocalMatrix<float>, LocalMultiVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class BlockCG<LocalMatrix<std::complex<double>>,
+                       LocalMultiVector<std::complex<double>>,
+                       std::complex<double>>;
+template class BlockCG<LocalMatrix<std::complex<float>>,
+                       LocalMultiVector<std::complex<float>>,
+                       std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,103 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_BLOCK_CG_HPP_
+#define ROCALUTION_KRYLOV_BLOCK_CG_HPP_
+
+#include "../solver.hpp"
+#include "../../base/local_vector.hpp"
+
+#include <vector>
+
+namespace rocalution {
+
+/** \ingroup solver_module
+  * \class BlockCG
+  * \brief Block Conjugate Gradient Method
+  * \details
+  * The Block Conjugate Gradient method solves a symmetric positive definite (SPD)
+  * linear system \f$AX=B\f$ with multiple right-hand sides, that are stored as columns
+  * of a LocalMultiVector. All columns share one block Krylov subspace, such that the
+  * operator is applied to the whole block at once (SpMM), reading each matrix entry
+  * only once per iteration for all right-hand sides.
+  * \cite blockcg
+  *
+  * Each column is checked against the tolerances of the iteration control separately.
+  * Converged columns are deflated, i.e. removed from the block, such that the block
+  * shrinks during the solve. Columns whose search directions become numerically
+  * linearly dependent on the others (e.g. repeated right-hand sides) are deferred and
+  * solved in a subsequent block iteration. The residual reported to the iteration
+  * control is the maximum L2 norm of all column residuals.
+  *
+  * The method can be preconditioned by a solver that operates on LocalMultiVector,
+  * where the approximation should also be SPD.
+  *
+  * \tparam OperatorType - can be LocalMatrix
+  * \tparam VectorType - can be LocalMultiVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+template <class OperatorType, class VectorType, typename ValueType>
+class BlockCG : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+{
+    public:
+    BlockCG();
+    virtual ~BlockCG();
+
+    virtual void Print(void) const;
+
+    virtual void Build(void);
+    virtual void ReBuildNumeric(void);
+    virtual void Clear(void);
+
+    protected:
+    virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+    virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+    virtual void PrintStart_(void) const;
+    virtual void PrintEnd_(void) const;
+
+    virtual void MoveToHostLocalData_(void);
+    virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+    /** \brief Block CG iteration, preconditioned if a preconditioner is set */
+    void SolveBlock_(const VectorType& rhs, VectorType* x);
+
+    /** \brief Copy column \p c of \p src into column \p j of \p dst */
+    void CopyColumn_(const VectorType& src, int c, VectorType* dst, int j);
+
+    // Residual of all columns
+    VectorType r_;
+
+    // Solution, residual and preconditioned residual of the active columns
+    VectorType x_, rr_, z_;
+    // Search directions, their product with the operator and a temporary
+    VectorType p_, q_, t_;
+
+    // Buffer to copy single columns
+    LocalVector<ValueType> col_;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_BLOCK_CG_HPP_
@@ -0,0 +1,826 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "../../utils/def.hpp"
+#include "block_gmres.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_multi_vector.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <math.h>
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+namespace rocalution {
+
+// Allocate a block of vectors, if its size differs
+template <class VectorType>
+static void block_resize(VectorType* v, int nrow, int ncol, const std::string& name)
+{
+    if((v->GetNumRows() != nrow) || (v->GetNumCols() != ncol))
+    {
+        v->Allocate(name, nrow, ncol);
+    }
+}
+
+// Keep the columns keep of a block of vectors, using tmp as buffer
+template <class VectorType>
+static void block_select(VectorType* v, VectorType* tmp, const std::vector<int>& keep)
+{
+    tmp->SelectColumns(*v, static_cast<int>(keep.size()), keep.data());
+    v->CloneFrom(*tmp);
+}
+
+// Maximum absolute value of all entries
+template <typename ValueType>
+static double max_abs(const std::vector<ValueType>& v)
+{
+    double res = 0.0;
+
+    for(size_t i = 0; i < v.size(); ++i)
+    {
+        res = std::max(res, static_cast<double>(rocalution_abs(v[i])));
+    }
+
+    return res;
+}
+
+// Inverse of a column-major upper triangular n x n matrix
+template <typename ValueType>
+static void upper_inverse(int n, const std::vector<ValueType>& R, std::vector<ValueType>& Rinv)
+{
+    Rinv.assign(n * n, static_cast<ValueType>(0));
+
+    for(int i = 0; i < n; ++i)
+    {
+        Rinv[i + i * n] = static_cast<ValueType>(1);
+    }
+
+    rocalution_upper_solve(n, R.data(), n, Rinv.data());
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+BlockGMRES<OperatorType, VectorType, ValueType>::BlockGMRES()
+{
+    log_debug(this, "BlockGMRES::BlockGMRES()", "default constructor");
+
+    this->size_basis_ = 10;
+    this->v_          = NULL;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+BlockGMRES<OperatorType, VectorType, ValueType>::~BlockGMRES()
+{
+    log_debug(this, "BlockGMRES::~BlockGMRES()", "destructor");
+
+    this->Clear();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::Print(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("BlockGMRES solver");
+    }
+    else
+    {
+        LOG_INFO("BlockGMRES solver, with preconditioner:");
+        this->precond_->Print();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("BlockGMRES(" << this->size_basis_ << ") (non-precond) linear solver starts");
+    }
+    else
+    {
+        LOG_INFO("BlockGMRES(" << this->size_basis_ << ") solver starts, with preconditioner:");
+        this->precond_->Print();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("BlockGMRES(" << this->size_basis_ << ") (non-precond) ends");
+    }
+    else
+    {
+        LOG_INFO("BlockGMRES(" << this->size_basis_ << ") ends");
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::Build(void)
+{
+    log_debug(this, "BlockGMRES::Build()", this->build_, " #*# begin");
+
+    if(this->build_ == true)
+    {
+        this->Clear();
+    }
+
+    assert(this->build_ == false);
+    assert(this->op_ != NULL);
+    assert(this->op_->GetM() > 0);
+    assert(this->op_->GetM() == this->op_->GetN());
+    assert(this->size_basis_ > 0);
+
+    if(this->res_norm_ != 2)
+    {
+        LOG_INFO("BlockGMRES solver supports only L2 residual norm. The solver is switching to "
+                 "L2 norm");
+        this->res_norm_ = 2;
+    }
+
+    // The blocks are allocated in Solve(), as soon as the number of right-hand sides is
+    // known
+    this->v_ = new VectorType*[this->size_basis_ + 2];
+
+    for(int i = 0; i < this->size_basis_ + 2; ++i)
+    {
+        this->v_[i] = new VectorType;
+        this->v_[i]->CloneBackend(*this->op_);
+    }
+
+    this->r_.CloneBackend(*this->op_);
+    this->x_.CloneBackend(*this->op_);
+    this->t_.CloneBackend(*this->op_);
+    this->col_.CloneBackend(*this->op_);
+
+    if(this->precond_ != NULL)
+    {
+        this->z_.CloneBackend(*this->op_);
+
+        this->precond_->SetOperator(*this->op_);
+        this->precond_->Build();
+    }
+
+    this->build_ = true;
+
+    log_debug(this, "BlockGMRES::Build()", this->build_, " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::Clear(void)
+{
+    log_debug(this, "BlockGMRES::Clear()", this->build_);
+
+    if(this->build_ == true)
+    {
+        if(this->precond_ != NULL)
+        {
+            this->z_.Clear();
+            this->precond_->Clear();
+            this->precond_ = NULL;
+        }
+
+        for(int i = 0; i < this->size_basis_ + 2; ++i)
+        {
+            this->v_[i]->Clear();
+            delete this->v_[i];
+        }
+
+        delete[] this->v_;
+        this->v_ = NULL;
+
+        this->r_.Clear();
+        this->x_.Clear();
+        this->t_.Clear();
+        this->col_.Clear();
+
+        this->iter_ctrl_.Clear();
+
+        this->build_ = false;
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+{
+    log_debug(this, "BlockGMRES::ReBuildNumeric()", this->build_);
+
+    if(this->build_ == true)
+    {
+        this->iter_ctrl_.Clear();
+
+        if(this->precond_ != NULL)
+        {
+            this->precond_->ReBuildNumeric();
+        }
+    }
+    else
+    {
+        this->Build();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+{
+    log_debug(this, "BlockGMRES::MoveToHostLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        this->r_.MoveToHost();
+        this->x_.MoveToHost();
+        this->t_.MoveToHost();
+        this->col_.MoveToHost();
+
+        for(int i = 0; i < this->size_basis_ + 2; ++i)
+        {
+            this->v_[i]->MoveToHost();
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.MoveToHost();
+        }
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+{
+    log_debug(this, "BlockGMRES::MoveToAcceleratorLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        this->r_.MoveToAccelerator();
+        this->x_.MoveToAccelerator();
+        this->t_.MoveToAccelerator();
+        this->col_.MoveToAccelerator();
+
+        for(int i = 0; i < this->size_basis_ + 2; ++i)
+        {
+            this->v_[i]->MoveToAccelerator();
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.MoveToAccelerator();
+        }
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::SetBasisSize(int size_basis)
+{
+    log_debug(this, "BlockGMRES:SetBasisSize()", size_basis);
+
+    assert(size_basis > 0);
+    assert(this->build_ == false);
+
+    this->size_basis_ = size_basis;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                       VectorType* x)
+{
+    log_debug(this, "BlockGMRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+    assert(x != NULL);
+    assert(x != &rhs);
+    assert(this->op_ != NULL);
+    assert(this->precond_ == NULL);
+    assert(this->build_ == true);
+    assert(this->size_basis_ > 0);
+    assert(this->res_norm_ == 2);
+
+    this->SolveBlock_(rhs, x);
+
+    log_debug(this, "BlockGMRES::SolveNonPrecond_()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                    VectorType* x)
+{
+    log_debug(this, "BlockGMRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+    assert(x != NULL);
+    assert(x != &rhs);
+    assert(this->op_ != NULL);
+    assert(this->precond_ != NULL);
+    assert(this->build_ == true);
+    assert(this->size_basis_ > 0);
+    assert(this->res_norm_ == 2);
+
+    this->SolveBlock_(rhs, x);
+
+    log_debug(this, "BlockGMRES::SolvePrecond_()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+int BlockGMRES<OperatorType, VectorType, ValueType>::CholQR_(VectorType** v,
+                                                             VectorType** w,
+                                                             ValueType* S)
+{
+    int nrow = (*v)->GetNumRows();
+    int k    = (*v)->GetNumCols();
+
+    ValueType zero = static_cast<ValueType>(0);
+
+    // Relative threshold of the Cholesky pivots, below which a column is treated as
+    // linearly dependent on the others
+    double tol = sqrt(static_cast<double>(rocalution_abs(rocalution_eps<ValueType>())));
+
+    std::vector<ValueType> R(k * k);
+    std::vector<ValueType> Rinv;
+
+    // R^H R = v^H v
+    (*v)->BlockDot(**v, R.data());
+
+    int piv = rocalution_cholesky(k, R.data(), tol);
+
+    if(piv >= 0)
+    {
+        return piv;
+    }
+
+    // w = v R^-1
+    upper_inverse(k, R, Rinv);
+
+    block_resize(*w, nrow, k, "w");
+    (*w)->BlockUpdate(zero, **v, Rinv.data());
+
+    std::swap(*v, *w);
+
+    for(int i = 0; i < k * k; ++i)
+    {
+        S[i] = R[i];
+    }
+
+    // Second pass to restore orthogonality, that is lost for ill-conditioned blocks
+    (*v)->BlockDot(**v, R.data());
+
+    if(rocalution_cholesky(k, R.data(), 0.0) < 0)
+    {
+        upper_inverse(k, R, Rinv);
+
+        (*w)->BlockUpdate(zero, **v, Rinv.data());
+
+        std::swap(*v, *w);
+
+        // S = R S
+        for(int j = 0; j < k; ++j)
+        {
+            for(int i = 0; i <= j; ++i)
+            {
+                ValueType sum = zero;
+
+                for(int l = i; l <= j; ++l)
+                {
+                    sum += R[i + l * k] * S[l + j * k];
+                }
+
+                Rinv[i + j * k] = sum;
+            }
+
+            for(int i = j + 1; i < k; ++i)
+            {
+                Rinv[i + j * k] = zero;
+            }
+        }
+
+        for(int i = 0; i < k * k; ++i)
+        {
+            S[i] = Rinv[i];
+        }
+    }
+
+    return -1;
+}
+
+// Block GMRES implementation is based on the block Arnoldi process described in
+// 'Block Krylov space methods for linear systems with multiple right-hand sides' by
+// M. H. Gutknecht, extended by deflation of converged and linearly dependent columns at
+// each restart.
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::SolveBlock_(const VectorType& rhs,
+                                                                  VectorType* x)
+{
+    ROCALUTION_TRACE_SCOPE("BlockGMRES::Solve", "solver");
+
+    const OperatorType* op = this->op_;
+
+    int nrow = rhs.GetNumRows();
+    int ncol = rhs.GetNumCols();
+    int size = this->size_basis_;
+
+    assert(nrow == this->op_->GetM());
+    assert(x->GetNumRows() == nrow);
+    assert(x->GetNumCols() == ncol);
+
+    if(ncol == 0)
+    {
+        return;
+    }
+
+    VectorType** v = this->v_;
+
+    VectorType* r  = &this->r_;
+    VectorType* xa = &this->x_;
+    VectorType* t  = &this->t_;
+    VectorType* z  = (this->precond_ != NULL) ? &this->z_ : r;
+
+    ValueType zero = static_cast<ValueType>(0);
+    ValueType one  = static_cast<ValueType>(1);
+
+    // Current (preconditioned) residual norm of each column
+    std::vector<ValueType> res(ncol);
+
+    bool first = true;
+
+    while(true)
+    {
+        // r = b - Ax
+        block_resize(r, nrow, ncol, "r");
+        op->Apply(*x, r);
+        r->ScaleAdd(-one, rhs);
+
+        // z = M^-1 r
+        if(this->precond_ != NULL)
+        {
+            block_resize(z, nrow, ncol, "z");
+            this->precond_->SolveZeroSol(*r, z);
+        }
+
+        z->ColumnNorms(res.data());
+
+        // Initial residual
+        if(first == true)
+        {
+            if(this->iter_ctrl_.InitResidual(max_abs(res)) == false)
+            {
+                break;
+            }
+
+            first = false;
+        }
+
+        // Deflate converged columns
+        std::vector<int> active;
+
+        for(int j = 0; j < ncol; ++j)
+        {
+            if(this->iter_ctrl_.CheckResidualNoCount(rocalution_abs(res[j])) == false)
+            {
+                active.push_back(j);
+            }
+        }
+
+        int ka = static_cast<int>(active.size());
+
+        if(ka == 0)
+        {
+            break;
+        }
+
+        xa->SelectColumns(*x, ka, active.data());
+        v[0]->SelectColumns(*z, ka, active.data());
+
+        // v_0 S = z, defer columns that are linearly dependent on the others to the next
+        // cycle
+        std::vector<ValueType> S(ka * ka);
+
+        int piv;
+        while((piv = this->CholQR_(&v[0], &v[size + 1], S.data())) >= 0)
+        {
+            std::vector<int> keep;
+            for(int c = 0; c < ka; ++c)
+            {
+                if(c != piv)
+                {
+                    keep.push_back(c);
+                }
+            }
+
+            active.erase(active.begin() + piv);
+
+            if(--ka == 0)
+            {
+                break;
+            }
+
+            block_select(xa, t, keep);
+            block_select(v[0], t, keep);
+            S.resize(ka * ka);
+        }
+
+        if(ka == 0)
+        {
+            LOG_INFO("BlockGMRES breakdown: the residuals of the remaining columns are "
+                     "linearly dependent");
+            break;
+        }
+
+        // Leading dimensions of the block Hessenberg matrix and the right-hand side of
+        // the least squares problem
+        int ldh = (size + 1) * ka;
+
+        std::vector<ValueType> H(ldh * size * ka, zero);
+        std::vector<ValueType> G(ldh * ka, zero);
+        std::vector<ValueType> cs(size * ka * ka);
+        std::vector<ValueType> sn(size * ka * ka);
+        std::vector<ValueType> Hc(ka * ka);
+        std::vector<ValueType> norms(ka);
+
+        // G = [S; 0]
+        for(int c = 0; c < ka; ++c)
+        {
+            for(int i = 0; i < ka; ++i)
+            {
+                G[i + c * ldh] = S[i + c * ka];
+            }
+        }
+
+        bool stop = false;
+
+        // Number of blocks of the basis
+        int nb = 0;
+
+        // Block Arnoldi iteration
+        for(int j = 0; j < size; ++j)
+        {
+            VectorType* w = v[j + 1];
+
+            // w = M^-1 A v_j
+            block_resize(w, nrow, ka, "v");
+
+            if(this->precond_ != NULL)
+            {
+                block_resize(t, nrow, ka, "t");
+                op->Apply(*v[j], t);
+                this->precond_->SolveZeroSol(*t, w);
+            }
+            else
+            {
+                op->Apply(*v[j], w);
+            }
+
+            // Block Gram-Schmidt with reorthogonalization
+            for(int pass = 0; pass < 2; ++pass)
+            {
+                for(int i = 0; i <= j; ++i)
+                {
+                    // Hc = v_i^H w
+                    v[i]->BlockDot(*w, Hc.data());
+
+                    for(int c = 0; c < ka; ++c)
+                    {
+                        for(int l = 0; l < ka; ++l)
+                        {
+                            H[i * ka + l + (j * ka + c) * ldh] += Hc[l + c * ka];
+                            Hc[l + c * ka] = -Hc[l + c * ka];
+                        }
+                    }
+
+                    // w = w - v_i Hc
+                    w->BlockUpdate(one, *v[i], Hc.data());
+                }
+            }
+
+            // v_j+1 H_j+1,j = w, the block is zero at (near) breakdown of the
+            // Krylov subspace
+            bool breakdown = (this->CholQR_(&v[j + 1], &v[size + 1], S.data()) >= 0);
+
+            if(breakdown == false)
+            {
+                for(int c = 0; c < ka; ++c)
+                {
+                    for(int l = 0; l <= c; ++l)
+                    {
+                        H[(j + 1) * ka + l + (j * ka + c) * ldh] = S[l + c * ka];
+                    }
+                }
+            }
+
+            // Apply previous Givens rotations to the new block column and annihilate its
+            // sub-diagonal entries
+            for(int c = 0; c < ka; ++c)
+            {
+                int col = j * ka + c;
+
+                ValueType* h = &H[col * ldh];
+
+                for(int p = 0; p < col; ++p)
+                {
+                    for(int k = 0; k < ka; ++k)
+                    {
+                        int row = p + ka - k;
+                        this->ApplyGivensRotation_(
+                            cs[p * ka + k], sn[p * ka + k], h[row - 1], h[row]);
+                    }
+                }
+
+                for(int k = 0; k < ka; ++k)
+                {
+                    int row = col + ka - k;
+                    int idx = col * ka + k;
+
+                    this->GenerateGivensRotation_(h[row - 1], h[row], cs[idx], sn[idx]);
+                    this->ApplyGivensRotation_(cs[idx], sn[idx], h[row - 1], h[row]);
+
+                    for(int l = 0; l < ka; ++l)
+                    {
+                        this->ApplyGivensRotation_(
+                            cs[idx], sn[idx], G[row - 1 + l * ldh], G[row + l * ldh]);
+                    }
+                }
+            }
+
+            nb = j + 1;
+
+            // The residual estimate is invalid at breakdown, the cycle ends and the true
+            // residual is computed
+            if(breakdown == false)
+            {
+                for(int c = 0; c < ka; ++c)
+                {
+                    double sum = 0.0;
+
+                    for(int l = 0; l < ka; ++l)
+                    {
+                        double val = rocalution_abs(G[nb * ka + l + c * ldh]);
+                        sum += val * val;
+                    }
+
+                    norms[c]       = static_cast<ValueType>(sqrt(sum));
+                    res[active[c]] = norms[c];
+                }
+            }
+
+            if(this->iter_ctrl_.CheckResidual(max_abs(res)))
+            {
+                stop = true;
+                break;
+            }
+
+            if(breakdown == true)
+            {
+                break;
+            }
+
+            // End the cycle, if all active columns converged
+            bool converged = true;
+
+            for(int c = 0; c < ka; ++c)
+            {
+                if(this->iter_ctrl_.CheckResidualNoCount(rocalution_abs(norms[c])) == false)
+                {
+                    converged = false;
+                    break;
+                }
+            }
+
+            if(converged == true)
+            {
+                break;
+            }
+        }
+
+        // Solve the upper triangular system R Y = G
+        int n = nb * ka;
+
+        std::vector<ValueType> R(n * n);
+        std::vector<ValueType> Y(n * ka);
+
+        for(int c = 0; c < n; ++c)
+        {
+            for(int i = 0; i <= c; ++i)
+            {
+                R[i + c * n] = H[i + c * ldh];
+            }
+        }
+
+        for(int c = 0; c < ka; ++c)
+        {
+            for(int i = 0; i < n; ++i)
+            {
+                Y[i + c * n] = G[i + c * ldh];
+            }
+        }
+
+        rocalution_upper_solve(n, R.data(), ka, Y.data());
+
+        // x = x + sum_i v_i Y_i
+        for(int i = 0; i < nb; ++i)
+        {
+            for(int c = 0; c < ka; ++c)
+            {
+                for(int l = 0; l < ka; ++l)
+                {
+                    Hc[l + c * ka] = Y[i * ka + l + c * n];
+                }
+            }
+
+            xa->BlockUpdate(one, *v[i], Hc.data());
+        }
+
+        // Write back the active columns
+        for(int c = 0; c < ka; ++c)
+        {
+            xa->GetColumn(c, &this->col_);
+            x->SetColumn(active[c], this->col_);
+        }
+
+        if(stop == true)
+        {
+            break;
+        }
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::GenerateGivensRotation_(ValueType dx,
+                                                                              ValueType dy,
+                                                                              ValueType& c,
+                                                                              ValueType& s) const
+{
+    ValueType zero = static_cast<ValueType>(0);
+    ValueType one  = static_cast<ValueType>(1);
+
+    double ax = static_cast<double>(rocalution_abs(dx));
+    double ay = static_cast<double>(rocalution_abs(dy));
+
+    if(ay == 0.0)
+    {
+        c = one;
+        s = zero;
+    }
+    else if(ax == 0.0)
+    {
+        c = zero;
+        s = one;
+    }
+    else
+    {
+        // c is real, s carries the phases of dx and dy
+        double nrm = std::max(ax, ay);
+        nrm *= sqrt((ax / nrm) * (ax / nrm) + (ay / nrm) * (ay / nrm));
+
+        c = static_cast<ValueType>(ax / nrm);
+        s = dx / static_cast<ValueType>(ax) * rocalution_conj(dy) / static_cast<ValueType>(nrm);
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BlockGMRES<OperatorType, VectorType, ValueType>::ApplyGivensRotation_(ValueType c,
+                                                                           ValueType s,
+                                                                           ValueType& dx,
+                                                                           ValueType& dy) const
+{
+    ValueType temp = dx;
+    dx             = c * dx + s * dy;
+    dy             = -rocalution_conj(s) * temp + c * dy;
+}
+
+template class BlockGMRES<LocalMatrix<double>, LocalMultiVector<double>, double>;
+template class BlockGMRES<LocalMatrix<float>, LocalMultiVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class BlockGMRES<LocalMatrix<std::complex<double>>,
+                          LocalMultiVector<std::complex<double>>,
+                          std::complex<double>>;
+template class BlockGMRES<LocalMatrix<std::complex<float>>,
+                          LocalMultiVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+} // namespace rocalution
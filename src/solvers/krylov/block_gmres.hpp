@@ -0,0 +1,120 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_KRYLOV_BLOCK_GMRES_HPP_
+#define ROCALUTION_KRYLOV_BLOCK_GMRES_HPP_
+
+#include "../solver.hpp"
+#include "../../base/local_vector.hpp"
+
+#include <vector>
+
+namespace rocalution {
+
+/** \ingroup solver_module
+  * \class BlockGMRES
+  * \brief Block Generalized Minimum Residual Method
+  * \details
+  * The Block GMRES method solves a (non) symmetric linear system \f$AX=B\f$ with
+  * multiple right-hand sides, that are stored as columns of a LocalMultiVector. The
+  * solution is approximated in a restarted block Krylov subspace, that is shared by all
+  * right-hand sides. The block Arnoldi process applies the operator to whole blocks
+  * (SpMM) and orthonormalizes each new block by block Gram-Schmidt followed by a
+  * Cholesky QR factorization.
+  * \cite blockkrylov
+  *
+  * Each column is checked against the tolerances of the iteration control separately.
+  * Converged columns are deflated at every restart, such that the block size shrinks
+  * during the solve. Columns of the initial residual block that are numerically
+  * linearly dependent on the others (e.g. repeated right-hand sides) are deferred to the
+  * next restart cycle. The residual reported to the iteration control is the maximum L2
+  * norm of all (preconditioned) column residuals.
+  *
+  * The number of blocks of the Krylov subspace basis can be set using SetBasisSize().
+  * The default size is 10 blocks. The method can be (left) preconditioned by a solver
+  * that operates on LocalMultiVector.
+  *
+  * \tparam OperatorType - can be LocalMatrix
+  * \tparam VectorType - can be LocalMultiVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+template <class OperatorType, class VectorType, typename ValueType>
+class BlockGMRES : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+{
+    public:
+    BlockGMRES();
+    virtual ~BlockGMRES();
+
+    virtual void Print(void) const;
+
+    virtual void Build(void);
+    virtual void ReBuildNumeric(void);
+    virtual void Clear(void);
+
+    /** \brief Set the number of blocks of the Krylov subspace basis */
+    virtual void SetBasisSize(int size_basis);
+
+    protected:
+    virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+    virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+    virtual void PrintStart_(void) const;
+    virtual void PrintEnd_(void) const;
+
+    virtual void MoveToHostLocalData_(void);
+    virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+    /** \brief Block GMRES cycles, preconditioned if a preconditioner is set */
+    void SolveBlock_(const VectorType& rhs, VectorType* x);
+
+    /** \brief Orthonormalize the block \p *v by Cholesky QR, such that v = Q * S
+      * \details
+      * Q is computed into \p *w and the two pointers are swapped. Returns the first
+      * linearly dependent column, leaving \p *v untouched, or -1 on success.
+      */
+    int CholQR_(VectorType** v, VectorType** w, ValueType* S);
+
+    /** \brief Generate complex Givens rotation, that annihilates \p dy */
+    void GenerateGivensRotation_(ValueType dx, ValueType dy, ValueType& c, ValueType& s) const;
+    /** \brief Apply complex Givens rotation */
+    void ApplyGivensRotation_(ValueType c, ValueType s, ValueType& dx, ValueType& dy) const;
+
+    // Residual (and preconditioned residual) of all columns
+    VectorType r_, z_;
+
+    // Solution of the active columns and a temporary
+    VectorType x_, t_;
+
+    // Krylov subspace basis, followed by a spare block used as buffer
+    VectorType** v_;
+
+    // Buffer to copy single columns
+    LocalVector<ValueType> col_;
+
+    int size_basis_;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_BLOCK_GMRES_HPP_
@@ -0,0 +1,993 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "../../utils/def.hpp"
+#include "cacg.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../base/matrix_formats_ind.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <math.h>
+#include <complex>
+#include <vector>
+
+namespace rocalution {
+
+// vec = sum_i coef[i] * basis[i]
+template <class VectorType, typename ValueType>
+static void basis_combination(int n, VectorType** basis, const ValueType* coef, VectorType* vec)
+{
+    vec->Zeros();
+
+    for(int i = 0; i < n; ++i)
+    {
+        if(coef[i] != static_cast<ValueType>(0))
+        {
+            vec->AddScale(*basis[i], coef[i]);
+        }
+    }
+}
+
+// Returns v^H G w for the n x n matrix G
+template <typename ValueType>
+static ValueType gram_product(int n, const ValueType* G, const ValueType* v, const ValueType* w)
+{
+    ValueType res = static_cast<ValueType>(0);
+
+    for(int j = 0; j < n; ++j)
+    {
+        ValueType tmp = static_cast<ValueType>(0);
+
+        for(int i = 0; i < n; ++i)
+        {
+            tmp += rocalution_conj(v[i]) * G[DENSE_IND(i, j, n, n)];
+        }
+
+        res += tmp * w[j];
+    }
+
+    return res;
+}
+
+template <typename ValueType>
+void ca_basis_coefficients(unsigned int basis,
+                           int length,
+                           ValueType lambda_min,
+                           ValueType lambda_max,
+                           ValueType* theta,
+                           ValueType* gamma,
+                           ValueType* sigma)
+{
+    assert(length > 0);
+    assert(theta != NULL);
+    assert(gamma != NULL);
+    assert(sigma != NULL);
+
+    ValueType zero = static_cast<ValueType>(0);
+    ValueType one  = static_cast<ValueType>(1);
+    ValueType two  = static_cast<ValueType>(2);
+
+    ValueType center = (lambda_max + lambda_min) / two;
+    ValueType radius = (lambda_max - lambda_min) / two;
+
+    if(rocalution_abs(radius) == 0.0)
+    {
+        radius = one;
+    }
+
+    for(int j = 0; j < length; ++j)
+    {
+        theta[j] = zero;
+        gamma[j] = one;
+        sigma[j] = zero;
+    }
+
+    if(basis == NewtonBasis)
+    {
+        // Leja ordered Chebyshev points of the spectral interval as shifts
+        std::vector<ValueType> points(length);
+        std::vector<bool> used(length, false);
+
+        for(int j = 0; j < length; ++j)
+        {
+            double angle = M_PI * (2 * j + 1) / (2 * length);
+            points[j]    = center + radius * static_cast<ValueType>(cos(angle));
+        }
+
+        for(int j = 0; j < length; ++j)
+        {
+            int next     = -1;
+            double max_p = -1.0;
+
+            for(int k = 0; k < length; ++k)
+            {
+                if(used[k] == true)
+                {
+                    continue;
+                }
+
+                double prod = (j == 0) ? rocalution_abs(points[k]) : 1.0;
+
+                for(int l = 0; l < j; ++l)
+                {
+                    prod *= rocalution_abs(points[k] - theta[l]);
+                }
+
+                if(prod > max_p)
+                {
+                    max_p = prod;
+                    next  = k;
+                }
+            }
+
+            used[next] = true;
+            theta[j]   = points[next];
+            gamma[j]   = radius / two;
+        }
+    }
+    else if(basis == ChebyshevBasis)
+    {
+        // Scaled and shifted Chebyshev polynomials of the first kind
+        for(int j = 0; j < length; ++j)
+        {
+            theta[j] = center;
+            gamma[j] = (j == 0) ? radius : radius / two;
+            sigma[j] = (j == 0) ? zero : radius / two;
+        }
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+CACG<OperatorType, VectorType, ValueType>::CACG()
+{
+    log_debug(this, "CACG::CACG()", "default constructor");
+
+    this->y_  = NULL;
+    this->yh_ = NULL;
+
+    this->G_    = NULL;
+    this->Gh_   = NULL;
+    this->B_    = NULL;
+    this->dots_ = NULL;
+
+    this->theta_ = NULL;
+    this->gamma_ = NULL;
+    this->sigma_ = NULL;
+
+    this->step_size_ = 4;
+    this->basis_     = MonomialBasis;
+
+    this->init_lambda_ = false;
+    this->lambda_min_  = static_cast<ValueType>(0);
+    this->lambda_max_  = static_cast<ValueType>(0);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+CACG<OperatorType, VectorType, ValueType>::~CACG()
+{
+    log_debug(this, "CACG::~CACG()", "destructor");
+
+    this->Clear();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::Print(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("CACG(" << this->step_size_ << ") solver");
+    }
+    else
+    {
+        LOG_INFO("PCACG(" << this->step_size_ << ") solver, with preconditioner:");
+        this->precond_->Print();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("CACG(" << this->step_size_ << ") (non-precond) linear solver starts");
+    }
+    else
+    {
+        LOG_INFO("PCACG(" << this->step_size_ << ") solver starts, with preconditioner:");
+        this->precond_->Print();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("CACG(" << this->step_size_ << ") (non-precond) ends");
+    }
+    else
+    {
+        LOG_INFO("PCACG(" << this->step_size_ << ") ends");
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::SetStepSize(int step_size)
+{
+    log_debug(this, "CACG::SetStepSize()", step_size);
+
+    assert(step_size > 0);
+    assert(this->build_ == false);
+
+    this->step_size_ = step_size;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::SetBasis(unsigned int basis)
+{
+    log_debug(this, "CACG::SetBasis()", basis);
+
+    assert(basis == MonomialBasis || basis == NewtonBasis || basis == ChebyshevBasis);
+    assert(this->build_ == false);
+
+    this->basis_ = basis;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::SetSpectralBounds(ValueType lambda_min,
+                                                                  ValueType lambda_max)
+{
+    log_debug(this, "CACG::SetSpectralBounds()", lambda_min, lambda_max);
+
+    assert(rocalution_abs(lambda_min) <= rocalution_abs(lambda_max));
+    assert(this->build_ == false);
+
+    this->lambda_min_  = lambda_min;
+    this->lambda_max_  = lambda_max;
+    this->init_lambda_ = true;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::Build(void)
+{
+    log_debug(this, "CACG::Build()", this->build_, " #*# begin");
+
+    if(this->build_ == true)
+    {
+        this->Clear();
+    }
+
+    assert(this->build_ == false);
+    assert(this->op_ != NULL);
+    assert(this->op_->GetM() == this->op_->GetN());
+    assert(this->op_->GetM() > 0);
+    assert(this->step_size_ > 0);
+
+    if(this->basis_ != MonomialBasis && this->init_lambda_ == false)
+    {
+        LOG_INFO("CACG solver requires spectral bounds for the Newton and Chebyshev basis. The "
+                 "solver is switching to the monomial basis");
+        this->basis_ = MonomialBasis;
+    }
+
+    int size = 2 * this->step_size_ + 1;
+
+    allocate_host(size * size, &this->G_);
+    allocate_host(size * size, &this->B_);
+    allocate_host(size * (size + 1), &this->dots_);
+
+    allocate_host(this->step_size_, &this->theta_);
+    allocate_host(this->step_size_, &this->gamma_);
+    allocate_host(this->step_size_, &this->sigma_);
+
+    this->y_ = new VectorType*[size];
+
+    for(int i = 0; i < size; ++i)
+    {
+        this->y_[i] = new VectorType;
+        this->y_[i]->CloneBackend(*this->op_);
+        this->y_[i]->Allocate("y", this->op_->GetM());
+    }
+
+    if(this->precond_ != NULL)
+    {
+        this->precond_->SetOperator(*this->op_);
+        this->precond_->Build();
+
+        allocate_host(size * size, &this->Gh_);
+
+        this->yh_ = new VectorType*[size];
+
+        for(int i = 0; i < size; ++i)
+        {
+            this->yh_[i] = new VectorType;
+            this->yh_[i]->CloneBackend(*this->op_);
+            this->yh_[i]->Allocate("yh", this->op_->GetM());
+        }
+    }
+
+    this->r_.CloneBackend(*this->op_);
+    this->r_.Allocate("r", this->op_->GetM());
+
+    this->p_.CloneBackend(*this->op_);
+    this->p_.Allocate("p", this->op_->GetM());
+
+    this->BuildBasisCoefficients_();
+
+    this->build_ = true;
+
+    log_debug(this, "CACG::Build()", this->build_, " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::Clear(void)
+{
+    log_debug(this, "CACG::Clear()", this->build_);
+
+    if(this->build_ == true)
+    {
+        int size = 2 * this->step_size_ + 1;
+
+        if(this->precond_ != NULL)
+        {
+            for(int i = 0; i < size; ++i)
+            {
+                this->yh_[i]->Clear();
+                delete this->yh_[i];
+            }
+            delete[] this->yh_;
+            this->yh_ = NULL;
+
+            free_host(&this->Gh_);
+
+            this->precond_->Clear();
+            this->precond_ = NULL;
+        }
+
+        for(int i = 0; i < size; ++i)
+        {
+            this->y_[i]->Clear();
+            delete this->y_[i];
+        }
+        delete[] this->y_;
+        this->y_ = NULL;
+
+        free_host(&this->G_);
+        free_host(&this->B_);
+        free_host(&this->dots_);
+
+        free_host(&this->theta_);
+        free_host(&this->gamma_);
+        free_host(&this->sigma_);
+
+        this->r_.Clear();
+        this->p_.Clear();
+
+        this->iter_ctrl_.Clear();
+
+        this->build_ = false;
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+{
+    log_debug(this, "CACG::ReBuildNumeric()", this->build_);
+
+    if(this->build_ == true)
+    {
+        int size = 2 * this->step_size_ + 1;
+
+        for(int i = 0; i < size; ++i)
+        {
+            this->y_[i]->Zeros();
+        }
+
+        this->r_.Zeros();
+        this->p_.Zeros();
+
+        this->iter_ctrl_.Clear();
+
+        if(this->precond_ != NULL)
+        {
+            for(int i = 0; i < size; ++i)
+            {
+                this->yh_[i]->Zeros();
+            }
+
+            this->precond_->ReBuildNumeric();
+        }
+    }
+    else
+    {
+        this->Build();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+{
+    log_debug(this, "CACG::MoveToHostLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        int size = 2 * this->step_size_ + 1;
+
+        for(int i = 0; i < size; ++i)
+        {
+            this->y_[i]->MoveToHost();
+        }
+
+        this->r_.MoveToHost();
+        this->p_.MoveToHost();
+
+        if(this->precond_ != NULL)
+        {
+            for(int i = 0; i < size; ++i)
+            {
+                this->yh_[i]->MoveToHost();
+            }
+
+            this->precond_->MoveToHost();
+        }
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+{
+    log_debug(this, "CACG::MoveToAcceleratorLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        int size = 2 * this->step_size_ + 1;
+
+        for(int i = 0; i < size; ++i)
+        {
+            this->y_[i]->MoveToAccelerator();
+        }
+
+        this->r_.MoveToAccelerator();
+        this->p_.MoveToAccelerator();
+
+        if(this->precond_ != NULL)
+        {
+            for(int i = 0; i < size; ++i)
+            {
+                this->yh_[i]->MoveToAccelerator();
+            }
+
+            this->precond_->MoveToAccelerator();
+        }
+    }
+}
+
+// The basis vectors satisfy the three-term recurrence
+//   A y_j = gamma_j y_j+1 + theta_j y_j + sigma_j y_j-1
+// and B holds these coefficients for the p (columns 0 to s) and the r (columns s+1 to 2s)
+// part of the basis, such that A Y = Y B for all but the last column of each part.
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::BuildBasisCoefficients_(void)
+{
+    log_debug(this, "CACG::BuildBasisCoefficients_()");
+
+    int s    = this->step_size_;
+    int size = 2 * s + 1;
+
+    ca_basis_coefficients(this->basis_,
+                          s,
+                          this->lambda_min_,
+                          this->lambda_max_,
+                          this->theta_,
+                          this->gamma_,
+                          this->sigma_);
+
+    set_to_zero_host(size * size, this->B_);
+
+    for(int part = 0; part < 2; ++part)
+    {
+        int offset = (part == 0) ? 0 : s + 1;
+        int length = (part == 0) ? s : s - 1;
+
+        for(int j = 0; j < length; ++j)
+        {
+            int col = offset + j;
+
+            this->B_[DENSE_IND(col + 1, col, size, size)] = this->gamma_[j];
+            this->B_[DENSE_IND(col, col, size, size)]     = this->theta_[j];
+
+            if(j > 0)
+            {
+                this->B_[DENSE_IND(col - 1, col, size, size)] = this->sigma_[j];
+            }
+        }
+    }
+}
+
+// Generates y_offset+1, ..., y_offset+length from y_offset. With a preconditioner, the
+// basis of M^-1 A is generated, together with yh = M y.
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::GenerateBasis_(int offset, int length)
+{
+    log_debug(this, "CACG::GenerateBasis_()", offset, length);
+
+    VectorType** y  = this->y_;
+    VectorType** yh = (this->precond_ != NULL) ? this->yh_ : this->y_;
+
+    ValueType one = static_cast<ValueType>(1);
+
+    for(int j = 0; j < length; ++j)
+    {
+        int col = offset + j;
+
+        // yh_j+1 = (A y_j - theta_j yh_j - sigma_j yh_j-1) / gamma_j
+        this->op_->Apply(*y[col], yh[col + 1]);
+
+        if(this->theta_[j] != static_cast<ValueType>(0))
+        {
+            yh[col + 1]->AddScale(*yh[col], -this->theta_[j]);
+        }
+
+        if(j > 0 && this->sigma_[j] != static_cast<ValueType>(0))
+        {
+            yh[col + 1]->AddScale(*yh[col - 1], -this->sigma_[j]);
+        }
+
+        if(this->gamma_[j] != one)
+        {
+            yh[col + 1]->Scale(one / this->gamma_[j]);
+        }
+
+        // y_j+1 = M^-1 yh_j+1
+        if(this->precond_ != NULL)
+        {
+            this->precond_->SolveZeroSol(*yh[col + 1], y[col + 1]);
+        }
+    }
+}
+
+// Computes the columns [col_begin, col_end) of G = Yh^H Y and, if requested, of
+// Gh = Yh^H Yh with a single reduction. The dot products of the column pairs are stored
+// consecutively in dots_. An asynchronous reduction is attached to p and completed by
+// p.MultiDotSync()
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::ComputeGramMatrix_(int col_begin,
+                                                                   int col_end,
+                                                                   bool residual_gram,
+                                                                   bool async)
+{
+    log_debug(this, "CACG::ComputeGramMatrix_()", col_begin, col_end, residual_gram, async);
+
+    assert(col_begin < col_end);
+
+    VectorType** y  = this->y_;
+    VectorType** yh = (this->precond_ != NULL) ? this->yh_ : this->y_;
+
+    // Number of dot products per pair
+    int m = (residual_gram == true) ? 2 : 1;
+
+    int begin = m * col_begin * (col_begin + 1) / 2;
+    int ndots = m * col_end * (col_end + 1) / 2 - begin;
+
+    std::vector<const VectorType*> left(ndots);
+    std::vector<const VectorType*> right(ndots);
+
+    int k = 0;
+    for(int j = col_begin; j < col_end; ++j)
+    {
+        for(int i = 0; i <= j; ++i)
+        {
+            left[k]  = yh[i];
+            right[k] = y[j];
+
+            if(residual_gram == true)
+            {
+                left[k + 1]  = yh[i];
+                right[k + 1] = yh[j];
+            }
+
+            k += m;
+        }
+    }
+
+    if(async == true)
+    {
+        this->p_.MultiDotAsync(ndots, &left[0], &right[0], this->dots_ + begin);
+    }
+    else
+    {
+        VectorType::MultiDot(ndots, &left[0], &right[0], this->dots_ + begin);
+    }
+}
+
+// Fills G and, if requested, Gh from the reduced dot products
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::AssembleGramMatrix_(bool residual_gram)
+{
+    log_debug(this, "CACG::AssembleGramMatrix_()", residual_gram);
+
+    const ValueType* dots = this->dots_;
+
+    int size = 2 * this->step_size_ + 1;
+    int m    = (residual_gram == true) ? 2 : 1;
+
+    // Both Gram matrices are hermitian
+    int k = 0;
+    for(int j = 0; j < size; ++j)
+    {
+        for(int i = 0; i <= j; ++i)
+        {
+            this->G_[DENSE_IND(i, j, size, size)] = dots[k];
+            this->G_[DENSE_IND(j, i, size, size)] = rocalution_conj(dots[k]);
+
+            if(residual_gram == true)
+            {
+                this->Gh_[DENSE_IND(i, j, size, size)] = dots[k + 1];
+                this->Gh_[DENSE_IND(j, i, size, size)] = rocalution_conj(dots[k + 1]);
+            }
+
+            k += m;
+        }
+    }
+}
+
+// Performs the outer iterations, starting from the residual r and the search direction
+// p (with preconditioner, p holds M times the search direction). The s inner CG steps of
+// each outer iteration operate on the coordinates of p, r and the solution update in the
+// basis Y.
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::SolveSteps_(VectorType* x)
+{
+    log_debug(this, "CACG::SolveSteps_()", x);
+
+    bool precond = (this->precond_ != NULL);
+
+    VectorType** y  = this->y_;
+    VectorType** yh = (precond == true) ? this->yh_ : this->y_;
+
+    VectorType* r = &this->r_;
+    VectorType* p = &this->p_;
+
+    int s    = this->step_size_;
+    int size = 2 * s + 1;
+
+    // The residual norm is obtained from the Gram matrices for the L2 norm only
+    bool l2 = (this->res_norm_ == 2);
+
+    const ValueType* G  = this->G_;
+    const ValueType* Gh = (precond == true) ? this->Gh_ : this->G_;
+
+    ValueType zero = static_cast<ValueType>(0);
+    ValueType one  = static_cast<ValueType>(1);
+
+    std::vector<ValueType> pc(size);
+    std::vector<ValueType> rc(size);
+    std::vector<ValueType> xc(size);
+    std::vector<ValueType> bp(size);
+
+    while(true)
+    {
+        // Krylov basis of p and r. With preconditioner, both starting vectors are
+        // recomputed from their M-images, such that the rounding errors in y = M^-1 yh
+        // do not accumulate over the outer iterations
+        if(precond == true)
+        {
+            this->precond_->SolveZeroSol(*p, y[0]);
+            this->precond_->SolveZeroSol(*r, y[s + 1]);
+
+            yh[0]->CopyFrom(*p);
+            yh[s + 1]->CopyFrom(*r);
+        }
+        else
+        {
+            y[0]->CopyFrom(*p);
+            y[s + 1]->CopyFrom(*r);
+        }
+
+        // The Gram matrix entries of the basis of p are reduced while the basis of r is
+        // generated, only the remaining entries wait for their reduction
+        this->GenerateBasis_(0, s);
+        this->ComputeGramMatrix_(0, s + 1, precond && l2, true);
+
+        this->GenerateBasis_(s + 1, s - 1);
+        this->ComputeGramMatrix_(s + 1, size, precond && l2, false);
+
+        p->MultiDotSync();
+        this->AssembleGramMatrix_(precond && l2);
+
+        // Coordinates of p, r and x in the basis
+        for(int i = 0; i < size; ++i)
+        {
+            pc[i] = zero;
+            rc[i] = zero;
+            xc[i] = zero;
+        }
+
+        pc[0]     = one;
+        rc[s + 1] = one;
+
+        // rho = (r,z)
+        ValueType rho = gram_product(size, G, &rc[0], &rc[0]);
+
+        bool converged = false;
+
+        for(int j = 0; j < s; ++j)
+        {
+            // bp = B pc, the coordinates of (M^-1) A p
+            for(int i = 0; i < size; ++i)
+            {
+                bp[i] = zero;
+            }
+
+            for(int l = 0; l < size; ++l)
+            {
+                if(pc[l] != zero)
+                {
+                    for(int i = 0; i < size; ++i)
+                    {
+                        bp[i] += this->B_[DENSE_IND(i, l, size, size)] * pc[l];
+                    }
+                }
+            }
+
+            // alpha = rho / (p,Ap)
+            ValueType alpha = rho / gram_product(size, G, &pc[0], &bp[0]);
+
+            // x = x + alpha * p
+            // r = r - alpha * Ap
+            for(int i = 0; i < size; ++i)
+            {
+                xc[i] += alpha * pc[i];
+                rc[i] -= alpha * bp[i];
+            }
+
+            ValueType rho_old = rho;
+            rho               = gram_product(size, G, &rc[0], &rc[0]);
+
+            // Check convergence
+            ValueType res_norm;
+
+            if(l2 == true)
+            {
+                res_norm = sqrt(rocalution_abs(gram_product(size, Gh, &rc[0], &rc[0])));
+            }
+            else
+            {
+                basis_combination(size, yh, &rc[0], r);
+                res_norm = this->Norm_(*r);
+            }
+
+            if(this->iter_ctrl_.CheckResidual(rocalution_abs(res_norm), this->index_))
+            {
+                converged = true;
+                break;
+            }
+
+            // p = r + beta * p
+            ValueType beta = rho / rho_old;
+
+            for(int i = 0; i < size; ++i)
+            {
+                pc[i] = rc[i] + beta * pc[i];
+            }
+        }
+
+        // Update solution
+        for(int i = 0; i < size; ++i)
+        {
+            if(xc[i] != zero)
+            {
+                x->AddScale(*y[i], xc[i]);
+            }
+        }
+
+        if(converged == true)
+        {
+            break;
+        }
+
+        // Recover p and r from their coordinates
+        basis_combination(size, yh, &pc[0], p);
+        basis_combination(size, yh, &rc[0], r);
+    }
+}
+
+// CA-CG implementation is based on the algorithm described in
+// 'Communication-Avoiding Krylov Subspace Methods in Theory and Practice' by E. Carson,
+// PhD thesis, UC Berkeley 2015, and modified to fit rocalution structures.
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                 VectorType* x)
+{
+    log_debug(this, "CACG::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+    assert(x != NULL);
+    assert(x != &rhs);
+    assert(this->op_ != NULL);
+    assert(this->precond_ == NULL);
+    assert(this->build_ == true);
+
+    const OperatorType* op = this->op_;
+
+    VectorType* r = &this->r_;
+    VectorType* p = &this->p_;
+
+    // Initial residual = b - Ax
+    op->Apply(*x, r);
+    r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+    // Initial residual norm |b-Ax0|
+    ValueType res_norm = this->Norm_(*r);
+
+    if(this->iter_ctrl_.InitResidual(rocalution_abs(res_norm)) == false)
+    {
+        log_debug(this, "CACG::SolveNonPrecond_()", " #*# end");
+        return;
+    }
+
+    // p = r
+    p->CopyFrom(*r);
+
+    this->SolveSteps_(x);
+
+    log_debug(this, "CACG::SolveNonPrecond_()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CACG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs, VectorType* x)
+{
+    log_debug(this, "CACG::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+    assert(x != NULL);
+    assert(x != &rhs);
+    assert(this->op_ != NULL);
+    assert(this->precond_ != NULL);
+    assert(this->build_ == true);
+
+    const OperatorType* op = this->op_;
+
+    VectorType* r = &this->r_;
+    VectorType* p = &this->p_;
+
+    // Initial residual = b - Ax
+    op->Apply(*x, r);
+    r->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+    // Initial residual norm |b-Ax0|
+    ValueType res_norm = this->Norm_(*r);
+
+    if(this->iter_ctrl_.InitResidual(rocalution_abs(res_norm)) == false)
+    {
+        log_debug(this, "CACG::SolvePrecond_()", " #*# end");
+        return;
+    }
+
+    // The search direction is M^-1 r, p holds its M-image
+    p->CopyFrom(*r);
+
+    this->SolveSteps_(x);
+
+    log_debug(this, "CACG::SolvePrecond_()", " #*# end");
+}
+
+template void ca_basis_coefficients(unsigned int basis,
+                                    int length,
+                                    double lambda_min,
+                                    double lambda_max,
+                                    double* theta,
+                                    double* gamma,
+                                    double* sigma);
+template void ca_basis_coefficients(unsigned int basis,
+                                    int length,
+                                    float lambda_min,
+                                    float lambda_max,
+                                    float* theta,
+                                    float* gamma,
+                                    float* sigma);
+#ifdef SUPPORT_COMPLEX
+template void ca_basis_coefficients(unsigned int basis,
+                                    int length,
+                                    std::complex<double> lambda_min,
+                                    std::complex<double> lambda_max,
+                                    std::complex<double>* theta,
+                                    std::complex<double>* gamma,
+                                    std::complex<double>* sigma);
+template void ca_basis_coefficients(unsigned int basis,
+                                    int length,
+                                    std::complex<float> lambda_min,
+                                    std::complex<float> lambda_max,
+                                    std::complex<float>* theta,
+                                    std::complex<float>* gamma,
+                                    std::complex<float>* sigma);
+#endif
+
+template class CACG<LocalMatrix<double>, LocalVector<double>, double>;
+template class CACG<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CACG<LocalMatrix<std::complex<double>>,
+                    LocalVector<std::complex<double>>,
+                    std::complex<double>>;
+template class CACG<LocalMatrix<std::complex<float>>,
+                    LocalVector<std::complex<float>>,
+                    std::complex<float>>;
+#endif
+
+template class CACG<GlobalMatrix<double>, GlobalVector<double>, double>;
+template class CACG<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CACG<GlobalMatrix<std::complex<double>>,
+                    GlobalVector<std::complex<double>>,
+                    std::complex<double>>;
+template class CACG<GlobalMatrix<std::complex<float>>,
+                    GlobalVector<std::complex<float>>,
+                    std::complex<float>>;
+#endif
+
+template class CACG<LocalStencil<double>, LocalVector<double>, double>;
+template class CACG<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CACG<LocalStencil<std::complex<double>>,
+                    LocalVector<std::complex<double>>,
+                    std::complex<double>>;
+template class CACG<LocalStencil<std::complex<float>>,
+                    LocalVector<std::complex<float>>,
+                    std::complex<float>>;
+#endif
+
+template class CACG<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class CACG<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CACG<LocalCallbackOperator<std::complex<double>>,
+                    LocalVector<std::complex<double>>,
+                    std::complex<double>>;
+template class CACG<LocalCallbackOperator<std::complex<float>>,
+                    LocalVector<std::complex<float>>,
+                    std::complex<float>>;
+#endif
+
+template class CACG<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class CACG<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CACG<GlobalCallbackOperator<std::complex<double>>,
+                    GlobalVector<std::complex<double>>,
+                    std::complex<double>>;
+template class CACG<GlobalCallbackOperator<std::complex<float>>,
+                    GlobalVector<std::complex<float>>,
+                    std::complex<float>>;
+#endif
+
+} // namespace rocalution
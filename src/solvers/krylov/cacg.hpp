@@ -0,0 +1,147 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_KRYLOV_CACG_HPP_
+#define ROCALUTION_KRYLOV_CACG_HPP_
+
+#include "../solver.hpp"
+
+#include <vector>
+
+namespace rocalution {
+
+enum _ca_basis
+{
+    MonomialBasis  = 0,
+    NewtonBasis    = 1,
+    ChebyshevBasis = 2
+};
+
+/** \brief Compute the three-term recurrence coefficients
+  * \f$A y_{j} = \gamma_{j} y_{j+1} + \theta_{j} y_{j} + \sigma_{j} y_{j-1}\f$ of the
+  * first \p length vectors of a communication-avoiding Krylov basis
+  */
+template <typename ValueType>
+void ca_basis_coefficients(unsigned int basis,
+                           int length,
+                           ValueType lambda_min,
+                           ValueType lambda_max,
+                           ValueType* theta,
+                           ValueType* gamma,
+                           ValueType* sigma);
+
+/** \ingroup solver_module
+  * \class CACG
+  * \brief Communication-Avoiding Conjugate Gradient Method
+  * \details
+  * The Communication-Avoiding Conjugate Gradient method (s-step CG) is mathematically
+  * equivalent to the CG method, but performs \f$s\f$ iterations per global reduction.
+  * Each outer iteration generates a basis of the Krylov subspaces
+  * \f$\mathcal{K}_{s+1}(p, A)\f$ and \f$\mathcal{K}_{s}(r, A)\f$ and computes their
+  * Gram matrix with a single blocking global reduction, the entries of the first basis
+  * are reduced in the background while the second basis is generated. The following
+  * \f$s\f$ CG steps are then performed on the coordinates of the vectors in this basis
+  * without further communication. The method can be preconditioned, where the
+  * approximation should also be SPD.
+  * \cite Carson2015
+  *
+  * The number of steps per outer iteration can be set using SetStepSize(). The default
+  * is 4. Large step sizes may affect the numerical stability of the monomial basis.
+  * The Newton and the Chebyshev basis are better conditioned, but require bounds of the
+  * spectrum of the (preconditioned) operator, see SetSpectralBounds().
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil,
+  *                        LocalCallbackOperator or GlobalCallbackOperator
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+template <class OperatorType, class VectorType, typename ValueType>
+class CACG : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+{
+    public:
+    CACG();
+    virtual ~CACG();
+
+    virtual void Print(void) const;
+
+    virtual void Build(void);
+    virtual void ReBuildNumeric(void);
+    virtual void Clear(void);
+
+    /** \brief Set the number of steps per outer iteration */
+    void SetStepSize(int step_size);
+    /** \brief Set the polynomial basis of the Krylov subspaces
+      * \details
+      * \p basis can be MonomialBasis, NewtonBasis or ChebyshevBasis.
+      */
+    void SetBasis(unsigned int basis);
+    /** \brief Set the bounds of the spectrum of the (preconditioned) operator, used by
+      * the Newton and the Chebyshev basis
+      */
+    void SetSpectralBounds(ValueType lambda_min, ValueType lambda_max);
+
+    protected:
+    virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+    virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+    virtual void PrintStart_(void) const;
+    virtual void PrintEnd_(void) const;
+
+    virtual void MoveToHostLocalData_(void);
+    virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+    void BuildBasisCoefficients_(void);
+    void GenerateBasis_(int offset, int length);
+    void ComputeGramMatrix_(int col_begin, int col_end, bool residual_gram, bool async);
+    void AssembleGramMatrix_(bool residual_gram);
+    void SolveSteps_(VectorType* x);
+
+    VectorType** y_;
+    VectorType** yh_;
+
+    VectorType r_;
+    VectorType p_;
+
+    ValueType* G_;
+    ValueType* Gh_;
+    ValueType* B_;
+
+    // Reduced dot products of the Gram matrices
+    ValueType* dots_;
+
+    ValueType* theta_;
+    ValueType* gamma_;
+    ValueType* sigma_;
+
+    int step_size_;
+    unsigned int basis_;
+
+    bool init_lambda_;
+    ValueType lambda_min_, lambda_max_;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_CACG_HPP_
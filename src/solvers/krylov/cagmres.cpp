@@ -0,0 +1,914 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "../../utils/def.hpp"
+#include "cagmres.hpp"
+#include "../iter_ctrl.hpp"
+
+#include "../../base/local_matrix.hpp"
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
+#include "../../base/global_vector.hpp"
+
+#include "../../base/matrix_formats_ind.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <math.h>
+#include <complex>
+#include <vector>
+
+namespace rocalution {
+
+template <class OperatorType, class VectorType, typename ValueType>
+CAGMRES<OperatorType, VectorType, ValueType>::CAGMRES()
+{
+    log_debug(this, "CAGMRES::CAGMRES()", "default constructor");
+
+    this->size_basis_ = 30;
+    this->step_size_  = 4;
+    this->basis_      = MonomialBasis;
+
+    this->v_ = NULL;
+
+    this->c_  = NULL;
+    this->s_  = NULL;
+    this->r_  = NULL;
+    this->H_  = NULL;
+    this->HR_ = NULL;
+
+    this->theta_ = NULL;
+    this->gamma_ = NULL;
+    this->sigma_ = NULL;
+
+    this->init_lambda_ = false;
+    this->lambda_min_  = static_cast<ValueType>(0);
+    this->lambda_max_  = static_cast<ValueType>(0);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+CAGMRES<OperatorType, VectorType, ValueType>::~CAGMRES()
+{
+    log_debug(this, "CAGMRES::~CAGMRES()", "destructor");
+
+    this->Clear();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::Print(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("CAGMRES(" << this->size_basis_ << ", " << this->step_size_ << ") solver");
+    }
+    else
+    {
+        LOG_INFO("CAGMRES(" << this->size_basis_ << ", " << this->step_size_
+                            << ") solver, with preconditioner:");
+        this->precond_->Print();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("CAGMRES(" << this->size_basis_ << ", " << this->step_size_
+                            << ") (non-precond) linear solver starts");
+    }
+    else
+    {
+        LOG_INFO("CAGMRES(" << this->size_basis_ << ", " << this->step_size_
+                            << ") solver starts, with preconditioner:");
+        this->precond_->Print();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+{
+    if(this->precond_ == NULL)
+    {
+        LOG_INFO("CAGMRES(" << this->size_basis_ << ", " << this->step_size_
+                            << ") (non-precond) ends");
+    }
+    else
+    {
+        LOG_INFO("CAGMRES(" << this->size_basis_ << ", " << this->step_size_ << ") ends");
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::Build(void)
+{
+    log_debug(this, "CAGMRES::Build()", this->build_, " #*# begin");
+
+    if(this->build_ == true)
+    {
+        this->Clear();
+    }
+
+    assert(this->build_ == false);
+    assert(this->op_ != NULL);
+    assert(this->op_->GetM() > 0);
+    assert(this->op_->GetM() == this->op_->GetN());
+    assert(this->size_basis_ > 0);
+    assert(this->step_size_ > 0);
+
+    if(this->res_norm_ != 2)
+    {
+        LOG_INFO(
+            "CAGMRES solver supports only L2 residual norm. The solver is switching to L2 norm");
+        this->res_norm_ = 2;
+    }
+
+    if(this->basis_ != MonomialBasis && this->init_lambda_ == false)
+    {
+        LOG_INFO("CAGMRES solver requires spectral bounds for the Newton and Chebyshev basis. "
+                 "The solver is switching to the monomial basis");
+        this->basis_ = MonomialBasis;
+    }
+
+    allocate_host(this->size_basis_, &this->c_);
+    allocate_host(this->size_basis_, &this->s_);
+    allocate_host(this->size_basis_ + 1, &this->r_);
+    allocate_host((this->size_basis_ + 1) * this->size_basis_, &this->H_);
+    allocate_host((this->size_basis_ + 1) * this->size_basis_, &this->HR_);
+
+    allocate_host(this->step_size_, &this->theta_);
+    allocate_host(this->step_size_, &this->gamma_);
+    allocate_host(this->step_size_, &this->sigma_);
+
+    ca_basis_coefficients(this->basis_,
+                          this->step_size_,
+                          this->lambda_min_,
+                          this->lambda_max_,
+                          this->theta_,
+                          this->gamma_,
+                          this->sigma_);
+
+    this->v_ = new VectorType*[this->size_basis_ + 1];
+
+    for(int i = 0; i < this->size_basis_ + 1; ++i)
+    {
+        this->v_[i] = new VectorType;
+        this->v_[i]->CloneBackend(*this->op_);
+        this->v_[i]->Allocate("v", this->op_->GetM());
+    }
+
+    if(this->precond_ != NULL)
+    {
+        this->z_.CloneBackend(*this->op_);
+        this->z_.Allocate("z", this->op_->GetM());
+
+        this->precond_->SetOperator(*this->op_);
+        this->precond_->Build();
+    }
+
+    this->build_ = true;
+
+    log_debug(this, "CAGMRES::Build()", this->build_, " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::Clear(void)
+{
+    log_debug(this, "CAGMRES::Clear()", this->build_);
+
+    if(this->build_ == true)
+    {
+        if(this->precond_ != NULL)
+        {
+            this->z_.Clear();
+            this->precond_->Clear();
+            this->precond_ = NULL;
+        }
+
+        free_host(&this->c_);
+        free_host(&this->s_);
+        free_host(&this->r_);
+        free_host(&this->H_);
+        free_host(&this->HR_);
+
+        free_host(&this->theta_);
+        free_host(&this->gamma_);
+        free_host(&this->sigma_);
+
+        for(int i = 0; i < this->size_basis_ + 1; ++i)
+        {
+            this->v_[i]->Clear();
+            delete this->v_[i];
+        }
+        delete[] this->v_;
+        this->v_ = NULL;
+
+        this->iter_ctrl_.Clear();
+
+        this->build_ = false;
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+{
+    log_debug(this, "CAGMRES::ReBuildNumeric()", this->build_);
+
+    if(this->build_ == true)
+    {
+        for(int i = 0; i < this->size_basis_ + 1; ++i)
+        {
+            this->v_[i]->Zeros();
+        }
+
+        this->iter_ctrl_.Clear();
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.Zeros();
+            this->precond_->ReBuildNumeric();
+        }
+    }
+    else
+    {
+        this->Build();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+{
+    log_debug(this, "CAGMRES::MoveToHostLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        for(int i = 0; i < this->size_basis_ + 1; ++i)
+        {
+            this->v_[i]->MoveToHost();
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.MoveToHost();
+            this->precond_->MoveToHost();
+        }
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+{
+    log_debug(this, "CAGMRES::MoveToAcceleratorLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        for(int i = 0; i < this->size_basis_ + 1; ++i)
+        {
+            this->v_[i]->MoveToAccelerator();
+        }
+
+        if(this->precond_ != NULL)
+        {
+            this->z_.MoveToAccelerator();
+            this->precond_->MoveToAccelerator();
+        }
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::SetBasisSize(int size_basis)
+{
+    log_debug(this, "CAGMRES:SetBasisSize()", size_basis);
+
+    assert(size_basis > 0);
+    assert(this->build_ == false);
+
+    this->size_basis_ = size_basis;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::SetStepSize(int step_size)
+{
+    log_debug(this, "CAGMRES::SetStepSize()", step_size);
+
+    assert(step_size > 0);
+    assert(this->build_ == false);
+
+    this->step_size_ = step_size;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::SetBasis(unsigned int basis)
+{
+    log_debug(this, "CAGMRES::SetBasis()", basis);
+
+    assert(basis == MonomialBasis || basis == NewtonBasis || basis == ChebyshevBasis);
+    assert(this->build_ == false);
+
+    this->basis_ = basis;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::SetSpectralBounds(ValueType lambda_min,
+                                                                     ValueType lambda_max)
+{
+    log_debug(this, "CAGMRES::SetSpectralBounds()", lambda_min, lambda_max);
+
+    assert(rocalution_abs(lambda_min) <= rocalution_abs(lambda_max));
+    assert(this->build_ == false);
+
+    this->lambda_min_  = lambda_min;
+    this->lambda_max_  = lambda_max;
+    this->init_lambda_ = true;
+}
+
+// Orthogonalizes the block v_col+1, ..., v_col+length against v_0, ..., v_col (block
+// classical Gram-Schmidt) and against each other (Cholesky QR), using a single global
+// reduction. The columns col, col+1, ... of the Hessenberg matrix are then reconstructed
+// from the basis recurrence coefficients and the orthogonalization coefficients. Returns
+// the number of reconstructed columns, which is less than length if the Cholesky
+// factorization broke down.
+template <class OperatorType, class VectorType, typename ValueType>
+int CAGMRES<OperatorType, VectorType, ValueType>::OrthogonalizeBlock_(int col, int length)
+{
+    log_debug(this, "CAGMRES::OrthogonalizeBlock_()", col, length);
+
+    VectorType** v = this->v_;
+
+    int size  = this->size_basis_;
+    int nprev = col + 1;
+
+    ValueType zero = static_cast<ValueType>(0);
+    ValueType one  = static_cast<ValueType>(1);
+
+    // C = V^H W and the upper part of W^H W
+    int nc    = nprev * length;
+    int ndots = nc + length * (length + 1) / 2;
+
+    std::vector<const VectorType*> left(ndots);
+    std::vector<const VectorType*> right(ndots);
+    std::vector<ValueType> dots(ndots);
+
+    int k = 0;
+    for(int j = 0; j < length; ++j)
+    {
+        for(int i = 0; i < nprev; ++i)
+        {
+            left[k]  = v[i];
+            right[k] = v[col + 1 + j];
+            ++k;
+        }
+    }
+
+    for(int j = 0; j < length; ++j)
+    {
+        for(int i = 0; i <= j; ++i)
+        {
+            left[k]  = v[col + 1 + i];
+            right[k] = v[col + 1 + j];
+            ++k;
+        }
+    }
+
+    VectorType::MultiDot(ndots, &left[0], &right[0], &dots[0]);
+
+    const ValueType* C = &dots[0];
+
+    // W = W - V C
+    for(int j = 0; j < length; ++j)
+    {
+        for(int i = 0; i < nprev; ++i)
+        {
+            v[col + 1 + j]->AddScale(*v[i], -C[DENSE_IND(i, j, nprev, length)]);
+        }
+    }
+
+    // Cholesky factorization R^H R = W^H W - C^H C of the projected block
+    std::vector<ValueType> R(length * length, zero);
+
+    double tol = rocalution_abs(rocalution_eps<ValueType>());
+
+    int nchol = 0;
+    k         = nc;
+    for(int j = 0; j < length; ++j)
+    {
+        std::vector<ValueType> g(j + 1);
+
+        for(int i = 0; i <= j; ++i)
+        {
+            g[i] = dots[k++];
+
+            for(int l = 0; l < nprev; ++l)
+            {
+                g[i] -= rocalution_conj(C[DENSE_IND(l, i, nprev, length)])
+                        * C[DENSE_IND(l, j, nprev, length)];
+            }
+        }
+
+        if(nchol < j)
+        {
+            continue;
+        }
+
+        for(int i = 0; i < j; ++i)
+        {
+            ValueType sum = g[i];
+
+            for(int l = 0; l < i; ++l)
+            {
+                sum -= rocalution_conj(R[DENSE_IND(l, i, length, length)])
+                       * R[DENSE_IND(l, j, length, length)];
+            }
+
+            R[DENSE_IND(i, j, length, length)] = sum / R[DENSE_IND(i, i, length, length)];
+        }
+
+        ValueType diag = g[j];
+
+        for(int l = 0; l < j; ++l)
+        {
+            diag -= rocalution_conj(R[DENSE_IND(l, j, length, length)])
+                    * R[DENSE_IND(l, j, length, length)];
+        }
+
+        // Stop at the first (numerically) linearly dependent vector
+        if(rocalution_abs(diag) <= tol * rocalution_abs(dots[k - 1]) || diag <= zero)
+        {
+            continue;
+        }
+
+        R[DENSE_IND(j, j, length, length)] = sqrt(diag);
+        ++nchol;
+    }
+
+    // W = W R^-1
+    for(int j = 0; j < nchol; ++j)
+    {
+        for(int i = 0; i < j; ++i)
+        {
+            v[col + 1 + j]->AddScale(*v[col + 1 + i], -R[DENSE_IND(i, j, length, length)]);
+        }
+
+        v[col + 1 + j]->Scale(one / R[DENSE_IND(j, j, length, length)]);
+    }
+
+    // If even the first vector is dependent, the Krylov subspace is invariant and the
+    // column is reconstructed with a vanishing subdiagonal entry
+    int ncol = (nchol > 0) ? nchol : 1;
+
+    // The block basis [v_col, W] = [V, W] Rh, where the first column of Rh is e_col
+    int nrow = nprev + ncol;
+
+    std::vector<ValueType> Rh(nrow * (ncol + 1), zero);
+
+    Rh[DENSE_IND(col, 0, nrow, ncol + 1)] = one;
+
+    for(int j = 0; j < ncol; ++j)
+    {
+        for(int i = 0; i < nprev; ++i)
+        {
+            Rh[DENSE_IND(i, j + 1, nrow, ncol + 1)] = C[DENSE_IND(i, j, nprev, length)];
+        }
+
+        for(int i = 0; i <= j && i < nchol; ++i)
+        {
+            Rh[DENSE_IND(nprev + i, j + 1, nrow, ncol + 1)] = R[DENSE_IND(i, j, length, length)];
+        }
+    }
+
+    // T = Rh B, where A [v_col, W] = [v_col, W] B
+    std::vector<ValueType> T(nrow * ncol, zero);
+
+    for(int j = 0; j < ncol; ++j)
+    {
+        for(int i = 0; i < nrow; ++i)
+        {
+            ValueType sum = this->gamma_[j] * Rh[DENSE_IND(i, j + 1, nrow, ncol + 1)]
+                            + this->theta_[j] * Rh[DENSE_IND(i, j, nrow, ncol + 1)];
+
+            if(j > 0)
+            {
+                sum += this->sigma_[j] * Rh[DENSE_IND(i, j - 1, nrow, ncol + 1)];
+            }
+
+            T[DENSE_IND(i, j, nrow, ncol)] = sum;
+        }
+    }
+
+    // T = T - H(0:col, 0:col-1) Rh(0:col-1, :), the images of the previous vectors
+    for(int j = 0; j < ncol; ++j)
+    {
+        for(int l = 0; l < col; ++l)
+        {
+            ValueType rlj = Rh[DENSE_IND(l, j, nrow, ncol + 1)];
+
+            if(rlj != zero)
+            {
+                for(int i = 0; i <= l + 1; ++i)
+                {
+                    T[DENSE_IND(i, j, nrow, ncol)]
+                        -= this->H_[DENSE_IND(i, l, size + 1, size)] * rlj;
+                }
+            }
+        }
+    }
+
+    // H(:, col:col+ncol-1) = T Rh(col:col+ncol-1, 0:ncol-1)^-1
+    for(int j = 0; j < ncol; ++j)
+    {
+        for(int i = 0; i < nrow; ++i)
+        {
+            ValueType sum = T[DENSE_IND(i, j, nrow, ncol)];
+
+            for(int l = 0; l < j; ++l)
+            {
+                sum -= this->H_[DENSE_IND(i, col + l, size + 1, size)]
+                       * Rh[DENSE_IND(col + l, j, nrow, ncol + 1)];
+            }
+
+            this->H_[DENSE_IND(i, col + j, size + 1, size)]
+                = sum / Rh[DENSE_IND(col + j, j, nrow, ncol + 1)];
+        }
+
+        for(int i = nrow; i <= size; ++i)
+        {
+            this->H_[DENSE_IND(i, col + j, size + 1, size)] = zero;
+        }
+    }
+
+    return ncol;
+}
+
+// Performs restart cycles, starting from the (preconditioned) residual v_0 with norm r_0
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::Cycle_(const VectorType& rhs, VectorType* x)
+{
+    log_debug(this, "CAGMRES::Cycle_()", (const void*&)rhs, x);
+
+    const OperatorType* op = this->op_;
+
+    VectorType* z  = &this->z_;
+    VectorType** v = this->v_;
+
+    ValueType* c  = this->c_;
+    ValueType* s  = this->s_;
+    ValueType* r  = this->r_;
+    ValueType* H  = this->H_;
+    ValueType* HR = this->HR_;
+
+    ValueType zero = static_cast<ValueType>(0);
+    ValueType one  = static_cast<ValueType>(1);
+
+    int i;
+    int size = this->size_basis_;
+
+    while(true)
+    {
+        // Normalize v_0
+        v[0]->Scale(one / r[0]);
+
+        i = 0;
+        while(i < size)
+        {
+            int length = (this->step_size_ < size - i) ? this->step_size_ : size - i;
+
+            // Krylov basis v_i+1, ..., v_i+length of the block
+            for(int j = 0; j < length; ++j)
+            {
+                int col = i + j;
+
+                if(this->precond_ != NULL)
+                {
+                    // Solve Mv_col+1 = Av_col
+                    op->Apply(*v[col], z);
+                    this->precond_->SolveZeroSol(*z, v[col + 1]);
+                }
+                else
+                {
+                    op->Apply(*v[col], v[col + 1]);
+                }
+
+                if(this->theta_[j] != zero)
+                {
+                    v[col + 1]->AddScale(*v[col], -this->theta_[j]);
+                }
+
+                if(j > 0 && this->sigma_[j] != zero)
+                {
+                    v[col + 1]->AddScale(*v[col - 1], -this->sigma_[j]);
+                }
+
+                if(this->gamma_[j] != one)
+                {
+                    v[col + 1]->Scale(one / this->gamma_[j]);
+                }
+            }
+
+            // Single global reduction per block
+            int ncol = this->OrthogonalizeBlock_(i, length);
+
+            bool converged = false;
+
+            for(int j = 0; j < ncol; ++j)
+            {
+                int col = i + j;
+
+                for(int k = 0; k <= col + 1; ++k)
+                {
+                    HR[DENSE_IND(k, col, size + 1, size)] = H[DENSE_IND(k, col, size + 1, size)];
+                }
+
+                // Apply Givens rotation J(0),...,J(col-1) on (H(0,col),...,H(col,col))
+                for(int k = 0; k < col; ++k)
+                {
+                    int kc   = DENSE_IND(k, col, size + 1, size);
+                    int kp1c = DENSE_IND(k + 1, col, size + 1, size);
+                    this->ApplyGivensRotation_(c[k], s[k], HR[kc], HR[kp1c]);
+                }
+
+                int cc   = DENSE_IND(col, col, size + 1, size);
+                int cp1c = DENSE_IND(col + 1, col, size + 1, size);
+
+                // Construct J(col)
+                this->GenerateGivensRotation_(HR[cc], HR[cp1c], c[col], s[col]);
+
+                // Apply J(col) to H(col,col) and H(col+1,col) such that H(col+1,col) = 0
+                this->ApplyGivensRotation_(c[col], s[col], HR[cc], HR[cp1c]);
+
+                // Apply J(col) to the norm of the residual
+                this->ApplyGivensRotation_(c[col], s[col], r[col], r[col + 1]);
+
+                // Check convergence
+                if(this->iter_ctrl_.CheckResidual(rocalution_abs(r[col + 1])))
+                {
+                    converged = true;
+                    ncol      = j + 1;
+                    break;
+                }
+            }
+
+            i += ncol;
+
+            // Restart on convergence or breakdown of the block orthogonalization
+            if(converged == true || ncol < length)
+            {
+                break;
+            }
+        }
+
+        // Solve upper triangular system
+        for(int j = i - 1; j >= 0; --j)
+        {
+            r[j] /= HR[DENSE_IND(j, j, size + 1, size)];
+
+            for(int k = 0; k < j; ++k)
+            {
+                r[k] -= HR[DENSE_IND(k, j, size + 1, size)] * r[j];
+            }
+        }
+
+        // Update solution
+        for(int j = 0; j < i; ++j)
+        {
+            x->AddScale(*v[j], r[j]);
+        }
+
+        // Compute residual v_0 = b - Ax
+        if(this->precond_ != NULL)
+        {
+            op->Apply(*x, z);
+            z->ScaleAdd(-one, rhs);
+
+            // Solve Mv_0 = z
+            this->precond_->SolveZeroSol(*z, v[0]);
+        }
+        else
+        {
+            op->Apply(*x, v[0]);
+            v[0]->ScaleAdd(-one, rhs);
+        }
+
+        // r = 0
+        set_to_zero_host(size + 1, r);
+
+        // r_0 = ||v_0||
+        r[0] = this->Norm_(*v[0]);
+
+        // Check convergence
+        if(this->iter_ctrl_.CheckResidualNoCount(rocalution_abs(r[0])))
+        {
+            break;
+        }
+    }
+}
+
+// CA-GMRES implementation is based on the algorithm described in
+// 'Communication-Avoiding Krylov Subspace Methods' by M. Hoemmen, PhD thesis,
+// UC Berkeley 2010, and modified to fit rocalution structures.
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType& rhs,
+                                                                    VectorType* x)
+{
+    log_debug(this, "CAGMRES::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+    assert(x != NULL);
+    assert(x != &rhs);
+    assert(this->op_ != NULL);
+    assert(this->precond_ == NULL);
+    assert(this->build_ == true);
+    assert(this->size_basis_ > 0);
+    assert(this->res_norm_ == 2);
+
+    VectorType** v = this->v_;
+
+    // Initial residual
+    this->op_->Apply(*x, v[0]);
+    v[0]->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+    // r = 0
+    set_to_zero_host(this->size_basis_ + 1, this->r_);
+
+    // r_0 = ||v_0||
+    this->r_[0] = this->Norm_(*v[0]);
+
+    // Initial residual
+    if(this->iter_ctrl_.InitResidual(rocalution_abs(this->r_[0])) == false)
+    {
+        log_debug(this, "CAGMRES::SolveNonPrecond_()", " #*# end");
+        return;
+    }
+
+    this->Cycle_(rhs, x);
+
+    log_debug(this, "CAGMRES::SolveNonPrecond_()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rhs,
+                                                                 VectorType* x)
+{
+    log_debug(this, "CAGMRES::SolvePrecond_()", " #*# begin", (const void*&)rhs, x);
+
+    assert(x != NULL);
+    assert(x != &rhs);
+    assert(this->op_ != NULL);
+    assert(this->precond_ != NULL);
+    assert(this->build_ == true);
+    assert(this->size_basis_ > 0);
+    assert(this->res_norm_ == 2);
+
+    VectorType* z  = &this->z_;
+    VectorType** v = this->v_;
+
+    // Initial residual
+    this->op_->Apply(*x, z);
+    z->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+    // Solve Mv_0 = z
+    this->precond_->SolveZeroSol(*z, v[0]);
+
+    // r = 0
+    set_to_zero_host(this->size_basis_ + 1, this->r_);
+
+    // r_0 = ||v_0||
+    this->r_[0] = this->Norm_(*v[0]);
+
+    // Initial residual
+    if(this->iter_ctrl_.InitResidual(rocalution_abs(this->r_[0])) == false)
+    {
+        log_debug(this, "CAGMRES::SolvePrecond_()", " #*# end");
+        return;
+    }
+
+    this->Cycle_(rhs, x);
+
+    log_debug(this, "CAGMRES::SolvePrecond_()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::GenerateGivensRotation_(ValueType dx,
+                                                                           ValueType dy,
+                                                                           ValueType& c,
+                                                                           ValueType& s) const
+{
+    ValueType zero = static_cast<ValueType>(0);
+    ValueType one  = static_cast<ValueType>(1);
+
+    if(dy == zero)
+    {
+        c = one;
+        s = zero;
+    }
+    else if(dx == zero)
+    {
+        c = zero;
+        s = one;
+    }
+    else if(rocalution_abs(dy) > rocalution_abs(dx))
+    {
+        ValueType tmp = dx / dy;
+        s             = one / sqrt(one + tmp * tmp);
+        c             = tmp * s;
+    }
+    else
+    {
+        ValueType tmp = dy / dx;
+        c             = one / sqrt(one + tmp * tmp);
+        s             = tmp * c;
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void CAGMRES<OperatorType, VectorType, ValueType>::ApplyGivensRotation_(ValueType c,
+                                                                        ValueType s,
+                                                                        ValueType& dx,
+                                                                        ValueType& dy) const
+{
+    ValueType temp = dx;
+    dx             = c * dx + s * dy;
+    dy             = -s * temp + c * dy;
+}
+
+template class CAGMRES<LocalMatrix<double>, LocalVector<double>, double>;
+template class CAGMRES<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CAGMRES<LocalMatrix<std::complex<double>>,
+                       LocalVector<std::complex<double>>,
+                       std::complex<double>>;
+template class CAGMRES<LocalMatrix<std::complex<float>>,
+                       LocalVector<std::complex<float>>,
+                       std::complex<float>>;
+#endif
+
+template class CAGMRES<GlobalMatrix<double>, GlobalVector<double>, double>;
+template class CAGMRES<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CAGMRES<GlobalMatrix<std::complex<double>>,
+                       GlobalVector<std::complex<double>>,
+                       std::complex<double>>;
+template class CAGMRES<GlobalMatrix<std::complex<float>>,
+                       GlobalVector<std::complex<float>>,
+                       std::complex<float>>;
+#endif
+
+template class CAGMRES<LocalStencil<double>, LocalVector<double>, double>;
+template class CAGMRES<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CAGMRES<LocalStencil<std::complex<double>>,
+                       LocalVector<std::complex<double>>,
+                       std::complex<double>>;
+template class CAGMRES<LocalStencil<std::complex<float>>,
+                       LocalVector<std::complex<float>>,
+                       std::complex<float>>;
+#endif
+
+template class CAGMRES<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class CAGMRES<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CAGMRES<LocalCallbackOperator<std::complex<double>>,
+                       LocalVector<std::complex<double>>,
+                       std::complex<double>>;
+template class CAGMRES<LocalCallbackOperator<std::complex<float>>,
+                       LocalVector<std::complex<float>>,
+                       std::complex<float>>;
+#endif
+
+template class CAGMRES<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class CAGMRES<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CAGMRES<GlobalCallbackOperator<std::complex<double>>,
+                       GlobalVector<std::complex<double>>,
+                       std::complex<double>>;
+template class CAGMRES<GlobalCallbackOperator<std::complex<float>>,
+                       GlobalVector<std::complex<float>>,
+                       std::complex<float>>;
+#endif
+
+} // namespace rocalution
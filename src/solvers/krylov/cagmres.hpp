@@ -0,0 +1,128 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_KRYLOV_CAGMRES_HPP_
+#define ROCALUTION_KRYLOV_CAGMRES_HPP_
+
+#include "../solver.hpp"
+#include "cacg.hpp"
+
+#include <vector>
+
+namespace rocalution {
+
+/** \ingroup solver_module
+  * \class CAGMRES
+  * \brief Communication-Avoiding Generalized Minimum Residual Method
+  * \details
+  * The Communication-Avoiding GMRES method (s-step GMRES) is mathematically equivalent
+  * to the restarted GMRES method. Instead of orthogonalizing each new Krylov vector
+  * individually, blocks of \f$s\f$ basis vectors are generated and orthogonalized
+  * against all previous vectors by block classical Gram-Schmidt and against each other
+  * by a Cholesky QR factorization, using a single global reduction per block. The
+  * Hessenberg matrix is then reconstructed from the basis coefficients and the
+  * orthogonalization factors.
+  * \cite Hoemmen2010
+  *
+  * The Krylov subspace basis size can be set using SetBasisSize(). The default size is
+  * 30. The number of vectors per block can be set using SetStepSize(). The default is
+  * 4. The Newton and the Chebyshev basis are better conditioned than the monomial
+  * basis, but require bounds of the spectrum of the (preconditioned) operator, see
+  * SetSpectralBounds().
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil,
+  *                        LocalCallbackOperator or GlobalCallbackOperator
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+template <class OperatorType, class VectorType, typename ValueType>
+class CAGMRES : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+{
+    public:
+    CAGMRES();
+    virtual ~CAGMRES();
+
+    virtual void Print(void) const;
+
+    virtual void Build(void);
+    virtual void ReBuildNumeric(void);
+    virtual void Clear(void);
+
+    /** \brief Set the size of the Krylov subspace basis */
+    virtual void SetBasisSize(int size_basis);
+    /** \brief Set the number of basis vectors per block */
+    void SetStepSize(int step_size);
+    /** \brief Set the polynomial basis of the Krylov subspace
+      * \details
+      * \p basis can be MonomialBasis, NewtonBasis or ChebyshevBasis.
+      */
+    void SetBasis(unsigned int basis);
+    /** \brief Set the bounds of the spectrum of the (preconditioned) operator, used by
+      * the Newton and the Chebyshev basis
+      */
+    void SetSpectralBounds(ValueType lambda_min, ValueType lambda_max);
+
+    protected:
+    virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+    virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+    virtual void PrintStart_(void) const;
+    virtual void PrintEnd_(void) const;
+
+    virtual void MoveToHostLocalData_(void);
+    virtual void MoveToAcceleratorLocalData_(void);
+
+    /** \brief Generate Givens rotation */
+    void GenerateGivensRotation_(ValueType dx, ValueType dy, ValueType& c, ValueType& s) const;
+    /** \brief Apply Givens rotation */
+    void ApplyGivensRotation_(ValueType c, ValueType s, ValueType& dx, ValueType& dy) const;
+
+    private:
+    int OrthogonalizeBlock_(int col, int length);
+    void Cycle_(const VectorType& rhs, VectorType* x);
+
+    VectorType** v_;
+    VectorType z_;
+
+    ValueType* c_;
+    ValueType* s_;
+    ValueType* r_;
+    ValueType* H_;
+    ValueType* HR_;
+
+    ValueType* theta_;
+    ValueType* gamma_;
+    ValueType* sigma_;
+
+    int size_basis_;
+    int step_size_;
+    unsigned int basis_;
+
+    bool init_lambda_;
+    ValueType lambda_min_, lambda_max_;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_KRYLOV_CAGMRES_HPP_
@@ -24,12 +24,15 @@
 #include "../../utils/def.hpp"
 #include "cg.hpp"
 #include "../iter_ctrl.hpp"
+#include "../preconditioners/preconditioner.hpp"
 
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
 
 #include "../../utils/log.hpp"
@@ -213,6 +216,7 @@ void CG<OperatorType, VectorType, ValueType>::Clear(void)
         this->z_.Clear();
         this->p_.Clear();
         this->q_.Clear();
+        this->inv_diag_.Clear();
 
         this->iter_ctrl_.Clear();
 
@@ -232,6 +236,9 @@ void CG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
         this->p_.Zeros();
         this->q_.Zeros();
 
+        // Extracted again from the new values by the next fused Solve
+        this->inv_diag_.Clear();
+
         this->iter_ctrl_.Clear();
 
         if(this->precond_ != NULL)
@@ -259,6 +266,7 @@ void CG<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
         if(this->precond_ != NULL)
         {
             this->z_.MoveToHost();
+            this->inv_diag_.MoveToHost();
             this->precond_->MoveToHost();
         }
     }
@@ -278,6 +286,7 @@ void CG<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
         if(this->precond_ != NULL)
         {
             this->z_.MoveToAccelerator();
+            this->inv_diag_.MoveToAccelerator();
             this->precond_->MoveToAccelerator();
         }
     }
@@ -327,6 +336,12 @@ void CG<OperatorType, VectorType, ValueType>::SolveNonPrecond_(const VectorType&
     // rho = (r,r)
     rho = r->DotNonConj(*r);
 
+    if(this->SolveFused_(NULL, rho, x) == true)
+    {
+        log_debug(this, "CG::SolveNonPrecond_()", " #*# end");
+        return;
+    }
+
     while(true)
     {
         // q=Ap
@@ -406,6 +421,16 @@ void CG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rh
     // rho = (r,z)
     rho = r->DotNonConj(*z);
 
+    // Jacobi is applied within the fused iterations
+    if(dynamic_cast<Jacobi<OperatorType, VectorType, ValueType>*>(this->precond_) != NULL)
+    {
+        if(this->SolveFused_(&this->inv_diag_, rho, x) == true)
+        {
+            log_debug(this, "CG::SolvePrecond_()", " #*# end");
+            return;
+        }
+    }
+
     while(true)
     {
         // q=Ap
@@ -442,6 +467,47 @@ void CG<OperatorType, VectorType, ValueType>::SolvePrecond_(const VectorType& rh
     log_debug(this, "CG::SolvePrecond_()", " #*# end");
 }
 
+template <class OperatorType, class VectorType, typename ValueType>
+bool CG<OperatorType, VectorType, ValueType>::SolveFused_(VectorType* inv_diag,
+                                                          ValueType rho,
+                                                          VectorType* x)
+{
+    log_debug(this, "CG::SolveFused_()", inv_diag, rho, x);
+
+    // The fused iterations compute the L2 norm of the residual only
+    if(this->res_norm_ != 2)
+    {
+        return false;
+    }
+
+    const LocalMatrix<ValueType>* mat = dynamic_cast<const LocalMatrix<ValueType>*>(this->op_);
+
+    LocalVector<ValueType>* cast_d = dynamic_cast<LocalVector<ValueType>*>(inv_diag);
+    LocalVector<ValueType>* cast_x = dynamic_cast<LocalVector<ValueType>*>(x);
+    LocalVector<ValueType>* cast_r = dynamic_cast<LocalVector<ValueType>*>(&this->r_);
+    LocalVector<ValueType>* cast_p = dynamic_cast<LocalVector<ValueType>*>(&this->p_);
+    LocalVector<ValueType>* cast_q = dynamic_cast<LocalVector<ValueType>*>(&this->q_);
+
+    if(mat == NULL || cast_x == NULL || cast_r == NULL || cast_p == NULL || cast_q == NULL ||
+       (inv_diag != NULL && cast_d == NULL))
+    {
+        return false;
+    }
+
+    return mat->CGIterations(
+        cast_d, rho, CG<OperatorType, VectorType, ValueType>::CheckResidual_, this, cast_x,
+        cast_r, cast_p, cast_q);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+bool CG<OperatorType, VectorType, ValueType>::CheckResidual_(double res, void* data)
+{
+    CG<OperatorType, VectorType, ValueType>* cg =
+        static_cast<CG<OperatorType, VectorType, ValueType>*>(data);
+
+    return cg->iter_ctrl_.CheckResidual(res);
+}
+
 template class CG<LocalMatrix<double>, LocalVector<double>, double>;
 template class CG<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -475,4 +541,26 @@ template class CG<LocalStencil<std::complex<float>>,
                   std::complex<float>>;
 #endif
 
+template class CG<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class CG<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CG<LocalCallbackOperator<std::complex<double>>,
+                  LocalVector<std::complex<double>>,
+                  std::complex<double>>;
+template class CG<LocalCallbackOperator<std::complex<float>>,
+                  LocalVector<std::complex<float>>,
+                  std::complex<float>>;
+#endif
+
+template class CG<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class CG<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CG<GlobalCallbackOperator<std::complex<double>>,
+                  GlobalVector<std::complex<double>>,
+                  std::complex<double>>;
+template class CG<GlobalCallbackOperator<std::complex<float>>,
+                  GlobalVector<std::complex<float>>,
+                  std::complex<float>>;
+#endif
+
 } // namespace rocalution
@@ -41,7 +41,13 @@ namespace rocalution {
   * the approximation should also be SPD.
   * \cite SAAD
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * If the operator is a LocalMatrix in CSR format on the host, the solver is not
+  * preconditioned or preconditioned by Jacobi, and the residual is measured in the L2
+  * norm, all iterations are performed within a single OpenMP parallel region (see
+  * LocalMatrix::CGIterations()).
+  *
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil,
+  *                        LocalCallbackOperator or GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -73,8 +79,16 @@ class CG : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
     virtual void MoveToAcceleratorLocalData_(void);
 
     private:
+    /** \brief Perform all iterations in a single parallel region, if supported */
+    bool SolveFused_(VectorType* inv_diag, ValueType rho, VectorType* x);
+    /** \brief Convergence check of the fused iterations */
+    static bool CheckResidual_(double res, void* data);
+
     VectorType r_, z_;
     VectorType p_, q_;
+
+    // Inverse diagonal of the fused Jacobi iterations, extracted once per Build
+    VectorType inv_diag_;
 };
 
 } // namespace rocalution
@@ -27,9 +27,11 @@
 
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
 
 #include "../../utils/log.hpp"
@@ -476,4 +478,26 @@ template class CR<LocalStencil<std::complex<float>>,
                   std::complex<float>>;
 #endif
 
+template class CR<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class CR<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CR<LocalCallbackOperator<std::complex<double>>,
+                  LocalVector<std::complex<double>>,
+                  std::complex<double>>;
+template class CR<LocalCallbackOperator<std::complex<float>>,
+                  LocalVector<std::complex<float>>,
+                  std::complex<float>>;
+#endif
+
+template class CR<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class CR<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class CR<GlobalCallbackOperator<std::complex<double>>,
+                  GlobalVector<std::complex<double>>,
+                  std::complex<double>>;
+template class CR<GlobalCallbackOperator<std::complex<float>>,
+                  GlobalVector<std::complex<float>>,
+                  std::complex<float>>;
+#endif
+
 } // namespace rocalution
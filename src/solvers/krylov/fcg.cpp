@@ -27,9 +27,11 @@
 
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
 
 #include "../../utils/log.hpp"
@@ -445,4 +447,26 @@ template class FCG<GlobalMatrix<std::complex<float>>,
                    std::complex<float>>;
 #endif
 
+template class FCG<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class FCG<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class FCG<LocalCallbackOperator<std::complex<double>>,
+                   LocalVector<std::complex<double>>,
+                   std::complex<double>>;
+template class FCG<LocalCallbackOperator<std::complex<float>>,
+                   LocalVector<std::complex<float>>,
+                   std::complex<float>>;
+#endif
+
+template class FCG<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class FCG<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class FCG<GlobalCallbackOperator<std::complex<double>>,
+                   GlobalVector<std::complex<double>>,
+                   std::complex<double>>;
+template class FCG<GlobalCallbackOperator<std::complex<float>>,
+                   GlobalVector<std::complex<float>>,
+                   std::complex<float>>;
+#endif
+
 } // namespace rocalution
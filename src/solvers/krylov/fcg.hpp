@@ -42,7 +42,8 @@ namespace rocalution {
   * operator.
   * \cite fcg
   *
-  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalCallbackOperator or
+  *                        GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -28,9 +28,11 @@
 #include "../../base/matrix_formats_ind.hpp"
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
 
 #include "../../utils/log.hpp"
@@ -646,4 +648,26 @@ template class FGMRES<LocalStencil<std::complex<float>>,
                       std::complex<float>>;
 #endif
 
+template class FGMRES<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class FGMRES<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class FGMRES<LocalCallbackOperator<std::complex<double>>,
+                      LocalVector<std::complex<double>>,
+                      std::complex<double>>;
+template class FGMRES<LocalCallbackOperator<std::complex<float>>,
+                      LocalVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
+template class FGMRES<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class FGMRES<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class FGMRES<GlobalCallbackOperator<std::complex<double>>,
+                      GlobalVector<std::complex<double>>,
+                      std::complex<double>>;
+template class FGMRES<GlobalCallbackOperator<std::complex<float>>,
+                      GlobalVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
 } // namespace rocalution
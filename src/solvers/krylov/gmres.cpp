@@ -28,9 +28,11 @@
 #include "../../base/matrix_formats_ind.hpp"
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
 
 #include "../../utils/log.hpp"
@@ -637,4 +639,26 @@ template class GMRES<LocalStencil<std::complex<float>>,
                      std::complex<float>>;
 #endif
 
+template class GMRES<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class GMRES<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class GMRES<LocalCallbackOperator<std::complex<double>>,
+                     LocalVector<std::complex<double>>,
+                     std::complex<double>>;
+template class GMRES<LocalCallbackOperator<std::complex<float>>,
+                     LocalVector<std::complex<float>>,
+                     std::complex<float>>;
+#endif
+
+template class GMRES<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class GMRES<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class GMRES<GlobalCallbackOperator<std::complex<double>>,
+                     GlobalVector<std::complex<double>>,
+                     std::complex<double>>;
+template class GMRES<GlobalCallbackOperator<std::complex<float>>,
+                     GlobalVector<std::complex<float>>,
+                     std::complex<float>>;
+#endif
+
 } // namespace rocalution
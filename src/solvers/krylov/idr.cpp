@@ -28,9 +28,11 @@
 
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
 
 #include "../../base/matrix_formats_ind.hpp"
@@ -823,4 +825,26 @@ template class IDR<LocalStencil<std::complex<float>>,
                    std::complex<float>>;
 #endif
 
+template class IDR<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class IDR<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class IDR<LocalCallbackOperator<std::complex<double>>,
+                   LocalVector<std::complex<double>>,
+                   std::complex<double>>;
+template class IDR<LocalCallbackOperator<std::complex<float>>,
+                   LocalVector<std::complex<float>>,
+                   std::complex<float>>;
+#endif
+
+template class IDR<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class IDR<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class IDR<GlobalCallbackOperator<std::complex<double>>,
+                   GlobalVector<std::complex<double>>,
+                   std::complex<double>>;
+template class IDR<GlobalCallbackOperator<std::complex<float>>,
+                   GlobalVector<std::complex<float>>,
+                   std::complex<float>>;
+#endif
+
 } // namespace rocalution
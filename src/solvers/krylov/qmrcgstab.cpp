@@ -27,9 +27,11 @@
 
 #include "../../base/local_matrix.hpp"
 #include "../../base/local_stencil.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../base/global_matrix.hpp"
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
 
 #include "../../utils/log.hpp"
@@ -730,4 +732,26 @@ template class QMRCGStab<GlobalMatrix<std::complex<float>>,
                          std::complex<float>>;
 #endif
 
+template class QMRCGStab<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class QMRCGStab<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class QMRCGStab<LocalCallbackOperator<std::complex<double>>,
+                         LocalVector<std::complex<double>>,
+                         std::complex<double>>;
+template class QMRCGStab<LocalCallbackOperator<std::complex<float>>,
+                         LocalVector<std::complex<float>>,
+                         std::complex<float>>;
+#endif
+
+template class QMRCGStab<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class QMRCGStab<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class QMRCGStab<GlobalCallbackOperator<std::complex<double>>,
+                         GlobalVector<std::complex<double>>,
+                         std::complex<double>>;
+template class QMRCGStab<GlobalCallbackOperator<std::complex<float>>,
+                         GlobalVector<std::complex<float>>,
+                         std::complex<float>>;
+#endif
+
 } // namespace rocalution
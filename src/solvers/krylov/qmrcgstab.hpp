@@ -39,7 +39,8 @@ namespace rocalution {
   * \f$Ax=b\f$.
   * \cite qmrcgstab
   *
-  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalCallbackOperator or
+  *                        GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
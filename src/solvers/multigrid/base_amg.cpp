@@ -32,9 +32,12 @@
 #include "../../base/global_vector.hpp"
 
 #include "../krylov/cg.hpp"
+#include "../chebyshev.hpp"
 #include "../preconditioners/preconditioner.hpp"
+#include "../preconditioners/preconditioner_l1.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 
 #include <list>
 
@@ -51,10 +54,13 @@ BaseAMG<OperatorType, VectorType, ValueType>::BaseAMG()
     this->set_sm_ = false;
     this->set_s_  = false;
 
-    // default smoother format
+    // default smoother and smoother format
+    this->sm_type_   = ChebyshevSmoother;
     this->sm_format_ = CSR;
     // default operator format
-    this->op_format_ = CSR;
+    this->op_format_           = CSR;
+    this->op_format_auto_      = false;
+    this->op_format_benchmark_ = false;
 
     // since hierarchy has not been built yet
     this->hierarchy_ = false;
@@ -102,6 +108,18 @@ void BaseAMG<OperatorType, VectorType, ValueType>::SetManualSolver(bool s_manual
     this->set_s_ = s_manual;
 }
 
+template <class OperatorType, class VectorType, typename ValueType>
+void BaseAMG<OperatorType, VectorType, ValueType>::SetDefaultSmoother(unsigned int smoother)
+{
+    log_debug(this, "BaseAMG::SetDefaultSmoother()", smoother);
+
+    assert(this->build_ == false);
+    assert(smoother == ChebyshevSmoother || smoother == L1JacobiSmoother ||
+           smoother == JacobiSmoother || smoother == GaussSeidelSmoother);
+
+    this->sm_type_ = smoother;
+}
+
 template <class OperatorType, class VectorType, typename ValueType>
 void BaseAMG<OperatorType, VectorType, ValueType>::SetDefaultSmootherFormat(unsigned int op_format)
 {
@@ -117,7 +135,35 @@ void BaseAMG<OperatorType, VectorType, ValueType>::SetOperatorFormat(unsigned in
 {
     log_debug(this, "BaseAMG::SetOperatorFormat()", op_format);
 
-    this->op_format_ = op_format;
+    this->op_format_      = op_format;
+    this->op_format_auto_ = false;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BaseAMG<OperatorType, VectorType, ValueType>::SetOperatorFormatAuto(bool benchmark)
+{
+    log_debug(this, "BaseAMG::SetOperatorFormatAuto()", benchmark);
+
+    this->op_format_auto_      = true;
+    this->op_format_benchmark_ = benchmark;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void BaseAMG<OperatorType, VectorType, ValueType>::ConvertOperators_(void)
+{
+    log_debug(this, "BaseAMG::ConvertOperators_()");
+
+    for(int i = 0; i < this->levels_ - 1; ++i)
+    {
+        if(this->op_format_auto_ == true)
+        {
+            this->op_level_[i]->AutoTuneFormat(this->op_format_benchmark_);
+        }
+        else if(this->op_format_ != CSR)
+        {
+            this->op_level_[i]->ConvertTo(this->op_format_);
+        }
+    }
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -267,13 +313,7 @@ void BaseAMG<OperatorType, VectorType, ValueType>::Build(void)
     log_debug(this, "BaseAMG::Build()", "#*# convert operators");
 
     // Convert operator to op_format
-    if(this->op_format_ != CSR)
-    {
-        for(int i = 0; i < this->levels_ - 1; ++i)
-        {
-            this->op_level_[i]->ConvertTo(this->op_format_);
-        }
-    }
+    this->ConvertOperators_();
 
     log_debug(this, "BaseAMG::Build()", this->build_, " #*# end");
 }
@@ -283,6 +323,8 @@ void BaseAMG<OperatorType, VectorType, ValueType>::BuildHierarchy(void)
 {
     log_debug(this, "BaseAMG::BuildHierarchy()", " #*# begin");
 
+    ROCALUTION_TRACE_SCOPE("BaseAMG::BuildHierarchy", "multigrid");
+
     if(this->hierarchy_ == false)
     {
         assert(this->build_ == false);
@@ -374,6 +416,8 @@ void BaseAMG<OperatorType, VectorType, ValueType>::BuildSmoothers(void)
 {
     log_debug(this, "BaseAMG::BuildSmoothers()", " #*# begin");
 
+    ROCALUTION_TRACE_SCOPE("BaseAMG::BuildSmoothers", "multigrid");
+
     // Smoother for each level
     this->smoother_level_ =
         new IterativeLinearSolver<OperatorType, VectorType, ValueType>*[this->levels_ - 1];
@@ -381,16 +425,59 @@ void BaseAMG<OperatorType, VectorType, ValueType>::BuildSmoothers(void)
 
     for(int i = 0; i < this->levels_ - 1; ++i)
     {
-        FixedPoint<OperatorType, VectorType, ValueType>* sm =
-            new FixedPoint<OperatorType, VectorType, ValueType>;
-        Jacobi<OperatorType, VectorType, ValueType>* jac =
-            new Jacobi<OperatorType, VectorType, ValueType>;
-
-        sm->SetRelaxation(static_cast<ValueType>(0.67));
-        sm->SetPreconditioner(*jac);
-        sm->Verbose(0);
-        this->smoother_level_[i] = sm;
-        this->sm_default_[i]     = jac;
+        switch(this->sm_type_)
+        {
+        case ChebyshevSmoother:
+        {
+            Chebyshev<OperatorType, VectorType, ValueType>* sm =
+                new Chebyshev<OperatorType, VectorType, ValueType>;
+            Jacobi<OperatorType, VectorType, ValueType>* jac =
+                new Jacobi<OperatorType, VectorType, ValueType>;
+
+            // Damp the upper part of the spectrum of D^-1 A, estimated on each level
+            sm->SetEigenvalueEstimation(10, static_cast<ValueType>(3));
+            sm->SetPreconditioner(*jac);
+            sm->Verbose(0);
+            this->smoother_level_[i] = sm;
+            this->sm_default_[i]     = jac;
+            break;
+        }
+
+        case L1JacobiSmoother:
+        {
+            FixedPoint<OperatorType, VectorType, ValueType>* sm =
+                new FixedPoint<OperatorType, VectorType, ValueType>;
+            L1Jacobi<OperatorType, VectorType, ValueType>* l1 =
+                new L1Jacobi<OperatorType, VectorType, ValueType>;
+
+            sm->SetRelaxation(static_cast<ValueType>(1));
+            sm->SetPreconditioner(*l1);
+            sm->Verbose(0);
+            this->smoother_level_[i] = sm;
+            this->sm_default_[i]     = l1;
+            break;
+        }
+
+        case JacobiSmoother:
+        {
+            FixedPoint<OperatorType, VectorType, ValueType>* sm =
+                new FixedPoint<OperatorType, VectorType, ValueType>;
+            Jacobi<OperatorType, VectorType, ValueType>* jac =
+                new Jacobi<OperatorType, VectorType, ValueType>;
+
+            sm->SetRelaxation(static_cast<ValueType>(0.67));
+            sm->SetPreconditioner(*jac);
+            sm->Verbose(0);
+            this->smoother_level_[i] = sm;
+            this->sm_default_[i]     = jac;
+            break;
+        }
+
+        default:
+            LOG_INFO("BaseAMG::BuildSmoothers() - smoother not supported by this solver");
+            FATAL_ERROR(__FILE__, __LINE__);
+            break;
+        }
     }
 
     log_debug(this, "BaseAMG::BuildSmoothers()", " #*# end");
@@ -31,6 +31,20 @@
 
 namespace rocalution {
 
+enum _aggregation_strategy
+{
+    Greedy = 0,
+    MIS2   = 1
+};
+
+enum _amg_smoother
+{
+    ChebyshevSmoother   = 0,
+    L1JacobiSmoother    = 1,
+    JacobiSmoother      = 2,
+    GaussSeidelSmoother = 3
+};
+
 /** \ingroup solver_module
   * \class BaseAMG
   * \brief Base class for all algebraic multigrid solvers
@@ -73,10 +87,41 @@ class BaseAMG : public BaseMultiGrid<OperatorType, VectorType, ValueType>
     /** \brief Set flag to pass coarse grid solver manually */
     void SetManualSolver(bool s_manual);
 
+    /** \brief Set the smoother that is built for each level
+      * \details
+      * Available smoothers are
+      * - ChebyshevSmoother (default): Chebyshev iteration with Jacobi preconditioner.
+      *   The maximum eigenvalue of \f$D^{-1}A\f$ is estimated on each level by a few
+      *   Lanczos steps, see Chebyshev::SetEigenvalueEstimation(). The number of pre- and
+      *   post-smoothing steps is the degree of the Chebyshev polynomial.
+      * - L1JacobiSmoother: fixed-point iteration with l1-Jacobi preconditioner, which
+      *   requires no damping.
+      * - JacobiSmoother: fixed-point iteration with Jacobi preconditioner, damped by
+      *   0.67.
+      * - GaussSeidelSmoother: fixed-point iteration with multi-colored Gauss-Seidel
+      *   preconditioner, relaxed by 1.3 (LocalMatrix only, not for pairwise AMG).
+      *
+      * The Chebyshev and Jacobi type smoothers are composed of SpMV and vector updates
+      * only and scale with the number of threads, while Gauss-Seidel is limited by the
+      * number of colors.
+      */
+    void SetDefaultSmoother(unsigned int smoother);
     /** \brief Set the smoother operator format */
     void SetDefaultSmootherFormat(unsigned int op_format);
     /** \brief Set the operator format */
     void SetOperatorFormat(unsigned int op_format);
+    /** \brief Select the operator format of each level automatically
+      * \details
+      * The coarse grid operators are converted level by level with
+      * LocalMatrix::AutoTuneFormat(), such that e.g. a regular fine level can be stored
+      * in DIA format while the denser and irregular coarse levels use CSR or HYB.
+      * Calling SetOperatorFormat() switches back to a fixed format.
+      *
+      * @param[in]
+      * benchmark   time the candidate formats on each level instead of using the
+      *             structural heuristic
+      */
+    void SetOperatorFormatAuto(bool benchmark = false);
 
     /** \brief Returns the number of levels in hierarchy */
     int GetNumLevels(void);
@@ -89,6 +134,9 @@ class BaseAMG : public BaseMultiGrid<OperatorType, VectorType, ValueType>
     virtual void SetOperatorHierarchy(OperatorType** op);
 
     protected:
+    /** \brief Convert the coarse grid operators to the operator format */
+    void ConvertOperators_(void);
+
     /** \brief Constructs the prolongation, restriction and coarse operator */
     virtual void Aggregate_(const OperatorType& op,
                             Operator<ValueType>* pro,
@@ -109,10 +157,16 @@ class BaseAMG : public BaseMultiGrid<OperatorType, VectorType, ValueType>
     /** \brief Build flag for hierarchy */
     bool hierarchy_;
 
+    /** \brief Smoother type */
+    unsigned int sm_type_;
     /** \brief Smoother operator format */
     unsigned int sm_format_;
     /** \brief Operator format */
     unsigned int op_format_;
+    /** \brief Operator format is selected per level */
+    bool op_format_auto_;
+    /** \brief Operator format selection benchmarks the candidate formats */
+    bool op_format_benchmark_;
 };
 
 } // namespace rocalution
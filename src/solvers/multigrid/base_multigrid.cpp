@@ -32,6 +32,7 @@
 #include "../../base/global_vector.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 #include "../../utils/math_functions.hpp"
 
 #include <math.h>
@@ -560,6 +561,8 @@ void BaseMultiGrid<OperatorType, VectorType, ValueType>::Solve(const VectorType&
 {
     log_debug(this, "BaseMultiGrid::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("BaseMultiGrid::Solve", "multigrid");
+
     assert(this->levels_ > 1);
     assert(x != NULL);
     assert(x != &rhs);
@@ -644,6 +647,8 @@ void BaseMultiGrid<OperatorType, VectorType, ValueType>::Restrict_(const VectorT
 {
     log_debug(this, "BaseMultiGrid::Restrict_()", (const void*&)fine, coarse, level);
 
+    ROCALUTION_TRACE_SCOPE("BaseMultiGrid::Restrict_", "multigrid");
+
     this->restrict_op_level_[level]->Apply(fine.GetInterior(), &(coarse->GetInterior()));
 }
 
@@ -654,9 +659,72 @@ void BaseMultiGrid<OperatorType, VectorType, ValueType>::Prolong_(const VectorTy
 {
     log_debug(this, "BaseMultiGrid::Prolong_()", (const void*&)coarse, fine, level);
 
+    ROCALUTION_TRACE_SCOPE("BaseMultiGrid::Prolong_", "multigrid");
+
     this->prolong_op_level_[level]->Apply(coarse.GetInterior(), &(fine->GetInterior()));
 }
 
+template <class OperatorType, class VectorType, typename ValueType>
+bool BaseMultiGrid<OperatorType, VectorType, ValueType>::RestrictResidual_(const VectorType& rhs,
+                                                                           const VectorType& x,
+                                                                           VectorType* coarse,
+                                                                           int level)
+{
+    log_debug(this,
+              "BaseMultiGrid::RestrictResidual_()",
+              (const void*&)rhs,
+              (const void*&)x,
+              coarse,
+              level);
+
+    const OperatorType* op = (level == 0) ? this->op_ : this->op_level_[level - 1];
+
+    const LocalMatrix<ValueType>* cast_op = dynamic_cast<const LocalMatrix<ValueType>*>(op);
+    const LocalMatrix<ValueType>* cast_res =
+        dynamic_cast<const LocalMatrix<ValueType>*>(this->restrict_op_level_[level]);
+
+    if(cast_op == NULL || cast_res == NULL)
+    {
+        return false;
+    }
+
+    ROCALUTION_TRACE_SCOPE("BaseMultiGrid::RestrictResidual_", "multigrid");
+
+    // The scaling of the finest level correction requires the residual
+    bool residual = (this->scaling_ == true && level == 0 && level < this->levels_ - 2);
+
+    cast_res->RestrictResidual(*cast_op,
+                               rhs.GetInterior(),
+                               x.GetInterior(),
+                               residual,
+                               &(this->s_level_[level]->GetInterior()),
+                               &(coarse->GetInterior()));
+
+    return true;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+bool BaseMultiGrid<OperatorType, VectorType, ValueType>::ProlongAdd_(const VectorType& coarse,
+                                                                     VectorType* fine,
+                                                                     int level)
+{
+    log_debug(this, "BaseMultiGrid::ProlongAdd_()", (const void*&)coarse, fine, level);
+
+    const LocalMatrix<ValueType>* cast_pro =
+        dynamic_cast<const LocalMatrix<ValueType>*>(this->prolong_op_level_[level]);
+
+    if(cast_pro == NULL)
+    {
+        return false;
+    }
+
+    ROCALUTION_TRACE_SCOPE("BaseMultiGrid::ProlongAdd_", "multigrid");
+
+    cast_pro->ApplyAdd(coarse.GetInterior(), static_cast<ValueType>(1), &(fine->GetInterior()));
+
+    return true;
+}
+
 template <class OperatorType, class VectorType, typename ValueType>
 void BaseMultiGrid<OperatorType, VectorType, ValueType>::Vcycle_(const VectorType& rhs,
                                                                  VectorType* x)
@@ -699,40 +767,48 @@ void BaseMultiGrid<OperatorType, VectorType, ValueType>::Vcycle_(const VectorTyp
             }
         }
 
-        // Update residual
-        if(this->current_level_ == 0)
-        {
-            this->op_->Apply(*x, this->s_level_[this->current_level_]);
-        }
-        else
-        {
-            this->op_level_[this->current_level_ - 1]->Apply(*x,
-                                                             this->s_level_[this->current_level_]);
-        }
-
-        this->s_level_[this->current_level_]->ScaleAdd(static_cast<ValueType>(-1), rhs);
-
-        if(this->current_level_ == this->levels_ - this->host_level_ - 1)
-        {
-            this->s_level_[this->current_level_]->MoveToHost();
-        }
-
-        // Restrict residual vector on finest
-        // level
-        this->Restrict_(*this->s_level_[this->current_level_],
-                        this->t_level_[this->current_level_ + 1],
-                        this->current_level_);
-
-        if(this->current_level_ == this->levels_ - this->host_level_ - 1)
+        // Update residual and restrict it in a fused kernel, if both levels reside on
+        // the same backend
+        if(this->current_level_ == this->levels_ - this->host_level_ - 1 ||
+           this->RestrictResidual_(
+               rhs, *x, this->t_level_[this->current_level_ + 1], this->current_level_)
+               == false)
         {
+            // Update residual
             if(this->current_level_ == 0)
             {
-                this->s_level_[this->current_level_]->CloneBackend(*this->op_);
+                this->op_->Apply(*x, this->s_level_[this->current_level_]);
             }
             else
             {
-                this->s_level_[this->current_level_]->CloneBackend(
-                    *this->op_level_[this->current_level_ - 1]);
+                this->op_level_[this->current_level_ - 1]->Apply(
+                    *x, this->s_level_[this->current_level_]);
+            }
+
+            this->s_level_[this->current_level_]->ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+            if(this->current_level_ == this->levels_ - this->host_level_ - 1)
+            {
+                this->s_level_[this->current_level_]->MoveToHost();
+            }
+
+            // Restrict residual vector on finest
+            // level
+            this->Restrict_(*this->s_level_[this->current_level_],
+                            this->t_level_[this->current_level_ + 1],
+                            this->current_level_);
+
+            if(this->current_level_ == this->levels_ - this->host_level_ - 1)
+            {
+                if(this->current_level_ == 0)
+                {
+                    this->s_level_[this->current_level_]->CloneBackend(*this->op_);
+                }
+                else
+                {
+                    this->s_level_[this->current_level_]->CloneBackend(
+                        *this->op_level_[this->current_level_ - 1]);
+                }
             }
         }
 
@@ -769,79 +845,99 @@ void BaseMultiGrid<OperatorType, VectorType, ValueType>::Vcycle_(const VectorTyp
         default: FATAL_ERROR(__FILE__, __LINE__); break;
         }
 
-        if(this->current_level_ == this->levels_ - this->host_level_)
+        // Prolong and add the correction in a single sweep, if no scaling is applied and
+        // both levels reside on the same backend
+        bool prolong_add = (this->scaling_ == false || this->current_level_ > this->levels_ - 2) &&
+                           (this->current_level_ != this->levels_ - this->host_level_);
+
+        if(prolong_add == true)
         {
-            this->r_level_[this->current_level_ - 1]->MoveToHost();
+            prolong_add = this->ProlongAdd_(
+                *this->d_level_[this->current_level_], x, this->current_level_ - 1);
         }
 
-        // Prolong solution vector on finest
-        // level
-        this->Prolong_(*this->d_level_[this->current_level_],
-                       this->r_level_[this->current_level_ - 1],
-                       this->current_level_ - 1);
-
-        if(this->current_level_ == this->levels_ - this->host_level_)
+        if(prolong_add == true)
         {
-            if(this->current_level_ == 1)
-            {
-                this->r_level_[this->current_level_ - 1]->CloneBackend(*this->op_);
-            }
-            else
-            {
-                this->r_level_[this->current_level_ - 1]->CloneBackend(
-                    *this->op_level_[this->current_level_ - 2]);
-            }
+            --this->current_level_;
         }
-
-        --this->current_level_;
-
-        // Scaling
-        if(this->scaling_ == true && this->current_level_ < this->levels_ - 2)
+        else
         {
-            if(this->current_level_ == 0)
-            {
-                this->s_level_[this->current_level_]->PointWiseMult(
-                    *this->r_level_[this->current_level_]);
-            }
-            else
+            if(this->current_level_ == this->levels_ - this->host_level_)
             {
-                this->s_level_[this->current_level_]->PointWiseMult(
-                    *this->r_level_[this->current_level_], *this->t_level_[this->current_level_]);
+                this->r_level_[this->current_level_ - 1]->MoveToHost();
             }
 
-            factor = this->s_level_[this->current_level_]->Reduce();
+            // Prolong solution vector on finest
+            // level
+            this->Prolong_(*this->d_level_[this->current_level_],
+                           this->r_level_[this->current_level_ - 1],
+                           this->current_level_ - 1);
 
-            if(this->current_level_ == 0)
+            if(this->current_level_ == this->levels_ - this->host_level_)
             {
-                this->op_->Apply(*this->r_level_[this->current_level_],
-                                 this->s_level_[this->current_level_]);
-            }
-            else
-            {
-                this->op_level_[this->current_level_ - 1]->Apply(
-                    *this->r_level_[this->current_level_], this->s_level_[this->current_level_]);
+                if(this->current_level_ == 1)
+                {
+                    this->r_level_[this->current_level_ - 1]->CloneBackend(*this->op_);
+                }
+                else
+                {
+                    this->r_level_[this->current_level_ - 1]->CloneBackend(
+                        *this->op_level_[this->current_level_ - 2]);
+                }
             }
 
-            this->s_level_[this->current_level_]->PointWiseMult(
-                *this->r_level_[this->current_level_]);
+            --this->current_level_;
 
-            // Check for division by zero
-            divisor = this->s_level_[this->current_level_]->Reduce();
-            if(divisor == static_cast<ValueType>(0))
+            // Scaling
+            if(this->scaling_ == true && this->current_level_ < this->levels_ - 2)
             {
-                factor = static_cast<ValueType>(1);
+                if(this->current_level_ == 0)
+                {
+                    this->s_level_[this->current_level_]->PointWiseMult(
+                        *this->r_level_[this->current_level_]);
+                }
+                else
+                {
+                    this->s_level_[this->current_level_]->PointWiseMult(
+                        *this->r_level_[this->current_level_],
+                        *this->t_level_[this->current_level_]);
+                }
+
+                factor = this->s_level_[this->current_level_]->Reduce();
+
+                if(this->current_level_ == 0)
+                {
+                    this->op_->Apply(*this->r_level_[this->current_level_],
+                                     this->s_level_[this->current_level_]);
+                }
+                else
+                {
+                    this->op_level_[this->current_level_ - 1]->Apply(
+                        *this->r_level_[this->current_level_],
+                        this->s_level_[this->current_level_]);
+                }
+
+                this->s_level_[this->current_level_]->PointWiseMult(
+                    *this->r_level_[this->current_level_]);
+
+                // Check for division by zero
+                divisor = this->s_level_[this->current_level_]->Reduce();
+                if(divisor == static_cast<ValueType>(0))
+                {
+                    factor = static_cast<ValueType>(1);
+                }
+                else
+                {
+                    factor /= divisor;
+                }
+
+                // Defect correction
+                x->AddScale(*this->r_level_[this->current_level_], factor);
             }
             else
-            {
-                factor /= divisor;
-            }
-
-            // Defect correction
-            x->AddScale(*this->r_level_[this->current_level_], factor);
+                // Defect correction
+                x->AddScale(*this->r_level_[this->current_level_], static_cast<ValueType>(1));
         }
-        else
-            // Defect correction
-            x->AddScale(*this->r_level_[this->current_level_], static_cast<ValueType>(1));
 
         // Post-smoothing on finest level
         this->smoother_level_[this->current_level_]->InitMaxIter(this->iter_post_smooth_);
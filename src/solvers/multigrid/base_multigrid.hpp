@@ -106,6 +106,14 @@ class BaseMultiGrid : public IterativeLinearSolver<OperatorType, VectorType, Val
     /** \brief Prolongs from level 'level' to 'level+1' */
     void Prolong_(const VectorType& coarse, VectorType* fine, int level);
 
+    /** \brief Computes the residual on level 'level' and restricts it to 'level-1' in a
+      * fused kernel; returns false if the operators do not support it */
+    bool RestrictResidual_(const VectorType& rhs, const VectorType& x, VectorType* coarse,
+                           int level);
+    /** \brief Prolongs from level 'level' to 'level+1' and adds the result to \p fine
+      * in a single sweep; returns false if the operator does not support it */
+    bool ProlongAdd_(const VectorType& coarse, VectorType* fine, int level);
+
     /** \brief V-cycle */
     void Vcycle_(const VectorType& rhs, VectorType* x);
     /** \brief W-cycle */
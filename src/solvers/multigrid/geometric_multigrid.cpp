@@ -0,0 +1,443 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "../../utils/def.hpp"
+#include "geometric_multigrid.hpp"
+#include "../iter_ctrl.hpp"
+#include "../krylov/cg.hpp"
+
+#include "../../base/local_stencil.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <complex>
+#include <vector>
+
+namespace rocalution {
+
+template <class OperatorType, class VectorType, typename ValueType>
+GeometricMultiGrid<OperatorType, VectorType, ValueType>::GeometricMultiGrid()
+{
+    log_debug(this, "GeometricMultiGrid::GeometricMultiGrid()", "default constructor");
+
+    this->levels_      = -1;
+    this->coarse_size_ = 300;
+    this->galerkin_    = true;
+
+    this->iter_pre_smooth_  = 2;
+    this->iter_post_smooth_ = 2;
+    this->omega_            = static_cast<ValueType>(0.8);
+
+    this->op_level_ = NULL;
+    this->r_level_  = NULL;
+    this->x_level_  = NULL;
+
+    this->solver_coarse_ = NULL;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+GeometricMultiGrid<OperatorType, VectorType, ValueType>::~GeometricMultiGrid()
+{
+    log_debug(this, "GeometricMultiGrid::~GeometricMultiGrid()", "destructor");
+
+    this->Clear();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::SetPreconditioner(
+    Solver<OperatorType, VectorType, ValueType>& precond)
+{
+    LOG_INFO("GeometricMultiGrid::SetPreconditioner() The geometric multigrid solver does not "
+             "support a preconditioner");
+    FATAL_ERROR(__FILE__, __LINE__);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::SetGalerkin(bool galerkin)
+{
+    log_debug(this, "GeometricMultiGrid::SetGalerkin()", galerkin);
+
+    this->galerkin_ = galerkin;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::SetCoarsestLevel(int coarse_size)
+{
+    log_debug(this, "GeometricMultiGrid::SetCoarsestLevel()", coarse_size);
+
+    assert(coarse_size > 0);
+    assert(this->build_ == false);
+
+    this->coarse_size_ = coarse_size;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::SetSmootherPreIter(int iter)
+{
+    log_debug(this, "GeometricMultiGrid::SetSmootherPreIter()", iter);
+
+    assert(iter >= 0);
+
+    this->iter_pre_smooth_ = iter;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::SetSmootherPostIter(int iter)
+{
+    log_debug(this, "GeometricMultiGrid::SetSmootherPostIter()", iter);
+
+    assert(iter >= 0);
+
+    this->iter_post_smooth_ = iter;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::SetSmootherRelaxation(ValueType omega)
+{
+    log_debug(this, "GeometricMultiGrid::SetSmootherRelaxation()", omega);
+
+    this->omega_ = omega;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+int GeometricMultiGrid<OperatorType, VectorType, ValueType>::GetNumLevels(void) const
+{
+    return this->levels_;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::Print(void) const
+{
+    LOG_INFO("GeometricMultiGrid solver");
+    LOG_INFO("GeometricMultiGrid number of levels " << this->levels_);
+    LOG_INFO("GeometricMultiGrid coarse grid stencils "
+             << (this->galerkin_ ? "Galerkin product" : "rediscretization"));
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::PrintStart_(void) const
+{
+    assert(this->levels_ > 0);
+
+    LOG_INFO("GeometricMultiGrid solver starts");
+    LOG_INFO("GeometricMultiGrid number of levels " << this->levels_);
+    LOG_INFO("GeometricMultiGrid smoother Jacobi(" << this->iter_pre_smooth_ << ", "
+                                                   << this->iter_post_smooth_ << ")");
+
+    for(int i = 0; i < this->levels_; ++i)
+    {
+        const OperatorType* op = (i == 0) ? this->op_ : this->op_level_[i - 1];
+
+        LOG_INFO("GeometricMultiGrid level " << i << " grid " << op->GetGridSize(0) << "x"
+                                             << op->GetGridSize(1) << "x"
+                                             << op->GetGridSize(2) << " points "
+                                             << op->GetNnz());
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
+{
+    LOG_INFO("GeometricMultiGrid ends");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+bool GeometricMultiGrid<OperatorType, VectorType, ValueType>::Coarsenable_(
+    const OperatorType& op) const
+{
+    for(int d = 0; d < op.GetNDim(); ++d)
+    {
+        if(op.GetGridSize(d) >= 3)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::Build(void)
+{
+    log_debug(this, "GeometricMultiGrid::Build()", this->build_, " #*# begin");
+
+    if(this->build_ == true)
+    {
+        this->Clear();
+    }
+
+    assert(this->build_ == false);
+    assert(this->op_ != NULL);
+    assert(this->op_->GetM() > 0);
+
+    // Coarsen until the grid is small enough or cannot be coarsened anymore
+    std::vector<OperatorType*> hierarchy;
+
+    const OperatorType* op = this->op_;
+
+    while(op->GetM() > static_cast<IndexType2>(this->coarse_size_) && this->Coarsenable_(*op))
+    {
+        OperatorType* coarse = new OperatorType(GeneralStencil);
+
+        op->Coarsen(this->galerkin_, coarse);
+
+        hierarchy.push_back(coarse);
+        op = coarse;
+    }
+
+    this->levels_ = static_cast<int>(hierarchy.size()) + 1;
+
+    this->op_level_ = new OperatorType*[this->levels_ - 1];
+    this->r_level_  = new VectorType*[this->levels_ - 1];
+    this->x_level_  = new VectorType*[this->levels_ - 1];
+
+    for(int i = 0; i < this->levels_ - 1; ++i)
+    {
+        this->op_level_[i] = hierarchy[i];
+
+        this->r_level_[i] = new VectorType;
+        this->r_level_[i]->CloneBackend(*this->op_);
+        this->r_level_[i]->Allocate("coarse rhs", hierarchy[i]->GetM());
+
+        this->x_level_[i] = new VectorType;
+        this->x_level_[i]->CloneBackend(*this->op_);
+        this->x_level_[i]->Allocate("coarse correction", hierarchy[i]->GetM());
+    }
+
+    this->r_.CloneBackend(*this->op_);
+    this->r_.Allocate("r", this->op_->GetM());
+
+    this->solver_coarse_ = new CG<OperatorType, VectorType, ValueType>;
+    this->solver_coarse_->SetOperator(*op);
+    this->solver_coarse_->Verbose(0);
+    this->solver_coarse_->Init(1e-30, 1e-6, 1e+8, 1000);
+    this->solver_coarse_->Build();
+
+    this->build_ = true;
+
+    log_debug(this, "GeometricMultiGrid::Build()", this->build_, " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
+{
+    log_debug(this, "GeometricMultiGrid::ReBuildNumeric()", this->build_);
+
+    if(this->build_ == true)
+    {
+        // The grids do not change, only the coarse grid stencils are recomputed
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            const OperatorType* fine = (i == 0) ? this->op_ : this->op_level_[i - 1];
+
+            fine->Coarsen(this->galerkin_, this->op_level_[i]);
+        }
+
+        this->r_.Zeros();
+
+        this->iter_ctrl_.Clear();
+
+        this->solver_coarse_->ReBuildNumeric();
+    }
+    else
+    {
+        this->Build();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::Clear(void)
+{
+    log_debug(this, "GeometricMultiGrid::Clear()", this->build_);
+
+    if(this->build_ == true)
+    {
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            delete this->op_level_[i];
+            delete this->r_level_[i];
+            delete this->x_level_[i];
+        }
+
+        delete[] this->op_level_;
+        delete[] this->r_level_;
+        delete[] this->x_level_;
+
+        this->op_level_ = NULL;
+        this->r_level_  = NULL;
+        this->x_level_  = NULL;
+
+        this->r_.Clear();
+
+        delete this->solver_coarse_;
+        this->solver_coarse_ = NULL;
+
+        this->iter_ctrl_.Clear();
+
+        this->levels_ = -1;
+        this->build_  = false;
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+{
+    log_debug(this, "GeometricMultiGrid::MoveToHostLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            this->op_level_[i]->MoveToHost();
+            this->r_level_[i]->MoveToHost();
+            this->x_level_[i]->MoveToHost();
+        }
+
+        this->r_.MoveToHost();
+
+        this->solver_coarse_->MoveToHost();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+{
+    log_debug(this, "GeometricMultiGrid::MoveToAcceleratorLocalData_()", this->build_);
+
+    if(this->build_ == true)
+    {
+        for(int i = 0; i < this->levels_ - 1; ++i)
+        {
+            this->op_level_[i]->MoveToAccelerator();
+            this->r_level_[i]->MoveToAccelerator();
+            this->x_level_[i]->MoveToAccelerator();
+        }
+
+        this->r_.MoveToAccelerator();
+
+        this->solver_coarse_->MoveToAccelerator();
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::Vcycle_(int level,
+                                                                      const VectorType& rhs,
+                                                                      VectorType* x)
+{
+    log_debug(this, "GeometricMultiGrid::Vcycle_()", level, (const void*&)rhs, x);
+
+    ROCALUTION_TRACE_SCOPE("GeometricMultiGrid::Vcycle", "multigrid");
+
+    if(level == this->levels_ - 1)
+    {
+        this->solver_coarse_->Solve(rhs, x);
+
+        return;
+    }
+
+    const OperatorType* op = (level == 0) ? this->op_ : this->op_level_[level - 1];
+
+    VectorType* r_coarse = this->r_level_[level];
+    VectorType* x_coarse = this->x_level_[level];
+
+    // Pre-smoothing
+    op->JacobiSmooth(rhs, x, this->omega_, this->iter_pre_smooth_);
+
+    // Coarse grid residual r_coarse = R (rhs - Ax)
+    op->ResidualRestrict(rhs, *x, r_coarse);
+
+    // Coarse grid correction
+    x_coarse->Zeros();
+    this->Vcycle_(level + 1, *r_coarse, x_coarse);
+
+    // x = x + P x_coarse
+    op->ProlongAdd(*x_coarse, x);
+
+    // Post-smoothing
+    op->JacobiSmooth(rhs, x, this->omega_, this->iter_post_smooth_);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::SolveNonPrecond_(
+    const VectorType& rhs, VectorType* x)
+{
+    log_debug(this, "GeometricMultiGrid::SolveNonPrecond_()", " #*# begin", (const void*&)rhs, x);
+
+    assert(x != NULL);
+    assert(x != &rhs);
+    assert(this->op_ != NULL);
+    assert(this->precond_ == NULL);
+    assert(this->build_ == true);
+    assert(this->levels_ > 0);
+
+    // Initial residual = b - Ax
+    this->op_->Apply(*x, &this->r_);
+    this->r_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+    ValueType res = this->Norm_(this->r_);
+
+    if(this->iter_ctrl_.InitResidual(rocalution_abs(res)) == false)
+    {
+        log_debug(this, "GeometricMultiGrid::SolveNonPrecond_()", " #*# end");
+        return;
+    }
+
+    do
+    {
+        this->Vcycle_(0, rhs, x);
+
+        // r = b - Ax
+        this->op_->Apply(*x, &this->r_);
+        this->r_.ScaleAdd(static_cast<ValueType>(-1), rhs);
+
+        res = this->Norm_(this->r_);
+    } while(!this->iter_ctrl_.CheckResidual(rocalution_abs(res), this->index_));
+
+    log_debug(this, "GeometricMultiGrid::SolveNonPrecond_()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void GeometricMultiGrid<OperatorType, VectorType, ValueType>::SolvePrecond_(
+    const VectorType& rhs, VectorType* x)
+{
+    LOG_INFO("GeometricMultiGrid::SolvePrecond_() The geometric multigrid solver does not "
+             "support a preconditioner");
+    FATAL_ERROR(__FILE__, __LINE__);
+}
+
+template class GeometricMultiGrid<LocalStencil<double>, LocalVector<double>, double>;
+template class GeometricMultiGrid<LocalStencil<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class GeometricMultiGrid<LocalStencil<std::complex<double>>,
+                                  LocalVector<std::complex<double>>,
+                                  std::complex<double>>;
+template class GeometricMultiGrid<LocalStencil<std::complex<float>>,
+                                  LocalVector<std::complex<float>>,
+                                  std::complex<float>>;
+#endif
+
+} // namespace rocalution
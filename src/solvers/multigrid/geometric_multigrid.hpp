@@ -0,0 +1,141 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_GEOMETRIC_MULTIGRID_HPP_
+#define ROCALUTION_GEOMETRIC_MULTIGRID_HPP_
+
+#include "../solver.hpp"
+#include "../../base/operator.hpp"
+
+namespace rocalution {
+
+template <class OperatorType, class VectorType, typename ValueType>
+class CG;
+
+/** \ingroup solver_module
+  * \class GeometricMultiGrid
+  * \brief Geometric MultiGrid on Structured Grids
+  * \details
+  * The geometric multigrid method builds its hierarchy directly from a LocalStencil,
+  * without assembling any operator. Each level halves the number of grid points in every
+  * dimension with at least three points, see LocalStencil::Coarsen(). The coarse grid
+  * stencils are either the Galerkin products of the transfer operators (default) or
+  * rediscretizations of the fine grid stencil, see SetGalerkin().
+  *
+  * The transfer operators are matrix-free, i.e. full weighting restriction and
+  * (bi-, tri-)linear interpolation. Each V-cycle level performs temporally blocked damped
+  * Jacobi pre-smoothing, the residual computation fused with the restriction, the
+  * interpolation fused with the coarse grid correction, and damped Jacobi post-smoothing.
+  * The coarsest grid is solved by the CG method.
+  * \cite Trottenberg2003
+  *
+  * \tparam OperatorType - can be LocalStencil
+  * \tparam VectorType - can be LocalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+template <class OperatorType, class VectorType, typename ValueType>
+class GeometricMultiGrid : public IterativeLinearSolver<OperatorType, VectorType, ValueType>
+{
+    public:
+    GeometricMultiGrid();
+    virtual ~GeometricMultiGrid();
+
+    virtual void Print(void) const;
+
+    /** \private */
+    virtual void SetPreconditioner(Solver<OperatorType, VectorType, ValueType>& precond);
+
+    /** \brief Build the coarse grid stencils by Galerkin product (default) or by
+      * rediscretization
+      */
+    void SetGalerkin(bool galerkin);
+
+    /** \brief Set the maximal number of grid points on the coarsest level (default 300) */
+    void SetCoarsestLevel(int coarse_size);
+
+    /** \brief Set the number of pre-smoothing steps */
+    void SetSmootherPreIter(int iter);
+
+    /** \brief Set the number of post-smoothing steps */
+    void SetSmootherPostIter(int iter);
+
+    /** \brief Set the relaxation parameter of the damped Jacobi smoother (default 0.8) */
+    void SetSmootherRelaxation(ValueType omega);
+
+    /** \brief Return the number of levels in the hierarchy */
+    int GetNumLevels(void) const;
+
+    virtual void Build(void);
+    virtual void ReBuildNumeric(void);
+    virtual void Clear(void);
+
+    protected:
+    /** \brief V-cycle on level 'level' */
+    void Vcycle_(int level, const VectorType& rhs, VectorType* x);
+
+    virtual void SolveNonPrecond_(const VectorType& rhs, VectorType* x);
+    virtual void SolvePrecond_(const VectorType& rhs, VectorType* x);
+
+    virtual void PrintStart_(void) const;
+    virtual void PrintEnd_(void) const;
+
+    virtual void MoveToHostLocalData_(void);
+    virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+    /** \brief Check whether a stencil grid can be coarsened */
+    bool Coarsenable_(const OperatorType& op) const;
+
+    /** \brief Number of levels in the hierarchy */
+    int levels_;
+    /** \brief Maximal size of the coarsest level */
+    int coarse_size_;
+    /** \brief Galerkin coarse grid stencils */
+    bool galerkin_;
+
+    /** \brief Number of pre-smoothing steps */
+    int iter_pre_smooth_;
+    /** \brief Number of post-smoothing steps */
+    int iter_post_smooth_;
+    /** \brief Jacobi relaxation parameter */
+    ValueType omega_;
+
+    /** \brief Coarse grid stencils */
+    OperatorType** op_level_;
+
+    /** \brief Coarse grid right-hand sides */
+    VectorType** r_level_;
+    /** \brief Coarse grid corrections */
+    VectorType** x_level_;
+
+    /** \brief Fine grid residual */
+    VectorType r_;
+
+    /** \brief Coarsest grid solver */
+    CG<OperatorType, VectorType, ValueType>* solver_coarse_;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_GEOMETRIC_MULTIGRID_HPP_
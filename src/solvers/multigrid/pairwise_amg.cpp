@@ -131,7 +131,7 @@ void PairwiseAMG<OperatorType, VectorType, ValueType>::SetOrdering(unsigned int
 {
     log_debug(this, "PairwiseAMG::SetOrdering()", ordering);
 
-    assert(ordering >= 0 && ordering <= 5);
+    assert(ordering >= 0 && ordering <= 6);
 
     this->aggregation_ordering_ = ordering;
 }
@@ -238,33 +238,6 @@ void PairwiseAMG<OperatorType, VectorType, ValueType>::BuildHierarchy(void)
     log_debug(this, "PairwiseAMG::BuildHierarchy()", " #*# end");
 }
 
-template <class OperatorType, class VectorType, typename ValueType>
-void PairwiseAMG<OperatorType, VectorType, ValueType>::BuildSmoothers(void)
-{
-    log_debug(this, "PairwiseAMG::BuildSmoothers()", " #*# begin");
-
-    // Smoother for each level
-    this->smoother_level_ =
-        new IterativeLinearSolver<OperatorType, VectorType, ValueType>*[this->levels_ - 1];
-    this->sm_default_ = new Solver<OperatorType, VectorType, ValueType>*[this->levels_ - 1];
-
-    for(int i = 0; i < this->levels_ - 1; ++i)
-    {
-        FixedPoint<OperatorType, VectorType, ValueType>* sm =
-            new FixedPoint<OperatorType, VectorType, ValueType>;
-        Jacobi<OperatorType, VectorType, ValueType>* jac =
-            new Jacobi<OperatorType, VectorType, ValueType>;
-
-        sm->SetRelaxation(static_cast<ValueType>(0.67));
-        sm->SetPreconditioner(*jac);
-        sm->Verbose(0);
-        this->smoother_level_[i] = sm;
-        this->sm_default_[i]     = jac;
-    }
-
-    log_debug(this, "PairwiseAMG::BuildSmoothers()", " #*# end");
-}
-
 template <class OperatorType, class VectorType, typename ValueType>
 void PairwiseAMG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
 {
@@ -330,13 +303,7 @@ void PairwiseAMG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
     this->solver_coarse_->Verbose(0);
 
     // Convert operator to op_format
-    if(this->op_format_ != CSR)
-    {
-        for(int i = 0; i < this->levels_ - 1; ++i)
-        {
-            this->op_level_[i]->ConvertTo(this->op_format_);
-        }
-    }
+    this->ConvertOperators_();
 
     log_debug(this, "PairwiseAMG::ReBuildNumeric()", " #*# end");
 }
@@ -31,12 +31,13 @@ namespace rocalution {
 
 enum _aggregation_ordering
 {
-    NoOrdering    = 0,
-    Connectivity  = 1,
-    CMK           = 2,
-    RCMK          = 3,
-    MIS           = 4,
-    MultiColoring = 5
+    NoOrdering       = 0,
+    Connectivity     = 1,
+    CMK              = 2,
+    RCMK             = 3,
+    MIS              = 4,
+    MultiColoring    = 5,
+    ParallelMatching = 6
 };
 
 /** \ingroup solver_module
@@ -63,11 +64,17 @@ class PairwiseAMG : public BaseAMG<OperatorType, VectorType, ValueType>
     virtual void Print(void) const;
     virtual void BuildHierarchy(void);
     virtual void ClearLocal(void);
-    virtual void BuildSmoothers(void);
 
     /** \brief Set beta for pairwise aggregation */
     void SetBeta(ValueType beta);
-    /** \brief Set re-ordering for aggregation */
+    /** \brief Set re-ordering for aggregation
+      * \details
+      * The pairwise aggregation visits the nodes sequentially in the selected order.
+      * With ParallelMatching, the pairs are determined in parallel by a matching of
+      * locally dominant couplings, which is independent of the number of threads.
+      * Unmatched nodes join an adjacent pair, such that aggregates of up to three nodes
+      * are formed.
+      */
     void SetOrdering(unsigned int ordering);
     /** \brief Set target coarsening factor */
     void SetCoarseningFactor(double factor);
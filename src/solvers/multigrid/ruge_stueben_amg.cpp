@@ -41,6 +41,16 @@ RugeStuebenAMG<OperatorType, VectorType, ValueType>::RugeStuebenAMG()
 
     // parameter for strong couplings in smoothed aggregation
     this->eps_ = static_cast<ValueType>(0.25);
+
+    // classic coarsening with direct interpolation
+    this->coarsening_    = Classic;
+    this->interpolation_ = Direct;
+
+    // no truncation of the interpolation
+    this->trunc_factor_       = static_cast<ValueType>(0);
+    this->trunc_max_elements_ = 0;
+
+    this->aggressive_levels_ = 0;
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -57,6 +67,7 @@ void RugeStuebenAMG<OperatorType, VectorType, ValueType>::Print(void) const
     LOG_INFO("AMG solver");
     LOG_INFO("AMG number of levels " << this->levels_);
     LOG_INFO("AMG using Ruge-Stüben coarsening");
+    this->PrintCoarsening_();
     LOG_INFO("AMG coarsest operator size = " << this->op_level_[this->levels_ - 2]->GetM());
     LOG_INFO("AMG coarsest level nnz = " << this->op_level_[this->levels_ - 2]->GetNnz());
     LOG_INFO("AMG with smoother:");
@@ -71,12 +82,44 @@ void RugeStuebenAMG<OperatorType, VectorType, ValueType>::PrintStart_(void) cons
     LOG_INFO("AMG solver starts");
     LOG_INFO("AMG number of levels " << this->levels_);
     LOG_INFO("AMG using Ruge-Stüben coarsening");
+    this->PrintCoarsening_();
     LOG_INFO("AMG coarsest operator size = " << this->op_level_[this->levels_ - 2]->GetM());
     LOG_INFO("AMG coarsest level nnz = " << this->op_level_[this->levels_ - 2]->GetNnz());
     LOG_INFO("AMG with smoother:");
     this->smoother_level_[0]->Print();
 }
 
+template <class OperatorType, class VectorType, typename ValueType>
+void RugeStuebenAMG<OperatorType, VectorType, ValueType>::PrintCoarsening_(void) const
+{
+    switch(this->coarsening_)
+    {
+    case PMIS:
+        LOG_INFO("AMG coarsening strategy: PMIS");
+        break;
+    case HMIS:
+        LOG_INFO("AMG coarsening strategy: HMIS");
+        break;
+    default:
+        LOG_INFO("AMG coarsening strategy: Classic");
+        break;
+    }
+
+    if(this->interpolation_ == ExtPI)
+    {
+        LOG_INFO("AMG interpolation: extended+i");
+    }
+    else
+    {
+        LOG_INFO("AMG interpolation: direct");
+    }
+
+    if(this->aggressive_levels_ > 0)
+    {
+        LOG_INFO("AMG aggressive coarsening levels: " << this->aggressive_levels_);
+    }
+}
+
 template <class OperatorType, class VectorType, typename ValueType>
 void RugeStuebenAMG<OperatorType, VectorType, ValueType>::PrintEnd_(void) const
 {
@@ -91,11 +134,61 @@ void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetCouplingStrength(Va
     this->eps_ = eps;
 }
 
+template <class OperatorType, class VectorType, typename ValueType>
+void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetCoarseningStrategy(unsigned int strat)
+{
+    log_debug(this, "RugeStuebenAMG::SetCoarseningStrategy()", strat);
+
+    assert(strat == Classic || strat == PMIS || strat == HMIS);
+
+    this->coarsening_ = strat;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetInterpolationType(unsigned int type)
+{
+    log_debug(this, "RugeStuebenAMG::SetInterpolationType()", type);
+
+    assert(type == Direct || type == ExtPI);
+
+    this->interpolation_ = type;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetInterpolationTruncation(
+    ValueType trunc_factor, int max_elements)
+{
+    log_debug(this, "RugeStuebenAMG::SetInterpolationTruncation()", trunc_factor, max_elements);
+
+    assert(max_elements >= 0);
+
+    this->trunc_factor_       = trunc_factor;
+    this->trunc_max_elements_ = max_elements;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void RugeStuebenAMG<OperatorType, VectorType, ValueType>::SetAggressiveCoarseningLevels(int levels)
+{
+    log_debug(this, "RugeStuebenAMG::SetAggressiveCoarseningLevels()", levels);
+
+    assert(levels >= 0);
+
+    this->aggressive_levels_ = levels;
+}
+
 template <class OperatorType, class VectorType, typename ValueType>
 void RugeStuebenAMG<OperatorType, VectorType, ValueType>::BuildSmoothers(void)
 {
     log_debug(this, "RugeStuebenAMG::BuildSmoothers()", " #*# begin");
 
+    // Only the Gauss-Seidel smoother is specific to the local solver
+    if(this->sm_type_ != GaussSeidelSmoother)
+    {
+        BaseAMG<OperatorType, VectorType, ValueType>::BuildSmoothers();
+
+        return;
+    }
+
     // Smoother for each level
     this->smoother_level_ =
         new IterativeLinearSolver<OperatorType, VectorType, ValueType>*[this->levels_ - 1];
@@ -215,13 +308,7 @@ void RugeStuebenAMG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
     this->solver_coarse_->Verbose(0);
 
     // Convert operator to op_format
-    if(this->op_format_ != CSR)
-    {
-        for(int i = 0; i < this->levels_ - 1; ++i)
-        {
-            this->op_level_[i]->ConvertTo(this->op_format_);
-        }
-    }
+    this->ConvertOperators_();
 
     log_debug(this, "RugeStuebenAMG::ReBuildNumeric()", " #*# end");
 }
@@ -245,7 +332,15 @@ void RugeStuebenAMG<OperatorType, VectorType, ValueType>::Aggregate_(const Opera
     assert(cast_pro != NULL);
 
     // Create prolongation and restriction operators
-    op.RugeStueben(this->eps_, cast_pro, cast_res);
+    // (this->levels_ is the number of the level, that is currently coarsened)
+    op.RugeStueben(this->eps_,
+                   this->coarsening_,
+                   this->interpolation_,
+                   this->levels_ <= this->aggressive_levels_,
+                   this->trunc_factor_,
+                   this->trunc_max_elements_,
+                   cast_pro,
+                   cast_res);
 
     // Create coarse operator
     OperatorType tmp;
@@ -31,6 +31,19 @@
 
 namespace rocalution {
 
+enum _rs_coarsening
+{
+    Classic = 0,
+    PMIS    = 1,
+    HMIS    = 2
+};
+
+enum _rs_interpolation
+{
+    Direct = 0,
+    ExtPI  = 1
+};
+
 /** \ingroup solver_module
   * \class RugeStuebenAMG
   * \brief Ruge-Stueben Algebraic MultiGrid Method
@@ -41,6 +54,14 @@ namespace rocalution {
   * has a higher building step and requires higher memory usage.
   * \cite stuben
   *
+  * The sequential classic coarsening can be replaced by the parallel PMIS or HMIS
+  * coarsening, which produce less coarse points and therefore lower operator
+  * complexities. Since PMIS and HMIS coarsening violate the classic interpolation
+  * requirements, they should be combined with extended+i interpolation, which can be
+  * truncated to limit the growth of the coarse operators. Aggressive coarsening can be
+  * applied to the finest levels, to further reduce the memory footprint of the
+  * hierarchy.
+  *
   * \tparam OperatorType - can be LocalMatrix
   * \tparam VectorType - can be LocalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
@@ -58,6 +79,24 @@ class RugeStuebenAMG : public BaseAMG<OperatorType, VectorType, ValueType>
     /** \brief Set coupling strength */
     void SetCouplingStrength(ValueType eps);
 
+    /** \brief Set the coarsening strategy (Classic, PMIS or HMIS) */
+    void SetCoarseningStrategy(unsigned int strat);
+
+    /** \brief Set the interpolation type (Direct or ExtPI) */
+    void SetInterpolationType(unsigned int type);
+
+    /** \brief Set the truncation of the interpolation
+      * \details
+      * Interpolation weights that are smaller than \p trunc_factor times the largest
+      * weight of the row are dropped. If \p max_elements is positive, only the largest
+      * \p max_elements weights of each row are kept. The remaining weights are rescaled
+      * to preserve the row sums. Default is no truncation.
+      */
+    void SetInterpolationTruncation(ValueType trunc_factor, int max_elements = 0);
+
+    /** \brief Set the number of levels, that are coarsened aggressively (default 0) */
+    void SetAggressiveCoarseningLevels(int levels);
+
     virtual void ReBuildNumeric(void);
 
     protected:
@@ -70,8 +109,24 @@ class RugeStuebenAMG : public BaseAMG<OperatorType, VectorType, ValueType>
     virtual void PrintEnd_(void) const;
 
     private:
+    /** \brief Print the coarsening and interpolation settings */
+    void PrintCoarsening_(void) const;
+
     /** \brief Coupling strength */
     ValueType eps_;
+
+    /** \brief Coarsening strategy */
+    unsigned int coarsening_;
+    /** \brief Interpolation type */
+    unsigned int interpolation_;
+
+    /** \brief Truncation factor of the interpolation */
+    ValueType trunc_factor_;
+    /** \brief Maximum number of interpolation weights per row */
+    int trunc_max_elements_;
+
+    /** \brief Number of aggressively coarsened levels */
+    int aggressive_levels_;
 };
 
 } // namespace rocalution
@@ -42,6 +42,8 @@ SAAMG<OperatorType, VectorType, ValueType>::SAAMG()
     // parameter for strong couplings in smoothed aggregation
     this->eps_   = static_cast<ValueType>(0.01);
     this->relax_ = static_cast<ValueType>(2) / static_cast<ValueType>(3);
+
+    this->aggregation_ = Greedy;
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -100,11 +102,29 @@ void SAAMG<OperatorType, VectorType, ValueType>::SetCouplingStrength(ValueType e
     this->eps_ = eps;
 }
 
+template <class OperatorType, class VectorType, typename ValueType>
+void SAAMG<OperatorType, VectorType, ValueType>::SetAggregationStrategy(unsigned int strat)
+{
+    log_debug(this, "SAAMG::SetAggregationStrategy()", strat);
+
+    assert(strat == Greedy || strat == MIS2);
+
+    this->aggregation_ = strat;
+}
+
 template <class OperatorType, class VectorType, typename ValueType>
 void SAAMG<OperatorType, VectorType, ValueType>::BuildSmoothers(void)
 {
     log_debug(this, "SAAMG::BuildSmoothers()", " #*# begin");
 
+    // Only the Gauss-Seidel smoother is specific to the local solver
+    if(this->sm_type_ != GaussSeidelSmoother)
+    {
+        BaseAMG<OperatorType, VectorType, ValueType>::BuildSmoothers();
+
+        return;
+    }
+
     // Smoother for each level
     this->smoother_level_ =
         new IterativeLinearSolver<OperatorType, VectorType, ValueType>*[this->levels_ - 1];
@@ -223,13 +243,7 @@ void SAAMG<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
     this->solver_coarse_->Verbose(0);
 
     // Convert operator to op_format
-    if(this->op_format_ != CSR)
-    {
-        for(int i = 0; i < this->levels_ - 1; ++i)
-        {
-            this->op_level_[i]->ConvertTo(this->op_format_);
-        }
-    }
+    this->ConvertOperators_();
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -263,7 +277,16 @@ void SAAMG<OperatorType, VectorType, ValueType>::Aggregate_(const OperatorType&
     }
 
     op.AMGConnect(eps, &connections);
-    op.AMGAggregate(connections, &aggregates);
+
+    if(this->aggregation_ == MIS2)
+    {
+        op.AMGMIS2Aggregate(connections, &aggregates);
+    }
+    else
+    {
+        op.AMGAggregate(connections, &aggregates);
+    }
+
     op.AMGSmoothedAggregation(this->relax_, aggregates, connections, cast_pro, cast_res);
 
     // Free unused vectors
@@ -57,6 +57,12 @@ class SAAMG : public BaseAMG<OperatorType, VectorType, ValueType>
     void SetCouplingStrength(ValueType eps);
     /** \brief Set the relaxation parameter */
     void SetInterpRelax(ValueType relax);
+    /** \brief Set the aggregation strategy
+      * \details
+      * Greedy (default) is the sequential plain aggregation. MIS2 builds the aggregates
+      * in parallel from a distance-2 maximal independent set of the strong couplings.
+      */
+    void SetAggregationStrategy(unsigned int strat);
 
     virtual void ReBuildNumeric(void);
 
@@ -75,6 +81,9 @@ class SAAMG : public BaseAMG<OperatorType, VectorType, ValueType>
 
     /** \brief Relaxation parameter */
     ValueType relax_;
+
+    /** \brief Aggregation strategy */
+    unsigned int aggregation_;
 };
 
 } // namespace rocalution
@@ -57,6 +57,12 @@ class UAAMG : public BaseAMG<OperatorType, VectorType, ValueType>
     void SetCouplingStrength(ValueType eps);
     /** \brief Set over-interpolation parameter for aggregation */
     void SetOverInterp(ValueType overInterp);
+    /** \brief Set the aggregation strategy
+      * \details
+      * Greedy (default) is the sequential plain aggregation. MIS2 builds the aggregates
+      * in parallel from a distance-2 maximal independent set of the strong couplings.
+      */
+    void SetAggregationStrategy(unsigned int strat);
 
     virtual void ReBuildNumeric(void);
 
@@ -75,6 +81,9 @@ class UAAMG : public BaseAMG<OperatorType, VectorType, ValueType>
 
     /** \brief Over-interpolation parameter for aggregation */
     ValueType over_interp_;
+
+    /** \brief Aggregation strategy */
+    unsigned int aggregation_;
 };
 
 } // namespace rocalution
@@ -27,10 +27,13 @@
 #include "../../base/global_matrix.hpp"
 #include "../../base/local_matrix.hpp"
 
+#include "../../base/global_callback_operator.hpp"
 #include "../../base/global_vector.hpp"
+#include "../../base/local_callback_operator.hpp"
 #include "../../base/local_vector.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 
 #include <math.h>
 #include <complex>
@@ -137,6 +140,8 @@ void Jacobi<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, V
 {
     log_debug(this, "Jacobi::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("Jacobi::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
 
@@ -237,6 +242,8 @@ void GS<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vecto
 {
     log_debug(this, "GS::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("GS::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
 
@@ -353,6 +360,8 @@ void SGS<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vect
 {
     log_debug(this, "SGS::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("SGS::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
 
@@ -486,6 +495,8 @@ void ILU<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vect
 {
     log_debug(this, "ILU::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("ILU::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
     assert(x != &rhs);
@@ -599,6 +610,8 @@ void ILUT<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vec
 {
     log_debug(this, "ILUT::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("ILUT::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
     assert(x != &rhs);
@@ -692,6 +705,8 @@ void IC<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vecto
 {
     log_debug(this, "IC::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("IC::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
     assert(x != &rhs);
@@ -809,6 +824,8 @@ void VariablePreconditioner<OperatorType, VectorType, ValueType>::Solve(const Ve
 {
     log_debug(this, "VariablePreconditioner::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("VariablePreconditioner::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
 
@@ -880,6 +897,28 @@ template class Preconditioner<GlobalMatrix<std::complex<float>>,
                               std::complex<float>>;
 #endif
 
+template class Preconditioner<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class Preconditioner<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class Preconditioner<LocalCallbackOperator<std::complex<double>>,
+                              LocalVector<std::complex<double>>,
+                              std::complex<double>>;
+template class Preconditioner<LocalCallbackOperator<std::complex<float>>,
+                              LocalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
+template class Preconditioner<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class Preconditioner<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class Preconditioner<GlobalCallbackOperator<std::complex<double>>,
+                              GlobalVector<std::complex<double>>,
+                              std::complex<double>>;
+template class Preconditioner<GlobalCallbackOperator<std::complex<float>>,
+                              GlobalVector<std::complex<float>>,
+                              std::complex<float>>;
+#endif
+
 template class Jacobi<LocalMatrix<double>, LocalVector<double>, double>;
 template class Jacobi<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -902,6 +941,28 @@ template class Jacobi<GlobalMatrix<std::complex<float>>,
                       std::complex<float>>;
 #endif
 
+template class Jacobi<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class Jacobi<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class Jacobi<LocalCallbackOperator<std::complex<double>>,
+                      LocalVector<std::complex<double>>,
+                      std::complex<double>>;
+template class Jacobi<LocalCallbackOperator<std::complex<float>>,
+                      LocalVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
+template class Jacobi<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class Jacobi<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class Jacobi<GlobalCallbackOperator<std::complex<double>>,
+                      GlobalVector<std::complex<double>>,
+                      std::complex<double>>;
+template class Jacobi<GlobalCallbackOperator<std::complex<float>>,
+                      GlobalVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
 template class GS<LocalMatrix<double>, LocalVector<double>, double>;
 template class GS<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -32,7 +32,8 @@ namespace rocalution {
   * \class Preconditioner
   * \brief Base class for all preconditioners
   *
-  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalCallbackOperator or
+  *                        GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -65,7 +66,8 @@ class Preconditioner : public Solver<OperatorType, VectorType, ValueType>
   *   \right)
   * \f]
   *
-  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalCallbackOperator or
+  *                        GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
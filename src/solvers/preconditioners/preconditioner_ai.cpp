@@ -26,16 +26,185 @@
 #include "../solver.hpp"
 
 #include "../../base/local_matrix.hpp"
+#include "../../base/local_callback_operator.hpp"
 
 #include "../../base/local_vector.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 
 #include <math.h>
+#include <algorithm>
 #include <complex>
 
 namespace rocalution {
 
+// Assemble the polynomial p(A) ~ A^-1 explicitly as a matrix
+template <class OperatorType, class VectorType, typename ValueType>
+static void ai_chebyshev_build(const OperatorType& op,
+                               int p,
+                               ValueType lambda_min,
+                               ValueType lambda_max,
+                               OperatorType* ai,
+                               VectorType* work)
+{
+    ai->CloneFrom(op);
+
+    ValueType q = (static_cast<ValueType>(1) - sqrt(lambda_min / lambda_max)) /
+                  (static_cast<ValueType>(1) + sqrt(lambda_min / lambda_max));
+    ValueType c = static_cast<ValueType>(1) / sqrt(lambda_min * lambda_max);
+
+    // Shifting
+    // Z = 2/(beta-alpha) [A-(beta+alpha)/2]
+    OperatorType Z;
+    Z.CloneFrom(op);
+
+    Z.AddScalarDiagonal(static_cast<ValueType>(-1) * (lambda_max + lambda_min) /
+                        (static_cast<ValueType>(2)));
+    Z.ScaleDiagonal(static_cast<ValueType>(2) / (lambda_max - lambda_min));
+
+    // Chebyshev formula/series
+    // ai = I c_0 / 2 + sum c_k T_k
+    // Tk = 2 Z T_k-1 - T_k-2
+
+    // 1st term
+    // T_0 = I
+    // ai = I c_0 / 2
+    ai->AddScalarDiagonal(c / static_cast<ValueType>(2));
+
+    OperatorType Tkm2;
+    Tkm2.CloneFrom(Z);
+    // 2nd term
+    // T_1 = Z
+    // ai = ai + c_1 Z
+    c = c * static_cast<ValueType>(-1) * q;
+    ai->MatrixAdd(Tkm2, static_cast<ValueType>(1), c, true);
+
+    // T_2 = 2*Z*Z - I
+    // + c (2*Z*Z - I)
+    OperatorType Tkm1;
+    Tkm1.CloneBackend(op);
+    Tkm1.MatrixMult(Z, Z);
+    Tkm1.Scale(static_cast<ValueType>(2));
+    Tkm1.AddScalarDiagonal(static_cast<ValueType>(-1));
+
+    c = c * static_cast<ValueType>(-1) * q;
+    ai->MatrixAdd(Tkm1, static_cast<ValueType>(1), c, true);
+
+    // T_k = 2 Z T_k-1 - T_k-2
+    OperatorType Tk;
+    Tk.CloneBackend(op);
+
+    for(int i = 2; i <= p; ++i)
+    {
+        Tk.MatrixMult(Z, Tkm1);
+        Tk.MatrixAdd(Tkm2, static_cast<ValueType>(2), static_cast<ValueType>(-1), true);
+
+        c = c * static_cast<ValueType>(-1) * q;
+        ai->MatrixAdd(Tk, static_cast<ValueType>(1), c, true);
+
+        if(i + 1 <= p)
+        {
+            Tkm2.CloneFrom(Tkm1);
+            Tkm1.CloneFrom(Tk);
+        }
+    }
+}
+
+// A matrix-free operator cannot be multiplied, p(A) is evaluated in ai_chebyshev_apply()
+template <typename ValueType>
+static void ai_chebyshev_build(const LocalCallbackOperator<ValueType>& op,
+                               int p,
+                               ValueType lambda_min,
+                               ValueType lambda_max,
+                               LocalCallbackOperator<ValueType>* ai,
+                               LocalVector<ValueType>* work)
+{
+    for(int i = 0; i < 3; ++i)
+    {
+        work[i].CloneBackend(op);
+        work[i].Allocate("AIChebyshev work", op.GetM());
+    }
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+static void ai_chebyshev_apply(const OperatorType& op,
+                               int p,
+                               ValueType lambda_min,
+                               ValueType lambda_max,
+                               const OperatorType& ai,
+                               VectorType* work,
+                               const VectorType& rhs,
+                               VectorType* x)
+{
+    ai.Apply(rhs, x);
+}
+
+// x = p(A) rhs by the three-term recurrence T_k = 2 Z T_k-1 - T_k-2, which costs one
+// operator application per degree of the polynomial
+template <typename ValueType>
+static void ai_chebyshev_apply(const LocalCallbackOperator<ValueType>& op,
+                               int p,
+                               ValueType lambda_min,
+                               ValueType lambda_max,
+                               const LocalCallbackOperator<ValueType>& ai,
+                               LocalVector<ValueType>* work,
+                               const LocalVector<ValueType>& rhs,
+                               LocalVector<ValueType>* x)
+{
+    ValueType q = (static_cast<ValueType>(1) - sqrt(lambda_min / lambda_max)) /
+                  (static_cast<ValueType>(1) + sqrt(lambda_min / lambda_max));
+    ValueType c = static_cast<ValueType>(1) / sqrt(lambda_min * lambda_max);
+
+    // Z = s (A - m I)
+    ValueType s = static_cast<ValueType>(2) / (lambda_max - lambda_min);
+    ValueType m = (lambda_max + lambda_min) / static_cast<ValueType>(2);
+
+    LocalVector<ValueType>* Tk   = &work[0];
+    LocalVector<ValueType>* Tkm1 = &work[1];
+    LocalVector<ValueType>* Tkm2 = &work[2];
+
+    // T_0 = rhs
+    // x = c_0 / 2 T_0
+    x->CopyFrom(rhs);
+    x->Scale(c / static_cast<ValueType>(2));
+
+    // T_1 = Z rhs
+    op.Apply(rhs, Tkm1);
+    Tkm1->ScaleAddScale(s, rhs, -s * m);
+
+    c = c * static_cast<ValueType>(-1) * q;
+    x->AddScale(*Tkm1, c);
+
+    // T_2 = 2 Z T_1 - T_0
+    op.Apply(*Tkm1, Tk);
+    Tk->ScaleAdd2(static_cast<ValueType>(2) * s,
+                  *Tkm1,
+                  static_cast<ValueType>(-2) * s * m,
+                  rhs,
+                  static_cast<ValueType>(-1));
+
+    c = c * static_cast<ValueType>(-1) * q;
+    x->AddScale(*Tk, c);
+
+    // Same degree as the assembled polynomial
+    for(int i = 2; i <= p; ++i)
+    {
+        std::swap(Tkm2, Tkm1);
+        std::swap(Tkm1, Tk);
+
+        op.Apply(*Tkm1, Tk);
+        Tk->ScaleAdd2(static_cast<ValueType>(2) * s,
+                      *Tkm1,
+                      static_cast<ValueType>(-2) * s * m,
+                      *Tkm2,
+                      static_cast<ValueType>(-1));
+
+        c = c * static_cast<ValueType>(-1) * q;
+        x->AddScale(*Tk, c);
+    }
+}
+
 template <class OperatorType, class VectorType, typename ValueType>
 AIChebyshev<OperatorType, VectorType, ValueType>::AIChebyshev()
 {
@@ -97,67 +266,12 @@ void AIChebyshev<OperatorType, VectorType, ValueType>::Build(void)
 
     assert(this->op_ != NULL);
 
-    this->AIChebyshev_.CloneFrom(*this->op_);
-
-    ValueType q = (static_cast<ValueType>(1) - sqrt(this->lambda_min_ / this->lambda_max_)) /
-                  (static_cast<ValueType>(1) + sqrt(this->lambda_min_ / this->lambda_max_));
-    ValueType c = static_cast<ValueType>(1) / sqrt(this->lambda_min_ * this->lambda_max_);
-
-    // Shifting
-    // Z = 2/(beta-alpha) [A-(beta+alpha)/2]
-    OperatorType Z;
-    Z.CloneFrom(*this->op_);
-
-    Z.AddScalarDiagonal(static_cast<ValueType>(-1) * (this->lambda_max_ + this->lambda_min_) /
-                        (static_cast<ValueType>(2)));
-    Z.ScaleDiagonal(static_cast<ValueType>(2) / (this->lambda_max_ - this->lambda_min_));
-
-    // Chebyshev formula/series
-    // ai = I c_0 / 2 + sum c_k T_k
-    // Tk = 2 Z T_k-1 - T_k-2
-
-    // 1st term
-    // T_0 = I
-    // ai = I c_0 / 2
-    this->AIChebyshev_.AddScalarDiagonal(c / static_cast<ValueType>(2));
-
-    OperatorType Tkm2;
-    Tkm2.CloneFrom(Z);
-    // 2nd term
-    // T_1 = Z
-    // ai = ai + c_1 Z
-    c = c * static_cast<ValueType>(-1) * q;
-    this->AIChebyshev_.MatrixAdd(Tkm2, static_cast<ValueType>(1), c, true);
-
-    // T_2 = 2*Z*Z - I
-    // + c (2*Z*Z - I)
-    OperatorType Tkm1;
-    Tkm1.CloneBackend(*this->op_);
-    Tkm1.MatrixMult(Z, Z);
-    Tkm1.Scale(static_cast<ValueType>(2));
-    Tkm1.AddScalarDiagonal(static_cast<ValueType>(-1));
-
-    c = c * static_cast<ValueType>(-1) * q;
-    this->AIChebyshev_.MatrixAdd(Tkm1, static_cast<ValueType>(1), c, true);
-
-    // T_k = 2 Z T_k-1 - T_k-2
-    OperatorType Tk;
-    Tk.CloneBackend(*this->op_);
-
-    for(int i = 2; i <= this->p_; ++i)
-    {
-        Tk.MatrixMult(Z, Tkm1);
-        Tk.MatrixAdd(Tkm2, static_cast<ValueType>(2), static_cast<ValueType>(-1), true);
-
-        c = c * static_cast<ValueType>(-1) * q;
-        this->AIChebyshev_.MatrixAdd(Tk, static_cast<ValueType>(1), c, true);
-
-        if(i + 1 <= this->p_)
-        {
-            Tkm2.CloneFrom(Tkm1);
-            Tkm1.CloneFrom(Tk);
-        }
-    }
+    ai_chebyshev_build(*this->op_,
+                       this->p_,
+                       this->lambda_min_,
+                       this->lambda_max_,
+                       &this->AIChebyshev_,
+                       this->work_);
 
     log_debug(this, "AIChebyshev::Build()", this->build_, " #*# end");
 }
@@ -168,6 +282,12 @@ void AIChebyshev<OperatorType, VectorType, ValueType>::Clear(void)
     log_debug(this, "AIChebyshev::Clear()", this->build_);
 
     this->AIChebyshev_.Clear();
+
+    for(int i = 0; i < 3; ++i)
+    {
+        this->work_[i].Clear();
+    }
+
     this->build_ = false;
 }
 
@@ -177,6 +297,11 @@ void AIChebyshev<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void
     log_debug(this, "AIChebyshev::MoveToHostLocalData_()", this->build_);
 
     this->AIChebyshev_.MoveToHost();
+
+    for(int i = 0; i < 3; ++i)
+    {
+        this->work_[i].MoveToHost();
+    }
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -185,6 +310,11 @@ void AIChebyshev<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalDat
     log_debug(this, "AIChebyshev::MoveToAcceleratorLocalData_()", this->build_);
 
     this->AIChebyshev_.MoveToAccelerator();
+
+    for(int i = 0; i < 3; ++i)
+    {
+        this->work_[i].MoveToAccelerator();
+    }
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -192,11 +322,20 @@ void AIChebyshev<OperatorType, VectorType, ValueType>::Solve(const VectorType& r
 {
     log_debug(this, "AIChebyshev::Solve()", " #*# begin");
 
+    ROCALUTION_TRACE_SCOPE("AIChebyshev::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
     assert(x != &rhs);
 
-    this->AIChebyshev_.Apply(rhs, x);
+    ai_chebyshev_apply(*this->op_,
+                       this->p_,
+                       this->lambda_min_,
+                       this->lambda_max_,
+                       this->AIChebyshev_,
+                       this->work_,
+                       rhs,
+                       x);
 
     log_debug(this, "AIChebyshev::Solve()", " #*# end");
 }
@@ -344,6 +483,8 @@ void FSAI<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vec
 {
     log_debug(this, "FSAI::Solve()", " #*# begin");
 
+    ROCALUTION_TRACE_SCOPE("FSAI::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
     assert(x != &rhs);
@@ -454,6 +595,8 @@ void SPAI<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vec
 {
     log_debug(this, "SPAI::Solve()", " #*# begin");
 
+    ROCALUTION_TRACE_SCOPE("SPAI::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
     assert(x != &rhs);
@@ -663,6 +806,8 @@ void TNS<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vect
 {
     log_debug(this, "TNS::Solve()", " #*# begin");
 
+    ROCALUTION_TRACE_SCOPE("TNS::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
     assert(x != &rhs);
@@ -712,6 +857,17 @@ template class AIChebyshev<LocalMatrix<std::complex<float>>,
                            std::complex<float>>;
 #endif
 
+template class AIChebyshev<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class AIChebyshev<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class AIChebyshev<LocalCallbackOperator<std::complex<double>>,
+                           LocalVector<std::complex<double>>,
+                           std::complex<double>>;
+template class AIChebyshev<LocalCallbackOperator<std::complex<float>>,
+                           LocalVector<std::complex<float>>,
+                           std::complex<float>>;
+#endif
+
 template class FSAI<LocalMatrix<double>, LocalVector<double>, double>;
 template class FSAI<LocalMatrix<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
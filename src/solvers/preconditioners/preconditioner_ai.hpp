@@ -37,8 +37,11 @@ namespace rocalution {
   * preconditioner with values from a linear combination of matrix-valued
   * Chebyshev polynomials.
   * \cite chebpoly
+  * For a LocalCallbackOperator, the polynomial cannot be assembled. Instead, it is
+  * applied to the vector in each Solve(), which requires one operator application per
+  * polynomial degree.
   *
-  * \tparam OperatorType - can be LocalMatrix
+  * \tparam OperatorType - can be LocalMatrix or LocalCallbackOperator
   * \tparam VectorType - can be LocalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -63,6 +66,8 @@ class AIChebyshev : public Preconditioner<OperatorType, VectorType, ValueType>
 
     private:
     OperatorType AIChebyshev_;
+    // Work vectors of the matrix-free polynomial evaluation
+    VectorType work_[3];
     int p_;
     ValueType lambda_min_, lambda_max_;
 };
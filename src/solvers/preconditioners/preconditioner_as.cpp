@@ -28,6 +28,7 @@
 #include "../../base/local_vector.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 
 #include "preconditioner.hpp"
 
@@ -236,6 +237,8 @@ void AS<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vecto
 {
     log_debug(this, "AS::Solve_()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("AS::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
     assert(x != &rhs);
@@ -343,6 +346,8 @@ void RAS<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, Vect
 {
     log_debug(this, "RAS::Solve_()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("RAS::Solve", "preconditioner");
+
     assert(this->build_ == true);
     assert(x != NULL);
     assert(x != &rhs);
@@ -31,6 +31,7 @@
 #include "../../base/local_vector.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 
 #include "preconditioner.hpp"
 
@@ -133,6 +134,8 @@ void BlockJacobi<OperatorType, VectorType, ValueType>::Solve(const VectorType& r
 {
     log_debug(this, "BlockJacobi::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("BlockJacobi::Solve", "preconditioner");
+
     this->local_precond_->Solve(rhs.GetInterior(), &x->GetInterior());
 
     log_debug(this, "BlockJacobi::Solve()", " #*# end");
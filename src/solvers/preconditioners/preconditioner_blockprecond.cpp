@@ -32,6 +32,7 @@
 
 #include "../../utils/allocate_free.hpp"
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 
 #include <complex>
 
@@ -321,6 +322,8 @@ void BlockPreconditioner<OperatorType, VectorType, ValueType>::Solve(const Vecto
 {
     log_debug(this, ":BlockPreconditioner:Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("BlockPreconditioner::Solve", "preconditioner");
+
     assert(this->build_ == true);
 
     // Extract RHS into the solution
@@ -0,0 +1,539 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#include "../../utils/def.hpp"
+#include "preconditioner_l1.hpp"
+#include "preconditioner.hpp"
+#include "../solver.hpp"
+#include "../../base/global_matrix.hpp"
+#include "../../base/local_matrix.hpp"
+
+#include "../../base/global_vector.hpp"
+#include "../../base/local_vector.hpp"
+
+#include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
+#include "../../utils/allocate_free.hpp"
+#include "../../utils/math_functions.hpp"
+
+#include <math.h>
+#include <complex>
+#include <vector>
+
+namespace rocalution {
+
+// Copy the matrix op into l1 (host, CSR) and add l1_norm and, if interior is true, the
+// l1 norm of the off-diagonal entries of each row to its diagonal entry
+template <typename ValueType>
+static void l1_add_row_norms(const LocalMatrix<ValueType>& op,
+                             bool interior,
+                             std::vector<ValueType>& l1_norm,
+                             LocalMatrix<ValueType>* l1)
+{
+    int nrow = op.GetM();
+
+    l1->Clear();
+    l1->CloneFrom(op);
+    l1->MoveToHost();
+    l1->ConvertToCSR();
+    l1->Sort();
+
+    int nnz         = l1->GetNnz();
+    int* row_offset = NULL;
+    int* col        = NULL;
+    ValueType* val  = NULL;
+
+    l1->LeaveDataPtrCSR(&row_offset, &col, &val);
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < nrow; ++i)
+    {
+        int diag = -1;
+
+        for(int j = row_offset[i]; j < row_offset[i + 1]; ++j)
+        {
+            if(col[j] == i)
+            {
+                diag = j;
+            }
+            else if(interior == true)
+            {
+                l1_norm[i] += static_cast<ValueType>(rocalution_abs(val[j]));
+            }
+        }
+
+        // The l1 smoothers require a non-zero diagonal
+        assert(diag != -1);
+
+        val[diag] += l1_norm[i];
+    }
+
+    l1->SetDataPtrCSR(&row_offset, &col, &val, "l1", nnz, nrow, nrow);
+}
+
+// Copy the matrix op into l1 (host, CSR) and add the l1 norm of the off-diagonal
+// entries of each row to its diagonal entry
+template <typename ValueType>
+static void l1_interior_matrix(const LocalMatrix<ValueType>& op,
+                               bool interior,
+                               LocalMatrix<ValueType>* l1)
+{
+    std::vector<ValueType> l1_norm(op.GetM(), static_cast<ValueType>(0));
+
+    l1_add_row_norms(op, interior, l1_norm, l1);
+}
+
+// Copy the interior matrix of op into l1 (host, CSR) and add the l1 norm of the
+// off-diagonal couplings of each row to its diagonal entry. If interior is false, only
+// the couplings to other processes (ghost part) are accounted for.
+template <typename ValueType>
+static void l1_interior_matrix(const GlobalMatrix<ValueType>& op,
+                               bool interior,
+                               LocalMatrix<ValueType>* l1)
+{
+    int nrow = op.GetLocalM();
+
+    std::vector<ValueType> l1_norm(nrow, static_cast<ValueType>(0));
+
+    // l1 norm of the ghost part of each row
+    if(op.GetGhostNnz() > 0)
+    {
+        LocalMatrix<ValueType> ghost;
+        ghost.CloneFrom(op.GetGhost());
+        ghost.MoveToHost();
+        ghost.ConvertToCOO();
+
+        int nnz        = ghost.GetNnz();
+        int* row       = NULL;
+        int* col       = NULL;
+        ValueType* val = NULL;
+
+        ghost.LeaveDataPtrCOO(&row, &col, &val);
+
+        for(int i = 0; i < nnz; ++i)
+        {
+            l1_norm[row[i]] += static_cast<ValueType>(rocalution_abs(val[i]));
+        }
+
+        free_host(&row);
+        free_host(&col);
+        free_host(&val);
+    }
+
+    l1_add_row_norms(op.GetInterior(), interior, l1_norm, l1);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+L1Jacobi<OperatorType, VectorType, ValueType>::L1Jacobi()
+{
+    log_debug(this, "L1Jacobi::L1Jacobi()", "default constructor");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+L1Jacobi<OperatorType, VectorType, ValueType>::~L1Jacobi()
+{
+    log_debug(this, "L1Jacobi::~L1Jacobi()", "destructor");
+
+    this->Clear();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1Jacobi<OperatorType, VectorType, ValueType>::Print(void) const
+{
+    LOG_INFO("l1-Jacobi preconditioner");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1Jacobi<OperatorType, VectorType, ValueType>::Build(void)
+{
+    log_debug(this, "L1Jacobi::Build()", this->build_, " #*# begin");
+
+    if(this->build_ == true)
+    {
+        this->Clear();
+    }
+
+    assert(this->build_ == false);
+    this->build_ = true;
+
+    assert(this->op_ != NULL);
+
+    LocalMatrix<ValueType> l1;
+    l1_interior_matrix(*this->op_, true, &l1);
+
+    l1.ExtractInverseDiagonal(&this->inv_diag_entries_);
+    this->inv_diag_entries_.CloneBackend(*this->op_);
+
+    log_debug(this, "L1Jacobi::Build()", this->build_, " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1Jacobi<OperatorType, VectorType, ValueType>::ResetOperator(const OperatorType& op)
+{
+    log_debug(this, "L1Jacobi::ResetOperator()", this->build_, (const void*&)op);
+
+    assert(this->op_ != NULL);
+
+    LocalMatrix<ValueType> l1;
+    l1_interior_matrix(*this->op_, true, &l1);
+
+    this->inv_diag_entries_.Clear();
+    this->inv_diag_entries_.MoveToHost();
+
+    l1.ExtractInverseDiagonal(&this->inv_diag_entries_);
+    this->inv_diag_entries_.CloneBackend(*this->op_);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1Jacobi<OperatorType, VectorType, ValueType>::Clear(void)
+{
+    log_debug(this, "L1Jacobi::Clear()", this->build_);
+
+    this->inv_diag_entries_.Clear();
+    this->build_ = false;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1Jacobi<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, VectorType* x)
+{
+    log_debug(this, "L1Jacobi::Solve()", " #*# begin", (const void*&)rhs, x);
+
+    ROCALUTION_TRACE_SCOPE("L1Jacobi::Solve", "preconditioner");
+
+    assert(this->build_ == true);
+    assert(x != NULL);
+
+    if(x != &rhs)
+    {
+        x->GetInterior().PointWiseMult(this->inv_diag_entries_, rhs.GetInterior());
+    }
+    else
+    {
+        x->GetInterior().PointWiseMult(this->inv_diag_entries_);
+    }
+
+    log_debug(this, "L1Jacobi::Solve()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1Jacobi<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+{
+    log_debug(this, "L1Jacobi::MoveToHostLocalData_()", this->build_);
+
+    this->inv_diag_entries_.MoveToHost();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1Jacobi<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+{
+    log_debug(this, "L1Jacobi::MoveToAcceleratorLocalData_()", this->build_);
+
+    this->inv_diag_entries_.MoveToAccelerator();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+L1GS<OperatorType, VectorType, ValueType>::L1GS()
+{
+    log_debug(this, "L1GS::L1GS()", "default constructor");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+L1GS<OperatorType, VectorType, ValueType>::~L1GS()
+{
+    log_debug(this, "L1GS::~L1GS()", "destructor");
+
+    this->Clear();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1GS<OperatorType, VectorType, ValueType>::Print(void) const
+{
+    LOG_INFO("Hybrid l1-Gauss-Seidel (l1-GS) preconditioner");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1GS<OperatorType, VectorType, ValueType>::Build(void)
+{
+    log_debug(this, "L1GS::Build()", this->build_, " #*# begin");
+
+    if(this->build_ == true)
+    {
+        this->Clear();
+    }
+
+    assert(this->build_ == false);
+    this->build_ = true;
+
+    assert(this->op_ != NULL);
+
+    l1_interior_matrix(*this->op_, false, &this->GS_);
+
+    this->GS_.CloneBackend(*this->op_);
+    this->GS_.LAnalyse(false);
+
+    log_debug(this, "L1GS::Build()", this->build_, " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1GS<OperatorType, VectorType, ValueType>::ResetOperator(const OperatorType& op)
+{
+    log_debug(this, "L1GS::ResetOperator()", this->build_, (const void*&)op);
+
+    assert(this->op_ != NULL);
+
+    this->GS_.LAnalyseClear();
+
+    l1_interior_matrix(*this->op_, false, &this->GS_);
+
+    this->GS_.CloneBackend(*this->op_);
+    this->GS_.LAnalyse(false);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1GS<OperatorType, VectorType, ValueType>::Clear(void)
+{
+    log_debug(this, "L1GS::Clear()", this->build_);
+
+    this->GS_.Clear();
+    this->GS_.LAnalyseClear();
+
+    this->build_ = false;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1GS<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, VectorType* x)
+{
+    log_debug(this, "L1GS::Solve()", " #*# begin", (const void*&)rhs, x);
+
+    ROCALUTION_TRACE_SCOPE("L1GS::Solve", "preconditioner");
+
+    assert(this->build_ == true);
+    assert(x != NULL);
+
+    this->GS_.LSolve(rhs.GetInterior(), &x->GetInterior());
+
+    log_debug(this, "L1GS::Solve()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1GS<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+{
+    log_debug(this, "L1GS::MoveToHostLocalData_()", this->build_);
+
+    this->GS_.MoveToHost();
+    this->GS_.LAnalyse(false);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1GS<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+{
+    log_debug(this, "L1GS::MoveToAcceleratorLocalData_()", this->build_);
+
+    this->GS_.MoveToAccelerator();
+    this->GS_.LAnalyse(false);
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+L1SGS<OperatorType, VectorType, ValueType>::L1SGS()
+{
+    log_debug(this, "L1SGS::L1SGS()", "default constructor");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+L1SGS<OperatorType, VectorType, ValueType>::~L1SGS()
+{
+    log_debug(this, "L1SGS::~L1SGS()", "destructor");
+
+    this->Clear();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1SGS<OperatorType, VectorType, ValueType>::Print(void) const
+{
+    LOG_INFO("Hybrid symmetric l1-Gauss-Seidel (l1-SGS) preconditioner");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1SGS<OperatorType, VectorType, ValueType>::Build(void)
+{
+    log_debug(this, "L1SGS::Build()", this->build_, " #*# begin");
+
+    if(this->build_ == true)
+    {
+        this->Clear();
+    }
+
+    assert(this->build_ == false);
+    this->build_ = true;
+
+    assert(this->op_ != NULL);
+
+    l1_interior_matrix(*this->op_, false, &this->SGS_);
+
+    this->SGS_.ExtractDiagonal(&this->diag_entries_);
+
+    this->SGS_.CloneBackend(*this->op_);
+    this->SGS_.LAnalyse(false);
+    this->SGS_.UAnalyse(false);
+
+    this->diag_entries_.CloneBackend(*this->op_);
+
+    this->v_.CloneBackend(*this->op_);
+    this->v_.Allocate("v", this->op_->GetLocalM());
+
+    log_debug(this, "L1SGS::Build()", this->build_, " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1SGS<OperatorType, VectorType, ValueType>::ResetOperator(const OperatorType& op)
+{
+    log_debug(this, "L1SGS::ResetOperator()", this->build_, (const void*&)op);
+
+    assert(this->op_ != NULL);
+
+    this->SGS_.LAnalyseClear();
+    this->SGS_.UAnalyseClear();
+
+    l1_interior_matrix(*this->op_, false, &this->SGS_);
+
+    this->diag_entries_.Clear();
+    this->diag_entries_.MoveToHost();
+    this->SGS_.ExtractDiagonal(&this->diag_entries_);
+
+    this->SGS_.CloneBackend(*this->op_);
+    this->SGS_.LAnalyse(false);
+    this->SGS_.UAnalyse(false);
+
+    this->diag_entries_.CloneBackend(*this->op_);
+
+    this->v_.Clear();
+    this->v_.CloneBackend(*this->op_);
+    this->v_.Allocate("v", this->op_->GetLocalM());
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1SGS<OperatorType, VectorType, ValueType>::Clear(void)
+{
+    log_debug(this, "L1SGS::Clear()", this->build_);
+
+    this->SGS_.Clear();
+    this->SGS_.LAnalyseClear();
+    this->SGS_.UAnalyseClear();
+
+    this->diag_entries_.Clear();
+    this->v_.Clear();
+
+    this->build_ = false;
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1SGS<OperatorType, VectorType, ValueType>::Solve(const VectorType& rhs, VectorType* x)
+{
+    log_debug(this, "L1SGS::Solve()", " #*# begin", (const void*&)rhs, x);
+
+    ROCALUTION_TRACE_SCOPE("L1SGS::Solve", "preconditioner");
+
+    assert(this->build_ == true);
+    assert(x != NULL);
+
+    this->SGS_.LSolve(rhs.GetInterior(), &this->v_);
+    this->v_.PointWiseMult(this->diag_entries_);
+    this->SGS_.USolve(this->v_, &x->GetInterior());
+
+    log_debug(this, "L1SGS::Solve()", " #*# end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1SGS<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
+{
+    log_debug(this, "L1SGS::MoveToHostLocalData_()", this->build_);
+
+    this->SGS_.MoveToHost();
+    this->SGS_.LAnalyse(false);
+    this->SGS_.UAnalyse(false);
+
+    this->diag_entries_.MoveToHost();
+    this->v_.MoveToHost();
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void L1SGS<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalData_(void)
+{
+    log_debug(this, "L1SGS::MoveToAcceleratorLocalData_()", this->build_);
+
+    this->SGS_.MoveToAccelerator();
+    this->SGS_.LAnalyse(false);
+    this->SGS_.UAnalyse(false);
+
+    this->diag_entries_.MoveToAccelerator();
+    this->v_.MoveToAccelerator();
+}
+
+template class L1Jacobi<LocalMatrix<double>, LocalVector<double>, double>;
+template class L1Jacobi<LocalMatrix<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class L1Jacobi<LocalMatrix<std::complex<double>>,
+                        LocalVector<std::complex<double>>,
+                        std::complex<double>>;
+template class L1Jacobi<LocalMatrix<std::complex<float>>,
+                        LocalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+template class L1Jacobi<GlobalMatrix<double>, GlobalVector<double>, double>;
+template class L1Jacobi<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class L1Jacobi<GlobalMatrix<std::complex<double>>,
+                        GlobalVector<std::complex<double>>,
+                        std::complex<double>>;
+template class L1Jacobi<GlobalMatrix<std::complex<float>>,
+                        GlobalVector<std::complex<float>>,
+                        std::complex<float>>;
+#endif
+
+template class L1GS<GlobalMatrix<double>, GlobalVector<double>, double>;
+template class L1GS<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class L1GS<GlobalMatrix<std::complex<double>>,
+                    GlobalVector<std::complex<double>>,
+                    std::complex<double>>;
+template class L1GS<GlobalMatrix<std::complex<float>>,
+                    GlobalVector<std::complex<float>>,
+                    std::complex<float>>;
+#endif
+
+template class L1SGS<GlobalMatrix<double>, GlobalVector<double>, double>;
+template class L1SGS<GlobalMatrix<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class L1SGS<GlobalMatrix<std::complex<double>>,
+                     GlobalVector<std::complex<double>>,
+                     std::complex<double>>;
+template class L1SGS<GlobalMatrix<std::complex<float>>,
+                     GlobalVector<std::complex<float>>,
+                     std::complex<float>>;
+#endif
+
+} // namespace rocalution
@@ -0,0 +1,160 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+
+#ifndef ROCALUTION_PRECONDITIONER_L1_HPP_
+#define ROCALUTION_PRECONDITIONER_L1_HPP_
+
+#include "preconditioner.hpp"
+
+namespace rocalution {
+
+template <typename ValueType>
+class LocalMatrix;
+template <typename ValueType>
+class LocalVector;
+
+/** \ingroup precond_module
+  * \class L1Jacobi
+  * \brief l1-Jacobi Method
+  * \details
+  * The l1-Jacobi method scales each row with the l1 norm of the row instead of the
+  * diagonal entry, such that
+  * \f[
+  *   x_{i} = \frac{b_{i}}{d_{i}^{\ell_1}}, \quad
+  *   d_{i}^{\ell_1} = a_{ii} + \sum\limits_{j \neq i}{|a_{ij}|}.
+  * \f]
+  * In contrast to the Jacobi method, the l1-Jacobi method converges as a smoother
+  * without the need of a damping parameter. For a GlobalMatrix, the row norms include
+  * the couplings to other processes.
+  * \cite l1smoother
+  *
+  * \tparam OperatorType - can be LocalMatrix or GlobalMatrix
+  * \tparam VectorType - can be LocalVector or GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+template <class OperatorType, class VectorType, typename ValueType>
+class L1Jacobi : public Preconditioner<OperatorType, VectorType, ValueType>
+{
+    public:
+    L1Jacobi();
+    virtual ~L1Jacobi();
+
+    virtual void Print(void) const;
+    virtual void Solve(const VectorType& rhs, VectorType* x);
+    virtual void Build(void);
+    virtual void Clear(void);
+
+    virtual void ResetOperator(const OperatorType& op);
+
+    protected:
+    virtual void MoveToHostLocalData_(void);
+    virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+    LocalVector<ValueType> inv_diag_entries_;
+};
+
+/** \ingroup precond_module
+  * \class L1GS
+  * \brief Hybrid l1-Gauss-Seidel Method
+  * \details
+  * The hybrid l1-Gauss-Seidel method performs a Gauss-Seidel sweep on the interior
+  * matrix of each process, while the couplings to other processes are treated in a
+  * Jacobi fashion. Each diagonal entry is enlarged by the l1 norm of the ghost part of
+  * its row,
+  * \f[
+  *   d_{i}^{\ell_1} = a_{ii} + \sum\limits_{j \in \textrm{ghost}}{|a_{ij}|},
+  * \f]
+  * which keeps the method convergent independently of the number of processes. Used as
+  * a smoother, the ghost values are exchanged only once per sweep.
+  * \cite l1smoother
+  *
+  * \tparam OperatorType - can be GlobalMatrix
+  * \tparam VectorType - can be GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+template <class OperatorType, class VectorType, typename ValueType>
+class L1GS : public Preconditioner<OperatorType, VectorType, ValueType>
+{
+    public:
+    L1GS();
+    virtual ~L1GS();
+
+    virtual void Print(void) const;
+    virtual void Solve(const VectorType& rhs, VectorType* x);
+    virtual void Build(void);
+    virtual void Clear(void);
+
+    virtual void ResetOperator(const OperatorType& op);
+
+    protected:
+    virtual void MoveToHostLocalData_(void);
+    virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+    LocalMatrix<ValueType> GS_;
+};
+
+/** \ingroup precond_module
+  * \class L1SGS
+  * \brief Hybrid Symmetric l1-Gauss-Seidel Method
+  * \details
+  * The hybrid symmetric l1-Gauss-Seidel method performs a forward and a backward
+  * Gauss-Seidel sweep on the interior matrix of each process with the l1 diagonal of
+  * the L1GS method. The resulting preconditioner is symmetric and can be used with
+  * the CG method.
+  * \cite l1smoother
+  *
+  * \tparam OperatorType - can be GlobalMatrix
+  * \tparam VectorType - can be GlobalVector
+  * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
+  */
+template <class OperatorType, class VectorType, typename ValueType>
+class L1SGS : public Preconditioner<OperatorType, VectorType, ValueType>
+{
+    public:
+    L1SGS();
+    virtual ~L1SGS();
+
+    virtual void Print(void) const;
+    virtual void Solve(const VectorType& rhs, VectorType* x);
+    virtual void Build(void);
+    virtual void Clear(void);
+
+    virtual void ResetOperator(const OperatorType& op);
+
+    protected:
+    virtual void MoveToHostLocalData_(void);
+    virtual void MoveToAcceleratorLocalData_(void);
+
+    private:
+    LocalMatrix<ValueType> SGS_;
+
+    LocalVector<ValueType> diag_entries_;
+    LocalVector<ValueType> v_;
+};
+
+} // namespace rocalution
+
+#endif // ROCALUTION_PRECONDITIONER_L1_HPP_
@@ -31,6 +31,7 @@
 #include "../../base/local_vector.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 #include "../../utils/allocate_free.hpp"
 
 #include <complex>
@@ -42,12 +43,17 @@ MultiColored<OperatorType, VectorType, ValueType>::MultiColored()
 {
     log_debug(this, "MultiColored::MultiColored()", "default constructor");
 
-    this->num_blocks_  = 0;
-    this->block_sizes_ = NULL;
+    this->num_blocks_    = 0;
+    this->block_sizes_   = NULL;
+    this->block_offsets_ = NULL;
 
     this->preconditioner_ = NULL;
     this->analyzer_op_    = NULL;
 
+    this->preconditioner_block_ = NULL;
+    this->x_block_              = NULL;
+    this->inv_diag_block_       = NULL;
+
     this->op_mat_format_      = false;
     this->precond_mat_format_ = CSR;
 
@@ -69,35 +75,11 @@ void MultiColored<OperatorType, VectorType, ValueType>::Clear(void)
 
     if(this->build_ == true)
     {
+        this->ClearBlocks_();
+
         delete this->preconditioner_;
         this->preconditioner_ = NULL;
 
-        if(this->decomp_ == true)
-        {
-            for(int i = 0; i < this->num_blocks_; ++i)
-            {
-                this->x_block_[i]->Clear();
-                delete this->x_block_[i];
-
-                this->diag_block_[i]->Clear();
-                delete this->diag_block_[i];
-                this->diag_solver_[i]->Clear();
-                delete this->diag_solver_[i];
-
-                for(int j = 0; j < this->num_blocks_; ++j)
-                {
-                    delete this->preconditioner_block_[i][j];
-                }
-
-                delete[] this->preconditioner_block_[i];
-            }
-
-            delete[] this->x_block_;
-            delete[] this->diag_block_;
-            delete[] this->diag_solver_;
-            delete[] this->preconditioner_block_;
-        }
-
         if(this->analyzer_op_ != this->op_)
         {
             delete this->analyzer_op_;
@@ -109,6 +91,12 @@ void MultiColored<OperatorType, VectorType, ValueType>::Clear(void)
 
         this->permutation_.Clear();
         free_host(&this->block_sizes_);
+
+        if(this->block_offsets_ != NULL)
+        {
+            free_host(&this->block_offsets_);
+        }
+
         this->num_blocks_ = 0;
 
         this->diag_.Clear();
@@ -190,104 +178,244 @@ void MultiColored<OperatorType, VectorType, ValueType>::Factorize_(void)
 template <class OperatorType, class VectorType, typename ValueType>
 void MultiColored<OperatorType, VectorType, ValueType>::Decompose_(void)
 {
-    log_debug(this, "MultiColored::Decompose_()", " * beging");
+    log_debug(this, "MultiColored::Decompose_()", " * begin");
+
+    this->ClearBlocks_();
 
     if(this->decomp_ == true)
     {
         assert(this->num_blocks_ > 0);
         assert(this->block_sizes_ != NULL);
 
-        int* offsets = NULL;
-        allocate_host(this->num_blocks_ + 1, &offsets);
+        // The colors are swept directly on the permuted matrix, thus only the first row
+        // of each color is required
+        if(this->block_offsets_ != NULL)
+        {
+            free_host(&this->block_offsets_);
+        }
 
-        offsets[0] = 0;
+        allocate_host(this->num_blocks_ + 1, &this->block_offsets_);
+
+        this->block_offsets_[0] = 0;
         for(int i = 0; i < this->num_blocks_; ++i)
         {
-            offsets[i + 1] = this->block_sizes_[i];
+            this->block_offsets_[i + 1] = this->block_offsets_[i] + this->block_sizes_[i];
         }
 
-        // sum up
-        for(int i = 0; i < this->num_blocks_; ++i)
+        // Blocks in a specific format are swept by SpMVs, the permuted matrix stays in
+        // CSR to extract them
+        if((this->op_mat_format_ == true) && (this->precond_mat_format_ != CSR))
         {
-            offsets[i + 1] += offsets[i];
+            this->DecomposeBlocks_();
         }
+    }
 
-        this->diag_solver_ = new Solver<OperatorType, VectorType, ValueType>*[this->num_blocks_];
+    this->diag_.CloneBackend(*this->op_);
+    this->preconditioner_->ExtractDiagonal(&this->diag_);
 
-        this->preconditioner_block_ = new OperatorType**[this->num_blocks_];
-        for(int i = 0; i < this->num_blocks_; ++i)
+    this->x_.CloneBackend(*this->op_);
+    this->x_.Allocate("Permuted solution vector", this->op_->GetM());
+
+    log_debug(this, "MultiColored::Decompose_()", " * end");
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void MultiColored<OperatorType, VectorType, ValueType>::DecomposeBlocks_(void)
+{
+    log_debug(this, "MultiColored::DecomposeBlocks_()");
+
+    assert(this->num_blocks_ > 0);
+    assert(this->block_sizes_ != NULL);
+    assert(this->block_offsets_ != NULL);
+    assert(this->preconditioner_ != NULL);
+    assert(this->preconditioner_block_ == NULL);
+
+    this->preconditioner_block_ = new OperatorType**[this->num_blocks_];
+    for(int i = 0; i < this->num_blocks_; ++i)
+    {
+        this->preconditioner_block_[i] = new OperatorType*[this->num_blocks_];
+
+        for(int j = 0; j < this->num_blocks_; ++j)
         {
-            this->preconditioner_block_[i] = new OperatorType*[this->num_blocks_];
+            this->preconditioner_block_[i][j] = new OperatorType;
+            this->preconditioner_block_[i][j]->CloneBackend(*this->preconditioner_);
         }
+    }
+
+    this->preconditioner_->ExtractSubMatrices(this->num_blocks_,
+                                              this->num_blocks_,
+                                              this->block_offsets_,
+                                              this->block_offsets_,
+                                              this->preconditioner_block_);
+
+    this->x_block_        = new VectorType*[this->num_blocks_];
+    this->inv_diag_block_ = new VectorType*[this->num_blocks_];
 
-        this->x_block_    = new VectorType*[this->num_blocks_];
-        this->diag_block_ = new VectorType*[this->num_blocks_];
+    for(int i = 0; i < this->num_blocks_; ++i)
+    {
+        this->x_block_[i] = new VectorType;
+        this->x_block_[i]->CloneBackend(*this->preconditioner_);
+        this->x_block_[i]->Allocate("MultiColored Preconditioner x_block_",
+                                    this->block_sizes_[i]);
+
+        this->inv_diag_block_[i] = new VectorType;
+        this->inv_diag_block_[i]->CloneBackend(*this->preconditioner_);
+
+        // The diagonal block of each color is diagonal
+        this->preconditioner_block_[i][i]->ExtractInverseDiagonal(this->inv_diag_block_[i]);
+        this->preconditioner_block_[i][i]->Clear();
+    }
 
+    if(this->op_mat_format_ == true)
+    {
         for(int i = 0; i < this->num_blocks_; ++i)
         {
             for(int j = 0; j < this->num_blocks_; ++j)
             {
-                this->preconditioner_block_[i][j] = new LocalMatrix<ValueType>;
-                this->preconditioner_block_[i][j]->CloneBackend(*this->op_);
+                this->preconditioner_block_[i][j]->ConvertTo(this->precond_mat_format_);
             }
         }
+    }
+}
 
-        this->preconditioner_->ExtractSubMatrices(
-            this->num_blocks_, this->num_blocks_, offsets, offsets, this->preconditioner_block_);
-
-        free_host(&offsets);
+template <class OperatorType, class VectorType, typename ValueType>
+void MultiColored<OperatorType, VectorType, ValueType>::ClearBlocks_(void)
+{
+    log_debug(this, "MultiColored::ClearBlocks_()");
 
-        int x_offset = 0;
+    if(this->preconditioner_block_ != NULL)
+    {
         for(int i = 0; i < this->num_blocks_; ++i)
         {
-            this->diag_block_[i] = new VectorType;
-            this->diag_block_[i]->CloneBackend(*this->op_); // clone backend
-            this->diag_block_[i]->Allocate("Diagonal preconditioners blocks",
-                                           this->block_sizes_[i]);
+            delete this->x_block_[i];
+            delete this->inv_diag_block_[i];
 
-            this->preconditioner_block_[i][i]->ExtractDiagonal(this->diag_block_[i]);
+            for(int j = 0; j < this->num_blocks_; ++j)
+            {
+                delete this->preconditioner_block_[i][j];
+            }
 
-            this->x_block_[i] = new VectorType; // empty vector
+            delete[] this->preconditioner_block_[i];
+        }
 
-            this->x_block_[i]->CloneBackend(*this->op_); // clone backend
-            this->x_block_[i]->Allocate("MultiColored Preconditioner x_block_",
-                                        this->block_sizes_[i]);
+        delete[] this->preconditioner_block_;
+        delete[] this->x_block_;
+        delete[] this->inv_diag_block_;
 
-            x_offset += this->block_sizes_[i];
+        this->preconditioner_block_ = NULL;
+        this->x_block_              = NULL;
+        this->inv_diag_block_       = NULL;
+    }
+}
 
-            Jacobi<OperatorType, VectorType, ValueType>* jacobi =
-                new Jacobi<OperatorType, VectorType, ValueType>;
-            jacobi->SetOperator(*this->preconditioner_block_[i][i]);
-            jacobi->Build();
+template <class OperatorType, class VectorType, typename ValueType>
+void MultiColored<OperatorType, VectorType, ValueType>::SweepL_(bool diag_unit, ValueType omega)
+{
+    log_debug(this, "MultiColored::SweepL_()", diag_unit, omega);
 
-            this->diag_solver_[i] = jacobi;
+    assert(this->build_ == true);
 
-            this->preconditioner_block_[i][i]->Clear();
+    // Fused sweep over all colors, if supported by the format and location of the matrix
+    if(this->preconditioner_block_ == NULL || this->precond_mat_format_ == CSR)
+    {
+        if(this->preconditioner_->MultiColoredLSweep(
+               this->num_blocks_, this->block_offsets_, diag_unit, omega, &this->x_)
+           == true)
+        {
+            return;
         }
+    }
 
-        // Clone the format
-        // e.g. the preconditioner block matrices will have the same format as this->op_
-        if(this->op_mat_format_ == true)
+    // Otherwise, one SpMV per block
+    if(this->preconditioner_block_ == NULL)
+    {
+        this->DecomposeBlocks_();
+    }
+
+    for(int i = 0; i < this->num_blocks_; ++i)
+    {
+        this->x_block_[i]->CopyFrom(this->x_, this->block_offsets_[i], 0, this->block_sizes_[i]);
+    }
+
+    for(int i = 0; i < this->num_blocks_; ++i)
+    {
+        for(int j = 0; j < i; ++j)
         {
-            for(int i = 0; i < this->num_blocks_; ++i)
+            if(this->preconditioner_block_[i][j]->GetNnz() > 0)
             {
-                for(int j = 0; j < this->num_blocks_; ++j)
-                {
-                    this->preconditioner_block_[i][j]->ConvertTo(this->precond_mat_format_);
-                }
+                this->preconditioner_block_[i][j]->ApplyAdd(
+                    *this->x_block_[j], static_cast<ValueType>(-1), this->x_block_[i]);
             }
         }
+
+        if(diag_unit == false)
+        {
+            this->x_block_[i]->PointWiseMult(*this->inv_diag_block_[i]);
+        }
+
+        // SSOR
+        if(omega != static_cast<ValueType>(1))
+        {
+            this->x_block_[i]->Scale(static_cast<ValueType>(1) / omega);
+        }
+
+        this->x_.CopyFrom(*this->x_block_[i], 0, this->block_offsets_[i], this->block_sizes_[i]);
     }
-    else
+}
+
+template <class OperatorType, class VectorType, typename ValueType>
+void MultiColored<OperatorType, VectorType, ValueType>::SweepR_(bool diag_unit, ValueType omega)
+{
+    log_debug(this, "MultiColored::SweepR_()", diag_unit, omega);
+
+    assert(this->build_ == true);
+
+    // Fused sweep over all colors, if supported by the format and location of the matrix
+    if(this->preconditioner_block_ == NULL || this->precond_mat_format_ == CSR)
     {
-        this->diag_.CloneBackend(*this->op_);
-        this->preconditioner_->ExtractDiagonal(&this->diag_);
+        if(this->preconditioner_->MultiColoredUSweep(
+               this->num_blocks_, this->block_offsets_, diag_unit, omega, &this->x_)
+           == true)
+        {
+            return;
+        }
     }
 
-    this->x_.CloneBackend(*this->op_);
-    this->x_.Allocate("Permuted solution vector", this->op_->GetM());
+    // Otherwise, one SpMV per block
+    if(this->preconditioner_block_ == NULL)
+    {
+        this->DecomposeBlocks_();
+    }
 
-    log_debug(this, "MultiColored::Decompose_()", " * end");
+    for(int i = 0; i < this->num_blocks_; ++i)
+    {
+        this->x_block_[i]->CopyFrom(this->x_, this->block_offsets_[i], 0, this->block_sizes_[i]);
+    }
+
+    for(int i = this->num_blocks_ - 1; i >= 0; --i)
+    {
+        for(int j = this->num_blocks_ - 1; j > i; --j)
+        {
+            if(this->preconditioner_block_[i][j]->GetNnz() > 0)
+            {
+                this->preconditioner_block_[i][j]->ApplyAdd(
+                    *this->x_block_[j], static_cast<ValueType>(-1), this->x_block_[i]);
+            }
+        }
+
+        if(diag_unit == false)
+        {
+            this->x_block_[i]->PointWiseMult(*this->inv_diag_block_[i]);
+        }
+
+        // SSOR
+        if(omega != static_cast<ValueType>(1))
+        {
+            this->x_block_[i]->Scale(static_cast<ValueType>(1) / omega);
+        }
+
+        this->x_.CopyFrom(*this->x_block_[i], 0, this->block_offsets_[i], this->block_sizes_[i]);
+    }
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -318,11 +446,7 @@ void MultiColored<OperatorType, VectorType, ValueType>::Build(void)
 
     this->build_ = true;
 
-    if(this->decomp_ == true)
-    {
-        this->preconditioner_->Clear();
-    }
-    else
+    if(this->decomp_ == false)
     {
         this->PostAnalyse_();
     }
@@ -340,21 +464,23 @@ void MultiColored<OperatorType, VectorType, ValueType>::Solve(const VectorType&
 {
     log_debug(this, "MultiColored::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("MultiColored::Solve", "preconditioner");
+
     assert(x != NULL);
     assert(x != &rhs);
     assert(this->build_ == true);
 
     if(this->decomp_ == true)
     {
-        // Solve via decomposition
+        // Solve via color sweeps on the permuted vector
 
-        this->ExtractRHSinX_(rhs, x);
+        this->x_.CopyFromPermute(rhs, this->permutation_);
 
         this->SolveL_();
         this->SolveD_();
         this->SolveR_();
 
-        this->InsertSolution_(x);
+        x->CopyFromPermuteBackward(this->x_, this->permutation_);
     }
     else
     {
@@ -366,43 +492,6 @@ void MultiColored<OperatorType, VectorType, ValueType>::Solve(const VectorType&
     log_debug(this, "MultiColored::Solve()", " #*# end");
 }
 
-template <class OperatorType, class VectorType, typename ValueType>
-void MultiColored<OperatorType, VectorType, ValueType>::ExtractRHSinX_(const VectorType& rhs,
-                                                                       VectorType* x)
-{
-    log_debug(this, "MultiColored::ExtractRHSinX_()", (const void*&)rhs, x);
-
-    assert(this->build_ == true);
-
-    x->CopyFromPermute(rhs, this->permutation_);
-
-    int x_offset = 0;
-    for(int i = 0; i < this->num_blocks_; ++i)
-    {
-        this->x_block_[i]->CopyFrom(*x, x_offset, 0, this->block_sizes_[i]);
-
-        x_offset += this->block_sizes_[i];
-    }
-}
-
-template <class OperatorType, class VectorType, typename ValueType>
-void MultiColored<OperatorType, VectorType, ValueType>::InsertSolution_(VectorType* x)
-{
-    log_debug(this, "MultiColored::InsertSolution_()", x);
-
-    assert(this->build_ == true);
-
-    int x_offset = 0;
-    for(int i = 0; i < this->num_blocks_; ++i)
-    {
-        this->x_.CopyFrom(*this->x_block_[i], 0, x_offset, this->block_sizes_[i]);
-
-        x_offset += this->block_sizes_[i];
-    }
-
-    x->CopyFromPermuteBackward(this->x_, this->permutation_);
-}
-
 template <class OperatorType, class VectorType, typename ValueType>
 void MultiColored<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(void)
 {
@@ -412,13 +501,12 @@ void MultiColored<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(voi
     {
         this->preconditioner_->MoveToHost();
 
-        if(this->decomp_ == true)
+        if(this->preconditioner_block_ != NULL)
         {
             for(int i = 0; i < this->num_blocks_; ++i)
             {
                 this->x_block_[i]->MoveToHost();
-                this->diag_block_[i]->MoveToHost();
-                this->diag_solver_[i]->MoveToHost();
+                this->inv_diag_block_[i]->MoveToHost();
 
                 for(int j = 0; j < this->num_blocks_; ++j)
                 {
@@ -435,6 +523,7 @@ void MultiColored<OperatorType, VectorType, ValueType>::MoveToHostLocalData_(voi
 
     this->permutation_.MoveToHost();
     this->x_.MoveToHost();
+    this->diag_.MoveToHost();
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -446,13 +535,12 @@ void MultiColored<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalDa
     {
         this->preconditioner_->MoveToAccelerator();
 
-        if(this->decomp_ == true)
+        if(this->preconditioner_block_ != NULL)
         {
             for(int i = 0; i < this->num_blocks_; ++i)
             {
                 this->x_block_[i]->MoveToAccelerator();
-                this->diag_block_[i]->MoveToAccelerator();
-                this->diag_solver_[i]->MoveToAccelerator();
+                this->inv_diag_block_[i]->MoveToAccelerator();
 
                 for(int j = 0; j < this->num_blocks_; ++j)
                 {
@@ -469,6 +557,7 @@ void MultiColored<OperatorType, VectorType, ValueType>::MoveToAcceleratorLocalDa
 
     this->permutation_.MoveToAccelerator();
     this->x_.MoveToAccelerator();
+    this->diag_.MoveToAccelerator();
 }
 
 template class MultiColored<LocalMatrix<double>, LocalVector<double>, double>;
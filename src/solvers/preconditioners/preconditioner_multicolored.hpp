@@ -51,10 +51,20 @@ class MultiColored : public Preconditioner<OperatorType, VectorType, ValueType>
 
     virtual void Build(void);
 
-    /** \brief Set a specific matrix type of the decomposed block matrices */
+    /** \brief Set a specific matrix format of the per-color block matrices
+      * \details
+      * If a format other than CSR is set, the colors are swept by one SpMV per
+      * off-diagonal block in this format, instead of the fused host CSR sweep.
+      */
     void SetPrecondMatrixFormat(unsigned int mat_format);
 
-    /** \brief Set if the preconditioner should be decomposed or not */
+    /** \brief Set if the preconditioner should be applied by color sweeps or not
+      * \details
+      * If \p decomp is true (default), the colors are swept in place on the permuted
+      * matrix. On the host with CSR format, each triangular part is swept by one fused
+      * kernel, otherwise by one SpMV per off-diagonal block. If \p decomp is false,
+      * level-scheduled triangular solves are performed.
+      */
     void SetDecomposition(bool decomp);
 
     virtual void Solve(const VectorType& rhs, VectorType* x);
@@ -62,54 +72,52 @@ class MultiColored : public Preconditioner<OperatorType, VectorType, ValueType>
     protected:
     /** \brief Operator for analyzing */
     OperatorType* analyzer_op_;
-    /** \brief Preconditioner */
+    /** \brief Permuted preconditioning matrix, whose rows are ordered by colors */
     OperatorType* preconditioner_;
 
-    /** \brief Preconditioner for each block */
+    /** \brief Blocks of the permuted preconditioning matrix, only used if the fused
+      * sweeps are not available for its format or location
+      */
     OperatorType*** preconditioner_block_;
-
     /** \brief Solution vector for each block */
     VectorType** x_block_;
-    /** \brief Diagonal for each block */
-    VectorType** diag_block_;
-    /** \brief Solution vector */
+    /** \brief Inverse diagonal for each block */
+    VectorType** inv_diag_block_;
+
+    /** \brief Permuted solution vector */
     VectorType x_;
-    /** \brief Diagonal */
+    /** \brief Diagonal of the permuted preconditioning matrix */
     VectorType diag_;
 
-    /** \brief Diagonal solver */
-    Solver<OperatorType, VectorType, ValueType>** diag_solver_;
-
-    /** \brief Number of blocks */
+    /** \brief Number of blocks (colors) */
     int num_blocks_;
     /** \brief Block sizes */
     int* block_sizes_;
+    /** \brief Offsets of the blocks, i.e. first row of each color (host) */
+    int* block_offsets_;
 
     /** \brief Keep the precond matrix in CSR or not */
     bool op_mat_format_;
     /** \brief Precond matrix format */
     unsigned int precond_mat_format_;
 
-    /** \brief Decompose the preconditioner into blocks or not */
+    /** \brief Sweep the colors (true) or use level-scheduled triangular solves (false) */
     bool decomp_;
 
-    /** \brief Extract b into x under the permutation (see Analyse_()) and
-      * decompose x into blocks (x_block_[])
-      */
-    void ExtractRHSinX_(const VectorType& rhs, VectorType* x);
-
-    /** \brief Solve the lower-triangular (left) matrix */
+    /** \brief Sweep the lower-triangular (left) matrix in place on x_ */
     virtual void SolveL_(void) = 0;
     /** \brief Solve the diagonal part (only for SGS) */
     virtual void SolveD_(void) = 0;
-    /** \brief Solve the upper-trianguler (right) matrix */
+    /** \brief Sweep the upper-trianguler (right) matrix in place on x_ */
     virtual void SolveR_(void) = 0;
 
-    /** \brief Solve directly without block decomposition */
-    virtual void Solve_(const VectorType& rhs, VectorType* x) = 0;
+    /** \brief Sweep x_ = (x_ - L x_) / (omega * D) over the colors in ascending order */
+    void SweepL_(bool diag_unit, ValueType omega);
+    /** \brief Sweep x_ = (x_ - U x_) / (omega * D) over the colors in descending order */
+    void SweepR_(bool diag_unit, ValueType omega);
 
-    /** \brief Insert the solution with backward permutation (from x_block_[]) */
-    void InsertSolution_(VectorType* x);
+    /** \brief Solve directly without color sweeps */
+    virtual void Solve_(const VectorType& rhs, VectorType* x) = 0;
 
     /** \brief Build the analyzing matrix */
     virtual void Build_Analyser_(void);
@@ -119,10 +127,14 @@ class MultiColored : public Preconditioner<OperatorType, VectorType, ValueType>
     void Permute_(void);
     /** \brief Factorize (i.e. build the preconditioner) */
     virtual void Factorize_(void);
-    /** \brief Decompose the structure into blocks (preconditioner_block_[] for the
-      * the preconditioning matrix; and x_block_[] for the x vector)
+    /** \brief Compute the color offsets and the diagonal of the permuted
+      * preconditioning matrix
       */
     void Decompose_(void);
+    /** \brief Extract the blocks of the permuted preconditioning matrix */
+    void DecomposeBlocks_(void);
+    /** \brief Free the blocks of the permuted preconditioning matrix */
+    void ClearBlocks_(void);
     /** \brief Post-analyzing if the preconditioner is not decomposed */
     virtual void PostAnalyse_(void);
 
@@ -85,31 +85,17 @@ void MultiColoredSGS<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
         delete this->preconditioner_;
     }
 
-    for(int i = 0; i < this->num_blocks_; ++i)
-    {
-        delete this->x_block_[i];
-        delete this->diag_block_[i];
-        delete this->diag_solver_[i];
-
-        for(int j = 0; j < this->num_blocks_; ++j)
-        {
-            delete this->preconditioner_block_[i][j];
-        }
-
-        delete[] this->preconditioner_block_[i];
-    }
-
-    delete[] this->preconditioner_block_;
-    delete[] this->x_block_;
-    delete[] this->diag_block_;
-    delete[] this->diag_solver_;
-
     this->preconditioner_ = new OperatorType;
     this->preconditioner_->CloneFrom(*this->op_);
 
     this->Permute_();
     this->Factorize_();
     this->Decompose_();
+
+    if(this->decomp_ == false)
+    {
+        this->PostAnalyse_();
+    }
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -129,25 +115,8 @@ void MultiColoredSGS<OperatorType, VectorType, ValueType>::SolveL_(void)
 
     assert(this->build_ == true);
 
-    for(int i = 0; i < this->num_blocks_; ++i)
-    {
-        for(int j = 0; j < i; ++j)
-        {
-            if(this->preconditioner_block_[i][j]->GetNnz() > 0)
-            {
-                this->preconditioner_block_[i][j]->ApplyAdd(
-                    *this->x_block_[j], static_cast<ValueType>(-1), this->x_block_[i]);
-            }
-        }
-
-        this->diag_solver_[i]->Solve(*this->x_block_[i], this->x_block_[i]);
-
-        // SSOR
-        if(this->omega_ != static_cast<ValueType>(1))
-        {
-            this->x_block_[i]->Scale(static_cast<ValueType>(1) / this->omega_);
-        }
-    }
+    // x_c = (x_c - L_c x) / (omega * D_c) for all colors in ascending order
+    this->SweepL_(false, this->omega_);
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -157,15 +126,12 @@ void MultiColoredSGS<OperatorType, VectorType, ValueType>::SolveD_(void)
 
     assert(this->build_ == true);
 
-    for(int i = 0; i < this->num_blocks_; ++i)
-    {
-        this->x_block_[i]->PointWiseMult(*this->diag_block_[i]);
+    this->x_.PointWiseMult(this->diag_);
 
-        // SSOR
-        if(this->omega_ != static_cast<ValueType>(1))
-        {
-            this->x_block_[i]->Scale(this->omega_ / (static_cast<ValueType>(2) - this->omega_));
-        }
+    // SSOR
+    if(this->omega_ != static_cast<ValueType>(1))
+    {
+        this->x_.Scale(this->omega_ / (static_cast<ValueType>(2) - this->omega_));
     }
 }
 
@@ -176,25 +142,8 @@ void MultiColoredSGS<OperatorType, VectorType, ValueType>::SolveR_(void)
 
     assert(this->build_ == true);
 
-    for(int i = this->num_blocks_ - 1; i >= 0; --i)
-    {
-        for(int j = this->num_blocks_ - 1; j > i; --j)
-        {
-            if(this->preconditioner_block_[i][j]->GetNnz() > 0)
-            {
-                this->preconditioner_block_[i][j]->ApplyAdd(
-                    *this->x_block_[j], static_cast<ValueType>(-1), this->x_block_[i]);
-            }
-        }
-
-        this->diag_solver_[i]->Solve(*this->x_block_[i], this->x_block_[i]);
-
-        // SSOR
-        if(this->omega_ != static_cast<ValueType>(1))
-        {
-            this->x_block_[i]->Scale(static_cast<ValueType>(1) / this->omega_);
-        }
-    }
+    // x_c = (x_c - U_c x) / (omega * D_c) for all colors in descending order
+    this->SweepR_(false, this->omega_);
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -253,32 +202,6 @@ void MultiColoredGS<OperatorType, VectorType, ValueType>::SolveD_(void)
 {
 }
 
-template <class OperatorType, class VectorType, typename ValueType>
-void MultiColoredGS<OperatorType, VectorType, ValueType>::SolveR_(void)
-{
-    assert(this->build_ == true);
-
-    for(int i = this->num_blocks_ - 1; i >= 0; --i)
-    {
-        for(int j = this->num_blocks_ - 1; j > i; --j)
-        {
-            if(this->preconditioner_block_[i][j]->GetNnz() > 0)
-            {
-                this->preconditioner_block_[i][j]->ApplyAdd(
-                    *this->x_block_[j], static_cast<ValueType>(-1), this->x_block_[i]);
-            }
-        }
-
-        this->diag_solver_[i]->Solve(*this->x_block_[i], this->x_block_[i]);
-
-        // SSOR
-        if(this->omega_ != static_cast<ValueType>(1))
-        {
-            this->x_block_[i]->Scale(static_cast<ValueType>(1) / this->omega_);
-        }
-    }
-}
-
 template <class OperatorType, class VectorType, typename ValueType>
 void MultiColoredGS<OperatorType, VectorType, ValueType>::Solve_(const VectorType& rhs,
                                                                  VectorType* x)
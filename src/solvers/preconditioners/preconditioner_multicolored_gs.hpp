@@ -100,7 +100,6 @@ class MultiColoredGS : public MultiColoredSGS<OperatorType, VectorType, ValueTyp
 
     virtual void SolveL_(void);
     virtual void SolveD_(void);
-    virtual void SolveR_(void);
     virtual void Solve_(const VectorType& rhs, VectorType* x);
 };
 
@@ -165,25 +165,6 @@ void MultiColoredILU<OperatorType, VectorType, ValueType>::ReBuildNumeric(void)
             delete this->preconditioner_;
         }
 
-        for(int i = 0; i < this->num_blocks_; ++i)
-        {
-            delete this->x_block_[i];
-            delete this->diag_block_[i];
-            delete this->diag_solver_[i];
-
-            for(int j = 0; j < this->num_blocks_; ++j)
-            {
-                delete this->preconditioner_block_[i][j];
-            }
-
-            delete[] this->preconditioner_block_[i];
-        }
-
-        delete[] this->preconditioner_block_;
-        delete[] this->x_block_;
-        delete[] this->diag_block_;
-        delete[] this->diag_solver_;
-
         this->preconditioner_ = new OperatorType;
         this->preconditioner_->CloneFrom(*this->op_);
 
@@ -200,17 +181,8 @@ void MultiColoredILU<OperatorType, VectorType, ValueType>::SolveL_(void)
 
     assert(this->build_ == true);
 
-    for(int i = 0; i < this->num_blocks_; ++i)
-    {
-        for(int j = 0; j < i; ++j)
-        {
-            if(this->preconditioner_block_[i][j]->GetNnz() > 0)
-            {
-                this->preconditioner_block_[i][j]->ApplyAdd(
-                    *this->x_block_[j], static_cast<ValueType>(-1), this->x_block_[i]);
-            }
-        }
-    }
+    // x_c = x_c - L_c x for all colors in ascending order, L has unit diagonal
+    this->SweepL_(true, static_cast<ValueType>(1));
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
@@ -225,19 +197,8 @@ void MultiColoredILU<OperatorType, VectorType, ValueType>::SolveR_(void)
 
     assert(this->build_ == true);
 
-    for(int i = this->num_blocks_ - 1; i >= 0; --i)
-    {
-        for(int j = this->num_blocks_ - 1; j > i; --j)
-        {
-            if(this->preconditioner_block_[i][j]->GetNnz() > 0)
-            {
-                this->preconditioner_block_[i][j]->ApplyAdd(
-                    *this->x_block_[j], static_cast<ValueType>(-1), this->x_block_[i]);
-            }
-        }
-
-        this->diag_solver_[i]->Solve(*this->x_block_[i], this->x_block_[i]);
-    }
+    // x_c = (x_c - U_c x) / D_c for all colors in descending order
+    this->SweepR_(false, static_cast<ValueType>(1));
 }
 
 template <class OperatorType, class VectorType, typename ValueType>
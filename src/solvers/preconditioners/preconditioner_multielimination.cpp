@@ -31,6 +31,7 @@
 #include "../../base/local_vector.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 #include "../../utils/math_functions.hpp"
 
 #include <complex>
@@ -315,6 +316,8 @@ void MultiElimination<OperatorType, VectorType, ValueType>::Solve(const VectorTy
 {
     log_debug(this, "MultiElimination::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("MultiElimination::Solve", "preconditioner");
+
     assert(this->build_ == true);
 
     this->rhs_.CopyFromPermute(rhs, this->permutation_);
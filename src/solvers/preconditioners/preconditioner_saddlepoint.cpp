@@ -31,6 +31,7 @@
 #include "../../base/local_vector.hpp"
 
 #include "../../utils/log.hpp"
+#include "../../utils/trace.hpp"
 
 #include <complex>
 
@@ -233,6 +234,8 @@ void DiagJacobiSaddlePointPrecond<OperatorType, VectorType, ValueType>::Solve(co
 {
     log_debug(this, "DiagJacobiSaddlePointPrecond::Solve()", " #*# begin", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("DiagJacobiSaddlePointPrecond::Solve", "preconditioner");
+
     assert(this->build_ == true);
 
     this->rhs_.CopyFromPermute(rhs, this->permutation_);
@@ -26,12 +26,16 @@
 
 #include "../base/local_matrix.hpp"
 #include "../base/local_stencil.hpp"
+#include "../base/local_callback_operator.hpp"
+#include "../base/local_multi_vector.hpp"
 #include "../base/local_vector.hpp"
 
 #include "../base/global_matrix.hpp"
+#include "../base/global_callback_operator.hpp"
 #include "../base/global_vector.hpp"
 
 #include "../utils/log.hpp"
+#include "../utils/trace.hpp"
 #include "../utils/math_functions.hpp"
 
 #include <complex>
@@ -367,6 +371,8 @@ void IterativeLinearSolver<OperatorType, VectorType, ValueType>::Solve(const Vec
 {
     log_debug(this, "IterativeLinearSolver::Solve()", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("IterativeLinearSolver::Solve", "solver");
+
     assert(x != NULL);
     assert(x != &rhs);
     assert(this->op_ != NULL);
@@ -646,6 +652,8 @@ void DirectLinearSolver<OperatorType, VectorType, ValueType>::Solve(const Vector
 {
     log_debug(this, "DirectLinearSolver::Solve()", (const void*&)rhs, x);
 
+    ROCALUTION_TRACE_SCOPE("DirectLinearSolver::Solve", "solver");
+
     assert(x != NULL);
     assert(x != &rhs);
     assert(this->op_ != NULL);
@@ -752,6 +760,28 @@ template class Solver<LocalStencil<std::complex<float>>,
                       std::complex<float>>;
 #endif
 
+template class Solver<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class Solver<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class Solver<LocalCallbackOperator<std::complex<double>>,
+                      LocalVector<std::complex<double>>,
+                      std::complex<double>>;
+template class Solver<LocalCallbackOperator<std::complex<float>>,
+                      LocalVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
+template class Solver<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class Solver<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class Solver<GlobalCallbackOperator<std::complex<double>>,
+                      GlobalVector<std::complex<double>>,
+                      std::complex<double>>;
+template class Solver<GlobalCallbackOperator<std::complex<float>>,
+                      GlobalVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
 template class IterativeLinearSolver<LocalStencil<double>, LocalVector<double>, double>;
 template class IterativeLinearSolver<LocalStencil<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -763,6 +793,50 @@ template class IterativeLinearSolver<LocalStencil<std::complex<float>>,
                                      std::complex<float>>;
 #endif
 
+template class IterativeLinearSolver<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class IterativeLinearSolver<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class IterativeLinearSolver<LocalCallbackOperator<std::complex<double>>,
+                                     LocalVector<std::complex<double>>,
+                                     std::complex<double>>;
+template class IterativeLinearSolver<LocalCallbackOperator<std::complex<float>>,
+                                     LocalVector<std::complex<float>>,
+                                     std::complex<float>>;
+#endif
+
+template class Solver<LocalMatrix<double>, LocalMultiVector<double>, double>;
+template class Solver<LocalMatrix<float>, LocalMultiVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class Solver<LocalMatrix<std::complex<double>>,
+                      LocalMultiVector<std::complex<double>>,
+                      std::complex<double>>;
+template class Solver<LocalMatrix<std::complex<float>>,
+                      LocalMultiVector<std::complex<float>>,
+                      std::complex<float>>;
+#endif
+
+template class IterativeLinearSolver<LocalMatrix<double>, LocalMultiVector<double>, double>;
+template class IterativeLinearSolver<LocalMatrix<float>, LocalMultiVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class IterativeLinearSolver<LocalMatrix<std::complex<double>>,
+                                     LocalMultiVector<std::complex<double>>,
+                                     std::complex<double>>;
+template class IterativeLinearSolver<LocalMatrix<std::complex<float>>,
+                                     LocalMultiVector<std::complex<float>>,
+                                     std::complex<float>>;
+#endif
+
+template class IterativeLinearSolver<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class IterativeLinearSolver<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class IterativeLinearSolver<GlobalCallbackOperator<std::complex<double>>,
+                                     GlobalVector<std::complex<double>>,
+                                     std::complex<double>>;
+template class IterativeLinearSolver<GlobalCallbackOperator<std::complex<float>>,
+                                     GlobalVector<std::complex<float>>,
+                                     std::complex<float>>;
+#endif
+
 template class FixedPoint<LocalStencil<double>, LocalVector<double>, double>;
 template class FixedPoint<LocalStencil<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
@@ -774,6 +848,28 @@ template class FixedPoint<LocalStencil<std::complex<float>>,
                           std::complex<float>>;
 #endif
 
+template class FixedPoint<LocalCallbackOperator<double>, LocalVector<double>, double>;
+template class FixedPoint<LocalCallbackOperator<float>, LocalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class FixedPoint<LocalCallbackOperator<std::complex<double>>,
+                          LocalVector<std::complex<double>>,
+                          std::complex<double>>;
+template class FixedPoint<LocalCallbackOperator<std::complex<float>>,
+                          LocalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
+template class FixedPoint<GlobalCallbackOperator<double>, GlobalVector<double>, double>;
+template class FixedPoint<GlobalCallbackOperator<float>, GlobalVector<float>, float>;
+#ifdef SUPPORT_COMPLEX
+template class FixedPoint<GlobalCallbackOperator<std::complex<double>>,
+                          GlobalVector<std::complex<double>>,
+                          std::complex<double>>;
+template class FixedPoint<GlobalCallbackOperator<std::complex<float>>,
+                          GlobalVector<std::complex<float>>,
+                          std::complex<float>>;
+#endif
+
 template class DirectLinearSolver<LocalStencil<double>, LocalVector<double>, double>;
 template class DirectLinearSolver<LocalStencil<float>, LocalVector<float>, float>;
 #ifdef SUPPORT_COMPLEX
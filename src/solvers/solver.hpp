@@ -54,7 +54,8 @@ namespace rocalution {
   * - MoveToHost() and MoveToAccelerator() to offload the solver (including
   *   preconditioners and sub-solvers) to the host/accelerator.
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil,
+  *                        LocalCallbackOperator or GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -183,7 +184,8 @@ class Solver : public RocalutionObj
   * - 3, if divergence tolerance has been reached
   * - 4, if maximum number of iteration has been reached
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil,
+  *                        LocalCallbackOperator or GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
@@ -286,7 +288,8 @@ class IterativeLinearSolver : public Solver<OperatorType, VectorType, ValueType>
   * The inversion of \f$M\f$ can be performed by preconditioners (Jacobi, Gauss-Seidel,
   * ILU, etc.) or by any type of solvers.
   *
-  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix or LocalStencil
+  * \tparam OperatorType - can be LocalMatrix, GlobalMatrix, LocalStencil,
+  *                        LocalCallbackOperator or GlobalCallbackOperator
   * \tparam VectorType - can be LocalVector or GlobalVector
   * \tparam ValueType - can be float, double, std::complex<float> or std::complex<double>
   */
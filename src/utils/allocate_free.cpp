@@ -144,6 +144,7 @@ template void allocate_host<std::complex<double>>(int size, std::complex<double>
 #endif
 template void allocate_host<int>(int size, int** ptr);
 template void allocate_host<unsigned int>(int size, unsigned int** ptr);
+template void allocate_host<unsigned short>(int size, unsigned short** ptr);
 template void allocate_host<char>(int size, char** ptr);
 
 template void free_host<float>(float** ptr);
@@ -154,6 +155,7 @@ template void free_host<std::complex<double>>(std::complex<double>** ptr);
 #endif
 template void free_host<int>(int** ptr);
 template void free_host<unsigned int>(unsigned int** ptr);
+template void free_host<unsigned short>(unsigned short** ptr);
 template void free_host<char>(char** ptr);
 
 template void set_to_zero_host<float>(int size, float* ptr);
@@ -164,6 +166,7 @@ template void set_to_zero_host<std::complex<double>>(int size, std::complex<doub
 #endif
 template void set_to_zero_host<int>(int size, int* ptr);
 template void set_to_zero_host<unsigned int>(int size, unsigned int* ptr);
+template void set_to_zero_host<unsigned short>(int size, unsigned short* ptr);
 template void set_to_zero_host<char>(int size, char* ptr);
 
 } // namespace rocalution
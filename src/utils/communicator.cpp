@@ -25,6 +25,7 @@
 #include "communicator.hpp"
 #include "log_mpi.hpp"
 
+#include <assert.h>
 #include <complex>
 
 namespace rocalution {
@@ -109,6 +110,147 @@ void communication_allreduce_single_sum(unsigned long long local,
     CHECK_MPI_ERROR(status, __FILE__, __LINE__);
 }
 
+template <>
+void communication_allreduce_sum(const double* local, double* global, int count, const void* comm)
+{
+    int status = MPI_Allreduce(local, global, count, MPI_DOUBLE, MPI_SUM, *(MPI_Comm*)comm);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_allreduce_sum(const float* local, float* global, int count, const void* comm)
+{
+    int status = MPI_Allreduce(local, global, count, MPI_FLOAT, MPI_SUM, *(MPI_Comm*)comm);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_allreduce_sum(const std::complex<double>* local,
+                                 std::complex<double>* global,
+                                 int count,
+                                 const void* comm)
+{
+    int status = MPI_Allreduce(local, global, count, MPI_DOUBLE_COMPLEX, MPI_SUM, *(MPI_Comm*)comm);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_allreduce_sum(const std::complex<float>* local,
+                                 std::complex<float>* global,
+                                 int count,
+                                 const void* comm)
+{
+    int status = MPI_Allreduce(local, global, count, MPI_COMPLEX, MPI_SUM, *(MPI_Comm*)comm);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_allreduce_sum(const int* local, int* global, int count, const void* comm)
+{
+    int status = MPI_Allreduce(local, global, count, MPI_INT, MPI_SUM, *(MPI_Comm*)comm);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_allreduce_sum(const long* local, long* global, int count, const void* comm)
+{
+    int status = MPI_Allreduce(local, global, count, MPI_LONG, MPI_SUM, *(MPI_Comm*)comm);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_allreduce_sum(const long long* local,
+                                 long long* global,
+                                 int count,
+                                 const void* comm)
+{
+    int status = MPI_Allreduce(local, global, count, MPI_LONG_LONG, MPI_SUM, *(MPI_Comm*)comm);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_allreduce_sum(
+    const double* local, double* global, int count, MRequest* request, const void* comm)
+{
+    int status =
+        MPI_Iallreduce(local, global, count, MPI_DOUBLE, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_allreduce_sum(
+    const float* local, float* global, int count, MRequest* request, const void* comm)
+{
+    int status =
+        MPI_Iallreduce(local, global, count, MPI_FLOAT, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_allreduce_sum(const std::complex<double>* local,
+                                       std::complex<double>* global,
+                                       int count,
+                                       MRequest* request,
+                                       const void* comm)
+{
+    int status = MPI_Iallreduce(
+        local, global, count, MPI_DOUBLE_COMPLEX, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_allreduce_sum(const std::complex<float>* local,
+                                       std::complex<float>* global,
+                                       int count,
+                                       MRequest* request,
+                                       const void* comm)
+{
+    int status =
+        MPI_Iallreduce(local, global, count, MPI_COMPLEX, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_allreduce_sum(
+    const int* local, int* global, int count, MRequest* request, const void* comm)
+{
+    int status =
+        MPI_Iallreduce(local, global, count, MPI_INT, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_allreduce_sum(
+    const long* local, long* global, int count, MRequest* request, const void* comm)
+{
+    int status =
+        MPI_Iallreduce(local, global, count, MPI_LONG, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_allreduce_sum(
+    const long long* local, long long* global, int count, MRequest* request, const void* comm)
+{
+    int status = MPI_Iallreduce(
+        local, global, count, MPI_LONG_LONG, MPI_SUM, *(MPI_Comm*)comm, &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_allgather_single(int local, int* global, const void* comm)
+{
+    int status = MPI_Allgather(&local, 1, MPI_INT, global, 1, MPI_INT, *(MPI_Comm*)comm);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_alltoall_single(const int* send, int* recv, const void* comm)
+{
+    int status = MPI_Alltoall(send, 1, MPI_INT, recv, 1, MPI_INT, *(MPI_Comm*)comm);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
 template <>
 void communication_async_recv(
     double* buf, int count, int source, int tag, MRequest* request, const void* comm)
@@ -201,6 +343,298 @@ void communication_async_send(
     CHECK_MPI_ERROR(status, __FILE__, __LINE__);
 }
 
+template <>
+void communication_persistent_recv(
+    double* buf, int count, int source, int tag, MRequest* request, const void* comm)
+{
+    int status =
+        MPI_Recv_init(buf, count, MPI_DOUBLE, source, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_persistent_recv(
+    float* buf, int count, int source, int tag, MRequest* request, const void* comm)
+{
+    int status = MPI_Recv_init(buf, count, MPI_FLOAT, source, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_persistent_recv(
+    std::complex<double>* buf, int count, int source, int tag, MRequest* request, const void* comm)
+{
+    int status =
+        MPI_Recv_init(buf, count, MPI_DOUBLE_COMPLEX, source, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_persistent_recv(
+    std::complex<float>* buf, int count, int source, int tag, MRequest* request, const void* comm)
+{
+    int status =
+        MPI_Recv_init(buf, count, MPI_COMPLEX, source, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_persistent_recv(
+    int* buf, int count, int source, int tag, MRequest* request, const void* comm)
+{
+    int status = MPI_Recv_init(buf, count, MPI_INT, source, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_persistent_send(
+    double* buf, int count, int dest, int tag, MRequest* request, const void* comm)
+{
+    int status = MPI_Send_init(buf, count, MPI_DOUBLE, dest, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_persistent_send(
+    float* buf, int count, int dest, int tag, MRequest* request, const void* comm)
+{
+    int status = MPI_Send_init(buf, count, MPI_FLOAT, dest, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_persistent_send(
+    std::complex<double>* buf, int count, int dest, int tag, MRequest* request, const void* comm)
+{
+    int status =
+        MPI_Send_init(buf, count, MPI_DOUBLE_COMPLEX, dest, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_persistent_send(
+    std::complex<float>* buf, int count, int dest, int tag, MRequest* request, const void* comm)
+{
+    int status = MPI_Send_init(buf, count, MPI_COMPLEX, dest, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_persistent_send(
+    int* buf, int count, int dest, int tag, MRequest* request, const void* comm)
+{
+    int status = MPI_Send_init(buf, count, MPI_INT, dest, tag, *(MPI_Comm*)comm, &request->req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+void communication_create_neighbor_comm(int nsource,
+                                        const int* sources,
+                                        int ndest,
+                                        const int* dests,
+                                        const void* comm,
+                                        void** neighbor_comm)
+{
+    assert(*neighbor_comm == NULL);
+
+    MPI_Comm* graph = new MPI_Comm;
+
+    int status = MPI_Dist_graph_create_adjacent(*(MPI_Comm*)comm,
+                                                nsource,
+                                                sources,
+                                                MPI_UNWEIGHTED,
+                                                ndest,
+                                                dests,
+                                                MPI_UNWEIGHTED,
+                                                MPI_INFO_NULL,
+                                                0,
+                                                graph);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+    *neighbor_comm = graph;
+}
+
+void communication_free_neighbor_comm(void** neighbor_comm)
+{
+    if(*neighbor_comm == NULL)
+    {
+        return;
+    }
+
+    MPI_Comm* graph = (MPI_Comm*)*neighbor_comm;
+
+    // Communicators of objects that outlive MPI have already been released by MPI_Finalize
+    int finalized;
+    MPI_Finalized(&finalized);
+
+    if(finalized == 0)
+    {
+        int status = MPI_Comm_free(graph);
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+
+    delete graph;
+    *neighbor_comm = NULL;
+}
+
+template <>
+void communication_async_neighbor_alltoallv(const double* send,
+                                            const int* send_count,
+                                            const int* send_offset,
+                                            double* recv,
+                                            const int* recv_count,
+                                            const int* recv_offset,
+                                            MRequest* request,
+                                            const void* neighbor_comm)
+{
+    int status = MPI_Ineighbor_alltoallv(send,
+                                         send_count,
+                                         send_offset,
+                                         MPI_DOUBLE,
+                                         recv,
+                                         recv_count,
+                                         recv_offset,
+                                         MPI_DOUBLE,
+                                         *(MPI_Comm*)neighbor_comm,
+                                         &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_neighbor_alltoallv(const float* send,
+                                            const int* send_count,
+                                            const int* send_offset,
+                                            float* recv,
+                                            const int* recv_count,
+                                            const int* recv_offset,
+                                            MRequest* request,
+                                            const void* neighbor_comm)
+{
+    int status = MPI_Ineighbor_alltoallv(send,
+                                         send_count,
+                                         send_offset,
+                                         MPI_FLOAT,
+                                         recv,
+                                         recv_count,
+                                         recv_offset,
+                                         MPI_FLOAT,
+                                         *(MPI_Comm*)neighbor_comm,
+                                         &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_neighbor_alltoallv(const std::complex<double>* send,
+                                            const int* send_count,
+                                            const int* send_offset,
+                                            std::complex<double>* recv,
+                                            const int* recv_count,
+                                            const int* recv_offset,
+                                            MRequest* request,
+                                            const void* neighbor_comm)
+{
+    int status = MPI_Ineighbor_alltoallv(send,
+                                         send_count,
+                                         send_offset,
+                                         MPI_DOUBLE_COMPLEX,
+                                         recv,
+                                         recv_count,
+                                         recv_offset,
+                                         MPI_DOUBLE_COMPLEX,
+                                         *(MPI_Comm*)neighbor_comm,
+                                         &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_neighbor_alltoallv(const std::complex<float>* send,
+                                            const int* send_count,
+                                            const int* send_offset,
+                                            std::complex<float>* recv,
+                                            const int* recv_count,
+                                            const int* recv_offset,
+                                            MRequest* request,
+                                            const void* neighbor_comm)
+{
+    int status = MPI_Ineighbor_alltoallv(send,
+                                         send_count,
+                                         send_offset,
+                                         MPI_COMPLEX,
+                                         recv,
+                                         recv_count,
+                                         recv_offset,
+                                         MPI_COMPLEX,
+                                         *(MPI_Comm*)neighbor_comm,
+                                         &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+template <>
+void communication_async_neighbor_alltoallv(const int* send,
+                                            const int* send_count,
+                                            const int* send_offset,
+                                            int* recv,
+                                            const int* recv_count,
+                                            const int* recv_offset,
+                                            MRequest* request,
+                                            const void* neighbor_comm)
+{
+    int status = MPI_Ineighbor_alltoallv(send,
+                                         send_count,
+                                         send_offset,
+                                         MPI_INT,
+                                         recv,
+                                         recv_count,
+                                         recv_offset,
+                                         MPI_INT,
+                                         *(MPI_Comm*)neighbor_comm,
+                                         &request->req);
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+bool communication_test(MRequest* request)
+{
+    int flag;
+    int status = MPI_Test(&request->req, &flag, MPI_STATUS_IGNORE);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+    return flag != 0;
+}
+
+void communication_sync(MRequest* request)
+{
+    int status = MPI_Wait(&request->req, MPI_STATUS_IGNORE);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+void communication_startall(int count, MRequest* requests)
+{
+    int status = MPI_Startall(count, &requests[0].req);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+}
+
+bool communication_testall(int count, MRequest* requests)
+{
+    int flag;
+    int status = MPI_Testall(count, &requests[0].req, &flag, MPI_STATUSES_IGNORE);
+
+    CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+
+    return flag != 0;
+}
+
 void communication_syncall(int count, MRequest* requests)
 {
     int status = MPI_Waitall(count, &requests[0].req, MPI_STATUSES_IGNORE);
@@ -208,6 +642,25 @@ void communication_syncall(int count, MRequest* requests)
     CHECK_MPI_ERROR(status, __FILE__, __LINE__);
 }
 
+void communication_freeall(int count, MRequest* requests)
+{
+    // Requests of objects that outlive MPI have already been released by MPI_Finalize
+    int finalized;
+    MPI_Finalized(&finalized);
+
+    if(finalized != 0)
+    {
+        return;
+    }
+
+    for(int i = 0; i < count; ++i)
+    {
+        int status = MPI_Request_free(&requests[i].req);
+
+        CHECK_MPI_ERROR(status, __FILE__, __LINE__);
+    }
+}
+
 template void
 communication_allreduce_single_sum<double>(double local, double* global, const void* comm);
 template void
@@ -222,6 +675,96 @@ template void communication_allreduce_single_sum<std::complex<float>>(std::compl
                                                                       const void* comm);
 #endif
 
+template void communication_allreduce_sum<double>(
+    const double* local, double* global, int count, const void* comm);
+template void communication_allreduce_sum<float>(
+    const float* local, float* global, int count, const void* comm);
+template void communication_allreduce_sum<int>(
+    const int* local, int* global, int count, const void* comm);
+template void communication_allreduce_sum<long>(
+    const long* local, long* global, int count, const void* comm);
+template void communication_allreduce_sum<long long>(
+    const long long* local, long long* global, int count, const void* comm);
+
+#ifdef SUPPORT_COMPLEX
+template void communication_allreduce_sum<std::complex<double>>(
+    const std::complex<double>* local, std::complex<double>* global, int count, const void* comm);
+template void communication_allreduce_sum<std::complex<float>>(
+    const std::complex<float>* local, std::complex<float>* global, int count, const void* comm);
+#endif
+
+template void communication_async_allreduce_sum<double>(
+    const double* local, double* global, int count, MRequest* request, const void* comm);
+template void communication_async_allreduce_sum<float>(
+    const float* local, float* global, int count, MRequest* request, const void* comm);
+template void communication_async_allreduce_sum<int>(
+    const int* local, int* global, int count, MRequest* request, const void* comm);
+template void communication_async_allreduce_sum<long>(
+    const long* local, long* global, int count, MRequest* request, const void* comm);
+template void communication_async_allreduce_sum<long long>(
+    const long long* local, long long* global, int count, MRequest* request, const void* comm);
+
+#ifdef SUPPORT_COMPLEX
+template void communication_async_allreduce_sum<std::complex<double>>(
+    const std::complex<double>* local,
+    std::complex<double>* global,
+    int count,
+    MRequest* request,
+    const void* comm);
+template void communication_async_allreduce_sum<std::complex<float>>(
+    const std::complex<float>* local,
+    std::complex<float>* global,
+    int count,
+    MRequest* request,
+    const void* comm);
+#endif
+
+template void communication_async_neighbor_alltoallv<double>(const double* send,
+                                                             const int* send_count,
+                                                             const int* send_offset,
+                                                             double* recv,
+                                                             const int* recv_count,
+                                                             const int* recv_offset,
+                                                             MRequest* request,
+                                                             const void* neighbor_comm);
+template void communication_async_neighbor_alltoallv<float>(const float* send,
+                                                            const int* send_count,
+                                                            const int* send_offset,
+                                                            float* recv,
+                                                            const int* recv_count,
+                                                            const int* recv_offset,
+                                                            MRequest* request,
+                                                            const void* neighbor_comm);
+template void communication_async_neighbor_alltoallv<int>(const int* send,
+                                                          const int* send_count,
+                                                          const int* send_offset,
+                                                          int* recv,
+                                                          const int* recv_count,
+                                                          const int* recv_offset,
+                                                          MRequest* request,
+                                                          const void* neighbor_comm);
+
+#ifdef SUPPORT_COMPLEX
+template void communication_async_neighbor_alltoallv<std::complex<double>>(
+    const std::complex<double>* send,
+    const int* send_count,
+    const int* send_offset,
+    std::complex<double>* recv,
+    const int* recv_count,
+    const int* recv_offset,
+    MRequest* request,
+    const void* neighbor_comm);
+template void communication_async_neighbor_alltoallv<std::complex<float>>(
+    const std::complex<float>* send,
+    const int* send_count,
+    const int* send_offset,
+    std::complex<float>* recv,
+    const int* recv_count,
+    const int* recv_offset,
+    MRequest* request,
+    const void* neighbor_comm);
+#endif
+
 template void communication_async_recv<double>(
     double* buf, int count, int source, int tag, MRequest* request, const void* comm);
 template void communication_async_recv<float>(
@@ -246,4 +789,28 @@ template void communication_async_send<std::complex<float>>(
     std::complex<float>* buf, int count, int dest, int tag, MRequest* request, const void* comm);
 #endif
 
+template void communication_persistent_recv<double>(
+    double* buf, int count, int source, int tag, MRequest* request, const void* comm);
+template void communication_persistent_recv<float>(
+    float* buf, int count, int source, int tag, MRequest* request, const void* comm);
+
+#ifdef SUPPORT_COMPLEX
+template void communication_persistent_recv<std::complex<double>>(
+    std::complex<double>* buf, int count, int source, int tag, MRequest* request, const void* comm);
+template void communication_persistent_recv<std::complex<float>>(
+    std::complex<float>* buf, int count, int source, int tag, MRequest* request, const void* comm);
+#endif
+
+template void communication_persistent_send<double>(
+    double* buf, int count, int dest, int tag, MRequest* request, const void* comm);
+template void communication_persistent_send<float>(
+    float* buf, int count, int dest, int tag, MRequest* request, const void* comm);
+
+#ifdef SUPPORT_COMPLEX
+template void communication_persistent_send<std::complex<double>>(
+    std::complex<double>* buf, int count, int dest, int tag, MRequest* request, const void* comm);
+template void communication_persistent_send<std::complex<float>>(
+    std::complex<float>* buf, int count, int dest, int tag, MRequest* request, const void* comm);
+#endif
+
 } // namespace rocalution
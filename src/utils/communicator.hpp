@@ -38,6 +38,22 @@ struct MRequest
 template <typename ValueType>
 void communication_allreduce_single_sum(ValueType local, ValueType* global, const void* comm);
 
+template <typename ValueType>
+void communication_allreduce_sum(const ValueType* local,
+                                 ValueType* global,
+                                 int count,
+                                 const void* comm);
+
+template <typename ValueType>
+void communication_async_allreduce_sum(
+    const ValueType* local, ValueType* global, int count, MRequest* request, const void* comm);
+
+template <typename ValueType>
+void communication_allgather_single(ValueType local, ValueType* global, const void* comm);
+
+template <typename ValueType>
+void communication_alltoall_single(const ValueType* send, ValueType* recv, const void* comm);
+
 template <typename ValueType>
 void communication_async_recv(
     ValueType* buf, int count, int source, int tag, MRequest* request, const void* comm);
@@ -46,8 +62,45 @@ template <typename ValueType>
 void communication_async_send(
     ValueType* buf, int count, int dest, int tag, MRequest* request, const void* comm);
 
+template <typename ValueType>
+void communication_persistent_recv(
+    ValueType* buf, int count, int source, int tag, MRequest* request, const void* comm);
+
+template <typename ValueType>
+void communication_persistent_send(
+    ValueType* buf, int count, int dest, int tag, MRequest* request, const void* comm);
+
+void communication_create_neighbor_comm(int nsource,
+                                        const int* sources,
+                                        int ndest,
+                                        const int* dests,
+                                        const void* comm,
+                                        void** neighbor_comm);
+
+void communication_free_neighbor_comm(void** neighbor_comm);
+
+template <typename ValueType>
+void communication_async_neighbor_alltoallv(const ValueType* send,
+                                            const int* send_count,
+                                            const int* send_offset,
+                                            ValueType* recv,
+                                            const int* recv_count,
+                                            const int* recv_offset,
+                                            MRequest* request,
+                                            const void* neighbor_comm);
+
+bool communication_test(MRequest* request);
+
+void communication_sync(MRequest* request);
+
+void communication_startall(int count, MRequest* requests);
+
+bool communication_testall(int count, MRequest* requests);
+
 void communication_syncall(int count, MRequest* requests);
 
+void communication_freeall(int count, MRequest* requests);
+
 } // namespace rocalution
 
 #endif // ROCALUTION_UTILS_COMMUNICATOR_HPP_
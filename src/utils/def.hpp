@@ -40,6 +40,25 @@
 // Comment to enable automatic object tracking
 #define OBJ_TRACKING_OFF
 
+// Number of blocks the interior rows of GlobalMatrix::Apply() are split into, the ghost
+// value exchange is progressed in between two blocks
+#define GLOBAL_APPLY_BLOCKS 16
+
+// Width of the SIMD registers in bytes, the chunk height of the SELL matrix format is
+// chosen such that one column of a chunk fills a register (64 for AVX-512)
+#define SELL_SIMD_BYTES 64
+
+// Sorting scope of the SELL matrix format in chunks
+#define SELL_SIGMA_CHUNKS 32
+
+// Column delta of the filler entries of the CCSR matrix formats, larger gaps between
+// two entries of a row are bridged by filler entries
+#define CCSR_FILLER 0xffff
+
+// Number of rows of the blocks, that are split independently by the classical Ruge
+// Stueben algorithm in the first pass of the HMIS coarsening
+#define RS_HMIS_BLOCK_ROWS 4096
+
 // ******************
 // ******************
 // Do not edit below!
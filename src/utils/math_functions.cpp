@@ -40,6 +40,14 @@ double rocalution_abs(const std::complex<double>& val) { return std::abs(val); }
 
 int rocalution_abs(const int& val) { return abs(val); }
 
+float rocalution_conj(const float& val) { return val; }
+
+double rocalution_conj(const double& val) { return val; }
+
+std::complex<float> rocalution_conj(const std::complex<float>& val) { return std::conj(val); }
+
+std::complex<double> rocalution_conj(const std::complex<double>& val) { return std::conj(val); }
+
 template <typename ValueType>
 ValueType rocalution_eps(void)
 {
@@ -98,6 +106,102 @@ bool operator>=(const std::complex<ValueType>& lhs, const std::complex<ValueType
     return lhs.real() >= rhs.real();
 }
 
+template <typename ValueType>
+int rocalution_cholesky(int n, ValueType* A, double tol)
+{
+    assert(n >= 0);
+    assert(A != NULL);
+
+    for(int j = 0; j < n; ++j)
+    {
+        double diag = std::real(A[j + j * n]);
+
+        for(int i = 0; i < j; ++i)
+        {
+            ValueType sum = A[i + j * n];
+
+            for(int l = 0; l < i; ++l)
+            {
+                sum -= rocalution_conj(A[l + i * n]) * A[l + j * n];
+            }
+
+            A[i + j * n] = sum / A[i + i * n];
+        }
+
+        double pivot = diag;
+
+        for(int l = 0; l < j; ++l)
+        {
+            double r = rocalution_abs(A[l + j * n]);
+            pivot -= r * r;
+        }
+
+        if(!(diag > 0.0) || !(pivot > tol * diag))
+        {
+            return j;
+        }
+
+        A[j + j * n] = static_cast<ValueType>(sqrt(pivot));
+
+        for(int i = j + 1; i < n; ++i)
+        {
+            A[i + j * n] = static_cast<ValueType>(0);
+        }
+    }
+
+    return -1;
+}
+
+template <typename ValueType>
+void rocalution_cholesky_solve(int n, const ValueType* R, int nrhs, ValueType* B)
+{
+    assert(n >= 0);
+    assert(R != NULL);
+    assert(B != NULL);
+
+    for(int c = 0; c < nrhs; ++c)
+    {
+        ValueType* b = B + c * n;
+
+        // R^H y = b
+        for(int i = 0; i < n; ++i)
+        {
+            for(int l = 0; l < i; ++l)
+            {
+                b[i] -= rocalution_conj(R[l + i * n]) * b[l];
+            }
+
+            b[i] /= R[i + i * n];
+        }
+    }
+
+    // R x = y
+    rocalution_upper_solve(n, R, nrhs, B);
+}
+
+template <typename ValueType>
+void rocalution_upper_solve(int n, const ValueType* R, int nrhs, ValueType* B)
+{
+    assert(n >= 0);
+    assert(R != NULL);
+    assert(B != NULL);
+
+    for(int c = 0; c < nrhs; ++c)
+    {
+        ValueType* b = B + c * n;
+
+        for(int i = n - 1; i >= 0; --i)
+        {
+            for(int l = i + 1; l < n; ++l)
+            {
+                b[i] -= R[i + l * n] * b[l];
+            }
+
+            b[i] /= R[i + i * n];
+        }
+    }
+}
+
 template double rocalution_eps(void);
 template float rocalution_eps(void);
 template std::complex<double> rocalution_eps(void);
@@ -115,4 +219,31 @@ template bool operator<=(const std::complex<double>& lhs, const std::complex<dou
 template bool operator>=(const std::complex<float>& lhs, const std::complex<float>& rhs);
 template bool operator>=(const std::complex<double>& lhs, const std::complex<double>& rhs);
 
+template int rocalution_cholesky(int n, double* A, double tol);
+template int rocalution_cholesky(int n, float* A, double tol);
+template int rocalution_cholesky(int n, std::complex<double>* A, double tol);
+template int rocalution_cholesky(int n, std::complex<float>* A, double tol);
+
+template void rocalution_cholesky_solve(int n, const double* R, int nrhs, double* B);
+template void rocalution_cholesky_solve(int n, const float* R, int nrhs, float* B);
+template void rocalution_cholesky_solve(int n,
+                                        const std::complex<double>* R,
+                                        int nrhs,
+                                        std::complex<double>* B);
+template void rocalution_cholesky_solve(int n,
+                                        const std::complex<float>* R,
+                                        int nrhs,
+                                        std::complex<float>* B);
+
+template void rocalution_upper_solve(int n, const double* R, int nrhs, double* B);
+template void rocalution_upper_solve(int n, const float* R, int nrhs, float* B);
+template void rocalution_upper_solve(int n,
+                                     const std::complex<double>* R,
+                                     int nrhs,
+                                     std::complex<double>* B);
+template void rocalution_upper_solve(int n,
+                                     const std::complex<float>* R,
+                                     int nrhs,
+                                     std::complex<float>* B);
+
 } // namespace rocalution
@@ -39,10 +39,35 @@ double rocalution_abs(const std::complex<double>& val);
 /// Return absolute int value
 int rocalution_abs(const int& val);
 
+/// Return complex conjugate float value
+float rocalution_conj(const float& val);
+/// Return complex conjugate double value
+double rocalution_conj(const double& val);
+/// Return complex conjugate float value
+std::complex<float> rocalution_conj(const std::complex<float>& val);
+/// Return complex conjugate double value
+std::complex<double> rocalution_conj(const std::complex<double>& val);
+
 /// Return smallest positive floating point number
 template <typename ValueType>
 ValueType rocalution_eps(void);
 
+/// Compute the Cholesky factorization A = R^H R of a column-major Hermitian n x n matrix
+/// in place (R is stored in the upper triangle, the strict lower triangle is zeroed).
+/// Returns the index of the first pivot that drops below tol times the corresponding
+/// diagonal entry of A, i.e. the first column that is numerically linearly dependent on
+/// the previous ones, or -1 on success
+template <typename ValueType>
+int rocalution_cholesky(int n, ValueType* A, double tol);
+/// Solve R^H R X = B in place for a column-major n x nrhs matrix B, where R is the
+/// Cholesky factor computed by rocalution_cholesky()
+template <typename ValueType>
+void rocalution_cholesky_solve(int n, const ValueType* R, int nrhs, ValueType* B);
+/// Solve R X = B in place for a column-major upper triangular n x n matrix R and a
+/// column-major n x nrhs matrix B
+template <typename ValueType>
+void rocalution_upper_solve(int n, const ValueType* R, int nrhs, ValueType* B);
+
 /// Overloaded < operator for complex numbers
 template <typename ValueType>
 bool operator<(const std::complex<ValueType>& lhs, const std::complex<ValueType>& rhs);
@@ -0,0 +1,89 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_UTILS_RANDOM_HPP_
+#define ROCALUTION_UTILS_RANDOM_HPP_
+
+namespace rocalution {
+
+/// Philox4x32-10 counter-based random number generator. The four 32 bit words of ctr
+/// are replaced by four random words, that depend on the counter and the key only.
+/// Thus, any entry of a random stream can be generated independently of all others.
+inline void philox4x32_10(unsigned int* ctr, unsigned long long seed)
+{
+    unsigned int k0 = static_cast<unsigned int>(seed);
+    unsigned int k1 = static_cast<unsigned int>(seed >> 32);
+
+    for(int r = 0; r < 10; ++r)
+    {
+        unsigned long long p0 = 0xD2511F53ULL * ctr[0];
+        unsigned long long p1 = 0xCD9E8D57ULL * ctr[2];
+
+        unsigned int c1 = ctr[1];
+        unsigned int c3 = ctr[3];
+
+        ctr[0] = static_cast<unsigned int>(p1 >> 32) ^ c1 ^ k0;
+        ctr[1] = static_cast<unsigned int>(p1);
+        ctr[2] = static_cast<unsigned int>(p0 >> 32) ^ c3 ^ k1;
+        ctr[3] = static_cast<unsigned int>(p0);
+
+        k0 += 0x9E3779B9U;
+        k1 += 0xBB67AE85U;
+    }
+}
+
+/// Finalizer of the 32 bit MurmurHash3, mixes all bits of x into the result. Used to
+/// derive reproducible pseudo random priorities from indices.
+inline unsigned int murmur3_fmix32(unsigned int x)
+{
+    x ^= x >> 16;
+    x *= 0x85ebca6bu;
+    x ^= x >> 13;
+    x *= 0xc2b2ae35u;
+    x ^= x >> 16;
+
+    return x;
+}
+
+/// Two uniformly distributed random numbers in [0,1) with 53 bits, that belong to the
+/// index-th pair of the stream defined by seed
+inline void random_uniform_pair(unsigned long long seed,
+                                unsigned long long index,
+                                double& u0,
+                                double& u1)
+{
+    unsigned int ctr[4]
+        = {static_cast<unsigned int>(index), static_cast<unsigned int>(index >> 32), 0, 0};
+
+    philox4x32_10(ctr, seed);
+
+    unsigned long long r0 = (static_cast<unsigned long long>(ctr[0]) << 32) | ctr[1];
+    unsigned long long r1 = (static_cast<unsigned long long>(ctr[2]) << 32) | ctr[3];
+
+    u0 = static_cast<double>(r0 >> 11) * (1.0 / 9007199254740992.0);
+    u1 = static_cast<double>(r1 >> 11) * (1.0 / 9007199254740992.0);
+}
+
+} // namespace rocalution
+
+#endif // ROCALUTION_UTILS_RANDOM_HPP_
@@ -0,0 +1,499 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#include "def.hpp"
+#include "trace.hpp"
+#include "log.hpp"
+#include "../base/backend_manager.hpp"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Number of events of each per-thread ring buffer
+#define TRACE_BUFFER_SIZE 65536
+
+// Number of counter slots of each per-thread buffer, i.e. the maximum number of distinct
+// kernels and solver phases that are counted per thread
+#define TRACE_COUNTER_SLOTS 512
+
+namespace rocalution {
+
+bool _rocalution_trace_enabled = false;
+
+struct TraceEvent
+{
+    const char* name;
+    const char* category;
+
+    long long start;
+    long long duration;
+    long long bytes;
+    long long flops;
+};
+
+struct TraceCounter
+{
+    const char* category;
+
+    long long calls;
+    long long time;
+    long long bytes;
+    long long flops;
+};
+
+// Counter of a single kernel or solver phase. The slot is claimed by publishing its
+// name, the values are only written by the owning thread.
+struct TraceCounterSlot
+{
+    std::atomic<const char*> name;
+    const char* category;
+
+    std::atomic<long long> calls;
+    std::atomic<long long> time;
+    std::atomic<long long> bytes;
+    std::atomic<long long> flops;
+};
+
+// Ring buffer and counters of a single thread. Only the owning thread writes into its
+// buffer, without any lock. Output and merge may run concurrently on other threads and
+// read acquire snapshots of the event count and the counter slots. A reset increments
+// reset_epoch, the owner discards its events and counters on its next event and then
+// publishes the observed epoch. Until then, readers treat the buffer as empty.
+struct TraceBuffer
+{
+    int tid;
+
+    std::atomic<long long> nevents;
+    std::atomic<long long> reset_epoch;
+    std::atomic<long long> epoch;
+
+    std::vector<TraceEvent> events;
+
+    TraceCounterSlot counters[TRACE_COUNTER_SLOTS];
+};
+
+// All buffers ever created, buffers are never freed, since threads keep their pointers
+static std::mutex trace_mutex;
+static std::vector<TraceBuffer*> trace_buffers;
+
+static thread_local TraceBuffer* trace_local = NULL;
+
+static const std::chrono::steady_clock::time_point trace_origin
+    = std::chrono::steady_clock::now();
+
+// True, if tracing has been requested by the environment
+static bool trace_env = false;
+
+static TraceBuffer* trace_register_buffer(void)
+{
+    TraceBuffer* buffer = new TraceBuffer;
+
+    buffer->nevents.store(0);
+    buffer->events.resize(TRACE_BUFFER_SIZE);
+
+    for(int i = 0; i < TRACE_COUNTER_SLOTS; ++i)
+    {
+        buffer->counters[i].name.store(NULL);
+        buffer->counters[i].category = NULL;
+        buffer->counters[i].calls.store(0);
+        buffer->counters[i].time.store(0);
+        buffer->counters[i].bytes.store(0);
+        buffer->counters[i].flops.store(0);
+    }
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    // Buffers that are created after a reset start in the current epoch
+    long long epoch = trace_buffers.empty() ? 0 : trace_buffers[0]->reset_epoch.load();
+
+    buffer->reset_epoch.store(epoch);
+    buffer->epoch.store(epoch);
+
+    buffer->tid = static_cast<int>(trace_buffers.size());
+    trace_buffers.push_back(buffer);
+
+    return buffer;
+}
+
+static long long trace_now(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - trace_origin)
+        .count();
+}
+
+// Add to a value that only the calling thread writes
+static inline void trace_add(std::atomic<long long>& value, long long inc)
+{
+    value.store(value.load(std::memory_order_relaxed) + inc, std::memory_order_relaxed);
+}
+
+// Counter slot of name in the buffer of the calling thread, NULL if the table is full
+static TraceCounterSlot* trace_counter_slot(TraceBuffer* buffer,
+                                            const char* name,
+                                            const char* category)
+{
+    size_t hash = reinterpret_cast<size_t>(name) / sizeof(void*);
+
+    for(int i = 0; i < TRACE_COUNTER_SLOTS; ++i)
+    {
+        TraceCounterSlot* slot = &buffer->counters[(hash + i) % TRACE_COUNTER_SLOTS];
+
+        const char* slot_name = slot->name.load(std::memory_order_relaxed);
+
+        if(slot_name == name)
+        {
+            return slot;
+        }
+
+        if(slot_name == NULL)
+        {
+            slot->category = category;
+            slot->name.store(name, std::memory_order_release);
+
+            return slot;
+        }
+    }
+
+    return NULL;
+}
+
+// Discard the events and counters of the calling thread, if a reset has been requested
+static void trace_observe_reset(TraceBuffer* buffer)
+{
+    long long epoch = buffer->reset_epoch.load(std::memory_order_acquire);
+
+    if(epoch == buffer->epoch.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    buffer->nevents.store(0, std::memory_order_relaxed);
+
+    for(int i = 0; i < TRACE_COUNTER_SLOTS; ++i)
+    {
+        buffer->counters[i].calls.store(0, std::memory_order_relaxed);
+        buffer->counters[i].time.store(0, std::memory_order_relaxed);
+        buffer->counters[i].bytes.store(0, std::memory_order_relaxed);
+        buffer->counters[i].flops.store(0, std::memory_order_relaxed);
+    }
+
+    buffer->epoch.store(epoch, std::memory_order_release);
+}
+
+// True, if the buffer holds data of the current epoch
+static bool trace_buffer_current(const TraceBuffer* buffer)
+{
+    return buffer->reset_epoch.load(std::memory_order_acquire)
+           == buffer->epoch.load(std::memory_order_acquire);
+}
+
+long long _rocalution_trace_begin(void)
+{
+    // Do not account for pending asynchronous work
+    _rocalution_sync();
+
+    return trace_now();
+}
+
+void _rocalution_trace_end(
+    const char* name, const char* category, long long start, long long bytes, long long flops)
+{
+    _rocalution_sync();
+
+    long long duration = trace_now() - start;
+
+    if(trace_local == NULL)
+    {
+        trace_local = trace_register_buffer();
+    }
+
+    TraceBuffer* buffer = trace_local;
+
+    trace_observe_reset(buffer);
+
+    long long nevents = buffer->nevents.load(std::memory_order_relaxed);
+
+    TraceEvent& event = buffer->events[nevents % TRACE_BUFFER_SIZE];
+
+    event.name     = name;
+    event.category = category;
+    event.start    = start;
+    event.duration = duration;
+    event.bytes    = bytes;
+    event.flops    = flops;
+
+    // Publish the event
+    buffer->nevents.store(nevents + 1, std::memory_order_release);
+
+    TraceCounterSlot* counter = trace_counter_slot(buffer, name, category);
+
+    if(counter != NULL)
+    {
+        trace_add(counter->calls, 1);
+        trace_add(counter->time, duration);
+        trace_add(counter->bytes, bytes);
+        trace_add(counter->flops, flops);
+    }
+}
+
+// Counters of all threads, merged by name
+static void trace_merge_counters(std::map<std::string, TraceCounter>& merged)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    for(size_t t = 0; t < trace_buffers.size(); ++t)
+    {
+        const TraceBuffer* buffer = trace_buffers[t];
+
+        if(trace_buffer_current(buffer) == false)
+        {
+            continue;
+        }
+
+        for(int i = 0; i < TRACE_COUNTER_SLOTS; ++i)
+        {
+            const TraceCounterSlot& slot = buffer->counters[i];
+
+            const char* name = slot.name.load(std::memory_order_acquire);
+
+            if(name == NULL)
+            {
+                continue;
+            }
+
+            TraceCounter counter;
+
+            counter.category = slot.category;
+            counter.calls    = slot.calls.load(std::memory_order_relaxed);
+            counter.time     = slot.time.load(std::memory_order_relaxed);
+            counter.bytes    = slot.bytes.load(std::memory_order_relaxed);
+            counter.flops    = slot.flops.load(std::memory_order_relaxed);
+
+            if(counter.calls == 0)
+            {
+                continue;
+            }
+
+            std::map<std::string, TraceCounter>::iterator m = merged.find(name);
+
+            if(m == merged.end())
+            {
+                merged[name] = counter;
+            }
+            else
+            {
+                m->second.calls += counter.calls;
+                m->second.time += counter.time;
+                m->second.bytes += counter.bytes;
+                m->second.flops += counter.flops;
+            }
+        }
+    }
+}
+
+static bool trace_compare_time(const std::pair<std::string, TraceCounter>& a,
+                               const std::pair<std::string, TraceCounter>& b)
+{
+    return a.second.time > b.second.time;
+}
+
+void enable_trace_rocalution(bool onoff)
+{
+    log_debug(0, "enable_trace_rocalution()", onoff);
+
+    _rocalution_trace_enabled = onoff;
+}
+
+void reset_trace_rocalution(void)
+{
+    log_debug(0, "reset_trace_rocalution()");
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    // The owning threads discard their data on their next event
+    for(size_t t = 0; t < trace_buffers.size(); ++t)
+    {
+        trace_buffers[t]->reset_epoch.fetch_add(1, std::memory_order_release);
+    }
+}
+
+void info_trace_rocalution(void)
+{
+    std::map<std::string, TraceCounter> merged;
+    trace_merge_counters(merged);
+
+    std::vector<std::pair<std::string, TraceCounter>> sorted(merged.begin(), merged.end());
+    std::sort(sorted.begin(), sorted.end(), trace_compare_time);
+
+    LOG_INFO("Trace counters (inclusive time):");
+    LOG_INFO(std::setw(40) << std::left << "name" << std::setw(16) << "category"
+                           << std::setw(10) << std::right << "calls" << std::setw(14)
+                           << "time [ms]" << std::setw(12) << "GB/s" << std::setw(12)
+                           << "GFlop/s");
+
+    for(size_t i = 0; i < sorted.size(); ++i)
+    {
+        const TraceCounter& c = sorted[i].second;
+
+        double time = static_cast<double>(c.time);
+        double bw   = (c.time > 0) ? static_cast<double>(c.bytes) / time : 0.0;
+        double perf = (c.time > 0) ? static_cast<double>(c.flops) / time : 0.0;
+
+        LOG_INFO(std::setw(40) << std::left << sorted[i].first << std::setw(16) << c.category
+                               << std::setw(10) << std::right << c.calls << std::setw(14)
+                               << std::fixed << std::setprecision(3) << time / 1e6
+                               << std::setw(12) << bw << std::setw(12) << perf);
+    }
+}
+
+void write_trace_rocalution(const std::string filename)
+{
+    log_debug(0, "write_trace_rocalution()", filename);
+
+    std::ofstream out(filename.c_str(), std::ios::out | std::ios::trunc);
+
+    if(!out.is_open())
+    {
+        LOG_INFO("WARNING: Cannot open trace file " << filename);
+        return;
+    }
+
+    int pid = _get_backend_descriptor()->rank;
+
+    out << std::fixed << std::setprecision(3);
+    out << "{\"traceEvents\":[";
+
+    bool first = true;
+
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+
+        for(size_t t = 0; t < trace_buffers.size(); ++t)
+        {
+            const TraceBuffer* buffer = trace_buffers[t];
+
+            long long epoch = buffer->epoch.load(std::memory_order_acquire);
+
+            if(buffer->reset_epoch.load(std::memory_order_acquire) != epoch)
+            {
+                continue;
+            }
+
+            // Snapshot of the published events, the oldest one still available in the
+            // ring buffer first
+            long long end   = buffer->nevents.load(std::memory_order_acquire);
+            long long begin = std::max(0LL, end - TRACE_BUFFER_SIZE);
+
+            std::vector<TraceEvent> events(end - begin);
+
+            for(long long i = begin; i < end; ++i)
+            {
+                events[i - begin] = buffer->events[i % TRACE_BUFFER_SIZE];
+            }
+
+            // Drop the events that the owning thread discarded or overwrote while copying,
+            // including the slot of the event that is currently written
+            long long current = buffer->nevents.load(std::memory_order_acquire);
+
+            if(buffer->epoch.load(std::memory_order_acquire) != epoch || current < end)
+            {
+                continue;
+            }
+
+            long long valid = std::max(begin, current + 1 - TRACE_BUFFER_SIZE);
+
+            for(long long i = valid; i < end; ++i)
+            {
+                const TraceEvent& e = events[i - begin];
+
+                out << (first ? "\n" : ",\n");
+                out << "{\"name\":\"" << e.name << "\",\"cat\":\"" << e.category
+                    << "\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << buffer->tid
+                    << ",\"ts\":" << e.start / 1e3 << ",\"dur\":" << e.duration / 1e3
+                    << ",\"args\":{\"bytes\":" << e.bytes << ",\"flops\":" << e.flops << "}}";
+
+                first = false;
+            }
+        }
+    }
+
+    std::map<std::string, TraceCounter> merged;
+    trace_merge_counters(merged);
+
+    out << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"counters\":[";
+
+    first = true;
+
+    std::map<std::string, TraceCounter>::const_iterator it;
+    for(it = merged.begin(); it != merged.end(); ++it)
+    {
+        out << (first ? "\n" : ",\n");
+        out << "{\"name\":\"" << it->first << "\",\"cat\":\"" << it->second.category
+            << "\",\"calls\":" << it->second.calls << ",\"time_us\":" << it->second.time / 1e3
+            << ",\"bytes\":" << it->second.bytes << ",\"flops\":" << it->second.flops << "}";
+
+        first = false;
+    }
+
+    out << "\n]}}\n";
+    out.close();
+}
+
+void _rocalution_init_trace(void)
+{
+    char* str_trace;
+    if((str_trace = getenv("ROCALUTION_TRACE")) != NULL)
+    {
+        if(atoi(str_trace) == 1)
+        {
+            trace_env = true;
+            enable_trace_rocalution(true);
+        }
+    }
+}
+
+void _rocalution_stop_trace(void)
+{
+    if(trace_env == true)
+    {
+        std::ostringstream rank;
+        rank << _get_backend_descriptor()->rank;
+
+        write_trace_rocalution("rocalution-rank-" + rank.str() + "-trace.json");
+
+        enable_trace_rocalution(false);
+        trace_env = false;
+    }
+}
+
+} // namespace rocalution
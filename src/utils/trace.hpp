@@ -0,0 +1,150 @@
+/* ************************************************************************
+ * Copyright (c) 2018 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ************************************************************************ */
+
+#ifndef ROCALUTION_UTILS_TRACE_HPP_
+#define ROCALUTION_UTILS_TRACE_HPP_
+
+#include <string>
+
+namespace rocalution {
+
+/** \ingroup backend_module
+  * \brief Enable/disable the tracing of rocALUTION kernels and solver phases
+  * \details
+  * When tracing is enabled, every kernel of the local and global matrix / vector
+  * classes and every solver phase (e.g. building, solving, smoothing, restriction,
+  * prolongation) records a timestamped event into a ring buffer of the calling thread.
+  * Additionally, the number of calls, the time, the bytes moved and the floating point
+  * operations are accumulated per kernel. Tracing can also be enabled by setting the
+  * environment variable \p ROCALUTION_TRACE to 1, in which case the trace is written
+  * to \p rocalution-rank-<rank>-trace.json by stop_rocalution().
+  *
+  * \note
+  * When tracing is disabled, each instrumentation point costs a single branch. When
+  * tracing is enabled on an accelerator backend, the device is synchronized after each
+  * event, such that the recorded time corresponds to the kernel execution.
+  *
+  * @param[in]
+  * onoff   boolean to turn on/off the tracing
+  */
+void enable_trace_rocalution(bool onoff = true);
+
+/** \ingroup backend_module
+  * \brief Discard all recorded trace events and counters */
+void reset_trace_rocalution(void);
+
+/** \ingroup backend_module
+  * \brief Print the accumulated trace counters
+  * \details
+  * \p info_trace_rocalution prints the number of calls, the total time, the bytes moved
+  * and the floating point operations of each traced kernel and solver phase, sorted by
+  * the total time.
+  */
+void info_trace_rocalution(void);
+
+/** \ingroup backend_module
+  * \brief Write the recorded trace events to a Chrome trace file
+  * \details
+  * \p write_trace_rocalution writes all recorded events in the Chrome trace event (JSON)
+  * format, which can be inspected with chrome://tracing or Perfetto. The accumulated
+  * counters are stored in the \p otherData section of the file. Events that have been
+  * overwritten in the ring buffers are lost, the counters are always complete.
+  *
+  * @param[in]
+  * filename    name of the trace file
+  */
+void write_trace_rocalution(const std::string filename);
+
+/** \private */
+extern bool _rocalution_trace_enabled;
+
+/** \private */
+void _rocalution_init_trace(void);
+/** \private */
+void _rocalution_stop_trace(void);
+
+/** \private */
+long long _rocalution_trace_begin(void);
+/** \private */
+void _rocalution_trace_end(
+    const char* name, const char* category, long long start, long long bytes, long long flops);
+
+/** \private
+  * \brief Trace scope, records an event from its construction to its destruction */
+class TraceScope
+{
+    public:
+    TraceScope(const char* name, const char* category)
+        : name_(name), category_(category), start_(-1), bytes_(0), flops_(0)
+    {
+        if(_rocalution_trace_enabled == true)
+        {
+            this->start_ = _rocalution_trace_begin();
+        }
+    }
+
+    ~TraceScope()
+    {
+        if(this->start_ >= 0)
+        {
+            _rocalution_trace_end(
+                this->name_, this->category_, this->start_, this->bytes_, this->flops_);
+        }
+    }
+
+    bool Active(void) const
+    {
+        return this->start_ >= 0;
+    }
+
+    void Count(long long bytes, long long flops)
+    {
+        this->bytes_ += bytes;
+        this->flops_ += flops;
+    }
+
+    private:
+    const char* name_;
+    const char* category_;
+
+    long long start_;
+    long long bytes_;
+    long long flops_;
+};
+
+} // namespace rocalution
+
+// Trace the enclosing scope, name and category have to be string literals
+#define ROCALUTION_TRACE_SCOPE(name, category) \
+    rocalution::TraceScope _rocalution_trace_scope(name, category)
+
+// Add bytes and flops to the trace scope of the enclosing scope, the arguments are only
+// evaluated when tracing is enabled
+#define ROCALUTION_TRACE_COUNT(bytes, flops)                                  \
+    {                                                                         \
+        if(_rocalution_trace_scope.Active() == true)                          \
+            _rocalution_trace_scope.Count(static_cast<long long>(bytes),      \
+                                          static_cast<long long>(flops));     \
+    }
+
+#endif // ROCALUTION_UTILS_TRACE_HPP_